@@ -14,13 +14,23 @@
 #include <boost/thread/thread.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <algorithm>
 #include <iostream>
+#include <fstream>
 #include <complex>
 #include <cstdlib>
+#include <cstring>
 #include <atomic>
 #include <chrono>
 #include <thread>
 
+#ifdef UHD_PLATFORM_LINUX
+#include <sched.h>    //sched_setaffinity
+#include <sys/mman.h> //mmap for the shared results block
+#include <sys/wait.h> //waitpid
+#include <unistd.h>   //fork
+#endif
+
 namespace po = boost::program_options;
 
 namespace {
@@ -42,6 +52,156 @@ unsigned long long num_late_commands = 0;
 unsigned long long num_timeouts_rx = 0;
 unsigned long long num_timeouts_tx = 0;
 
+/***********************************************************************
+ * Results of one streaming process:
+ * In multi-process mode every child fills its slot of a shared memory
+ * array with these, and the parent aggregates them.
+ **********************************************************************/
+struct benchmark_results_t{
+    unsigned long long num_overruns;
+    unsigned long long num_underruns;
+    unsigned long long num_rx_samps;
+    unsigned long long num_tx_samps;
+    unsigned long long num_dropped_samps;
+    unsigned long long num_seq_errors;
+    unsigned long long num_seqrx_errors;
+    unsigned long long num_late_commands;
+    unsigned long long num_timeouts_rx;
+    unsigned long long num_timeouts_tx;
+    int exit_code;
+};
+
+//! snapshot the global counters of this process
+static benchmark_results_t collect_results(void){
+    benchmark_results_t results;
+    std::memset(&results, 0, sizeof(results));
+    results.num_overruns = num_overruns;
+    results.num_underruns = num_underruns;
+    results.num_rx_samps = num_rx_samps;
+    results.num_tx_samps = num_tx_samps;
+    results.num_dropped_samps = num_dropped_samps;
+    results.num_seq_errors = num_seq_errors;
+    results.num_seqrx_errors = num_seqrx_errors;
+    results.num_late_commands = num_late_commands;
+    results.num_timeouts_rx = num_timeouts_rx;
+    results.num_timeouts_tx = num_timeouts_tx;
+    return results;
+}
+
+//! print the human-readable counter summary
+static void print_summary(const benchmark_results_t &results){
+    std::cout << std::endl
+        << boost::format(
+                "Benchmark rate summary:\n"
+                "  Num received samples:     %u\n"
+                "  Num dropped samples:      %u\n"
+                "  Num overruns detected:    %u\n"
+                "  Num transmitted samples:  %u\n"
+                "  Num sequence errors (Tx): %u\n"
+                "  Num sequence errors (Rx): %u\n"
+                "  Num underruns detected:   %u\n"
+                "  Num late commands:        %u\n"
+                "  Num timeouts (Tx):        %u\n"
+                "  Num timeouts (Rx):        %u\n"
+            ) % results.num_rx_samps
+              % results.num_dropped_samps
+              % results.num_overruns
+              % results.num_tx_samps
+              % results.num_seq_errors
+              % results.num_seqrx_errors
+              % results.num_underruns
+              % results.num_late_commands
+              % results.num_timeouts_tx
+              % results.num_timeouts_rx
+        << std::endl;
+}
+
+//! escape a string for embedding in a JSON document
+static std::string json_escape(const std::string &input){
+    std::string output;
+    for (size_t i = 0; i < input.size(); i++){
+        if (input[i] == '"' or input[i] == '\\') output += '\\';
+        output += input[i];
+    }
+    return output;
+}
+
+//! dump per-device results and totals as JSON for qualification scripts
+static void write_json_results(
+    const std::string &path,
+    const std::vector<std::string> &device_args,
+    const std::vector<benchmark_results_t> &results
+){
+    benchmark_results_t totals;
+    std::memset(&totals, 0, sizeof(totals));
+
+    std::ofstream json(path.c_str());
+    json << "{\n  \"devices\": [";
+    for (size_t i = 0; i < results.size(); i++){
+        const benchmark_results_t &r = results[i];
+        json << (i? ",\n" : "\n")
+            << "    {\n"
+            << "      \"args\": \"" << json_escape(device_args[i]) << "\",\n"
+            << "      \"num_rx_samps\": " << r.num_rx_samps << ",\n"
+            << "      \"num_tx_samps\": " << r.num_tx_samps << ",\n"
+            << "      \"num_dropped_samps\": " << r.num_dropped_samps << ",\n"
+            << "      \"num_overruns\": " << r.num_overruns << ",\n"
+            << "      \"num_underruns\": " << r.num_underruns << ",\n"
+            << "      \"num_seq_errors_tx\": " << r.num_seq_errors << ",\n"
+            << "      \"num_seq_errors_rx\": " << r.num_seqrx_errors << ",\n"
+            << "      \"num_late_commands\": " << r.num_late_commands << ",\n"
+            << "      \"num_timeouts_rx\": " << r.num_timeouts_rx << ",\n"
+            << "      \"num_timeouts_tx\": " << r.num_timeouts_tx << ",\n"
+            << "      \"exit_code\": " << r.exit_code << "\n"
+            << "    }";
+        totals.num_rx_samps += r.num_rx_samps;
+        totals.num_tx_samps += r.num_tx_samps;
+        totals.num_dropped_samps += r.num_dropped_samps;
+        totals.num_overruns += r.num_overruns;
+        totals.num_underruns += r.num_underruns;
+        totals.num_seq_errors += r.num_seq_errors;
+        totals.num_seqrx_errors += r.num_seqrx_errors;
+        totals.num_late_commands += r.num_late_commands;
+        totals.num_timeouts_rx += r.num_timeouts_rx;
+        totals.num_timeouts_tx += r.num_timeouts_tx;
+        if (r.exit_code != EXIT_SUCCESS) totals.exit_code = EXIT_FAILURE;
+    }
+    json << "\n  ],\n  \"totals\": {\n"
+        << "    \"num_rx_samps\": " << totals.num_rx_samps << ",\n"
+        << "    \"num_tx_samps\": " << totals.num_tx_samps << ",\n"
+        << "    \"num_dropped_samps\": " << totals.num_dropped_samps << ",\n"
+        << "    \"num_overruns\": " << totals.num_overruns << ",\n"
+        << "    \"num_underruns\": " << totals.num_underruns << ",\n"
+        << "    \"num_seq_errors_tx\": " << totals.num_seq_errors << ",\n"
+        << "    \"num_seq_errors_rx\": " << totals.num_seqrx_errors << ",\n"
+        << "    \"num_late_commands\": " << totals.num_late_commands << ",\n"
+        << "    \"num_timeouts_rx\": " << totals.num_timeouts_rx << ",\n"
+        << "    \"num_timeouts_tx\": " << totals.num_timeouts_tx << ",\n"
+        << "    \"exit_code\": " << totals.exit_code << "\n"
+        << "  }\n}\n";
+}
+
+//! pin this process to the given CPUs; done before device creation so
+//! buffers and frame pools allocate on the matching NUMA node
+static void apply_cpu_affinity(const std::string &cpu_list){
+#ifdef UHD_PLATFORM_LINUX
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    std::vector<std::string> cpu_strs;
+    boost::split(cpu_strs, cpu_list, boost::is_any_of("\"',"));
+    for (size_t i = 0; i < cpu_strs.size(); i++){
+        if (cpu_strs[i].empty()) continue;
+        CPU_SET(std::stoul(cpu_strs[i]), &cpuset);
+    }
+    if (::sched_setaffinity(0, sizeof(cpuset), &cpuset) != 0){
+        std::cerr << "WARNING: Could not set CPU affinity to " << cpu_list << std::endl;
+    }
+#else
+    std::cerr << "WARNING: CPU affinity (" << cpu_list
+              << ") is only supported on Linux." << std::endl;
+#endif
+}
+
 inline boost::posix_time::time_duration time_delta(const boost::posix_time::ptime &ref_time)
 {
     return boost::posix_time::microsec_clock::local_time() - ref_time;
@@ -296,6 +456,7 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
     bool random_nsamps = false;
     std::atomic<bool> burst_timer_elapsed(false);
     size_t overrun_threshold, underrun_threshold, drop_threshold, seq_threshold;
+    std::string multi_args, cpu_affinity, json_path;
 
     //setup the program options
     po::options_description desc("Allowed options");
@@ -326,6 +487,12 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
          "Number of dropped packets (D) which will declare the benchmark a failure.")
         ("seq-threshold", po::value<size_t>(&seq_threshold),
          "Number of dropped packets (D) which will declare the benchmark a failure.")
+        ("multi_args", po::value<std::string>(&multi_args),
+         "semicolon-separated device args; forks one streaming process per device and aggregates the results (Linux only)")
+        ("cpu_affinity", po::value<std::string>(&cpu_affinity),
+         "CPUs to pin the process to, e.g. \"0,1\"; with multi_args, semicolon-separated groups, one per device")
+        ("json", po::value<std::string>(&json_path),
+         "write a machine-readable results summary to this file")
     ;
     po::variables_map vm;
     po::store(po::parse_command_line(argc, argv, desc), vm);
@@ -358,6 +525,89 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
         }
     }
 
+    /***************************************************************
+     * Multi-process mode:
+     * Fork one streaming process per device before any UHD state
+     * exists. Each child pins itself to its CPU group, falls through
+     * to the normal single-device flow below, and reports its
+     * counters through a shared memory block. The parent waits,
+     * aggregates, and prints/dumps the combined results.
+     **************************************************************/
+    int child_index = -1;
+    std::vector<std::string> multi_args_list;
+    benchmark_results_t *shm_results = NULL;
+    if (vm.count("multi_args")){
+#ifdef UHD_PLATFORM_LINUX
+        boost::split(multi_args_list, multi_args, boost::is_any_of(";"));
+        multi_args_list.erase(
+            std::remove(multi_args_list.begin(), multi_args_list.end(), std::string()),
+            multi_args_list.end());
+        if (multi_args_list.empty()){
+            std::cerr << "ERROR: multi_args contains no device args." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        shm_results = static_cast<benchmark_results_t *>(::mmap(
+            NULL, multi_args_list.size() * sizeof(benchmark_results_t),
+            PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+        if (shm_results == MAP_FAILED){
+            throw std::runtime_error("Could not map shared memory for results.");
+        }
+        std::memset(shm_results, 0, multi_args_list.size() * sizeof(benchmark_results_t));
+
+        std::vector<pid_t> child_pids;
+        for (size_t i = 0; i < multi_args_list.size(); i++){
+            const pid_t pid = ::fork();
+            if (pid < 0) throw std::runtime_error("fork failed");
+            if (pid == 0){
+                child_index = int(i);
+                args = multi_args_list[i];
+                break;
+            }
+            child_pids.push_back(pid);
+        }
+
+        if (child_index < 0){
+            //parent: wait for the children and aggregate their results
+            int exit_code = EXIT_SUCCESS;
+            for (size_t i = 0; i < child_pids.size(); i++){
+                int status = 0;
+                ::waitpid(child_pids[i], &status, 0);
+                shm_results[i].exit_code =
+                    WIFEXITED(status)? WEXITSTATUS(status) : EXIT_FAILURE;
+                if (shm_results[i].exit_code != EXIT_SUCCESS) exit_code = EXIT_FAILURE;
+            }
+            std::vector<benchmark_results_t> all_results(
+                shm_results, shm_results + multi_args_list.size());
+            for (size_t i = 0; i < all_results.size(); i++){
+                std::cout << std::endl << "Device " << i
+                    << " (" << multi_args_list[i] << "), exit code "
+                    << all_results[i].exit_code << ":";
+                print_summary(all_results[i]);
+            }
+            if (vm.count("json")){
+                write_json_results(json_path, multi_args_list, all_results);
+            }
+            return exit_code;
+        }
+
+        //child: select this device's group of the CPU affinity list
+        if (vm.count("cpu_affinity")){
+            std::vector<std::string> affinity_groups;
+            boost::split(affinity_groups, cpu_affinity, boost::is_any_of(";"));
+            cpu_affinity = (size_t(child_index) < affinity_groups.size())?
+                affinity_groups[child_index] : std::string();
+        }
+#else
+        std::cerr << "ERROR: multi_args mode is only supported on Linux." << std::endl;
+        return EXIT_FAILURE;
+#endif
+    }
+
+    if (vm.count("cpu_affinity") and not cpu_affinity.empty()){
+        apply_cpu_affinity(cpu_affinity);
+    }
+
     //create a usrp device
     std::cout << std::endl;
     uhd::device_addrs_t device_addrs = uhd::device::find(args, uhd::device::USRP);
@@ -561,33 +811,12 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
     const bool seq_threshold_err =
         vm.count("seq-threshold") and
         num_seq_errors > seq_threshold;
-    std::cout << std::endl
-        << boost::format(
-                "Benchmark rate summary:\n"
-                "  Num received samples:     %u\n"
-                "  Num dropped samples:      %u\n"
-                "  Num overruns detected:    %u\n"
-                "  Num transmitted samples:  %u\n"
-                "  Num sequence errors (Tx): %u\n"
-                "  Num sequence errors (Rx): %u\n"
-                "  Num underruns detected:   %u\n"
-                "  Num late commands:        %u\n"
-                "  Num timeouts (Tx):        %u\n"
-                "  Num timeouts (Rx):        %u\n"
-            ) % num_rx_samps
-              % num_dropped_samps
-              % num_overruns
-              % num_tx_samps
-              % num_seq_errors
-              % num_seqrx_errors
-              % num_underruns
-              % num_late_commands
-              % num_timeouts_tx
-              % num_timeouts_rx
-        << std::endl;
+    benchmark_results_t results = collect_results();
+    print_summary(results);
     //finished
     std::cout << std::endl << "Done!" << std::endl << std::endl;
 
+    int exit_code = EXIT_SUCCESS;
     if (overrun_threshold_err
             || underrun_threshold_err
             || drop_threshold_err
@@ -621,7 +850,23 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
                    % seq_threshold
                 << std::endl;
         }
-        return EXIT_FAILURE;
+        exit_code = EXIT_FAILURE;
+    }
+
+#ifdef UHD_PLATFORM_LINUX
+    //multi-process child: report into the parent's shared memory slot
+    if (child_index >= 0){
+        results.exit_code = exit_code;
+        shm_results[child_index] = results;
+        return exit_code;
+    }
+#endif
+
+    if (vm.count("json")){
+        results.exit_code = exit_code;
+        write_json_results(json_path,
+            std::vector<std::string>(1, args),
+            std::vector<benchmark_results_t>(1, results));
     }
-    return EXIT_SUCCESS;
+    return exit_code;
 }
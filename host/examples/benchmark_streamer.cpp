@@ -16,6 +16,7 @@
 #include <boost/format.hpp>
 #include <iostream>
 #include <iomanip>
+#include <fstream>
 #include <thread>
 #include <chrono>
 
@@ -248,6 +249,32 @@ void print_tx_results(
     std::cout << "Calculated throughput: " << results.host.num_samples / results.host.seconds / 1e6 << " Msps" << std::endl;
 }
 
+// Append one machine-readable record per measurement. The records are
+// JSON objects, one per line, so repeated invocations of this tool can
+// share an output file and benchmark_streamer_suite.py can sweep
+// parameters across processes and diff the results against a baseline.
+void append_json_record(
+    const std::string& json_path,
+    const std::string& test,
+    const std::string& format,
+    const test_results& results
+) {
+    if (json_path.empty()) {
+        return;
+    }
+    std::ofstream json_file(json_path.c_str(), std::ofstream::app);
+    json_file << "{"
+        << "\"test\": \"" << test << "\", "
+        << "\"format\": \"" << format << "\", "
+        << "\"spp\": " << results.host.spp << ", "
+        << "\"seconds\": " << results.host.seconds << ", "
+        << "\"num_samples\": " << results.host.num_samples << ", "
+        << "\"num_packets\": " << results.host.num_packets << ", "
+        << "\"throughput_msps\": "
+        << results.host.num_samples / results.host.seconds / 1e6
+        << "}" << std::endl;
+}
+
 uhd::rx_streamer::sptr configure_rx_streamer(
     uhd::device3::sptr usrp,
     const std::string& nullid,
@@ -486,6 +513,7 @@ test_results benchmark_tx_streamer(
 int UHD_SAFE_MAIN(int argc, char *argv[]){
     //variables to be set by po
     std::string args, format, fifoid0, ddcid0, ducid0, ddcid1, ducid1;
+    std::string json_path;
     std::string nullid0, nullid1, nullid2, nullid3;
     double rx_duration, tx_duration, dual_rx_duration, dual_tx_duration;
     double full_duplex_duration, dual_full_duplex_duration;
@@ -505,6 +533,7 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
         ("dual_full_duplex_duration", po::value<double>(&dual_full_duplex_duration)->default_value(0.0), "duration for the dual full duplex test in seconds")
         ("spp", po::value<size_t>(&spp)->default_value(0), "samples per packet (on FPGA and wire)")
         ("format", po::value<std::string>(&format)->default_value("sc16"), "Host sample type: sc16, fc32, or fc64")
+        ("json", po::value<std::string>(&json_path)->default_value(""), "Optional: append machine-readable results to this file, one JSON record per measurement")
         ("bus_clk_freq", po::value<double>(&bus_clk_freq)->default_value(187.5e6), "Bus clock frequency for throughput calculation (default: 187.5e6)")
         ("nullid0", po::value<std::string>(&nullid0)->default_value("0/NullSrcSink_0"), "The block ID for the null source.")
         ("nullid1", po::value<std::string>(&nullid1)->default_value("0/NullSrcSink_1"), "The block ID for the second null source in measurements with two streamers.")
@@ -561,6 +590,7 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
         auto results = benchmark_rx_streamer(usrp, rx_stream, nullid0,
             rx_duration, format);
         print_rx_results(results, bus_clk_freq);
+        append_json_record(json_path, "rx", format, results);
     }
 
     if (tx_duration != 0.0) {
@@ -570,6 +600,7 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
         auto results = benchmark_tx_streamer(usrp, tx_stream, nullid0,
             tx_duration, format);
         print_tx_results(results, bus_clk_freq);
+        append_json_record(json_path, "tx", format, results);
     }
 
     if (dual_rx_duration != 0.0) {
@@ -596,6 +627,8 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
 
         print_rx_results(results0, bus_clk_freq);
         print_rx_results(results1, bus_clk_freq);
+        append_json_record(json_path, "dual_rx_0", format, results0);
+        append_json_record(json_path, "dual_rx_1", format, results1);
     }
 
     if (dual_tx_duration != 0.0) {
@@ -622,6 +655,8 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
 
         print_tx_results(results0, bus_clk_freq);
         print_tx_results(results1, bus_clk_freq);
+        append_json_record(json_path, "dual_tx_0", format, results0);
+        append_json_record(json_path, "dual_tx_1", format, results1);
     }
 
     if (full_duplex_duration != 0.0) {
@@ -648,6 +683,8 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
 
         print_tx_results(tx_results, bus_clk_freq);
         print_rx_results(rx_results, bus_clk_freq);
+        append_json_record(json_path, "full_duplex_tx", format, tx_results);
+        append_json_record(json_path, "full_duplex_rx", format, rx_results);
     }
 
     if (dual_full_duplex_duration != 0.0) {
@@ -692,6 +729,10 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
         print_tx_results(tx_results1, bus_clk_freq);
         print_rx_results(rx_results0, bus_clk_freq);
         print_rx_results(rx_results1, bus_clk_freq);
+        append_json_record(json_path, "dual_full_duplex_tx_0", format, tx_results0);
+        append_json_record(json_path, "dual_full_duplex_tx_1", format, tx_results1);
+        append_json_record(json_path, "dual_full_duplex_rx_0", format, rx_results0);
+        append_json_record(json_path, "dual_full_duplex_rx_1", format, rx_results1);
     }
 
     return EXIT_SUCCESS;
@@ -0,0 +1,177 @@
+#!/usr/bin/env python
+#
+# Copyright 2018 Ettus Research, a National Instruments Company
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+"""
+Drive benchmark_streamer as an automated throughput regression suite.
+
+Sweeps a parameter grid (tests x formats x spp) against a device whose
+FPGA image provides null source/sink blocks with traffic counters, so a
+full run needs no RF hardware or cabling. Results are compared against
+a JSON baseline file with a configurable tolerance; the exit code is
+non-zero when any case regressed, which makes the suite suitable as a
+gate in an upgrade pipeline:
+
+    # record a baseline on a known-good build
+    benchmark_streamer_suite.py --args <...> --baseline base.json --save-baseline
+
+    # later, fail the pipeline on a throughput regression
+    benchmark_streamer_suite.py --args <...> --baseline base.json
+"""
+
+from __future__ import print_function
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+DEFAULT_TESTS = 'rx,tx,full_duplex'
+DEFAULT_FORMATS = 'sc16,fc32'
+DEFAULT_SPPS = '0'
+
+
+def parse_args():
+    """ Parse args, duh """
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+    )
+    parser.add_argument(
+        '--benchmark-streamer', default='./benchmark_streamer',
+        help='Path to the benchmark_streamer binary',
+    )
+    parser.add_argument(
+        '--args', default='',
+        help='Device address args passed through to benchmark_streamer',
+    )
+    parser.add_argument(
+        '--tests', default=DEFAULT_TESTS,
+        help='Comma-separated subset of: rx, tx, dual_rx, dual_tx, '
+             'full_duplex, dual_full_duplex',
+    )
+    parser.add_argument(
+        '--formats', default=DEFAULT_FORMATS,
+        help='Comma-separated host formats to sweep (sc16, fc32, fc64)',
+    )
+    parser.add_argument(
+        '--spps', default=DEFAULT_SPPS,
+        help='Comma-separated samples-per-packet values (0 = device default)',
+    )
+    parser.add_argument(
+        '--duration', type=float, default=2.0,
+        help='Measurement duration per case in seconds',
+    )
+    parser.add_argument(
+        '--baseline', default=None,
+        help='JSON baseline file to compare against (or write, with '
+             '--save-baseline)',
+    )
+    parser.add_argument(
+        '--save-baseline', action='store_true',
+        help='Write the measured throughputs to the baseline file instead '
+             'of comparing',
+    )
+    parser.add_argument(
+        '--tolerance', type=float, default=10.0,
+        help='Allowed throughput drop below baseline in percent',
+    )
+    parser.add_argument(
+        '--extra-args', default='',
+        help='Extra arguments appended to every benchmark_streamer call, '
+             'e.g. block IDs for a non-default FPGA image',
+    )
+    return parser.parse_args()
+
+
+def run_one_case(args, test, fmt, spp):
+    """
+    Run benchmark_streamer for a single grid point and return the list of
+    result records it produced (a multi-streamer test yields several).
+    """
+    handle, json_path = tempfile.mkstemp(suffix='.json')
+    os.close(handle)
+    os.unlink(json_path)
+    call_args = [
+        args.benchmark_streamer,
+        '--args', args.args,
+        '--{0}_duration'.format(test), str(args.duration),
+        '--format', fmt,
+        '--spp', str(spp),
+        '--json', json_path,
+    ] + args.extra_args.split()
+    try:
+        subprocess.check_output(call_args, stderr=subprocess.STDOUT)
+    except subprocess.CalledProcessError as ex:
+        print(ex.output)
+        raise
+    try:
+        with open(json_path) as json_file:
+            return [json.loads(line) for line in json_file if line.strip()]
+    finally:
+        if os.path.exists(json_path):
+            os.unlink(json_path)
+
+
+def case_key(record, spp_arg):
+    """ Stable baseline key: which test, at which parameters """
+    return '{test}/{format}/spp{spp}'.format(
+        test=record['test'], format=record['format'], spp=spp_arg)
+
+
+def main():
+    """ Go, go, go! """
+    args = parse_args()
+    baseline = {}
+    if args.baseline and not args.save_baseline:
+        with open(args.baseline) as baseline_file:
+            baseline = json.load(baseline_file)
+
+    measured = {}
+    failures = []
+    for test in args.tests.split(','):
+        for fmt in args.formats.split(','):
+            for spp in args.spps.split(','):
+                print('== Running: test={0} format={1} spp={2}'.format(
+                    test, fmt, spp))
+                for record in run_one_case(args, test, fmt, spp):
+                    key = case_key(record, spp)
+                    throughput = record['throughput_msps']
+                    measured[key] = throughput
+                    if key not in baseline:
+                        print('   {0}: {1:.2f} Msps (no baseline)'.format(
+                            key, throughput))
+                        continue
+                    floor = baseline[key] * (1.0 - args.tolerance / 100.0)
+                    verdict = 'PASS' if throughput >= floor else 'FAIL'
+                    print('   {0}: {1:.2f} Msps (baseline {2:.2f}, '
+                          'floor {3:.2f}) {4}'.format(
+                              key, throughput, baseline[key], floor, verdict))
+                    if throughput < floor:
+                        failures.append(key)
+
+    if args.save_baseline:
+        if not args.baseline:
+            print('error: --save-baseline requires --baseline')
+            return 1
+        with open(args.baseline, 'w') as baseline_file:
+            json.dump(measured, baseline_file, indent=4, sort_keys=True)
+        print('Wrote baseline with {0} cases to {1}'.format(
+            len(measured), args.baseline))
+        return 0
+
+    if failures:
+        print('Throughput regressions detected in {0} case(s):'.format(
+            len(failures)))
+        for key in failures:
+            print('   ' + key)
+        return 1
+    print('All {0} cases within tolerance.'.format(len(measured)))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -10,18 +10,133 @@
 #include <uhd/usrp/multi_usrp.hpp>
 #include <boost/program_options.hpp>
 #include <boost/format.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
 #include <iostream>
 #include <complex>
+#include <vector>
 
 namespace po = boost::program_options;
 
+/***********************************************************************
+ * Latency statistics:
+ * Every iteration's host-side turnaround time lands here, so after a
+ * run we can report the percentiles and the tail, not just an average.
+ **********************************************************************/
+struct latency_stats_t{
+    //! one measured round trip with the wall clock time it happened at
+    struct sample_t{
+        size_t run;
+        double rtt_us;
+        int64_t wall_time_us; //microseconds since the epoch
+    };
+
+    std::vector<sample_t> samples;
+
+    void record(const size_t run, const double rtt_us){
+        sample_t sample;
+        sample.run = run;
+        sample.rtt_us = rtt_us;
+        sample.wall_time_us =
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+        samples.push_back(sample);
+    }
+
+    //! the given percentile of the recorded round trips (sorts a copy)
+    double percentile(const double pct) const{
+        if (samples.empty()) return 0.0;
+        std::vector<double> rtts;
+        rtts.reserve(samples.size());
+        for (size_t i = 0; i < samples.size(); i++){
+            rtts.push_back(samples[i].rtt_us);
+        }
+        std::sort(rtts.begin(), rtts.end());
+        const size_t index = std::min(
+            rtts.size() - 1, size_t((pct / 100.0) * double(rtts.size())));
+        return rtts[index];
+    }
+
+    //! the samples above the given threshold, worst first
+    std::vector<sample_t> outliers_above(const double threshold_us) const{
+        std::vector<sample_t> result;
+        for (size_t i = 0; i < samples.size(); i++){
+            if (samples[i].rtt_us > threshold_us) result.push_back(samples[i]);
+        }
+        std::sort(result.begin(), result.end(),
+            [](const sample_t &lhs, const sample_t &rhs){
+                return lhs.rtt_us > rhs.rtt_us;
+            });
+        return result;
+    }
+};
+
+//! format an epoch microsecond count as HH:MM:SS.uuuuuu local time
+static std::string wall_time_str(const int64_t wall_time_us){
+    const std::time_t secs = std::time_t(wall_time_us / 1000000);
+    char buff[32];
+    std::strftime(buff, sizeof(buff), "%H:%M:%S", std::localtime(&secs));
+    return str(boost::format("%s.%06d") % buff % (wall_time_us % 1000000));
+}
+
+//! print an HDR-style histogram: doubling buckets with cumulative percentages
+static void print_histogram(const latency_stats_t &stats){
+    if (stats.samples.empty()) return;
+    double max_rtt = 0.0;
+    for (size_t i = 0; i < stats.samples.size(); i++){
+        max_rtt = std::max(max_rtt, stats.samples[i].rtt_us);
+    }
+    std::vector<size_t> buckets;
+    for (double hi = 1.0; ; hi *= 2){
+        buckets.push_back(0);
+        if (hi > max_rtt) break;
+    }
+    for (size_t i = 0; i < stats.samples.size(); i++){
+        size_t bucket = 0;
+        for (double hi = 1.0; hi <= stats.samples[i].rtt_us; hi *= 2) bucket++;
+        buckets[bucket]++;
+    }
+    std::cout << "RTT histogram (us):" << std::endl;
+    size_t cumulative = 0;
+    double lo = 0.0;
+    double hi = 1.0;
+    for (size_t i = 0; i < buckets.size(); i++){
+        cumulative += buckets[i];
+        if (buckets[i] != 0){
+            std::cout << boost::format("  [%10.0f, %10.0f): %6d  %6.2f%%")
+                % lo % hi % buckets[i]
+                % (100.0 * double(cumulative) / double(stats.samples.size()))
+            << std::endl;
+        }
+        lo = hi;
+        hi *= 2;
+    }
+}
+
+//! parse a comma-separated list of values for the sweep options
+template <typename T>
+static std::vector<T> parse_list(const std::string &list_str){
+    std::vector<std::string> items;
+    boost::split(items, list_str, boost::is_any_of("\"',"));
+    std::vector<T> result;
+    for (size_t i = 0; i < items.size(); i++){
+        if (items[i].empty()) continue;
+        result.push_back(boost::lexical_cast<T>(items[i]));
+    }
+    return result;
+}
+
 int UHD_SAFE_MAIN(int argc, char *argv[]){
     uhd::set_thread_priority_safe();
 
     //variables to be set by po
     std::string args;
-    size_t nsamps;
-    double rate;
+    std::string nsamps_list;
+    std::string rate_list;
     double rtt;
     size_t nruns;
 
@@ -30,10 +145,11 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
     desc.add_options()
         ("help", "help message")
         ("args",   po::value<std::string>(&args)->default_value(""), "single uhd device address args")
-        ("nsamps", po::value<size_t>(&nsamps)->default_value(100),   "number of samples per run")
-        ("nruns",  po::value<size_t>(&nruns)->default_value(1000),   "number of tests to perform")
+        ("nsamps", po::value<std::string>(&nsamps_list)->default_value("100"), "number of samples per run (comma-separated list to sweep)")
+        ("nruns",  po::value<size_t>(&nruns)->default_value(1000),   "number of tests to perform per sweep point")
         ("rtt",    po::value<double>(&rtt)->default_value(0.001),    "delay between receive and transmit (seconds)")
-        ("rate",   po::value<double>(&rate)->default_value(100e6/4), "sample rate for receive and transmit (sps)")
+        ("rate",   po::value<std::string>(&rate_list)->default_value("25e6"), "sample rate for receive and transmit (comma-separated list to sweep)")
+        ("histogram", "specify to print the per-sweep-point RTT histogram")
         ("verbose", "specify to enable inner-loop verbose")
     ;
     po::variables_map vm;
@@ -53,7 +169,10 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
         "    arrive too late at the device indicate an error.\n"
         "    The smallest value of rtt that does not indicate an error is an\n"
         "    approximation for the time it takes for a sample packet to\n"
-        "    go to UHD and back to the device."
+        "    go to UHD and back to the device.\n"
+        "    The host-side turnaround of every run (packet received to burst\n"
+        "    acknowledged) is also recorded, and its percentiles and worst\n"
+        "    outliers are reported per sweep point."
         << std::endl;
         return EXIT_SUCCESS;
     }
@@ -68,6 +187,10 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
 
     usrp->set_time_now(uhd::time_spec_t(0.0));
 
+    const std::vector<double> rates = parse_list<double>(rate_list);
+    const std::vector<size_t> nsamps_sweep = parse_list<size_t>(nsamps_list);
+
+    for (const double rate : rates){
     //set the tx sample rate
     usrp->set_tx_rate(rate);
     std::cout
@@ -82,19 +205,22 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
             % (usrp->get_rx_rate()/1e6)
         << std::endl;
 
-    //allocate a buffer to use
-    std::vector<std::complex<float> > buffer(nsamps);
-
     //create RX and TX streamers
     uhd::stream_args_t stream_args("fc32"); //complex floats
     uhd::rx_streamer::sptr rx_stream = usrp->get_rx_stream(stream_args);
     uhd::tx_streamer::sptr tx_stream = usrp->get_tx_stream(stream_args);
 
+    for (const size_t nsamps : nsamps_sweep){
+
+    //allocate a buffer to use
+    std::vector<std::complex<float> > buffer(nsamps);
+
     //initialize result counts
     int time_error = 0;
     int ack = 0;
     int underflow = 0;
     int other = 0;
+    latency_stats_t stats;
 
     for(size_t nrun = 0; nrun < nruns; nrun++){
 
@@ -114,6 +240,7 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
         size_t num_rx_samps = rx_stream->recv(
             &buffer.front(), buffer.size(), rx_md
         );
+        const auto recv_time = std::chrono::steady_clock::now();
 
         if (verbose) {
             std::cout << boost::format(
@@ -160,6 +287,9 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
 
         case uhd::async_metadata_t::EVENT_CODE_BURST_ACK:
             ack++;
+            //record the host-side turnaround: packet in hand to burst acked
+            stats.record(nrun, std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - recv_time).count());
             break;
 
         case uhd::async_metadata_t::EVENT_CODE_UNDERFLOW:
@@ -206,16 +336,46 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
     }
 
     /***************************************************************
-     * Print the summary
+     * Print the summary for this sweep point
      **************************************************************/
     std::cout << "Summary\n"
               << "================\n"
+              << "Sample rate:      " << (rate/1e6) << " Msps" << std::endl
+              << "Samples per run:  " << nsamps << std::endl
               << "Number of runs:   " << nruns << std::endl
               << "RTT value tested: " << (rtt*1e3) << " ms" << std::endl
               << "ACKs received:    " << ack << "/" << nruns << std::endl
               << "Underruns:        " << underflow << std::endl
               << "Late packets:     " << time_error << std::endl
-              << "Other errors:     " << other << std::endl
-              << std::endl;
+              << "Other errors:     " << other << std::endl;
+    if (not stats.samples.empty()){
+        const double p99 = stats.percentile(99.0);
+        std::cout
+              << "Turnaround p50:   " << stats.percentile(50.0) << " us" << std::endl
+              << "Turnaround p99:   " << p99 << " us" << std::endl
+              << "Turnaround p99.9: " << stats.percentile(99.9) << " us" << std::endl
+              << "Turnaround max:   " << stats.percentile(100.0) << " us" << std::endl;
+        if (vm.count("histogram")){
+            print_histogram(stats);
+        }
+        //the tail is what breaks timing loops, so name the offenders
+        const std::vector<latency_stats_t::sample_t> outliers =
+            stats.outliers_above(p99);
+        const size_t num_to_print = std::min<size_t>(outliers.size(), 10);
+        if (num_to_print > 0){
+            std::cout << "Worst outliers above p99:" << std::endl;
+            for (size_t i = 0; i < num_to_print; i++){
+                std::cout << boost::format("  run %6d at %s: %.0f us")
+                    % outliers[i].run
+                    % wall_time_str(outliers[i].wall_time_us)
+                    % outliers[i].rtt_us
+                << std::endl;
+            }
+        }
+    }
+    std::cout << std::endl;
+
+    } //for nsamps
+    } //for rate
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,85 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHD_EXAMPLES_MAPPED_FILE_HPP
+#define INCLUDED_UHD_EXAMPLES_MAPPED_FILE_HPP
+
+#include <uhd/config.hpp>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#ifdef UHD_PLATFORM_LINUX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*!
+ * A read-only memory mapping of a sample file (Linux only).
+ *
+ * The streamer can send directly out of the mapped pages, which avoids
+ * the staging copy of the read()-into-a-vector approach. Optionally the
+ * mapping is locked into RAM so playback takes no page faults mid-burst,
+ * and the kernel is advised to read the file ahead sequentially.
+ */
+class mapped_file_t{
+public:
+    mapped_file_t(const std::string &file, const bool lock, const bool readahead):
+        _mem(NULL), _size(0)
+    {
+#ifdef UHD_PLATFORM_LINUX
+        const int fd = ::open(file.c_str(), O_RDONLY);
+        if (fd < 0){
+            throw std::runtime_error("Could not open file: " + file);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0 or st.st_size == 0){
+            ::close(fd);
+            throw std::runtime_error("Could not stat file: " + file);
+        }
+        _size = size_t(st.st_size);
+        void *mem = ::mmap(NULL, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); //the mapping holds its own reference to the file
+        if (mem == MAP_FAILED){
+            throw std::runtime_error("Could not map file: " + file);
+        }
+        _mem = mem;
+        if (readahead){
+            ::madvise(_mem, _size, MADV_SEQUENTIAL);
+            ::madvise(_mem, _size, MADV_WILLNEED);
+        }
+        if (lock and ::mlock(_mem, _size) != 0){
+            std::cerr << "Warning: could not lock file mapping into RAM "
+                         "(check the memlock rlimit)" << std::endl;
+        }
+#else
+        (void)lock; (void)readahead;
+        throw std::runtime_error("Memory-mapped playback is only supported on Linux");
+#endif
+    }
+
+    ~mapped_file_t(void){
+#ifdef UHD_PLATFORM_LINUX
+        if (_mem != NULL) ::munmap(_mem, _size);
+#endif
+    }
+
+    const char *data(void) const{
+        return static_cast<const char *>(_mem);
+    }
+
+    size_t size(void) const{
+        return _size;
+    }
+
+private:
+    void *_mem;
+    size_t _size;
+};
+
+#endif /* INCLUDED_UHD_EXAMPLES_MAPPED_FILE_HPP */
@@ -10,15 +10,24 @@
 #include <boost/program_options.hpp>
 #include <boost/thread/condition_variable.hpp>
 #include <boost/thread/thread.hpp>
+#include <boost/algorithm/string.hpp>
 #include <boost/format.hpp>
 #include <boost/asio.hpp>
+#include <algorithm>
 #include <iostream>
 #include <csignal>
+#include <cstring>
 #include <vector>
 #include <cstdlib>
 #include <chrono>
 #include <thread>
 
+#ifdef UHD_PLATFORM_LINUX
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+
 namespace po = boost::program_options;
 namespace asio = boost::asio;
 
@@ -26,6 +35,9 @@ typedef boost::shared_ptr<asio::ip::udp::socket> socket_type;
 
 static const size_t insane_mtu = 9000;
 
+//number of datagrams moved per recvmmsg/sendmmsg call
+static const size_t relay_batch_size = 32;
+
 #if defined(UHD_PLATFORM_MACOS)
     //limit buffer resize on macos or it will error
     const size_t rx_dsp_buff_size = size_t(1e6);
@@ -64,38 +76,65 @@ class udp_relay_type{
 public:
     udp_relay_type(
         const std::string &server_addr,
-        const std::string &client_addr,
+        const std::vector<std::string> &client_addrs,
         const std::string &port,
         const size_t server_rx_size = 0,
         const size_t server_tx_size = 0,
         const size_t client_rx_size = 0,
-        const size_t client_tx_size = 0
-    ):_port(port){
-        {
-            asio::ip::udp::resolver resolver(_io_service);
-            asio::ip::udp::resolver::query query(asio::ip::udp::v4(), server_addr, port);
-            asio::ip::udp::endpoint endpoint = *resolver.resolve(query);
-
-            _server_socket = boost::shared_ptr<asio::ip::udp::socket>(new asio::ip::udp::socket(_io_service, endpoint));
-            resize_buffs(_server_socket, server_rx_size, server_tx_size);
+        const size_t client_tx_size = 0,
+        const size_t num_workers = 1,
+        const bool steer_sid = false
+    ):
+        _port(port),
+        _num_devices(client_addrs.size()),
+        _steer_sid(steer_sid),
+        _endpoint_valid(false)
+    {
+        //resolve the host-facing endpoint once, all workers bind to it
+        asio::ip::udp::resolver resolver(_io_service);
+        asio::ip::udp::resolver::query server_query(asio::ip::udp::v4(), server_addr, port);
+        asio::ip::udp::endpoint server_endpoint = *resolver.resolve(server_query);
+
+        //one host-facing socket per worker; with more than one worker the
+        //kernel steers flows across the sockets via SO_REUSEPORT
+        for (size_t i = 0; i < num_workers; i++){
+            socket_type sock(new asio::ip::udp::socket(_io_service));
+            sock->open(asio::ip::udp::v4());
+            #if defined(UHD_PLATFORM_LINUX) && defined(SO_REUSEPORT)
+            if (num_workers > 1){
+                const int enable = 1;
+                ::setsockopt(sock->native_handle(), SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable));
+            }
+            #endif
+            sock->bind(server_endpoint);
+            resize_buffs(sock, server_rx_size, server_tx_size);
+            _server_sockets.push_back(sock);
         }
-        {
-            asio::ip::udp::resolver resolver(_io_service);
-            asio::ip::udp::resolver::query query(asio::ip::udp::v4(), client_addr, port);
-            asio::ip::udp::endpoint endpoint = *resolver.resolve(query);
-
-            _client_socket = boost::shared_ptr<asio::ip::udp::socket>(new asio::ip::udp::socket(_io_service));
-            _client_socket->open(asio::ip::udp::v4());
-            _client_socket->connect(endpoint);
-            resize_buffs(_client_socket, client_rx_size, client_tx_size);
+
+        //one device-facing socket per worker and device; connected so the
+        //send path does not need a destination per datagram
+        for (size_t i = 0; i < num_workers; i++){
+            for (size_t j = 0; j < _num_devices; j++){
+                asio::ip::udp::resolver::query query(asio::ip::udp::v4(), client_addrs[j], port);
+                asio::ip::udp::endpoint endpoint = *resolver.resolve(query);
+                socket_type sock(new asio::ip::udp::socket(_io_service));
+                sock->open(asio::ip::udp::v4());
+                sock->connect(endpoint);
+                resize_buffs(sock, client_rx_size, client_tx_size);
+                _client_sockets.push_back(sock);
+            }
         }
 
         std::cout << "spawning relay threads... " << _port << std::endl;
         boost::unique_lock<boost::mutex> lock(spawn_mutex);     // lock in preparation to wait for threads to spawn
-        (void)_thread_group.create_thread(boost::bind(&udp_relay_type::server_thread, this));
-        wait_for_thread.wait(lock);      // wait for thread to spin up
-        (void)_thread_group.create_thread(boost::bind(&udp_relay_type::client_thread, this));
-        wait_for_thread.wait(lock);      // wait for thread to spin up
+        for (size_t i = 0; i < num_workers; i++){
+            (void)_thread_group.create_thread(boost::bind(&udp_relay_type::server_thread, this, i));
+            wait_for_thread.wait(lock);      // wait for thread to spin up
+            for (size_t j = 0; j < _num_devices; j++){
+                (void)_thread_group.create_thread(boost::bind(&udp_relay_type::client_thread, this, i, j));
+                wait_for_thread.wait(lock);      // wait for thread to spin up
+            }
+        }
         std::cout << "    done!" << std::endl << std::endl;
     }
 
@@ -113,53 +152,174 @@ private:
         if (tx_size != 0) sock->set_option(asio::socket_base::send_buffer_size(tx_size));
     }
 
-    void server_thread(void){
+    //! Pick the destination device for a host-to-device packet.
+    //
+    // Byte offset 4 of a CHDR packet holds the 32-bit SID in network
+    // order; bits [15:8] are the destination device address. Without SID
+    // steering everything goes to the first (only) device.
+    size_t steer_to_device(const char *buff, const size_t len) const{
+        if (not _steer_sid or _num_devices < 2) return 0;
+        if (len < 8) return 0;
+        uint32_t sid;
+        std::memcpy(&sid, buff + 4, sizeof(sid));
+        sid = ntohl(sid);
+        return size_t((sid >> 8) & 0xff) % _num_devices;
+    }
+
+    void server_thread(const size_t worker){
         uhd::set_thread_priority_safe();
         std::cout << "    entering server_thread..." << std::endl;
         wait_for_thread.notify_one();    // notify constructor that this thread has started
+        socket_type sock = _server_sockets[worker];
+#ifdef UHD_PLATFORM_LINUX
+        //batched host -> device forwarding with recvmmsg/sendmmsg
+        std::vector<char> buffs(relay_batch_size * insane_mtu);
+        std::vector<iovec> iovecs(relay_batch_size);
+        std::vector<mmsghdr> msgs(relay_batch_size);
+        std::vector<sockaddr_in> names(relay_batch_size);
+        for (size_t i = 0; i < relay_batch_size; i++){
+            iovecs[i].iov_base = &buffs[i * insane_mtu];
+            iovecs[i].iov_len = insane_mtu;
+            std::memset(&msgs[i], 0, sizeof(mmsghdr));
+            msgs[i].msg_hdr.msg_iov = &iovecs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_name = &names[i];
+        }
+        std::vector<iovec> out_iovecs(relay_batch_size);
+        std::vector<mmsghdr> out_msgs(relay_batch_size);
+        while (not boost::this_thread::interruption_requested()){
+            if (not wait_for_recv_ready(sock->native_handle())) continue;
+
+            //the kernel shrinks msg_namelen, restore it before each call
+            for (size_t i = 0; i < relay_batch_size; i++){
+                msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            }
+            const int num_recvd = ::recvmmsg(
+                sock->native_handle(), &msgs.front(), relay_batch_size, MSG_DONTWAIT, NULL
+            );
+            if (num_recvd <= 0) continue;
+
+            //remember where the host is so the device -> host path can reply
+            {
+                boost::mutex::scoped_lock lock(_endpoint_mutex);
+                std::memcpy(&_host_addr, &names[0], sizeof(sockaddr_in));
+                _endpoint_valid = true;
+            }
+
+            //group the batch by destination device and forward each group
+            for (size_t dev = 0; dev < _num_devices; dev++){
+                size_t num_out = 0;
+                for (int i = 0; i < num_recvd; i++){
+                    if (steer_to_device(&buffs[i * insane_mtu], msgs[i].msg_len) != dev) continue;
+                    out_iovecs[num_out].iov_base = &buffs[i * insane_mtu];
+                    out_iovecs[num_out].iov_len = msgs[i].msg_len;
+                    std::memset(&out_msgs[num_out], 0, sizeof(mmsghdr));
+                    out_msgs[num_out].msg_hdr.msg_iov = &out_iovecs[num_out];
+                    out_msgs[num_out].msg_hdr.msg_iovlen = 1;
+                    num_out++;
+                }
+                if (num_out == 0) continue;
+                const int fd = _client_sockets[worker * _num_devices + dev]->native_handle();
+                size_t num_sent = 0;
+                while (num_sent < num_out){
+                    const int ret = ::sendmmsg(fd, &out_msgs[num_sent], num_out - num_sent, 0);
+                    if (ret <= 0) break;
+                    num_sent += ret;
+                }
+            }
+        }
+#else
         std::vector<char> buff(insane_mtu);
         while (not boost::this_thread::interruption_requested()){
-            if (wait_for_recv_ready(_server_socket->native_handle())){
+            if (wait_for_recv_ready(sock->native_handle())){
                 boost::mutex::scoped_lock lock(_endpoint_mutex);
-                const size_t len = _server_socket->receive_from(asio::buffer(&buff.front(), buff.size()), _endpoint);
+                const size_t len = sock->receive_from(asio::buffer(&buff.front(), buff.size()), _endpoint);
+                _endpoint_valid = true;
                 lock.unlock();
-                _client_socket->send(asio::buffer(&buff.front(), len));
-
-                //perform sequence error detection on tx dsp data (can detect bad network cards)
-                /*
-                if (_port[4] == '7'){
-                    static uint32_t next_seq;
-                    const uint32_t this_seq = ntohl(reinterpret_cast<const uint32_t *>(&buff.front())[0]);
-                    if (next_seq != this_seq and this_seq != 0) std::cout << "S" << std::flush;
-                    next_seq = this_seq + 1;
-                }
-                */
+                const size_t dev = steer_to_device(&buff.front(), len);
+                _client_sockets[worker * _num_devices + dev]->send(asio::buffer(&buff.front(), len));
             }
         }
+#endif
         std::cout << "    exiting server_thread..." << std::endl;
     }
 
-    void client_thread(void){
+    void client_thread(const size_t worker, const size_t device){
         uhd::set_thread_priority_safe();
         std::cout << "    entering client_thread..." << std::endl;
         wait_for_thread.notify_one();    // notify constructor that this thread has started
+        socket_type sock = _client_sockets[worker * _num_devices + device];
+#ifdef UHD_PLATFORM_LINUX
+        //batched device -> host forwarding with recvmmsg/sendmmsg
+        std::vector<char> buffs(relay_batch_size * insane_mtu);
+        std::vector<iovec> iovecs(relay_batch_size);
+        std::vector<mmsghdr> msgs(relay_batch_size);
+        for (size_t i = 0; i < relay_batch_size; i++){
+            iovecs[i].iov_base = &buffs[i * insane_mtu];
+            iovecs[i].iov_len = insane_mtu;
+            std::memset(&msgs[i], 0, sizeof(mmsghdr));
+            msgs[i].msg_hdr.msg_iov = &iovecs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        while (not boost::this_thread::interruption_requested()){
+            if (not wait_for_recv_ready(sock->native_handle())) continue;
+            const int num_recvd = ::recvmmsg(
+                sock->native_handle(), &msgs.front(), relay_batch_size, MSG_DONTWAIT, NULL
+            );
+            if (num_recvd <= 0) continue;
+
+            sockaddr_in host_addr;
+            {
+                boost::mutex::scoped_lock lock(_endpoint_mutex);
+                if (not _endpoint_valid) continue; //no host seen yet, drop
+                std::memcpy(&host_addr, &_host_addr, sizeof(sockaddr_in));
+            }
+            for (int i = 0; i < num_recvd; i++){
+                iovecs[i].iov_len = msgs[i].msg_len;
+                msgs[i].msg_hdr.msg_name = &host_addr;
+                msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            }
+            const int fd = _server_sockets[worker]->native_handle();
+            int num_sent = 0;
+            while (num_sent < num_recvd){
+                const int ret = ::sendmmsg(fd, &msgs[num_sent], num_recvd - num_sent, 0);
+                if (ret <= 0) break;
+                num_sent += ret;
+            }
+
+            //restore the full buffer lengths and detach the names
+            for (int i = 0; i < num_recvd; i++){
+                iovecs[i].iov_len = insane_mtu;
+                msgs[i].msg_hdr.msg_name = NULL;
+                msgs[i].msg_hdr.msg_namelen = 0;
+            }
+        }
+#else
         std::vector<char> buff(insane_mtu);
         while (not boost::this_thread::interruption_requested()){
-            if (wait_for_recv_ready(_client_socket->native_handle())){
-                const size_t len = _client_socket->receive(asio::buffer(&buff.front(), buff.size()));
+            if (wait_for_recv_ready(sock->native_handle())){
+                const size_t len = sock->receive(asio::buffer(&buff.front(), buff.size()));
                 boost::mutex::scoped_lock lock(_endpoint_mutex);
-                _server_socket->send_to(asio::buffer(&buff.front(), len), _endpoint);
+                if (not _endpoint_valid) continue; //no host seen yet, drop
+                _server_sockets[worker]->send_to(asio::buffer(&buff.front(), len), _endpoint);
             }
         }
+#endif
         std::cout << "    exiting client_thread..." << std::endl;
     }
 
     const std::string _port;
+    const size_t _num_devices;
+    const bool _steer_sid;
     boost::thread_group _thread_group;
     asio::io_service _io_service;
     asio::ip::udp::endpoint _endpoint;
+#ifdef UHD_PLATFORM_LINUX
+    sockaddr_in _host_addr;
+#endif
+    bool _endpoint_valid;
     boost::mutex _endpoint_mutex;
-    socket_type _server_socket, _client_socket;
+    std::vector<socket_type> _server_sockets, _client_sockets;
     boost::mutex spawn_mutex;
     boost::condition_variable wait_for_thread;
 };
@@ -174,13 +334,16 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
     //variables to be set by po
     std::string addr;
     std::string bind;
+    size_t workers;
 
     //setup the program options
     po::options_description desc("Allowed options");
     desc.add_options()
         ("help", "help message")
-        ("addr", po::value<std::string>(&addr), "the resolvable address of the usrp (must be specified)")
+        ("addr", po::value<std::string>(&addr), "comma-separated resolvable address(es) of the usrp(s) (must be specified)")
         ("bind", po::value<std::string>(&bind)->default_value("0.0.0.0"), "bind the server to this network address (default: any)")
+        ("workers", po::value<size_t>(&workers)->default_value(1), "worker threads per relay direction (Linux only, uses SO_REUSEPORT)")
+        ("steer-sid", "steer host-to-device packets to the device selected by the CHDR SID destination")
     ;
     po::variables_map vm;
     po::store(po::parse_command_line(argc, argv, desc), vm);
@@ -191,17 +354,36 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
         std::cout
             << boost::format("UHD Network Relay %s") % desc << std::endl
             << "Runs a network relay between UHD on one computer and a USRP on the network.\n"
-            << "This example is basically for test purposes. Use at your own convenience.\n"
+            << "Multiple device addresses fan out the data path by CHDR SID (--steer-sid).\n"
             << std::endl;
         return EXIT_FAILURE;
     }
 
+    //split the comma-separated device list
+    std::vector<std::string> addrs;
+    boost::split(addrs, addr, boost::is_any_of(","), boost::token_compress_on);
+    addrs.erase(std::remove(addrs.begin(), addrs.end(), std::string()), addrs.end());
+    if (addrs.empty()){
+        std::cerr << "No device address specified" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const bool steer_sid = vm.count("steer-sid") > 0;
+    if (workers == 0) workers = 1;
+#ifndef UHD_PLATFORM_LINUX
+    if (workers > 1){
+        std::cout << "Multiple workers require SO_REUSEPORT, falling back to one worker" << std::endl;
+        workers = 1;
+    }
+#endif
+
     {
-        boost::shared_ptr<udp_relay_type> ctrl  (new udp_relay_type(bind, addr, "49152"));
-        boost::shared_ptr<udp_relay_type> rxdsp0(new udp_relay_type(bind, addr, "49156", 0, tx_dsp_buff_size, rx_dsp_buff_size, 0));
-        boost::shared_ptr<udp_relay_type> txdsp0(new udp_relay_type(bind, addr, "49157", tx_dsp_buff_size, 0, 0, tx_dsp_buff_size));
-        boost::shared_ptr<udp_relay_type> rxdsp1(new udp_relay_type(bind, addr, "49158", 0, tx_dsp_buff_size, rx_dsp_buff_size, 0));
-        boost::shared_ptr<udp_relay_type> gps   (new udp_relay_type(bind, addr, "49172"));
+        //control relays stay single-worker, the data ports get the pool
+        boost::shared_ptr<udp_relay_type> ctrl  (new udp_relay_type(bind, addrs, "49152", 0, 0, 0, 0, 1, steer_sid));
+        boost::shared_ptr<udp_relay_type> rxdsp0(new udp_relay_type(bind, addrs, "49156", 0, tx_dsp_buff_size, rx_dsp_buff_size, 0, workers, steer_sid));
+        boost::shared_ptr<udp_relay_type> txdsp0(new udp_relay_type(bind, addrs, "49157", tx_dsp_buff_size, 0, 0, tx_dsp_buff_size, workers, steer_sid));
+        boost::shared_ptr<udp_relay_type> rxdsp1(new udp_relay_type(bind, addrs, "49158", 0, tx_dsp_buff_size, rx_dsp_buff_size, 0, workers, steer_sid));
+        boost::shared_ptr<udp_relay_type> gps   (new udp_relay_type(bind, addrs, "49172", 0, 0, 0, 0, 1, steer_sid));
 
         std::signal(SIGINT, &sig_int_handler);
         std::cout << "Press Ctrl + C to stop streaming..." << std::endl;
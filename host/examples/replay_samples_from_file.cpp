@@ -10,6 +10,7 @@
 // It streams the file data to the Replay block, where it is recorded, then it
 // is played back to the radio.
 
+#include "mapped_file.hpp"
 #include <uhd/utils/safe_main.hpp>
 #include <uhd/device3.hpp>
 #include <uhd/rfnoc/radio_ctrl.hpp>
@@ -18,7 +19,9 @@
 #include <boost/format.hpp>
 #include <fstream>
 #include <csignal>
+#include <memory>
 #include <thread>
+#include <vector>
 
 
 
@@ -79,6 +82,9 @@ int UHD_SAFE_MAIN(int argc, char *argv[])
         ("ant", po::value<std::string>(&ant), "antenna selection")
         ("bw", po::value<double>(&bw), "analog front-end filter bandwidth in Hz")
         ("ref", po::value<std::string>(&ref)->default_value("internal"), "reference source (internal, external, mimo)")
+        ("mmap", "memory-map the file and upload from the mapped pages (Linux only)")
+        ("mlock", "with --mmap, lock the mapping into RAM to avoid page faults mid-upload")
+        ("readahead", "with --mmap, advise the kernel to read the file ahead sequentially")
     ;
     po::variables_map vm;
     po::store(po::parse_command_line(argc, argv, desc), vm);
@@ -213,30 +219,44 @@ int UHD_SAFE_MAIN(int argc, char *argv[])
     ///////////////////////////////////////////////////////////////////////////
     // Read the data to replay
 
-    // Open the file
-    std::ifstream infile(file.c_str(), std::ifstream::binary);
-    if (!infile.is_open()) {
-        std::cerr << "Could not open specified file" << std::endl;
-        return EXIT_FAILURE;
+    std::unique_ptr<mapped_file_t> mapped;
+    std::vector<char> tx_buffer;
+    const char* tx_buf_ptr = NULL;
+    size_t file_size = 0;
+
+    if (vm.count("mmap")) {
+        // Map the file and upload straight from the mapped pages, no
+        // staging copy into a host-side buffer
+        mapped.reset(new mapped_file_t(
+            file, vm.count("mlock") > 0, vm.count("readahead") > 0
+        ));
+        file_size = mapped->size();
+        tx_buf_ptr = mapped->data();
+    }
+    else {
+        // Open the file
+        std::ifstream infile(file.c_str(), std::ifstream::binary);
+        if (!infile.is_open()) {
+            std::cerr << "Could not open specified file" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        // Get the file size
+        infile.seekg(0, std::ios::end);
+        file_size = infile.tellg();
+        infile.seekg(0, std::ios::beg);
+
+        // Read file into buffer, rounded down to number of words
+        tx_buffer.resize((file_size / replay_word_size) * replay_word_size);
+        infile.read(&tx_buffer[0], tx_buffer.size());
+        infile.close();
+        tx_buf_ptr = &tx_buffer[0];
     }
-
-    // Get the file size
-    infile.seekg(0, std::ios::end);
-    size_t file_size = infile.tellg();
-    infile.seekg(0, std::ios::beg);
 
     // Calculate the number of 64-bit words and samples to replay
     size_t words_to_replay = file_size / replay_word_size;
     size_t samples_to_replay = words_to_replay * replay_word_size / bytes_per_sample;
 
-    // Create buffer
-    std::vector<char> tx_buffer(words_to_replay * replay_word_size);
-    char* tx_buf_ptr = &tx_buffer[0];
-
-    // Read file into buffer, rounded down to number of words
-    infile.read(tx_buf_ptr, words_to_replay * replay_word_size);
-    infile.close();
-
 
     ///////////////////////////////////////////////////////////////////////////
     // Configure replay block
@@ -13,18 +13,273 @@
 #include <boost/program_options.hpp>
 #include <boost/format.hpp>
 #include <boost/lexical_cast.hpp>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <condition_variable>
 #include <csignal>
+#include <cstdlib>
+#include <cstring>
 #include <complex>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <chrono>
 
+#ifdef UHD_PLATFORM_LINUX
+#include <fcntl.h>  //open, posix_fallocate
+#include <unistd.h> //write, ftruncate
+#endif
+
 namespace po = boost::program_options;
 
 static bool stop_signal_called = false;
 void sig_int_handler(int){stop_signal_called = true;}
 
+/***********************************************************************
+ * Capture writer:
+ * A ring of large aligned buffers filled directly by recv() and
+ * drained by a dedicated writer thread, so page-cache writeback stalls
+ * cannot back up into the recv loop. On Linux the file can be opened
+ * with O_DIRECT (bypassing the page cache entirely) and is
+ * preallocated when the capture length is known up front. When all
+ * buffers are in flight, claim() fails and the caller drops the data
+ * with accounting instead of blocking.
+ **********************************************************************/
+class capture_writer_t{
+public:
+    static const size_t BLOCK_SIZE = 4096; //O_DIRECT alignment requirement
+
+    capture_writer_t(
+        const std::string &file,
+        const size_t buff_size,
+        const size_t num_buffs,
+        const bool use_odirect
+    ):
+        _buff_size((buff_size + BLOCK_SIZE - 1) & ~(BLOCK_SIZE - 1)),
+        _odirect(false),
+        _current(0),
+        _current_len(0),
+        _bytes_logical(0),
+        _dropped_bytes(0),
+        _stop(false),
+        _finalized(false)
+    {
+#ifdef UHD_PLATFORM_LINUX
+        int flags = O_WRONLY | O_CREAT | O_TRUNC;
+        if (use_odirect) flags |= O_DIRECT;
+        _fd = ::open(file.c_str(), flags, 0644);
+        if (_fd < 0 and use_odirect){
+            std::cerr << "WARNING: Could not open " << file
+                      << " with O_DIRECT, falling back to buffered writes."
+                      << std::endl;
+            _fd = ::open(file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        } else {
+            _odirect = use_odirect;
+        }
+        if (_fd < 0) throw std::runtime_error("Could not open file: " + file);
+#else
+        if (use_odirect){
+            std::cerr << "WARNING: O_DIRECT is only supported on Linux, "
+                         "using buffered writes." << std::endl;
+        }
+        _outfile.open(file.c_str(), std::ofstream::binary);
+        if (not _outfile) throw std::runtime_error("Could not open file: " + file);
+#endif
+
+        for (size_t i = 0; i < std::max<size_t>(num_buffs, 2); i++){
+#ifdef UHD_PLATFORM_LINUX
+            void *mem = NULL;
+            if (::posix_memalign(&mem, BLOCK_SIZE, _buff_size) != 0){
+                throw std::bad_alloc();
+            }
+            _buffs.push_back(static_cast<char *>(mem));
+#else
+            _buffs.push_back(new char[_buff_size]);
+#endif
+            if (i != 0) _free_buffs.push_back(i); //index 0 starts as current
+        }
+
+        _thread = std::thread(&capture_writer_t::writer_loop, this);
+    }
+
+    ~capture_writer_t(void){
+        this->finalize();
+        for (size_t i = 0; i < _buffs.size(); i++){
+#ifdef UHD_PLATFORM_LINUX
+            std::free(_buffs[i]);
+#else
+            delete [] _buffs[i];
+#endif
+        }
+    }
+
+    //! reserve the file space up front so the writes never extend it
+    void preallocate(const uint64_t num_bytes){
+#ifdef UHD_PLATFORM_LINUX
+        if (::posix_fallocate(_fd, 0, off_t(num_bytes)) != 0){
+            std::cerr << "WARNING: Could not preallocate the output file."
+                      << std::endl;
+        }
+#else
+        (void)num_bytes;
+#endif
+    }
+
+    /*!
+     * Get space for num_bytes in the current buffer, rotating to a free
+     * buffer when the current one cannot fit them. Returns NULL when the
+     * writer has fallen behind and every buffer is in flight; the caller
+     * should drop the data and account for it via count_drop().
+     */
+    char *claim(const size_t num_bytes){
+        if (_buff_size - _current_len < num_bytes){
+            if (not this->rotate_buffers()) return NULL;
+        }
+        return _buffs[_current] + _current_len;
+    }
+
+    //! mark bytes written into the space returned by claim()
+    void commit(const size_t num_bytes){
+        _current_len += num_bytes;
+    }
+
+    //! account for data dropped because claim() failed
+    void count_drop(const size_t num_bytes){
+        _dropped_bytes += num_bytes;
+    }
+
+    uint64_t num_dropped_bytes(void) const {return _dropped_bytes;}
+
+    //! drain the ring, write the tail, trim and close the file
+    void finalize(void){
+        if (_finalized) return;
+        _finalized = true;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _cond.notify_one();
+        _thread.join();
+        if (_current_len != 0){
+            this->write_chunk(_buffs[_current], _current_len, true /*pad final*/);
+        }
+#ifdef UHD_PLATFORM_LINUX
+        //trim the padding and any preallocated space back off the file
+        if (::ftruncate(_fd, off_t(_bytes_logical)) != 0){
+            std::cerr << "WARNING: Could not trim the output file." << std::endl;
+        }
+        ::close(_fd);
+#else
+        _outfile.close();
+#endif
+    }
+
+private:
+    struct filled_t{
+        size_t index;
+        size_t len;
+    };
+
+    /*!
+     * Hand the current buffer to the writer thread and grab a free one.
+     * With O_DIRECT, only the block-aligned prefix is handed off and the
+     * unaligned tail is carried into the next buffer, so every in-flight
+     * write stays aligned. Returns false when no buffer is free.
+     */
+    bool rotate_buffers(void){
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (_free_buffs.empty()) return false;
+        const size_t next = _free_buffs.front();
+        _free_buffs.pop_front();
+
+        size_t flush_len = _current_len;
+        if (_odirect) flush_len &= ~(BLOCK_SIZE - 1);
+        const size_t tail = _current_len - flush_len;
+        if (tail != 0) std::memcpy(_buffs[next], _buffs[_current] + flush_len, tail);
+
+        if (flush_len != 0){
+            filled_t filled;
+            filled.index = _current;
+            filled.len = flush_len;
+            _filled_buffs.push_back(filled);
+            _cond.notify_one();
+        } else {
+            _free_buffs.push_back(_current);
+        }
+        _current = next;
+        _current_len = tail;
+        return true;
+    }
+
+    void writer_loop(void){
+        while (true){
+            filled_t job;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _cond.wait(lock, [this]{
+                    return _stop or not _filled_buffs.empty();
+                });
+                if (_filled_buffs.empty()) return; //stopped and drained
+                job = _filled_buffs.front();
+                _filled_buffs.pop_front();
+            }
+            this->write_chunk(_buffs[job.index], job.len);
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _free_buffs.push_back(job.index);
+            }
+        }
+    }
+
+    void write_chunk(char *data, const size_t len, const bool pad_final = false){
+#ifdef UHD_PLATFORM_LINUX
+        size_t write_len = len;
+        if (_odirect and pad_final){
+            //the last write may be unaligned: pad it out and trim later
+            write_len = (len + BLOCK_SIZE - 1) & ~(BLOCK_SIZE - 1);
+            std::memset(data + len, 0, write_len - len);
+        }
+        size_t num_written = 0;
+        while (num_written < write_len){
+            const ssize_t ret = ::write(_fd, data + num_written, write_len - num_written);
+            if (ret < 0){
+                if (errno == EINTR) continue;
+                std::cerr << "ERROR: File write failed: " << strerror(errno) << std::endl;
+                break;
+            }
+            num_written += size_t(ret);
+        }
+#else
+        (void)pad_final;
+        _outfile.write(data, std::streamsize(len));
+#endif
+        _bytes_logical += len;
+    }
+
+    const size_t _buff_size;
+    bool _odirect;
+    std::vector<char *> _buffs;
+    size_t _current, _current_len;
+    uint64_t _bytes_logical;
+    uint64_t _dropped_bytes;
+
+    std::deque<size_t> _free_buffs;     //guarded by _mutex
+    std::deque<filled_t> _filled_buffs; //guarded by _mutex
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    bool _stop;
+    bool _finalized;
+    std::thread _thread;
+
+#ifdef UHD_PLATFORM_LINUX
+    int _fd;
+#else
+    std::ofstream _outfile;
+#endif
+};
+
 template<typename samp_type> void recv_to_file(
     uhd::usrp::multi_usrp::sptr usrp,
     const std::string &cpu_format,
@@ -38,7 +293,10 @@ template<typename samp_type> void recv_to_file(
     bool stats = false,
     bool null = false,
     bool enable_size_map = false,
-    bool continue_on_bad_packet = false
+    bool continue_on_bad_packet = false,
+    bool use_odirect = false,
+    size_t write_buff_size = 33554432,
+    size_t num_write_buffs = 4
 ){
     unsigned long long num_total_samps = 0;
     //create a receive streamer
@@ -50,9 +308,19 @@ template<typename samp_type> void recv_to_file(
 
     uhd::rx_metadata_t md;
     std::vector<samp_type> buff(samps_per_buff);
-    std::ofstream outfile;
-    if (not null)
-        outfile.open(file.c_str(), std::ofstream::binary);
+    std::unique_ptr<capture_writer_t> writer;
+    if (not null){
+        //each ring buffer must hold at least a couple of recv calls
+        const size_t min_buff_size = 2 * samps_per_buff * sizeof(samp_type);
+        writer.reset(new capture_writer_t(
+            file,
+            std::max(write_buff_size, min_buff_size),
+            num_write_buffs,
+            use_odirect));
+        if (num_requested_samples != 0){
+            writer->preallocate(num_requested_samples * sizeof(samp_type));
+        }
+    }
     bool overflow_message = true;
 
     //setup streaming
@@ -86,8 +354,19 @@ template<typename samp_type> void recv_to_file(
             ) {
         const auto now = std::chrono::steady_clock::now();
 
+        //receive straight into the capture ring when a buffer is free,
+        //otherwise into the scratch buffer (and drop with accounting)
+        samp_type *recv_ptr = &buff.front();
+        char *claim_ptr = NULL;
+        if (writer){
+            claim_ptr = writer->claim(buff.size() * sizeof(samp_type));
+            if (claim_ptr != NULL){
+                recv_ptr = reinterpret_cast<samp_type *>(claim_ptr);
+            }
+        }
+
         size_t num_rx_samps =
-            rx_stream->recv(&buff.front(), buff.size(), md, 3.0, enable_size_map);
+            rx_stream->recv(recv_ptr, buff.size(), md, 3.0, enable_size_map);
 
         if (md.error_code == uhd::rx_metadata_t::ERROR_CODE_TIMEOUT) {
             std::cout << boost::format("Timeout while streaming") << std::endl;
@@ -125,11 +404,12 @@ template<typename samp_type> void recv_to_file(
 
         num_total_samps += num_rx_samps;
 
-        if (outfile.is_open()) {
-            outfile.write(
-                (const char*)&buff.front(),
-                num_rx_samps*sizeof(samp_type)
-            );
+        if (writer) {
+            if (claim_ptr != NULL){
+                writer->commit(num_rx_samps * sizeof(samp_type));
+            } else {
+                writer->count_drop(num_rx_samps * sizeof(samp_type));
+            }
         }
 
         if (bw_summary) {
@@ -151,8 +431,13 @@ template<typename samp_type> void recv_to_file(
     stream_cmd.stream_mode = uhd::stream_cmd_t::STREAM_MODE_STOP_CONTINUOUS;
     rx_stream->issue_stream_cmd(stream_cmd);
 
-    if (outfile.is_open()) {
-        outfile.close();
+    if (writer) {
+        writer->finalize();
+        if (writer->num_dropped_bytes() != 0) {
+            std::cerr << boost::format(
+                "WARNING: Dropped %d samples because the file writer fell behind."
+            ) % (writer->num_dropped_bytes() / sizeof(samp_type)) << std::endl;
+        }
     }
 
     if (stats) {
@@ -230,6 +515,7 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
     //variables to be set by po
     std::string args, file, type, ant, subdev, ref, wirefmt;
     size_t channel, total_num_samps, spb;
+    size_t write_buff_size, num_write_buffs;
     double rate, freq, gain, bw, total_time, setup_time;
 
     //setup the program options
@@ -260,6 +546,9 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
         ("continue", "don't abort on a bad packet")
         ("skip-lo", "skip checking LO lock status")
         ("int-n", "tune USRP with integer-N tuning")
+        ("odirect", "bypass the page cache with O_DIRECT file writes (Linux only)")
+        ("write-buff-size", po::value<size_t>(&write_buff_size)->default_value(33554432), "bytes per capture ring buffer")
+        ("num-write-buffs", po::value<size_t>(&num_write_buffs)->default_value(4), "number of capture ring buffers")
     ;
     po::variables_map vm;
     po::store(po::parse_command_line(argc, argv, desc), vm);
@@ -280,6 +569,7 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
     bool null = vm.count("null") > 0;
     bool enable_size_map = vm.count("sizemap") > 0;
     bool continue_on_bad_packet = vm.count("continue") > 0;
+    bool use_odirect = vm.count("odirect") > 0;
 
     if (enable_size_map)
         std::cout << "Packet size tracking enabled - will only recv one packet at a time!" << std::endl;
@@ -374,7 +664,7 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
     }
 
 #define recv_to_file_args(format) \
-    (usrp, format, wirefmt, channel, file, spb, total_num_samps, total_time, bw_summary, stats, null, enable_size_map, continue_on_bad_packet)
+    (usrp, format, wirefmt, channel, file, spb, total_num_samps, total_time, bw_summary, stats, null, enable_size_map, continue_on_bad_packet, use_odirect, write_buff_size, num_write_buffs)
     //recv to file
     if (wirefmt == "s16") {
         if (type == "double") recv_to_file<double>recv_to_file_args("f64");
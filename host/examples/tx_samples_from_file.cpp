@@ -5,17 +5,20 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
+#include "mapped_file.hpp"
 #include <uhd/types/tune_request.hpp>
 #include <uhd/utils/thread.hpp>
 #include <uhd/utils/safe_main.hpp>
 #include <uhd/usrp/multi_usrp.hpp>
 #include <boost/program_options.hpp>
 #include <boost/format.hpp>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <complex>
 #include <csignal>
 #include <chrono>
+#include <memory>
 #include <thread>
 
 namespace po = boost::program_options;
@@ -50,6 +53,34 @@ template<typename samp_type> void send_from_file(
     infile.close();
 }
 
+template<typename samp_type> void send_from_mapped_file(
+    uhd::tx_streamer::sptr tx_stream,
+    const mapped_file_t &mapped,
+    size_t samps_per_buff
+){
+
+    uhd::tx_metadata_t md;
+    md.start_of_burst = false;
+    md.end_of_burst = false;
+    const samp_type *samps = reinterpret_cast<const samp_type *>(mapped.data());
+    const size_t total_samps = mapped.size()/sizeof(samp_type);
+    size_t num_sent = 0;
+
+    //send directly out of the mapped file pages, no staging copy
+
+    while(num_sent < total_samps and not stop_signal_called){
+
+        const size_t samps_to_send = std::min(samps_per_buff, total_samps - num_sent);
+
+        md.end_of_burst = (samps_to_send == total_samps - num_sent);
+
+        const size_t num_tx_samps = tx_stream->send(samps + num_sent, samps_to_send, md);
+        if (num_tx_samps == 0) break; //timeout
+
+        num_sent += num_tx_samps;
+    }
+}
+
 int UHD_SAFE_MAIN(int argc, char *argv[]){
     uhd::set_thread_priority_safe();
 
@@ -79,6 +110,9 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
         ("channel", po::value<std::string>(&channel)->default_value("0"), "which channel to use")
         ("repeat", "repeatedly transmit file")
         ("int-n", "tune USRP with integer-n tuning")
+        ("mmap", "memory-map the file and send from the mapped pages (Linux only)")
+        ("mlock", "with --mmap, lock the mapping into RAM to avoid page faults mid-burst")
+        ("readahead", "with --mmap, advise the kernel to read the file ahead sequentially")
     ;
     po::variables_map vm;
     po::store(po::parse_command_line(argc, argv, desc), vm);
@@ -91,6 +125,15 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
     }
 
     bool repeat = vm.count("repeat") > 0;
+    bool use_mmap = vm.count("mmap") > 0;
+
+    //map the file up-front, the mapping is reused across repeats
+    std::unique_ptr<mapped_file_t> mapped;
+    if (use_mmap){
+        mapped.reset(new mapped_file_t(
+            file, vm.count("mlock") > 0, vm.count("readahead") > 0
+        ));
+    }
 
     //create a usrp device
     std::cout << std::endl;
@@ -190,7 +233,13 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
 
     //send from file
     do{
-        if (type == "double") send_from_file<std::complex<double> >(tx_stream, file, spb);
+        if (use_mmap){
+            if (type == "double") send_from_mapped_file<std::complex<double> >(tx_stream, *mapped, spb);
+            else if (type == "float") send_from_mapped_file<std::complex<float> >(tx_stream, *mapped, spb);
+            else if (type == "short") send_from_mapped_file<std::complex<short> >(tx_stream, *mapped, spb);
+            else throw std::runtime_error("Unknown type " + type);
+        }
+        else if (type == "double") send_from_file<std::complex<double> >(tx_stream, file, spb);
         else if (type == "float") send_from_file<std::complex<float> >(tx_stream, file, spb);
         else if (type == "short") send_from_file<std::complex<short> >(tx_stream, file, spb);
         else throw std::runtime_error("Unknown type " + type);
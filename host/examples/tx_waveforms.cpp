@@ -39,7 +39,7 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
     //variables to be set by po
     std::string args, wave_type, ant, subdev, ref, pps, otw, channel_list;
     uint64_t total_num_samps;
-    size_t spb;
+    size_t spb, table_len;
     double rate, freq, gain, wave_freq, bw;
     float ampl;
 
@@ -59,6 +59,7 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
         ("bw", po::value<double>(&bw), "analog frontend filter bandwidth in Hz")
         ("wave-type", po::value<std::string>(&wave_type)->default_value("CONST"), "waveform type (CONST, SQUARE, RAMP, SINE)")
         ("wave-freq", po::value<double>(&wave_freq)->default_value(0), "waveform frequency in Hz")
+        ("wave-table-len", po::value<size_t>(&table_len)->default_value(wave_table_len), "length of the lookup table, must be a power of two")
         ("ref", po::value<std::string>(&ref)->default_value("internal"), "clock reference (internal, external, mimo, gpsdo)")
         ("pps", po::value<std::string>(&pps), "PPS source (internal, external, mimo, gpsdo)")
         ("otw", po::value<std::string>(&otw)->default_value("sc16"), "specify the over-the-wire sample mode")
@@ -151,13 +152,13 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
     if (std::abs(wave_freq) > usrp->get_tx_rate()/2){
         throw std::runtime_error("wave freq out of Nyquist zone");
     }
-    if (usrp->get_tx_rate()/std::abs(wave_freq) > wave_table_len/2){
+    if (usrp->get_tx_rate()/std::abs(wave_freq) > table_len/2){
         throw std::runtime_error("wave freq too small for table");
     }
 
     //pre-compute the waveform values
-    const wave_table_class wave_table(wave_type, ampl);
-    const size_t step = boost::math::iround(wave_freq/usrp->get_tx_rate() * wave_table_len);
+    const wave_table_class wave_table(wave_type, ampl, table_len);
+    const size_t step = boost::math::iround(wave_freq/usrp->get_tx_rate() * table_len);
     size_t index = 0;
 
     //create a transmit streamer
@@ -244,10 +245,8 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
         if (stop_signal_called) break;
         if (total_num_samps > 0 and num_acc_samps >= total_num_samps) break;
 
-        //fill the buffer with the waveform
-        for (size_t n = 0; n < buff.size(); n++){
-            buff[n] = wave_table(index += step);
-        }
+        //fill the buffer with the waveform, one block per call
+        index = wave_table.fill(&buff.front(), buff.size(), index, step);
 
         //send the entire contents of the buffer
         num_acc_samps += tx_stream->send(
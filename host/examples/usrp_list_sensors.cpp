@@ -5,9 +5,11 @@
 //
 
 #include <uhd/usrp/multi_usrp.hpp>
+#include <uhd/property_tree.hpp>
 #include <uhd/utils/safe_main.hpp>
 #include <boost/program_options.hpp>
 #include <boost/algorithm/string.hpp> //for split
+#include <boost/format.hpp>
 #include <iostream>
 #include <sstream>
 
@@ -68,6 +70,90 @@ std::string db_sensors_string(
     return ss.str();
 }
 
+namespace {
+    std::string json_escape(const std::string &in)
+    {
+        std::stringstream ss;
+        for (const char c : in) {
+            switch (c) {
+            case '"': ss << "\\\""; break;
+            case '\\': ss << "\\\\"; break;
+            case '\n': ss << "\\n"; break;
+            case '\r': ss << "\\r"; break;
+            case '\t': ss << "\\t"; break;
+            default: ss << c;
+            }
+        }
+        return ss.str();
+    }
+
+    std::string sensor_to_json(const uhd::sensor_value_t& sensor)
+    {
+        return str(boost::format("{\"value\": \"%s\", \"unit\": \"%s\"}")
+            % json_escape(sensor.value)
+            % json_escape(sensor.unit));
+    }
+}
+
+std::string db_sensors_json(
+        const std::string& tx_rx,
+        multi_usrp::sptr usrp,
+        const size_t mb_idx
+) {
+    std::stringstream ss;
+    const size_t num_chans = (tx_rx == "rx")
+        ?  usrp->get_rx_subdev_spec(mb_idx).size()
+        :  usrp->get_tx_subdev_spec(mb_idx).size()
+    ;
+
+    ss << "\"" << tx_rx << "\": [";
+    for (size_t chan_idx = 0; chan_idx < num_chans; chan_idx++) {
+        ss << ((chan_idx)? ", " : "") << "{";
+        const auto sensors = (tx_rx == "rx")
+            ? usrp->get_rx_sensor_names(chan_idx)
+            : usrp->get_tx_sensor_names(chan_idx);
+        bool first = true;
+        for (const auto& sensor : sensors) {
+            const auto sensor_value = (tx_rx == "rx")
+                ? usrp->get_rx_sensor(sensor, chan_idx)
+                : usrp->get_tx_sensor(sensor, chan_idx)
+            ;
+            ss << (first? "" : ", ")
+               << "\"" << json_escape(sensor) << "\": "
+               << sensor_to_json(sensor_value);
+            first = false;
+        }
+        ss << "}";
+    }
+    ss << "]";
+    return ss.str();
+}
+
+std::string mboard_sensors_json(multi_usrp::sptr usrp, const size_t mb_idx)
+{
+    //one snapshot pass lets registered bulk backends prefetch the
+    //sensor values, so the reads below are served from a cache
+    //instead of querying the device one sensor at a time
+    usrp->get_device()->get_tree()->snapshot(
+        "/mboards/" + std::to_string(mb_idx));
+
+    std::stringstream ss;
+    ss << "{\"index\": " << mb_idx << ", \"sensors\": {";
+    const auto mboard_sensors = usrp->get_mboard_sensor_names(mb_idx);
+    bool first = true;
+    for (const auto& mboard_sensor : mboard_sensors) {
+        const auto sensor_value =
+            usrp->get_mboard_sensor(mboard_sensor, mb_idx);
+        ss << (first? "" : ", ")
+           << "\"" << json_escape(mboard_sensor) << "\": "
+           << sensor_to_json(sensor_value);
+        first = false;
+    }
+    ss << "}, " << db_sensors_json("rx", usrp, mb_idx)
+       << ", " << db_sensors_json("tx", usrp, mb_idx) << "}";
+    return ss.str();
+}
+
 std::string mboard_sensors_string(multi_usrp::sptr usrp, const size_t mb_idx)
 {
     std::stringstream ss;
@@ -94,6 +180,7 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
     desc.add_options()
         ("help", "Display this help message")
         ("args", po::value<std::string>(&usrp_args), "USRP device arguments")
+        ("json", "Print sensor values as JSON for machine consumption")
     ;
     po::variables_map vm;
     po::store(po::parse_command_line(argc, argv, desc), vm);
@@ -109,11 +196,26 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
         return EXIT_SUCCESS;
     }
 
+    const bool json = bool(vm.count("json"));
+
     // Create a Multi-USRP device
-    std::cout << "\nCreating the USRP device with: " << usrp_args << std::endl;
+    if (not json) {
+        std::cout << "\nCreating the USRP device with: " << usrp_args << std::endl;
+    }
     multi_usrp::sptr usrp = multi_usrp::make(usrp_args);
 
     const size_t num_mboards = usrp->get_num_mboards();
+
+    if (json) {
+        std::cout << "{\"mboards\": [";
+        for (size_t mboard_idx = 0; mboard_idx < num_mboards; mboard_idx++) {
+            std::cout << ((mboard_idx)? ", " : "")
+                      << mboard_sensors_json(usrp, mboard_idx);
+        }
+        std::cout << "]}" << std::endl;
+        return EXIT_SUCCESS;
+    }
+
     std::cout << "Device contains " << num_mboards
               << " motherboard(s)." << std::endl << std::endl;
 
@@ -15,33 +15,42 @@ static const size_t wave_table_len = 8192;
 
 class wave_table_class{
 public:
-    wave_table_class(const std::string &wave_type, const float ampl):
-        _wave_table(wave_table_len)
+    wave_table_class(
+        const std::string &wave_type,
+        const float ampl,
+        const size_t table_len = wave_table_len
+    ):
+        _wave_table(table_len), _mask(table_len-1)
     {
+        //the index mask in fill() requires a power-of-two length
+        if (table_len < 2 or (table_len & (table_len-1)) != 0){
+            throw std::runtime_error("wave table length not a power of two");
+        }
+
         //compute real wave table with 1.0 amplitude
-        std::vector<float> real_wave_table(wave_table_len);
+        std::vector<float> real_wave_table(table_len);
         if (wave_type == "CONST"){
-            for (size_t i = 0; i < wave_table_len; i++)
+            for (size_t i = 0; i < table_len; i++)
                 real_wave_table[i] = 1.0;
         }
         else if (wave_type == "SQUARE"){
-            for (size_t i = 0; i < wave_table_len; i++)
-                real_wave_table[i] = (i < wave_table_len/2)? 0.0 : 1.0;
+            for (size_t i = 0; i < table_len; i++)
+                real_wave_table[i] = (i < table_len/2)? 0.0 : 1.0;
         }
         else if (wave_type == "RAMP"){
-            for (size_t i = 0; i < wave_table_len; i++)
-                real_wave_table[i] = 2.0*i/(wave_table_len-1) - 1.0;
+            for (size_t i = 0; i < table_len; i++)
+                real_wave_table[i] = 2.0*i/(table_len-1) - 1.0;
         }
         else if (wave_type == "SINE"){
             static const double tau = 2*std::acos(-1.0);
-            for (size_t i = 0; i < wave_table_len; i++)
-                real_wave_table[i] = std::sin((tau*i)/wave_table_len);
+            for (size_t i = 0; i < table_len; i++)
+                real_wave_table[i] = std::sin((tau*i)/table_len);
         }
         else throw std::runtime_error("unknown waveform type: " + wave_type);
 
         //compute i and q pairs with 90% offset and scale to amplitude
-        for (size_t i = 0; i < wave_table_len; i++){
-            const size_t q = (i+(3*wave_table_len)/4)%wave_table_len;
+        for (size_t i = 0; i < table_len; i++){
+            const size_t q = (i+(3*table_len)/4)%table_len;
             _wave_table[i] = std::complex<float>(
                 ampl*real_wave_table[i],
                 ampl*real_wave_table[q]
@@ -50,10 +59,44 @@ public:
     }
 
     inline std::complex<float> operator()(const size_t index) const{
-        return _wave_table[index % wave_table_len];
+        return _wave_table[index & _mask];
+    }
+
+    /*!
+     * Fill a whole send buffer from the table in one call.
+     *
+     * The phase accumulates by step per sample and wraps via the
+     * power-of-two index mask, so the inner loop has no division or
+     * modulo and the compiler can vectorize it.
+     *
+     * \param buff destination buffer
+     * \param nsamps number of samples to generate
+     * \param index phase accumulator value from the previous call
+     * \param step phase increment per sample
+     * \return the phase accumulator value to pass into the next call
+     */
+    inline size_t fill(
+        std::complex<float> *buff,
+        const size_t nsamps,
+        const size_t index,
+        const size_t step
+    ) const{
+        const std::complex<float> *table = &_wave_table.front();
+        const size_t mask = _mask;
+        size_t phase = index;
+        for (size_t n = 0; n < nsamps; n++){
+            phase += step;
+            buff[n] = table[phase & mask];
+        }
+        return phase;
+    }
+
+    size_t get_length(void) const{
+        return _mask + 1;
     }
 
 private:
     std::vector<std::complex<float> > _wave_table;
+    size_t _mask;
 };
 
@@ -47,6 +47,7 @@ typedef ptrdiff_t ssize_t;
     #define UHD_DEPRECATED     __declspec(deprecated)
     #define UHD_ALIGNED(x)     __declspec(align(x))
     #define UHD_UNUSED(x)      x
+    #define UHD_PREFETCH_READ(x)
 #elif defined(__MINGW32__)
     #define UHD_EXPORT         __declspec(dllexport)
     #define UHD_IMPORT         __declspec(dllimport)
@@ -55,6 +56,7 @@ typedef ptrdiff_t ssize_t;
     #define UHD_DEPRECATED     __declspec(deprecated)
     #define UHD_ALIGNED(x)     __declspec(align(x))
     #define UHD_UNUSED(x)      x __attribute__((unused))
+    #define UHD_PREFETCH_READ(x) __builtin_prefetch((x), 0, 3)
 #elif defined(__GNUG__) && __GNUG__ >= 4
     #define UHD_EXPORT         __attribute__((visibility("default")))
     #define UHD_IMPORT         __attribute__((visibility("default")))
@@ -63,6 +65,7 @@ typedef ptrdiff_t ssize_t;
     #define UHD_DEPRECATED     __attribute__((deprecated))
     #define UHD_ALIGNED(x)     __attribute__((aligned(x)))
     #define UHD_UNUSED(x)      x __attribute__((unused))
+    #define UHD_PREFETCH_READ(x) __builtin_prefetch((x), 0, 3)
 #elif defined(__clang__)
     #define UHD_EXPORT         __attribute__((visibility("default")))
     #define UHD_IMPORT         __attribute__((visibility("default")))
@@ -71,6 +74,7 @@ typedef ptrdiff_t ssize_t;
     #define UHD_DEPRECATED     __attribute__((deprecated))
     #define UHD_ALIGNED(x)     __attribute__((aligned(x)))
     #define UHD_UNUSED(x)      x __attribute__((unused))
+    #define UHD_PREFETCH_READ(x) __builtin_prefetch((x), 0, 3)
 #else
     #define UHD_EXPORT
     #define UHD_IMPORT
@@ -79,6 +83,7 @@ typedef ptrdiff_t ssize_t;
     #define UHD_DEPRECATED
     #define UHD_ALIGNED(x)
     #define UHD_UNUSED(x)      x
+    #define UHD_PREFETCH_READ(x)
 #endif
 
 // Define API declaration macro
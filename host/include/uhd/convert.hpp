@@ -14,6 +14,7 @@
 #include <boost/function.hpp>
 #include <boost/operators.hpp>
 #include <string>
+#include <vector>
 
 namespace uhd{ namespace convert{
 
@@ -52,6 +53,25 @@ namespace uhd{ namespace convert{
     //! Priority of conversion routines
     typedef int priority_type;
 
+    /*!
+     * Priority under which converters with non-temporal (cache
+     * bypassing) stores register. It is below every default priority,
+     * so these converters are never chosen automatically; request the
+     * priority explicitly when the output buffers are much larger than
+     * the processor caches and the data is consumed elsewhere.
+     */
+    static const priority_type PRIORITY_NONTEMPORAL = -2;
+
+    /*!
+     * Priority under which dithered dequantization kernels register.
+     * These add half an LSB of uniform random dither to each sample
+     * before scaling, decorrelating the quantization error from the
+     * signal for long integrations. Below every default priority, so
+     * they are never chosen automatically; request the priority
+     * explicitly when the application needs dithered conversion.
+     */
+    static const priority_type PRIORITY_DITHERED = -3;
+
     //! Identify a conversion routine in the registry
     struct UHD_API id_type : boost::equality_comparable<id_type>{
         std::string input_format;
@@ -91,6 +111,62 @@ namespace uhd{ namespace convert{
         const priority_type prio = -1
     );
 
+    /*!
+     * Get the identifiers of all registered conversions.
+     * \return a vector of registered ids
+     */
+    UHD_API std::vector<id_type> get_ids(void);
+
+    /*!
+     * Get the priorities registered for a conversion.
+     * \param id identify the conversion
+     * \return a vector of registered priorities
+     */
+    UHD_API std::vector<priority_type> get_priorities(const id_type &id);
+
+    //! Describes one registered conversion routine
+    struct UHD_API converter_info_type{
+        id_type id;              //!< the conversion the routine implements
+        priority_type priority;  //!< the priority it registered under
+        std::string impl_class;  //!< implementation class, e.g. "simd"
+        std::string to_pp_string(void) const;
+    };
+
+    /*!
+     * Resolve the priority that get_converter would select.
+     *
+     * Applies the same matching rules as get_converter: an explicit
+     * priority must match exactly, -1 picks the best registered
+     * priority. Unlike get_converter this does not construct anything,
+     * so it can be used to report which routine is (or would be) in use.
+     *
+     * \param id identify the conversion
+     * \param prio the desired prio or -1 for best
+     * \return the priority get_converter selects for these arguments
+     */
+    UHD_API priority_type get_converter_priority(
+        const id_type &id,
+        const priority_type prio = -1
+    );
+
+    /*!
+     * Describe the conversion routine that get_converter selects.
+     * \param id identify the conversion
+     * \param prio the desired prio or -1 for best
+     * \return name, class and priority of the selected routine
+     */
+    UHD_API converter_info_type get_converter_info(
+        const id_type &id,
+        const priority_type prio = -1
+    );
+
+    /*!
+     * Map a registration priority to its implementation class name.
+     * \param prio a converter registration priority
+     * \return a name such as "general", "table" or "simd"
+     */
+    UHD_API std::string get_priority_class(const priority_type prio);
+
     /*!
      * Register the size of a particular item.
      * \param format the item format
@@ -81,6 +81,19 @@ public:
      */
     static sptr make(const device_addr_t &hint, device_filter_t filter = ANY, size_t which = 0);
 
+    /*!
+     * \brief Merge an entry into the persistent discovery cache.
+     *
+     * Device implementations call this to record facts learned during
+     * setup (e.g. the probed path MTU) alongside the cached discovery
+     * addresses, so the next session can reuse them without re-probing.
+     * Entries are keyed by the serial key; entries without a serial are
+     * ignored. Cache updates are best-effort and never throw.
+     *
+     * \param dev_addr the address entry to merge into the cache
+     */
+    static void update_discovery_cache(const device_addr_t &dev_addr);
+
     /*! \brief Make a new receive streamer from the streamer arguments
      *
      * Note: There can always only be one streamer. When calling get_rx_stream()
@@ -0,0 +1,120 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHD_DEVICE_POOL_HPP
+#define INCLUDED_UHD_DEVICE_POOL_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/device.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <boost/utility.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/function.hpp>
+
+namespace uhd{
+
+/*!
+ * A warm standby pool of initialized devices.
+ *
+ * The pool holds claimed devices with their property tree built and,
+ * optionally, streamers pre-created from a template. The multi-second
+ * device::make() and streamer setup run on a background worker while
+ * the pool sits on standby, so acquire() hands a ready device to a
+ * session in milliseconds once the pool is warm. When a session ends,
+ * its device goes back through the worker for re-initialization before
+ * it is handed out again.
+ *
+ * Intended for interactive applications that open many short sessions
+ * against the same hardware and cannot afford the full device setup
+ * cost on each one.
+ */
+class UHD_API device_pool : boost::noncopyable{
+public:
+    typedef boost::shared_ptr<device_pool> sptr;
+
+    /*!
+     * A session handle for one pooled device.
+     *
+     * The session owns the device exclusively until the handle is
+     * destroyed, which hands the device back to the pool for background
+     * re-initialization. Streamer handles obtained from the session must
+     * not outlive it.
+     */
+    class UHD_API session : boost::noncopyable{
+    public:
+        typedef boost::shared_ptr<session> sptr;
+
+        virtual ~session(void) = 0;
+
+        //! The initialized device held by this session
+        virtual device::sptr get_device(void) = 0;
+
+        /*!
+         * The receive streamer pre-created from the pool's rx template.
+         * Throws uhd::runtime_error if the pool was made without one.
+         */
+        virtual rx_streamer::sptr get_rx_stream(void) = 0;
+
+        //! Transmit counterpart of get_rx_stream()
+        virtual tx_streamer::sptr get_tx_stream(void) = 0;
+    };
+
+    /*!
+     * Callback run on a device in the background after its session ends
+     * and before the device is handed out again. Use this to restore
+     * state a session may have left behind (gain, tuning, time).
+     */
+    typedef boost::function<void(device::sptr)> reset_fcn_type;
+
+    /*!
+     * Create a device pool.
+     *
+     * Discovery runs in the calling thread so a missing device fails
+     * fast; the device creation and streamer setup happen on the
+     * background worker, so the pool comes up without blocking the
+     * caller. Stream templates with an empty cpu_format are ignored;
+     * otherwise each pooled device gets its streamer created up front.
+     *
+     * \param hint a partially (or fully) filled in device address
+     * \param num_devices how many matching devices to hold at most
+     * \param rx_stream_args template for the pre-created rx streamer
+     * \param tx_stream_args template for the pre-created tx streamer
+     * \param reset_fcn optional re-initialization callback
+     * \return a new device pool object
+     */
+    static sptr make(
+        const device_addr_t &hint,
+        const size_t num_devices = 1,
+        const stream_args_t &rx_stream_args = stream_args_t(),
+        const stream_args_t &tx_stream_args = stream_args_t(),
+        const reset_fcn_type &reset_fcn = reset_fcn_type()
+    );
+
+    virtual ~device_pool(void) = 0;
+
+    /*!
+     * Acquire a ready device from the pool.
+     *
+     * Blocks until a device is ready or the timeout expires. Throws
+     * uhd::runtime_error on timeout or when every pooled device failed
+     * to initialize.
+     *
+     * \param timeout the timeout in seconds to wait for a ready device
+     * \return a session handle; drop it to release the device
+     */
+    virtual session::sptr acquire(const double timeout = 30.0) = 0;
+
+    //! Number of devices ready for instant acquisition
+    virtual size_t num_ready(void) = 0;
+
+    //! Number of devices held by the pool (ready, acquired, or preparing)
+    virtual size_t size(void) = 0;
+};
+
+} //namespace uhd
+
+#endif /* INCLUDED_UHD_DEVICE_POOL_HPP */
@@ -170,6 +170,21 @@ public:
      */
     virtual const T get_desired(void) const = 0;
 
+    /*!
+     * Get a const reference to the current value of this property.
+     * Unlike get(), no copy of the stored value is made, which
+     * matters for string-heavy types like device_addr_t. The
+     * reference stays valid until the property is next set.
+     *
+     * This accessor cannot be used on a property with a registered
+     * publisher: the publisher yields a temporary, so no reference
+     * can be returned and get() must be used instead.
+     *
+     * \return a const reference to the current value in the property
+     * \throws uhd::runtime_error
+     */
+    virtual const T &get_cref(void) const = 0;
+
     /*!
      * A property is empty if it has never been set.
      * A property with a publisher is never empty.
@@ -211,8 +226,14 @@ public:
 
     enum coerce_mode_t { AUTO_COERCE, MANUAL_COERCE };
 
+    //! Callback that creates the properties of a lazily registered subtree
+    typedef boost::function<void(void)> populator_fcn_t;
+
     virtual ~property_tree(void) = 0;
 
+    //! Opaque handle to an interned property path (see intern())
+    typedef size_t path_handle_t;
+
     //! Create a new + empty property tree
     static sptr make(void);
 
@@ -228,6 +249,39 @@ public:
     //! Get an iterable to all things in the given path
     virtual std::vector<std::string> list(const fs_path &path) const = 0;
 
+    /*!
+     * Register a lazily populated subtree.
+     * The populator callback is invoked the first time the subtree is
+     * listed, accessed, removed, or checked with exists; it is expected
+     * to create the properties below path. Creating unrelated properties
+     * below path does not trigger the populator, so expensive branches
+     * can be deferred while siblings are registered eagerly.
+     */
+    virtual void register_lazy_subtree(const fs_path &path, const populator_fcn_t &populator) = 0;
+
+    /*!
+     * Register a bulk backend for subtree snapshots.
+     * The backend callback is invoked once per snapshot() call covering
+     * path, before the tree is walked. It is expected to prefetch the
+     * values below path in a single bulk operation (one RPC call on
+     * networked devices, one batched register read elsewhere) so that
+     * the per-property reads that follow are served from a cache
+     * instead of going to the device one value at a time.
+     */
+    virtual void register_snapshot_backend(const fs_path &path, const populator_fcn_t &backend) = 0;
+
+    /*!
+     * Collect every property path below path in a single pass.
+     * Pending lazy populators below path are run, then the registered
+     * snapshot backends covering path, and finally the subtree is
+     * walked once under a single lock acquisition. The returned paths
+     * are relative to this tree and can be fed straight into access().
+     * Full-tree dumps and inventory scans should prefer this over
+     * recursing with list(), which locks and resolves each node
+     * individually.
+     */
+    virtual std::vector<fs_path> snapshot(const fs_path &path) const = 0;
+
     //! Create a new property entry in the tree
     template <typename T> property<T> &create(
         const fs_path &path,
@@ -236,6 +290,24 @@ public:
     //! Get access to a property in the tree
     template <typename T> property<T> &access(const fs_path &path);
 
+    /*!
+     * Intern a property path for repeated access.
+     * The path is resolved once - including any pending lazy populator -
+     * and the returned handle refers to the property from then on, so
+     * steady-state accesses from hot paths (streaming, tuning) cost an
+     * array index instead of string splitting and per-token lookups.
+     * The handle is valid on this tree and all trees sharing its guts
+     * (subtrees), and it pins the resolved property: removing the path
+     * from the tree afterwards does not invalidate the handle.
+     * \param path the path of an existing property
+     * \return an opaque handle for use with access(handle)
+     * \throws uhd::lookup_error when no property exists at path
+     */
+    virtual path_handle_t intern(const fs_path &path) = 0;
+
+    //! Get access to a property through an interned path handle
+    template <typename T> property<T> &access(const path_handle_t handle);
+
 private:
     //! Internal create property with wild-card type
     virtual void _create(const fs_path &path, const boost::shared_ptr<void> &prop) = 0;
@@ -243,6 +315,9 @@ private:
     //! Internal access property with wild-card type
     virtual boost::shared_ptr<void> &_access(const fs_path &path) const = 0;
 
+    //! Internal access through an interned handle with wild-card type
+    virtual boost::shared_ptr<void> &_access(const path_handle_t handle) const = 0;
+
 };
 
 } //namespace uhd
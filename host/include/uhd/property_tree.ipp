@@ -99,6 +99,18 @@ public:
         }
     }
 
+    const T &get_cref(void) const{
+        if (empty()) {
+            throw uhd::runtime_error("Cannot get_cref() on an uninitialized (empty) property");
+        }
+        if (not _publisher.empty()) {
+            throw uhd::runtime_error("Cannot get_cref() on a property with a registered publisher");
+        }
+        if (_coerced_value.get() == NULL and _coerce_mode == property_tree::MANUAL_COERCE)
+            throw uhd::runtime_error("uninitialized coerced value for manually coerced attribute");
+        return get_value_ref(_coerced_value);
+    }
+
     const T get_desired(void) const{
         if (_value.get() == NULL) throw uhd::runtime_error("Cannot get_desired() on an uninitialized (empty) property");
 
@@ -152,6 +164,10 @@ namespace uhd{
         return *boost::static_pointer_cast<property<T> >(this->_access(path));
     }
 
+    template <typename T> property<T> &property_tree::access(const path_handle_t handle){
+        return *boost::static_pointer_cast<property<T> >(this->_access(handle));
+    }
+
 } //namespace uhd
 
 #endif /* INCLUDED_UHD_PROPERTY_TREE_IPP */
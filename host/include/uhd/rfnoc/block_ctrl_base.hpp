@@ -180,6 +180,45 @@ public:
      */
     void sr_write(const std::string &reg, const uint32_t data, const size_t port = 0);
 
+    /*! One entry of a staged timed-command schedule */
+    struct timed_sr_write_t {
+        uint32_t reg;
+        uint32_t data;
+        time_spec_t time;
+    };
+
+    /*! Stage a timed settings-register write without sending it.
+     *
+     * The write is queued on the host until commit_sr_writes() is
+     * called; nothing goes over the wire. Use this to build up a
+     * schedule of timed commands (e.g. a hop sequence of tune, gain
+     * and GPIO writes) that should be emitted as one burst.
+     *
+     * \param reg The settings register to write to.
+     * \param data New value of this register.
+     * \param time When the command shall execute on the device.
+     * \param port Port on which to write
+     */
+    void stage_sr_write(
+            const uint32_t reg,
+            const uint32_t data,
+            const time_spec_t &time,
+            const size_t port = 0
+    );
+
+    /*! Emit all staged writes as one contiguous burst.
+     *
+     * The schedule staged via stage_sr_write() is converted to ticks
+     * once and pushed into the block's command FIFO back to back,
+     * instead of paying a full control round trip per command. The
+     * call blocks only if the schedule exceeds the command FIFO
+     * depth, in which case it waits for executed commands to drain.
+     * The staged schedule is cleared, also on error.
+     *
+     * \param port Port on which to write
+     */
+    void commit_sr_writes(const size_t port = 0);
+
     /*! Allows reading one register on the settings bus (64-Bit version).
      *
      * \param reg The settings register to be read.
@@ -412,6 +451,9 @@ private:
     std::map<size_t, time_spec_t> _cmd_timespecs;
     std::map<size_t, double> _cmd_tickrates;
 
+    //! Timed writes staged via stage_sr_write(), per port
+    std::map<size_t, std::vector<timed_sr_write_t> > _staged_sr_writes;
+
     //! The base address of this block (the address of block port 0)
     uint32_t _base_address;
 
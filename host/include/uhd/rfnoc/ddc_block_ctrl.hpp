@@ -33,6 +33,12 @@ class UHD_RFNOC_API ddc_block_ctrl :
 public:
     UHD_RFNOC_BLOCK_OBJECT(ddc_block_ctrl)
 
+    //! Return the number of halfband filters in this block's DDC chain
+    virtual size_t get_num_halfbands() const = 0;
+
+    //! Return the maximum decimation of this block's CIC filter
+    virtual size_t get_cic_max_decim() const = 0;
+
 }; /* class ddc_block_ctrl*/
 
 }} /* namespace uhd::rfnoc */
@@ -38,6 +38,14 @@ public:
     //! Returns the depth of the FIFO (in bytes).
     uint32_t get_depth(const size_t chan) const;
 
+    /*! Returns the current fill level of the FIFO (in bytes).
+     *
+     * Reads the occupancy counter from the FIFO core, so this costs a
+     * register transaction; cheap enough to poll from a monitoring
+     * thread, but not meant for per-packet use.
+     */
+    virtual uint32_t get_bytes_occupied(const size_t chan) = 0;
+
 }; /* class dma_fifo_block_ctrl*/
 
 }} /* namespace uhd::rfnoc */
@@ -0,0 +1,108 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_LIBUHD_RFNOC_RATE_PLAN_HPP
+#define INCLUDED_LIBUHD_RFNOC_RATE_PLAN_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/rfnoc/ddc_block_ctrl.hpp>
+#include <string>
+#include <vector>
+
+namespace uhd {
+    namespace rfnoc {
+
+/*! \brief Resampling capabilities of one DDC/DUC stage.
+ *
+ * Describes what a single stage of a rate-change cascade can do: how
+ * many halfband filters it has, and how far its CIC can decimate (or
+ * interpolate). These map directly onto the readback registers of the
+ * DDC and DUC blocks.
+ */
+struct UHD_RFNOC_API dsp_stage_caps
+{
+    dsp_stage_caps(
+            const size_t num_halfbands_ = 0,
+            const size_t cic_max_decim_ = 1
+    ):
+        num_halfbands(num_halfbands_),
+        cic_max_decim(cic_max_decim_)
+    {}
+
+    //! Number of cascaded halfband filters in this stage
+    size_t num_halfbands;
+    //! Maximum rate change of this stage's CIC filter
+    size_t cic_max_decim;
+};
+
+/*! \brief A planned decimation split across a cascade of DSP stages.
+ *
+ * The plan records, for every stage in order, the overall stage rate
+ * change and how the hardware will decompose it into halfbands and CIC
+ * decimation. A stage with decim == 1 passes samples through untouched.
+ */
+struct UHD_RFNOC_API rate_plan
+{
+    struct stage_type
+    {
+        stage_type(void):
+            decim(1), num_halfbands(0), cic_decim(1)
+        {}
+
+        //! Overall rate change of this stage
+        size_t decim;
+        //! Number of halfbands the stage will enable
+        size_t num_halfbands;
+        //! Decimation left for the stage's CIC filter
+        size_t cic_decim;
+    };
+
+    rate_plan(void): cost(0.0) {}
+
+    //! Per-stage rate changes, in processing order
+    std::vector<stage_type> stages;
+    //! Relative filter work of this plan (lower is better)
+    double cost;
+
+    //! Product of all stage rate changes
+    size_t get_total_decim(void) const;
+
+    //! Pretty-print the plan, one line per stage
+    std::string to_pp_string(void) const;
+};
+
+/*! Plan a total rate change across a cascade of DSP stages.
+ *
+ * Enumerates every factorization of \p decim that the given stages can
+ * realize and returns the one with the least filter work. The cost
+ * model charges each filter for the rate it runs at, so plans prefer
+ * decimating early, covering powers of two with halfbands, and avoiding
+ * CIC-only stages (which let the CIC rolloff reach the passband with no
+ * halfband behind it).
+ *
+ * \param stages capabilities of each stage, in processing order
+ * \param decim the total rate change to realize
+ * \return the cheapest feasible plan
+ * \throws uhd::value_error if no factorization fits the stages
+ */
+UHD_RFNOC_API rate_plan plan_rate_chain(
+        const std::vector<dsp_stage_caps> &stages,
+        const size_t decim
+);
+
+/*! Plan a total decimation across a chain of DDC blocks.
+ *
+ * Convenience overload that reads the stage capabilities out of the
+ * block controllers' readback registers.
+ */
+UHD_RFNOC_API rate_plan plan_rate_chain(
+        const std::vector<ddc_block_ctrl::sptr> &blocks,
+        const size_t decim
+);
+
+}} /* namespace uhd::rfnoc */
+
+#endif /* INCLUDED_LIBUHD_RFNOC_RATE_PLAN_HPP */
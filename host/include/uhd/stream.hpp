@@ -9,14 +9,20 @@
 #define INCLUDED_UHD_STREAM_HPP
 
 #include <uhd/config.hpp>
+#include <uhd/convert.hpp>
 #include <uhd/types/metadata.hpp>
 #include <uhd/types/device_addr.hpp>
 #include <uhd/types/stream_cmd.hpp>
 #include <uhd/types/ref_vector.hpp>
+#include <uhd/types/sample_timekeeper.hpp>
+#include <uhd/transport/zero_copy.hpp>
 #include <boost/utility.hpp>
 #include <boost/shared_ptr.hpp>
+#include <complex>
+#include <functional>
 #include <vector>
 #include <string>
+#include <stdint.h>
 
 namespace uhd{
 
@@ -129,6 +135,21 @@ struct UHD_API stream_args_t{
      * Users should specify this option to request smaller than default
      * packets, probably with the intention of reducing packet latency.
      *
+     * - converter_prio: force the conversion routine registered under
+     * this priority instead of letting the framework pick the best one.
+     * Intended for A/B testing of converter implementations; the routine
+     * actually in use can be queried with get_converter_info(). When no
+     * routine registered under the requested priority, the streamer logs
+     * the fact and falls back to the default selection.
+     *
+     * - fc_extrapolate: when set to a non-zero value on a TX stream,
+     * flow control credits are replenished at the known consumption
+     * rate (sample rate times bytes per item) between downstream
+     * updates instead of stalling for each one. The estimate is capped
+     * at the bytes in flight and reconciled against every real update,
+     * so the downstream buffer can never be overrun. Useful on links
+     * with round-trip spikes; requires the sample rate to be set.
+     *
      * - noclear: Used by tx_dsp_core_200 and rx_dsp_core_200
      *
      * The following are not implemented, but are listed for conceptual purposes:
@@ -162,6 +183,167 @@ struct UHD_API stream_args_t{
     std::vector<size_t> channels;
 };
 
+/*!
+ * Performance counters for a streamer.
+ *
+ * The counters accumulate over the lifetime of the streamer and are
+ * maintained with lightweight per-channel atomics, so reading them
+ * from a monitoring thread does not interfere with the fast path.
+ * Not every field applies to both directions; fields that do not
+ * apply to a streamer remain zero.
+ */
+struct UHD_API stream_stats_t{
+    stream_stats_t(void):
+        num_packets(0),
+        num_sequence_errors(0),
+        num_overruns(0),
+        num_timeouts(0),
+        num_alignment_failures(0),
+        num_fc_stalls(0),
+        num_dropped_samps(0),
+        max_skew_ticks(0),
+        device_buff_bytes(0),
+        device_buff_capacity(0),
+        num_device_underruns(0),
+        num_device_seq_errors(0),
+        num_device_time_errors(0),
+        fc_stall_time_ns(0),
+        link_quality(1.0)
+    {}
+
+    //! Number of data packets received or sent across all channels
+    uint64_t num_packets;
+    //! Number of dropped-packet (sequence number) errors (RX only)
+    uint64_t num_sequence_errors;
+    //! Number of overflow events signalled by the device (RX only)
+    uint64_t num_overruns;
+    //! Number of receive or send calls that hit the timeout
+    uint64_t num_timeouts;
+    //! Number of multi-channel alignment failures (RX only)
+    uint64_t num_alignment_failures;
+    //! Number of times send stalled waiting for flow control credit (TX only)
+    uint64_t num_fc_stalls;
+    //! Number of samples dropped by drop-on-timeout send mode (TX only)
+    uint64_t num_dropped_samps;
+    //! Peak inter-channel timestamp skew tolerated by coherent-group
+    //! alignment, in ticks (RX only, zero outside coherent-group mode)
+    uint64_t max_skew_ticks;
+    //! Bytes resident in the device-side buffer (e.g. the TX DMA FIFO)
+    //! at the time of the snapshot, summed over the channels; zero
+    //! when the hardware cannot report its fill level (TX only)
+    uint64_t device_buff_bytes;
+    //! Total capacity in bytes of the device-side buffers reporting
+    //! into device_buff_bytes; zero when unknown (TX only)
+    uint64_t device_buff_capacity;
+    //! Number of underflow events signalled by the device through the
+    //! async message path (TX only)
+    uint64_t num_device_underruns;
+    //! Number of downlink sequence errors signalled by the device -
+    //! packets lost between host and device, as opposed to the
+    //! host-side num_sequence_errors (TX only)
+    uint64_t num_device_seq_errors;
+    //! Number of late-packet (time error) events signalled by the
+    //! device (TX only)
+    uint64_t num_device_time_errors;
+    //! Accumulated wall time spent stalled waiting for flow control
+    //! credit, in nanoseconds (TX only)
+    uint64_t fc_stall_time_ns;
+    //! Composite link quality score in [0.0, 1.0]: 1.0 is a clean
+    //! stream; event counters above drag it down in proportion to
+    //! their rate per packet. A heuristic for trend monitoring and
+    //! alerting - compare the individual counters to tell host-side
+    //! drops from network loss from device-side stalls
+    double link_quality;
+
+    /*!
+     * Recompute link_quality from the counters above.
+     *
+     * Streamers call this when filling a snapshot. The weighting is a
+     * heuristic: packet loss hurts most, device faults (overruns,
+     * underruns, time errors) less, stalls and timeouts least, each in
+     * proportion to its rate per packet, clamped to [0.0, 1.0].
+     */
+    void update_link_quality(void){
+        const double pkts = double(num_packets? num_packets : 1);
+        const double loss = double(
+            num_sequence_errors + num_device_seq_errors)/pkts;
+        const double fault = double(num_overruns + num_device_underruns
+            + num_device_time_errors + num_alignment_failures)/pkts;
+        const double stall = double(num_fc_stalls + num_timeouts)/pkts;
+        const double quality = 1.0 - 10.0*loss - 5.0*fault - 1.0*stall;
+        link_quality = (quality < 0.0)? 0.0 : quality;
+    }
+
+    //! Number of pipeline stages covered by the compile-in stage profiler
+    static const size_t NUM_PROFILER_STAGES = 5;
+    //! Number of power-of-two buckets per stage cycle histogram
+    static const size_t NUM_PROFILER_BUCKETS = 32;
+
+    /*!
+     * Cycle accounting for one fast-path pipeline stage.
+     *
+     * Populated only when the library was built with
+     * UHD_TXRX_STAGE_PROFILING defined; all-zero otherwise.
+     */
+    struct stage_cycles_t{
+        stage_cycles_t(void):
+            total_cycles(0),
+            num_calls(0)
+        {
+            for (size_t i = 0; i < NUM_PROFILER_BUCKETS; i++) buckets[i] = 0;
+        }
+        //! Sum of cycle-counter ticks spent in this stage
+        uint64_t total_cycles;
+        //! Number of times the stage ran
+        uint64_t num_calls;
+        //! buckets[i] counts runs taking [2^i, 2^(i+1)) cycles
+        uint64_t buckets[NUM_PROFILER_BUCKETS];
+    };
+
+    //! Per-stage cycle histograms, indexed in pipeline order:
+    //! wait, unpack, convert, metadata, release
+    stage_cycles_t stage_cycles[NUM_PROFILER_STAGES];
+};
+
+/*!
+ * Signal statistics for one channel of a streamer.
+ *
+ * The raw accumulators cover every sample delivered since the last
+ * read; mean power and DC offset follow from them. Maintained inside
+ * the receive conversion pass (see rx_streamer::set_power_stats_enabled),
+ * so collecting them does not cost a second full-rate sweep over the
+ * buffers.
+ */
+struct UHD_API power_stats_t{
+    power_stats_t(void):
+        num_samps(0),
+        sum_i(0.0),
+        sum_q(0.0),
+        sum_power(0.0)
+    {}
+
+    //! Number of samples accumulated since the last read
+    uint64_t num_samps;
+    //! Sum of the in-phase components
+    double sum_i;
+    //! Sum of the quadrature components
+    double sum_q;
+    //! Sum of the squared sample magnitudes
+    double sum_power;
+
+    //! Average DC offset over the accumulation window
+    std::complex<double> dc_offset(void) const{
+        if (num_samps == 0) return std::complex<double>(0.0, 0.0);
+        return std::complex<double>(
+            sum_i/double(num_samps), sum_q/double(num_samps));
+    }
+
+    //! Mean sample power over the accumulation window
+    double mean_power(void) const{
+        return (num_samps == 0)? 0.0 : sum_power/double(num_samps);
+    }
+};
+
 /*!
  * The RX streamer is the host interface to receiving samples.
  * It represents the layer between the samples on the host
@@ -224,6 +406,301 @@ public:
         const bool one_packet = false
     ) = 0;
 
+    /*!
+     * Receive a batch of buffers in a single call.
+     *
+     * This behaves like calling recv() once per entry in \p buffs,
+     * but amortizes the per-call overhead over the whole batch.
+     * Each entry in \p buffs is one set of channel buffers as would
+     * be passed to recv(); the number of samples written into entry i
+     * is stored in nsamps[i] and described by metadata[i].
+     *
+     * The call returns early when a buffer completes with an error
+     * code or an end of burst; buffers past that point are untouched.
+     * The nsamps and metadata vectors are resized to buffs.size().
+     *
+     * The same threading note as for recv() applies: this call is
+     * *not* thread-safe with respect to other receive calls.
+     *
+     * \param buffs a vector of buffer sets to fill with samples
+     * \param nsamps_per_buff the size of each buffer in number of samples
+     * \param nsamps the number of samples received into each buffer
+     * \param metadata data to fill describing each buffer
+     * \param timeout the timeout in seconds to wait for a packet
+     * \param one_packet return each buffer after a single packet
+     * \return the number of buffers that hold samples or metadata
+     */
+    virtual size_t recv_multi(
+        const std::vector<buffs_type> &buffs,
+        const size_t nsamps_per_buff,
+        std::vector<size_t> &nsamps,
+        std::vector<rx_metadata_t> &metadata,
+        const double timeout = 0.1,
+        const bool one_packet = false
+    );
+
+    /*!
+     * A buffer loaned out to the application by recv_loan().
+     *
+     * The data pointer refers directly into the payload of the
+     * underlying transport buffer. The loan keeps the transport
+     * buffer claimed until release() is called or the loan object
+     * is destroyed, at which point the buffer returns to the
+     * transport for reuse.
+     */
+    struct buff_loan_t{
+        buff_loan_t(void): data(NULL), nsamps(0){}
+
+        //! Release the underlying buffer back to the transport
+        void release(void){
+            data = NULL;
+            nsamps = 0;
+            buff.reset();
+        }
+
+        //! Sample payload in the over-the-wire sample layout
+        const void *data;
+        //! Number of samples in the payload
+        size_t nsamps;
+        //! Reference that keeps the transport buffer claimed
+        transport::managed_recv_buffer::sptr buff;
+    };
+
+    /*!
+     * Receive by loaning the transport buffer to the application.
+     *
+     * Rather than converting samples into a caller buffer, this
+     * call hands out the packet payload in place and thereby skips
+     * the converter and the copy entirely. The samples are in the
+     * over-the-wire layout of the link; the caller is expected to
+     * process them natively. This mode requires the wire item size
+     * to match the CPU item size (e.g. sc16 over the wire with
+     * sc16 as the CPU format) and a single channel streamer, and
+     * throws a uhd::runtime_error otherwise.
+     *
+     * The number of simultaneously outstanding loans is bounded by
+     * the receive frames of the transport: the application must
+     * release loans promptly or the transport will starve.
+     *
+     * \param loan filled with the payload pointer and buffer reference
+     * \param metadata data to fill describing the payload
+     * \param timeout the timeout in seconds to wait for a packet
+     * \return true when the loan holds data, false on error or timeout
+     */
+    virtual bool recv_loan(
+        buff_loan_t &loan,
+        rx_metadata_t &metadata,
+        const double timeout = 0.1
+    );
+
+    /*!
+     * A completed pre-posted receive buffer.
+     */
+    struct recv_completion_t{
+        recv_completion_t(void): index(0), nsamps(0){}
+        //! Posting order of the completed buffer set, counted from zero
+        size_t index;
+        //! Number of samples written into each channel buffer
+        size_t nsamps;
+        //! Metadata describing the received samples
+        rx_metadata_t metadata;
+    };
+
+    /*!
+     * Pre-post a destination buffer set for posted-mode receive.
+     *
+     * Posted buffer sets are filled in posting order by recv_posted(),
+     * the converter writing directly into the application's memory, so
+     * a pipeline that owns its buffers gets them filled without a
+     * handoff copy. The memory must stay valid until the buffer
+     * completes. Combine with register_recv_buff() to get streaming
+     * stores into DMA-capable regions.
+     *
+     * \param buffs one writable buffer per channel
+     * \param nsamps_per_buff the size of each buffer in samples
+     * \return the posting index the completion will carry
+     * \throws uhd::value_error if the buffer count does not match the
+     *         channel count or the size is zero
+     * \throws uhd::not_implemented_error if the underlying streamer
+     *         does not support posted buffers
+     */
+    virtual size_t post_recv_buff(
+        const buffs_type &buffs,
+        const size_t nsamps_per_buff
+    );
+
+    /*!
+     * Receive into the oldest posted buffer set.
+     *
+     * This behaves like one recv() call targeting the buffer set at
+     * the front of the posted queue: the completion reports the
+     * posting index, the samples written and the usual metadata. A
+     * timeout that produced no samples leaves the buffer posted and
+     * returns false; any other outcome (including a short fill ended
+     * by an error or end of burst) completes the buffer.
+     *
+     * The same threading note as for recv() applies.
+     *
+     * \param completion filled with the completed buffer's details
+     * \param timeout the timeout in seconds to wait for a packet
+     * \return true when a posted buffer completed
+     * \throws uhd::runtime_error if no buffers are posted
+     * \throws uhd::not_implemented_error if the underlying streamer
+     *         does not support posted buffers
+     */
+    virtual bool recv_posted(
+        recv_completion_t &completion,
+        const double timeout = 0.1
+    );
+
+    /*!
+     * Receive without ever blocking in the transport.
+     *
+     * This behaves like recv() with a zero timeout: packets already
+     * queued in the transport are processed and the call returns
+     * immediately. When no data is available, zero samples are
+     * returned and the metadata carries ERROR_CODE_TIMEOUT -- in this
+     * mode that simply means "nothing there yet", not a failure.
+     *
+     * Combined with get_recv_fds() this lets an application own its
+     * event loop: register the descriptors with poll/epoll alongside
+     * its own sockets, and call recv_nonblock() until empty whenever
+     * they become readable, instead of dedicating a thread that
+     * blocks inside recv() per streamer.
+     *
+     * The same threading note as for recv() applies.
+     *
+     * \param buffs a vector of writable memory to fill with samples
+     * \param nsamps_per_buff the size of each buffer in number of samples
+     * \param metadata data to fill describing the buffer
+     * \param one_packet return after the first packet is received
+     * \return the number of samples received or 0 when none are ready
+     */
+    virtual size_t recv_nonblock(
+        const buffs_type &buffs,
+        const size_t nsamps_per_buff,
+        rx_metadata_t &metadata,
+        const bool one_packet = false
+    );
+
+    /*!
+     * Get the pollable receive descriptors of this streamer.
+     *
+     * Returns one file descriptor per channel whose underlying
+     * transport has one; transports without a descriptor contribute
+     * no entry, so the vector may be empty (e.g. USB transports).
+     * The descriptors may be watched for readability with
+     * poll/epoll/select; on readiness call recv_nonblock() until it
+     * returns no data. Readability is a hint, not a guarantee of a
+     * complete aligned buffer. The descriptors remain owned by the
+     * transport -- do not read from or close them.
+     *
+     * \return descriptors to watch for receive readiness
+     * \throws uhd::not_implemented_error if the underlying streamer
+     *         cannot expose descriptors
+     */
+    virtual std::vector<int> get_recv_fds(void) const;
+
+    /*!
+     * Get a snapshot of the performance counters for this streamer.
+     *
+     * The counters accumulate from the creation of the streamer.
+     * This call is cheap and safe to poll from a monitoring thread
+     * while another thread is receiving.
+     *
+     * \return the accumulated counters
+     * \throws uhd::not_implemented_error if the underlying streamer
+     *         does not maintain counters
+     */
+    virtual stream_stats_t get_stream_stats(void) const;
+
+    /*!
+     * Describe the conversion routine this streamer selected.
+     *
+     * Reports the conversion the streamer resolved at creation (or after
+     * the last format change): the format pair, the priority of the
+     * routine in use and its implementation class ("general", "table",
+     * "simd", ...). Use it to verify that a host did not silently fall
+     * back to the generic converters, e.g. after a deployment change;
+     * combine with the converter_prio stream argument to force a
+     * specific routine for A/B testing.
+     *
+     * \return format pair, class and priority of the conversion in use
+     * \throws uhd::not_implemented_error if the underlying streamer
+     *         does not use the converter framework
+     */
+    virtual uhd::convert::converter_info_type get_converter_info(void) const;
+
+    /*!
+     * Get the timekeeper tracking per-sample times of received buffers.
+     *
+     * The timekeeper observes every recv() call on this streamer and
+     * vends the device time of any sample offset within the last
+     * received buffer, using 128-bit fixed point tick counts so that
+     * long free-running captures accumulate no floating point rounding
+     * error. Query it between recv() calls on the receiving thread;
+     * it replaces hand-rolled time_spec-plus-sample-index arithmetic.
+     *
+     * \return a reference to the streamer's timekeeper
+     * \throws uhd::not_implemented_error if the underlying streamer
+     *         does not track per-sample times
+     */
+    virtual const sample_timekeeper &get_timekeeper(void) const;
+
+    /*!
+     * Enable a rolling history of received samples on this streamer.
+     *
+     * Every recv() call appends its converted samples to a per-channel
+     * circular buffer sized to hold the given duration at the current
+     * sample rate. When a detector fires, freeze_history() stops the
+     * ring and read_history() copies out the samples that arrived just
+     * before the trigger - samples that the application has already
+     * consumed or discarded. Feeding the ring inside the streamer uses
+     * buffers that are still cache-hot from conversion, which is
+     * cheaper than a second full-rate copy at the application level.
+     *
+     * Pass a duration of zero to disable and release the buffer.
+     *
+     * \param duration history length in seconds
+     * \throws uhd::not_implemented_error if the underlying streamer
+     *         cannot maintain a history buffer
+     */
+    virtual void enable_history(const double duration);
+
+    /*!
+     * Stop history updates and report the samples held.
+     *
+     * The ring stops filling until resume_history() is called; recv()
+     * itself keeps streaming, so the device sees no backpressure from
+     * a frozen history.
+     *
+     * \return the number of samples held per channel
+     * \throws uhd::runtime_error if the history is not enabled
+     */
+    virtual size_t freeze_history(void);
+
+    /*!
+     * Copy samples out of a frozen history, oldest first.
+     *
+     * \param buffs a vector of writable memory, one per channel
+     * \param nsamps_per_buff the size of each buffer in samples
+     * \param offset skip this many of the oldest held samples
+     * \return the number of samples copied per channel
+     * \throws uhd::runtime_error if the history is not frozen
+     */
+    virtual size_t read_history(
+        const buffs_type &buffs,
+        const size_t nsamps_per_buff,
+        const size_t offset = 0
+    );
+
+    /*!
+     * Resume history updates after a freeze.
+     * The held samples remain valid and continue to age out as new
+     * samples arrive.
+     */
+    virtual void resume_history(void);
+
     /*!
      * Issue a stream command to the usrp device.
      * This tells the usrp to send samples into the host.
@@ -236,6 +713,188 @@ public:
      * \param stream_cmd the stream command to issue
      */
     virtual void issue_stream_cmd(const stream_cmd_t &stream_cmd) = 0;
+
+    /*!
+     * Schedule a train of timed stream commands for dispatch.
+     *
+     * The commands are queued on the host and fed into the device
+     * command FIFO ahead of their deadlines, so issuing a long train
+     * of gated captures does not require an application thread that
+     * sleeps and issues each command just in time.
+     *
+     * Every command must be timed (stream_now false) and should
+     * produce a finite burst: the completion of each burst on the
+     * receive path paces the refill of the device command FIFO.
+     *
+     * The default implementation issues all commands immediately,
+     * which works for trains that fit the device command FIFO.
+     *
+     * \param stream_cmds the stream commands in dispatch order
+     */
+    virtual void schedule_stream_cmds(const std::vector<stream_cmd_t> &stream_cmds);
+
+    /*!
+     * Register caller-owned output memory with this streamer.
+     *
+     * recv() always converts directly into the buffers passed by the
+     * caller; registration additionally tells the streamer that the
+     * region is a conversion destination that should be written with
+     * cache-bypassing streaming stores when such a converter exists
+     * for the stream's format pair. The typical use is DMA-capable
+     * pinned host memory (e.g. from cudaHostAlloc): converting into it
+     * directly removes the intermediate copy from a GPU processing
+     * path, and streaming stores avoid displacing the cache with data
+     * the CPU will never read.
+     *
+     * The memory must be 16-byte aligned and must stay valid for the
+     * lifetime of the streamer. Register regions before streaming
+     * starts; registration is not synchronized against a concurrent
+     * recv(). Buffers outside any registered region continue to use
+     * the default converter.
+     *
+     * \param mem the start of the caller-owned memory region
+     * \param num_bytes the length of the region in bytes
+     * \throws uhd::value_error if the memory is misaligned
+     * \throws uhd::not_implemented_error if the underlying streamer
+     *         does not support registered output memory
+     */
+    virtual void register_recv_buff(void *mem, const size_t num_bytes);
+
+    /*!
+     * Change the samples per packet of this stream at runtime.
+     *
+     * The packet size fixes the latency/throughput tradeoff of a
+     * stream: small packets keep the time-to-first-sample low, large
+     * packets amortize the per-packet overhead. This call re-programs
+     * the device's packet size and updates the streamer's bookkeeping
+     * in place, so an application can switch between a low-latency
+     * mode and a bulk-capture mode without tearing the streamer down
+     * and rebuilding it (which costs transport and flow control setup
+     * time).
+     *
+     * The new value takes effect on packets produced after the call;
+     * packets already in flight keep their old size and are handled
+     * transparently. The value may not exceed the frame-size-derived
+     * maximum established at streamer creation, since the transport
+     * buffers cannot grow. The call is *not* synchronized against a
+     * concurrent recv(); change the packet size between bursts or
+     * while the stream is stopped.
+     *
+     * \param spp the new number of samples per packet
+     * \throws uhd::value_error if \p spp is zero or exceeds the
+     *         frame-size-derived maximum
+     * \throws uhd::not_implemented_error if the underlying streamer
+     *         cannot re-program the packet size
+     */
+    virtual void set_samples_per_packet(const size_t spp);
+
+    /*!
+     * Apply host-side IQ corrections to this channel's samples.
+     *
+     * Every received sample is replaced by scale * sample + offset:
+     * the complex scale corrects gain and phase imbalance, the complex
+     * offset removes residual DC. Use this when the device cannot
+     * apply the corrections in hardware; the stage runs inside the
+     * receive conversion pass with SIMD, on each block while it is
+     * still cache-hot, so it is much cheaper than a separate
+     * full-buffer sweep in the application.
+     *
+     * Only the fc32 CPU format is supported. Pass a scale of 1 and an
+     * offset of 0 to disable the stage; it is disabled by default and
+     * then costs nothing.
+     *
+     * \param chan which channel of this streamer to correct
+     * \param scale complex gain/phase correction factor
+     * \param offset complex DC offset correction term
+     * \throws uhd::runtime_error if the CPU format is not fc32
+     * \throws uhd::not_implemented_error if the underlying streamer
+     *         does not support host-side corrections
+     */
+    virtual void set_iq_corrections(
+        const size_t chan,
+        const std::complex<float> &scale,
+        const std::complex<float> &offset
+    );
+
+    /*!
+     * Accumulate per-channel signal statistics inside the receive pass.
+     *
+     * When enabled, every delivered block also feeds component sums
+     * and a sum of squared magnitudes into per-channel accumulators,
+     * ridden along the conversion pass with SIMD while the block is
+     * cache-hot. A monitoring pipeline that derives mean power and DC
+     * offset from these no longer needs its own full-rate sweep over
+     * every buffer.
+     *
+     * Only the fc32 CPU format is supported. Disabled by default, in
+     * which case the fast path is untouched.
+     *
+     * \param enable true to accumulate, false to stop
+     * \throws uhd::runtime_error if the CPU format is not fc32
+     * \throws uhd::not_implemented_error if the underlying streamer
+     *         does not support in-stream statistics
+     */
+    virtual void set_power_stats_enabled(const bool enable);
+
+    /*!
+     * Read and reset one channel's accumulated signal statistics.
+     *
+     * The accumulators are written by the conversion pass and are not
+     * synchronized against it: read them between recv() calls, or from
+     * the thread that calls recv().
+     *
+     * \param chan which channel of this streamer to read
+     * \return the statistics accumulated since the last read
+     * \throws uhd::not_implemented_error if the underlying streamer
+     *         does not support in-stream statistics
+     */
+    virtual power_stats_t get_power_stats(const size_t chan);
+
+    /*!
+     * Re-establish this streamer's data transports after a link failure.
+     *
+     * When the network path dies under a running stream (NIC flap,
+     * switch reconvergence), the device keeps its stale routing and
+     * flow control state and the stream never recovers on its own.
+     * This call rebuilds the data transports, re-programs the device
+     * routing for the new sockets and restarts the flow control
+     * conversation, while the streamer object and its configuration
+     * (format, converter, channels) stay intact - so recovery costs
+     * transport setup only instead of a full session rebuild.
+     *
+     * Call it after recv() reports persistent timeouts once the link
+     * is expected to be back. Samples produced while the path was down
+     * are lost; one overflow notification may surface as the stream
+     * resumes. Do not call concurrently with recv().
+     *
+     * \throws uhd::not_implemented_error if the underlying streamer
+     *         cannot rebuild its transports
+     */
+    virtual void reconnect(void);
+
+    /*!
+     * Switch the CPU sample format on a live stream.
+     *
+     * Destroying and recreating a streamer to change the host-side
+     * format costs tens of milliseconds and risks overflows; this
+     * swaps the conversion routine in place instead. Only the CPU
+     * format may change - the wire format and the channel topology
+     * are fixed by the device configuration.
+     *
+     * The new format is validated and resolved on the caller's thread;
+     * the receive path applies it at the next packet boundary, so no
+     * call mixes formats within its output. Buffers passed to recv()
+     * after this call returns must be sized for the new format. Any
+     * buffered history ring restarts empty since its samples are in
+     * the old format.
+     *
+     * \param cpu_format the new CPU format (see stream_args_t)
+     * \throws uhd::value_error if no converter exists from the
+     *         configured wire format to \p cpu_format
+     * \throws uhd::not_implemented_error if the underlying streamer
+     *         does not support a live converter swap
+     */
+    virtual void set_cpu_format(const std::string &cpu_format);
 };
 
 /*!
@@ -295,6 +954,220 @@ public:
     virtual bool recv_async_msg(
         async_metadata_t &async_metadata, double timeout = 0.1
     ) = 0;
+
+    /*!
+     * A contiguous run of samples within a scattered send buffer.
+     */
+    struct span_t{
+        span_t(const void *data_ = NULL, const size_t nsamps_ = 0):
+            data(data_), nsamps(nsamps_){}
+        //! Pointer to the first sample of the run
+        const void *data;
+        //! Number of samples in the run
+        size_t nsamps;
+    };
+
+    //! An ordered list of spans making up one channel's samples
+    typedef std::vector<span_t> span_list_t;
+
+    /*!
+     * Send samples described by a scatter list per channel.
+     *
+     * This behaves like send(), except that each channel's samples may
+     * be scattered across multiple non-contiguous memory runs. The
+     * conversion pass walks the scatter list directly while packing
+     * frames, so sample producers that emit fragments (frame assembly,
+     * block-based DSP output) need not copy them into a contiguous
+     * staging buffer first.
+     *
+     * Every channel's spans must sum to the same total sample count;
+     * that total is sent with the usual fragmentation and burst flag
+     * rules of send(). Formats with interleaved input buffers per
+     * channel are not supported by this call.
+     *
+     * \param buffs one span list per channel
+     * \param metadata data describing the buffer's contents
+     * \param timeout the timeout in seconds to wait on a packet
+     * \return the number of samples sent
+     * \throws uhd::value_error if the span totals differ across channels
+     * \throws uhd::not_implemented_error if the underlying streamer
+     *         does not support scattered sends
+     */
+    virtual size_t send_spans(
+        const std::vector<span_list_t> &buffs,
+        const tx_metadata_t &metadata,
+        const double timeout = 0.1
+    );
+
+    /*!
+     * Enable or disable drop-on-timeout send mode.
+     *
+     * In this mode the timeout passed to send() becomes a hard
+     * deadline for the whole call: when the transport cannot accept a
+     * packet before the deadline (flow control credits exhausted, no
+     * free send buffer), the packet's samples are dropped instead of
+     * blocking, and send() returns as if they had been sent. Dropped
+     * samples are reported through the num_dropped_samps performance
+     * counter.
+     *
+     * This bounds the latency of a real-time transmit feed: a
+     * transient stall costs the stalled samples rather than growing
+     * the end-to-end latency by the stall duration. The mode is off
+     * by default, preserving the blocking behavior of send().
+     *
+     * \param enable true to drop on deadline, false to block
+     * \throws uhd::not_implemented_error if the underlying streamer
+     *         does not support the mode
+     */
+    virtual void set_drop_on_timeout(const bool enable);
+
+    /*!
+     * Pre-stage a complete timed burst into the device buffers.
+     *
+     * The call packs the whole burst and pushes every packet towards
+     * the device immediately; on devices with a deep transmit buffer
+     * (e.g. an off-chip DMA FIFO) the burst then waits in hardware for
+     * its time spec, so it fires on time even when the host hiccups
+     * for tens of milliseconds afterwards. This removes the LATE_COMMAND
+     * failure mode of calling send() just-in-time before the burst.
+     *
+     * The metadata must describe a timed, complete burst: it must have
+     * a time spec in the future as well as the start and end of burst
+     * flags set. The call blocks until the burst has been handed to
+     * the transport (bounded by the device buffer space - use
+     * get_buffer_occupancy() to check how much of it is in use).
+     *
+     * \param buffs a vector of read-only memory containing samples
+     * \param nsamps_per_buff the number of samples to stage, per buffer
+     * \param metadata data describing the burst (must be a timed burst)
+     * \param timeout the timeout in seconds to wait on device buffer space
+     * \return the number of samples staged
+     * \throws uhd::value_error if the metadata does not describe a
+     *         timed, complete burst
+     */
+    virtual size_t stage_burst(
+        const buffs_type &buffs,
+        const size_t nsamps_per_buff,
+        const tx_metadata_t &metadata,
+        const double timeout = 1.0
+    );
+
+    /*!
+     * Get the occupancy of the device-side send buffer.
+     *
+     * Reports the fraction of the device buffer (the flow control
+     * window, e.g. the off-chip DMA FIFO) holding data the device has
+     * not yet consumed; with multiple channels the fullest one is
+     * reported. Poll this after stage_burst() to confirm a burst is
+     * resident in hardware, or before staging the next burst to check
+     * that it will fit without blocking.
+     *
+     * The estimate is derived from the flow control state and lags by
+     * up to one flow control update interval. It is cheap and safe to
+     * call from a monitoring thread while another thread is sending.
+     *
+     * \return the occupied fraction of the device buffer, 0.0 to 1.0
+     * \throws uhd::not_implemented_error if the underlying streamer
+     *         cannot observe the device buffer level
+     */
+    virtual double get_buffer_occupancy(void) const;
+
+    /*!
+     * Register a low/high watermark callback on the device buffer.
+     *
+     * The occupancy (as reported by get_buffer_occupancy()) is checked
+     * at the end of every send call: when it rises to \p high the
+     * callback fires with true, and not again until it has fallen back
+     * to \p low, where the callback fires with false. A sender can use
+     * this to throttle proactively instead of learning about a full or
+     * drained buffer from an underflow after the fact.
+     *
+     * The callback runs on the thread calling send() and must be
+     * lightweight and non-allocating; typically it just sets a flag or
+     * posts to a semaphore the pacing logic waits on.
+     *
+     * \param low occupancy fraction to re-arm the callback, 0.0 to 1.0
+     * \param high occupancy fraction to fire the callback, >= \p low
+     * \param callback invoked with true on rising through \p high,
+     *                 false on falling through \p low
+     * \throws uhd::value_error if the watermarks are out of order or
+     *         outside [0.0, 1.0]
+     * \throws uhd::not_implemented_error if the underlying streamer
+     *         cannot observe the device buffer level
+     */
+    virtual void set_occupancy_watermarks(
+        const double low,
+        const double high,
+        const std::function<void(const bool above_high)> &callback
+    );
+
+    /*!
+     * Get a snapshot of the performance counters for this streamer.
+     *
+     * The counters accumulate from the creation of the streamer.
+     * This call is cheap and safe to poll from a monitoring thread
+     * while another thread is sending.
+     *
+     * \return the accumulated counters
+     * \throws uhd::not_implemented_error if the underlying streamer
+     *         does not maintain counters
+     */
+    virtual stream_stats_t get_stream_stats(void) const;
+
+    /*!
+     * Describe the conversion routine this streamer selected.
+     *
+     * Reports the conversion the streamer resolved at creation: the
+     * format pair, the priority of the routine in use and its
+     * implementation class ("general", "table", "simd", ...). Use it to
+     * verify that a host did not silently fall back to the generic
+     * converters; combine with the converter_prio stream argument to
+     * force a specific routine for A/B testing.
+     *
+     * \return format pair, class and priority of the conversion in use
+     * \throws uhd::not_implemented_error if the underlying streamer
+     *         does not use the converter framework
+     */
+    virtual uhd::convert::converter_info_type get_converter_info(void) const;
+
+    /*!
+     * Enable or disable replicated-send mode.
+     *
+     * When enabled, every channel of this streamer transmits the same
+     * samples: send() reads only the first channel's buffer, converts
+     * it once, and copies the converted payload into the other
+     * channels' packets (headers remain per-channel). For N identical
+     * channels, e.g. a phased array transmitting one waveform, this
+     * replaces N conversion passes with one pass plus N-1 payload
+     * copies.
+     *
+     * The signature of send() is unchanged: pass the usual buffer
+     * vector (the same pointer for every channel is fine); buffers
+     * past the first channel are ignored while the mode is enabled.
+     * Do not toggle the mode while another thread is sending.
+     * The mode is disabled by default.
+     *
+     * \param enable true to convert once and replicate, false for
+     *               independent per-channel conversion
+     * \throws uhd::not_implemented_error if the underlying streamer
+     *         does not support replication
+     */
+    virtual void set_replicate_channels(const bool enable);
+
+    /*!
+     * Re-establish this streamer's data transports after a link failure.
+     *
+     * The transmit counterpart of rx_streamer::reconnect(): rebuilds
+     * the data transports, re-programs the device routing and restarts
+     * the flow control conversation without recreating the device or
+     * the streamer. Samples in flight when the path died are lost; one
+     * sequence error may be reported device-side as the stream
+     * resumes. Do not call concurrently with send().
+     *
+     * \throws uhd::not_implemented_error if the underlying streamer
+     *         cannot rebuild its transports
+     */
+    virtual void reconnect(void);
 };
 
 } //namespace uhd
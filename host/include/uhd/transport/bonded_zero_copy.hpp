@@ -0,0 +1,43 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_LIBUHD_BONDED_ZERO_COPY_HPP
+#define INCLUDED_LIBUHD_BONDED_ZERO_COPY_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/transport/zero_copy.hpp>
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+namespace uhd { namespace transport {
+
+/*! Aggregate several zero-copy links into one logical transport.
+ *
+ * Send buffers are handed out round-robin across the member links, so a
+ * stream of packets is striped over all of them. Receive buffers are
+ * polled from all members. Packets may therefore be reordered slightly
+ * across the links in both directions; the consumer must tolerate this
+ * (e.g. via the recv packet handler's sequence reorder window).
+ *
+ * All member links are expected to reach the same endpoint. Calls are not
+ * synchronized internally; like the underlying transports, one thread per
+ * direction is assumed.
+ */
+class UHD_API bonded_zero_copy : public virtual zero_copy_if {
+public:
+    typedef boost::shared_ptr<bonded_zero_copy> sptr;
+
+    /*! Create a bonded transport from its member links.
+     *
+     * \param links the member transports, at least one
+     * \throws uhd::value_error if \p links is empty
+     */
+    static sptr make(const std::vector<zero_copy_if::sptr> &links);
+};
+
+}} /* namespace uhd::transport */
+
+#endif /* INCLUDED_LIBUHD_BONDED_ZERO_COPY_HPP */
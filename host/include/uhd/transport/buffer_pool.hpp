@@ -38,6 +38,43 @@ namespace uhd{ namespace transport{
             const size_t alignment = 16
         );
 
+        /*!
+         * Make a new buffer pool with memory bound to a NUMA node.
+         * Keeping the frame memory on the node that runs the streaming
+         * threads avoids cross-socket traffic on multi-socket hosts.
+         * Falls back to a regular allocation (with a warning) when UHD
+         * was built without libnuma or the node does not exist.
+         * \param num_buffs the number of buffers to allocate
+         * \param buff_size the size of each buffer in bytes
+         * \param node the NUMA node to allocate on
+         * \param alignment the alignment boundary in bytes
+         * \return a new buffer pool buff_size X num_buffs
+         */
+        static sptr make_numa(
+            const size_t num_buffs,
+            const size_t buff_size,
+            const int node,
+            const size_t alignment = 16
+        );
+
+        /*!
+         * Make a new buffer pool backed by 2 MB huge pages.
+         * Large frame pools on 4 KB pages cost dTLB misses in the
+         * packet handlers; huge-page backing removes those, and the
+         * default alignment keeps each frame on a cache-line boundary.
+         * Falls back to a regular allocation (with a warning) when no
+         * huge pages are available or the platform has no support.
+         * \param num_buffs the number of buffers to allocate
+         * \param buff_size the size of each buffer in bytes
+         * \param alignment the alignment boundary in bytes
+         * \return a new buffer pool buff_size X num_buffs
+         */
+        static sptr make_huge(
+            const size_t num_buffs,
+            const size_t buff_size,
+            const size_t alignment = 64
+        );
+
         //! Get a pointer to the buffer start at the specified index
         virtual ptr_type at(const size_t index) const = 0;
 
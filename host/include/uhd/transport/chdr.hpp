@@ -9,6 +9,7 @@
 #define INCLUDED_UHD_TRANSPORT_CHDR_HPP
 
 #include <uhd/transport/vrt_if_packet.hpp>
+#include <uhd/utils/byteswap.hpp>
 
 namespace uhd{ namespace transport{ namespace vrt{
 
@@ -95,6 +96,128 @@ namespace chdr{
         if_packet_info_t &if_packet_info
     );
 
+    /*!
+     * Non-throwing variant of if_hdr_unpack_be().
+     * Reports malformed packets through the return value instead of an
+     * exception, so the receive fastpath can reject bad packets without
+     * exception or string-construction cost.
+     *
+     * \param packet_buff memory to read the packed vrt header
+     * \param if_packet_info the if packet info (read/write)
+     * \return UNPACK_NO_ERROR on success, the error condition otherwise
+     */
+    UHD_API unpack_error_t if_hdr_unpack_be_nothrow(
+        const uint32_t *packet_buff,
+        if_packet_info_t &if_packet_info
+    );
+
+    /*!
+     * Non-throwing variant of if_hdr_unpack_le().
+     * See if_hdr_unpack_be_nothrow().
+     *
+     * \param packet_buff memory to read the packed vrt header
+     * \param if_packet_info the if packet info (read/write)
+     * \return UNPACK_NO_ERROR on success, the error condition otherwise
+     */
+    UHD_API unpack_error_t if_hdr_unpack_le_nothrow(
+        const uint32_t *packet_buff,
+        if_packet_info_t &if_packet_info
+    );
+
+    /*!
+     * Trusted-link variant of if_hdr_unpack_be_nothrow().
+     * Decodes all header fields but skips the length cross-checks, on
+     * the assumption that the link has already proven itself: use it
+     * only on an established stream after initial packets have passed
+     * the full validation. Truncated or corrupted packets are then
+     * caught later (or not at all), so this trades safety margin for
+     * fewer branches per packet. Defining UHD_CHDR_ALWAYS_VALIDATE at
+     * compile time turns these back into the fully checked variants
+     * for debugging.
+     *
+     * \param packet_buff memory to read the packed vrt header
+     * \param if_packet_info the if packet info (read/write)
+     * \return UNPACK_NO_ERROR (always, unless validation is forced on)
+     */
+    UHD_API unpack_error_t if_hdr_unpack_be_trusted(
+        const uint32_t *packet_buff,
+        if_packet_info_t &if_packet_info
+    );
+
+    /*!
+     * Trusted-link variant of if_hdr_unpack_le_nothrow().
+     * See if_hdr_unpack_be_trusted().
+     *
+     * \param packet_buff memory to read the packed vrt header
+     * \param if_packet_info the if packet info (read/write)
+     * \return UNPACK_NO_ERROR (always, unless validation is forced on)
+     */
+    UHD_API unpack_error_t if_hdr_unpack_le_trusted(
+        const uint32_t *packet_buff,
+        if_packet_info_t &if_packet_info
+    );
+
+    /*!
+     * Compile-time specialized CHDR header packer.
+     *
+     * The generic if_hdr_pack_* functions re-derive the header layout
+     * from if_packet_info_t on every call. Header layout properties
+     * that are fixed for the lifetime of a stream can instead be baked
+     * into a template instantiation, letting the compiler fold the
+     * layout constants and drop the branches - header packing runs on
+     * every TX packet, so this is worth a setup-time selection.
+     *
+     * The \p has_tsf parameter must match `if_packet_info.has_tsf`;
+     * the streamer selects the matching instantiation per packet (the
+     * field only changes between bursts, so that branch predicts).
+     * Semantics are otherwise identical to if_hdr_pack_be()/_le().
+     *
+     * \tparam big_endian true for the _be layout, false for _le
+     * \tparam has_tsf true when the packet carries a fractional time
+     * \param packet_buff memory to write the packed vrt header
+     * \param if_packet_info the if packet info (read/write)
+     */
+    template <bool big_endian, bool has_tsf>
+    UHD_INLINE void if_hdr_pack_tmpl(
+        uint32_t *packet_buff,
+        if_packet_info_t &if_packet_info
+    ){
+        const size_t num_header_words32 = has_tsf ? 4 : 2;
+        if_packet_info.num_header_words32 = num_header_words32;
+        if_packet_info.num_packet_words32 =
+            num_header_words32 + if_packet_info.num_payload_words32;
+
+        const uint16_t pkt_length = uint16_t(
+            if_packet_info.num_payload_bytes + 4*num_header_words32);
+        const uint32_t chdr = 0
+            // 2 Bits: Packet type
+            | (uint32_t(if_packet_info.packet_type) << 30)
+            // 1 Bit: Has time (folded to an immediate)
+            | (has_tsf ? (uint32_t(1) << 29) : 0)
+            // 1 Bit: EOB or Error or FC ACK
+            | (uint32_t(
+                if_packet_info.eob or if_packet_info.error
+                or if_packet_info.fc_ack) << 28)
+            // 12 Bits: Sequence number
+            | ((uint32_t(if_packet_info.packet_count) & 0xFFF) << 16)
+            // 16 Bits: Total packet length
+            | pkt_length;
+
+        packet_buff[0] = big_endian?
+            uhd::htonx<uint32_t>(chdr) : uhd::htowx<uint32_t>(chdr);
+        packet_buff[1] = big_endian?
+            uhd::htonx<uint32_t>(if_packet_info.sid) :
+            uhd::htowx<uint32_t>(if_packet_info.sid);
+        if (has_tsf){ //compile-time constant
+            const uint32_t tsf_hi = uint32_t(if_packet_info.tsf >> 32);
+            const uint32_t tsf_lo = uint32_t(if_packet_info.tsf >> 0);
+            packet_buff[2] = big_endian?
+                uhd::htonx<uint32_t>(tsf_hi) : uhd::htowx<uint32_t>(tsf_hi);
+            packet_buff[3] = big_endian?
+                uhd::htonx<uint32_t>(tsf_lo) : uhd::htowx<uint32_t>(tsf_lo);
+        }
+    }
+
 } //namespace chdr
 
 }}} //namespace uhd::transport::vrt
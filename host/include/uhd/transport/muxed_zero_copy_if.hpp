@@ -44,8 +44,19 @@ public:
     //! virtual dtor
     virtual ~muxed_zero_copy_if() {}
 
-    //! Make a virtual transport for the specified stream number
-    virtual zero_copy_if::sptr make_stream(const uint32_t stream_num) = 0;
+    /*!
+     * Make a virtual transport for the specified stream number.
+     *
+     * A priority stream carries latency-sensitive traffic (control
+     * responses). Once any priority stream exists, a full receive
+     * queue on a non-priority stream drops the frame instead of
+     * blocking the demux thread, so bulk traffic cannot head-of-line
+     * block a control response behind it.
+     *
+     * \param stream_num the stream identifier from the classifier
+     * \param priority true for latency-sensitive streams
+     */
+    virtual zero_copy_if::sptr make_stream(const uint32_t stream_num, const bool priority = false) = 0;
 
     //! Unregister the stream number. All packets destined to the stream will be dropped.
     virtual void remove_stream(const uint32_t stream_num) = 0;
@@ -53,8 +64,21 @@ public:
     //! Get number of frames dropped due to unregistered streams
     virtual size_t get_num_dropped_frames() const = 0;
 
-    //! Make a new demuxer from a transport and parameters
-    static sptr make(zero_copy_if::sptr base_xport, stream_classifier_fn classify_fn, size_t max_streams);
+    /*!
+     * Make a new demuxer from a transport and parameters.
+     *
+     * In low-latency mode, the demux thread takes the "ctrl_mux"
+     * thread policy role, elevates its scheduling priority, and
+     * busy-polls the underlying transport instead of sleeping when
+     * idle, bounding the latency of control responses during
+     * full-rate streaming at the cost of railing one core.
+     *
+     * \param base_xport the transport to mux virtual streams onto
+     * \param classify_fn stream classifier for received frames
+     * \param max_streams maximum number of virtual streams
+     * \param low_latency true to busy-poll with an elevated priority
+     */
+    static sptr make(zero_copy_if::sptr base_xport, stream_classifier_fn classify_fn, size_t max_streams, const bool low_latency = false);
 };
 
 }} //namespace uhd::transport
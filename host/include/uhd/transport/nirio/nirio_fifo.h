@@ -129,6 +129,9 @@ public:
 
     /*!
     * Releases space in the DMA buffer so it can be read by the device (output) or written by the device (input)
+    * For input FIFOs the grant to the kernel driver may be deferred and coalesced
+    * with later releases (interrupt moderation); deferred grants are flushed
+    * before any blocking acquire and when the FIFO is stopped.
     * \param elements Size (in elements) of the block to release.
     * \return status
     */
@@ -201,6 +204,12 @@ private:    //Methods
         const fifo_optimization_option_t fifo_optimization_option,
         nirio_status& status);
 
+    /*!
+    * Grants any elements deferred by interrupt moderation back to the RIO kernel driver
+    * \return status
+    */
+    nirio_status _flush_pending_releases();
+
 private:    //Members
     enum fifo_state_t {
         UNMAPPED, MAPPED, STARTED
@@ -225,6 +234,8 @@ private:    //Members
     boost::atomic<size_t>          _total_elements_acquired;
     size_t                         _frame_size_in_elements;
     fifo_optimization_option_t     _fifo_optimization_option;
+    size_t                         _pending_release_elements;
+    size_t                         _release_batch_elements;
 
     static const uint32_t FIFO_LOCK_TIMEOUT_IN_MS = 5000;
 };
@@ -34,7 +34,9 @@ nirio_fifo<data_t>::nirio_fifo(
     _actual_depth_in_elements(0),
     _total_elements_acquired(0),
     _frame_size_in_elements(0),
-    _fifo_optimization_option(MINIMIZE_LATENCY)
+    _fifo_optimization_option(MINIMIZE_LATENCY),
+    _pending_release_elements(0),
+    _release_batch_elements(0)
 {
     nirio_status status = 0;
     nirio_status_chain(_riok_proxy_ptr->set_attribute(RIO_ADDRESS_SPACE, BUS_INTERFACE), status);
@@ -67,6 +69,7 @@ nirio_status nirio_fifo<data_t>::initialize(
 
         _frame_size_in_elements = frame_size_in_elements;
         _fifo_optimization_option = fifo_optimization_option;
+        _release_batch_elements = frame_size_in_elements;
 
         uint32_t actual_depth_u32 = 0;
         uint32_t actual_size_u32 = 0;
@@ -180,6 +183,24 @@ bool nirio_fifo<data_t>::_acquire_block_from_rio_buffer(
     {
         _remaining_acquirable_elements = static_cast<size_t>(elements_remaining_u32);
 
+        // Adapt the grant batch (interrupt moderation) to the observed fill
+        // rate: a backlog in the DMA buffer means we are throughput bound and
+        // can defer more grants per kernel transition; an empty buffer means
+        // we are keeping up and drop back towards per-frame granting so the
+        // device is never starved of space longer than necessary.
+        if (_fifo_direction == INPUT_FIFO && _frame_size_in_elements > 0)
+        {
+            const size_t max_batch_elements = std::max(
+                _frame_size_in_elements, _actual_depth_in_elements / 4);
+            if (_remaining_acquirable_elements >= _release_batch_elements * 2) {
+                _release_batch_elements = std::min(
+                    _release_batch_elements * 2, max_batch_elements);
+            } else if (_remaining_acquirable_elements == 0) {
+                _release_batch_elements = std::max(
+                    _frame_size_in_elements, _release_batch_elements / 2);
+            }
+        }
+
         if (elements_acquired_u32 > 0)
         {
             _total_elements_acquired += static_cast<size_t>(elements_acquired_u32);
@@ -209,6 +230,8 @@ nirio_status nirio_fifo<data_t>::start()
         _total_elements_acquired = 0;
         _remaining_in_claimed_block = 0;
         _remaining_acquirable_elements = 0;
+        _pending_release_elements = 0;
+        _release_batch_elements = _frame_size_in_elements;
 
         status = _riok_proxy_ptr->start_fifo(_fifo_channel);
 
@@ -241,8 +264,13 @@ nirio_status nirio_fifo<data_t>::stop()
 
     if (_state == STARTED) {
 
-        // release any remaining acquired elements
-        if (_total_elements_acquired > 0) release(_total_elements_acquired);
+        // release any remaining acquired elements, including grants
+        // still deferred by interrupt moderation
+        if (_total_elements_acquired > 0) {
+            _pending_release_elements = _total_elements_acquired;
+            _flush_pending_releases();
+        }
+        _pending_release_elements = 0;
         _total_elements_acquired = 0;
         _remaining_in_claimed_block = 0;
         _remaining_acquirable_elements = 0;
@@ -272,7 +300,11 @@ nirio_status nirio_fifo<data_t>::acquire(
 
         if (_remaining_in_claimed_block == 0)
         {
-   
+            // we are about to transition into the kernel anyway (and possibly
+            // block), so push out any grants deferred by interrupt moderation
+            // first -- the device may need that buffer space to make progress
+            nirio_status_chain(_flush_pending_releases(), status);
+
             // so acquire some now
             if (!_acquire_block_from_rio_buffer(
                      elements_requested,
@@ -323,10 +355,16 @@ nirio_status nirio_fifo<data_t>::release(const size_t elements)
     boost::unique_lock<boost::recursive_mutex> lock(_mutex);
 
     if (_state == STARTED) {
-        status = _riok_proxy_ptr->grant_fifo(
-            _fifo_channel,
-            static_cast<uint32_t>(elements));
-        _total_elements_acquired -= elements;
+        // Interrupt moderation: every grant is a kernel transition and an
+        // interrupt on the device side. For input FIFOs the grant merely
+        // recycles buffer space, so it is coalesced and signalled once per
+        // batch; output grants kick off the actual transfer to the device
+        // and always go out immediately.
+        _pending_release_elements += elements;
+        if (_fifo_direction == OUTPUT_FIFO ||
+            _pending_release_elements >= _release_batch_elements) {
+            status = _flush_pending_releases();
+        }
     } else {
         status = NiRio_Status_ResourceNotInitialized;
     }
@@ -334,6 +372,22 @@ nirio_status nirio_fifo<data_t>::release(const size_t elements)
     return status;
 }
 
+template <typename data_t>
+nirio_status nirio_fifo<data_t>::_flush_pending_releases()
+{
+    //_riok_proxy_ptr must be valid and _mutex must be locked
+
+    nirio_status status = NiRio_Status_Success;
+    if (_pending_release_elements > 0) {
+        status = _riok_proxy_ptr->grant_fifo(
+            _fifo_channel,
+            static_cast<uint32_t>(_pending_release_elements));
+        _total_elements_acquired -= _pending_release_elements;
+        _pending_release_elements = 0;
+    }
+    return status;
+}
+
 template <typename data_t>
 nirio_status nirio_fifo<data_t>::read(
     data_t* buf,
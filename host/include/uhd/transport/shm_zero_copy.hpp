@@ -0,0 +1,54 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHD_TRANSPORT_SHM_ZERO_COPY_HPP
+#define INCLUDED_UHD_TRANSPORT_SHM_ZERO_COPY_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/transport/zero_copy.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace uhd{ namespace transport{
+
+/*!
+ * A zero copy transport over a shared-memory ring (Linux only).
+ *
+ * Two co-located processes exchange managed buffers through a pair of
+ * single-producer single-consumer rings in a POSIX shared memory
+ * segment, with a futex doorbell per ring direction. Buffers are
+ * written and read in place, so handing a packet to the peer process
+ * costs neither a memory copy nor a socket send.
+ *
+ * The first process to open a segment name creates and sizes it from
+ * its hints; the second process attaches and adopts the creator's
+ * frame geometry. The creator sends on ring 0 and receives on ring 1,
+ * the attacher does the opposite, so both ends simply call make()
+ * with the same name.
+ */
+struct UHD_API shm_zero_copy : public virtual zero_copy_if
+{
+    virtual ~shm_zero_copy(void);
+
+    /*!
+     * Make a new zero copy shared-memory transport:
+     *
+     * \param name name of the shared memory segment (e.g. "uhd_dsp0")
+     * \param hints optional parameters:
+     *  - recv_frame_size, num_recv_frames
+     *  - send_frame_size, num_send_frames
+     *  (only honored by the creating process)
+     * \throws uhd::not_implemented_error on non-Linux platforms
+     */
+    static zero_copy_if::sptr make(
+        const std::string &name,
+        const device_addr_t &hints = device_addr_t()
+    );
+};
+
+}} //namespace
+
+#endif /* INCLUDED_UHD_TRANSPORT_SHM_ZERO_COPY_HPP */
@@ -0,0 +1,105 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHD_TRANSPORT_SPSC_BOUNDED_BUFFER_HPP
+#define INCLUDED_UHD_TRANSPORT_SPSC_BOUNDED_BUFFER_HPP
+
+#include <uhd/transport/spsc_bounded_buffer.ipp> //detail
+
+namespace uhd{ namespace transport{
+
+    /*!
+     * Implement a templated lock-free bounded buffer for the
+     * single-producer/single-consumer case:
+     * Exactly one thread may push and exactly one thread may pop.
+     * The fast paths are wait-free ring operations on atomic indices;
+     * the waiting variants spin for a bounded number of iterations
+     * before falling back to a condition variable, so a per-packet
+     * handoff between a fixed thread pair pays no mutex acquisitions.
+     *
+     * The interface matches bounded_buffer with the exception of
+     * push_with_pop_on_full, which cannot be implemented without
+     * the producer touching the consumer side of the ring.
+     */
+    template <typename elem_type> class spsc_bounded_buffer{
+    public:
+
+        /*!
+         * Create a new SPSC bounded buffer object.
+         * \param capacity the buffer capacity
+         */
+        spsc_bounded_buffer(size_t capacity):
+            _detail(capacity)
+        {
+            /* NOP */
+        }
+
+        /*!
+         * Push a new element into the bounded buffer immediately.
+         * The element will not be pushed when the buffer is full.
+         * \param elem the new element to push
+         * \return false when the buffer is full
+         */
+        UHD_INLINE bool push_with_haste(const elem_type &elem){
+            return _detail.push_with_haste(elem);
+        }
+
+        /*!
+         * Push a new element into the bounded buffer.
+         * Wait until the bounded buffer becomes non-full.
+         * \param elem the new element to push
+         */
+        UHD_INLINE void push_with_wait(const elem_type &elem){
+            return _detail.push_with_wait(elem);
+        }
+
+        /*!
+         * Push a new element into the bounded buffer.
+         * Wait until the bounded buffer becomes non-full or timeout.
+         * \param elem the new element to push
+         * \param timeout the timeout in seconds
+         * \return false when the operation times out
+         */
+        UHD_INLINE bool push_with_timed_wait(const elem_type &elem, double timeout){
+            return _detail.push_with_timed_wait(elem, timeout);
+        }
+
+        /*!
+         * Pop an element from the bounded buffer immediately.
+         * The element will not be popped when the buffer is empty.
+         * \param elem the element reference pop to
+         * \return false when the buffer is empty
+         */
+        UHD_INLINE bool pop_with_haste(elem_type &elem){
+            return _detail.pop_with_haste(elem);
+        }
+
+        /*!
+         * Pop an element from the bounded buffer.
+         * Wait until the bounded buffer becomes non-empty.
+         * \param elem the element reference pop to
+         */
+        UHD_INLINE void pop_with_wait(elem_type &elem){
+            return _detail.pop_with_wait(elem);
+        }
+
+        /*!
+         * Pop an element from the bounded buffer.
+         * Wait until the bounded buffer becomes non-empty or timeout.
+         * \param elem the element reference pop to
+         * \param timeout the timeout in seconds
+         * \return false when the operation times out
+         */
+        UHD_INLINE bool pop_with_timed_wait(elem_type &elem, double timeout){
+            return _detail.pop_with_timed_wait(elem, timeout);
+        }
+
+    private: spsc_bounded_buffer_detail<elem_type> _detail;
+    };
+
+}} //namespace
+
+#endif /* INCLUDED_UHD_TRANSPORT_SPSC_BOUNDED_BUFFER_HPP */
@@ -0,0 +1,194 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHD_TRANSPORT_SPSC_BOUNDED_BUFFER_IPP
+#define INCLUDED_UHD_TRANSPORT_SPSC_BOUNDED_BUFFER_IPP
+
+#include <uhd/config.hpp>
+#include <boost/utility.hpp>
+#include <boost/thread/condition.hpp>
+#include <boost/thread/locks.hpp>
+#include <atomic>
+#include <vector>
+
+namespace uhd{ namespace transport{
+
+    template <typename elem_type> class spsc_bounded_buffer_detail : boost::noncopyable
+    {
+    public:
+
+        spsc_bounded_buffer_detail(size_t capacity):
+            _buffer(capacity + 1), //one slot is left empty to tell full from empty
+            _num_slots(capacity + 1),
+            _write_index(0),
+            _read_index(0),
+            _consumer_waiting(false),
+            _producer_waiting(false)
+        {
+            /* NOP */
+        }
+
+        UHD_INLINE bool push_with_haste(const elem_type &elem)
+        {
+            const size_t wr = _write_index.load(std::memory_order_relaxed);
+            const size_t next = this->increment(wr);
+            if (next == _read_index.load(std::memory_order_acquire))
+            {
+                return false; //full
+            }
+            _buffer[wr] = elem;
+            _write_index.store(next, std::memory_order_release);
+            this->wake_consumer();
+            return true;
+        }
+
+        UHD_INLINE void push_with_wait(const elem_type &elem)
+        {
+            while (not this->push_with_timed_wait(elem, BLOCK_TIMEOUT))
+            {
+                /* NOP */
+            }
+        }
+
+        UHD_INLINE bool push_with_timed_wait(const elem_type &elem, double timeout)
+        {
+            if (this->push_with_haste(elem)) return true;
+
+            //bounded spin before falling back to a blocking wait
+            for (size_t i = 0; i < SPIN_COUNT; i++)
+            {
+                if (this->push_with_haste(elem)) return true;
+            }
+
+            boost::mutex::scoped_lock lock(_mutex);
+            _producer_waiting.store(true, std::memory_order_seq_cst);
+            while (this->is_full())
+            {
+                if (not _full_cond.timed_wait(lock, to_time_dur(timeout)))
+                {
+                    _producer_waiting.store(false, std::memory_order_relaxed);
+                    return this->push_with_haste(elem); //last chance
+                }
+            }
+            _producer_waiting.store(false, std::memory_order_relaxed);
+            lock.unlock();
+            return this->push_with_haste(elem); //cannot fail, we are the only producer
+        }
+
+        UHD_INLINE bool pop_with_haste(elem_type &elem)
+        {
+            const size_t rd = _read_index.load(std::memory_order_relaxed);
+            if (rd == _write_index.load(std::memory_order_acquire))
+            {
+                return false; //empty
+            }
+            elem = _buffer[rd];
+            _buffer[rd] = elem_type(); //drop the reference
+            _read_index.store(this->increment(rd), std::memory_order_release);
+            this->wake_producer();
+            return true;
+        }
+
+        UHD_INLINE void pop_with_wait(elem_type &elem)
+        {
+            while (not this->pop_with_timed_wait(elem, BLOCK_TIMEOUT))
+            {
+                /* NOP */
+            }
+        }
+
+        UHD_INLINE bool pop_with_timed_wait(elem_type &elem, double timeout)
+        {
+            if (this->pop_with_haste(elem)) return true;
+
+            //bounded spin before falling back to a blocking wait
+            for (size_t i = 0; i < SPIN_COUNT; i++)
+            {
+                if (this->pop_with_haste(elem)) return true;
+            }
+
+            boost::mutex::scoped_lock lock(_mutex);
+            _consumer_waiting.store(true, std::memory_order_seq_cst);
+            while (this->is_empty())
+            {
+                if (not _empty_cond.timed_wait(lock, to_time_dur(timeout)))
+                {
+                    _consumer_waiting.store(false, std::memory_order_relaxed);
+                    return this->pop_with_haste(elem); //last chance
+                }
+            }
+            _consumer_waiting.store(false, std::memory_order_relaxed);
+            lock.unlock();
+            return this->pop_with_haste(elem); //cannot fail, we are the only consumer
+        }
+
+    private:
+        static const size_t SPIN_COUNT = 2000;
+        static constexpr double BLOCK_TIMEOUT = 0.1; //seconds per blocking retry
+
+        UHD_INLINE size_t increment(const size_t index) const
+        {
+            return (index + 1 == _num_slots)? 0 : index + 1;
+        }
+
+        UHD_INLINE bool is_empty(void) const
+        {
+            return _read_index.load(std::memory_order_acquire) ==
+                   _write_index.load(std::memory_order_acquire);
+        }
+
+        UHD_INLINE bool is_full(void) const
+        {
+            return this->increment(_write_index.load(std::memory_order_acquire)) ==
+                   _read_index.load(std::memory_order_acquire);
+        }
+
+        //only lock when the other side advertised that it sleeps;
+        //the full fence orders the index publish before the flag read
+        //(a release store followed by a load may still reorder, which
+        //would miss a waiter that just re-checked and went to sleep),
+        //pairing with the waiter's seq_cst flag store before its check
+        UHD_INLINE void wake_consumer(void)
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (_consumer_waiting.load(std::memory_order_relaxed))
+            {
+                boost::mutex::scoped_lock lock(_mutex);
+                _empty_cond.notify_one();
+            }
+        }
+
+        UHD_INLINE void wake_producer(void)
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (_producer_waiting.load(std::memory_order_relaxed))
+            {
+                boost::mutex::scoped_lock lock(_mutex);
+                _full_cond.notify_one();
+            }
+        }
+
+        static UHD_INLINE boost::posix_time::time_duration to_time_dur(double timeout)
+        {
+            return boost::posix_time::microseconds(long(timeout*1e6));
+        }
+
+        std::vector<elem_type> _buffer;
+        const size_t _num_slots;
+
+        //producer and consumer indices on separate cache lines
+        alignas(64) std::atomic<size_t> _write_index;
+        alignas(64) std::atomic<size_t> _read_index;
+
+        //slow path: blocking support for the waiting variants
+        alignas(64) std::atomic<bool> _consumer_waiting;
+        std::atomic<bool> _producer_waiting;
+        boost::mutex _mutex;
+        boost::condition _empty_cond, _full_cond;
+    };
+}} //namespace
+
+#endif /* INCLUDED_UHD_TRANSPORT_SPSC_BOUNDED_BUFFER_IPP */
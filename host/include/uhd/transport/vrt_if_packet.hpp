@@ -22,6 +22,20 @@ namespace vrt{
     //! The maximum number of 32-bit words in a vrt if packet header
     static const size_t max_if_hdr_words32 = 7; //hdr+sid+cid+tsi+tsf
 
+    /*!
+     * Error conditions a non-throwing header unpacker can report.
+     * The fastpath propagates these as plain return values so a
+     * malformed packet costs no exception or string construction;
+     * only the API boundary converts them into uhd exceptions.
+     */
+    enum unpack_error_t
+    {
+        UNPACK_NO_ERROR = 0,
+        UNPACK_BAD_LENGTH, //length field shorter than the header
+        UNPACK_FRAGMENT,   //buffer shorter than the length field
+        UNPACK_BAD_HEADER  //malformed or unsupported header fields
+    };
+
     /*!
      * Definition for fields that can be packed into a vrt if header.
      * The size fields are used for input and output depending upon
@@ -13,6 +13,8 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/intrusive_ptr.hpp>
 #include <boost/detail/atomic_count.hpp>
+#include <atomic>
+#include <stdint.h>
 
 namespace uhd{ namespace transport{
 
@@ -70,11 +72,11 @@ namespace uhd{ namespace transport{
             return boost::intrusive_ptr<T>(p);
         }
 
-        boost::detail::atomic_count _ref_count;
+        std::atomic<long> _ref_count;
         typedef boost::intrusive_ptr<managed_buffer> sptr;
 
         int ref_count(){
-        	return (int) _ref_count;
+        	return (int) _ref_count.load(std::memory_order_relaxed);
         }
 
 #ifdef UHD_TXRX_DEBUG_PRINTS
@@ -96,12 +98,35 @@ namespace uhd{ namespace transport{
 #endif
     };
 
+    /*
+     * Intrusive reference counting with a single-owner fast path.
+     * The count is zero only while the transport owns the buffer, and one
+     * only while a single sptr does; at those points no other thread can
+     * legally touch the count (sharing requires copying an sptr, which is
+     * itself not thread-safe), so the first add-ref and the last release
+     * replace the atomic read-modify-write with a plain store. That saves
+     * two contended atomic ops per packet on the common
+     * transport -> handler -> release path.
+     */
     UHD_INLINE void intrusive_ptr_add_ref(managed_buffer *p){
-        ++(p->_ref_count);
+        if (p->_ref_count.load(std::memory_order_relaxed) == 0){
+            //first reference: the caller is the sole owner
+            p->_ref_count.store(1, std::memory_order_relaxed);
+        }
+        else p->_ref_count.fetch_add(1, std::memory_order_relaxed);
     }
 
     UHD_INLINE void intrusive_ptr_release(managed_buffer *p){
-        if (--(p->_ref_count) == 0) p->release();
+        //the acquire load synchronizes with the decrements of other
+        //former owners, so release() sees all their buffer accesses
+        if (p->_ref_count.load(std::memory_order_acquire) == 1){
+            //last reference: the caller is the sole owner
+            p->_ref_count.store(0, std::memory_order_relaxed);
+            p->release();
+        }
+        else if (p->_ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1){
+            p->release();
+        }
     }
 
     /*!
@@ -112,6 +137,26 @@ namespace uhd{ namespace transport{
     class UHD_API managed_recv_buffer : public managed_buffer{
     public:
         typedef boost::intrusive_ptr<managed_recv_buffer> sptr;
+
+        managed_recv_buffer(void): _recv_timestamp_ns(0) { /* NOP */ }
+
+        /*!
+         * Get the time this buffer's packet arrived at the host, in
+         * nanoseconds since the Unix epoch (or the NIC's hardware clock).
+         * Returns zero when the transport does not capture receive
+         * timestamps.
+         */
+        UHD_INLINE uint64_t get_recv_timestamp_ns(void) const{
+            return _recv_timestamp_ns;
+        }
+
+        //! Called by the transport to attach the receive timestamp
+        UHD_INLINE void set_recv_timestamp_ns(const uint64_t timestamp_ns){
+            _recv_timestamp_ns = timestamp_ns;
+        }
+
+    private:
+        uint64_t _recv_timestamp_ns;
     };
 
     /*!
@@ -134,7 +179,15 @@ namespace uhd{ namespace transport{
         num_recv_frames(0),
         num_send_frames(0),
         recv_buff_size(0),
-        send_buff_size(0)
+        send_buff_size(0),
+        recv_batch_size(0),
+        send_batch_size(0),
+        numa_node(-1),
+        dscp(-1),
+        busy_poll_us(0),
+        so_priority(-1),
+        spin_wait_us(0),
+        rx_timestamps(false)
         { /* NOP */ }
         size_t recv_frame_size;
         size_t send_frame_size;
@@ -142,6 +195,22 @@ namespace uhd{ namespace transport{
         size_t num_send_frames;
         size_t recv_buff_size;
         size_t send_buff_size;
+        //! Max datagrams pulled per syscall (0 or 1 disables batching)
+        size_t recv_batch_size;
+        //! Max datagrams pushed per syscall (0 or 1 disables batching)
+        size_t send_batch_size;
+        //! NUMA node for frame memory (-1 for no node binding)
+        int numa_node;
+        //! DSCP codepoint for outgoing packets, 0-63 (-1 leaves unmarked)
+        int dscp;
+        //! SO_BUSY_POLL duration in microseconds (0 disables busy polling)
+        int busy_poll_us;
+        //! SO_PRIORITY queueing class for this socket (-1 leaves the default)
+        int so_priority;
+        //! Microseconds to busy-poll for a packet before blocking, 0 to block right away
+        int spin_wait_us;
+        //! Capture per-packet receive timestamps from the kernel/NIC
+        bool rx_timestamps;
     };
 
     /*!
@@ -200,6 +269,25 @@ namespace uhd{ namespace transport{
          */
         virtual size_t get_send_frame_size(void) const = 0;
 
+        /*!
+         * Flush any send buffers held back for batching:
+         * Transports that collect committed send buffers to push
+         * them with fewer system calls force them onto the wire
+         * here. Transports that commit straight to the wire keep
+         * this default and do nothing.
+         */
+        virtual void flush_send_buffs(void){/* NOP */}
+
+        /*!
+         * Get a file descriptor that polls readable when a receive
+         * buffer may be available. The descriptor stays owned by the
+         * transport; the caller must not read from or close it.
+         * \return the descriptor, or -1 when the transport has none
+         */
+        virtual int get_recv_fd(void) const{
+            return -1;
+        }
+
     };
 
 }} //namespace
@@ -11,6 +11,7 @@
 #include <uhd/config.hpp>
 #include <uhd/transport/zero_copy.hpp>
 #include <boost/shared_ptr.hpp>
+#include <vector>
 
 namespace uhd{ namespace transport{
 
@@ -28,11 +29,18 @@ public:
      * used in cases where the main thread needs to be relieved of the burden
      * of the underlying transport receive calls.
      *
+     * Each offload instance owns one receive thread, so wrapping each
+     * underlying transport of a multi-channel stream yields one thread
+     * per channel. The optional CPU affinity list pins that thread so
+     * channel processing stays on a chosen core.
+     *
      * \param transport a shared pointer to the transport interface
      * \param timeout a general timeout for pushing and pulling on the bounded buffer
+     * \param cpu_affinity CPUs to pin the receive thread to (empty for no pinning)
      */
     static sptr make(zero_copy_if::sptr transport,
-                     const double timeout);
+                     const double timeout,
+                     const std::vector<size_t> &cpu_affinity = std::vector<size_t>());
 };
 
 }} //namespace
@@ -82,6 +82,14 @@ namespace uhd{
          */
         void set(const Key &key, const Val &val);
 
+        /*!
+         * Set a value in the dict at the key (move overload).
+         * The value is moved into the dict instead of copied.
+         * \param key the key to set at
+         * \param val the value to move from
+         */
+        void set(const Key &key, Val &&val);
+
         /*!
          * Get a value for the given key if it exists.
          * If the key is not found throw an error.
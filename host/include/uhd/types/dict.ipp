@@ -13,6 +13,7 @@
 #include <boost/format.hpp>
 #include <boost/lexical_cast.hpp>
 #include <typeinfo>
+#include <utility>
 
 namespace uhd{
 
@@ -95,6 +96,11 @@ namespace uhd{
         (*this)[key] = val;
     }
 
+    template <typename Key, typename Val>
+    void dict<Key, Val>::set(const Key &key, Val &&val){
+        (*this)[key] = std::move(val);
+    }
+
     template <typename Key, typename Val>
     const Val &dict<Key, Val>::operator[](const Key &key) const{
         BOOST_FOREACH(const pair_t &p, _map){
@@ -39,6 +39,7 @@ namespace uhd{
             end_of_burst = false;
             error_code = ERROR_CODE_NONE;
             out_of_sequence = false;
+            host_recv_timestamp_ns = 0;
         }
 
         //! Has time specification?
@@ -109,6 +110,18 @@ namespace uhd{
         //! Out of sequence.  The transport has either dropped a packet or received data out of order.
         bool out_of_sequence;
 
+        /*!
+         * Host receive timestamp:
+         * Time the first packet of this receive arrived at the host, in
+         * nanoseconds since the Unix epoch (or the NIC's hardware clock
+         * when hardware stamping is active). Only filled in when the
+         * transport captures receive timestamps (rx_timestamps transport
+         * arg); zero otherwise. Compare against time_spec, which holds the
+         * device-side timestamp, to measure per-packet network and
+         * host-side latency.
+         */
+        uint64_t host_recv_timestamp_ns;
+
         /*!
          * Convert a rx_metadata_t into a pretty print string.
          *
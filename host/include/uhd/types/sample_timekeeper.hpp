@@ -0,0 +1,101 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHD_TYPES_SAMPLE_TIMEKEEPER_HPP
+#define INCLUDED_UHD_TYPES_SAMPLE_TIMEKEEPER_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/types/time_spec.hpp>
+#include <uhd/types/metadata.hpp>
+#include <stdint.h>
+#include <cstddef>
+
+namespace uhd{
+
+    /*!
+     * A sample_timekeeper tracks the device time of individual samples
+     * within received buffers, using 128-bit fixed point tick counts
+     * (64 whole tick bits, 64 fractional tick bits) so that repeated
+     * per-buffer advances accumulate no floating point rounding error.
+     *
+     * The timekeeper is anchored whenever a buffer's metadata carries a
+     * time_spec, and free-runs across buffers without one: feed it the
+     * metadata and sample count of every recv() call, then ask for the
+     * tick count or time_spec of any sample offset in the last buffer.
+     * Conversion to time_spec_t happens lazily on demand only, so the
+     * per-buffer cost is a handful of integer operations.
+     *
+     * Double precision arithmetic is used exactly once per anchor to
+     * translate the metadata time into ticks; everything after that is
+     * integer math, which is what makes the per-sample times exact for
+     * rational tick-per-sample ratios and monotonic always.
+     */
+    class UHD_API sample_timekeeper{
+    public:
+        sample_timekeeper(void);
+
+        //! Set the tick rate in ticks per second (the device timebase)
+        void set_tick_rate(const double tick_rate);
+
+        //! Set the sample rate in samples per second
+        void set_samp_rate(const double samp_rate);
+
+        /*!
+         * Account for one received buffer.
+         * Call this once per recv() with the metadata and the number of
+         * samples actually received: a metadata time re-anchors the
+         * timekeeper, otherwise it advances by the previous buffer's
+         * sample count and keeps free-running.
+         * \param metadata the metadata of the received buffer
+         * \param nsamps the number of samples in the received buffer
+         */
+        void update(const rx_metadata_t &metadata, const size_t nsamps);
+
+        //! True once a buffer with a time_spec has been seen
+        bool is_anchored(void) const;
+
+        /*!
+         * Get the whole tick count of a sample in the last buffer,
+         * rounded to the nearest tick.
+         * \param sample_offset the sample index within the last buffer
+         * \return the tick count of that sample
+         */
+        uint64_t get_ticks(const size_t sample_offset = 0) const;
+
+        /*!
+         * Get the fractional tick part of a sample's timestamp,
+         * in units of 1/2^64 of a tick. Together with the truncated
+         * whole ticks this is the full 128-bit timestamp.
+         * \param sample_offset the sample index within the last buffer
+         * \return the fractional tick count of that sample
+         */
+        uint64_t get_tick_frac(const size_t sample_offset = 0) const;
+
+        /*!
+         * Get the time of a sample in the last buffer as a time_spec_t.
+         * This performs the tick-to-seconds conversion on demand.
+         * \param sample_offset the sample index within the last buffer
+         * \return the device time of that sample
+         */
+        time_spec_t get_time_spec(const size_t sample_offset = 0) const;
+
+    private:
+        void recalc_step(void);
+        void advance(uint64_t &whole, uint64_t &frac, const uint64_t nsamps) const;
+
+        double _tick_rate, _samp_rate;
+        //! ticks per sample in unsigned Q64.64 fixed point
+        uint64_t _step_whole, _step_frac;
+        //! tick count of sample zero of the last buffer, Q64.64
+        uint64_t _base_whole, _base_frac;
+        //! samples to advance by on the next update
+        size_t _pending_samps;
+        bool _anchored;
+    };
+
+} //namespace uhd
+
+#endif /* INCLUDED_UHD_TYPES_SAMPLE_TIMEKEEPER_HPP */
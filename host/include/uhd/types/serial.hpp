@@ -27,10 +27,11 @@ namespace uhd{
      * An eeprom implementation comes for free with the interface.
      *
      * The eeprom routines are implemented on top of i2c.
-     * The built in eeprom implementation only does single
-     * byte reads and byte writes over the i2c interface,
-     * so it should be portable across multiple eeproms.
-     * Override the eeprom routines if this is not acceptable.
+     * The built in eeprom implementation does single byte reads,
+     * and writes in small boundary-aligned pages (a safe lower
+     * bound for common parts), so it should be portable across
+     * multiple eeproms. Override the eeprom routines if this is
+     * not acceptable.
      */
     class UHD_API i2c_iface{
     public:
@@ -12,6 +12,8 @@
 #include <uhd/types/time_spec.hpp>
 #include <stdint.h>
 #include <boost/shared_ptr.hpp>
+#include <utility>
+#include <vector>
 
 namespace uhd
 {
@@ -65,6 +67,33 @@ public:
      * \return the 16bit data
      */
     virtual uint16_t peek16(const wb_addr_type addr);
+
+    /*!
+     * Write a contiguous range of registers (32 bits each).
+     *
+     * The range starts at addr with a stride of 4 bytes per register.
+     * Burst-capable interfaces override this to post the writes
+     * back-to-back, bounded only by the command FIFO depth; the
+     * default loops over poke32().
+     *
+     * \param addr the address of the first register
+     * \param data one value per register
+     */
+    virtual void poke32_range(const wb_addr_type addr, const std::vector<uint32_t> &data);
+
+    /*!
+     * Read a contiguous range of registers (32 bits each).
+     *
+     * The range starts at addr with a stride of 4 bytes per register.
+     * Burst-capable interfaces override this to pipeline the requests
+     * instead of paying one control round trip per register; the
+     * default loops over peek32().
+     *
+     * \param addr the address of the first register
+     * \param num_regs the number of registers to read
+     * \return one value per register
+     */
+    virtual std::vector<uint32_t> peek32_range(const wb_addr_type addr, const size_t num_regs);
 };
 
 class UHD_API timed_wb_iface : public wb_iface
@@ -85,6 +114,126 @@ public:
     virtual void set_time(const time_spec_t& t) = 0;
 };
 
+/*!
+ * A readback cache for status registers with bounded staleness.
+ *
+ * Wraps a wb_iface and serves peek32() of declared addresses from a
+ * cache for up to a per-register time-to-live, so hot status polls
+ * (lock status, flow control counts) from multiple callers collapse
+ * into shared reads and control round trips are only spent when the
+ * cached value may actually be stale. Writes pass through and drop the
+ * entire cache, since a write may change any status the device
+ * reports. Undeclared addresses always go to the device.
+ */
+class UHD_API cached_wb_iface : public wb_iface
+{
+public:
+    typedef boost::shared_ptr<cached_wb_iface> sptr;
+
+    /*!
+     * Make a caching wrapper around the given interface.
+     * No address is cached until declared with set_cache_ttl().
+     * \param iface the interface to wrap
+     */
+    static sptr make(wb_iface::sptr iface);
+
+    /*!
+     * Declare an address cacheable for readback.
+     * \param addr the readback address
+     * \param ttl how long a cached value may be served, in seconds
+     */
+    virtual void set_cache_ttl(const wb_addr_type addr, const double ttl) = 0;
+
+    /*!
+     * Drop the cached value for an address, forcing the next
+     * peek32() of it to go to the device.
+     * \param addr the readback address
+     */
+    virtual void invalidate(const wb_addr_type addr) = 0;
+
+    //! Drop all cached values
+    virtual void invalidate_all(void) = 0;
+};
+
+/*!
+ * A batch of register writes against a wb_iface.
+ *
+ * Pokes issued through this object are buffered and sent back-to-back
+ * when commit() is called, so a pipelined control interface can post
+ * them as consecutive packets with no interleaved reads or flushes in
+ * between. The destructor commits any pending writes.
+ */
+class UHD_API wb_write_batch
+{
+public:
+    wb_write_batch(wb_iface::sptr iface);
+
+    ~wb_write_batch(void);
+
+    /*!
+     * Queue a register write (32 bits)
+     * \param addr the address
+     * \param data the 32bit data
+     */
+    void poke32(const wb_iface::wb_addr_type addr, const uint32_t data);
+
+    //! Issue all queued writes back-to-back and clear the batch
+    void commit(void);
+
+private:
+    wb_iface::sptr _iface;
+    std::vector<std::pair<wb_iface::wb_addr_type, uint32_t> > _writes;
+};
+
+/*!
+ * A register state snapshot built on the range operations.
+ *
+ * Declare the register ranges that make up a core's state once, then
+ * capture() them from one interface and restore() them to the same or
+ * a different device. Both directions run as bursts, so cloning a
+ * core's full configuration onto a standby device costs a handful of
+ * command FIFO fills instead of one round trip per register.
+ */
+class UHD_API wb_snapshot
+{
+public:
+    wb_snapshot(void);
+
+    /*!
+     * Declare a contiguous range of 32-bit registers (4-byte stride)
+     * as part of the snapshot.
+     * \param addr the address of the first register
+     * \param num_regs the number of registers in the range
+     */
+    void declare_range(const wb_iface::wb_addr_type addr, const size_t num_regs);
+
+    /*!
+     * Read every declared range from the interface.
+     * \param iface the interface to capture from
+     */
+    void capture(wb_iface::sptr iface);
+
+    /*!
+     * Write the captured values back, range by range, in declaration
+     * order. The target may be a different device of the same type.
+     * \param iface the interface to restore to
+     * \throws uhd::runtime_error when no capture has been taken
+     */
+    void restore(wb_iface::sptr iface) const;
+
+    //! True when a capture has been taken
+    bool valid(void) const;
+
+private:
+    struct range_type
+    {
+        wb_iface::wb_addr_type addr;
+        size_t num_regs;
+    };
+    std::vector<range_type> _ranges;
+    std::vector<std::vector<uint32_t> > _values;
+};
+
 } //namespace uhd
 
 #endif /* INCLUDED_UHD_TYPES_WB_IFACE_HPP */
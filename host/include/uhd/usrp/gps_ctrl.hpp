@@ -44,6 +44,24 @@ public:
    */
   virtual bool gps_detected(void) = 0;
 
+  //! Callback type for fresh-fix notifications
+  typedef boost::function<void(void)> fix_callback_type;
+
+  /*!
+   * Register a callback to fire whenever a fresh GPS fix arrives.
+   *
+   * The callback runs on the internal GPS polling thread each time a
+   * new position/time sentence is published to the sensor cache, so
+   * time-sync code can react to fresh data instead of polling the
+   * sensors serially. Callbacks must return quickly and must not call
+   * back into this object. Subscriptions cannot be removed, so the
+   * callback must not outlive anything it references.
+   *
+   * Not all implementations support subscriptions; the default
+   * implementation throws a uhd::not_implemented_error.
+   */
+  virtual void subscribe_fix_callback(const fix_callback_type &callback);
+
   //TODO: other fun things you can do with a GPS.
 
 };
@@ -39,6 +39,8 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/utility.hpp>
 #include <complex>
+#include <future>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -332,6 +334,35 @@ public:
      */
     virtual void issue_stream_cmd(const stream_cmd_t &stream_cmd, size_t chan = ALL_CHANS) = 0;
 
+    /*!
+     * Issue a timed stream command to every channel at once.
+     *
+     * Computes a common start time shortly in the future, issues the
+     * stream command with that time to all motherboards concurrently
+     * (each has its own control channel), and then reads the device
+     * times back to verify that every command landed before the start
+     * time. This replaces issuing per-device commands serially with a
+     * blanket safety margin: the lead time only has to cover the actual
+     * command delivery, and late delivery raises an error instead of
+     * silently misaligning the streams.
+     *
+     * If \p stream_cmd carries a future time spec with stream_now set
+     * to false, that time is kept as the deadline; otherwise the start
+     * time is the time of motherboard zero plus \p lead_time.
+     *
+     * The motherboard times must be synchronized beforehand (e.g. with
+     * set_time_next_pps() or set_time_unknown_pps()).
+     *
+     * \param stream_cmd the stream command to issue to all channels
+     * \param lead_time seconds ahead of now to schedule the start
+     * \return the common start time of the streams
+     * \throws uhd::runtime_error when a command arrives past the deadline
+     */
+    virtual time_spec_t issue_stream_cmd_synced(
+        const stream_cmd_t &stream_cmd,
+        const double lead_time = 0.1
+    ) = 0;
+
     /*!
      * Set the clock configuration for the usrp device.
      * DEPRECATED in favor of set time and clock source calls.
@@ -561,6 +592,20 @@ public:
      */
     virtual std::vector<std::string> get_mboard_sensor_names(size_t mboard = 0) = 0;
 
+    /*!
+     * Get multiple motherboard sensor values in one batch.
+     *
+     * All requested sensors are read in a single pass. On devices that
+     * support it (currently MPM-based devices), the entire list is fetched
+     * with a single control transaction, which makes polling many sensors
+     * considerably cheaper than calling get_mboard_sensor() once per
+     * sensor.
+     * \param names the names of the sensors to read
+     * \param mboard the motherboard index 0 to M-1
+     * \return a map from sensor name to sensor value object
+     */
+    virtual std::map<std::string, sensor_value_t> get_mboard_sensors_batch(const std::vector<std::string> &names, size_t mboard = 0) = 0;
+
     /*!
      * Perform write on the user configuration register bus. These only exist if
      * the user has implemented custom setting registers in the device FPGA.
@@ -661,6 +706,23 @@ public:
         const tune_request_t &tune_request, size_t chan = 0
     ) = 0;
 
+    /*!
+     * Set the RX center frequency asynchronously.
+     *
+     * The tune request is queued to a dedicated control thread and this
+     * call returns immediately, so the caller can keep servicing its
+     * streamers while the reconfiguration runs. The streaming fastpath
+     * shares no locks with the control thread. Asynchronous calls run in
+     * the order they were posted and serialize with each other, but not
+     * with direct API calls made concurrently from other threads.
+     * \param tune_request tune request instructions
+     * \param chan the channel index 0 to N-1
+     * \return a future providing the tune result upon completion
+     */
+    virtual std::future<tune_result_t> set_rx_freq_async(
+        const tune_request_t &tune_request, size_t chan = 0
+    ) = 0;
+
     /*!
      * Get the RX center frequency.
      * \param chan the channel index 0 to N-1
@@ -686,6 +748,47 @@ public:
      */
     virtual freq_range_t get_fe_rx_freq_range(size_t chan = 0) = 0;
 
+    /*!
+     * Precompute an RX tune profile for fast frequency hopping.
+     *
+     * Each entry in the list is tuned once, up front, so that clipping,
+     * LO offset computation, and hardware coercion are all resolved and
+     * the resulting RF and DSP targets recorded. apply_rx_tune_profile()
+     * then replays an entry with a minimal set of writes -- no tune math
+     * or range queries happen on the hop itself.
+     *
+     * The profile captures the state at computation time: recompute it
+     * after changing sample rates, LO sources, or tune args, as those
+     * may change how a frequency coerces.
+     *
+     * \param freqs the list of target frequencies in Hz
+     * \param chan the channel index 0 to N-1
+     */
+    virtual void make_rx_tune_profile(
+        const std::vector<double> &freqs, size_t chan = 0
+    ) = 0;
+
+    /*!
+     * Hop to an entry of the precomputed RX tune profile.
+     * \param index index into the list given to make_rx_tune_profile()
+     * \param chan the channel index 0 to N-1
+     * \return the tune result recorded when the profile was computed
+     */
+    virtual tune_result_t apply_rx_tune_profile(size_t index, size_t chan = 0) = 0;
+
+    /*!
+     * Hop to an entry of the precomputed RX tune profile at a given time.
+     * The writes are wrapped in set_command_time()/clear_command_time()
+     * so the hop executes as a timed command where supported.
+     * \param index index into the list given to make_rx_tune_profile()
+     * \param time when to apply the hop
+     * \param chan the channel index 0 to N-1
+     * \return the tune result recorded when the profile was computed
+     */
+    virtual tune_result_t apply_rx_tune_profile(
+        size_t index, const time_spec_t &time, size_t chan = 0
+    ) = 0;
+
     /**************************************************************************
      * LO controls
      *************************************************************************/
@@ -1022,6 +1125,24 @@ public:
         return this->set_rx_gain(gain, ALL_GAINS, chan);
     }
 
+    /*!
+     * Set the RX gain value asynchronously.
+     *
+     * The gain change is queued to a dedicated control thread and this
+     * call returns immediately; see set_rx_freq_async() for the
+     * execution semantics.
+     * \param gain the gain in dB
+     * \param name the name of the gain element
+     * \param chan the channel index 0 to N-1
+     * \return a future that becomes ready when the gain has been applied
+     */
+    virtual std::future<void> set_rx_gain_async(double gain, const std::string &name, size_t chan = 0) = 0;
+
+    //! A convenience wrapper for setting overall RX gain asynchronously
+    std::future<void> set_rx_gain_async(double gain, size_t chan = 0){
+        return this->set_rx_gain_async(gain, ALL_GAINS, chan);
+    }
+
     /*!
      * Set the normalized RX gain value.
      *
@@ -1164,6 +1285,17 @@ public:
      */
     virtual std::vector<std::string> get_rx_sensor_names(size_t chan = 0) = 0;
 
+    /*!
+     * Get multiple RX frontend sensor values in one batch.
+     *
+     * The requested sensors are read in a single pass over the property
+     * tree. See also get_mboard_sensors_batch().
+     * \param names the names of the sensors to read
+     * \param chan the channel index 0 to N-1
+     * \return a map from sensor name to sensor value object
+     */
+    virtual std::map<std::string, sensor_value_t> get_rx_sensors_batch(const std::vector<std::string> &names, size_t chan = 0) = 0;
+
     /*!
      * Enable/disable the automatic RX DC offset correction.
      * The automatic correction subtracts out the long-run average.
@@ -1275,6 +1407,20 @@ public:
         const tune_request_t &tune_request, size_t chan = 0
     ) = 0;
 
+    /*!
+     * Set the TX center frequency asynchronously.
+     *
+     * The tune request is queued to a dedicated control thread and this
+     * call returns immediately; see set_rx_freq_async() for the
+     * execution semantics.
+     * \param tune_request tune request instructions
+     * \param chan the channel index 0 to N-1
+     * \return a future providing the tune result upon completion
+     */
+    virtual std::future<tune_result_t> set_tx_freq_async(
+        const tune_request_t &tune_request, size_t chan = 0
+    ) = 0;
+
     /*!
      * Get the TX center frequency.
      * \param chan the channel index 0 to N-1
@@ -1300,6 +1446,36 @@ public:
      */
     virtual freq_range_t get_fe_tx_freq_range(size_t chan = 0) = 0;
 
+    /*!
+     * Precompute a TX tune profile for fast frequency hopping.
+     * See make_rx_tune_profile() for details.
+     * \param freqs the list of target frequencies in Hz
+     * \param chan the channel index 0 to N-1
+     */
+    virtual void make_tx_tune_profile(
+        const std::vector<double> &freqs, size_t chan = 0
+    ) = 0;
+
+    /*!
+     * Hop to an entry of the precomputed TX tune profile.
+     * \param index index into the list given to make_tx_tune_profile()
+     * \param chan the channel index 0 to N-1
+     * \return the tune result recorded when the profile was computed
+     */
+    virtual tune_result_t apply_tx_tune_profile(size_t index, size_t chan = 0) = 0;
+
+    /*!
+     * Hop to an entry of the precomputed TX tune profile at a given time.
+     * See the RX variant for details.
+     * \param index index into the list given to make_tx_tune_profile()
+     * \param time when to apply the hop
+     * \param chan the channel index 0 to N-1
+     * \return the tune result recorded when the profile was computed
+     */
+    virtual tune_result_t apply_tx_tune_profile(
+        size_t index, const time_spec_t &time, size_t chan = 0
+    ) = 0;
+
     /*!
      * Set the TX gain value for the specified gain element.
      * For an empty name, distribute across all gain elements.
@@ -1342,6 +1518,24 @@ public:
         return this->set_tx_gain(gain, ALL_GAINS, chan);
     }
 
+    /*!
+     * Set the TX gain value asynchronously.
+     *
+     * The gain change is queued to a dedicated control thread and this
+     * call returns immediately; see set_rx_freq_async() for the
+     * execution semantics.
+     * \param gain the gain in dB
+     * \param name the name of the gain element
+     * \param chan the channel index 0 to N-1
+     * \return a future that becomes ready when the gain has been applied
+     */
+    virtual std::future<void> set_tx_gain_async(double gain, const std::string &name, size_t chan = 0) = 0;
+
+    //! A convenience wrapper for setting overall TX gain asynchronously
+    std::future<void> set_tx_gain_async(double gain, size_t chan = 0){
+        return this->set_tx_gain_async(gain, ALL_GAINS, chan);
+    }
+
     /*!
      * Set the normalized TX gain value.
      *
@@ -1468,6 +1662,17 @@ public:
      */
     virtual std::vector<std::string> get_tx_sensor_names(size_t chan = 0) = 0;
 
+    /*!
+     * Get multiple TX frontend sensor values in one batch.
+     *
+     * The requested sensors are read in a single pass over the property
+     * tree. See also get_mboard_sensors_batch().
+     * \param names the names of the sensors to read
+     * \param chan the channel index 0 to N-1
+     * \return a map from sensor name to sensor value object
+     */
+    virtual std::map<std::string, sensor_value_t> get_tx_sensors_batch(const std::vector<std::string> &names, size_t chan = 0) = 0;
+
     /*!
      * Set a constant TX DC offset value.
      * The value is complex to control both I and Q.
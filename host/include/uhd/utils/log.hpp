@@ -151,6 +151,13 @@ namespace uhd {
          */
         UHD_API void set_log_level(uhd::log::severity_level level);
 
+        /*! Get the global log level
+         *
+         * Used by the logging macros to skip all argument evaluation for
+         * messages below the global level.
+         */
+        UHD_API severity_level get_log_level();
+
         /*! Set the log level for the console logger (if defined).
          *
          * Short-hand for `set_logger_level("console", level);`
@@ -178,47 +185,64 @@ namespace uhd {
 //! Internal logging macro to be used in other macros
 #define _UHD_LOG_INTERNAL(component, level) \
     uhd::_log::log(level, __FILE__, __LINE__, component, boost::this_thread::get_id())
+
+// Internal lazy logging macro: the log object and everything inserted into
+// it are only evaluated after the level passes the global runtime filter.
+// The ternary/operator& construction (instead of an if) keeps the macro a
+// single expression, so it is safe in unbraced if/else statements, and
+// operator& binds looser than operator<< so it swallows the whole insertion
+// chain.
+#define _UHD_LOG_IF_ENABLED(component, level) \
+    (level < uhd::log::get_log_level()) ? (void)0 : \
+        uhd::_log::log_voidify() & _UHD_LOG_INTERNAL(component, level)
+
+// Internal compile-time disabled logging macro: the insertion chain is
+// type-checked but never evaluated, and dead-code elimination removes it
+// from the build entirely.
+#define _UHD_LOG_DISABLED(component, level) \
+    true ? (void)0 : \
+        uhd::_log::log_voidify() & _UHD_LOG_INTERNAL(component, level)
 //! \endcond
 
 // macro-style logging (compile-time determined)
 #if UHD_LOG_MIN_LEVEL < 1
 #define UHD_LOG_TRACE(component, message) \
-    _UHD_LOG_INTERNAL(component, uhd::log::trace) << message;
+    _UHD_LOG_IF_ENABLED(component, uhd::log::trace) << message;
 #else
 #define UHD_LOG_TRACE(component, message)
 #endif
 
 #if UHD_LOG_MIN_LEVEL < 2
 #define UHD_LOG_DEBUG(component, message) \
-    _UHD_LOG_INTERNAL(component, uhd::log::debug) << message;
+    _UHD_LOG_IF_ENABLED(component, uhd::log::debug) << message;
 #else
 #define UHD_LOG_DEBUG(component, message)
 #endif
 
 #if UHD_LOG_MIN_LEVEL < 3
 #define UHD_LOG_INFO(component, message) \
-    _UHD_LOG_INTERNAL(component, uhd::log::info) << message;
+    _UHD_LOG_IF_ENABLED(component, uhd::log::info) << message;
 #else
 #define UHD_LOG_INFO(component, message)
 #endif
 
 #if UHD_LOG_MIN_LEVEL < 4
 #define UHD_LOG_WARNING(component, message) \
-    _UHD_LOG_INTERNAL(component, uhd::log::warning) << message;
+    _UHD_LOG_IF_ENABLED(component, uhd::log::warning) << message;
 #else
 #define UHD_LOG_WARNING(component, message)
 #endif
 
 #if UHD_LOG_MIN_LEVEL < 5
 #define UHD_LOG_ERROR(component, message) \
-    _UHD_LOG_INTERNAL(component, uhd::log::error) << message;
+    _UHD_LOG_IF_ENABLED(component, uhd::log::error) << message;
 #else
 #define UHD_LOG_ERROR(component, message)
 #endif
 
 #if UHD_LOG_MIN_LEVEL < 6
 #define UHD_LOG_FATAL(component, message) \
-    _UHD_LOG_INTERNAL(component, uhd::log::fatal) << message;
+    _UHD_LOG_IF_ENABLED(component, uhd::log::fatal) << message;
 #else
 #define UHD_LOG_FATAL(component, message)
 #endif
@@ -235,12 +259,43 @@ namespace uhd {
 #endif
 
 // iostream-style logging
-#define UHD_LOGGER_TRACE(component) _UHD_LOG_INTERNAL(component, uhd::log::trace)
-#define UHD_LOGGER_DEBUG(component) _UHD_LOG_INTERNAL(component, uhd::log::debug)
-#define UHD_LOGGER_INFO(component) _UHD_LOG_INTERNAL(component, uhd::log::info)
-#define UHD_LOGGER_WARNING(component) _UHD_LOG_INTERNAL(component, uhd::log::warning)
-#define UHD_LOGGER_ERROR(component) _UHD_LOG_INTERNAL(component, uhd::log::error)
-#define UHD_LOGGER_FATAL(component) _UHD_LOG_INTERNAL(component, uhd::log::fatal)
+// The runtime level check happens before the log object or any insertion
+// arguments are evaluated; levels below UHD_LOG_MIN_LEVEL are compiled out.
+#if UHD_LOG_MIN_LEVEL < 1
+#define UHD_LOGGER_TRACE(component) _UHD_LOG_IF_ENABLED(component, uhd::log::trace)
+#else
+#define UHD_LOGGER_TRACE(component) _UHD_LOG_DISABLED(component, uhd::log::trace)
+#endif
+
+#if UHD_LOG_MIN_LEVEL < 2
+#define UHD_LOGGER_DEBUG(component) _UHD_LOG_IF_ENABLED(component, uhd::log::debug)
+#else
+#define UHD_LOGGER_DEBUG(component) _UHD_LOG_DISABLED(component, uhd::log::debug)
+#endif
+
+#if UHD_LOG_MIN_LEVEL < 3
+#define UHD_LOGGER_INFO(component) _UHD_LOG_IF_ENABLED(component, uhd::log::info)
+#else
+#define UHD_LOGGER_INFO(component) _UHD_LOG_DISABLED(component, uhd::log::info)
+#endif
+
+#if UHD_LOG_MIN_LEVEL < 4
+#define UHD_LOGGER_WARNING(component) _UHD_LOG_IF_ENABLED(component, uhd::log::warning)
+#else
+#define UHD_LOGGER_WARNING(component) _UHD_LOG_DISABLED(component, uhd::log::warning)
+#endif
+
+#if UHD_LOG_MIN_LEVEL < 5
+#define UHD_LOGGER_ERROR(component) _UHD_LOG_IF_ENABLED(component, uhd::log::error)
+#else
+#define UHD_LOGGER_ERROR(component) _UHD_LOG_DISABLED(component, uhd::log::error)
+#endif
+
+#if UHD_LOG_MIN_LEVEL < 6
+#define UHD_LOGGER_FATAL(component) _UHD_LOG_IF_ENABLED(component, uhd::log::fatal)
+#else
+#define UHD_LOGGER_FATAL(component) _UHD_LOG_DISABLED(component, uhd::log::fatal)
+#endif
 
 
 #if defined(__GNUG__)
@@ -305,6 +360,12 @@ namespace uhd{ namespace _log {
         const bool _log_it;
     };
 
+    //! Turns the lazy log expression into void so both branches of the
+    // level-check ternary have the same type
+    struct log_voidify {
+        void operator&(const log&) const {}
+    };
+
 } //namespace uhd::_log
 //! \endcond
 } /* namespace uhd */
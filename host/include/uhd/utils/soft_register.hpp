@@ -108,6 +108,7 @@ public:
     virtual size_t get_bitwidth() = 0;
     virtual bool is_readable() = 0;
     virtual bool is_writable() = 0;
+    virtual bool is_dirty() = 0;
 
     /*!
      * Cast the soft_register generic reference to a more specific type
@@ -282,6 +283,14 @@ public:
         return writable;
     }
 
+    /*!
+     * Does the soft-copy have changes that were not flushed to hardware?
+     */
+    UHD_INLINE bool is_dirty()
+    {
+        return _soft_copy.is_dirty();
+    }
+
 private:
     wb_iface*                       _iface;
     const wb_iface::wb_addr_type    _wr_addr;
@@ -354,10 +363,69 @@ public:
         return soft_register_t<reg_data_t, readable, writable>::read(field);
     }
 
+    UHD_INLINE bool is_dirty()
+    {
+        boost::lock_guard<boost::mutex> lock(_mutex);
+        return soft_register_t<reg_data_t, readable, writable>::is_dirty();
+    }
+
 private:
     boost::mutex _mutex;
 };
 
+/*!
+ * A deferred-flush group of soft registers.
+ *
+ * Multi-field updates through write() flush the full register once per
+ * call, so a settings change that touches several fields produces
+ * redundant pokes. A flush group defers the pokes instead: callers
+ * set() fields on the member registers, then commit() emits one
+ * minimal, ordered write burst -- every register with a dirty
+ * soft-copy is flushed exactly once, in the order the registers were
+ * added to the group, and clean registers are skipped regardless of
+ * their flush mode.
+ *
+ * The group may span registers from different register maps as long
+ * as flushing them in add order is valid. It does not own its members
+ * and does not synchronize access to them; use the _sync_t register
+ * variants if members are shared between threads.
+ */
+class soft_reg_flush_group_t : public boost::noncopyable {
+public:
+    /*!
+     * Add a register to the group. Commit order is add order.
+     * NOTE: Storage of the register is up to the caller.
+     */
+    UHD_INLINE void add(soft_register_base& reg)
+    {
+        _members.push_back(&reg);
+    }
+
+    /*!
+     * Does any member register have unflushed changes?
+     */
+    UHD_INLINE bool is_dirty()
+    {
+        BOOST_FOREACH(soft_register_base* reg, _members) {
+            if (reg->is_writable() and reg->is_dirty()) return true;
+        }
+        return false;
+    }
+
+    /*!
+     * Flush every dirty member register once, in add order.
+     */
+    UHD_INLINE void commit()
+    {
+        BOOST_FOREACH(soft_register_base* reg, _members) {
+            if (reg->is_writable() and reg->is_dirty()) reg->flush();
+        }
+    }
+
+private:
+    std::list<soft_register_base*> _members;
+};
+
 /*
  * Register Shortcut Formats:
  * - soft_reg<bits>_<mode>_t: Soft register object with an unsynchronized soft-copy.
@@ -13,6 +13,8 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/function.hpp>
 #include <boost/utility.hpp>
+#include <string>
+#include <vector>
 
 namespace uhd{
 
@@ -37,6 +39,35 @@ namespace uhd{
             const task_fcn_type &task_fcn,
             const std::string &name=""
         );
+
+        /*!
+         * Create a task that runs on the shared task executor.
+         *
+         * Unlike make(), no dedicated thread is spawned: iterations of
+         * the callback are interleaved with other pooled tasks on a
+         * small group of worker threads with work-stealing queues, so
+         * dozens of mostly-idle housekeeping loops cost a handful of
+         * threads instead of one each. The callback must return
+         * promptly and must not sleep or block: a stalled iteration
+         * stalls every task sharing its worker group. Callbacks that
+         * wait internally (e.g. on sockets with long timeouts) should
+         * keep using make().
+         *
+         * Tasks with the same affinity mask share one worker group and
+         * its threads are pinned to those CPUs, so housekeeping can be
+         * kept off isolated streaming cores. An empty mask selects the
+         * default group, which inherits the process affinity.
+         *
+         * \param task_fcn the task callback function
+         * \param name Task name, for logging purposes
+         * \param cpu_affinity CPUs the task's worker group may run on
+         * \return a new task object
+         */
+        static sptr make_pooled(
+            const task_fcn_type &task_fcn,
+            const std::string &name="",
+            const std::vector<size_t> &cpu_affinity=std::vector<size_t>()
+        );
     };
 } //namespace uhd
 
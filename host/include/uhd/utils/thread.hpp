@@ -11,6 +11,7 @@
 #include <uhd/config.hpp>
 #include <boost/thread/thread.hpp>
 #include <string>
+#include <vector>
 
 namespace uhd{
 
@@ -45,6 +46,30 @@ namespace uhd{
         bool realtime = true
     );
 
+    /*!
+     * Put the current thread under deadline scheduling.
+     *
+     * Requests a CPU reservation of \p runtime seconds of execution
+     * time in every \p period seconds (Linux SCHED_DEADLINE). Unlike a
+     * static realtime priority, the thread preempts everything else
+     * only while its per-period budget lasts and is throttled once the
+     * budget is spent, so a runaway streaming thread cannot starve the
+     * rest of the system. The deadline is set equal to the period.
+     *
+     * Admission control may reject the reservation (insufficient
+     * privileges, budget already committed to other deadline tasks, or
+     * a CPU affinity narrower than the scheduling domain); a failure is
+     * logged and reported so the caller can fall back to priorities.
+     *
+     * \param runtime requested execution time per period in seconds
+     * \param period the reservation period in seconds
+     * \return true on success, false where unsupported or denied
+     */
+    UHD_API bool set_thread_deadline(
+            const double runtime,
+            const double period
+    );
+
     /*!
      * Set the thread name on the given boost thread.
      * \param thread pointer to a boost thread
@@ -55,6 +80,17 @@ namespace uhd{
             const std::string &name
     );
 
+    /*!
+     * Set the affinity of the current thread to the given CPUs.
+     * Pinning I/O threads to cores keeps the streaming hot path on
+     * one cache domain and stops the scheduler from migrating them.
+     * Logs a warning when affinity control is unsupported or fails.
+     * \param cpu_affinity a list of CPU numbers to pin to
+     */
+    UHD_API void set_thread_affinity(
+            const std::vector<size_t> &cpu_affinity
+    );
+
 } //namespace uhd
 
 #endif /* INCLUDED_UHD_UTILS_THREAD_HPP */
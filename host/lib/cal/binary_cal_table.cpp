@@ -0,0 +1,138 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/cal/binary_cal_table.hpp>
+#include <uhd/exception.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/format.hpp>
+#include <cstring>
+#include <fstream>
+
+using namespace uhd;
+using namespace uhd::cal;
+
+const char *binary_cal_table::FILE_EXT = ".cal";
+
+namespace {
+    static const char BINARY_CAL_MAGIC[8] =
+        {'U', 'H', 'D', 'B', 'C', 'A', 'L', '\0'};
+    static const uint32_t BINARY_CAL_VERSION = 1;
+
+    //! Fixed-size header preceding the row data
+    struct binary_cal_header_t {
+        char     magic[8];
+        uint32_t version;
+        uint32_t num_cols;
+        uint64_t num_rows;
+    };
+}
+
+/***********************************************************************
+ * Implementation on top of a read-only file mapping
+ **********************************************************************/
+class binary_cal_table_impl : public binary_cal_table {
+public:
+    binary_cal_table_impl(const std::string &path) try :
+        _mapping(path.c_str(), boost::interprocess::read_only),
+        _region(_mapping, boost::interprocess::read_only)
+    {
+        if (_region.get_size() < sizeof(binary_cal_header_t)) {
+            throw uhd::io_error("binary cal table too short: " + path);
+        }
+        const binary_cal_header_t *header =
+            static_cast<const binary_cal_header_t *>(_region.get_address());
+        if (std::memcmp(header->magic, BINARY_CAL_MAGIC, sizeof(BINARY_CAL_MAGIC)) != 0) {
+            throw uhd::io_error("not a binary cal table: " + path);
+        }
+        if (header->version != BINARY_CAL_VERSION) {
+            throw uhd::io_error(str(boost::format(
+                "unsupported binary cal table version %u: %s")
+                % header->version % path));
+        }
+        _num_cols = size_t(header->num_cols);
+        _num_rows = size_t(header->num_rows);
+        if (_num_cols == 0) {
+            throw uhd::io_error("binary cal table has no columns: " + path);
+        }
+        const size_t expected_size = sizeof(binary_cal_header_t)
+            + _num_rows * _num_cols * sizeof(double);
+        if (_region.get_size() < expected_size) {
+            throw uhd::io_error("binary cal table truncated: " + path);
+        }
+        _rows = reinterpret_cast<const double *>(header + 1);
+    }
+    catch (const boost::interprocess::interprocess_exception &ex) {
+        throw uhd::io_error(str(boost::format(
+            "cannot map binary cal table %s: %s") % path % ex.what()));
+    }
+
+    size_t get_num_rows(void) const
+    {
+        return _num_rows;
+    }
+
+    size_t get_num_cols(void) const
+    {
+        return _num_cols;
+    }
+
+    const double *at(const size_t row) const
+    {
+        UHD_ASSERT_THROW(row < _num_rows);
+        return _rows + row * _num_cols;
+    }
+
+    size_t lower_bound(const double key) const
+    {
+        //binary search over the column-zero keys of the mapped rows
+        size_t lo = 0, hi = _num_rows;
+        while (lo < hi) {
+            const size_t mid = lo + (hi - lo) / 2;
+            if (_rows[mid * _num_cols] < key) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+private:
+    boost::interprocess::file_mapping _mapping;
+    boost::interprocess::mapped_region _region;
+    size_t _num_cols;
+    size_t _num_rows;
+    const double *_rows;
+};
+
+binary_cal_table::sptr binary_cal_table::make(const std::string &path)
+{
+    return sptr(new binary_cal_table_impl(path));
+}
+
+void binary_cal_table::write(
+    const std::string &path,
+    const size_t num_cols,
+    const std::vector<double> &rows
+){
+    UHD_ASSERT_THROW(num_cols > 0);
+    UHD_ASSERT_THROW(rows.size() % num_cols == 0);
+
+    binary_cal_header_t header;
+    std::memcpy(header.magic, BINARY_CAL_MAGIC, sizeof(BINARY_CAL_MAGIC));
+    header.version = BINARY_CAL_VERSION;
+    header.num_cols = uint32_t(num_cols);
+    header.num_rows = uint64_t(rows.size() / num_cols);
+
+    std::ofstream file(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    if (not rows.empty()) {
+        file.write(
+            reinterpret_cast<const char *>(&rows.front()),
+            rows.size() * sizeof(double));
+    }
+    if (not file) {
+        throw uhd::io_error("cannot write binary cal table: " + path);
+    }
+}
@@ -0,0 +1,83 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <immintrin.h>
+
+using namespace uhd::convert;
+
+//combine the four int32 results of two double conversions
+static UHD_INLINE __m256i cvttpd_epi32_2x(
+    const __m256d &lo, const __m256d &hi, const __m256d &scalar
+){
+    const __m128i tmpilo = _mm256_cvttpd_epi32(_mm256_mul_pd(lo, scalar));
+    const __m128i tmpihi = _mm256_cvttpd_epi32(_mm256_mul_pd(hi, scalar));
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(tmpilo), tmpihi, 1);
+}
+
+DECLARE_CONVERTER_GUARDED(fc64, 1, sc16_item32_le, 1, PRIORITY_SIMD_AVX2, __builtin_cpu_supports("avx2")){
+    const fc64_t *input = reinterpret_cast<const fc64_t *>(inputs[0]);
+    item32_t *output = reinterpret_cast<item32_t *>(outputs[0]);
+
+    const __m256d scalar = _mm256_set1_pd(scale_factor);
+
+    size_t i = 0;
+    for (; i+7 < nsamps; i+=8){
+        //load from input
+        __m256d tmp0 = _mm256_loadu_pd(reinterpret_cast<const double *>(input+i+0));
+        __m256d tmp1 = _mm256_loadu_pd(reinterpret_cast<const double *>(input+i+2));
+        __m256d tmp2 = _mm256_loadu_pd(reinterpret_cast<const double *>(input+i+4));
+        __m256d tmp3 = _mm256_loadu_pd(reinterpret_cast<const double *>(input+i+6));
+
+        //convert and scale
+        __m256i tmpilo = cvttpd_epi32_2x(tmp0, tmp1, scalar);
+        __m256i tmpihi = cvttpd_epi32_2x(tmp2, tmp3, scalar);
+
+        //pack + undo the lane interleave of the pack + swap 16-bit pairs
+        __m256i tmpi = _mm256_packs_epi32(tmpilo, tmpihi);
+        tmpi = _mm256_permute4x64_epi64(tmpi, _MM_SHUFFLE(3, 1, 2, 0));
+        tmpi = _mm256_shufflelo_epi16(tmpi, _MM_SHUFFLE(2, 3, 0, 1));
+        tmpi = _mm256_shufflehi_epi16(tmpi, _MM_SHUFFLE(2, 3, 0, 1));
+
+        //store to output
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(output+i), tmpi);
+    }
+
+    //convert any remaining samples
+    xx_to_item32_sc16<uhd::htowx>(input+i, output+i, nsamps-i, scale_factor);
+}
+
+DECLARE_CONVERTER_GUARDED(fc64, 1, sc16_item32_be, 1, PRIORITY_SIMD_AVX2, __builtin_cpu_supports("avx2")){
+    const fc64_t *input = reinterpret_cast<const fc64_t *>(inputs[0]);
+    item32_t *output = reinterpret_cast<item32_t *>(outputs[0]);
+
+    const __m256d scalar = _mm256_set1_pd(scale_factor);
+
+    size_t i = 0;
+    for (; i+7 < nsamps; i+=8){
+        //load from input
+        __m256d tmp0 = _mm256_loadu_pd(reinterpret_cast<const double *>(input+i+0));
+        __m256d tmp1 = _mm256_loadu_pd(reinterpret_cast<const double *>(input+i+2));
+        __m256d tmp2 = _mm256_loadu_pd(reinterpret_cast<const double *>(input+i+4));
+        __m256d tmp3 = _mm256_loadu_pd(reinterpret_cast<const double *>(input+i+6));
+
+        //convert and scale
+        __m256i tmpilo = cvttpd_epi32_2x(tmp0, tmp1, scalar);
+        __m256i tmpihi = cvttpd_epi32_2x(tmp2, tmp3, scalar);
+
+        //pack + undo the lane interleave of the pack + byteswap 16-bit words
+        __m256i tmpi = _mm256_packs_epi32(tmpilo, tmpihi);
+        tmpi = _mm256_permute4x64_epi64(tmpi, _MM_SHUFFLE(3, 1, 2, 0));
+        tmpi = _mm256_or_si256(_mm256_srli_epi16(tmpi, 8), _mm256_slli_epi16(tmpi, 8));
+
+        //store to output
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(output+i), tmpi);
+    }
+
+    //convert any remaining samples
+    xx_to_item32_sc16<uhd::htonx>(input+i, output+i, nsamps-i, scale_factor);
+}
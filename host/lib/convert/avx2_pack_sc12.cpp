@@ -0,0 +1,232 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <immintrin.h>
+#include "convert_pack_sc12.hpp"
+
+/*
+ * The pack itself is the SSSE3 algorithm run once per 128-bit lane,
+ * with four complex samples in each lane producing one 12-byte sc12
+ * block. See ssse3_pack_sc12.cpp for the shuffle ordering diagrams;
+ * the constants below are the same, just replicated per lane.
+ */
+#define SC12_SHIFT_MASK      0xfff0fff0, 0xfff0fff0, 0x0fff0fff, 0x0fff0fff
+#define SC12_PACK_SHUFFLE1   13,12,9,8,5,4,1,0,15,14,11,10,7,6,3,2
+#define SC12_PACK_SHUFFLE2   9,8,0,11,10,2,13,12,4,15,14,6,0,0,0,0
+#define SC12_PACK_SHUFFLE3   8,1,8,8,3,8,8,5,8,8,7,8,8,8,8,8
+
+static inline __m256i combine_si(const __m128i &lo, const __m128i &hi)
+{
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+static inline __m256 combine_ps(const __m128 &lo, const __m128 &hi)
+{
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+}
+
+//store two 12-byte blocks from the two lanes of one register;
+//like the SSE store, each lane writes a full 16 bytes
+static inline void store_sc12_blockpair(item32_sc12_3x *output, const __m256i &m)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&output[0]), _mm256_castsi256_si128(m));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&output[1]), _mm256_extracti128_si256(m, 1));
+}
+
+template <typename type>
+inline void convert_star_8_to_sc12_item32_6
+(
+    const std::complex<type> *in,
+    item32_sc12_3x *output,
+    const double scalar,
+    typename std::enable_if<std::is_same<type, float>::value>::type* = NULL
+)
+{
+    __m256 m0, m1, m2;
+    m0 = _mm256_set1_ps(scalar);
+    m1 = combine_ps(_mm_loadu_ps((const float *) &in[0]), _mm_loadu_ps((const float *) &in[4]));
+    m2 = combine_ps(_mm_loadu_ps((const float *) &in[2]), _mm_loadu_ps((const float *) &in[6]));
+    m1 = _mm256_mul_ps(m1, m0);
+    m2 = _mm256_mul_ps(m2, m0);
+    m0 = _mm256_shuffle_ps(m1, m2, _MM_SHUFFLE(2, 0, 2, 0));
+    m1 = _mm256_shuffle_ps(m1, m2, _MM_SHUFFLE(3, 1, 3, 1));
+
+    __m256i m3, m4, m5, m6, m7;
+    m3 = _mm256_set_epi32(SC12_SHIFT_MASK, SC12_SHIFT_MASK);
+    m4 = _mm256_set_epi8(SC12_PACK_SHUFFLE2, SC12_PACK_SHUFFLE2);
+    m5 = _mm256_set_epi8(SC12_PACK_SHUFFLE3, SC12_PACK_SHUFFLE3);
+
+    m6 = _mm256_cvtps_epi32(m0);
+    m7 = _mm256_cvtps_epi32(m1);
+    m6 = _mm256_slli_epi32(m6, 4);
+    m6 = _mm256_packs_epi32(m7, m6);
+    m6 = _mm256_and_si256(m6, m3);
+    m7 = _mm256_unpacklo_epi64(m6, _mm256_setzero_si256());
+
+    m6 = _mm256_shuffle_epi8(m6, m4);
+    m7 = _mm256_shuffle_epi8(m7, m5);
+    m6 = _mm256_or_si256(m6, m7);
+
+    m6 = _mm256_shuffle_epi32(m6, _MM_SHUFFLE(0, 1, 2, 3));
+    store_sc12_blockpair(output, m6);
+}
+
+template <typename type>
+static void convert_star_8_to_sc12_item32_6
+(
+    const std::complex<type> *in,
+    item32_sc12_3x *output,
+    const double,
+    typename std::enable_if<std::is_same<type, short>::value>::type* = NULL
+)
+{
+    __m256i m0, m1, m2, m3, m4, m5;
+    m0 = _mm256_set_epi32(SC12_SHIFT_MASK, SC12_SHIFT_MASK);
+    m1 = _mm256_set_epi8(SC12_PACK_SHUFFLE1, SC12_PACK_SHUFFLE1);
+    m2 = _mm256_set_epi8(SC12_PACK_SHUFFLE2, SC12_PACK_SHUFFLE2);
+    m3 = _mm256_set_epi8(SC12_PACK_SHUFFLE3, SC12_PACK_SHUFFLE3);
+
+    m4 = combine_si(
+        _mm_loadu_si128((const __m128i*) &in[0]),
+        _mm_loadu_si128((const __m128i*) &in[4]));
+    m4 = _mm256_shuffle_epi8(m4, m1);
+    m5 = _mm256_srli_epi16(m4, 4);
+    m4 = _mm256_shuffle_epi32(m4, _MM_SHUFFLE(0, 0, 3, 2));
+    m4 = _mm256_unpacklo_epi64(m5, m4);
+
+    m4 = _mm256_and_si256(m4, m0);
+    m5 = _mm256_unpacklo_epi64(m4, _mm256_setzero_si256());
+    m4 = _mm256_shuffle_epi8(m4, m2);
+    m5 = _mm256_shuffle_epi8(m5, m3);
+    m3 = _mm256_or_si256(m4, m5);
+
+    m3 = _mm256_shuffle_epi32(m3, _MM_SHUFFLE(0, 1, 2, 3));
+    store_sc12_blockpair(output, m3);
+}
+
+template <typename type, towire32_type towire>
+struct convert_star_1_to_sc12_item32_3 : public converter
+{
+    convert_star_1_to_sc12_item32_3(void):_scalar(0.0)
+    {
+    }
+
+    void set_scalar(const double scalar)
+    {
+        _scalar = scalar;
+    }
+
+    void operator()(const input_type &inputs, const output_type &outputs, const size_t nsamps)
+    {
+        const std::complex<type> *input = reinterpret_cast<const std::complex<type> *>(inputs[0]);
+
+        const size_t head_samps = size_t(outputs[0]) & 0x3;
+        int enable;
+        size_t rewind = 0;
+        switch(head_samps)
+        {
+            case 0: break;
+            case 1: rewind = 9; break;
+            case 2: rewind = 6; break;
+            case 3: rewind = 3; break;
+        }
+        item32_sc12_3x *output = reinterpret_cast<item32_sc12_3x *>(size_t(outputs[0]) - rewind);
+
+        //helper variables
+        size_t i = 0, o = 0;
+
+        //handle the head case
+        switch (head_samps)
+        {
+        case 0:
+            break; //no head
+        case 1:
+            enable = CONVERT12_LINE2;
+            convert_star_4_to_sc12_item32_3<type, towire>(0, 0, 0, input[0], enable, output[o++], _scalar);
+            break;
+        case 2:
+            enable = CONVERT12_LINE2 | CONVERT12_LINE1;
+            convert_star_4_to_sc12_item32_3<type, towire>(0, 0, input[0], input[1], enable, output[o++], _scalar);
+            break;
+        case 3:
+            enable = CONVERT12_LINE2 | CONVERT12_LINE1 | CONVERT12_LINE0;
+            convert_star_4_to_sc12_item32_3<type, towire>(0, input[0], input[1], input[2], enable, output[o++], _scalar);
+            break;
+        }
+        i += head_samps;
+
+        // Each packed write covers 16 bytes per lane, which overwrites
+        // past the two 12-bit packed structs by 4 bytes. As with the SSE
+        // version, this is only safe while subsequent samples remain, so
+        // force a tail case on the final 8 or fewer samples.
+        while (i+8 < nsamps)
+        {
+            convert_star_8_to_sc12_item32_6<type>(&input[i], &output[o], _scalar);
+            o += 2; i += 8;
+        }
+
+        //at most one whole block can remain before the tail
+        if (i+4 < nsamps)
+        {
+            convert_star_4_to_sc12_item32_3<type, towire>(input[i+0], input[i+1], input[i+2], input[i+3], CONVERT12_LINE_ALL, output[o], _scalar);
+            o++; i += 4;
+        }
+
+        //handle the tail case
+        const size_t tail_samps = nsamps - i;
+        switch (tail_samps)
+        {
+        case 0:
+            break; //no tail
+        case 1:
+            enable = CONVERT12_LINE0;
+            convert_star_4_to_sc12_item32_3<type, towire>(input[i+0], 0, 0, 0, enable, output[o], _scalar);
+            break;
+        case 2:
+            enable = CONVERT12_LINE0 | CONVERT12_LINE1;
+            convert_star_4_to_sc12_item32_3<type, towire>(input[i+0], input[i+1], 0, 0, enable, output[o], _scalar);
+            break;
+        case 3:
+            enable = CONVERT12_LINE0 | CONVERT12_LINE1 | CONVERT12_LINE2;
+            convert_star_4_to_sc12_item32_3<type, towire>(input[i+0], input[i+1], input[i+2], 0, enable, output[o], _scalar);
+            break;
+        case 4:
+            enable = CONVERT12_LINE_ALL;
+            convert_star_4_to_sc12_item32_3<type, towire>(input[i+0], input[i+1], input[i+2], input[i+3], enable, output[o], _scalar);
+            break;
+        }
+    }
+
+    double _scalar;
+};
+
+static converter::sptr make_convert_fc32_1_to_sc12_item32_le_1(void)
+{
+    return converter::sptr(new convert_star_1_to_sc12_item32_3<float, uhd::wtohx>());
+}
+
+static converter::sptr make_convert_sc16_1_to_sc12_item32_le_1(void)
+{
+    return converter::sptr(new convert_star_1_to_sc12_item32_3<short, uhd::wtohx>());
+}
+
+UHD_STATIC_BLOCK(register_avx2_pack_sc12)
+{
+    //keep the kernels out of the registry on hosts without AVX2
+    if (not __builtin_cpu_supports("avx2")) return;
+
+    uhd::convert::id_type id;
+    id.num_inputs = 1;
+    id.num_outputs = 1;
+
+    id.input_format = "fc32";
+    id.output_format = "sc12_item32_le";
+    uhd::convert::register_converter(id, &make_convert_fc32_1_to_sc12_item32_le_1, PRIORITY_SIMD_AVX2);
+
+    id.input_format = "sc16";
+    id.output_format = "sc12_item32_le";
+    uhd::convert::register_converter(id, &make_convert_sc16_1_to_sc12_item32_le_1, PRIORITY_SIMD_AVX2);
+}
@@ -0,0 +1,82 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <immintrin.h>
+
+using namespace uhd::convert;
+
+DECLARE_CONVERTER_GUARDED(sc16_item32_le, 1, fc64, 1, PRIORITY_SIMD_AVX2, __builtin_cpu_supports("avx2")){
+    const item32_t *input = reinterpret_cast<const item32_t *>(inputs[0]);
+    fc64_t *output = reinterpret_cast<fc64_t *>(outputs[0]);
+
+    const __m256d scalar = _mm256_set1_pd(scale_factor/(1 << 16));
+    const __m256i zeroi = _mm256_setzero_si256();
+
+    size_t i = 0;
+    for (; i+7 < nsamps; i+=8){
+        //load from input
+        __m256i tmpi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(input+i));
+
+        //swap 16-bit pairs + pre-permute so the unpack stays in order
+        tmpi = _mm256_shufflelo_epi16(tmpi, _MM_SHUFFLE(2, 3, 0, 1));
+        tmpi = _mm256_shufflehi_epi16(tmpi, _MM_SHUFFLE(2, 3, 0, 1));
+        tmpi = _mm256_permute4x64_epi64(tmpi, _MM_SHUFFLE(3, 1, 2, 0));
+        __m256i tmpilo = _mm256_unpacklo_epi16(zeroi, tmpi); /* value in upper 16 bits */
+        __m256i tmpihi = _mm256_unpackhi_epi16(zeroi, tmpi);
+
+        //convert and scale
+        __m256d tmp0 = _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(tmpilo)), scalar);
+        __m256d tmp1 = _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(tmpilo, 1)), scalar);
+        __m256d tmp2 = _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(tmpihi)), scalar);
+        __m256d tmp3 = _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(tmpihi, 1)), scalar);
+
+        //store to output
+        _mm256_storeu_pd(reinterpret_cast<double *>(output+i+0), tmp0);
+        _mm256_storeu_pd(reinterpret_cast<double *>(output+i+2), tmp1);
+        _mm256_storeu_pd(reinterpret_cast<double *>(output+i+4), tmp2);
+        _mm256_storeu_pd(reinterpret_cast<double *>(output+i+6), tmp3);
+    }
+
+    //convert any remaining samples
+    item32_sc16_to_xx<uhd::wtohx>(input+i, output+i, nsamps-i, scale_factor);
+}
+
+DECLARE_CONVERTER_GUARDED(sc16_item32_be, 1, fc64, 1, PRIORITY_SIMD_AVX2, __builtin_cpu_supports("avx2")){
+    const item32_t *input = reinterpret_cast<const item32_t *>(inputs[0]);
+    fc64_t *output = reinterpret_cast<fc64_t *>(outputs[0]);
+
+    const __m256d scalar = _mm256_set1_pd(scale_factor/(1 << 16));
+    const __m256i zeroi = _mm256_setzero_si256();
+
+    size_t i = 0;
+    for (; i+7 < nsamps; i+=8){
+        //load from input
+        __m256i tmpi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(input+i));
+
+        //byteswap 16-bit words + pre-permute so the unpack stays in order
+        tmpi = _mm256_or_si256(_mm256_srli_epi16(tmpi, 8), _mm256_slli_epi16(tmpi, 8));
+        tmpi = _mm256_permute4x64_epi64(tmpi, _MM_SHUFFLE(3, 1, 2, 0));
+        __m256i tmpilo = _mm256_unpacklo_epi16(zeroi, tmpi); /* value in upper 16 bits */
+        __m256i tmpihi = _mm256_unpackhi_epi16(zeroi, tmpi);
+
+        //convert and scale
+        __m256d tmp0 = _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(tmpilo)), scalar);
+        __m256d tmp1 = _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(tmpilo, 1)), scalar);
+        __m256d tmp2 = _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(tmpihi)), scalar);
+        __m256d tmp3 = _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(tmpihi, 1)), scalar);
+
+        //store to output
+        _mm256_storeu_pd(reinterpret_cast<double *>(output+i+0), tmp0);
+        _mm256_storeu_pd(reinterpret_cast<double *>(output+i+2), tmp1);
+        _mm256_storeu_pd(reinterpret_cast<double *>(output+i+4), tmp2);
+        _mm256_storeu_pd(reinterpret_cast<double *>(output+i+6), tmp3);
+    }
+
+    //convert any remaining samples
+    item32_sc16_to_xx<uhd::ntohx>(input+i, output+i, nsamps-i, scale_factor);
+}
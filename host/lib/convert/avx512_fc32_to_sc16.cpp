@@ -0,0 +1,74 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <immintrin.h>
+
+using namespace uhd::convert;
+
+#define avx512_guard (__builtin_cpu_supports("avx512f") and __builtin_cpu_supports("avx512bw"))
+
+DECLARE_CONVERTER_GUARDED(fc32, 1, sc16_item32_le, 1, PRIORITY_SIMD_AVX512, avx512_guard){
+    const fc32_t *input = reinterpret_cast<const fc32_t *>(inputs[0]);
+    item32_t *output = reinterpret_cast<item32_t *>(outputs[0]);
+
+    const __m512 scalar = _mm512_set1_ps(float(scale_factor));
+    //packs works per 128-bit lane; this permute restores item order
+    const __m512i unlace = _mm512_set_epi64(7, 5, 3, 1, 6, 4, 2, 0);
+
+    size_t i = 0;
+    for (; i+15 < nsamps; i+=16){
+        //load from input
+        __m512 tmplo = _mm512_loadu_ps(reinterpret_cast<const float *>(input+i+0));
+        __m512 tmphi = _mm512_loadu_ps(reinterpret_cast<const float *>(input+i+8));
+
+        //convert and scale
+        __m512i tmpilo = _mm512_cvtps_epi32(_mm512_mul_ps(tmplo, scalar));
+        __m512i tmpihi = _mm512_cvtps_epi32(_mm512_mul_ps(tmphi, scalar));
+
+        //pack + undo the lane interleave of the pack + swap 16-bit pairs
+        __m512i tmpi = _mm512_packs_epi32(tmpilo, tmpihi);
+        tmpi = _mm512_permutexvar_epi64(unlace, tmpi);
+        tmpi = _mm512_rol_epi32(tmpi, 16);
+
+        //store to output
+        _mm512_storeu_si512(reinterpret_cast<void *>(output+i), tmpi);
+    }
+
+    //convert any remaining samples
+    xx_to_item32_sc16<uhd::htowx>(input+i, output+i, nsamps-i, scale_factor);
+}
+
+DECLARE_CONVERTER_GUARDED(fc32, 1, sc16_item32_be, 1, PRIORITY_SIMD_AVX512, avx512_guard){
+    const fc32_t *input = reinterpret_cast<const fc32_t *>(inputs[0]);
+    item32_t *output = reinterpret_cast<item32_t *>(outputs[0]);
+
+    const __m512 scalar = _mm512_set1_ps(float(scale_factor));
+    const __m512i unlace = _mm512_set_epi64(7, 5, 3, 1, 6, 4, 2, 0);
+
+    size_t i = 0;
+    for (; i+15 < nsamps; i+=16){
+        //load from input
+        __m512 tmplo = _mm512_loadu_ps(reinterpret_cast<const float *>(input+i+0));
+        __m512 tmphi = _mm512_loadu_ps(reinterpret_cast<const float *>(input+i+8));
+
+        //convert and scale
+        __m512i tmpilo = _mm512_cvtps_epi32(_mm512_mul_ps(tmplo, scalar));
+        __m512i tmpihi = _mm512_cvtps_epi32(_mm512_mul_ps(tmphi, scalar));
+
+        //pack + undo the lane interleave of the pack + byteswap 16-bit words
+        __m512i tmpi = _mm512_packs_epi32(tmpilo, tmpihi);
+        tmpi = _mm512_permutexvar_epi64(unlace, tmpi);
+        tmpi = _mm512_or_si512(_mm512_srli_epi16(tmpi, 8), _mm512_slli_epi16(tmpi, 8));
+
+        //store to output
+        _mm512_storeu_si512(reinterpret_cast<void *>(output+i), tmpi);
+    }
+
+    //convert any remaining samples
+    xx_to_item32_sc16<uhd::htonx>(input+i, output+i, nsamps-i, scale_factor);
+}
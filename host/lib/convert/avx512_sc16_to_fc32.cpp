@@ -0,0 +1,78 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <immintrin.h>
+
+using namespace uhd::convert;
+
+#define avx512_guard (__builtin_cpu_supports("avx512f") and __builtin_cpu_supports("avx512bw"))
+
+DECLARE_CONVERTER_GUARDED(sc16_item32_le, 1, fc32, 1, PRIORITY_SIMD_AVX512, avx512_guard){
+    const item32_t *input = reinterpret_cast<const item32_t *>(inputs[0]);
+    fc32_t *output = reinterpret_cast<fc32_t *>(outputs[0]);
+
+    const __m512 scalar = _mm512_set1_ps(float(scale_factor)/(1 << 16));
+    //unpacks work per 128-bit lane; this permute makes them come out in order
+    const __m512i lace = _mm512_set_epi64(7, 3, 6, 2, 5, 1, 4, 0);
+    const __m512i zeroi = _mm512_setzero_si512();
+
+    size_t i = 0;
+    for (; i+15 < nsamps; i+=16){
+        //load from input
+        __m512i tmpi = _mm512_loadu_si512(reinterpret_cast<const void *>(input+i));
+
+        //swap 16-bit pairs + pre-permute so the unpack stays in order
+        tmpi = _mm512_rol_epi32(tmpi, 16);
+        tmpi = _mm512_permutexvar_epi64(lace, tmpi);
+        __m512i tmpilo = _mm512_unpacklo_epi16(zeroi, tmpi); /* value in upper 16 bits */
+        __m512i tmpihi = _mm512_unpackhi_epi16(zeroi, tmpi);
+
+        //convert and scale
+        __m512 tmplo = _mm512_mul_ps(_mm512_cvtepi32_ps(tmpilo), scalar);
+        __m512 tmphi = _mm512_mul_ps(_mm512_cvtepi32_ps(tmpihi), scalar);
+
+        //store to output
+        _mm512_storeu_ps(reinterpret_cast<float *>(output+i+0), tmplo);
+        _mm512_storeu_ps(reinterpret_cast<float *>(output+i+8), tmphi);
+    }
+
+    //convert any remaining samples
+    item32_sc16_to_xx<uhd::wtohx>(input+i, output+i, nsamps-i, scale_factor);
+}
+
+DECLARE_CONVERTER_GUARDED(sc16_item32_be, 1, fc32, 1, PRIORITY_SIMD_AVX512, avx512_guard){
+    const item32_t *input = reinterpret_cast<const item32_t *>(inputs[0]);
+    fc32_t *output = reinterpret_cast<fc32_t *>(outputs[0]);
+
+    const __m512 scalar = _mm512_set1_ps(float(scale_factor)/(1 << 16));
+    const __m512i lace = _mm512_set_epi64(7, 3, 6, 2, 5, 1, 4, 0);
+    const __m512i zeroi = _mm512_setzero_si512();
+
+    size_t i = 0;
+    for (; i+15 < nsamps; i+=16){
+        //load from input
+        __m512i tmpi = _mm512_loadu_si512(reinterpret_cast<const void *>(input+i));
+
+        //byteswap 16-bit words + pre-permute so the unpack stays in order
+        tmpi = _mm512_or_si512(_mm512_srli_epi16(tmpi, 8), _mm512_slli_epi16(tmpi, 8));
+        tmpi = _mm512_permutexvar_epi64(lace, tmpi);
+        __m512i tmpilo = _mm512_unpacklo_epi16(zeroi, tmpi); /* value in upper 16 bits */
+        __m512i tmpihi = _mm512_unpackhi_epi16(zeroi, tmpi);
+
+        //convert and scale
+        __m512 tmplo = _mm512_mul_ps(_mm512_cvtepi32_ps(tmpilo), scalar);
+        __m512 tmphi = _mm512_mul_ps(_mm512_cvtepi32_ps(tmpihi), scalar);
+
+        //store to output
+        _mm512_storeu_ps(reinterpret_cast<float *>(output+i+0), tmplo);
+        _mm512_storeu_ps(reinterpret_cast<float *>(output+i+8), tmphi);
+    }
+
+    //convert any remaining samples
+    item32_sc16_to_xx<uhd::ntohx>(input+i, output+i, nsamps-i, scale_factor);
+}
@@ -13,7 +13,7 @@
 #include <stdint.h>
 #include <complex>
 
-#define _DECLARE_CONVERTER(name, in_form, num_in, out_form, num_out, prio) \
+#define _DECLARE_CONVERTER_GUARDED(name, in_form, num_in, out_form, num_out, prio, guard) \
     struct name : public uhd::convert::converter{ \
         static sptr make(void){return sptr(new name());} \
         double scale_factor; \
@@ -21,6 +21,7 @@
         void operator()(const input_type&, const output_type&, const size_t); \
     }; \
     UHD_STATIC_BLOCK(__register_##name##_##prio){ \
+        if (not (guard)) return; \
         uhd::convert::id_type id; \
         id.input_format = #in_form; \
         id.num_inputs = num_in; \
@@ -32,6 +33,9 @@
         const input_type &inputs, const output_type &outputs, const size_t nsamps \
     )
 
+#define _DECLARE_CONVERTER(name, in_form, num_in, out_form, num_out, prio) \
+    _DECLARE_CONVERTER_GUARDED(name, in_form, num_in, out_form, num_out, prio, true)
+
 /*! Convenience macro to declare a single-function converter
  *
  * Most converters consist of a single for loop, and can make use of
@@ -48,19 +52,37 @@
 #define DECLARE_CONVERTER(in_form, num_in, out_form, num_out, prio) \
     _DECLARE_CONVERTER(__convert_##in_form##_##num_in##_##out_form##_##num_out##_##prio, in_form, num_in, out_form, num_out, prio)
 
+/*! Declare a converter that only registers when a runtime guard holds
+ *
+ * Same usage as DECLARE_CONVERTER, with an additional guard expression
+ * that is evaluated once at registration time. This is how kernels for
+ * instruction sets beyond the build baseline (e.g. AVX2) stay out of
+ * the registry on hosts whose CPU cannot execute them.
+ */
+#define DECLARE_CONVERTER_GUARDED(in_form, num_in, out_form, num_out, prio, guard) \
+    _DECLARE_CONVERTER_GUARDED(__convert_##in_form##_##num_in##_##out_form##_##num_out##_##prio, in_form, num_in, out_form, num_out, prio, guard)
+
 /***********************************************************************
  * Setup priorities
  **********************************************************************/
 static const int PRIORITY_GENERAL = 0;
 static const int PRIORITY_EMPTY = -1;
 
-#ifdef __ARM_NEON__
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
 static const int PRIORITY_SIMD = 2;
 static const int PRIORITY_TABLE = 1; //tables require large cache, so they are slower on arm
 #else
 // We used to have ORC, too, so SIMD is 3
 static const int PRIORITY_SIMD = 3;
 static const int PRIORITY_TABLE = 1;
+//wider vector kernels beat the baseline SIMD kernels when the CPU
+//supports them; their registration is guarded by runtime checks
+static const int PRIORITY_SIMD_AVX2 = 4;
+static const int PRIORITY_SIMD_AVX512 = 5;
+//kernels with streaming stores; opt-in only (see uhd/convert.hpp)
+static const int PRIORITY_SIMD_NT = uhd::convert::PRIORITY_NONTEMPORAL;
+//kernels that fuse dither into the dequantization; opt-in only
+static const int PRIORITY_SIMD_DITHER = uhd::convert::PRIORITY_DITHERED;
 #endif
 
 /***********************************************************************
@@ -101,6 +123,14 @@ template <> UHD_INLINE item32_t xx_to_item32_sc16_x1(
     return (item32_t(real) << 16) | (item32_t(imag) << 0);
 }
 
+//! Samples per unrolled block in the generic sc16 kernels below. The
+//! streamers call the converter with a constant samples-per-packet
+//! derived from the frame size, so nearly every call is covered by
+//! whole blocks; the fixed trip count lets the compiler unroll (and
+//! vectorize) the block body with no per-sample loop checks. Only the
+//! final partial packet of a burst takes the scalar tail.
+static const size_t SC16_BLOCK_SIZE = 8;
+
 template <xtox_t to_wire, typename T>
 UHD_INLINE void xx_to_item32_sc16(
     const std::complex<T> *input,
@@ -108,7 +138,15 @@ UHD_INLINE void xx_to_item32_sc16(
     const size_t nsamps,
     const double scale_factor
 ){
-    for (size_t i = 0; i < nsamps; i++){
+    const size_t num_blocks = nsamps/SC16_BLOCK_SIZE;
+    size_t i = 0;
+    for (size_t b = 0; b < num_blocks; b++){
+        for (size_t k = 0; k < SC16_BLOCK_SIZE; k++, i++){
+            const item32_t item = xx_to_item32_sc16_x1(input[i], scale_factor);
+            output[i] = to_wire(item);
+        }
+    }
+    for (; i < nsamps; i++){
         const item32_t item = xx_to_item32_sc16_x1(input[i], scale_factor);
         output[i] = to_wire(item);
     }
@@ -141,7 +179,15 @@ UHD_INLINE void item32_sc16_to_xx(
     const size_t nsamps,
     const double scale_factor
 ){
-    for (size_t i = 0; i < nsamps; i++){
+    const size_t num_blocks = nsamps/SC16_BLOCK_SIZE;
+    size_t i = 0;
+    for (size_t b = 0; b < num_blocks; b++){
+        for (size_t k = 0; k < SC16_BLOCK_SIZE; k++, i++){
+            const item32_t item_i = to_host(input[i]);
+            output[i] = item32_sc16_x1_to_xx<T>(item_i, scale_factor);
+        }
+    }
+    for (; i < nsamps; i++){
         const item32_t item_i = to_host(input[i]);
         output[i] = item32_sc16_x1_to_xx<T>(item_i, scale_factor);
     }
@@ -10,9 +10,13 @@
 #include <uhd/utils/static.hpp>
 #include <uhd/types/dict.hpp>
 #include <uhd/exception.hpp>
+#include <uhdlib/utils/flat_map.hpp>
 #include <stdint.h>
 #include <boost/format.hpp>
 #include <complex>
+#include <functional>
+#include <memory>
+#include <mutex>
 
 using namespace uhd;
 
@@ -55,10 +59,65 @@ std::string convert::id_type::to_string(void) const{
 
 /***********************************************************************
  * Setup the table registry
+ *
+ * The id table is a flat_map so the by-id lookup in get_converter is a
+ * hashed probe instead of a string compare against every registered id.
+ * The priority table nested within stays a plain dict: it only ever
+ * holds a few entries and get_converter scans all of them anyway.
  **********************************************************************/
-typedef uhd::dict<convert::id_type, uhd::dict<convert::priority_type, convert::function_type> > fcn_table_type;
+struct id_hash_type{
+    std::size_t operator()(const convert::id_type &id) const{
+        const std::hash<std::string> hash_string;
+        std::size_t hash = hash_string(id.input_format);
+        hash = (hash * 131) + id.num_inputs;
+        hash = (hash * 131) + hash_string(id.output_format);
+        hash = (hash * 131) + id.num_outputs;
+        return hash;
+    }
+};
+
+typedef uhd::flat_map<convert::id_type, uhd::dict<convert::priority_type, convert::function_type>, id_hash_type> fcn_table_type;
 UHD_SINGLETON_FCN(fcn_table_type, get_table);
 
+/***********************************************************************
+ * Memoization of resolved converters
+ *
+ * get_converter runs once per streamer channel, so hosts that bring up
+ * many streamers at once resolve the same (id, prio) over and over.
+ * Resolved factories are published in a copy-on-write snapshot that
+ * readers grab with one atomic load - repeat lookups take no lock and
+ * never touch the registry. Writers (a cache miss, or a late converter
+ * registration invalidating the cache) serialize on a mutex, copy the
+ * snapshot, and swap in the updated one.
+ **********************************************************************/
+struct cached_id_type{
+    convert::id_type id;
+    convert::priority_type prio;
+};
+
+static bool operator==(const cached_id_type &lhs, const cached_id_type &rhs){
+    return (lhs.prio == rhs.prio) and (lhs.id == rhs.id);
+}
+
+struct cached_id_hash_type{
+    std::size_t operator()(const cached_id_type &key) const{
+        return (id_hash_type()(key.id) * 131) + key.prio;
+    }
+};
+
+typedef uhd::flat_map<cached_id_type, convert::function_type, cached_id_hash_type> converter_cache_type;
+
+static std::mutex &get_cache_mutex(void){
+    static std::mutex mutex;
+    return mutex;
+}
+
+static std::shared_ptr<const converter_cache_type> &get_cache_snapshot(void){
+    static std::shared_ptr<const converter_cache_type> snapshot =
+        std::make_shared<converter_cache_type>();
+    return snapshot;
+}
+
 /***********************************************************************
  * The registry functions
  **********************************************************************/
@@ -69,6 +128,11 @@ void uhd::convert::register_converter(
 ){
     get_table()[id][prio] = fcn;
 
+    //a late registration may shadow cached resolutions - drop them all
+    std::lock_guard<std::mutex> lock(get_cache_mutex());
+    std::atomic_store(&get_cache_snapshot(),
+        std::shared_ptr<const converter_cache_type>(std::make_shared<converter_cache_type>()));
+
     //----------------------------------------------------------------//
     //UHD_LOG_TRACE("CONVERT", boost::format("register_converter: %s prio: %s") % id.to_string() % prio)
     //----------------------------------------------------------------//
@@ -77,10 +141,30 @@ void uhd::convert::register_converter(
 /***********************************************************************
  * The converter functions
  **********************************************************************/
+//! Publish a resolved converter into a fresh cache snapshot
+static convert::function_type memoize_converter(
+    const cached_id_type &cache_key,
+    const convert::function_type &fcn
+){
+    std::lock_guard<std::mutex> lock(get_cache_mutex());
+    std::shared_ptr<converter_cache_type> updated =
+        std::make_shared<converter_cache_type>(*std::atomic_load(&get_cache_snapshot()));
+    (*updated)[cache_key] = fcn;
+    std::atomic_store(&get_cache_snapshot(),
+        std::shared_ptr<const converter_cache_type>(updated));
+    return fcn;
+}
+
 convert::function_type convert::get_converter(
     const id_type &id,
     const priority_type prio
 ){
+    //lock-free fast path: repeat resolutions come out of the snapshot
+    const cached_id_type cache_key = {id, prio};
+    std::shared_ptr<const converter_cache_type> cache =
+        std::atomic_load(&get_cache_snapshot());
+    if (cache->has_key(cache_key)) return cache->get(cache_key);
+
     if (not get_table().has_key(id)) throw uhd::key_error(
         "Cannot find a conversion routine for " + id.to_pp_string());
 
@@ -93,7 +177,7 @@ convert::function_type convert::get_converter(
                                         << " Using prio: " << prio;
             ;
             //----------------------------------------------------------------//
-            return get_table()[id][prio];
+            return memoize_converter(cache_key, get_table()[id][prio]);
         }
         best_prio = std::max(best_prio, prio_i);
     }
@@ -108,13 +192,77 @@ convert::function_type convert::get_converter(
     //----------------------------------------------------------------//
 
     //otherwise, return best prio
-    return get_table()[id][best_prio];
+    return memoize_converter(cache_key, get_table()[id][best_prio]);
+}
+
+std::vector<convert::id_type> convert::get_ids(void){
+    return get_table().keys();
+}
+
+std::vector<convert::priority_type> convert::get_priorities(const id_type &id){
+    if (not get_table().has_key(id)) throw uhd::key_error(
+        "Cannot find a conversion routine for " + id.to_pp_string());
+    return get_table()[id].keys();
+}
+
+convert::priority_type convert::get_converter_priority(
+    const id_type &id,
+    const priority_type prio
+){
+    if (not get_table().has_key(id)) throw uhd::key_error(
+        "Cannot find a conversion routine for " + id.to_pp_string());
+
+    //same matching rules as get_converter: exact match or best
+    priority_type best_prio = -1;
+    for(priority_type prio_i:  get_table()[id].keys()){
+        if (prio_i == prio) return prio;
+        best_prio = std::max(best_prio, prio_i);
+    }
+
+    if (prio != -1) throw uhd::key_error(
+        "Cannot find a conversion routine [with prio] for " + id.to_pp_string());
+
+    return best_prio;
+}
+
+convert::converter_info_type convert::get_converter_info(
+    const id_type &id,
+    const priority_type prio
+){
+    converter_info_type info;
+    info.id = id;
+    info.priority = get_converter_priority(id, prio);
+    info.impl_class = get_priority_class(info.priority);
+    return info;
+}
+
+std::string convert::get_priority_class(const priority_type prio){
+    //the registry keys routines by priority alone, and every priority
+    //value maps to one implementation class (see convert_common.hpp)
+    switch (prio){
+    case 0:  return "general";
+    case 1:  return "table";
+    case 2:  return "simd";  //NEON hosts register their SIMD kernels here
+    case 3:  return "simd";
+    case 4:  return "simd-wide";
+    case -2: return "simd-nontemporal";
+    case -3: return "simd-dithered";
+    default: return str(boost::format("unknown (%d)") % prio);
+    }
+}
+
+std::string convert::converter_info_type::to_pp_string(void) const{
+    return str(boost::format("%s [class: %s, prio: %d]")
+        % this->id.to_string()
+        % this->impl_class
+        % this->priority
+    );
 }
 
 /***********************************************************************
  * Mappings for item format to byte size for all items we can
  **********************************************************************/
-typedef uhd::dict<std::string, size_t> item_size_type;
+typedef uhd::flat_map<std::string, size_t> item_size_type;
 UHD_SINGLETON_FCN(item_size_type, get_item_size_table);
 
 void convert::register_bytes_per_item(
@@ -0,0 +1,280 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <type_traits>
+
+using namespace uhd::convert;
+
+/***********************************************************************
+ * Packed 4-bit wire format
+ *
+ * One item32 line carries four complex samples, one byte per sample,
+ * I in the high nibble and Q in the low nibble, first sample in the
+ * most significant byte:
+ *  _ _ _ _ _ _ _ _
+ * |_1_|_1_|_2_|_2_|
+ *  31              0
+ *
+ * This is a host-side compression format for relaying low-entropy
+ * streams over constrained links: it halves the wire rate of sc8 at
+ * the cost of dynamic range. No radio produces it; both ends of the
+ * link run these converters. Values are top-justified like sc12, so
+ * the standard sc16 scale factors apply.
+ **********************************************************************/
+
+typedef uint32_t (*towire32_type)(uint32_t);
+
+template <typename type, towire32_type towire>
+void convert_star_4_to_sc4_item32_1
+(
+    const std::complex<type> &in0,
+    const std::complex<type> &in1,
+    const std::complex<type> &in2,
+    const std::complex<type> &in3,
+    item32_t &output,
+    const double scalar,
+    typename std::enable_if<std::is_floating_point<type>::value>::type* = NULL
+)
+{
+    const int32_t iq[8] = {
+        (int32_t(in0.real()*scalar) >> 12) & 0xf,
+        (int32_t(in0.imag()*scalar) >> 12) & 0xf,
+        (int32_t(in1.real()*scalar) >> 12) & 0xf,
+        (int32_t(in1.imag()*scalar) >> 12) & 0xf,
+
+        (int32_t(in2.real()*scalar) >> 12) & 0xf,
+        (int32_t(in2.imag()*scalar) >> 12) & 0xf,
+        (int32_t(in3.real()*scalar) >> 12) & 0xf,
+        (int32_t(in3.imag()*scalar) >> 12) & 0xf,
+    };
+    output = towire(
+        iq[0] << 28 | iq[1] << 24 | iq[2] << 20 | iq[3] << 16 |
+        iq[4] << 12 | iq[5] <<  8 | iq[6] <<  4 | iq[7] <<  0
+    );
+}
+
+template <typename type, towire32_type towire>
+void convert_star_4_to_sc4_item32_1
+(
+    const std::complex<type> &in0,
+    const std::complex<type> &in1,
+    const std::complex<type> &in2,
+    const std::complex<type> &in3,
+    item32_t &output,
+    const double,
+    typename std::enable_if<std::is_integral<type>::value>::type* = NULL
+)
+{
+    const int32_t iq[8] = {
+        (int32_t(in0.real()) >> 12) & 0xf,
+        (int32_t(in0.imag()) >> 12) & 0xf,
+        (int32_t(in1.real()) >> 12) & 0xf,
+        (int32_t(in1.imag()) >> 12) & 0xf,
+
+        (int32_t(in2.real()) >> 12) & 0xf,
+        (int32_t(in2.imag()) >> 12) & 0xf,
+        (int32_t(in3.real()) >> 12) & 0xf,
+        (int32_t(in3.imag()) >> 12) & 0xf,
+    };
+    output = towire(
+        iq[0] << 28 | iq[1] << 24 | iq[2] << 20 | iq[3] << 16 |
+        iq[4] << 12 | iq[5] <<  8 | iq[6] <<  4 | iq[7] <<  0
+    );
+}
+
+template <typename type, towire32_type tohost>
+void convert_sc4_item32_1_to_star_4
+(
+    const item32_t &input,
+    std::complex<type> &out0,
+    std::complex<type> &out1,
+    std::complex<type> &out2,
+    std::complex<type> &out3,
+    const double scalar,
+    typename std::enable_if<std::is_floating_point<type>::value>::type* = NULL
+)
+{
+    const item32_t line = tohost(input);
+    // sign extend each nibble into the top of an int16, sc12 style
+    out0 = std::complex<type>(
+        type(int16_t((line >> 16) & 0xf000)*scalar),
+        type(int16_t((line >> 12) & 0xf000)*scalar)
+    );
+    out1 = std::complex<type>(
+        type(int16_t((line >>  8) & 0xf000)*scalar),
+        type(int16_t((line >>  4) & 0xf000)*scalar)
+    );
+    out2 = std::complex<type>(
+        type(int16_t((line >>  0) & 0xf000)*scalar),
+        type(int16_t((line <<  4) & 0xf000)*scalar)
+    );
+    out3 = std::complex<type>(
+        type(int16_t((line <<  8) & 0xf000)*scalar),
+        type(int16_t((line << 12) & 0xf000)*scalar)
+    );
+}
+
+template <typename type, towire32_type tohost>
+void convert_sc4_item32_1_to_star_4
+(
+    const item32_t &input,
+    std::complex<type> &out0,
+    std::complex<type> &out1,
+    std::complex<type> &out2,
+    std::complex<type> &out3,
+    const double,
+    typename std::enable_if<std::is_integral<type>::value>::type* = NULL
+)
+{
+    const item32_t line = tohost(input);
+    out0 = std::complex<type>(line >> 16 & 0xf000, line >> 12 & 0xf000);
+    out1 = std::complex<type>(line >>  8 & 0xf000, line >>  4 & 0xf000);
+    out2 = std::complex<type>(line >>  0 & 0xf000, line <<  4 & 0xf000);
+    out3 = std::complex<type>(line <<  8 & 0xf000, line << 12 & 0xf000);
+}
+
+/***********************************************************************
+ * Converter classes
+ **********************************************************************/
+template <typename type, towire32_type towire>
+struct convert_star_1_to_sc4_item32_1 : public converter
+{
+    convert_star_1_to_sc4_item32_1(void):_scalar(0.0)
+    {
+        //NOP
+    }
+
+    void set_scalar(const double scalar)
+    {
+        _scalar = scalar;
+    }
+
+    void operator()(const input_type &inputs, const output_type &outputs, const size_t nsamps)
+    {
+        const std::complex<type> *input = reinterpret_cast<const std::complex<type> *>(inputs[0]);
+        item32_t *output = reinterpret_cast<item32_t *>(outputs[0]);
+
+        const size_t num_lines = nsamps/4;
+        size_t i = 0, o = 0;
+        while (o < num_lines){
+            convert_star_4_to_sc4_item32_1<type, towire>(
+                input[i+0], input[i+1], input[i+2], input[i+3],
+                output[o], _scalar);
+            i += 4; o++;
+        }
+
+        // the wire payload is item32 granular: pack a zero-padded line
+        if (i < nsamps){
+            const std::complex<type> zero(0, 0);
+            convert_star_4_to_sc4_item32_1<type, towire>(
+                input[i+0],
+                (i+1 < nsamps)? input[i+1] : zero,
+                (i+2 < nsamps)? input[i+2] : zero,
+                zero,
+                output[o], _scalar);
+        }
+    }
+
+    double _scalar;
+};
+
+template <typename type, towire32_type tohost>
+struct convert_sc4_item32_1_to_star_1 : public converter
+{
+    convert_sc4_item32_1_to_star_1(void):_scalar(0.0)
+    {
+        //NOP
+    }
+
+    void set_scalar(const double scalar)
+    {
+        _scalar = scalar;
+    }
+
+    void operator()(const input_type &inputs, const output_type &outputs, const size_t nsamps)
+    {
+        const item32_t *input = reinterpret_cast<const item32_t *>(inputs[0]);
+        std::complex<type> *output = reinterpret_cast<std::complex<type> *>(outputs[0]);
+
+        const size_t num_lines = nsamps/4;
+        size_t i = 0, o = 0;
+        while (i < num_lines){
+            convert_sc4_item32_1_to_star_4<type, tohost>(
+                input[i], output[o+0], output[o+1], output[o+2], output[o+3],
+                _scalar);
+            i++; o += 4;
+        }
+
+        // unpack the zero-padded tail line into dummies past the end
+        if (o < nsamps){
+            std::complex<type> tail[4];
+            convert_sc4_item32_1_to_star_4<type, tohost>(
+                input[i], tail[0], tail[1], tail[2], tail[3], _scalar);
+            for (size_t t = 0; o < nsamps; t++, o++) output[o] = tail[t];
+        }
+    }
+
+    double _scalar;
+};
+
+/***********************************************************************
+ * Factories and registration
+ **********************************************************************/
+#define MAKE_SC4_CONVERTERS(fmt, type) \
+static converter::sptr make_convert_ ## fmt ## _1_to_sc4_item32_le_1(void) \
+{ \
+    return converter::sptr(new convert_star_1_to_sc4_item32_1<type, uhd::wtohx>()); \
+} \
+static converter::sptr make_convert_ ## fmt ## _1_to_sc4_item32_be_1(void) \
+{ \
+    return converter::sptr(new convert_star_1_to_sc4_item32_1<type, uhd::ntohx>()); \
+} \
+static converter::sptr make_convert_sc4_item32_le_1_to_ ## fmt ## _1(void) \
+{ \
+    return converter::sptr(new convert_sc4_item32_1_to_star_1<type, uhd::wtohx>()); \
+} \
+static converter::sptr make_convert_sc4_item32_be_1_to_ ## fmt ## _1(void) \
+{ \
+    return converter::sptr(new convert_sc4_item32_1_to_star_1<type, uhd::ntohx>()); \
+}
+
+MAKE_SC4_CONVERTERS(fc32, float)
+MAKE_SC4_CONVERTERS(sc16, short)
+
+UHD_STATIC_BLOCK(register_convert_sc4_item32)
+{
+    uhd::convert::register_bytes_per_item("sc4", 1/*bytes*/);
+
+    uhd::convert::id_type id;
+    id.num_inputs = 1;
+    id.num_outputs = 1;
+
+    id.input_format = "fc32";
+    id.output_format = "sc4_item32_le";
+    uhd::convert::register_converter(id, &make_convert_fc32_1_to_sc4_item32_le_1, PRIORITY_GENERAL);
+    id.output_format = "sc4_item32_be";
+    uhd::convert::register_converter(id, &make_convert_fc32_1_to_sc4_item32_be_1, PRIORITY_GENERAL);
+
+    id.input_format = "sc16";
+    id.output_format = "sc4_item32_le";
+    uhd::convert::register_converter(id, &make_convert_sc16_1_to_sc4_item32_le_1, PRIORITY_GENERAL);
+    id.output_format = "sc4_item32_be";
+    uhd::convert::register_converter(id, &make_convert_sc16_1_to_sc4_item32_be_1, PRIORITY_GENERAL);
+
+    id.output_format = "fc32";
+    id.input_format = "sc4_item32_le";
+    uhd::convert::register_converter(id, &make_convert_sc4_item32_le_1_to_fc32_1, PRIORITY_GENERAL);
+    id.input_format = "sc4_item32_be";
+    uhd::convert::register_converter(id, &make_convert_sc4_item32_be_1_to_fc32_1, PRIORITY_GENERAL);
+
+    id.output_format = "sc16";
+    id.input_format = "sc4_item32_le";
+    uhd::convert::register_converter(id, &make_convert_sc4_item32_le_1_to_sc16_1, PRIORITY_GENERAL);
+    id.input_format = "sc4_item32_be";
+    uhd::convert::register_converter(id, &make_convert_sc4_item32_be_1_to_sc16_1, PRIORITY_GENERAL);
+}
@@ -0,0 +1,148 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/convert/convert_threaded.hpp>
+#include <uhd/utils/tasks.hpp>
+#include <uhd/exception.hpp>
+#include <boost/format.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <vector>
+
+using namespace uhd;
+using namespace uhd::convert;
+
+//split points are multiples of this many items so that every worker
+//starts on a cache-line boundary (64 items x 1 byte minimum item size)
+static const size_t CHUNK_QUANTUM = 64;
+
+/***********************************************************************
+ * Threaded converter implementation
+ **********************************************************************/
+class threaded_converter_impl : public converter{
+public:
+    threaded_converter_impl(
+        const converter::sptr &base,
+        const id_type &id,
+        const size_t num_threads
+    ):
+        _base(base),
+        _bytes_per_in_item(get_bytes_per_item(id.input_format)),
+        _bytes_per_out_item(get_bytes_per_item(id.output_format)),
+        _num_pending(0)
+    {
+        _jobs.resize(num_threads - 1);
+        for (size_t i = 0; i < _jobs.size(); i++){
+            _tasks.push_back(task::make(
+                [this, i](){this->worker_loop(i);},
+                str(boost::format("conv_worker%d") % i)
+            ));
+        }
+    }
+
+    ~threaded_converter_impl(void){
+        //wake the workers so the task loops can observe their exit flag
+        boost::mutex::scoped_lock lock(_mutex);
+        _work_cond.notify_all();
+    }
+
+    void set_scalar(const double scalar){
+        _base->set_scalar(scalar);
+    }
+
+private:
+    //! One contiguous range of items assigned to a worker
+    struct job_type{
+        job_type(void): pending(false), nsamps(0){}
+        bool pending;
+        size_t nsamps;
+        std::vector<const void *> in_ptrs;
+        std::vector<void *> out_ptrs;
+    };
+
+    void operator()(const input_type &in, const output_type &out, const size_t nsamps){
+        //below this size the dispatch overhead is not worth it
+        const size_t chunk = ((nsamps/(_jobs.size() + 1))/CHUNK_QUANTUM)*CHUNK_QUANTUM;
+        if (chunk == 0) return _base->conv(in, out, nsamps);
+
+        //hand the leading chunks to the workers
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            for (size_t i = 0; i < _jobs.size(); i++){
+                job_type &job = _jobs[i];
+                job.nsamps = chunk;
+                fill_ptrs(job.in_ptrs, in, i*chunk*_bytes_per_in_item);
+                fill_ptrs(job.out_ptrs, out, i*chunk*_bytes_per_out_item);
+                job.pending = true;
+            }
+            _num_pending = _jobs.size();
+            _work_cond.notify_all();
+        }
+
+        //convert the tail chunk on the caller
+        const size_t offset = _jobs.size()*chunk;
+        std::vector<const void *> in_ptrs;
+        std::vector<void *> out_ptrs;
+        fill_ptrs(in_ptrs, in, offset*_bytes_per_in_item);
+        fill_ptrs(out_ptrs, out, offset*_bytes_per_out_item);
+        _base->conv(input_type(in_ptrs), output_type(out_ptrs), nsamps - offset);
+
+        //wait for the workers to finish their chunks
+        boost::mutex::scoped_lock lock(_mutex);
+        while (_num_pending != 0) _done_cond.wait(lock);
+    }
+
+    template <typename ptrs_type, typename buffs_type>
+    static void fill_ptrs(ptrs_type &ptrs, const buffs_type &buffs, const size_t byte_offset){
+        ptrs.resize(buffs.size());
+        for (size_t i = 0; i < buffs.size(); i++){
+            ptrs[i] = reinterpret_cast<char *>(size_t(buffs[i])) + byte_offset;
+        }
+    }
+
+    void worker_loop(const size_t index){
+        boost::mutex::scoped_lock lock(_mutex);
+        if (not _jobs[index].pending){
+            //bounded wait so the task loop can exit on shutdown
+            _work_cond.timed_wait(lock, boost::posix_time::milliseconds(100));
+            if (not _jobs[index].pending) return;
+        }
+        job_type &job = _jobs[index];
+        lock.unlock();
+        _base->conv(input_type(job.in_ptrs), output_type(job.out_ptrs), job.nsamps);
+        lock.lock();
+        job.pending = false;
+        if (--_num_pending == 0) _done_cond.notify_one();
+    }
+
+    const converter::sptr _base;
+    const size_t _bytes_per_in_item;
+    const size_t _bytes_per_out_item;
+
+    boost::mutex _mutex;
+    boost::condition_variable _work_cond, _done_cond;
+    std::vector<job_type> _jobs;
+    size_t _num_pending;
+    std::vector<task::sptr> _tasks;
+};
+
+/***********************************************************************
+ * Factory function
+ **********************************************************************/
+converter::sptr uhd::convert::make_threaded_converter(
+    const converter::sptr &base,
+    const id_type &id,
+    const size_t num_threads
+){
+    if (num_threads < 2) return base;
+    try{
+        return converter::sptr(new threaded_converter_impl(base, id, num_threads));
+    }
+    catch(const uhd::key_error &){
+        //formats without a fixed item size (ex: sc12) cannot be split
+        return base;
+    }
+}
@@ -9,106 +9,168 @@
 #include <uhd/utils/byteswap.hpp>
 #include <arm_neon.h>
 
-extern "C" {
-void neon_item32_sc16_swap_16n(void *, void *, int iter);
+using namespace uhd::convert;
+
+/*
+ * The kernels below are unrolled so each loop iteration issues several
+ * independent load/convert/store chains, enough to keep both NEON pipes
+ * busy on the dual-issue Cortex-A cores in our embedded devices. The
+ * same intrinsics build for ARMv7 NEON and aarch64 ASIMD; the fc64
+ * kernels need the double-precision vector ops that only exist on
+ * aarch64.
+ */
+
+static UHD_INLINE void fc32_to_item32_2n(
+    const float *in, int16_t *out, const float32x4_t &scale
+){
+    const float32x4_t f = vmulq_f32(vld1q_f32(in), scale);
+    const int16x4_t s = vmovn_s32(vcvtq_s32_f32(f));
+    vst1_s16(out, vrev32_s16(s));
 }
 
-static const int SIMD_WIDTH = 16;
+static UHD_INLINE void item32_to_fc32_2n(
+    const int16_t *in, float *out, const float32x4_t &scale
+){
+    const int16x4_t s = vrev32_s16(vld1_s16(in));
+    const float32x4_t f = vcvtq_f32_s32(vmovl_s16(s));
+    vst1q_f32(out, vmulq_f32(f, scale));
+}
 
-using namespace uhd::convert;
+/*
+ * The _be kernels fold the wire byteswap into the conversion: on our
+ * little-endian ARM hosts a big-endian item32 is the natural I/Q order
+ * with each 16-bit component byte-swapped, which is a single rev16 in
+ * place of the rev32 the _le kernels use.
+ */
+static UHD_INLINE void fc32_to_item32_be_2n(
+    const float *in, int16_t *out, const float32x4_t &scale
+){
+    const float32x4_t f = vmulq_f32(vld1q_f32(in), scale);
+    const int16x4_t s = vmovn_s32(vcvtq_s32_f32(f));
+    vst1_s16(out, vreinterpret_s16_u8(vrev16_u8(vreinterpret_u8_s16(s))));
+}
+
+static UHD_INLINE void item32_be_to_fc32_2n(
+    const int16_t *in, float *out, const float32x4_t &scale
+){
+    const int16x4_t s = vreinterpret_s16_u8(vrev16_u8(vreinterpret_u8_s16(vld1_s16(in))));
+    const float32x4_t f = vcvtq_f32_s32(vmovl_s16(s));
+    vst1q_f32(out, vmulq_f32(f, scale));
+}
 
 DECLARE_CONVERTER(fc32, 1, sc16_item32_le, 1, PRIORITY_SIMD){
     const fc32_t *input = reinterpret_cast<const fc32_t *>(inputs[0]);
     item32_t *output = reinterpret_cast<item32_t *>(outputs[0]);
 
-    size_t i;
+    const float32x4_t scale = vdupq_n_f32(float(scale_factor));
 
-    float32x4_t Q0 = vdupq_n_f32(float(scale_factor));
-    for (i=0; i < (nsamps & ~0x0f); i+=8) {
-        float32x4_t Q1 = vld1q_f32(reinterpret_cast<const float *>(&input[i]));
-        float32x4_t Q4 = vld1q_f32(reinterpret_cast<const float *>(&input[i+2]));
-        float32x4_t Q7 = vld1q_f32(reinterpret_cast<const float *>(&input[i+4]));
-        float32x4_t Q10 = vld1q_f32(reinterpret_cast<const float *>(&input[i+6]));
-
-        float32x4_t Q2 = vmulq_f32(Q1, Q0);
-        int32x4_t Q3 = vcvtq_s32_f32(Q2);
-        int16x4_t D8 = vmovn_s32(Q3);
-        int16x4_t D9 = vrev32_s16(D8);
-        vst1_s16((reinterpret_cast<int16_t *>(&output[i])), D9);
-
-        float32x4_t Q5 = vmulq_f32(Q4, Q0);
-        int32x4_t Q6 = vcvtq_s32_f32(Q5);
-        int16x4_t D10 = vmovn_s32(Q6);
-        int16x4_t D11 = vrev32_s16(D10);
-        vst1_s16((reinterpret_cast<int16_t *>(&output[i+2])), D11);
-
-        float32x4_t Q8 = vmulq_f32(Q7, Q0);
-        int32x4_t Q9 = vcvtq_s32_f32(Q8);
-        int16x4_t D12 = vmovn_s32(Q9);
-        int16x4_t D13 = vrev32_s16(D12);
-        vst1_s16((reinterpret_cast<int16_t *>(&output[i+4])), D13);
-
-        float32x4_t Q11 = vmulq_f32(Q10, Q0);
-        int32x4_t Q13 = vcvtq_s32_f32(Q11);
-        int16x4_t D14 = vmovn_s32(Q13);
-        int16x4_t D15 = vrev32_s16(D14);
-        vst1_s16((reinterpret_cast<int16_t *>(&output[i+6])), D15);
+    size_t i;
+    for (i=0; i < (nsamps & ~0xf); i+=16) {
+        fc32_to_item32_2n(reinterpret_cast<const float *>(&input[i+ 0]), reinterpret_cast<int16_t *>(&output[i+ 0]), scale);
+        fc32_to_item32_2n(reinterpret_cast<const float *>(&input[i+ 2]), reinterpret_cast<int16_t *>(&output[i+ 2]), scale);
+        fc32_to_item32_2n(reinterpret_cast<const float *>(&input[i+ 4]), reinterpret_cast<int16_t *>(&output[i+ 4]), scale);
+        fc32_to_item32_2n(reinterpret_cast<const float *>(&input[i+ 6]), reinterpret_cast<int16_t *>(&output[i+ 6]), scale);
+        fc32_to_item32_2n(reinterpret_cast<const float *>(&input[i+ 8]), reinterpret_cast<int16_t *>(&output[i+ 8]), scale);
+        fc32_to_item32_2n(reinterpret_cast<const float *>(&input[i+10]), reinterpret_cast<int16_t *>(&output[i+10]), scale);
+        fc32_to_item32_2n(reinterpret_cast<const float *>(&input[i+12]), reinterpret_cast<int16_t *>(&output[i+12]), scale);
+        fc32_to_item32_2n(reinterpret_cast<const float *>(&input[i+14]), reinterpret_cast<int16_t *>(&output[i+14]), scale);
     }
 
     xx_to_item32_sc16<uhd::htowx>(input+i, output+i, nsamps-i, scale_factor);
 }
 
+DECLARE_CONVERTER(fc32, 1, sc16_item32_be, 1, PRIORITY_SIMD){
+    const fc32_t *input = reinterpret_cast<const fc32_t *>(inputs[0]);
+    item32_t *output = reinterpret_cast<item32_t *>(outputs[0]);
+
+    const float32x4_t scale = vdupq_n_f32(float(scale_factor));
+
+    size_t i;
+    for (i=0; i < (nsamps & ~0xf); i+=16) {
+        fc32_to_item32_be_2n(reinterpret_cast<const float *>(&input[i+ 0]), reinterpret_cast<int16_t *>(&output[i+ 0]), scale);
+        fc32_to_item32_be_2n(reinterpret_cast<const float *>(&input[i+ 2]), reinterpret_cast<int16_t *>(&output[i+ 2]), scale);
+        fc32_to_item32_be_2n(reinterpret_cast<const float *>(&input[i+ 4]), reinterpret_cast<int16_t *>(&output[i+ 4]), scale);
+        fc32_to_item32_be_2n(reinterpret_cast<const float *>(&input[i+ 6]), reinterpret_cast<int16_t *>(&output[i+ 6]), scale);
+        fc32_to_item32_be_2n(reinterpret_cast<const float *>(&input[i+ 8]), reinterpret_cast<int16_t *>(&output[i+ 8]), scale);
+        fc32_to_item32_be_2n(reinterpret_cast<const float *>(&input[i+10]), reinterpret_cast<int16_t *>(&output[i+10]), scale);
+        fc32_to_item32_be_2n(reinterpret_cast<const float *>(&input[i+12]), reinterpret_cast<int16_t *>(&output[i+12]), scale);
+        fc32_to_item32_be_2n(reinterpret_cast<const float *>(&input[i+14]), reinterpret_cast<int16_t *>(&output[i+14]), scale);
+    }
+
+    xx_to_item32_sc16<uhd::htonx>(input+i, output+i, nsamps-i, scale_factor);
+}
+
 DECLARE_CONVERTER(sc16_item32_le, 1, fc32, 1, PRIORITY_SIMD){
     const item32_t *input = reinterpret_cast<const item32_t *>(inputs[0]);
     fc32_t *output = reinterpret_cast<fc32_t *>(outputs[0]);
 
+    const float32x4_t scale = vdupq_n_f32(float(scale_factor));
+
     size_t i;
+    for (i=0; i < (nsamps & ~0xf); i+=16) {
+        item32_to_fc32_2n(reinterpret_cast<const int16_t *>(&input[i+ 0]), reinterpret_cast<float *>(&output[i+ 0]), scale);
+        item32_to_fc32_2n(reinterpret_cast<const int16_t *>(&input[i+ 2]), reinterpret_cast<float *>(&output[i+ 2]), scale);
+        item32_to_fc32_2n(reinterpret_cast<const int16_t *>(&input[i+ 4]), reinterpret_cast<float *>(&output[i+ 4]), scale);
+        item32_to_fc32_2n(reinterpret_cast<const int16_t *>(&input[i+ 6]), reinterpret_cast<float *>(&output[i+ 6]), scale);
+        item32_to_fc32_2n(reinterpret_cast<const int16_t *>(&input[i+ 8]), reinterpret_cast<float *>(&output[i+ 8]), scale);
+        item32_to_fc32_2n(reinterpret_cast<const int16_t *>(&input[i+10]), reinterpret_cast<float *>(&output[i+10]), scale);
+        item32_to_fc32_2n(reinterpret_cast<const int16_t *>(&input[i+12]), reinterpret_cast<float *>(&output[i+12]), scale);
+        item32_to_fc32_2n(reinterpret_cast<const int16_t *>(&input[i+14]), reinterpret_cast<float *>(&output[i+14]), scale);
+    }
+
+    item32_sc16_to_xx<uhd::wtohx>(input+i, output+i, nsamps-i, scale_factor);
+}
 
-    float32x4_t Q1 = vdupq_n_f32(float(scale_factor));
-    for (i=0; i < (nsamps & ~0xf); i+=8) {
-        int16x4_t D0 = vld1_s16(reinterpret_cast<const int16_t *>(&input[i]));
-        int16x4_t D2 = vld1_s16(reinterpret_cast<const int16_t *>(&input[i+2]));
-        int16x4_t D4 = vld1_s16(reinterpret_cast<const int16_t *>(&input[i+4]));
-        int16x4_t D6 = vld1_s16(reinterpret_cast<const int16_t *>(&input[i+6]));
-
-        int16x4_t D1 = vrev32_s16(D0);
-        int32x4_t Q2 = vmovl_s16(D1);
-        float32x4_t Q3 = vcvtq_f32_s32(Q2);
-        float32x4_t Q4 = vmulq_f32(Q3, Q1);
-        vst1q_f32((reinterpret_cast<float *>(&output[i])), Q4);
-
-        int16x4_t D3 = vrev32_s16(D2);
-        int32x4_t Q5 = vmovl_s16(D3);
-        float32x4_t Q6 = vcvtq_f32_s32(Q5);
-        float32x4_t Q7 = vmulq_f32(Q6, Q1);
-        vst1q_f32((reinterpret_cast<float *>(&output[i+2])), Q7);
-
-        int16x4_t D5 = vrev32_s16(D4);
-        int32x4_t Q8 = vmovl_s16(D5);
-        float32x4_t Q9 = vcvtq_f32_s32(Q8);
-        float32x4_t Q10 = vmulq_f32(Q9, Q1);
-        vst1q_f32((reinterpret_cast<float *>(&output[i+4])), Q10);
-
-        int16x4_t D7 = vrev32_s16(D6);
-        int32x4_t Q11 = vmovl_s16(D7);
-        float32x4_t Q12 = vcvtq_f32_s32(Q11);
-        float32x4_t Q13 = vmulq_f32(Q12, Q1);
-        vst1q_f32((reinterpret_cast<float *>(&output[i+6])), Q13);
+DECLARE_CONVERTER(sc16_item32_be, 1, fc32, 1, PRIORITY_SIMD){
+    const item32_t *input = reinterpret_cast<const item32_t *>(inputs[0]);
+    fc32_t *output = reinterpret_cast<fc32_t *>(outputs[0]);
+
+    const float32x4_t scale = vdupq_n_f32(float(scale_factor));
+
+    size_t i;
+    for (i=0; i < (nsamps & ~0xf); i+=16) {
+        item32_be_to_fc32_2n(reinterpret_cast<const int16_t *>(&input[i+ 0]), reinterpret_cast<float *>(&output[i+ 0]), scale);
+        item32_be_to_fc32_2n(reinterpret_cast<const int16_t *>(&input[i+ 2]), reinterpret_cast<float *>(&output[i+ 2]), scale);
+        item32_be_to_fc32_2n(reinterpret_cast<const int16_t *>(&input[i+ 4]), reinterpret_cast<float *>(&output[i+ 4]), scale);
+        item32_be_to_fc32_2n(reinterpret_cast<const int16_t *>(&input[i+ 6]), reinterpret_cast<float *>(&output[i+ 6]), scale);
+        item32_be_to_fc32_2n(reinterpret_cast<const int16_t *>(&input[i+ 8]), reinterpret_cast<float *>(&output[i+ 8]), scale);
+        item32_be_to_fc32_2n(reinterpret_cast<const int16_t *>(&input[i+10]), reinterpret_cast<float *>(&output[i+10]), scale);
+        item32_be_to_fc32_2n(reinterpret_cast<const int16_t *>(&input[i+12]), reinterpret_cast<float *>(&output[i+12]), scale);
+        item32_be_to_fc32_2n(reinterpret_cast<const int16_t *>(&input[i+14]), reinterpret_cast<float *>(&output[i+14]), scale);
     }
 
-    item32_sc16_to_xx<uhd::htowx>(input+i, output+i, nsamps-i, scale_factor);
+    item32_sc16_to_xx<uhd::ntohx>(input+i, output+i, nsamps-i, scale_factor);
+}
+
+//sc16 <-> item32 is just an I/Q swap: reverse the 16-bit
+//elements within each 32-bit item
+static UHD_INLINE void item32_sc16_swap_4n(const int16_t *in, int16_t *out)
+{
+    vst1q_s16(out, vrev32q_s16(vld1q_s16(in)));
+}
+
+//sc16 <-> item32_be is a byteswap of each 16-bit component;
+//I/Q already land in the right order on a little-endian host
+static UHD_INLINE void item32_sc16_bswap_4n(const int16_t *in, int16_t *out)
+{
+    vst1q_s16(out, vreinterpretq_s16_u8(vrev16q_u8(vreinterpretq_u8_s16(vld1q_s16(in)))));
 }
 
 DECLARE_CONVERTER(sc16, 1, sc16_item32_le, 1, PRIORITY_SIMD){
     const sc16_t *input = reinterpret_cast<const sc16_t *>(inputs[0]);
     item32_t *output = reinterpret_cast<item32_t *>(outputs[0]);
 
-    size_t i = nsamps / SIMD_WIDTH;
-
-    if (i)
-        neon_item32_sc16_swap_16n((void *) input, (void *) output, i);
-
-    i *= SIMD_WIDTH;
+    size_t i;
+    for (i=0; i < (nsamps & ~0x1f); i+=32) {
+        item32_sc16_swap_4n(reinterpret_cast<const int16_t *>(&input[i+ 0]), reinterpret_cast<int16_t *>(&output[i+ 0]));
+        item32_sc16_swap_4n(reinterpret_cast<const int16_t *>(&input[i+ 4]), reinterpret_cast<int16_t *>(&output[i+ 4]));
+        item32_sc16_swap_4n(reinterpret_cast<const int16_t *>(&input[i+ 8]), reinterpret_cast<int16_t *>(&output[i+ 8]));
+        item32_sc16_swap_4n(reinterpret_cast<const int16_t *>(&input[i+12]), reinterpret_cast<int16_t *>(&output[i+12]));
+        item32_sc16_swap_4n(reinterpret_cast<const int16_t *>(&input[i+16]), reinterpret_cast<int16_t *>(&output[i+16]));
+        item32_sc16_swap_4n(reinterpret_cast<const int16_t *>(&input[i+20]), reinterpret_cast<int16_t *>(&output[i+20]));
+        item32_sc16_swap_4n(reinterpret_cast<const int16_t *>(&input[i+24]), reinterpret_cast<int16_t *>(&output[i+24]));
+        item32_sc16_swap_4n(reinterpret_cast<const int16_t *>(&input[i+28]), reinterpret_cast<int16_t *>(&output[i+28]));
+    }
 
     xx_to_item32_sc16<uhd::htowx>(input+i, output+i, nsamps-i, scale_factor);
 }
@@ -117,12 +179,166 @@ DECLARE_CONVERTER(sc16_item32_le, 1, sc16, 1, PRIORITY_SIMD){
     const item32_t *input = reinterpret_cast<const item32_t *>(inputs[0]);
     sc16_t *output = reinterpret_cast<sc16_t *>(outputs[0]);
 
-    size_t i = nsamps / SIMD_WIDTH;
+    size_t i;
+    for (i=0; i < (nsamps & ~0x1f); i+=32) {
+        item32_sc16_swap_4n(reinterpret_cast<const int16_t *>(&input[i+ 0]), reinterpret_cast<int16_t *>(&output[i+ 0]));
+        item32_sc16_swap_4n(reinterpret_cast<const int16_t *>(&input[i+ 4]), reinterpret_cast<int16_t *>(&output[i+ 4]));
+        item32_sc16_swap_4n(reinterpret_cast<const int16_t *>(&input[i+ 8]), reinterpret_cast<int16_t *>(&output[i+ 8]));
+        item32_sc16_swap_4n(reinterpret_cast<const int16_t *>(&input[i+12]), reinterpret_cast<int16_t *>(&output[i+12]));
+        item32_sc16_swap_4n(reinterpret_cast<const int16_t *>(&input[i+16]), reinterpret_cast<int16_t *>(&output[i+16]));
+        item32_sc16_swap_4n(reinterpret_cast<const int16_t *>(&input[i+20]), reinterpret_cast<int16_t *>(&output[i+20]));
+        item32_sc16_swap_4n(reinterpret_cast<const int16_t *>(&input[i+24]), reinterpret_cast<int16_t *>(&output[i+24]));
+        item32_sc16_swap_4n(reinterpret_cast<const int16_t *>(&input[i+28]), reinterpret_cast<int16_t *>(&output[i+28]));
+    }
+
+    item32_sc16_to_xx<uhd::wtohx>(input+i, output+i, nsamps-i, scale_factor);
+}
+
+DECLARE_CONVERTER(sc16, 1, sc16_item32_be, 1, PRIORITY_SIMD){
+    const sc16_t *input = reinterpret_cast<const sc16_t *>(inputs[0]);
+    item32_t *output = reinterpret_cast<item32_t *>(outputs[0]);
 
-    if (i)
-        neon_item32_sc16_swap_16n((void *) input, (void *) output, i);
+    size_t i;
+    for (i=0; i < (nsamps & ~0x1f); i+=32) {
+        item32_sc16_bswap_4n(reinterpret_cast<const int16_t *>(&input[i+ 0]), reinterpret_cast<int16_t *>(&output[i+ 0]));
+        item32_sc16_bswap_4n(reinterpret_cast<const int16_t *>(&input[i+ 4]), reinterpret_cast<int16_t *>(&output[i+ 4]));
+        item32_sc16_bswap_4n(reinterpret_cast<const int16_t *>(&input[i+ 8]), reinterpret_cast<int16_t *>(&output[i+ 8]));
+        item32_sc16_bswap_4n(reinterpret_cast<const int16_t *>(&input[i+12]), reinterpret_cast<int16_t *>(&output[i+12]));
+        item32_sc16_bswap_4n(reinterpret_cast<const int16_t *>(&input[i+16]), reinterpret_cast<int16_t *>(&output[i+16]));
+        item32_sc16_bswap_4n(reinterpret_cast<const int16_t *>(&input[i+20]), reinterpret_cast<int16_t *>(&output[i+20]));
+        item32_sc16_bswap_4n(reinterpret_cast<const int16_t *>(&input[i+24]), reinterpret_cast<int16_t *>(&output[i+24]));
+        item32_sc16_bswap_4n(reinterpret_cast<const int16_t *>(&input[i+28]), reinterpret_cast<int16_t *>(&output[i+28]));
+    }
 
-    i *= SIMD_WIDTH;
+    xx_to_item32_sc16<uhd::htonx>(input+i, output+i, nsamps-i, scale_factor);
+}
+
+DECLARE_CONVERTER(sc16_item32_be, 1, sc16, 1, PRIORITY_SIMD){
+    const item32_t *input = reinterpret_cast<const item32_t *>(inputs[0]);
+    sc16_t *output = reinterpret_cast<sc16_t *>(outputs[0]);
+
+    size_t i;
+    for (i=0; i < (nsamps & ~0x1f); i+=32) {
+        item32_sc16_bswap_4n(reinterpret_cast<const int16_t *>(&input[i+ 0]), reinterpret_cast<int16_t *>(&output[i+ 0]));
+        item32_sc16_bswap_4n(reinterpret_cast<const int16_t *>(&input[i+ 4]), reinterpret_cast<int16_t *>(&output[i+ 4]));
+        item32_sc16_bswap_4n(reinterpret_cast<const int16_t *>(&input[i+ 8]), reinterpret_cast<int16_t *>(&output[i+ 8]));
+        item32_sc16_bswap_4n(reinterpret_cast<const int16_t *>(&input[i+12]), reinterpret_cast<int16_t *>(&output[i+12]));
+        item32_sc16_bswap_4n(reinterpret_cast<const int16_t *>(&input[i+16]), reinterpret_cast<int16_t *>(&output[i+16]));
+        item32_sc16_bswap_4n(reinterpret_cast<const int16_t *>(&input[i+20]), reinterpret_cast<int16_t *>(&output[i+20]));
+        item32_sc16_bswap_4n(reinterpret_cast<const int16_t *>(&input[i+24]), reinterpret_cast<int16_t *>(&output[i+24]));
+        item32_sc16_bswap_4n(reinterpret_cast<const int16_t *>(&input[i+28]), reinterpret_cast<int16_t *>(&output[i+28]));
+    }
+
+    item32_sc16_to_xx<uhd::ntohx>(input+i, output+i, nsamps-i, scale_factor);
+}
+
+#ifdef __aarch64__
+
+static UHD_INLINE void fc64_to_item32_2n(
+    const double *in, int16_t *out, const float64x2_t &scale
+){
+    const int32x2_t lo = vmovn_s64(vcvtq_s64_f64(vmulq_f64(vld1q_f64(in+0), scale)));
+    const int32x2_t hi = vmovn_s64(vcvtq_s64_f64(vmulq_f64(vld1q_f64(in+2), scale)));
+    const int16x4_t s = vmovn_s32(vcombine_s32(lo, hi));
+    vst1_s16(out, vrev32_s16(s));
+}
+
+static UHD_INLINE void item32_to_fc64_2n(
+    const int16_t *in, double *out, const float64x2_t &scale
+){
+    const int32x4_t w = vmovl_s16(vrev32_s16(vld1_s16(in)));
+    const float64x2_t lo = vcvtq_f64_s64(vmovl_s32(vget_low_s32(w)));
+    const float64x2_t hi = vcvtq_f64_s64(vmovl_s32(vget_high_s32(w)));
+    vst1q_f64(out+0, vmulq_f64(lo, scale));
+    vst1q_f64(out+2, vmulq_f64(hi, scale));
+}
+
+static UHD_INLINE void fc64_to_item32_be_2n(
+    const double *in, int16_t *out, const float64x2_t &scale
+){
+    const int32x2_t lo = vmovn_s64(vcvtq_s64_f64(vmulq_f64(vld1q_f64(in+0), scale)));
+    const int32x2_t hi = vmovn_s64(vcvtq_s64_f64(vmulq_f64(vld1q_f64(in+2), scale)));
+    const int16x4_t s = vmovn_s32(vcombine_s32(lo, hi));
+    vst1_s16(out, vreinterpret_s16_u8(vrev16_u8(vreinterpret_u8_s16(s))));
+}
+
+static UHD_INLINE void item32_be_to_fc64_2n(
+    const int16_t *in, double *out, const float64x2_t &scale
+){
+    const int16x4_t s = vreinterpret_s16_u8(vrev16_u8(vreinterpret_u8_s16(vld1_s16(in))));
+    const int32x4_t w = vmovl_s16(s);
+    const float64x2_t lo = vcvtq_f64_s64(vmovl_s32(vget_low_s32(w)));
+    const float64x2_t hi = vcvtq_f64_s64(vmovl_s32(vget_high_s32(w)));
+    vst1q_f64(out+0, vmulq_f64(lo, scale));
+    vst1q_f64(out+2, vmulq_f64(hi, scale));
+}
+
+DECLARE_CONVERTER(fc64, 1, sc16_item32_le, 1, PRIORITY_SIMD){
+    const fc64_t *input = reinterpret_cast<const fc64_t *>(inputs[0]);
+    item32_t *output = reinterpret_cast<item32_t *>(outputs[0]);
+
+    const float64x2_t scale = vdupq_n_f64(scale_factor);
+
+    size_t i;
+    for (i=0; i < (nsamps & ~0x7); i+=8) {
+        fc64_to_item32_2n(reinterpret_cast<const double *>(&input[i+0]), reinterpret_cast<int16_t *>(&output[i+0]), scale);
+        fc64_to_item32_2n(reinterpret_cast<const double *>(&input[i+2]), reinterpret_cast<int16_t *>(&output[i+2]), scale);
+        fc64_to_item32_2n(reinterpret_cast<const double *>(&input[i+4]), reinterpret_cast<int16_t *>(&output[i+4]), scale);
+        fc64_to_item32_2n(reinterpret_cast<const double *>(&input[i+6]), reinterpret_cast<int16_t *>(&output[i+6]), scale);
+    }
+
+    xx_to_item32_sc16<uhd::htowx>(input+i, output+i, nsamps-i, scale_factor);
+}
+
+DECLARE_CONVERTER(fc64, 1, sc16_item32_be, 1, PRIORITY_SIMD){
+    const fc64_t *input = reinterpret_cast<const fc64_t *>(inputs[0]);
+    item32_t *output = reinterpret_cast<item32_t *>(outputs[0]);
+
+    const float64x2_t scale = vdupq_n_f64(scale_factor);
+
+    size_t i;
+    for (i=0; i < (nsamps & ~0x7); i+=8) {
+        fc64_to_item32_be_2n(reinterpret_cast<const double *>(&input[i+0]), reinterpret_cast<int16_t *>(&output[i+0]), scale);
+        fc64_to_item32_be_2n(reinterpret_cast<const double *>(&input[i+2]), reinterpret_cast<int16_t *>(&output[i+2]), scale);
+        fc64_to_item32_be_2n(reinterpret_cast<const double *>(&input[i+4]), reinterpret_cast<int16_t *>(&output[i+4]), scale);
+        fc64_to_item32_be_2n(reinterpret_cast<const double *>(&input[i+6]), reinterpret_cast<int16_t *>(&output[i+6]), scale);
+    }
+
+    xx_to_item32_sc16<uhd::htonx>(input+i, output+i, nsamps-i, scale_factor);
+}
+
+DECLARE_CONVERTER(sc16_item32_le, 1, fc64, 1, PRIORITY_SIMD){
+    const item32_t *input = reinterpret_cast<const item32_t *>(inputs[0]);
+    fc64_t *output = reinterpret_cast<fc64_t *>(outputs[0]);
+
+    const float64x2_t scale = vdupq_n_f64(scale_factor);
+
+    size_t i;
+    for (i=0; i < (nsamps & ~0x7); i+=8) {
+        item32_to_fc64_2n(reinterpret_cast<const int16_t *>(&input[i+0]), reinterpret_cast<double *>(&output[i+0]), scale);
+        item32_to_fc64_2n(reinterpret_cast<const int16_t *>(&input[i+2]), reinterpret_cast<double *>(&output[i+2]), scale);
+        item32_to_fc64_2n(reinterpret_cast<const int16_t *>(&input[i+4]), reinterpret_cast<double *>(&output[i+4]), scale);
+        item32_to_fc64_2n(reinterpret_cast<const int16_t *>(&input[i+6]), reinterpret_cast<double *>(&output[i+6]), scale);
+    }
 
     item32_sc16_to_xx<uhd::wtohx>(input+i, output+i, nsamps-i, scale_factor);
 }
+
+DECLARE_CONVERTER(sc16_item32_be, 1, fc64, 1, PRIORITY_SIMD){
+    const item32_t *input = reinterpret_cast<const item32_t *>(inputs[0]);
+    fc64_t *output = reinterpret_cast<fc64_t *>(outputs[0]);
+
+    const float64x2_t scale = vdupq_n_f64(scale_factor);
+
+    size_t i;
+    for (i=0; i < (nsamps & ~0x7); i+=8) {
+        item32_be_to_fc64_2n(reinterpret_cast<const int16_t *>(&input[i+0]), reinterpret_cast<double *>(&output[i+0]), scale);
+        item32_be_to_fc64_2n(reinterpret_cast<const int16_t *>(&input[i+2]), reinterpret_cast<double *>(&output[i+2]), scale);
+        item32_be_to_fc64_2n(reinterpret_cast<const int16_t *>(&input[i+4]), reinterpret_cast<double *>(&output[i+4]), scale);
+        item32_be_to_fc64_2n(reinterpret_cast<const int16_t *>(&input[i+6]), reinterpret_cast<double *>(&output[i+6]), scale);
+    }
+
+    item32_sc16_to_xx<uhd::ntohx>(input+i, output+i, nsamps-i, scale_factor);
+}
+
+#endif /* __aarch64__ */
@@ -6,8 +6,14 @@
 //
 
 #include "convert_common.hpp"
+#include <uhd/types/dict.hpp>
 #include <uhd/utils/byteswap.hpp>
+#include <boost/format.hpp>
 #include <boost/math/special_functions/round.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <string>
+#include <typeinfo>
 #include <vector>
 
 using namespace uhd::convert;
@@ -16,6 +22,64 @@ static const size_t sc16_table_len = size_t(1 << 16);
 
 typedef uint16_t (*tohost16_type)(uint16_t);
 
+/***********************************************************************
+ * Shared table storage
+ *
+ * The lookup tables only depend on the converter type and the scalar,
+ * so all converter instances with the same parameters (think many
+ * streamers on one host) share a single read-only table. Tables are
+ * never mutated in place: a new scalar builds a new table and the old
+ * one lives until the last instance referencing it goes away. The
+ * storage is cache-line aligned so equal tables index the same way
+ * into the cache sets regardless of heap layout.
+ **********************************************************************/
+static const size_t table_alignment = 64;
+
+template <typename entry_type>
+class aligned_table_t{
+public:
+    aligned_table_t(const size_t len):
+        _storage(len*sizeof(entry_type) + table_alignment),
+        _table(reinterpret_cast<entry_type *>(
+            (size_t(&_storage.front()) + table_alignment - 1) & ~(table_alignment - 1)))
+    {}
+    entry_type &operator[](const size_t i){return _table[i];}
+    const entry_type &operator[](const size_t i) const {return _table[i];}
+private:
+    std::vector<char> _storage;
+    entry_type *_table;
+};
+
+template <typename entry_type>
+struct table_cache_t{
+    typedef boost::shared_ptr<const aligned_table_t<entry_type> > sptr;
+    boost::mutex mutex;
+    uhd::dict<std::string, sptr> tables;
+};
+
+template <typename entry_type>
+static table_cache_t<entry_type> &get_table_cache(void){
+    static table_cache_t<entry_type> cache;
+    return cache;
+}
+
+//! Get (or build with the fill functor) the table for kind + scalar
+template <typename entry_type, typename fill_type>
+static typename table_cache_t<entry_type>::sptr get_shared_table(
+    const std::string &kind, const double scalar, const fill_type &fill
+){
+    table_cache_t<entry_type> &cache = get_table_cache<entry_type>();
+    const std::string key = str(boost::format("%s@%.17g") % kind % scalar);
+    boost::mutex::scoped_lock lock(cache.mutex);
+    if (not cache.tables.has_key(key)){
+        boost::shared_ptr<aligned_table_t<entry_type> > table(
+            new aligned_table_t<entry_type>(sc16_table_len));
+        fill(*table);
+        cache.tables[key] = table;
+    }
+    return cache.tables[key];
+}
+
 /***********************************************************************
  * Implementation for sc16 to sc8 lookup table
  *  - Lookup the real and imaginary parts individually
@@ -23,13 +87,16 @@ typedef uint16_t (*tohost16_type)(uint16_t);
 template <bool swap>
 class convert_sc16_1_to_sc8_item32_1 : public converter{
 public:
-    convert_sc16_1_to_sc8_item32_1(void): _table(sc16_table_len){}
+    convert_sc16_1_to_sc8_item32_1(void){}
 
     void set_scalar(const double scalar){
-        for (size_t i = 0; i < sc16_table_len; i++){
-            const int16_t val = uint16_t(i);
-            _table[i] = int8_t(boost::math::iround(val * scalar / 32767.));
-        }
+        _table = get_shared_table<uint8_t>(typeid(*this).name(), scalar,
+            [scalar](aligned_table_t<uint8_t> &table){
+                for (size_t i = 0; i < sc16_table_len; i++){
+                    const int16_t val = uint16_t(i);
+                    table[i] = int8_t(boost::math::iround(val * scalar / 32767.));
+                }
+            });
     }
 
     void operator()(const input_type &inputs, const output_type &outputs, const size_t nsamps){
@@ -47,22 +114,23 @@ public:
     }
 
     item32_t lookup(const sc16_t &in0, const sc16_t &in1){
+        const aligned_table_t<uint8_t> &table = *_table;
         if (swap){ //hope this compiles out, its a template constant
             return
-            (item32_t(_table[uint16_t(in1.real())]) << 16) |
-            (item32_t(_table[uint16_t(in1.imag())]) << 24) |
-            (item32_t(_table[uint16_t(in0.real())]) << 0) |
-            (item32_t(_table[uint16_t(in0.imag())]) << 8) ;
+            (item32_t(table[uint16_t(in1.real())]) << 16) |
+            (item32_t(table[uint16_t(in1.imag())]) << 24) |
+            (item32_t(table[uint16_t(in0.real())]) << 0) |
+            (item32_t(table[uint16_t(in0.imag())]) << 8) ;
         }
         return
-            (item32_t(_table[uint16_t(in1.real())]) << 8) |
-            (item32_t(_table[uint16_t(in1.imag())]) << 0) |
-            (item32_t(_table[uint16_t(in0.real())]) << 24) |
-            (item32_t(_table[uint16_t(in0.imag())]) << 16) ;
+            (item32_t(table[uint16_t(in1.real())]) << 8) |
+            (item32_t(table[uint16_t(in1.imag())]) << 0) |
+            (item32_t(table[uint16_t(in0.real())]) << 24) |
+            (item32_t(table[uint16_t(in0.imag())]) << 16) ;
     }
 
 private:
-    std::vector<uint8_t> _table;
+    table_cache_t<uint8_t>::sptr _table;
 };
 
 /***********************************************************************
@@ -72,30 +140,34 @@ private:
 template <typename type, tohost16_type tohost, size_t re_shift, size_t im_shift>
 class convert_sc16_item32_1_to_fcxx_1 : public converter{
 public:
-    convert_sc16_item32_1_to_fcxx_1(void): _table(sc16_table_len){}
+    convert_sc16_item32_1_to_fcxx_1(void){}
 
     void set_scalar(const double scalar){
-        for (size_t i = 0; i < sc16_table_len; i++){
-            const uint16_t val = tohost(uint16_t(i & 0xffff));
-            _table[i] = type(int16_t(val)*scalar);
-        }
+        _table = get_shared_table<type>(typeid(*this).name(), scalar,
+            [scalar](aligned_table_t<type> &table){
+                for (size_t i = 0; i < sc16_table_len; i++){
+                    const uint16_t val = tohost(uint16_t(i & 0xffff));
+                    table[i] = type(int16_t(val)*scalar);
+                }
+            });
     }
 
     void operator()(const input_type &inputs, const output_type &outputs, const size_t nsamps){
         const item32_t *input = reinterpret_cast<const item32_t *>(inputs[0]);
         std::complex<type> *output = reinterpret_cast<std::complex<type> *>(outputs[0]);
+        const aligned_table_t<type> &table = *_table;
 
         for (size_t i = 0; i < nsamps; i++){
             const item32_t item = input[i];
             output[i] = std::complex<type>(
-                _table[uint16_t(item >> re_shift)],
-                _table[uint16_t(item >> im_shift)]
+                table[uint16_t(item >> re_shift)],
+                table[uint16_t(item >> im_shift)]
             );
         }
     }
 
 private:
-    std::vector<type> _table;
+    typename table_cache_t<type>::sptr _table;
 };
 
 /***********************************************************************
@@ -105,7 +177,7 @@ private:
 template <typename type, tohost16_type tohost, size_t lo_shift, size_t hi_shift>
 class convert_sc8_item32_1_to_fcxx_1 : public converter{
 public:
-    convert_sc8_item32_1_to_fcxx_1(void): _table(sc16_table_len){}
+    convert_sc8_item32_1_to_fcxx_1(void){}
 
     //special case for sc16 type, 32767 undoes float normalization
     static type conv(const int8_t &num, const double scalar){
@@ -116,41 +188,45 @@ public:
     }
 
     void set_scalar(const double scalar){
-        for (size_t i = 0; i < sc16_table_len; i++){
-            const uint16_t val = tohost(uint16_t(i & 0xffff));
-            const type real = conv(int8_t(val >> 8), scalar);
-            const type imag = conv(int8_t(val >> 0), scalar);
-            _table[i] = std::complex<type>(real, imag);
-        }
+        _table = get_shared_table<std::complex<type> >(typeid(*this).name(), scalar,
+            [scalar](aligned_table_t<std::complex<type> > &table){
+                for (size_t i = 0; i < sc16_table_len; i++){
+                    const uint16_t val = tohost(uint16_t(i & 0xffff));
+                    const type real = conv(int8_t(val >> 8), scalar);
+                    const type imag = conv(int8_t(val >> 0), scalar);
+                    table[i] = std::complex<type>(real, imag);
+                }
+            });
     }
 
     void operator()(const input_type &inputs, const output_type &outputs, const size_t nsamps){
         const item32_t *input = reinterpret_cast<const item32_t *>(size_t(inputs[0]) & ~0x3);
         std::complex<type> *output = reinterpret_cast<std::complex<type> *>(outputs[0]);
+        const aligned_table_t<std::complex<type> > &table = *_table;
 
         size_t num_samps = nsamps;
 
         if ((size_t(inputs[0]) & 0x3) != 0){
             const item32_t item0 = *input++;
-            *output++ = _table[uint16_t(item0 >> hi_shift)];
+            *output++ = table[uint16_t(item0 >> hi_shift)];
             num_samps--;
         }
 
         const size_t num_pairs = num_samps/2;
         for (size_t i = 0, j = 0; i < num_pairs; i++, j+=2){
             const item32_t item_i = (input[i]);
-            output[j] = _table[uint16_t(item_i >> lo_shift)];
-            output[j + 1] = _table[uint16_t(item_i >> hi_shift)];
+            output[j] = table[uint16_t(item_i >> lo_shift)];
+            output[j + 1] = table[uint16_t(item_i >> hi_shift)];
         }
 
         if (num_samps != num_pairs*2){
             const item32_t item_n = input[num_pairs];
-            output[num_samps-1] = _table[uint16_t(item_n >> lo_shift)];
+            output[num_samps-1] = table[uint16_t(item_n >> lo_shift)];
         }
     }
 
 private:
-    std::vector<std::complex<type> > _table;
+    typename table_cache_t<std::complex<type> >::sptr _table;
 };
 
 /***********************************************************************
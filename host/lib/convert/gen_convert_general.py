@@ -56,6 +56,29 @@ DECLARE_CONVERTER({in_type}, 1, {out_type}, 1, PRIORITY_GENERAL) {{
 """
 
 
+# Complex types against the sc16/sc8 wire formats. These scale and
+# byteswap in one fused pass: the UHD_INLINE helpers from
+# convert_common.hpp compose the wire item in a register and apply the
+# wire order on the way through, so each sample is one load and one
+# store. The same helpers serve as the unaligned head/tail code of the
+# hand-written SIMD converters, which keeps the rounding behavior
+# bit-identical between the generic and SIMD paths.
+TMPL_CONV_COMPLEX_ITEM32 = """
+DECLARE_CONVERTER({cpu_type}, 1, {wire_type}_item32_{end}, 1, PRIORITY_GENERAL) {{
+    const {cpu_type}_t *input = reinterpret_cast<const {cpu_type}_t *>(inputs[0]);
+    item32_t *output = reinterpret_cast<item32_t *>(outputs[0]);
+
+    xx_to_item32_{wire_type}<{to_wire}>(input, output, nsamps, scale_factor);
+}}
+
+DECLARE_CONVERTER({wire_type}_item32_{end}, 1, {cpu_type}, 1, PRIORITY_GENERAL) {{
+    const item32_t *input = reinterpret_cast<const item32_t *>(inputs[0]);
+    {cpu_type}_t *output = reinterpret_cast<{cpu_type}_t *>(outputs[0]);
+
+    item32_{wire_type}_to_xx<{to_host}>(input, output, nsamps, scale_factor);
+}}
+"""
+
 TMPL_CONV_U8S8 = """
 DECLARE_CONVERTER({us8}, 1, {us8}_item32_{end}, 1, PRIORITY_GENERAL) {{
     const item32_t *input = reinterpret_cast<const item32_t *>(inputs[0]);
@@ -208,6 +231,23 @@ if __name__ == '__main__':
                     in_type=in_type.format(end=end), out_type=out_type.format(end=end)
             )
 
+    ## Complex types against the item32 wire formats:
+    for cpu_type, wire_types in (
+            ('sc16', ('sc8', 'sc16')),
+            ('fc32', ('sc8', 'sc16')),
+            ('fc64', ('sc8', 'sc16')),
+            ('sc8', ('sc8',)),
+    ):
+        for wire_type in wire_types:
+            for end, to_host, to_wire in (
+                ('be', 'uhd::ntohx', 'uhd::htonx'),
+                ('le', 'uhd::wtohx', 'uhd::htowx'),
+            ):
+                output += TMPL_CONV_COMPLEX_ITEM32.format(
+                        cpu_type=cpu_type, wire_type=wire_type,
+                        end=end, to_host=to_host, to_wire=to_wire
+                )
+
     ## Real 16-Bit:
     for end, to_host, to_wire in (
         ('be', 'uhd::ntohx', 'uhd::htonx'),
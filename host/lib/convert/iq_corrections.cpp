@@ -0,0 +1,66 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/convert/iq_corrections.hpp>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/*
+ * The complex multiply is expanded on the interleaved [re, im] layout:
+ *   y_re = a_re*x_re - a_im*x_im + o_re
+ *   y_im = a_re*x_im + a_im*x_re + o_im
+ * The SIMD paths process two complex samples per vector by pairing the
+ * broadcast a_re with a sign-alternated a_im against the swapped input.
+ */
+void uhd::convert::apply_iq_corrections_fc32(
+    std::complex<float> *samps,
+    const size_t nsamps,
+    const std::complex<float> scale,
+    const std::complex<float> offset
+){
+    const float a_re = scale.real();
+    const float a_im = scale.imag();
+    const float o_re = offset.real();
+    const float o_im = offset.imag();
+    float *f = reinterpret_cast<float *>(samps);
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    const __m128 areal = _mm_set1_ps(a_re);
+    const __m128 aimag = _mm_set_ps(a_im, -a_im, a_im, -a_im);
+    const __m128 off   = _mm_set_ps(o_im, o_re, o_im, o_re);
+    for (; i + 2 <= nsamps; i += 2){
+        const __m128 x  = _mm_loadu_ps(f + 2*i);
+        const __m128 xs = _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 0, 1));
+        const __m128 y  = _mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(x, areal), _mm_mul_ps(xs, aimag)), off);
+        _mm_storeu_ps(f + 2*i, y);
+    }
+#elif defined(__ARM_NEON)
+    const float aimag_arr[4] = {-a_im, a_im, -a_im, a_im};
+    const float off_arr[4]   = {o_re, o_im, o_re, o_im};
+    const float32x4_t areal = vdupq_n_f32(a_re);
+    const float32x4_t aimag = vld1q_f32(aimag_arr);
+    const float32x4_t off   = vld1q_f32(off_arr);
+    for (; i + 2 <= nsamps; i += 2){
+        const float32x4_t x  = vld1q_f32(f + 2*i);
+        const float32x4_t xs = vrev64q_f32(x);
+        const float32x4_t y  = vmlaq_f32(vmlaq_f32(off, x, areal), xs, aimag);
+        vst1q_f32(f + 2*i, y);
+    }
+#endif
+
+    for (; i < nsamps; i++){
+        const float x_re = f[2*i + 0];
+        const float x_im = f[2*i + 1];
+        f[2*i + 0] = a_re*x_re - a_im*x_im + o_re;
+        f[2*i + 1] = a_re*x_im + a_im*x_re + o_im;
+    }
+}
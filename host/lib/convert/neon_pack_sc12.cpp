@@ -0,0 +1,169 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_pack_sc12.hpp"
+#include <arm_neon.h>
+
+using namespace uhd::convert;
+
+/*
+ * Packing with NEON is a hybrid: the quantization (scale, convert and
+ * mask to 12 bits) vectorizes over a whole block of 4 complex samples,
+ * while the odd shift-and-or line assembly stays scalar through the
+ * shared pack() helper. This keeps the writes exact at 12 bytes per
+ * block, so no overwrite games are needed and the body can run all the
+ * way to the tail.
+ */
+template <typename type, towire32_type towire>
+inline void convert_star_4_to_sc12_item32_3
+(
+    const std::complex<type> *in,
+    item32_sc12_3x &output,
+    const double scalar,
+    typename std::enable_if<std::is_same<type, float>::value>::type* = NULL
+)
+{
+    float32x4_t f0 = vld1q_f32(reinterpret_cast<const float *>(&in[0]));
+    float32x4_t f1 = vld1q_f32(reinterpret_cast<const float *>(&in[2]));
+    const float32x4_t vscalar = vdupq_n_f32(scalar);
+    f0 = vmulq_f32(f0, vscalar);
+    f1 = vmulq_f32(f1, vscalar);
+
+    //truncating conversion and mask, same as the scalar quantizer
+    const int32x4_t vmask = vdupq_n_s32(0xfff);
+    int32_t iq[8];
+    vst1q_s32(&iq[0], vandq_s32(vcvtq_s32_f32(f0), vmask));
+    vst1q_s32(&iq[4], vandq_s32(vcvtq_s32_f32(f1), vmask));
+
+    pack<towire>(output, CONVERT12_LINE_ALL, iq);
+}
+
+template <typename type, towire32_type towire>
+inline void convert_star_4_to_sc12_item32_3
+(
+    const std::complex<type> *in,
+    item32_sc12_3x &output,
+    const double,
+    typename std::enable_if<std::is_same<type, short>::value>::type* = NULL
+)
+{
+    const int16x8_t v = vshrq_n_s16(
+        vld1q_s16(reinterpret_cast<const int16_t *>(in)), 4);
+
+    const int32x4_t vmask = vdupq_n_s32(0xfff);
+    int32_t iq[8];
+    vst1q_s32(&iq[0], vandq_s32(vmovl_s16(vget_low_s16(v)), vmask));
+    vst1q_s32(&iq[4], vandq_s32(vmovl_s16(vget_high_s16(v)), vmask));
+
+    pack<towire>(output, CONVERT12_LINE_ALL, iq);
+}
+
+template <typename type, towire32_type towire>
+struct convert_star_1_to_sc12_item32_neon : public converter
+{
+    convert_star_1_to_sc12_item32_neon(void):_scalar(0.0)
+    {
+    }
+
+    void set_scalar(const double scalar)
+    {
+        _scalar = scalar;
+    }
+
+    void operator()(const input_type &inputs, const output_type &outputs, const size_t nsamps)
+    {
+        const std::complex<type> *input = reinterpret_cast<const std::complex<type> *>(inputs[0]);
+
+        const size_t head_samps = size_t(outputs[0]) & 0x3;
+        int enable;
+        size_t rewind = 0;
+        switch(head_samps)
+        {
+            case 0: break;
+            case 1: rewind = 9; break;
+            case 2: rewind = 6; break;
+            case 3: rewind = 3; break;
+        }
+        item32_sc12_3x *output = reinterpret_cast<item32_sc12_3x *>(size_t(outputs[0]) - rewind);
+
+        //helper variables
+        size_t i = 0, o = 0;
+
+        //handle the head case
+        switch (head_samps)
+        {
+        case 0:
+            break; //no head
+        case 1:
+            enable = CONVERT12_LINE2;
+            convert_star_4_to_sc12_item32_3<type, towire>(0, 0, 0, input[0], enable, output[o++], _scalar);
+            break;
+        case 2:
+            enable = CONVERT12_LINE2 | CONVERT12_LINE1;
+            convert_star_4_to_sc12_item32_3<type, towire>(0, 0, input[0], input[1], enable, output[o++], _scalar);
+            break;
+        case 3:
+            enable = CONVERT12_LINE2 | CONVERT12_LINE1 | CONVERT12_LINE0;
+            convert_star_4_to_sc12_item32_3<type, towire>(0, input[0], input[1], input[2], enable, output[o++], _scalar);
+            break;
+        }
+        i += head_samps;
+
+        //convert the body
+        while (i+3 < nsamps)
+        {
+            convert_star_4_to_sc12_item32_3<type, towire>(&input[i], output[o], _scalar);
+            o++; i += 4;
+        }
+
+        //handle the tail case
+        const size_t tail_samps = nsamps - i;
+        switch (tail_samps)
+        {
+        case 0:
+            break; //no tail
+        case 1:
+            enable = CONVERT12_LINE0;
+            convert_star_4_to_sc12_item32_3<type, towire>(input[i+0], 0, 0, 0, enable, output[o], _scalar);
+            break;
+        case 2:
+            enable = CONVERT12_LINE0 | CONVERT12_LINE1;
+            convert_star_4_to_sc12_item32_3<type, towire>(input[i+0], input[i+1], 0, 0, enable, output[o], _scalar);
+            break;
+        case 3:
+            enable = CONVERT12_LINE0 | CONVERT12_LINE1 | CONVERT12_LINE2;
+            convert_star_4_to_sc12_item32_3<type, towire>(input[i+0], input[i+1], input[i+2], 0, enable, output[o], _scalar);
+            break;
+        }
+    }
+
+    double _scalar;
+};
+
+static converter::sptr make_convert_fc32_1_to_sc12_item32_le_1(void)
+{
+    return converter::sptr(new convert_star_1_to_sc12_item32_neon<float, uhd::wtohx>());
+}
+
+static converter::sptr make_convert_sc16_1_to_sc12_item32_le_1(void)
+{
+    return converter::sptr(new convert_star_1_to_sc12_item32_neon<short, uhd::wtohx>());
+}
+
+UHD_STATIC_BLOCK(register_neon_pack_sc12)
+{
+    uhd::convert::id_type id;
+    id.num_inputs = 1;
+    id.num_outputs = 1;
+
+    id.input_format = "fc32";
+    id.output_format = "sc12_item32_le";
+    uhd::convert::register_converter(id, &make_convert_fc32_1_to_sc12_item32_le_1, PRIORITY_SIMD);
+
+    id.input_format = "sc16";
+    id.output_format = "sc12_item32_le";
+    uhd::convert::register_converter(id, &make_convert_sc16_1_to_sc12_item32_le_1, PRIORITY_SIMD);
+}
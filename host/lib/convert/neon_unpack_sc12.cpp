@@ -0,0 +1,173 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_unpack_sc12.hpp"
+#include <arm_neon.h>
+
+using namespace uhd::convert;
+
+/*
+ * Unpacking a 12-byte sc12 block with NEON:
+ *
+ * The table lookups gather the two bytes holding each 12-bit number
+ * into one 16-bit lane, I values in one d-register and Q values in the
+ * other. I values come out high-bit aligned and Q values come out with
+ * a 4-bit offset, so the I lanes are masked with 0xfff0 and the Q lanes
+ * are masked with 0x0fff and shifted up. A final zip re-interleaves the
+ * I/Q pairs into sample order.
+ *
+ *            Block bytes     Mask     Shift
+ * ==========================================
+ *    I0         2, 3        0xfff0      0
+ *    I1         7, 0        0xfff0      0
+ *    I2         4, 5        0xfff0      0
+ *    I3         9,10        0xfff0      0
+ *    Q0         1, 2        0x0fff      4
+ *    Q1         6, 7        0x0fff      4
+ *    Q2        11, 4        0x0fff      4
+ *    Q3         8, 9        0x0fff      4
+ */
+static const uint8_t sc12_unpack_idx_i[8] = {2, 3, 7, 0, 4, 5, 9, 10};
+static const uint8_t sc12_unpack_idx_q[8] = {1, 2, 6, 7, 11, 4, 8, 9};
+
+template <typename type, tohost32_type tohost>
+UHD_INLINE void unpack_sc12_nx8(
+    const item32_sc12_3x &input,
+    int16x4_t &vi, int16x4_t &vq
+){
+    uint8x8x2_t tbl;
+    const uint8x16_t raw = vld1q_u8(reinterpret_cast<const uint8_t *>(&input));
+    tbl.val[0] = vget_low_u8(raw);
+    tbl.val[1] = vget_high_u8(raw);
+
+    uint16x4_t ui = vreinterpret_u16_u8(vtbl2_u8(tbl, vld1_u8(sc12_unpack_idx_i)));
+    uint16x4_t uq = vreinterpret_u16_u8(vtbl2_u8(tbl, vld1_u8(sc12_unpack_idx_q)));
+    ui = vand_u16(ui, vdup_n_u16(0xfff0));
+    uq = vshl_n_u16(vand_u16(uq, vdup_n_u16(0x0fff)), 4);
+
+    vi = vreinterpret_s16_u16(ui);
+    vq = vreinterpret_s16_u16(uq);
+}
+
+template <typename type, tohost32_type tohost>
+inline void convert_sc12_item32_3_to_star_4
+(
+    const item32_sc12_3x &input,
+    std::complex<type> *out,
+    double scalar,
+    typename std::enable_if<std::is_same<type, float>::value>::type* = NULL
+)
+{
+    int16x4_t vi, vq;
+    unpack_sc12_nx8<type, tohost>(input, vi, vq);
+
+    const float32x4_t vscalar = vdupq_n_f32(scalar);
+    const float32x4_t fi = vmulq_f32(vcvtq_f32_s32(vmovl_s16(vi)), vscalar);
+    const float32x4_t fq = vmulq_f32(vcvtq_f32_s32(vmovl_s16(vq)), vscalar);
+
+    const float32x4x2_t z = vzipq_f32(fi, fq);
+    vst1q_f32(reinterpret_cast<float *>(&out[0]), z.val[0]);
+    vst1q_f32(reinterpret_cast<float *>(&out[2]), z.val[1]);
+}
+
+template <typename type, tohost32_type tohost>
+inline void convert_sc12_item32_3_to_star_4
+(
+    const item32_sc12_3x &input,
+    std::complex<type> *out,
+    double,
+    typename std::enable_if<std::is_same<type, short>::value>::type* = NULL
+)
+{
+    int16x4_t vi, vq;
+    unpack_sc12_nx8<type, tohost>(input, vi, vq);
+
+    const int16x4x2_t z = vzip_s16(vi, vq);
+    vst1q_s16(reinterpret_cast<int16_t *>(out), vcombine_s16(z.val[0], z.val[1]));
+}
+
+template <typename type, tohost32_type tohost>
+struct convert_sc12_item32_1_to_star_neon : public converter
+{
+    convert_sc12_item32_1_to_star_neon(void):_scalar(0.0)
+    {
+        //NOP
+    }
+
+    void set_scalar(const double scalar)
+    {
+        const int unpack_growth = 16;
+        _scalar = scalar/unpack_growth;
+    }
+
+    void operator()(const input_type &inputs, const output_type &outputs, const size_t nsamps)
+    {
+        const size_t head_samps = size_t(inputs[0]) & 0x3;
+        size_t rewind = 0;
+        switch(head_samps)
+        {
+            case 0: break;
+            case 1: rewind = 9; break;
+            case 2: rewind = 6; break;
+            case 3: rewind = 3; break;
+        }
+
+        const item32_sc12_3x *input = reinterpret_cast<const item32_sc12_3x *>(size_t(inputs[0]) - rewind);
+        std::complex<type> *output = reinterpret_cast<std::complex<type> *>(outputs[0]);
+        std::complex<type> dummy;
+        size_t i = 0, o = 0;
+        switch (head_samps)
+        {
+        case 0: break; //no head
+        case 1: convert_sc12_item32_3_to_star_4<type, tohost>(input[i++], dummy, dummy, dummy, output[0], _scalar); break;
+        case 2: convert_sc12_item32_3_to_star_4<type, tohost>(input[i++], dummy, dummy, output[0], output[1], _scalar); break;
+        case 3: convert_sc12_item32_3_to_star_4<type, tohost>(input[i++], dummy, output[0], output[1], output[2], _scalar); break;
+        }
+        o += head_samps;
+
+        //convert the body
+        while (o+3 < nsamps)
+        {
+            convert_sc12_item32_3_to_star_4<type, tohost>(input[i], &output[o], _scalar);
+            i += 1; o += 4;
+        }
+
+        const size_t tail_samps = nsamps - o;
+        switch (tail_samps)
+        {
+        case 0: break; //no tail
+        case 1: convert_sc12_item32_3_to_star_4<type, tohost>(input[i], output[o+0], dummy, dummy, dummy, _scalar); break;
+        case 2: convert_sc12_item32_3_to_star_4<type, tohost>(input[i], output[o+0], output[o+1], dummy, dummy, _scalar); break;
+        case 3: convert_sc12_item32_3_to_star_4<type, tohost>(input[i], output[o+0], output[o+1], output[o+2], dummy, _scalar); break;
+        }
+    }
+
+    double _scalar;
+};
+
+static converter::sptr make_convert_sc12_item32_le_1_to_fc32_1(void)
+{
+    return converter::sptr(new convert_sc12_item32_1_to_star_neon<float, uhd::wtohx>());
+}
+
+static converter::sptr make_convert_sc12_item32_le_1_to_sc16_1(void)
+{
+    return converter::sptr(new convert_sc12_item32_1_to_star_neon<short, uhd::wtohx>());
+}
+
+UHD_STATIC_BLOCK(register_neon_unpack_sc12)
+{
+    uhd::convert::id_type id;
+    id.num_inputs = 1;
+    id.num_outputs = 1;
+    id.output_format = "fc32";
+    id.input_format = "sc12_item32_le";
+    uhd::convert::register_converter(id, &make_convert_sc12_item32_le_1_to_fc32_1, PRIORITY_SIMD);
+
+    id.output_format = "sc16";
+    id.input_format = "sc12_item32_le";
+    uhd::convert::register_converter(id, &make_convert_sc12_item32_le_1_to_sc16_1, PRIORITY_SIMD);
+}
@@ -0,0 +1,69 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/convert/power_stats.hpp>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/*
+ * The vector accumulators run on the interleaved [re, im] layout: the
+ * component sums fall out of the even/odd lanes and the squared
+ * magnitudes are the lane-wise sum of x*x. Float accumulation over one
+ * packet-sized block stays well within precision; the reduction into
+ * the caller's double accumulators happens once per call.
+ */
+void uhd::convert::accumulate_power_stats_fc32(
+    const std::complex<float> *samps,
+    const size_t nsamps,
+    double &sum_i,
+    double &sum_q,
+    double &sum_power
+){
+    const float *f = reinterpret_cast<const float *>(samps);
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    __m128 acc    = _mm_setzero_ps();
+    __m128 acc_sq = _mm_setzero_ps();
+    for (; i + 2 <= nsamps; i += 2){
+        const __m128 x = _mm_loadu_ps(f + 2*i);
+        acc    = _mm_add_ps(acc, x);
+        acc_sq = _mm_add_ps(acc_sq, _mm_mul_ps(x, x));
+    }
+    float a[4], sq[4];
+    _mm_storeu_ps(a, acc);
+    _mm_storeu_ps(sq, acc_sq);
+    sum_i += double(a[0]) + double(a[2]);
+    sum_q += double(a[1]) + double(a[3]);
+    sum_power += double(sq[0]) + double(sq[1]) + double(sq[2]) + double(sq[3]);
+#elif defined(__ARM_NEON)
+    float32x4_t acc    = vdupq_n_f32(0.0f);
+    float32x4_t acc_sq = vdupq_n_f32(0.0f);
+    for (; i + 2 <= nsamps; i += 2){
+        const float32x4_t x = vld1q_f32(f + 2*i);
+        acc    = vaddq_f32(acc, x);
+        acc_sq = vmlaq_f32(acc_sq, x, x);
+    }
+    float a[4], sq[4];
+    vst1q_f32(a, acc);
+    vst1q_f32(sq, acc_sq);
+    sum_i += double(a[0]) + double(a[2]);
+    sum_q += double(a[1]) + double(a[3]);
+    sum_power += double(sq[0]) + double(sq[1]) + double(sq[2]) + double(sq[3]);
+#endif
+
+    for (; i < nsamps; i++){
+        const float x_re = f[2*i + 0];
+        const float x_im = f[2*i + 1];
+        sum_i += double(x_re);
+        sum_q += double(x_im);
+        sum_power += double(x_re)*double(x_re) + double(x_im)*double(x_im);
+    }
+}
@@ -63,6 +63,180 @@ DECLARE_CONVERTER(sc16_item32_le, 1, fc32, 1, PRIORITY_SIMD){
     item32_sc16_to_xx<uhd::htowx>(input+i, output+i, nsamps-i, scale_factor);
 }
 
+/***********************************************************************
+ * Dithered dequantization:
+ * Each sample gets half an LSB of uniform random dither added before
+ * scaling, so the quantization error decorrelates from the signal and
+ * integrates down like noise. The dither comes from four xorshift32
+ * lanes advanced with the same SSE2 shifts/xors as the conversion, so
+ * the fused kernels stay within a few percent of the plain ones.
+ * Registered under PRIORITY_SIMD_DITHER; a streamer has to ask for
+ * dithered conversion explicitly.
+ **********************************************************************/
+
+// advance four xorshift32 lanes by one draw
+#define XORSHIFT32_X4_DRAW(state)                                       \
+    state = _mm_xor_si128(state, _mm_slli_epi32(state, 13));            \
+    state = _mm_xor_si128(state, _mm_srli_epi32(state, 17));            \
+    state = _mm_xor_si128(state, _mm_slli_epi32(state, 5));
+
+//! Scalar tail of the dithered kernels, one xorshift32 lane
+template <xtox_t to_host>
+UHD_INLINE void item32_sc16_to_fc32_dithered(
+    const item32_t *input,
+    fc32_t *output,
+    const size_t nsamps,
+    const double scale_factor,
+    uint32_t &rng
+){
+    for (size_t i = 0; i < nsamps; i++){
+        const item32_t item = to_host(input[i]);
+        rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+        const float dr = float(int32_t(rng))*(1.0f/4294967296.0f);
+        rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+        const float di = float(int32_t(rng))*(1.0f/4294967296.0f);
+        output[i] = fc32_t(
+            (float(int16_t(item >> 16)) + dr)*float(scale_factor),
+            (float(int16_t(item >> 0)) + di)*float(scale_factor)
+        );
+    }
+}
+
+//! Common shell of the two dithered converters; the PRNG state lives
+//! in the converter instance so consecutive calls continue the sequence.
+//! Two independent 4-lane states cover the eight floats per iteration,
+//! so the two draws overlap instead of serializing on one state.
+struct sse2_sc16_to_fc32_dithered_base : public uhd::convert::converter{
+    sse2_sc16_to_fc32_dithered_base(void): scale_factor(0.0)
+    {
+        //arbitrary distinct seeds; xorshift must not start at zero
+        _rng[0] = 0x6b8b4567;
+        _rng[1] = 0x327b23c6;
+        _rng[2] = 0x643c9869;
+        _rng[3] = 0x66334873;
+        _rng[4] = 0x74b0dc51;
+        _rng[5] = 0x19495cff;
+        _rng[6] = 0x2ae8944a;
+        _rng[7] = 0x625558ec;
+    }
+    void set_scalar(const double s){scale_factor = s;}
+    double scale_factor;
+    uint32_t _rng[8];
+};
+
+struct convert_sc16_item32_le_1_to_fc32_1_dithered : public sse2_sc16_to_fc32_dithered_base{
+    static sptr make(void){return sptr(new convert_sc16_item32_le_1_to_fc32_1_dithered());}
+    void operator()(const input_type &inputs, const output_type &outputs, const size_t nsamps){
+        const item32_t *input = reinterpret_cast<const item32_t *>(inputs[0]);
+        fc32_t *output = reinterpret_cast<fc32_t *>(outputs[0]);
+
+        const __m128 scalar = _mm_set_ps1(float(scale_factor)/(1 << 16));
+        //the integer value sits in the upper 16 bits, so half an LSB of
+        //it is the raw 32-bit draw scaled by 2^-16
+        const __m128 dither_scalar = _mm_set_ps1(1.0f/(1 << 16));
+        const __m128i zeroi = _mm_setzero_si128();
+        __m128i rng_a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_rng+0));
+        __m128i rng_b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_rng+4));
+
+        size_t i = 0;
+        for (; i+3 < nsamps; i+=4){
+            /* load from input */
+            __m128i tmpi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input+i));
+
+            /* unpack + swap 16-bit pairs */
+            tmpi = _mm_shufflelo_epi16(tmpi, _MM_SHUFFLE(2, 3, 0, 1));
+            tmpi = _mm_shufflehi_epi16(tmpi, _MM_SHUFFLE(2, 3, 0, 1));
+            __m128i tmpilo = _mm_unpacklo_epi16(zeroi, tmpi); /* value in upper 16 bits */
+            __m128i tmpihi = _mm_unpackhi_epi16(zeroi, tmpi);
+
+            /* draw dither for all eight floats */
+            XORSHIFT32_X4_DRAW(rng_a)
+            const __m128 dlo = _mm_mul_ps(_mm_cvtepi32_ps(rng_a), dither_scalar);
+            XORSHIFT32_X4_DRAW(rng_b)
+            const __m128 dhi = _mm_mul_ps(_mm_cvtepi32_ps(rng_b), dither_scalar);
+
+            /* convert, dither and scale */
+            __m128 tmplo = _mm_mul_ps(_mm_add_ps(_mm_cvtepi32_ps(tmpilo), dlo), scalar);
+            __m128 tmphi = _mm_mul_ps(_mm_add_ps(_mm_cvtepi32_ps(tmpihi), dhi), scalar);
+
+            /* store to output */
+            _mm_storeu_ps(reinterpret_cast<float *>(output+i+0), tmplo);
+            _mm_storeu_ps(reinterpret_cast<float *>(output+i+2), tmphi);
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(_rng+0), rng_a);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(_rng+4), rng_b);
+
+        // convert any remaining samples
+        item32_sc16_to_fc32_dithered<uhd::htowx>(input+i, output+i, nsamps-i, scale_factor, _rng[0]);
+    }
+};
+
+UHD_STATIC_BLOCK(__register_convert_sc16_item32_le_1_to_fc32_1_dithered){
+    uhd::convert::id_type id;
+    id.input_format = "sc16_item32_le";
+    id.num_inputs = 1;
+    id.output_format = "fc32";
+    id.num_outputs = 1;
+    uhd::convert::register_converter(id,
+        &convert_sc16_item32_le_1_to_fc32_1_dithered::make, PRIORITY_SIMD_DITHER);
+}
+
+struct convert_sc16_item32_be_1_to_fc32_1_dithered : public sse2_sc16_to_fc32_dithered_base{
+    static sptr make(void){return sptr(new convert_sc16_item32_be_1_to_fc32_1_dithered());}
+    void operator()(const input_type &inputs, const output_type &outputs, const size_t nsamps){
+        const item32_t *input = reinterpret_cast<const item32_t *>(inputs[0]);
+        fc32_t *output = reinterpret_cast<fc32_t *>(outputs[0]);
+
+        const __m128 scalar = _mm_set_ps1(float(scale_factor)/(1 << 16));
+        const __m128 dither_scalar = _mm_set_ps1(1.0f/(1 << 16));
+        const __m128i zeroi = _mm_setzero_si128();
+        __m128i rng_a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_rng+0));
+        __m128i rng_b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_rng+4));
+
+        size_t i = 0;
+        for (; i+3 < nsamps; i+=4){
+            /* load from input */
+            __m128i tmpi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input+i));
+
+            /* byteswap + unpack -> byteswap 16 bit words */
+            tmpi = _mm_or_si128(_mm_srli_epi16(tmpi, 8), _mm_slli_epi16(tmpi, 8));
+            __m128i tmpilo = _mm_unpacklo_epi16(zeroi, tmpi); /* value in upper 16 bits */
+            __m128i tmpihi = _mm_unpackhi_epi16(zeroi, tmpi);
+
+            /* draw dither for all eight floats */
+            XORSHIFT32_X4_DRAW(rng_a)
+            const __m128 dlo = _mm_mul_ps(_mm_cvtepi32_ps(rng_a), dither_scalar);
+            XORSHIFT32_X4_DRAW(rng_b)
+            const __m128 dhi = _mm_mul_ps(_mm_cvtepi32_ps(rng_b), dither_scalar);
+
+            /* convert, dither and scale */
+            __m128 tmplo = _mm_mul_ps(_mm_add_ps(_mm_cvtepi32_ps(tmpilo), dlo), scalar);
+            __m128 tmphi = _mm_mul_ps(_mm_add_ps(_mm_cvtepi32_ps(tmpihi), dhi), scalar);
+
+            /* store to output */
+            _mm_storeu_ps(reinterpret_cast<float *>(output+i+0), tmplo);
+            _mm_storeu_ps(reinterpret_cast<float *>(output+i+2), tmphi);
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(_rng+0), rng_a);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(_rng+4), rng_b);
+
+        // convert any remaining samples
+        item32_sc16_to_fc32_dithered<uhd::htonx>(input+i, output+i, nsamps-i, scale_factor, _rng[0]);
+    }
+};
+
+UHD_STATIC_BLOCK(__register_convert_sc16_item32_be_1_to_fc32_1_dithered){
+    uhd::convert::id_type id;
+    id.input_format = "sc16_item32_be";
+    id.num_inputs = 1;
+    id.output_format = "fc32";
+    id.num_outputs = 1;
+    uhd::convert::register_converter(id,
+        &convert_sc16_item32_be_1_to_fc32_1_dithered::make, PRIORITY_SIMD_DITHER);
+}
+
 DECLARE_CONVERTER(sc16_item32_be, 1, fc32, 1, PRIORITY_SIMD){
     const item32_t *input = reinterpret_cast<const item32_t *>(inputs[0]);
     fc32_t *output = reinterpret_cast<fc32_t *>(outputs[0]);
@@ -113,3 +287,62 @@ DECLARE_CONVERTER(sc16_item32_be, 1, fc32, 1, PRIORITY_SIMD){
     // convert any remaining samples
     item32_sc16_to_xx<uhd::htonx>(input+i, output+i, nsamps-i, scale_factor);
 }
+
+/*
+ * Same conversion as the nswap kernel above, with non-temporal stores:
+ * when the output is a channel-major capture block much larger than the
+ * caches, writing around the cache leaves it to the consumer of the
+ * data. Registered under PRIORITY_SIMD_NT, so a streamer has to ask for
+ * streaming stores explicitly.
+ */
+DECLARE_CONVERTER(sc16_item32_le, 1, fc32, 1, PRIORITY_SIMD_NT){
+    const item32_t *input = reinterpret_cast<const item32_t *>(inputs[0]);
+    fc32_t *output = reinterpret_cast<fc32_t *>(outputs[0]);
+
+    const __m128 scalar = _mm_set_ps1(float(scale_factor)/(1 << 16));
+    const __m128i zeroi = _mm_setzero_si128();
+
+    #define convert_item32_1_to_fc32_1_nswap_guts_nt                    \
+    for (; i+3 < nsamps; i+=4){                                         \
+        /* load from input */                                           \
+        __m128i tmpi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input+i)); \
+                                                                        \
+        /* unpack + swap 16-bit pairs */                                \
+        tmpi = _mm_shufflelo_epi16(tmpi, _MM_SHUFFLE(2, 3, 0, 1));      \
+        tmpi = _mm_shufflehi_epi16(tmpi, _MM_SHUFFLE(2, 3, 0, 1));      \
+        __m128i tmpilo = _mm_unpacklo_epi16(zeroi, tmpi); /* value in upper 16 bits */ \
+        __m128i tmpihi = _mm_unpackhi_epi16(zeroi, tmpi);               \
+                                                                        \
+        /* convert and scale */                                         \
+        __m128 tmplo = _mm_mul_ps(_mm_cvtepi32_ps(tmpilo), scalar);     \
+        __m128 tmphi = _mm_mul_ps(_mm_cvtepi32_ps(tmpihi), scalar);     \
+                                                                        \
+        /* stream to output, bypassing the cache */                     \
+        _mm_stream_ps(reinterpret_cast<float *>(output+i+0), tmplo);    \
+        _mm_stream_ps(reinterpret_cast<float *>(output+i+2), tmphi);    \
+    }                                                                   \
+
+    size_t i = 0;
+
+    // streaming stores require a 16-byte aligned output
+    switch (size_t(output) & 0xf){
+    case 0x0:
+        convert_item32_1_to_fc32_1_nswap_guts_nt
+        _mm_sfence(); //order the streamed data before the buffer handoff
+        break;
+    case 0x8:
+        // process one sample to align the remainder of the output
+        item32_sc16_to_xx<uhd::htowx>(input, output, 1, scale_factor);
+        i++;
+        convert_item32_1_to_fc32_1_nswap_guts_nt
+        _mm_sfence();
+        break;
+    default:
+        // unalignable output: fall through to the scalar loop below,
+        // callers that want streaming stores align their buffers
+        break;
+    }
+
+    // convert any remaining samples
+    item32_sc16_to_xx<uhd::htowx>(input+i, output+i, nsamps-i, scale_factor);
+}
@@ -189,3 +189,53 @@ DECLARE_CONVERTER(sc16_item32_be, 1, sc16, 1, PRIORITY_SIMD){
     // convert any remaining samples
     item32_sc16_to_xx<uhd::htonx>(input+i, output+i, nsamps-i, 1.0);
 }
+
+//
+// Variant of the LE de-swap with non-temporal stores for outputs much
+// larger than the caches; opt-in via PRIORITY_SIMD_NT (see convert.hpp).
+//
+DECLARE_CONVERTER(sc16_item32_le, 1, sc16, 1, PRIORITY_SIMD_NT){
+    const item32_t *input = reinterpret_cast<const item32_t *>(inputs[0]);
+    sc16_t *output = reinterpret_cast<sc16_t *>(outputs[0]);
+
+    size_t i = 0;
+
+    #define CONVERT_SC16_1_TO_SC16_1_NSWAP_GUTS_NT                      \
+    for (; i+3 < nsamps; i+=4) {                                        \
+        __m128i m0;                                                     \
+                                                                        \
+        /* load from input */                                           \
+        m0 = _mm_loadu_si128((const __m128i *) (input+i));              \
+                                                                        \
+        /* swap 16-bit pairs */                                         \
+        m0 = _mm_shufflelo_epi16(m0, _MM_SHUFFLE(2, 3, 0, 1));          \
+        m0 = _mm_shufflehi_epi16(m0, _MM_SHUFFLE(2, 3, 0, 1));          \
+                                                                        \
+        /* stream to output, bypassing the cache */                     \
+        _mm_stream_si128((__m128i *) (output+i), m0);                   \
+    }                                                                   \
+
+    // streaming stores require a 16-byte aligned output
+    switch (size_t(output) & 0xf){
+    case 0x0:
+        CONVERT_SC16_1_TO_SC16_1_NSWAP_GUTS_NT
+        _mm_sfence(); //order the streamed data before the buffer handoff
+        break;
+    case 0x8:
+        if (nsamps < 2)
+            break;
+        // process two samples to align the remainder of the output
+        item32_sc16_to_xx<uhd::htowx>(input, output, 2, 1.0);
+        i += 2;
+        CONVERT_SC16_1_TO_SC16_1_NSWAP_GUTS_NT
+        _mm_sfence();
+        break;
+    default:
+        // unalignable output: fall through to the scalar loop below,
+        // callers that want streaming stores align their buffers
+        break;
+    }
+
+    // convert any remaining samples
+    item32_sc16_to_xx<uhd::htowx>(input+i, output+i, nsamps-i, 1.0);
+}
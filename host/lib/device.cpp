@@ -10,17 +10,24 @@
 #include <uhd/exception.hpp>
 #include <uhd/utils/log.hpp>
 
-#include <uhd/utils/static.hpp>
 #include <uhd/utils/algorithm.hpp>
+#include <uhd/utils/paths.hpp>
 #include <uhdlib/utils/prefs.hpp>
+#include <uhdlib/utils/thread_policy.hpp>
 
 #include <boost/format.hpp>
 #include <boost/weak_ptr.hpp>
 #include <boost/functional/hash.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/filesystem.hpp>
 
+#include <fstream>
 #include <future>
+#include <memory>
+#include <mutex>
+#include <set>
 
 using namespace uhd;
 
@@ -47,7 +54,11 @@ static size_t hash_device_addr(
         "claimed",
         "skip_dram",
         "skip_ddc",
-        "skip_duc"
+        "skip_duc",
+        //transport tuning recorded in the discovery cache, not identity
+        "path_mtu",
+        "path_mtu_recv",
+        "path_mtu_send"
     };
 
     if(dev_addr.has_key("resource")) {
@@ -67,13 +78,107 @@ static size_t hash_device_addr(
     return hash;
 }
 
+/***********************************************************************
+ * Discovery cache
+ **********************************************************************/
+//! Hint key that opts into the persistent discovery cache
+static const std::string DISCOVERY_CACHE_KEY = "cache";
+
+static boost::filesystem::path get_discovery_cache_path(void)
+{
+    return boost::filesystem::path(uhd::get_app_path())
+        / ".uhd" / "discovery_cache";
+}
+
+static device_addrs_t load_discovery_cache(void)
+{
+    device_addrs_t cached_addrs;
+    std::ifstream cache_file(get_discovery_cache_path().string().c_str());
+    std::string line;
+    while (std::getline(cache_file, line)) {
+        if (line.empty()) continue;
+        try {
+            cached_addrs.push_back(device_addr_t(line));
+        } catch (const std::exception &) {
+            //skip unparseable entries, the cache is only a hint
+        }
+    }
+    return cached_addrs;
+}
+
+/*!
+ * Merge freshly discovered addresses into the cache file.
+ * Entries are keyed by serial; entries without a serial are not cached.
+ */
+static void store_discovery_cache(const device_addrs_t &device_addrs)
+{
+    try {
+        device_addrs_t cached_addrs = load_discovery_cache();
+        for (const device_addr_t &dev_addr : device_addrs) {
+            if (not dev_addr.has_key("serial")) continue;
+            for (size_t i = 0; i < cached_addrs.size(); i++) {
+                if (cached_addrs[i].get("serial") == dev_addr["serial"]) {
+                    cached_addrs.erase(cached_addrs.begin() + i);
+                    break;
+                }
+            }
+            cached_addrs.push_back(dev_addr);
+        }
+        boost::filesystem::create_directories(
+            get_discovery_cache_path().parent_path());
+        std::ofstream cache_file(get_discovery_cache_path().string().c_str());
+        for (const device_addr_t &dev_addr : cached_addrs) {
+            cache_file << dev_addr.to_string() << std::endl;
+        }
+    } catch (const std::exception &e) {
+        UHD_LOGGER_WARNING("UHD")
+            << "Could not update discovery cache: " << e.what();
+    }
+}
+
+//! True when the candidate agrees with every identifying key in the hint
+static bool discovery_cache_match(
+    const device_addr_t &hint, const device_addr_t &candidate
+){
+    static const std::vector<std::string> match_keys =
+        {"serial", "type", "product", "name", "addr", "mgmt_addr", "resource"};
+    for (const std::string &key : match_keys) {
+        if (hint.has_key(key) and candidate.has_key(key)
+                and hint[key] != candidate[key]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void device::update_discovery_cache(const device_addr_t &dev_addr)
+{
+    if (not dev_addr.has_key("serial")) return;
+    boost::mutex::scoped_lock lock(_device_mutex);
+    store_discovery_cache(device_addrs_t(1, dev_addr));
+}
+
 /***********************************************************************
  * Registration
  **********************************************************************/
 typedef boost::tuple<device::find_t, device::make_t, device::device_filter_t> dev_fcn_reg_t;
+typedef std::vector<dev_fcn_reg_t> dev_fcn_registry_t;
 
-// instantiate the device function registry container
-UHD_SINGLETON_FCN(std::vector<dev_fcn_reg_t>, get_dev_fcn_regs)
+// The registry is an immutable snapshot behind a single atomic pointer:
+// registration (static init, possibly from concurrently loaded modules)
+// copies the snapshot and swaps in the new one under a mutex, while the
+// readers in find() and make() grab the pointer with one atomic load and
+// never take a lock.
+static std::mutex &get_dev_registry_mutex(void){
+    static std::mutex mutex;
+    return mutex;
+}
+
+static std::shared_ptr<const dev_fcn_registry_t> &get_dev_fcn_snapshot(void){
+    static std::shared_ptr<const dev_fcn_registry_t> snapshot =
+        std::make_shared<dev_fcn_registry_t>();
+    return snapshot;
+}
 
 void device::register_device(
     const find_t &find,
@@ -81,7 +186,12 @@ void device::register_device(
     const device_filter_t filter
 ){
     // UHD_LOGGER_TRACE("UHD") << "registering device";
-    get_dev_fcn_regs().push_back(dev_fcn_reg_t(find, make, filter));
+    std::lock_guard<std::mutex> lock(get_dev_registry_mutex());
+    auto updated = std::make_shared<dev_fcn_registry_t>(
+        *std::atomic_load(&get_dev_fcn_snapshot()));
+    updated->push_back(dev_fcn_reg_t(find, make, filter));
+    std::atomic_store(&get_dev_fcn_snapshot(),
+        std::shared_ptr<const dev_fcn_registry_t>(updated));
 }
 
 device::~device(void){
@@ -92,11 +202,49 @@ device::~device(void){
  * Discover
  **********************************************************************/
 device_addrs_t device::find(const device_addr_t &hint, device_filter_t filter){
-    boost::mutex::scoped_lock lock(_device_mutex);
+    //one atomic load of the registry snapshot; concurrent finds from
+    //multiple threads no longer serialize on a registry mutex
+    const std::shared_ptr<const dev_fcn_registry_t> regs =
+        std::atomic_load(&get_dev_fcn_snapshot());
 
     device_addrs_t device_addrs;
+
+    //with cache=... in the hint, try direct (unicast) verification of the
+    //last-known addresses first and only broadcast on a miss
+    const bool use_cache = hint.has_key(DISCOVERY_CACHE_KEY);
+    if (use_cache) {
+        device_addrs_t cached_addrs;
+        {
+            //the cache file itself still wants exclusive access
+            boost::mutex::scoped_lock lock(_device_mutex);
+            cached_addrs = load_discovery_cache();
+        }
+        for (const device_addr_t &candidate : cached_addrs) {
+            if (not discovery_cache_match(hint, candidate)) continue;
+            for (const auto& fcn : *regs) {
+                if (filter != ANY and fcn.get<2>() != filter) continue;
+                try {
+                    device_addrs_t found_addrs = fcn.get<0>()(candidate);
+                    device_addrs.insert(
+                        device_addrs.end(),
+                        found_addrs.begin(),
+                        found_addrs.end()
+                    );
+                } catch (const std::exception &e) {
+                    UHD_LOGGER_ERROR("UHD")
+                        << "Device discovery error: " << e.what();
+                }
+            }
+        }
+        if (not device_addrs.empty()) {
+            return device_addrs;
+        }
+        UHD_LOGGER_DEBUG("UHD")
+            << "Discovery cache miss, falling back to broadcast discovery.";
+    }
+
     std::vector<std::future<device_addrs_t>> find_tasks;
-    for (const auto& fcn : get_dev_fcn_regs()) {
+    for (const auto& fcn : *regs) {
         if (filter == ANY or fcn.get<2>() == filter) {
             find_tasks.emplace_back(std::async(std::launch::async,
                 [fcn, hint](){
@@ -119,6 +267,12 @@ device_addrs_t device::find(const device_addr_t &hint, device_filter_t filter){
         }
     }
 
+    //remember the broadcast results for the next cache-enabled find
+    if (use_cache and not device_addrs.empty()) {
+        boost::mutex::scoped_lock lock(_device_mutex);
+        store_discovery_cache(device_addrs);
+    }
+
     return device_addrs;
 }
 
@@ -126,12 +280,16 @@ device_addrs_t device::find(const device_addr_t &hint, device_filter_t filter){
  * Make
  **********************************************************************/
 device::sptr device::make(const device_addr_t &hint, device_filter_t filter, size_t which){
-    boost::mutex::scoped_lock lock(_device_mutex);
+    //no global lock here: the registry snapshot is grabbed with one
+    //atomic load and the find/make calls touch disjoint hardware, so
+    //concurrent makes of different devices cost max, not sum, of init
+    const std::shared_ptr<const dev_fcn_registry_t> regs =
+        std::atomic_load(&get_dev_fcn_snapshot());
 
     typedef boost::tuple<device_addr_t, make_t> dev_addr_make_t;
     std::vector<dev_addr_make_t> dev_addr_makers;
 
-    for(const dev_fcn_reg_t &fcn:  get_dev_fcn_regs()){
+    for(const dev_fcn_reg_t &fcn:  *regs){
         try{
             if(filter == ANY or fcn.get<2>() == filter){
                 for(device_addr_t dev_addr:  fcn.get<0>()(hint)){
@@ -173,19 +331,45 @@ device::sptr device::make(const device_addr_t &hint, device_filter_t filter, siz
 
     //map device address hash to created devices
     static uhd::dict<size_t, boost::weak_ptr<device> > hash_to_device;
+    //hashes whose device is being constructed by another thread right now
+    static std::set<size_t> hashes_in_progress;
+    static boost::condition_variable hash_cond;
+
+    //try to find an existing device; if another thread is already
+    //constructing this very device, wait for it instead of making a twin
+    boost::mutex::scoped_lock lock(_device_mutex);
+    while (true){
+        if (hash_to_device.has_key(dev_hash) and not hash_to_device[dev_hash].expired()){
+            return hash_to_device[dev_hash].lock();
+        }
+        if (hashes_in_progress.count(dev_hash) == 0) break;
+        hash_cond.wait(lock);
+    }
+    hashes_in_progress.insert(dev_hash);
+    lock.unlock();
 
-    //try to find an existing device
-    if (hash_to_device.has_key(dev_hash) and not hash_to_device[dev_hash].expired()){
-        return hash_to_device[dev_hash].lock();
+    // Add keys from the config files (note: the user-defined keys will
+    // always be applied, see also get_usrp_args()
+    // Then, create and register a new device.
+    device::sptr dev;
+    try {
+        const device_addr_t usrp_args = prefs::get_usrp_args(dev_addr);
+        //register thread policies before the maker spawns any of the
+        //internal threads they apply to
+        thread_policy::register_policies_from_args(usrp_args);
+        dev = maker(usrp_args);
     }
-    else {
-        // Add keys from the config files (note: the user-defined keys will
-        // always be applied, see also get_usrp_args()
-        // Then, create and register a new device.
-        device::sptr dev = maker(prefs::get_usrp_args(dev_addr));
-        hash_to_device[dev_hash] = dev;
-        return dev;
+    catch(...){
+        lock.lock();
+        hashes_in_progress.erase(dev_hash);
+        hash_cond.notify_all();
+        throw;
     }
+    lock.lock();
+    hash_to_device[dev_hash] = dev;
+    hashes_in_progress.erase(dev_hash);
+    hash_cond.notify_all();
+    return dev;
 }
 
 uhd::property_tree::sptr
@@ -0,0 +1,259 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/device_pool.hpp>
+#include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/tasks.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/format.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include <list>
+
+using namespace uhd;
+
+device_pool::~device_pool(void){
+    /* NOP */
+}
+
+device_pool::session::~session(void){
+    /* NOP */
+}
+
+namespace {
+    //everything one warm standby slot carries
+    struct pool_entry_t{
+        device_addr_t addr;
+        device::sptr dev;
+        rx_streamer::sptr rx_stream;
+        tx_streamer::sptr tx_stream;
+    };
+    typedef boost::shared_ptr<pool_entry_t> pool_entry_sptr;
+}
+
+class device_pool_impl;
+
+/***********************************************************************
+ * Session: hands the entry back to the pool on destruction
+ **********************************************************************/
+class pool_session_impl : public device_pool::session{
+public:
+    pool_session_impl(
+        boost::shared_ptr<device_pool_impl> pool, pool_entry_sptr entry
+    ):
+        _pool(pool), _entry(entry)
+    {
+        /* NOP */
+    }
+
+    ~pool_session_impl(void);
+
+    device::sptr get_device(void){
+        return _entry->dev;
+    }
+
+    rx_streamer::sptr get_rx_stream(void){
+        if (not _entry->rx_stream) throw uhd::runtime_error(
+            "device_pool: no rx streamer template was given to make()");
+        return _entry->rx_stream;
+    }
+
+    tx_streamer::sptr get_tx_stream(void){
+        if (not _entry->tx_stream) throw uhd::runtime_error(
+            "device_pool: no tx streamer template was given to make()");
+        return _entry->tx_stream;
+    }
+
+private:
+    //the session keeps the pool alive: entries must always have
+    //somewhere to go back to
+    boost::shared_ptr<device_pool_impl> _pool;
+    pool_entry_sptr _entry;
+};
+
+/***********************************************************************
+ * Pool implementation
+ **********************************************************************/
+class device_pool_impl :
+    public device_pool,
+    public boost::enable_shared_from_this<device_pool_impl>
+{
+public:
+    device_pool_impl(
+        const device_addr_t &hint,
+        const size_t num_devices,
+        const stream_args_t &rx_stream_args,
+        const stream_args_t &tx_stream_args,
+        const reset_fcn_type &reset_fcn
+    ):
+        _rx_stream_args(rx_stream_args),
+        _tx_stream_args(tx_stream_args),
+        _reset_fcn(reset_fcn),
+        _num_total(0),
+        _num_lost(0),
+        _shutdown(false)
+    {
+        if (num_devices == 0) throw uhd::value_error(
+            "device_pool: num_devices must be at least 1");
+
+        //discover in the calling thread so a missing device fails fast,
+        //then leave the expensive makes to the worker
+        const device_addrs_t found = device::find(hint);
+        if (found.empty()){
+            throw uhd::key_error(str(
+                boost::format("No devices found for ----->\n%s")
+                % hint.to_pp_string()
+            ));
+        }
+
+        for (size_t i = 0; i < std::min(num_devices, found.size()); i++){
+            pool_entry_sptr entry = boost::make_shared<pool_entry_t>();
+            entry->addr = found[i];
+            //copy keys that were in hint but not in the found address,
+            //so transport arguments survive the round trip (same rule
+            //as device::make)
+            for(const std::string &key:  hint.keys()){
+                if (not entry->addr.has_key(key)){
+                    entry->addr[key] = hint[key];
+                }
+            }
+            _cold.push_back(entry);
+            _num_total++;
+        }
+
+        _worker = task::make(
+            boost::bind(&device_pool_impl::prep_task, this), "device_pool");
+    }
+
+    ~device_pool_impl(void){
+        //the worker only exits between iterations, so wake it up and
+        //tell it not to go back to sleep before joining it
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            _shutdown = true;
+            _cond.notify_all();
+        }
+        _worker.reset();
+    }
+
+    session::sptr acquire(const double timeout){
+        const boost::system_time exit_time = boost::get_system_time()
+            + boost::posix_time::milliseconds(long(timeout*1000));
+        boost::mutex::scoped_lock lock(_mutex);
+        while (_ready.empty()){
+            if (_num_lost == _num_total) throw uhd::runtime_error(
+                "device_pool: all pooled devices failed to initialize");
+            if (not _cond.timed_wait(lock, exit_time)) throw uhd::runtime_error(
+                "device_pool: timed out waiting for a ready device");
+        }
+        pool_entry_sptr entry = _ready.front();
+        _ready.pop_front();
+        return session::sptr(new pool_session_impl(shared_from_this(), entry));
+    }
+
+    size_t num_ready(void){
+        boost::mutex::scoped_lock lock(_mutex);
+        return _ready.size();
+    }
+
+    size_t size(void){
+        boost::mutex::scoped_lock lock(_mutex);
+        return _num_total - _num_lost;
+    }
+
+    //called by the session destructor: queue the entry for background
+    //re-initialization before it can be handed out again
+    void release(pool_entry_sptr entry){
+        //drop the session's streamers first - there can only be one
+        //streamer per device, and it must be gone before the worker
+        //creates the next one
+        entry->rx_stream.reset();
+        entry->tx_stream.reset();
+        boost::mutex::scoped_lock lock(_mutex);
+        _cold.push_back(entry);
+        _cond.notify_all();
+    }
+
+private:
+    //background worker: one entry per iteration through make (first
+    //time) or the reset callback (on release), then streamer setup
+    void prep_task(void){
+        pool_entry_sptr entry;
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            while (_cold.empty() and not _shutdown){
+                _cond.wait(lock);
+            }
+            if (_shutdown) return;
+            entry = _cold.front();
+            _cold.pop_front();
+        }
+        try{
+            if (not entry->dev){
+                entry->dev = device::make(entry->addr);
+            }
+            else if (_reset_fcn){
+                _reset_fcn(entry->dev);
+            }
+            if (not _rx_stream_args.cpu_format.empty()){
+                entry->rx_stream = entry->dev->get_rx_stream(_rx_stream_args);
+            }
+            if (not _tx_stream_args.cpu_format.empty()){
+                entry->tx_stream = entry->dev->get_tx_stream(_tx_stream_args);
+            }
+        }
+        catch(const std::exception &e){
+            UHD_LOGGER_ERROR("UHD")
+                << "device_pool: could not prepare device: " << e.what();
+            boost::mutex::scoped_lock lock(_mutex);
+            _num_lost++;
+            _cond.notify_all(); //wake acquirers so they can give up
+            return;
+        }
+        boost::mutex::scoped_lock lock(_mutex);
+        _ready.push_back(entry);
+        _cond.notify_all();
+    }
+
+    const stream_args_t _rx_stream_args;
+    const stream_args_t _tx_stream_args;
+    const reset_fcn_type _reset_fcn;
+
+    boost::mutex _mutex;
+    boost::condition_variable _cond;
+    std::list<pool_entry_sptr> _cold; //waiting for make or re-init
+    std::list<pool_entry_sptr> _ready; //warm, ready to hand out
+    size_t _num_total;
+    size_t _num_lost;
+    bool _shutdown;
+
+    //declared last so it is destroyed first: the worker must be gone
+    //before the queues and the condition variable go away
+    task::sptr _worker;
+};
+
+pool_session_impl::~pool_session_impl(void){
+    _pool->release(_entry);
+}
+
+/***********************************************************************
+ * Public make function for the device pool
+ **********************************************************************/
+device_pool::sptr device_pool::make(
+    const device_addr_t &hint,
+    const size_t num_devices,
+    const stream_args_t &rx_stream_args,
+    const stream_args_t &tx_stream_args,
+    const reset_fcn_type &reset_fcn
+){
+    return sptr(new device_pool_impl(
+        hint, num_devices, rx_stream_args, tx_stream_args, reset_fcn));
+}
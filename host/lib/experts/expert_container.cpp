@@ -62,7 +62,8 @@ private:    //Visitor class for cycle detection algorithm
 
 public:
     expert_container_impl(const std::string& name):
-        _name(name)
+        _name(name), _sorted_nodes_valid(false),
+        _defer_depth(0), _defer_pending(false), _defer_force(false)
     {
     }
 
@@ -79,6 +80,7 @@ public:
     void resolve_all(bool force = false)
     {
         boost::lock_guard<boost::recursive_mutex> resolve_lock(_resolve_mutex);
+        if (_defer_resolve(force)) return;
         boost::lock_guard<boost::mutex> lock(_mutex);
         EX_LOG(0, str(boost::format("resolve_all(%s)") % (force?"force":"")));
         // Do a full resolve of the graph
@@ -88,6 +90,7 @@ public:
     void resolve_from(const std::string&)
     {
         boost::lock_guard<boost::recursive_mutex> resolve_lock(_resolve_mutex);
+        if (_defer_resolve(false)) return;
         boost::lock_guard<boost::mutex> lock(_mutex);
         EX_LOG(0, "resolve_from (overridden to resolve_all)");
         // Do a full resolve of the graph
@@ -98,6 +101,7 @@ public:
     void resolve_to(const std::string&)
     {
         boost::lock_guard<boost::recursive_mutex> resolve_lock(_resolve_mutex);
+        if (_defer_resolve(false)) return;
         boost::lock_guard<boost::mutex> lock(_mutex);
         EX_LOG(0, "resolve_to (overridden to resolve_all)");
         // Do a full resolve of the graph
@@ -105,6 +109,31 @@ public:
         _resolve_helper("", "", false);
     }
 
+    void defer_resolve()
+    {
+        boost::lock_guard<boost::recursive_mutex> resolve_lock(_resolve_mutex);
+        EX_LOG(0, "defer_resolve()");
+        _defer_depth++;
+    }
+
+    void commit_resolve()
+    {
+        boost::lock_guard<boost::recursive_mutex> resolve_lock(_resolve_mutex);
+        EX_LOG(0, "commit_resolve()");
+        if (_defer_depth == 0) {
+            throw uhd::runtime_error("commit_resolve() called with no open transaction on expert " + _name);
+        }
+        if (--_defer_depth > 0) return;
+        if (not _defer_pending) return;
+
+        //Run the one batched resolve over all nodes dirtied in the transaction
+        const bool force = _defer_force;
+        _defer_pending = false;
+        _defer_force = false;
+        boost::lock_guard<boost::mutex> lock(_mutex);
+        _resolve_helper("", "", force);
+    }
+
     dag_vertex_t& retrieve(const std::string& name) const
     {
         try {
@@ -295,6 +324,7 @@ protected:
             expert_graph_t::vertex_descriptor gr_node = boost::add_vertex(data_node, _expert_dag);
             EX_LOG(1, str(boost::format("added vertex %s") % data_node->get_name()));
             _datanode_map.insert(vertex_map_t::value_type(data_node->get_name(), gr_node));
+            _sorted_nodes_valid = false;    //graph structure changed
 
             //Add resolve callbacks
             if (resolve_mode == AUTO_RESOLVE_ON_WRITE or resolve_mode == AUTO_RESOLVE_ON_READ_WRITE) {
@@ -334,6 +364,7 @@ protected:
             expert_graph_t::vertex_descriptor gr_node = boost::add_vertex(worker, _expert_dag);
             EX_LOG(1, str(boost::format("added vertex %s") % worker->get_name()));
             _worker_map.insert(vertex_map_t::value_type(worker->get_name(), gr_node));
+            _sorted_nodes_valid = false;    //graph structure changed
 
             //For each input, add an edge from the input to this node
             for(const std::string& node_name:  worker->get_inputs()) {
@@ -396,29 +427,52 @@ protected:
         // Release all nodes in the map
         _worker_map.clear();
         _datanode_map.clear();
+
+        // Invalidate the cached resolution order
+        _sorted_nodes.clear();
+        _sorted_nodes_valid = false;
     }
 
 private:
+    /*!
+     * If a deferred resolve transaction is open, record the resolve
+     * request and return true; the caller must skip the actual resolve.
+     * The resolve mutex must be held.
+     */
+    bool _defer_resolve(bool force)
+    {
+        if (_defer_depth == 0) return false;
+        EX_LOG(0, "resolve deferred (transaction open)");
+        _defer_pending = true;
+        _defer_force = _defer_force or force;
+        return true;
+    }
+
     void _resolve_helper(std::string start, std::string stop, bool force)
     {
         //Sort the graph topologically. This ensures that for all dependencies, the dependant
-        //is always after all of its dependencies.
-        node_queue_t sorted_nodes;
-        try {
-            boost::topological_sort(_expert_dag, std::front_inserter(sorted_nodes));
-        } catch (boost::not_a_dag&) {
-            std::vector<std::string> back_edges;
-            cycle_det_visitor cdet_vis(back_edges);
-            boost::depth_first_search(_expert_dag, boost::visitor(cdet_vis));
-            if (not back_edges.empty()) {
-                std::string edges;
-                for(const std::string& e:  back_edges) {
-                    edges += "* " + e + "";
+        //is always after all of its dependencies. The order only changes when the graph
+        //structure changes, so it is computed once and reused for every resolve.
+        if (not _sorted_nodes_valid) {
+            _sorted_nodes.clear();
+            try {
+                boost::topological_sort(_expert_dag, std::front_inserter(_sorted_nodes));
+            } catch (boost::not_a_dag&) {
+                std::vector<std::string> back_edges;
+                cycle_det_visitor cdet_vis(back_edges);
+                boost::depth_first_search(_expert_dag, boost::visitor(cdet_vis));
+                if (not back_edges.empty()) {
+                    std::string edges;
+                    for(const std::string& e:  back_edges) {
+                        edges += "* " + e + "";
+                    }
+                    throw uhd::runtime_error("Cannot resolve expert because it has at least one cycle!\n"
+                                             "The following back-edges were found:" + edges);
                 }
-                throw uhd::runtime_error("Cannot resolve expert because it has at least one cycle!\n"
-                                         "The following back-edges were found:" + edges);
             }
+            _sorted_nodes_valid = true;
         }
+        node_queue_t& sorted_nodes = _sorted_nodes;
         if (sorted_nodes.empty()) return;
 
         //Determine the start and stop node. If one is not explicitly specified then
@@ -511,8 +565,13 @@ private:
     expert_graph_t          _expert_dag;        //The primary graph data structure as an adjacency list
     vertex_map_t            _worker_map;        //A map from vertex name to vertex descriptor for workers
     vertex_map_t            _datanode_map;      //A map from vertex name to vertex descriptor for data nodes
+    node_queue_t            _sorted_nodes;      //Cached topological order of the graph for resolves
+    bool                    _sorted_nodes_valid;//False when the graph changed since the last sort
     boost::mutex            _mutex;
     boost::recursive_mutex  _resolve_mutex;
+    size_t                  _defer_depth;       //Nesting depth of open deferred resolve transactions
+    bool                    _defer_pending;     //True if a resolve was requested during the transaction
+    bool                    _defer_force;       //True if any deferred resolve requested force
 };
 
 expert_container::sptr expert_container::make(const std::string& name)
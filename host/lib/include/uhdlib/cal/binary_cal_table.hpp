@@ -0,0 +1,86 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_CAL_BINARY_CAL_TABLE_HPP
+#define INCLUDED_UHDLIB_CAL_BINARY_CAL_TABLE_HPP
+
+#include <uhd/config.hpp>
+#include <boost/shared_ptr.hpp>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace uhd { namespace cal {
+
+/*!
+ * A flat, memory-mapped calibration table.
+ *
+ * The file holds a fixed-size header followed by a dense matrix of
+ * doubles, sorted ascending by the key in column zero (typically the
+ * LO frequency). Lookups binary-search the mapped rows in place, so
+ * opening a table costs one mmap regardless of its size and only the
+ * pages actually touched become resident. This is the fast-path
+ * alternative to the boost archive containers, whose text files must
+ * be deserialized in full at load.
+ *
+ * The values are stored in host byte order: calibration data is
+ * generated on the host it describes and is not an interchange format.
+ */
+class binary_cal_table {
+public:
+    typedef boost::shared_ptr<binary_cal_table> sptr;
+
+    //! File extension used for binary calibration tables
+    static const char *FILE_EXT; // ".cal"
+
+    virtual ~binary_cal_table(void) {}
+
+    /*!
+     * Map an existing table from a file.
+     * \param path path to the table file
+     * \throws uhd::io_error if the file cannot be mapped or the
+     *         header is malformed
+     */
+    static sptr make(const std::string &path);
+
+    //! Number of rows in the table
+    virtual size_t get_num_rows(void) const = 0;
+
+    //! Number of doubles per row, including the key in column zero
+    virtual size_t get_num_cols(void) const = 0;
+
+    /*!
+     * Get a pointer to a row inside the mapping.
+     * The pointer is valid for the lifetime of the table object.
+     * \param row the row index, must be less than get_num_rows()
+     */
+    virtual const double *at(const size_t row) const = 0;
+
+    /*!
+     * Find the first row whose key is not less than the given key.
+     * \param key the column-zero value to search for
+     * \returns the row index, or get_num_rows() if all keys are smaller
+     */
+    virtual size_t lower_bound(const double key) const = 0;
+
+    /*!
+     * Write a table to a file.
+     * \param path path to the table file
+     * \param num_cols number of doubles per row (key included)
+     * \param rows row-major data, sorted ascending by column zero;
+     *        its size must be a multiple of num_cols
+     * \throws uhd::io_error if the file cannot be written
+     */
+    static void write(
+        const std::string &path,
+        const size_t num_cols,
+        const std::vector<double> &rows
+    );
+};
+
+}} //namespace uhd::cal
+
+#endif /* INCLUDED_UHDLIB_CAL_BINARY_CAL_TABLE_HPP */
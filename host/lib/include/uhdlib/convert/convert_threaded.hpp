@@ -0,0 +1,36 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_CONVERT_THREADED_HPP
+#define INCLUDED_UHDLIB_CONVERT_THREADED_HPP
+
+#include <uhd/convert.hpp>
+
+namespace uhd{ namespace convert{
+
+    /*!
+     * Wrap a converter so that large conversions are split across a
+     * persistent pool of worker threads. The split points are multiples
+     * of 64 items, so every worker starts on a cache-line boundary.
+     *
+     * Small conversions (and conversions whose item sizes cannot be
+     * determined, like sc12) bypass the pool and run on the caller.
+     *
+     * \param base the underlying converter to parallelize
+     * \param id identify the conversion (used to look up item sizes)
+     * \param num_threads total number of conversion threads, including
+     *                    the caller; a value below 2 returns base as-is
+     * \return the wrapped converter (or base when not applicable)
+     */
+    UHD_API converter::sptr make_threaded_converter(
+        const converter::sptr &base,
+        const id_type &id,
+        const size_t num_threads
+    );
+
+}} //namespace
+
+#endif /* INCLUDED_UHDLIB_CONVERT_THREADED_HPP */
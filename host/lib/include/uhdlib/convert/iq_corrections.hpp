@@ -0,0 +1,34 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_CONVERT_IQ_CORRECTIONS_HPP
+#define INCLUDED_UHDLIB_CONVERT_IQ_CORRECTIONS_HPP
+
+#include <uhd/config.hpp>
+#include <complex>
+#include <stddef.h>
+
+namespace uhd{ namespace convert{
+
+/*! Apply host-side IQ corrections to a block of fc32 samples in place.
+ *
+ * Computes samps[i] = scale * samps[i] + offset: the complex multiply
+ * corrects gain and phase imbalance, the complex offset removes the
+ * residual DC. Implemented with SIMD (SSE2/NEON) where the compiler
+ * provides it. The caller is expected to fuse this into the receive
+ * conversion pass, so the block is corrected while still cache-hot
+ * instead of being re-read from DRAM by a later sweep.
+ */
+UHD_API void apply_iq_corrections_fc32(
+    std::complex<float> *samps,
+    const size_t nsamps,
+    const std::complex<float> scale,
+    const std::complex<float> offset
+);
+
+}} //namespace uhd::convert
+
+#endif /* INCLUDED_UHDLIB_CONVERT_IQ_CORRECTIONS_HPP */
@@ -0,0 +1,36 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_CONVERT_POWER_STATS_HPP
+#define INCLUDED_UHDLIB_CONVERT_POWER_STATS_HPP
+
+#include <uhd/config.hpp>
+#include <complex>
+#include <stddef.h>
+
+namespace uhd{ namespace convert{
+
+/*! Accumulate signal statistics over a block of fc32 samples.
+ *
+ * Adds the component sums and the sum of squared magnitudes of the
+ * block into the caller's running accumulators, from which mean power
+ * and DC offset follow. Implemented with SIMD (SSE2/NEON) where the
+ * compiler provides it. The caller is expected to fuse this into the
+ * receive conversion pass, so the statistics ride along while the
+ * block is still cache-hot instead of costing a second full-rate
+ * sweep over DRAM.
+ */
+UHD_API void accumulate_power_stats_fc32(
+    const std::complex<float> *samps,
+    const size_t nsamps,
+    double &sum_i,
+    double &sum_q,
+    double &sum_power
+);
+
+}} //namespace uhd::convert
+
+#endif /* INCLUDED_UHDLIB_CONVERT_POWER_STATS_HPP */
@@ -86,6 +86,29 @@ namespace uhd { namespace experts {
          */
         virtual void resolve_to(const std::string& node_name) = 0;
 
+        /*!
+         * Open a deferred resolve transaction.
+         *
+         * While a transaction is open, resolve_all/resolve_from/resolve_to
+         * calls (including the auto-resolve callbacks of data nodes) only
+         * record that a resolve is pending; the written nodes stay dirty.
+         * Transactions nest: each defer_resolve must be balanced by a
+         * commit_resolve.
+         */
+        virtual void defer_resolve() = 0;
+
+        /*!
+         * Close a deferred resolve transaction.
+         *
+         * When the outermost transaction is closed and a resolve was
+         * requested during the batch, a single topologically-ordered
+         * resolve is run over the accumulated dirty nodes.
+         *
+         * \throws uhd::runtime_error if no transaction is open
+         * \throws uhd::runtime_error if graph cannot be resolved
+         */
+        virtual void commit_resolve() = 0;
+
         /*!
          * Return a node retriever object for this container
          */
@@ -187,6 +210,36 @@ namespace uhd { namespace experts {
         virtual void clear() = 0;
     };
 
+    /*!
+     * RAII guard for a deferred resolve transaction.
+     *
+     * Writes to data nodes made while the guard is alive only mark them
+     * dirty; the destructor runs one resolve over the whole batch. Use
+     * this to collapse multi-property sequences (e.g. gain + frequency)
+     * into a single expert pass.
+     */
+    class deferred_resolve_t : private boost::noncopyable {
+    public:
+        deferred_resolve_t(expert_container::sptr container) :
+            _container(container)
+        {
+            _container->defer_resolve();
+        }
+
+        ~deferred_resolve_t()
+        {
+            try {
+                _container->commit_resolve();
+            } catch (...) {
+                //Cannot throw from a destructor. The nodes stay dirty and
+                //will be picked up by the next resolve of this container.
+            }
+        }
+
+    private:
+        expert_container::sptr _container;
+    };
+
 }}
 
 #endif /* INCLUDED_UHD_EXPERTS_EXPERT_CONTAINER_HPP */
@@ -10,7 +10,9 @@
 
 #include "xports.hpp"
 #include <boost/shared_ptr.hpp>
+#include <stdint.h>
 #include <string>
+#include <vector>
 
 namespace uhd { namespace rfnoc {
 
@@ -59,6 +61,28 @@ public:
             const bool readback=false,
             const uint64_t timestamp=0
     ) = 0;
+
+    //! One entry of a timed command burst
+    struct timed_cmd_t
+    {
+        size_t addr;
+        size_t data;
+        uint64_t timestamp;
+    };
+
+    /*! Send a burst of command packets back to back.
+     *
+     * The packets are emitted under a single lock without waiting for
+     * individual responses, so a schedule of N timed commands costs one
+     * contiguous burst instead of N round trips. The call only blocks
+     * when the block's command FIFO would otherwise overflow, in which
+     * case it waits for outstanding commands to complete first.
+     *
+     * \param cmds the commands in emission order
+     *
+     * \throws the same errors as send_cmd_pkt()
+     */
+    virtual void send_cmd_pkt_burst(const std::vector<timed_cmd_t> &cmds) = 0;
 };
 
 }} /* namespace uhd::rfnoc */
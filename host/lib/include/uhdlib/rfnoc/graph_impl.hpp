@@ -10,6 +10,8 @@
 
 #include "async_msg_handler.hpp"
 #include <uhd/rfnoc/graph.hpp>
+#include <uhd/rfnoc/source_block_ctrl_base.hpp>
+#include <uhd/rfnoc/sink_block_ctrl_base.hpp>
 #include <uhd/device3.hpp>
 
 namespace uhd { namespace rfnoc {
@@ -70,8 +72,33 @@ public:
 
 private:
 
+    //! Device programming for one resolved connection, kept for replay
+    //
+    // Our applications frequently tear down and rebuild the same graph.
+    // Recording the resolved ports, SID and flow control values on the
+    // first connect() lets a later connect() of the same edge skip the
+    // resolution work and emit the programming as one burst per block.
+    struct connection_plan_t
+    {
+        size_t src_port;
+        size_t dst_port;
+        uint32_t sid;
+        size_t buf_size_bytes;
+        size_t bytes_per_response;
+    };
+
+    //! Replay a previously recorded connection plan
+    void replay_connection_plan(
+            uhd::rfnoc::source_block_ctrl_base::sptr src,
+            uhd::rfnoc::sink_block_ctrl_base::sptr dst,
+            const connection_plan_t &plan
+    );
+
     void handle_overruns(const async_msg_t& async_msg);
 
+    //! Plans from previous connect() calls, keyed by edge and packet size
+    std::map<std::string, connection_plan_t> _connection_plans;
+
     //! Maps 16-bit addresses to block IDs
     std::map<uint32_t, block_id_t> _block_id_map;
 
@@ -14,6 +14,7 @@
 #include <uhd/rfnoc/scalar_node_ctrl.hpp>
 #include <uhd/rfnoc/terminator_node_ctrl.hpp>
 #include <uhd/rfnoc/block_ctrl_base.hpp> // For the block macros
+#include <chrono>
 #include <mutex>
 
 namespace uhd {
@@ -71,6 +72,10 @@ private:
 
     std::mutex _overrun_handler_mutex;
 
+    //! Time of the last in-place (no stop/flush) overrun recovery;
+    //  recoveries that re-trigger promptly fall back to a full restart
+    std::chrono::steady_clock::time_point _last_fast_recovery;
+
 }; /* class rx_stream_terminator */
 
 }} /* namespace uhd::rfnoc */
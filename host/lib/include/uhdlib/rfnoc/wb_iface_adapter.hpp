@@ -40,6 +40,7 @@ public:
     void poke32(const wb_addr_type addr, const uint32_t data);
     uint32_t peek32(const wb_addr_type addr);
     uint64_t peek64(const wb_addr_type addr);
+    void poke32_range(const wb_addr_type addr, const std::vector<uint32_t> &data);
     time_spec_t get_time() { return gettime_functor(); }
     void set_time(const uhd::time_spec_t& t) { settime_functor(t); }
 
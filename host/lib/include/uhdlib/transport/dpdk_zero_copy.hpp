@@ -0,0 +1,87 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_DPDK_ZERO_COPY_HPP
+#define INCLUDED_DPDK_ZERO_COPY_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/transport/zero_copy.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <string>
+
+namespace uhd { namespace transport {
+
+/*!
+ * Handle for the global uhd-dpdk context (EAL, ports, I/O threads).
+ * The context is initialized once per process from the first set of
+ * device args containing DPDK keys; subsequent init() calls are no-ops.
+ */
+class uhd_dpdk_ctx : boost::noncopyable {
+public:
+    typedef boost::shared_ptr<uhd_dpdk_ctx> sptr;
+
+    ~uhd_dpdk_ctx(void);
+
+    //! Return the global context handle (creating it if needed)
+    static sptr get(void);
+
+    /*!
+     * Initialize the DPDK environment from user args.
+     * Recognized keys: dpdk_corelist, dpdk_num_mbufs, dpdk_mbuf_cache_size,
+     * dpdk_mtu. Does nothing if the context is already up.
+     */
+    void init(const uhd::device_addr_t &user_args);
+
+    //! Whether init() has completed successfully
+    bool is_init_done(void) const;
+
+    /*!
+     * Find the DPDK port on the same IPv4 subnet as the given address.
+     * \return port ID, or -1 when no port can route to the address
+     */
+    int get_route(const std::string &addr) const;
+
+    //! Number of DPDK-managed network ports
+    size_t get_port_count(void) const;
+
+    //! Dotted IPv4 address of a DPDK-managed port (empty on failure)
+    std::string get_ipv4_addr(const unsigned int port_id) const;
+
+private:
+    uhd_dpdk_ctx(void);
+};
+
+/*!
+ * A zero copy transport for UDP-over-DPDK:
+ * CHDR packets move between the NIC and the caller via DPDK packet
+ * buffers without ever entering the kernel network stack.
+ */
+class dpdk_zero_copy : public virtual zero_copy_if {
+public:
+    typedef boost::shared_ptr<dpdk_zero_copy> sptr;
+
+    static sptr make(
+        const uhd_dpdk_ctx &ctx,
+        const unsigned int dpdk_port_id,
+        const std::string &addr,
+        const std::string &remote_port,
+        const std::string &local_port, //0 for auto-assign
+        const zero_copy_xport_params &default_buff_args,
+        const uhd::device_addr_t &hints
+    );
+
+    //! Local UDP port, host byte order
+    virtual uint16_t get_local_port(void) const = 0;
+
+    //! Packets dropped by the DPDK socket due to a full receive ring
+    virtual uint32_t get_drop_count(void) const = 0;
+};
+
+}} //namespace uhd::transport
+
+#endif /* INCLUDED_DPDK_ZERO_COPY_HPP */
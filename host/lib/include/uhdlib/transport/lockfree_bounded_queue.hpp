@@ -0,0 +1,146 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_TRANSPORT_LOCKFREE_BOUNDED_QUEUE_HPP
+#define INCLUDED_UHDLIB_TRANSPORT_LOCKFREE_BOUNDED_QUEUE_HPP
+
+#include <uhd/config.hpp>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstddef>
+
+namespace uhd{ namespace transport{
+
+/*!
+ * A bounded lock-free queue of messages.
+ *
+ * This is the classic bounded multi-producer/multi-consumer ring with
+ * one sequence counter per slot: a producer claims a slot with a
+ * single compare-and-swap and never takes a lock, so pushing from a
+ * fastpath costs nanoseconds and cannot block behind a slow or absent
+ * consumer. Unlike bounded_buffer there is no condition variable; the
+ * timed pop polls with a short sleep, which is acceptable for
+ * low-rate message traffic such as TX async metadata.
+ *
+ * The element type must be copyable; elements are stored by value.
+ */
+template <typename elem_type>
+class lockfree_bounded_queue{
+public:
+    /*!
+     * Create a new queue.
+     * \param capacity the minimum capacity, rounded up to a power of 2
+     */
+    lockfree_bounded_queue(const size_t capacity):
+        _mask(round_up_to_power_of_2(capacity) - 1),
+        _slots(_mask + 1),
+        _enqueue_pos(0),
+        _dequeue_pos(0)
+    {
+        for (size_t i = 0; i < _slots.size(); i++){
+            _slots[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    //! Push an element; returns false when the queue is full
+    bool push(const elem_type &elem){
+        slot_type *slot;
+        size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+        while (true){
+            slot = &_slots[pos & _mask];
+            const size_t seq = slot->seq.load(std::memory_order_acquire);
+            const ptrdiff_t diff = ptrdiff_t(seq) - ptrdiff_t(pos);
+            if (diff == 0){
+                if (_enqueue_pos.compare_exchange_weak(
+                    pos, pos + 1, std::memory_order_relaxed)) break;
+            }
+            else if (diff < 0) return false; //full
+            else pos = _enqueue_pos.load(std::memory_order_relaxed);
+        }
+        slot->elem = elem;
+        slot->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    //! Push an element, popping the oldest to make space when full
+    void push_with_pop_on_full(const elem_type &elem){
+        while (not this->push(elem)){
+            elem_type trash;
+            this->pop(trash);
+        }
+    }
+
+    //! Pop an element; returns false when the queue is empty
+    bool pop(elem_type &elem){
+        slot_type *slot;
+        size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+        while (true){
+            slot = &_slots[pos & _mask];
+            const size_t seq = slot->seq.load(std::memory_order_acquire);
+            const ptrdiff_t diff = ptrdiff_t(seq) - ptrdiff_t(pos + 1);
+            if (diff == 0){
+                if (_dequeue_pos.compare_exchange_weak(
+                    pos, pos + 1, std::memory_order_relaxed)) break;
+            }
+            else if (diff < 0) return false; //empty
+            else pos = _dequeue_pos.load(std::memory_order_relaxed);
+        }
+        elem = slot->elem;
+        slot->seq.store(pos + _mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    //! Drain every pending element into the back of a vector
+    size_t pop_all(std::vector<elem_type> &elems){
+        size_t count = 0;
+        elem_type elem;
+        while (this->pop(elem)){
+            elems.push_back(elem);
+            count++;
+        }
+        return count;
+    }
+
+    /*!
+     * Pop an element, polling until the timeout expires.
+     * An empty queue is detected with a single atomic load,
+     * so a zero-timeout poll returns almost immediately.
+     */
+    bool pop_with_timed_wait(elem_type &elem, const double timeout){
+        if (this->pop(elem)) return true;
+        const std::chrono::steady_clock::time_point exit_time =
+            std::chrono::steady_clock::now()
+            + std::chrono::microseconds(long(timeout*1e6));
+        while (std::chrono::steady_clock::now() < exit_time){
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            if (this->pop(elem)) return true;
+        }
+        return this->pop(elem);
+    }
+
+private:
+    struct slot_type{
+        std::atomic<size_t> seq;
+        elem_type elem;
+    };
+
+    static size_t round_up_to_power_of_2(const size_t in){
+        size_t out = 1;
+        while (out < in) out *= 2;
+        return out;
+    }
+
+    const size_t _mask;
+    std::vector<slot_type> _slots;
+    std::atomic<size_t> _enqueue_pos;
+    std::atomic<size_t> _dequeue_pos;
+};
+
+}} //namespace uhd::transport
+
+#endif /* INCLUDED_UHDLIB_TRANSPORT_LOCKFREE_BOUNDED_QUEUE_HPP */
@@ -16,12 +16,21 @@
 #include <uhd/utils/byteswap.hpp>
 #include <boost/thread.hpp>
 #include <boost/enable_shared_from_this.hpp>
-#include <queue>
-#include <map>
+#include <atomic>
+#include <vector>
 #include <stdint.h>
 
 namespace uhd{ namespace usrp{
 
+    /*!
+     * Demuxes a single transport into per-SID streams without a lock on
+     * the packet path. Each SID gets a fixed-depth single-producer
+     * single-consumer ring; whichever streaming thread wins the try-lock
+     * on the transport classifies packets inline, keeps its own and hands
+     * foreign ones off through the rings, while the other threads spin on
+     * their ring waiting for the hand-off. With one thread per channel
+     * this keeps multi-channel receive off a shared mutex entirely.
+     */
     struct recv_packet_demuxer_3000 : boost::enable_shared_from_this<recv_packet_demuxer_3000>
     {
         typedef boost::shared_ptr<recv_packet_demuxer_3000> sptr;
@@ -30,78 +39,156 @@ namespace uhd{ namespace usrp{
             return sptr(new recv_packet_demuxer_3000(xport));
         }
 
-        recv_packet_demuxer_3000(transport::zero_copy_if::sptr xport):
-            _xport(xport)
-        {/*NOP*/}
+        //! Depth of the per-SID hand-off rings; must be a power of two
+        static const size_t RING_DEPTH = 64;
 
-        transport::managed_recv_buffer::sptr get_recv_buff(const uint32_t sid, const double timeout)
+        /*!
+         * Single-producer single-consumer ring for one SID. The consumer
+         * is the thread streaming this SID; producers are serialized by
+         * _xport_mutex, so release/acquire on the indices is all the
+         * synchronization the slots need.
+         */
+        struct sid_ring_t
         {
-            const time_spec_t exit_time =
-                time_spec_t(timeout) + uhd::get_system_time();
-            transport::managed_recv_buffer::sptr buff;
-            buff = _internal_get_recv_buff(sid, timeout);
-            while (not buff) //loop until timeout
+            sid_ring_t(const uint32_t sid_): sid(sid_), _head(0), _tail(0) {}
+
+            bool push(transport::managed_recv_buffer::sptr &buff)
             {
-                const time_spec_t delta = exit_time - uhd::get_system_time();
-                const double new_timeout = delta.get_real_secs();
-                if (new_timeout < 0.0) break;
-                buff = _internal_get_recv_buff(sid, new_timeout);
+                const size_t tail = _tail.load(std::memory_order_relaxed);
+                if (tail - _head.load(std::memory_order_acquire) >= RING_DEPTH) return false;
+                _slots[tail & (RING_DEPTH-1)].swap(buff);
+                _tail.store(tail + 1, std::memory_order_release);
+                return true;
+            }
+
+            bool pop(transport::managed_recv_buffer::sptr &buff)
+            {
+                const size_t head = _head.load(std::memory_order_relaxed);
+                if (head == _tail.load(std::memory_order_acquire)) return false;
+                buff.swap(_slots[head & (RING_DEPTH-1)]);
+                _head.store(head + 1, std::memory_order_release);
+                return true;
             }
-            return buff;
-        }
 
-        transport::managed_recv_buffer::sptr _internal_get_recv_buff(const uint32_t sid, const double timeout)
+            //! Only safe while the SID has no active consumer thread
+            void clear(void)
+            {
+                transport::managed_recv_buffer::sptr buff;
+                while (pop(buff)) buff.reset();
+            }
+
+            const uint32_t sid;
+        private:
+            std::atomic<size_t> _head;
+            std::atomic<size_t> _tail;
+            transport::managed_recv_buffer::sptr _slots[RING_DEPTH];
+        };
+
+        typedef std::vector<boost::shared_ptr<sid_ring_t> > channel_list_t;
+
+        recv_packet_demuxer_3000(transport::zero_copy_if::sptr xport):
+            _xport(xport), _channels(new channel_list_t())
+        {/*NOP*/}
+
+        transport::managed_recv_buffer::sptr get_recv_buff(const uint32_t sid, const double timeout)
         {
             transport::managed_recv_buffer::sptr buff;
+            boost::shared_ptr<sid_ring_t> ring = get_ring(sid);
+            if (ring->pop(buff)) return buff;
 
-            //----------------------------------------------------------
-            //-- Check the queue to see if we already have a buffer
-            //----------------------------------------------------------
+            const time_spec_t exit_time =
+                time_spec_t(timeout) + uhd::get_system_time();
+            while (true)
             {
-                boost::mutex::scoped_lock l(mutex);
-                queue_type_t &queue = _queues[sid];
-                if (not queue.empty())
+                //one thread at a time classifies packets from the transport,
+                //the others spin on their ring waiting for a hand-off
+                if (_xport_mutex.try_lock())
                 {
-                    buff = queue.front();
-                    queue.front().reset();
-                    queue.pop();
-                    return buff;
+                    boost::mutex::scoped_lock l(_xport_mutex, boost::adopt_lock);
+                    if (ring->pop(buff)) return buff; //handed off while taking the lock
+                    const time_spec_t delta = exit_time - uhd::get_system_time();
+                    const double new_timeout = delta.get_real_secs();
+                    if (new_timeout < 0.0) return buff; //timeout
+                    buff = _xport->get_recv_buff(new_timeout);
+                    if (not buff) return buff; //timeout
+                    const uint32_t new_sid = uhd::wtohx(buff->cast<const uint32_t *>()[1]);
+                    if (new_sid == sid) return buff; //got expected packet
+                    this->hand_off(new_sid, buff);
+                    buff.reset();
                 }
-            }
-            {
-                buff = _xport->get_recv_buff(timeout);
-                if (buff)
+                else
                 {
-                    const uint32_t new_sid = uhd::wtohx(buff->cast<const uint32_t *>()[1]);
-                    if (new_sid != sid)
-                    {
-                        boost::mutex::scoped_lock l(mutex);
-                        if (_queues.count(new_sid) == 0) UHD_LOGGER_ERROR("STREAMER")
-                            << "recv packet demuxer unexpected sid 0x" << std::hex << new_sid << std::dec
-                            ;
-                        else _queues[new_sid].push(buff);
-                        buff.reset();
-                    }
+                    if (ring->pop(buff)) return buff;
+                    if (uhd::get_system_time() > exit_time) return buff; //timeout
+                    boost::this_thread::yield();
                 }
             }
-            return buff;
         }
 
         void realloc_sid(const uint32_t sid)
         {
-            boost::mutex::scoped_lock l(mutex);
-            while(not _queues[sid].empty()) //allocated and clears if already allocated
+            get_ring(sid)->clear(); //allocates and clears if already allocated
+        }
+
+        transport::zero_copy_if::sptr make_proxy(const uint32_t sid);
+
+        //! Find the ring for a SID in the current channel list
+        boost::shared_ptr<sid_ring_t> find_ring(const uint32_t sid)
+        {
+            boost::shared_ptr<const channel_list_t> channels = boost::atomic_load(&_channels);
+            for (size_t i = 0; i < channels->size(); i++)
             {
-                _queues[sid].pop();
+                if ((*channels)[i]->sid == sid) return (*channels)[i];
             }
+            return boost::shared_ptr<sid_ring_t>();
         }
 
-        transport::zero_copy_if::sptr make_proxy(const uint32_t sid);
+        //! Find the ring for a SID, allocating it on first use
+        boost::shared_ptr<sid_ring_t> get_ring(const uint32_t sid)
+        {
+            boost::shared_ptr<sid_ring_t> ring = find_ring(sid);
+            if (ring) return ring;
+            boost::mutex::scoped_lock l(_setup_mutex);
+            ring = find_ring(sid); //lost the setup race?
+            if (ring) return ring;
+            //swap in a copy so hot-path readers never see a resize
+            boost::shared_ptr<const channel_list_t> channels = boost::atomic_load(&_channels);
+            boost::shared_ptr<channel_list_t> new_channels(new channel_list_t(*channels));
+            ring.reset(new sid_ring_t(sid));
+            new_channels->push_back(ring);
+            boost::atomic_store(&_channels, boost::shared_ptr<const channel_list_t>(new_channels));
+            return ring;
+        }
+
+        //! Give a foreign packet to the ring of its SID
+        void hand_off(const uint32_t new_sid, transport::managed_recv_buffer::sptr &buff)
+        {
+            boost::shared_ptr<sid_ring_t> ring = find_ring(new_sid);
+            if (not ring)
+            {
+                UHD_LOGGER_ERROR("STREAMER")
+                    << "recv packet demuxer unexpected sid 0x" << std::hex << new_sid << std::dec
+                    ;
+                return;
+            }
+            //bounded retry: the consumer normally drains long before this
+            for (size_t i = 0; not ring->push(buff); i++)
+            {
+                if (i > 1000)
+                {
+                    UHD_LOGGER_ERROR("STREAMER")
+                        << "recv packet demuxer dropped a packet for sid 0x" << std::hex << new_sid << std::dec
+                        ;
+                    return;
+                }
+                boost::this_thread::yield();
+            }
+        }
 
-        typedef std::queue<transport::managed_recv_buffer::sptr> queue_type_t;
-        std::map<uint32_t, queue_type_t> _queues;
         transport::zero_copy_if::sptr _xport;
-        boost::mutex mutex;
+        boost::shared_ptr<const channel_list_t> _channels;
+        boost::mutex _setup_mutex;
+        boost::mutex _xport_mutex;
     };
 
     struct recv_packet_demuxer_proxy_3000 : transport::zero_copy_if
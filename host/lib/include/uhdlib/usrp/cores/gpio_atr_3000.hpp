@@ -12,6 +12,7 @@
 #include <uhd/usrp/dboard_iface.hpp>
 #include <uhd/usrp/gpio_defs.hpp>
 #include <uhdlib/usrp/gpio_defs.hpp>
+#include <uhd/types/time_spec.hpp>
 #include <uhd/types/wb_iface.hpp>
 #include <boost/shared_ptr.hpp>
 
@@ -95,6 +96,55 @@ public:
      * \param value the value to write to the attribute
      */
     virtual void set_gpio_attr(const gpio_attr_t attr, const uint32_t value) = 0;
+
+    /*!
+     * A complete ATR state table for bulk programming.
+     * Each entry has a value and a mask; entries with a zero mask are
+     * left untouched. The mode entry follows the GPIO_CTRL convention
+     * (1 = driven by the ATR state machine, 0 = static GPIO) and the
+     * DDR entry follows GPIO_DDR (1 = output, 0 = input).
+     */
+    struct atr_config_t {
+        atr_config_t(void):
+            idle_value(0), idle_mask(0),
+            rx_value(0), rx_mask(0),
+            tx_value(0), tx_mask(0),
+            fdx_value(0), fdx_mask(0),
+            atr_mode_value(0), atr_mode_mask(0),
+            ddr_value(0), ddr_mask(0)
+        {}
+        uint32_t idle_value, idle_mask;
+        uint32_t rx_value, rx_mask;
+        uint32_t tx_value, tx_mask;
+        uint32_t fdx_value, fdx_mask;
+        uint32_t atr_mode_value, atr_mode_mask;
+        uint32_t ddr_value, ddr_mask;
+    };
+
+    /*!
+     * Apply a full ATR configuration as one coalesced burst.
+     * All shadow registers are updated first and the changed registers
+     * are then flushed back-to-back, so reprogramming a complete state
+     * table costs one uninterrupted run of writes instead of a
+     * poke-per-setting round trip.
+     *
+     * \param config the state table to apply (zero-mask entries are skipped)
+     */
+    virtual void set_atr_config(const atr_config_t &config) = 0;
+
+    /*!
+     * Timed variant of set_atr_config().
+     * The writes are stamped with the given command time so the GPIO
+     * reconfiguration can ride the same command-FIFO batch as other
+     * timed commands (tunes, gain changes). The previous command time
+     * is restored afterwards.
+     *
+     * \param config the state table to apply (zero-mask entries are skipped)
+     * \param time the command time to apply the configuration at
+     * \throws uhd::not_implemented_error when the underlying control
+     *         interface cannot timestamp writes
+     */
+    virtual void set_atr_config(const atr_config_t &config, const time_spec_t &time) = 0;
 };
 
 class db_gpio_atr_3000 {
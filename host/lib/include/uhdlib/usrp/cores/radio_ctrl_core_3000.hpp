@@ -41,6 +41,30 @@ public:
     //! Push a response externall (resp_xport is NULL)
     virtual void push_response(const uint32_t *buff) = 0;
 
+    //! Command latency distribution measured through the response path
+    struct latency_stats_t
+    {
+        double min_latency;  //!< shortest observed round trip (seconds)
+        double max_latency;  //!< longest observed round trip (seconds)
+        double mean_latency; //!< average round trip (seconds)
+        double jitter;       //!< standard deviation of the round trips (seconds)
+        double safe_margin;  //!< derived lead time for timed commands (seconds)
+    };
+
+    /*!
+     * Measure the host-to-device command delivery latency.
+     * Issues a batch of no-op readback commands at staggered times and
+     * times each acknowledgment through the response path. The derived
+     * safe margin is cached and reported by get_command_margin().
+     * Cannot run while a command time is set: acks for timed commands
+     * return at execution time, not at delivery time.
+     */
+    virtual latency_stats_t measure_command_latency(const size_t num_samples = 32) = 0;
+
+    //! Get the calibrated safe lead time for timed commands.
+    //! Reports a conservative default until measure_command_latency() runs.
+    virtual double get_command_margin(void) = 0;
+
     //! Set the command time that will activate
     virtual void set_time(const uhd::time_spec_t &time) = 0;
 
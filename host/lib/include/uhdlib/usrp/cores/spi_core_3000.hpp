@@ -13,6 +13,7 @@
 #include <boost/utility.hpp>
 #include <boost/shared_ptr.hpp>
 #include <uhd/types/wb_iface.hpp>
+#include <vector>
 
 class spi_core_3000 : boost::noncopyable, public uhd::spi_iface
 {
@@ -27,6 +28,34 @@ public:
     //! Set the spi clock divider to something usable
     virtual void set_divider(const double div) = 0;
 
+    //! One entry in a batched run of SPI transactions
+    struct spi_batch_entry_t {
+        spi_batch_entry_t(void): which_slave(0), data(0), num_bits(0) {}
+        spi_batch_entry_t(
+            const int which_slave_,
+            const uhd::spi_config_t &config_,
+            const uint32_t data_,
+            const size_t num_bits_
+        ): which_slave(which_slave_), config(config_), data(data_), num_bits(num_bits_) {}
+        int which_slave;
+        uhd::spi_config_t config;
+        uint32_t data;
+        size_t num_bits;
+    };
+
+    /*!
+     * Stream a list of SPI transactions into the core back-to-back.
+     * The writes for all entries are posted in one run with no
+     * readback in between; a single readback at the end waits for the
+     * whole run to complete. Long peripheral programming sequences
+     * (dboard LO register loads) thus pay one control round trip
+     * instead of one per transfer.
+     *
+     * \param entries the transactions to perform, in order
+     * \return the readback data of the last transaction
+     */
+    virtual uint32_t transact_spi_batch(const std::vector<spi_batch_entry_t> &entries) = 0;
+
     //! Place SPI core in shutdown mode. All attempted SPI transactions are dropped by
     //  the core.
     virtual void set_shutdown(const bool shutdown) = 0;
@@ -0,0 +1,59 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_UTILS_ALLOC_GUARD_HPP
+#define INCLUDED_UHDLIB_UTILS_ALLOC_GUARD_HPP
+
+/*! \file alloc_guard.hpp
+ *
+ * Scoped allocation assert for realtime fast paths.
+ *
+ * The streaming threads typically run with realtime priority (see
+ * uhd::set_thread_priority), where a heap allocation can stall behind
+ * the allocator lock held by a lower-priority thread. The packet
+ * handlers are written to stop allocating after their first call;
+ * building with -DENABLE_ALLOC_ASSERT=ON verifies that claim: any
+ * heap allocation on a thread while a scoped_alloc_guard is armed
+ * prints a diagnostic and aborts, so the backtrace points straight at
+ * the offending allocation site. Note that error paths which log
+ * (e.g. alignment failures) do allocate and will trip the assert --
+ * that is deliberate, since they stall the realtime thread just the
+ * same. In a regular build the guard compiles to nothing.
+ */
+
+namespace uhd{
+
+#ifdef UHD_ALLOC_ASSERT
+
+    //implemented in lib/utils/alloc_guard.cpp
+    void alloc_guard_arm(void);
+    void alloc_guard_disarm(void);
+
+    //! Asserts that this thread does not allocate while in scope
+    class scoped_alloc_guard{
+    public:
+        scoped_alloc_guard(const bool armed): _armed(armed){
+            if (_armed) alloc_guard_arm();
+        }
+        ~scoped_alloc_guard(void){
+            if (_armed) alloc_guard_disarm();
+        }
+    private:
+        const bool _armed;
+    };
+
+#else
+
+    class scoped_alloc_guard{
+    public:
+        scoped_alloc_guard(const bool){}
+    };
+
+#endif /* UHD_ALLOC_ASSERT */
+
+} //namespace uhd
+
+#endif /* INCLUDED_UHDLIB_UTILS_ALLOC_GUARD_HPP */
@@ -0,0 +1,43 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_UTILS_COMPAT_CACHE_HPP
+#define INCLUDED_UHDLIB_UTILS_COMPAT_CACHE_HPP
+
+#include <string>
+
+namespace uhd{ namespace compat_cache{
+
+/*! Persistent cache of passed compatibility verifications.
+ *
+ * A compatibility check against an unchanged device cannot produce a
+ * new result, yet it costs a round trip on every make(). Device types
+ * whose check rides on a slow path (e.g. the mpmd RPC link) record a
+ * fingerprint of everything the check depends on here after it passes,
+ * and skip the round trip on the next session while the entry is
+ * fresh. Any change to the fingerprint - new FPGA image, new software
+ * version on either end - misses the cache and re-verifies.
+ *
+ * The cache lives in the per-user application data directory next to
+ * the other UHD caches and is only ever a hint: errors reading or
+ * writing it degrade to the uncached behavior.
+ */
+
+/*! True when \p fingerprint was recorded for \p serial within the last
+ * \p max_age_secs seconds.
+ */
+bool is_fresh(
+    const std::string &serial,
+    const std::string &fingerprint,
+    const double max_age_secs
+);
+
+//! Record that \p fingerprint passed verification for \p serial just now
+void store(const std::string &serial, const std::string &fingerprint);
+
+}} //namespace uhd::compat_cache
+
+#endif /* INCLUDED_UHDLIB_UTILS_COMPAT_CACHE_HPP */
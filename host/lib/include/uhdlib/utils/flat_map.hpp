@@ -0,0 +1,143 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_UTILS_FLAT_MAP_HPP
+#define INCLUDED_UHDLIB_UTILS_FLAT_MAP_HPP
+
+#include <uhd/exception.hpp>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace uhd {
+
+/*! An open-addressing hash map for hot-path lookups.
+ *
+ * uhd::dict stores key/value pairs in a linked list and compares every
+ * key on lookup, which is fine for a handful of entries but shows up in
+ * profiles when the map sits on a hot path (e.g. the converter registry,
+ * which is queried by id on every streamer setup). flat_map keeps its
+ * entries in one contiguous table and probes linearly from the hashed
+ * slot, so a successful lookup usually costs one hash and one compare.
+ *
+ * The interface intentionally mirrors the subset of uhd::dict that the
+ * call sites use (operator[], has_key, get, keys, size). Entries cannot
+ * be removed; the registries this is written for only ever grow.
+ *
+ * \tparam Key the key type, must be equality-comparable
+ * \tparam Val the value type, must be default-constructible
+ * \tparam Hash hash functor for Key, defaults to std::hash
+ */
+template <typename Key, typename Val, typename Hash = std::hash<Key> >
+class flat_map
+{
+public:
+    flat_map(void) : _table(INITIAL_SIZE), _size(0)
+    {
+        /* NOP */
+    }
+
+    //! Returns the number of elements in this map
+    std::size_t size(void) const
+    {
+        return _size;
+    }
+
+    //! True if the key is stored in this map
+    bool has_key(const Key& key) const
+    {
+        return _table[this->find_slot(key)].used;
+    }
+
+    /*! Get a value for the given key if it exists in this map.
+     * \throws uhd::key_error if the key is not found
+     */
+    const Val& get(const Key& key) const
+    {
+        const entry_type& entry = _table[this->find_slot(key)];
+        if (not entry.used) {
+            throw uhd::key_error("flat_map key not found");
+        }
+        return entry.val;
+    }
+
+    /*! Access a value for the given key.
+     * The key is inserted with a default-constructed value when missing.
+     */
+    Val& operator[](const Key& key)
+    {
+        std::size_t slot = this->find_slot(key);
+        if (not _table[slot].used) {
+            // Grow before the table fills up so probe chains stay short
+            if (2 * (_size + 1) > _table.size()) {
+                this->grow();
+                slot = this->find_slot(key);
+            }
+            _table[slot].used = true;
+            _table[slot].key  = key;
+            _size++;
+        }
+        return _table[slot].val;
+    }
+
+    //! Get a list of the keys in this map, in insertion-independent order
+    std::vector<Key> keys(void) const
+    {
+        std::vector<Key> keys;
+        keys.reserve(_size);
+        for (const entry_type& entry : _table) {
+            if (entry.used) {
+                keys.push_back(entry.key);
+            }
+        }
+        return keys;
+    }
+
+private:
+    // Power of two, so the probe sequence can mask instead of modulo
+    static const std::size_t INITIAL_SIZE = 16;
+
+    struct entry_type
+    {
+        entry_type(void) : used(false)
+        {
+            /* NOP */
+        }
+        bool used;
+        Key key;
+        Val val;
+    };
+
+    //! Probe from the hashed slot to the key's entry or the first free slot
+    std::size_t find_slot(const Key& key) const
+    {
+        const std::size_t mask = _table.size() - 1;
+        std::size_t slot       = Hash()(key) & mask;
+        while (_table[slot].used and not(_table[slot].key == key)) {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    //! Double the table and re-insert every entry under the new mask
+    void grow(void)
+    {
+        std::vector<entry_type> old_table(2 * _table.size());
+        old_table.swap(_table);
+        for (entry_type& entry : old_table) {
+            if (entry.used) {
+                _table[this->find_slot(entry.key)] = entry;
+            }
+        }
+    }
+
+    std::vector<entry_type> _table;
+    std::size_t _size;
+};
+
+} /* namespace uhd */
+
+#endif /* INCLUDED_UHDLIB_UTILS_FLAT_MAP_HPP */
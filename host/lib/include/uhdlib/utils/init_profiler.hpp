@@ -0,0 +1,96 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_UTILS_INIT_PROFILER_HPP
+#define INCLUDED_UHDLIB_UTILS_INIT_PROFILER_HPP
+
+#include <uhd/config.hpp>
+#include <boost/noncopyable.hpp>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace uhd {
+
+/*! Phase timer for device initialization.
+ *
+ * Device construction spans discovery, claiming, EEPROM readout,
+ * firmware checks, block enumeration and tree population, and a
+ * cold-start regression can hide in any of them. An init_profiler
+ * instance times the phases of one initialization and writes a
+ * structured breakdown (per-phase milliseconds and share of the total)
+ * to the logger when it is finished or destroyed.
+ *
+ * Long linear init routines call enter_phase() at each stage boundary,
+ * which closes the previous phase; bracketed sections can use the RAII
+ * scoped_phase instead. Instances are not thread safe: concurrent
+ * per-motherboard setups each use their own profiler.
+ */
+class init_profiler : boost::noncopyable
+{
+public:
+    //! One timed initialization phase
+    struct phase_type
+    {
+        phase_type(void): elapsed(0.0) {}
+        std::string name;
+        double elapsed; //seconds
+    };
+
+    //! \param context prefix for the report, e.g. "X300 mb0"
+    init_profiler(const std::string &context);
+
+    //! Reports on destruction when finish() was not called
+    ~init_profiler(void);
+
+    //! Close the running phase (if any) and start a new one
+    void enter_phase(const std::string &name);
+
+    //! Close the running phase without starting another
+    void leave_phase(void);
+
+    //! Close the running phase and write the breakdown to the log
+    void finish(void);
+
+    //! Structured access to the phases recorded so far
+    const std::vector<phase_type> &get_phases(void) const
+    {
+        return _phases;
+    }
+
+    //! Total wall time covered by the recorded phases in seconds
+    double get_total(void) const;
+
+    //! RAII marker accounting its lifetime to one phase
+    class scoped_phase : boost::noncopyable
+    {
+    public:
+        scoped_phase(init_profiler &profiler, const std::string &name):
+            _profiler(profiler)
+        {
+            _profiler.enter_phase(name);
+        }
+        ~scoped_phase(void)
+        {
+            _profiler.leave_phase();
+        }
+    private:
+        init_profiler &_profiler;
+    };
+
+private:
+    typedef std::chrono::steady_clock clock_type;
+
+    const std::string _context;
+    std::vector<phase_type> _phases;
+    clock_type::time_point _phase_start;
+    bool _phase_open;
+    bool _reported;
+};
+
+} //namespace uhd
+
+#endif /* INCLUDED_UHDLIB_UTILS_INIT_PROFILER_HPP */
@@ -12,6 +12,7 @@
 #include <uhd/utils/log.hpp>
 #include <uhd/exception.hpp>
 #include <boost/format.hpp>
+#include <future>
 
 namespace uhd {
 
@@ -119,6 +120,73 @@ class rpc_client
         }
     };
 
+    /*! Handle to the in-flight response of an async_request().
+     *
+     * get() blocks until the response arrives, converts it to the
+     * requested type and applies the same error handling as request().
+     * The handle must not outlive the rpc_client that produced it.
+     */
+    template <typename return_type>
+    class async_response
+    {
+      public:
+        async_response(
+                rpc_client *client,
+                const std::string &func_name,
+                std::future<RPCLIB_MSGPACK::object_handle> &&response
+        ) : _client(client)
+          , _func_name(func_name)
+          , _response(std::move(response))
+        {
+            // nop
+        }
+
+        //! Block until the response arrives and return the result
+        return_type get()
+        {
+            return _client->template _wait_for_response<return_type>(
+                _response, _func_name);
+        }
+
+      private:
+        rpc_client *_client;
+        std::string _func_name;
+        std::future<RPCLIB_MSGPACK::object_handle> _response;
+    };
+
+    /*! Perform a pipelined RPC request.
+     *
+     * Thread safe (locked). Unlike request(), this only posts the call and
+     * returns immediately; the response is collected by calling get() on the
+     * returned handle. Posting several requests before collecting their
+     * responses overlaps the round trips to the server, so a burst of n
+     * queries costs roughly one RTT instead of n.
+     *
+     * \param func_name The function name that is called via RPC
+     * \param args All these arguments are passed to the RPC call
+     */
+    template <typename return_type, typename... Args>
+    async_response<return_type> async_request(
+            std::string const& func_name, Args&&... args
+    ) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return async_response<return_type>(this, func_name,
+            _client.async_call(func_name, std::forward<Args>(args)...));
+    };
+
+    /*! Like async_request(), also provides a token.
+     *
+     * This is a convenience wrapper to directly call a function that requires
+     * a token without having to have a copy of the token.
+     */
+    template <typename return_type, typename... Args>
+    async_response<return_type> async_request_with_token(
+            std::string const& func_name, Args&&... args
+    ) {
+        return async_request<return_type>(
+            func_name, _token, std::forward<Args>(args)...);
+    };
+
     /*! Like request(), also provides a token.
      *
      * This is a convenience wrapper to directly call a function that requires
@@ -154,6 +222,37 @@ class rpc_client
     }
 
   private:
+    template <typename return_type>
+    friend class async_response;
+
+    /*! Wait on a posted call and convert its response. Called by
+     * async_response::get(); applies the same error handling as request().
+     */
+    template <typename return_type>
+    return_type _wait_for_response(
+            std::future<RPCLIB_MSGPACK::object_handle> &response,
+            const std::string &func_name
+    ) {
+        try {
+            return response.get().template as<return_type>();
+        } catch (const ::rpc::rpc_error &ex) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            const std::string error = _get_last_error_safe();
+            if (not error.empty()) {
+                UHD_LOG_ERROR("RPC", error);
+            }
+            throw uhd::runtime_error(str(
+                boost::format("Error during RPC call to `%s'. Error message: %s")
+                % func_name % (error.empty() ? ex.what() : error)
+            ));
+        } catch (const std::bad_cast& ex) {
+            throw uhd::runtime_error(str(
+                boost::format("Error during RPC call to `%s'. Error message: %s")
+                % func_name % ex.what()
+            ));
+        }
+    }
+
      /*! Pull the last error out of the RPC server. Not thread-safe, meant to
       * be called from notify() or request().
       *
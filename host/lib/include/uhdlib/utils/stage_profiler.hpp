@@ -0,0 +1,128 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_UTILS_STAGE_PROFILER_HPP
+#define INCLUDED_UHDLIB_UTILS_STAGE_PROFILER_HPP
+
+/*! \file stage_profiler.hpp
+ *
+ * Compile-in cycle accounting for the streaming fastpath.
+ *
+ * When UHD is built with UHD_TXRX_STAGE_PROFILING defined, the super
+ * packet handlers timestamp the boundaries of each pipeline stage with
+ * the TSC and accumulate a power-of-two cycle histogram per stage. The
+ * histograms come back through stream_stats_t, so stage-level
+ * attribution of a throughput regression is available from a running
+ * production process without attaching an external profiler. Without
+ * the define, the probe macros compile to nothing.
+ *
+ * The accumulators are plain counters written only by the thread that
+ * owns the fast path (recv/send are single-threaded by contract); a
+ * monitoring thread reading them concurrently may see a histogram that
+ * is slightly torn, which is acceptable for trend analysis.
+ */
+
+#include <uhd/config.hpp>
+#include <uhd/stream.hpp>
+#include <stdint.h>
+#include <cstring>
+
+#ifdef UHD_TXRX_STAGE_PROFILING
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif !defined(__x86_64__) && !defined(__i386__)
+#include <chrono>
+#endif
+
+namespace uhd{ namespace transport{ namespace sph{
+
+class stage_profiler{
+public:
+    //! The instrumented pipeline stages, in stream_stats_t index order
+    enum stage_t{
+        STAGE_WAIT = 0,  //blocking on the transport for a buffer
+        STAGE_UNPACK,    //VRT header parse and packet bookkeeping
+        STAGE_CONVERT,   //sample format conversion
+        STAGE_METADATA,  //metadata assembly and fragment accounting
+        STAGE_RELEASE,   //committing or releasing transport buffers
+        NUM_STAGES
+    };
+
+    stage_profiler(void){
+        std::memset(_stages, 0, sizeof(_stages));
+    }
+
+    //! Read the cycle counter (falls back to the steady clock off-x86)
+    static UHD_INLINE uint64_t now(void){
+    #if defined(__x86_64__) || defined(__i386__)
+        uint32_t lo, hi;
+        __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+        return (uint64_t(hi) << 32) | lo;
+    #elif defined(_MSC_VER)
+        return __rdtsc();
+    #else
+        return uint64_t(
+            std::chrono::steady_clock::now().time_since_epoch().count());
+    #endif
+    }
+
+    //! Account now() - start cycles to the given stage
+    UHD_INLINE void accumulate(const stage_t stage, const uint64_t start){
+        const uint64_t cycles = now() - start;
+        stage_acc_type &acc = _stages[stage];
+        acc.total_cycles += cycles;
+        acc.num_calls++;
+        size_t bucket = 0;
+        for (uint64_t c = cycles >> 1;
+            c != 0 and bucket < uhd::stream_stats_t::NUM_PROFILER_BUCKETS-1;
+            c >>= 1) bucket++;
+        acc.buckets[bucket]++;
+    }
+
+    //! Merge the accumulated histograms into the public stats struct
+    void fill_stats(uhd::stream_stats_t &stats) const{
+        static_assert(
+            size_t(NUM_STAGES) == uhd::stream_stats_t::NUM_PROFILER_STAGES,
+            "stage enum does not match stream_stats_t");
+        for (size_t s = 0; s < NUM_STAGES; s++){
+            stats.stage_cycles[s].total_cycles += _stages[s].total_cycles;
+            stats.stage_cycles[s].num_calls += _stages[s].num_calls;
+            for (size_t b = 0; b < uhd::stream_stats_t::NUM_PROFILER_BUCKETS; b++){
+                stats.stage_cycles[s].buckets[b] += _stages[s].buckets[b];
+            }
+        }
+    }
+
+private:
+    struct stage_acc_type{
+        uint64_t total_cycles;
+        uint64_t num_calls;
+        uint64_t buckets[uhd::stream_stats_t::NUM_PROFILER_BUCKETS];
+    };
+    stage_acc_type _stages[NUM_STAGES];
+};
+
+}}} //namespace uhd::transport::sph
+
+//! Take a timestamp at a stage boundary
+#define UHD_STAGE_PROF_TS(name) \
+    const uint64_t name = ::uhd::transport::sph::stage_profiler::now()
+//! Account the cycles since \p start to \p stage
+#define UHD_STAGE_PROF_ACC(stage, start) \
+    _stage_profiler.accumulate(::uhd::transport::sph::stage_profiler::stage, start)
+//! Merge the handler's histograms into a stream_stats_t
+#define UHD_STAGE_PROF_FILL(stats) _stage_profiler.fill_stats(stats)
+
+#else //UHD_TXRX_STAGE_PROFILING
+
+#define UHD_STAGE_PROF_TS(name)
+#define UHD_STAGE_PROF_ACC(stage, start)
+#define UHD_STAGE_PROF_FILL(stats)
+
+#endif //UHD_TXRX_STAGE_PROFILING
+
+#endif /* INCLUDED_UHDLIB_UTILS_STAGE_PROFILER_HPP */
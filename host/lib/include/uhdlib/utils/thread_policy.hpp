@@ -0,0 +1,72 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_LIBUHD_UTILS_THREAD_POLICY_HPP
+#define INCLUDED_LIBUHD_UTILS_THREAD_POLICY_HPP
+
+#include <uhd/types/device_addr.hpp>
+#include <string>
+#include <vector>
+
+namespace uhd { namespace thread_policy {
+
+    /*! Scheduling policy for a named internal thread role.
+     *
+     * Internal threads (offload, usb events, tasks) call apply() with
+     * their role name when they start, so policies take effect at
+     * thread creation instead of racing it from outside the process.
+     */
+    struct policy_t {
+        //! When true, priority/realtime below are applied
+        bool has_priority;
+        //! Priority in [-1.0, 1.0], see uhd::set_thread_priority
+        float priority;
+        //! Request realtime (round-robin) scheduling
+        bool realtime;
+        //! Deadline reservation in seconds (see uhd::set_thread_deadline);
+        //! both > 0 requests SCHED_DEADLINE, which supersedes the static
+        //! priority; a rejected reservation falls back to the priority
+        double deadline_runtime;
+        double deadline_period;
+        //! CPUs to pin to; empty leaves the affinity untouched
+        std::vector<size_t> cpu_affinity;
+
+        policy_t(void);
+    };
+
+    /*! Set (or replace) the policy for a named thread role.
+     *
+     * Takes effect for threads created after this call; policies from
+     * the config file are loaded first, so explicit registrations and
+     * device args win over uhd.conf.
+     */
+    void register_policy(const std::string &role, const policy_t &policy);
+
+    /*! Register policies from device args.
+     *
+     * Recognized keys (dots separate CPU numbers, since commas delimit
+     * device args):
+     *  - thread_<role>_priority=<float in [-1.0, 1.0]>
+     *  - thread_<role>_realtime=<0|1>
+     *  - thread_<role>_deadline_runtime=<seconds>
+     *  - thread_<role>_deadline_period=<seconds>
+     *  - thread_<role>_affinity=<cpu>[.<cpu>...]
+     *
+     * The same keys (with commas allowed in the affinity list) are read
+     * from the [threads] section of uhd.conf on first use.
+     */
+    void register_policies_from_args(const uhd::device_addr_t &args);
+
+    /*! Apply the policy for a role to the calling thread.
+     *
+     * Roles without a configured policy are left untouched, so this is
+     * safe to call unconditionally from every internal thread.
+     */
+    void apply(const std::string &role);
+
+}} /* namespace uhd::thread_policy */
+
+#endif /* INCLUDED_LIBUHD_UTILS_THREAD_POLICY_HPP */
@@ -0,0 +1,40 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_UTILS_TRACEPOINTS_HPP
+#define INCLUDED_UHDLIB_UTILS_TRACEPOINTS_HPP
+
+/*! \file tracepoints.hpp
+ *
+ * Static tracepoints for the streaming fastpath.
+ *
+ * When UHD is configured with -DENABLE_USDT=ON, the UHD_TRACEPOINT*
+ * macros emit USDT (userspace statically defined tracing) probes under
+ * the "uhd" provider. A probe is a single nop instruction until a
+ * tracer (bpftrace, perf probe, systemtap, ...) attaches to it, so
+ * instrumented binaries can ship to production at no cost. Without the
+ * CMake option the macros compile to nothing, and the arguments are
+ * never evaluated.
+ *
+ * Example, histogram of committed send packet sizes:
+ *
+ *     bpftrace -e 'usdt:libuhd.so:uhd:send_commit { @ = hist(arg1); }'
+ */
+
+#ifdef UHD_USE_USDT_TRACEPOINTS
+#include <sys/sdt.h>
+#define UHD_TRACEPOINT(name)            DTRACE_PROBE(uhd, name)
+#define UHD_TRACEPOINT1(name, a)        DTRACE_PROBE1(uhd, name, a)
+#define UHD_TRACEPOINT2(name, a, b)     DTRACE_PROBE2(uhd, name, a, b)
+#define UHD_TRACEPOINT3(name, a, b, c)  DTRACE_PROBE3(uhd, name, a, b, c)
+#else
+#define UHD_TRACEPOINT(name)
+#define UHD_TRACEPOINT1(name, a)
+#define UHD_TRACEPOINT2(name, a, b)
+#define UHD_TRACEPOINT3(name, a, b, c)
+#endif
+
+#endif /* INCLUDED_UHDLIB_UTILS_TRACEPOINTS_HPP */
@@ -7,9 +7,14 @@
 
 #include <uhd/property_tree.hpp>
 #include <uhd/types/dict.hpp>
-#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/shared_mutex.hpp>
 #include <boost/make_shared.hpp>
+#include <algorithm>
+#include <deque>
 #include <iostream>
+#include <map>
+#include <stdint.h>
 
 using namespace uhd;
 
@@ -74,75 +79,166 @@ public:
 
     sptr subtree(const fs_path &path_) const{
         const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
+        boost::shared_lock<boost::shared_mutex> lock(_guts->mutex);
 
         property_tree_impl *subtree = new property_tree_impl(path);
         subtree->_guts = this->_guts; //copy the guts sptr
         return sptr(subtree);
     }
 
+    void register_lazy_subtree(const fs_path &path_, const populator_fcn_t &populator){
+        const fs_path path = _root / path_;
+        boost::unique_lock<boost::shared_mutex> lock(_guts->mutex);
+        _guts->populators[path] = populator;
+    }
+
+    void register_snapshot_backend(const fs_path &path_, const populator_fcn_t &backend){
+        const fs_path path = _root / path_;
+        boost::unique_lock<boost::shared_mutex> lock(_guts->mutex);
+        _guts->snapshot_backends[path] = backend;
+    }
+
+    std::vector<fs_path> snapshot(const fs_path &path_) const{
+        const fs_path path = _root / path_;
+        this->materialize(path); //the walk below must see lazily registered nodes
+
+        //run the bulk backends covering this path so the per-property
+        //reads that follow are served from a warm cache
+        std::vector<populator_fcn_t> backends;
+        {
+            boost::shared_lock<boost::shared_mutex> lock(_guts->mutex);
+            for(const std::string &reg_path:  _guts->snapshot_backends.keys()){
+                if (paths_overlap(fs_path(reg_path), path)){
+                    backends.push_back(_guts->snapshot_backends[reg_path]);
+                }
+            }
+        }
+        for(const populator_fcn_t &backend:  backends) backend();
+
+        boost::shared_lock<boost::shared_mutex> lock(_guts->mutex);
+        node_type *node = this->find_node(path);
+        if (node == NULL) throw_path_not_found(path);
+
+        std::vector<fs_path> paths;
+        collect_prop_paths(*node, path_, paths);
+        return paths;
+    }
+
     void remove(const fs_path &path_){
         const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
+        this->materialize(path);
+        boost::unique_lock<boost::shared_mutex> lock(_guts->mutex);
 
-        node_type *parent = NULL;
-        node_type *node = &_guts->root;
+        uint32_t parent = NODE_NPOS;
+        uint32_t index = 0; //the root
+        std::string leaf_name;
         for(const std::string &name:  path_tokenizer(path)){
-            if (not node->has_key(name)) throw_path_not_found(path);
-            parent = node;
-            node = &(*node)[name];
+            const uint32_t child = _guts->find_child(_guts->nodes[index], name);
+            if (child == NODE_NPOS) throw_path_not_found(path);
+            parent = index;
+            index = child;
+            leaf_name = name;
+        }
+        if (parent == NODE_NPOS) throw uhd::runtime_error("Cannot uproot");
+        //unlink from the parent only: the subtree's arena slots are not
+        //reclaimed, removal is rare and the arena dies with the tree
+        node_type &parent_node = _guts->nodes[parent];
+        const uint32_t segment = _guts->find_segment(leaf_name);
+        for (node_type::children_type::iterator it = parent_node.children.begin();
+             it != parent_node.children.end(); ++it){
+            if (it->first == segment){
+                parent_node.children.erase(it);
+                break;
+            }
         }
-        if (parent == NULL) throw uhd::runtime_error("Cannot uproot");
-        parent->pop(fs_path(path.leaf()));
     }
 
     bool exists(const fs_path &path_) const{
         const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
-
-        node_type *node = &_guts->root;
-        for(const std::string &name:  path_tokenizer(path)){
-            if (not node->has_key(name)) return false;
-            node = &(*node)[name];
+        {
+            boost::shared_lock<boost::shared_mutex> lock(_guts->mutex);
+            if (this->find_node(path) != NULL) return true;
         }
-        return true;
+        //the node may be provided by a lazy populator
+        if (not this->materialize(path)) return false;
+        boost::shared_lock<boost::shared_mutex> lock(_guts->mutex);
+        return this->find_node(path) != NULL;
     }
 
     std::vector<std::string> list(const fs_path &path_) const{
         const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
+        this->materialize(path); //a complete listing requires pending populators to run
+        boost::shared_lock<boost::shared_mutex> lock(_guts->mutex);
 
-        node_type *node = &_guts->root;
-        for(const std::string &name:  path_tokenizer(path)){
-            if (not node->has_key(name)) throw_path_not_found(path);
-            node = &(*node)[name];
-        }
+        node_type *node = this->find_node(path);
+        if (node == NULL) throw_path_not_found(path);
 
-        return node->keys();
+        std::vector<std::string> names;
+        names.reserve(node->children.size());
+        for (size_t i = 0; i < node->children.size(); i++){
+            names.push_back(_guts->segment_names[node->children[i].first]);
+        }
+        return names;
     }
 
     void _create(const fs_path &path_, const boost::shared_ptr<void> &prop){
         const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
+        boost::unique_lock<boost::shared_mutex> lock(_guts->mutex);
 
-        node_type *node = &_guts->root;
+        uint32_t index = 0; //the root
         for(const std::string &name:  path_tokenizer(path)){
-            if (not node->has_key(name)) (*node)[name] = node_type();
-            node = &(*node)[name];
+            uint32_t child = _guts->find_child(_guts->nodes[index], name);
+            if (child == NODE_NPOS){
+                const uint32_t segment = _guts->intern_segment(name);
+                _guts->nodes.push_back(node_type());
+                child = uint32_t(_guts->nodes.size() - 1);
+                _guts->nodes[index].children.push_back(
+                    std::make_pair(segment, child));
+            }
+            index = child;
         }
+        node_type *node = &_guts->nodes[index];
         if (node->prop.get() != NULL) throw uhd::runtime_error("Cannot create! Property already exists at: " + path);
         node->prop = prop;
     }
 
-    boost::shared_ptr<void> &_access(const fs_path &path_) const{
+    path_handle_t intern(const fs_path &path_){
         const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
+        {
+            boost::shared_lock<boost::shared_mutex> lock(_guts->mutex);
+            if (_guts->interned_ids.has_key(path)) return _guts->interned_ids[path];
+        }
+        //resolve once through the usual path walk (runs lazy populators)
+        boost::shared_ptr<void> &prop = this->_access(path_);
+        boost::unique_lock<boost::shared_mutex> lock(_guts->mutex);
+        if (_guts->interned_ids.has_key(path)) return _guts->interned_ids[path];
+        _guts->interned_props.push_back(prop);
+        const path_handle_t handle = _guts->interned_props.size() - 1;
+        _guts->interned_ids[path] = handle;
+        return handle;
+    }
 
-        node_type *node = &_guts->root;
-        for(const std::string &name:  path_tokenizer(path)){
-            if (not node->has_key(name)) throw_path_not_found(path);
-            node = &(*node)[name];
+    boost::shared_ptr<void> &_access(const path_handle_t handle) const{
+        boost::shared_lock<boost::shared_mutex> lock(_guts->mutex);
+        if (handle >= _guts->interned_props.size()){
+            throw uhd::lookup_error("Invalid interned property handle");
+        }
+        return _guts->interned_props[handle];
+    }
+
+    boost::shared_ptr<void> &_access(const fs_path &path_) const{
+        const fs_path path = _root / path_;
+        {
+            boost::shared_lock<boost::shared_mutex> lock(_guts->mutex);
+            node_type *node = this->find_node(path);
+            if (node != NULL and node->prop.get() != NULL) return node->prop;
         }
+        //the property may be provided by a lazy populator
+        this->materialize(path);
+        boost::shared_lock<boost::shared_mutex> lock(_guts->mutex);
+
+        node_type *node = this->find_node(path);
+        if (node == NULL) throw_path_not_found(path);
         if (node->prop.get() == NULL) throw uhd::runtime_error("Cannot access! Property uninitialized at: " + path);
         return node->prop;
     }
@@ -152,17 +248,140 @@ private:
         throw uhd::lookup_error("Path not found in tree: " + path);
     }
 
+    //!True when one path is a prefix of the other (token-wise)
+    static bool paths_overlap(const fs_path &lhs, const fs_path &rhs){
+        std::vector<std::string> lhs_names, rhs_names;
+        for(const std::string &name:  path_tokenizer(lhs)) lhs_names.push_back(name);
+        for(const std::string &name:  path_tokenizer(rhs)) rhs_names.push_back(name);
+        const size_t num_common = std::min(lhs_names.size(), rhs_names.size());
+        for (size_t i = 0; i < num_common; i++){
+            if (lhs_names[i] != rhs_names[i]) return false;
+        }
+        return true;
+    }
+
+    /*!
+     * Run pending populators whose subtree overlaps with the given path.
+     * Each populator is unregistered before it runs so it runs only once.
+     * Must be called without holding the guts mutex: the populators call
+     * back into create, which acquires the mutex itself.
+     * \return true when at least one populator was run
+     */
+    bool materialize(const fs_path &path) const{
+        //fast path: peek for pending work under the reader lock,
+        //so steady-state lookups never serialize on the writer lock
+        {
+            boost::shared_lock<boost::shared_mutex> lock(_guts->mutex);
+            bool pending = false;
+            for(const std::string &reg_path:  _guts->populators.keys()){
+                if (paths_overlap(fs_path(reg_path), path)){
+                    pending = true;
+                    break;
+                }
+            }
+            if (not pending) return false;
+        }
+        std::vector<populator_fcn_t> populators;
+        {
+            boost::unique_lock<boost::shared_mutex> lock(_guts->mutex);
+            for(const std::string &reg_path:  _guts->populators.keys()){
+                if (paths_overlap(fs_path(reg_path), path)){
+                    populators.push_back(_guts->populators.pop(reg_path));
+                }
+            }
+        }
+        for(const populator_fcn_t &populator:  populators) populator();
+        return not populators.empty();
+    }
+
+    //!Not-found marker for segment and node indexes
+    static const uint32_t NODE_NPOS = uint32_t(~0);
+
     //basic structural node element
-    struct node_type : uhd::dict<std::string, node_type>{
+    //children link to arena slots through interned segment ids, so a
+    //walk compares integers against compact pairs instead of chasing
+    //one heap-allocated string map per node
+    struct node_type{
+        typedef std::vector<std::pair<uint32_t, uint32_t> > children_type;
         boost::shared_ptr<void> prop;
+        children_type children; //(segment id, arena index), in insertion order
     };
 
+    //!Depth-first collection of property paths (guts mutex must be held)
+    void collect_prop_paths(const node_type &node, const fs_path &path, std::vector<fs_path> &paths) const{
+        if (node.prop.get() != NULL) paths.push_back(path);
+        for (size_t i = 0; i < node.children.size(); i++){
+            collect_prop_paths(
+                _guts->nodes[node.children[i].second],
+                path / _guts->segment_names[node.children[i].first],
+                paths);
+        }
+    }
+
     //tree guts which may be referenced in a subtree
     struct tree_guts_type{
-        node_type root;
-        boost::mutex mutex;
+        tree_guts_type(void){
+            nodes.resize(1); //slot 0 is the root node
+        }
+
+        //!Look up the interned id of a path segment, NODE_NPOS when unknown
+        uint32_t find_segment(const std::string &name) const{
+            const std::map<std::string, uint32_t>::const_iterator
+                it = segment_ids.find(name);
+            return (it == segment_ids.end())? NODE_NPOS : it->second;
+        }
+
+        //!Intern a path segment, reusing the id of an equal segment
+        uint32_t intern_segment(const std::string &name){
+            const uint32_t id = find_segment(name);
+            if (id != NODE_NPOS) return id;
+            segment_names.push_back(name);
+            segment_ids[name] = uint32_t(segment_names.size() - 1);
+            return uint32_t(segment_names.size() - 1);
+        }
+
+        //!Find a child of the given node by name, NODE_NPOS when absent
+        uint32_t find_child(const node_type &node, const std::string &name) const{
+            const uint32_t segment = find_segment(name);
+            if (segment == NODE_NPOS) return NODE_NPOS;
+            for (size_t i = 0; i < node.children.size(); i++){
+                if (node.children[i].first == segment) return node.children[i].second;
+            }
+            return NODE_NPOS;
+        }
+
+        //node arena: a deque allocates in chunks and keeps node (and
+        //thus property reference) addresses stable while the tree
+        //grows, so building a full device tree costs a handful of
+        //block allocations instead of one per node
+        std::deque<node_type> nodes;
+        //interned path segments; names repeat heavily across a device
+        //tree (every channel has the same leaves) so each distinct
+        //segment is stored once and children refer to it by id
+        std::vector<std::string> segment_names;
+        std::map<std::string, uint32_t> segment_ids;
+        uhd::dict<std::string, populator_fcn_t> populators;
+        uhd::dict<std::string, populator_fcn_t> snapshot_backends;
+        //interned path handles: the resolved props by handle, plus the
+        //path -> handle map so re-interning a path is idempotent; a
+        //deque keeps the entry addresses stable (like the node arena),
+        //since _access() hands out references that outlive the lock
+        std::deque<boost::shared_ptr<void> > interned_props;
+        uhd::dict<std::string, path_handle_t> interned_ids;
+        boost::shared_mutex mutex;
     };
 
+    //!Walk to the node at path, NULL when not present (guts mutex must be held)
+    node_type *find_node(const fs_path &path) const{
+        uint32_t index = 0; //the root
+        for(const std::string &name:  path_tokenizer(path)){
+            const uint32_t child = _guts->find_child(_guts->nodes[index], name);
+            if (child == NODE_NPOS) return NULL;
+            index = child;
+        }
+        return &_guts->nodes[index];
+    }
+
     //members, the tree and root prefix
     boost::shared_ptr<tree_guts_type> _guts;
     const fs_path _root;
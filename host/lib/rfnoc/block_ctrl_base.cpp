@@ -276,6 +276,50 @@ void block_ctrl_base::sr_write(const uint32_t reg, const uint32_t data, const si
     }
 }
 
+void block_ctrl_base::stage_sr_write(
+        const uint32_t reg,
+        const uint32_t data,
+        const time_spec_t &time,
+        const size_t port
+) {
+    if (not _ctrl_ifaces.count(port)) {
+        throw uhd::key_error(str(boost::format("[%s] stage_sr_write(): No such port: %d") % get_block_id().get() % port));
+    }
+    const timed_sr_write_t write = {reg, data, time};
+    _staged_sr_writes[port].push_back(write);
+}
+
+void block_ctrl_base::commit_sr_writes(const size_t port)
+{
+    if (not _ctrl_ifaces.count(port)) {
+        throw uhd::key_error(str(boost::format("[%s] commit_sr_writes(): No such port: %d") % get_block_id().get() % port));
+    }
+    std::vector<timed_sr_write_t> &staged = _staged_sr_writes[port];
+    if (staged.empty()) {
+        return;
+    }
+
+    //convert the whole schedule to ticks once, up front
+    std::vector<ctrl_iface::timed_cmd_t> cmds;
+    cmds.reserve(staged.size());
+    const double tick_rate = _cmd_tickrates[port];
+    for (const timed_sr_write_t &write : staged) {
+        ctrl_iface::timed_cmd_t cmd;
+        cmd.addr = write.reg;
+        cmd.data = write.data;
+        cmd.timestamp = write.time.to_ticks(tick_rate);
+        cmds.push_back(cmd);
+    }
+    staged.clear();
+
+    try {
+        _ctrl_ifaces[port]->send_cmd_pkt_burst(cmds);
+    }
+    catch(const std::exception &ex) {
+        throw uhd::io_error(str(boost::format("[%s] commit_sr_writes() failed: %s") % get_block_id().get() % ex.what()));
+    }
+}
+
 void block_ctrl_base::sr_write(const std::string &reg, const uint32_t data, const size_t port)
 {
     uint32_t reg_addr = 255;
@@ -11,12 +11,16 @@
 #include <uhd/utils/log.hpp>
 #include <uhd/utils/paths.hpp>
 #include <boost/format.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/xml_parser.hpp>
+#include <stdint.h>
 #include <cstdlib>
+#include <cstring>
+#include <fstream>
 
 using namespace uhd;
 using namespace uhd::rfnoc;
@@ -220,6 +224,18 @@ public:
         return false;
     }
 
+    //! Returns all NoC IDs defined in this block definition
+    std::vector<std::string> get_ids()
+    {
+        std::vector<std::string> ids;
+        for(pt::ptree::value_type &v:  _pt.get_child("nocblock.ids")) {
+            if (v.first == "id") {
+                ids.push_back(v.second.data());
+            }
+        }
+        return ids;
+    }
+
     blockdef_xml_impl(const fs::path &filename, uint64_t noc_id, xml_repr_t type=DESCRIBES_BLOCK) :
         _type(type),
         _noc_id(noc_id)
@@ -408,6 +424,320 @@ private:
 
 };
 
+/****************************************************************************
+ * Compiled blockdef cache
+ *
+ * Scanning for a NoC ID parses every blockdef XML file with the property
+ * tree XML parser, for every block, on every session. Each XML file is
+ * therefore compiled once into a small binary table stored under the app
+ * path; subsequent sessions load the tables and skip the XML parser
+ * entirely. A cache file is keyed by a hash of the XML path and validated
+ * against the XML file's size and modification time, so edited definitions
+ * are recompiled transparently.
+ ****************************************************************************/
+static const char COMPILED_BLOCKDEF_MAGIC[8] = {'U','H','D','B','D','E','F','\0'};
+static const uint32_t COMPILED_BLOCKDEF_VERSION = 1;
+
+//! Everything make_from_noc_id() and the blockdef getters need, pre-parsed
+struct compiled_blockdef_t
+{
+    std::vector<std::string> ids;
+    std::string key;
+    std::string name;
+    blockdef::ports_t input_ports;
+    blockdef::ports_t output_ports;
+    blockdef::args_t args;
+    blockdef::registers_t set_regs;
+    blockdef::registers_t rb_regs;
+};
+
+static void _write_string(std::ostream &out, const std::string &s)
+{
+    const uint32_t len = uint32_t(s.size());
+    out.write(reinterpret_cast<const char *>(&len), sizeof(len));
+    out.write(s.data(), len);
+}
+
+static std::string _read_string(std::istream &in)
+{
+    uint32_t len = 0;
+    in.read(reinterpret_cast<char *>(&len), sizeof(len));
+    std::string s(len, '\0');
+    if (len) {
+        in.read(&s[0], len);
+    }
+    return s;
+}
+
+static void _write_dict(std::ostream &out, const uhd::dict<std::string, std::string> &dict)
+{
+    const uint32_t count = uint32_t(dict.size());
+    out.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    for(const std::string &dict_key:  dict.keys()) {
+        _write_string(out, dict_key);
+        _write_string(out, dict[dict_key]);
+    }
+}
+
+template <typename dict_type>
+static void _read_dict(std::istream &in, dict_type &dict)
+{
+    uint32_t count = 0;
+    in.read(reinterpret_cast<char *>(&count), sizeof(count));
+    for (uint32_t j = 0; j < count; j++) {
+        const std::string dict_key = _read_string(in);
+        dict[dict_key] = _read_string(in);
+    }
+}
+
+static void _write_regs(std::ostream &out, const blockdef::registers_t &regs)
+{
+    const uint32_t count = uint32_t(regs.size());
+    out.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    for(const std::string &reg_name:  regs.keys()) {
+        _write_string(out, reg_name);
+        const uint64_t addr = regs[reg_name];
+        out.write(reinterpret_cast<const char *>(&addr), sizeof(addr));
+    }
+}
+
+static void _read_regs(std::istream &in, blockdef::registers_t &regs)
+{
+    uint32_t count = 0;
+    in.read(reinterpret_cast<char *>(&count), sizeof(count));
+    for (uint32_t j = 0; j < count; j++) {
+        const std::string reg_name = _read_string(in);
+        uint64_t addr = 0;
+        in.read(reinterpret_cast<char *>(&addr), sizeof(addr));
+        regs[reg_name] = size_t(addr);
+    }
+}
+
+//! Where the compiled table for the given XML file lives
+static fs::path compiled_blockdef_path(const fs::path &xml_path)
+{
+    boost::hash<std::string> string_hash;
+    return fs::path(uhd::get_app_path()) / ".uhd" / "cache" / "blockdefs"
+        / str(boost::format("%016x.bdc") % uint64_t(string_hash(xml_path.string())));
+}
+
+/*! Load the compiled table for the given XML file.
+ *
+ * Returns false if there is no cache file, it is stale with respect to the
+ * XML file, or it cannot be read; the caller then falls back to parsing.
+ */
+static bool load_compiled_blockdef(const fs::path &xml_path, compiled_blockdef_t &def)
+{
+    const fs::path cache_path = compiled_blockdef_path(xml_path);
+    try {
+        if (not fs::exists(cache_path)) {
+            return false;
+        }
+        std::ifstream in(cache_path.string().c_str(), std::ios::binary);
+        in.exceptions(std::ifstream::failbit | std::ifstream::badbit | std::ifstream::eofbit);
+        char magic[8];
+        in.read(magic, sizeof(magic));
+        if (std::memcmp(magic, COMPILED_BLOCKDEF_MAGIC, sizeof(magic)) != 0) {
+            return false;
+        }
+        uint32_t version = 0;
+        in.read(reinterpret_cast<char *>(&version), sizeof(version));
+        if (version != COMPILED_BLOCKDEF_VERSION) {
+            return false;
+        }
+        uint64_t xml_size = 0;
+        int64_t xml_mtime = 0;
+        in.read(reinterpret_cast<char *>(&xml_size), sizeof(xml_size));
+        in.read(reinterpret_cast<char *>(&xml_mtime), sizeof(xml_mtime));
+        if (xml_size != uint64_t(fs::file_size(xml_path))
+                or xml_mtime != int64_t(fs::last_write_time(xml_path))) {
+            return false; // XML file changed, recompile
+        }
+        uint32_t n_ids = 0;
+        in.read(reinterpret_cast<char *>(&n_ids), sizeof(n_ids));
+        for (uint32_t j = 0; j < n_ids; j++) {
+            def.ids.push_back(_read_string(in));
+        }
+        def.key = _read_string(in);
+        def.name = _read_string(in);
+        uint32_t n_ports = 0;
+        in.read(reinterpret_cast<char *>(&n_ports), sizeof(n_ports));
+        for (uint32_t j = 0; j < n_ports; j++) {
+            blockdef::port_t port;
+            _read_dict(in, port);
+            def.input_ports.push_back(port);
+        }
+        in.read(reinterpret_cast<char *>(&n_ports), sizeof(n_ports));
+        for (uint32_t j = 0; j < n_ports; j++) {
+            blockdef::port_t port;
+            _read_dict(in, port);
+            def.output_ports.push_back(port);
+        }
+        uint32_t n_args = 0;
+        in.read(reinterpret_cast<char *>(&n_args), sizeof(n_args));
+        for (uint32_t j = 0; j < n_args; j++) {
+            blockdef::arg_t arg;
+            _read_dict(in, arg);
+            def.args.push_back(arg);
+        }
+        _read_regs(in, def.set_regs);
+        _read_regs(in, def.rb_regs);
+        return true;
+    } catch (const std::exception &) {
+        return false; // corrupt or truncated cache entry, fall back to XML
+    }
+}
+
+/*! Parse the given XML file and compile it into the cache.
+ *
+ * Returns false if the file is not a valid block definition; writing the
+ * cache entry itself is best effort (the cache is only an optimization).
+ */
+static bool compile_blockdef(const fs::path &xml_path, uint64_t noc_id, compiled_blockdef_t &def)
+{
+    try {
+        blockdef_xml_impl block(xml_path, noc_id);
+        def.ids = block.get_ids();
+        def.key = block.get_key();
+        def.name = block.get_name();
+        def.input_ports = block.get_input_ports();
+        def.output_ports = block.get_output_ports();
+        def.args = block.get_args();
+        def.set_regs = block.get_settings_registers();
+        def.rb_regs = block.get_readback_registers();
+    } catch (const std::exception &) {
+        return false;
+    }
+    const fs::path cache_path = compiled_blockdef_path(xml_path);
+    try {
+        fs::create_directories(cache_path.branch_path());
+        // Write to a unique temp file and rename it into place, so parallel
+        // block enumeration threads cannot tear each other's cache entries
+        const fs::path tmp_path =
+            cache_path.branch_path() / fs::unique_path("%%%%%%%%.bdc.tmp");
+        {
+            std::ofstream out(tmp_path.string().c_str(), std::ios::binary);
+            out.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+            out.write(COMPILED_BLOCKDEF_MAGIC, sizeof(COMPILED_BLOCKDEF_MAGIC));
+            out.write(reinterpret_cast<const char *>(&COMPILED_BLOCKDEF_VERSION),
+                    sizeof(COMPILED_BLOCKDEF_VERSION));
+            const uint64_t xml_size = uint64_t(fs::file_size(xml_path));
+            const int64_t xml_mtime = int64_t(fs::last_write_time(xml_path));
+            out.write(reinterpret_cast<const char *>(&xml_size), sizeof(xml_size));
+            out.write(reinterpret_cast<const char *>(&xml_mtime), sizeof(xml_mtime));
+            uint32_t count = uint32_t(def.ids.size());
+            out.write(reinterpret_cast<const char *>(&count), sizeof(count));
+            for(const std::string &id:  def.ids) {
+                _write_string(out, id);
+            }
+            _write_string(out, def.key);
+            _write_string(out, def.name);
+            count = uint32_t(def.input_ports.size());
+            out.write(reinterpret_cast<const char *>(&count), sizeof(count));
+            for(const blockdef::port_t &port:  def.input_ports) {
+                _write_dict(out, port);
+            }
+            count = uint32_t(def.output_ports.size());
+            out.write(reinterpret_cast<const char *>(&count), sizeof(count));
+            for(const blockdef::port_t &port:  def.output_ports) {
+                _write_dict(out, port);
+            }
+            count = uint32_t(def.args.size());
+            out.write(reinterpret_cast<const char *>(&count), sizeof(count));
+            for(const blockdef::arg_t &arg:  def.args) {
+                _write_dict(out, arg);
+            }
+            _write_regs(out, def.set_regs);
+            _write_regs(out, def.rb_regs);
+        }
+        fs::rename(tmp_path, cache_path);
+    } catch (const std::exception &e) {
+        UHD_LOGGER_DEBUG("RFNOC")
+            << "Could not write compiled blockdef cache entry for "
+            << xml_path.string() << ": " << e.what();
+    }
+    return true;
+}
+
+//! Serves block definition data from a compiled table, no XML involved
+class blockdef_compiled_impl : public blockdef
+{
+public:
+    blockdef_compiled_impl(const compiled_blockdef_t &def, uint64_t noc_id) :
+        _def(def),
+        _noc_id(noc_id)
+    {
+        // nop
+    }
+
+    bool is_block() const
+    {
+        return true;
+    }
+
+    bool is_component() const
+    {
+        return false;
+    }
+
+    std::string get_key() const
+    {
+        return _def.key;
+    }
+
+    std::string get_name() const
+    {
+        return _def.name;
+    }
+
+    uint64_t noc_id() const
+    {
+        return _noc_id;
+    }
+
+    ports_t get_input_ports()
+    {
+        return _def.input_ports;
+    }
+
+    ports_t get_output_ports()
+    {
+        return _def.output_ports;
+    }
+
+    std::vector<size_t> get_all_port_numbers()
+    {
+        std::set<size_t> set_ports;
+        for(const port_t &port:  _def.input_ports) {
+            set_ports.insert(boost::lexical_cast<size_t>(port["port"]));
+        }
+        for(const port_t &port:  _def.output_ports) {
+            set_ports.insert(boost::lexical_cast<size_t>(port["port"]));
+        }
+        return std::vector<size_t>(set_ports.begin(), set_ports.end());
+    }
+
+    args_t get_args()
+    {
+        return _def.args;
+    }
+
+    registers_t get_settings_registers()
+    {
+        return _def.set_regs;
+    }
+
+    registers_t get_readback_registers()
+    {
+        return _def.rb_regs;
+    }
+
+private:
+
+    const compiled_blockdef_t _def;
+    const uint64_t _noc_id;
+};
+
 blockdef::sptr blockdef::make_from_noc_id(uint64_t noc_id)
 {
     std::vector<fs::path> paths = blockdef_xml_impl::get_xml_paths();
@@ -440,8 +770,29 @@ blockdef::sptr blockdef::make_from_noc_id(uint64_t noc_id)
             if (i->path().filename().extension() != XML_EXTENSION) {
                 continue;
             }
-            if (blockdef_xml_impl::has_noc_id(noc_id, i->path())) {
-                return blockdef::sptr(new blockdef_xml_impl(i->path(), noc_id));
+            compiled_blockdef_t cdef;
+            if (not load_compiled_blockdef(i->path(), cdef)) {
+                // Not compiled yet (or stale): parse the XML once and
+                // compile it so future sessions skip the parser.
+                if (not compile_blockdef(i->path(), noc_id, cdef)) {
+                    // Not a valid block definition; fall back to the plain
+                    // scan behaviour for this file.
+                    if (blockdef_xml_impl::has_noc_id(noc_id, i->path())) {
+                        return blockdef::sptr(new blockdef_xml_impl(i->path(), noc_id));
+                    }
+                    continue;
+                }
+            }
+            try {
+                for(const std::string &id:  cdef.ids) {
+                    if (blockdef_xml_impl::match_noc_id(id, noc_id)) {
+                        return blockdef::sptr(new blockdef_compiled_impl(cdef, noc_id));
+                    }
+                }
+            } catch (const std::exception &e) {
+                UHD_LOGGER_WARNING("RFNOC")
+                    << "make_from_noc_id(): caught exception " << e.what()
+                    << " while matching NoC IDs from: " << i->path().string();
             }
         }
     }
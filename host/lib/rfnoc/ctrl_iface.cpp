@@ -19,7 +19,7 @@
 #include <boost/format.hpp>
 #include <boost/bind.hpp>
 #include <boost/make_shared.hpp>
-#include <queue>
+#include <boost/circular_buffer.hpp>
 
 using namespace uhd;
 using namespace uhd::rfnoc;
@@ -44,7 +44,8 @@ public:
                 uhd::rfnoc::CMD_FIFO_SIZE / 3, // Max command packet size is 3 lines
                 _xports.recv->get_num_recv_frames()
             )
-        )
+        ),
+        _outstanding_seqs(_max_outstanding_acks + 1)
     {
         UHD_ASSERT_THROW(bool(_xports.send));
         UHD_ASSERT_THROW(bool(_xports.recv));
@@ -77,6 +78,19 @@ public:
         );
     }
 
+    void send_cmd_pkt_burst(const std::vector<timed_cmd_t> &cmds)
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        for (const timed_cmd_t &cmd : cmds) {
+            this->send_pkt(cmd.addr, cmd.data, cmd.timestamp);
+            //only blocks when the command FIFO would overflow
+            this->wait_for_ack(
+                    false,
+                    bool(cmd.timestamp) ? MASSIVE_TIMEOUT : ACK_TIMEOUT
+            );
+        }
+    }
+
 private:
     // This is the buffer type for response messages
     struct resp_buff_type
@@ -129,7 +143,8 @@ private:
 
         //UHD_LOGGER_TRACE("RFNOC") << boost::format("0x%08x, 0x%08x\n") % addr % data;
         //send the buffer over the interface
-        _outstanding_seqs.push(_seq_out);
+        UHD_ASSERT_THROW(not _outstanding_seqs.full());
+        _outstanding_seqs.push_back(_seq_out);
         buff->commit(sizeof(uint32_t)*(packet_info.num_packet_words32));
 
         _seq_out++;//inc seq for next call
@@ -154,7 +169,7 @@ private:
             try {
                 UHD_ASSERT_THROW(bool(buff));
                 UHD_ASSERT_THROW(buff->size() > 0);
-                _outstanding_seqs.pop();
+                _outstanding_seqs.pop_front();
             }
             catch(const std::exception &ex) {
                 throw uhd::io_error(str(
@@ -241,8 +256,11 @@ private:
     const uhd::both_xports_t _xports;
     const std::string _name;
     size_t _seq_out;
-    std::queue<size_t> _outstanding_seqs;
     const size_t _max_outstanding_acks;
+    // Preallocated to the ack pipeline depth, so tracking a
+    // transaction never touches the allocator (std::queue's deque
+    // backing churns heap blocks under sustained command storms)
+    boost::circular_buffer<size_t> _outstanding_seqs;
 
     boost::mutex _mutex;
 };
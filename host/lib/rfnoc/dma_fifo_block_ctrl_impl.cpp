@@ -77,6 +77,10 @@ public:
         return _perifs[chan].depth;
     }
 
+    uint32_t get_bytes_occupied(const size_t chan) {
+        return _perifs[chan].core->get_bytes_occupied();
+    }
+
 private:
     struct fifo_perifs_t
     {
@@ -89,7 +89,24 @@ void graph_impl::connect(
         ;
 
     /********************************************************************
-     * 2. Check IO signatures match
+     * 2. Check for a cached connection plan
+     ********************************************************************/
+    // The logical edges above always have to be redrawn (the graph
+    // bookkeeping is torn down with the graph object), but the device
+    // programming of a previously resolved edge can be replayed verbatim.
+    const std::string plan_key = str(
+        boost::format("%s:%d-->%s:%d/%d")
+        % src->get_block_id().get() % src_block_port
+        % dst->get_block_id().get() % dst_block_port
+        % pkt_size_
+    );
+    if (_connection_plans.count(plan_key)) {
+        replay_connection_plan(src, dst, _connection_plans[plan_key]);
+        return;
+    }
+
+    /********************************************************************
+     * 3. Check IO signatures match
      ********************************************************************/
     if (not rfnoc::stream_sig_t::is_compatible(
                 src->get_output_signature(actual_src_block_port),
@@ -105,7 +122,7 @@ void graph_impl::connect(
     UHD_LOG_TRACE("RFNOC", "IO signatures match.");
 
     /********************************************************************
-     * 3. Configure the source block's destination
+     * 4. Configure the source block's destination
      ********************************************************************/
     // Calculate SID
     sid_t sid = dst->get_address(dst_block_port);
@@ -115,7 +132,7 @@ void graph_impl::connect(
     src->set_destination(sid.get(), src_block_port);
 
     /********************************************************************
-     * 4. Configure flow control
+     * 5. Configure flow control
      ********************************************************************/
     size_t pkt_size = (pkt_size_ != 0) ? pkt_size_ : src->get_output_signature(src_block_port).packet_size;
     if (pkt_size == 0) { // Unspecified packet rate. Assume max packet size.
@@ -151,15 +168,58 @@ void graph_impl::connect(
     );
 
     /********************************************************************
-     * 5. Configure error policy
+     * 6. Configure error policy
      ********************************************************************/
     dst->set_error_policy("next_burst");
 
     /********************************************************************
-     * 6. Set async message handling
+     * 7. Set async message handling
      ********************************************************************/
     src->sr_write(uhd::rfnoc::SR_RESP_OUT_DST_SID,  _msg_handler->get_local_addr(), src_block_port);
     dst->sr_write(uhd::rfnoc::SR_RESP_IN_DST_SID, _msg_handler->get_local_addr(), dst_block_port);
+
+    /********************************************************************
+     * 8. Record the plan for future rebuilds of this edge
+     ********************************************************************/
+    connection_plan_t plan;
+    plan.src_port = src_block_port;
+    plan.dst_port = dst_block_port;
+    plan.sid = sid.get();
+    plan.buf_size_bytes = buf_size_bytes;
+    plan.bytes_per_response = bytes_per_response;
+    _connection_plans[plan_key] = plan;
+}
+
+void graph_impl::replay_connection_plan(
+        uhd::rfnoc::source_block_ctrl_base::sptr src,
+        uhd::rfnoc::sink_block_ctrl_base::sptr dst,
+        const connection_plan_t &plan
+) {
+    UHD_LOGGER_TRACE("RFNOC")
+        << "[" << _name << "] Replaying cached connection plan for "
+        << src->get_block_id() << ":" << plan.src_port << " --> "
+        << dst->get_block_id() << ":" << plan.dst_port
+        ;
+    // The register writes below match what set_destination(),
+    // configure_flow_control_out() and configure_flow_control_in() emitted
+    // when the plan was recorded. Because the window size is identical to
+    // the previous run, the flush wait in configure_flow_control_out() is
+    // not required: the window is disabled and re-enabled with the same
+    // settings within a single burst.
+    const uhd::time_spec_t now(0.0);
+    const uint32_t fc_config = 1 | (1 << 1); // FC output enabled, byte-based
+    src->stage_sr_write(uhd::rfnoc::SR_NEXT_DST_SID, (1 << 16) | plan.sid, now, plan.src_port);
+    src->stage_sr_write(uhd::rfnoc::SR_FLOW_CTRL_EN, 0, now, plan.src_port);
+    src->stage_sr_write(uhd::rfnoc::SR_FLOW_CTRL_WINDOW_SIZE, plan.buf_size_bytes, now, plan.src_port);
+    src->stage_sr_write(uhd::rfnoc::SR_FLOW_CTRL_EN, fc_config, now, plan.src_port);
+    src->stage_sr_write(uhd::rfnoc::SR_RESP_OUT_DST_SID, _msg_handler->get_local_addr(), now, plan.src_port);
+    src->commit_sr_writes(plan.src_port);
+
+    dst->stage_sr_write(uhd::rfnoc::SR_FLOW_CTRL_BYTES_PER_ACK, (1 << 31) | plan.bytes_per_response, now, plan.dst_port);
+    dst->stage_sr_write(uhd::rfnoc::SR_RESP_IN_DST_SID, _msg_handler->get_local_addr(), now, plan.dst_port);
+    dst->commit_sr_writes(plan.dst_port);
+    // set_error_policy() writes to the default port, outside the burst
+    dst->set_error_policy("next_burst");
 }
 
 void graph_impl::connect(
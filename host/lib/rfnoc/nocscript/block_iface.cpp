@@ -107,7 +107,14 @@ void block_iface::run_and_check(const std::string &code, const std::string &erro
     boost::mutex::scoped_lock local_interpreter_lock(_lil_mutex);
 
     UHD_NOCSCRIPT_LOG() << "[NocScript] Executing and asserting code: " << code ;
-    expression::sptr e = _parser->create_expr_tree(code);
+    // The code strings come from the blockdef and don't change at runtime,
+    // so each one only needs to go through the parser once. Variables are
+    // late-bound (their getters run at eval time) and functions re-execute
+    // their side effects on every eval(), so reusing the tree is safe.
+    expression::sptr &e = _expr_cache[code];
+    if (not e) {
+        e = _parser->create_expr_tree(code);
+    }
     expression_literal result = e->eval();
     if (not result.to_bool()) {
         if (error_message.empty()) {
@@ -74,6 +74,9 @@ class block_iface {
     //! Pointer to the parser object
     parser::sptr _parser;
 
+    //! Parsed expression trees, keyed by source code (guarded by _lil_mutex)
+    std::map<std::string, expression::sptr> _expr_cache;
+
     //! Container for scoped variables
     std::map<std::string, expression_literal> _vars;
 };
@@ -307,8 +307,9 @@ class parser_impl : public parser
         grammar_props P(_ftable, _var_type_getter, _var_value_getter);
         int next_valid_state = grammar::VALID_EXPRESSION;
 
-        // Create a lexer instance
-        ns_lexer<lex::lexertl::lexer<> > lexer_functor;
+        // The lexer is stateless and building its tables is not cheap,
+        // so one shared instance serves all parses
+        static const ns_lexer<lex::lexertl::lexer<> > lexer_functor;
 
         // Tokenize the string
         char const* first = code.c_str();
@@ -0,0 +1,171 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/rfnoc/rate_plan.hpp>
+#include <uhd/exception.hpp>
+#include <boost/format.hpp>
+#include <sstream>
+
+using namespace uhd::rfnoc;
+
+/***********************************************************************
+ * Cost model constants
+ *
+ * Costs are charged per input sample of each filter, relative to the
+ * chain input rate, so earlier stages are more expensive to run. The
+ * halfband weight reflects that a halfband burns more multipliers per
+ * sample than the multiplierless CIC. The alias penalty is large enough
+ * that a CIC-only stage (passband CIC rolloff with no halfband behind
+ * it) only wins when no clean factorization exists.
+ **********************************************************************/
+static const double COST_CIC = 1.0;
+static const double COST_HALFBAND = 4.0;
+static const double COST_ALIAS_PENALTY = 1e6;
+
+/***********************************************************************
+ * Helpers
+ **********************************************************************/
+//! Decompose a stage decimation the way the FPGA will: greedily strip
+//! factors of two into halfbands, leave the rest for the CIC.
+//! Returns false if the CIC cannot cover the remainder.
+static bool decompose_stage_decim(
+    const dsp_stage_caps &caps,
+    const size_t decim,
+    rate_plan::stage_type &stage
+){
+    stage.decim = decim;
+    stage.num_halfbands = 0;
+    stage.cic_decim = decim;
+    while ((stage.cic_decim % 2 == 0)
+            and stage.num_halfbands < caps.num_halfbands) {
+        stage.num_halfbands++;
+        stage.cic_decim /= 2;
+    }
+    return stage.cic_decim <= caps.cic_max_decim;
+}
+
+//! Relative work of one stage running at relative input rate \p rate
+static double stage_cost(
+    const rate_plan::stage_type &stage,
+    const double rate
+){
+    double cost = 0.0;
+    // the CIC runs at the full stage input rate
+    if (stage.cic_decim > 1) {
+        cost += COST_CIC * rate;
+        // no halfband behind the CIC to clean up its rolloff
+        if (stage.num_halfbands == 0) {
+            cost += COST_ALIAS_PENALTY * rate;
+        }
+    }
+    // each halfband runs at half the rate of the one before it
+    double hb_rate = rate / stage.cic_decim;
+    for (size_t hb = 0; hb < stage.num_halfbands; hb++) {
+        cost += COST_HALFBAND * hb_rate;
+        hb_rate /= 2;
+    }
+    return cost;
+}
+
+//! Recursively assign the remaining decimation to stages[i:], keeping
+//! the cheapest complete plan in \p best.
+static void plan_recursive(
+    const std::vector<dsp_stage_caps> &stages,
+    const size_t i,
+    const size_t decim_left,
+    const double rate,
+    const double cost,
+    std::vector<rate_plan::stage_type> &current,
+    rate_plan &best,
+    bool &found
+){
+    if (i == stages.size()) {
+        if (decim_left != 1) return;
+        if (not found or cost < best.cost) {
+            best.stages = current;
+            best.cost = cost;
+            found = true;
+        }
+        return;
+    }
+    // try every divisor of the remaining decimation for this stage
+    for (size_t d = 1; d <= decim_left; d++) {
+        if (decim_left % d != 0) continue;
+        rate_plan::stage_type stage;
+        if (not decompose_stage_decim(stages[i], d, stage)) continue;
+        current[i] = stage;
+        plan_recursive(
+            stages, i+1, decim_left/d, rate/d,
+            cost + stage_cost(stage, rate),
+            current, best, found
+        );
+    }
+}
+
+/***********************************************************************
+ * rate_plan
+ **********************************************************************/
+size_t rate_plan::get_total_decim(void) const
+{
+    size_t decim = 1;
+    for (const stage_type &stage : stages) {
+        decim *= stage.decim;
+    }
+    return decim;
+}
+
+std::string rate_plan::to_pp_string(void) const
+{
+    std::stringstream ss;
+    ss << boost::format("Rate plan: total decimation %d, relative cost %f")
+            % get_total_decim() % cost << std::endl;
+    for (size_t i = 0; i < stages.size(); i++) {
+        ss << boost::format("  Stage %d: decim %d (halfbands: %d, CIC: %d)")
+                % i % stages[i].decim
+                % stages[i].num_halfbands % stages[i].cic_decim
+           << std::endl;
+    }
+    return ss.str();
+}
+
+/***********************************************************************
+ * Planner
+ **********************************************************************/
+rate_plan uhd::rfnoc::plan_rate_chain(
+    const std::vector<dsp_stage_caps> &stages,
+    const size_t decim
+){
+    if (decim == 0) {
+        throw uhd::value_error("plan_rate_chain(): decimation cannot be zero");
+    }
+    rate_plan best;
+    bool found = false;
+    std::vector<rate_plan::stage_type> current(stages.size());
+    plan_recursive(stages, 0, decim, 1.0, 0.0, current, best, found);
+    if (not found) {
+        throw uhd::value_error(str(
+            boost::format("plan_rate_chain(): decimation %d is not "
+                          "factorable across %d stages")
+            % decim % stages.size()
+        ));
+    }
+    return best;
+}
+
+rate_plan uhd::rfnoc::plan_rate_chain(
+    const std::vector<ddc_block_ctrl::sptr> &blocks,
+    const size_t decim
+){
+    std::vector<dsp_stage_caps> stages;
+    stages.reserve(blocks.size());
+    for (const ddc_block_ctrl::sptr &block : blocks) {
+        stages.push_back(dsp_stage_caps(
+            block->get_num_halfbands(),
+            block->get_cic_max_decim()
+        ));
+    }
+    return plan_rate_chain(stages, decim);
+}
@@ -93,6 +93,30 @@ void rx_stream_terminator::handle_overrun(boost::weak_ptr<uhd::rx_streamer> stre
         return;
     }
 
+    /////////////////////////////////////////////////////////////
+    // MIMO fast path: in-place recovery without a restart window
+    /////////////////////////////////////////////////////////////
+    // A radio that overflowed has halted itself; the others keep
+    // streaming. Restarting the halted ones right away (no stop, no
+    // flush, no timed restart) lets the packet handler's timestamp
+    // alignment discard the stale lead-in and re-align the channels,
+    // so a brief overrun costs packets instead of a restart window.
+    // Re-issuing a start on a port that never halted is a no-op for
+    // a continuous stream. If the overrun re-triggers right after a
+    // fast recovery the radio likely did not resume, so fall back to
+    // the conservative stop/flush/timed-restart below.
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (in_continuous_streaming_mode
+        and now > _last_fast_recovery + std::chrono::milliseconds(100)) {
+        _last_fast_recovery = now;
+        for(const boost::shared_ptr<uhd::rfnoc::radio_ctrl_impl> &node:  upstream_radio_nodes) {
+            for(const size_t port:  node->get_active_rx_ports()) {
+                node->issue_stream_cmd(stream_cmd_t::STREAM_MODE_START_CONTINUOUS, port);
+            }
+        }
+        return;
+    }
+
     /////////////////////////////////////////////////////////////
     // MIMO overflow recovery time
     /////////////////////////////////////////////////////////////
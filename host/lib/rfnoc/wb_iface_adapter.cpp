@@ -29,6 +29,21 @@ void wb_iface_adapter::poke32(const wb_addr_type addr, const uint32_t data)
     _iface->send_cmd_pkt(addr / 4, data, false, timestamp);
 }
 
+void wb_iface_adapter::poke32_range(const wb_addr_type addr, const std::vector<uint32_t> &data)
+{
+    const uint64_t timestamp = get_timestamp();
+    std::vector<ctrl_iface::timed_cmd_t> cmds(data.size());
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        cmds[i].addr = (addr + 4*i) / 4;
+        cmds[i].data = data[i];
+        cmds[i].timestamp = timestamp;
+    }
+    //the burst variant only waits for acks when the command FIFO
+    //would overflow, so the writes go out back-to-back
+    _iface->send_cmd_pkt_burst(cmds);
+}
+
 uint32_t wb_iface_adapter::peek32(const wb_addr_type addr)
 {
     const uint64_t reg_value = peek64(addr);
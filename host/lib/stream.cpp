@@ -6,6 +6,7 @@
 //
 
 #include <uhd/stream.hpp>
+#include <uhd/exception.hpp>
 
 using namespace uhd;
 
@@ -14,7 +15,280 @@ rx_streamer::~rx_streamer(void)
     //empty
 }
 
+//generic fallback: dispatch into single buffer receive calls;
+//streamer implementations can override this with a batched path
+size_t rx_streamer::recv_multi(
+    const std::vector<buffs_type> &buffs,
+    const size_t nsamps_per_buff,
+    std::vector<size_t> &nsamps,
+    std::vector<rx_metadata_t> &metadata,
+    const double timeout,
+    const bool one_packet
+){
+    nsamps.resize(buffs.size());
+    metadata.resize(buffs.size());
+
+    size_t num_buffs = 0;
+    for (size_t i = 0; i < buffs.size(); i++){
+        nsamps[i] = this->recv(
+            buffs[i], nsamps_per_buff, metadata[i], timeout, one_packet
+        );
+        num_buffs++;
+
+        //stop the batch on errors and burst boundaries so that the
+        //caller sees them in order and unfilled buffers stay untouched
+        if (metadata[i].error_code != rx_metadata_t::ERROR_CODE_NONE) break;
+        if (metadata[i].end_of_burst) break;
+    }
+    return num_buffs;
+}
+
+//generic fallback: a zero timeout makes recv() drain only what is
+//already queued in the transport without blocking
+size_t rx_streamer::recv_nonblock(
+    const buffs_type &buffs,
+    const size_t nsamps_per_buff,
+    rx_metadata_t &metadata,
+    const bool one_packet
+){
+    return this->recv(buffs, nsamps_per_buff, metadata, 0.0, one_packet);
+}
+
+//pollable descriptors require support from the streamer
+//implementation; streamers without it keep this default
+std::vector<int> rx_streamer::get_recv_fds(void) const
+{
+    throw uhd::not_implemented_error(
+        "get_recv_fds() is not supported by this streamer");
+}
+
+//generic fallback: issue everything right away; works for command
+//trains that fit the device command FIFO
+void rx_streamer::schedule_stream_cmds(const std::vector<stream_cmd_t> &stream_cmds)
+{
+    for (size_t i = 0; i < stream_cmds.size(); i++){
+        this->issue_stream_cmd(stream_cmds[i]);
+    }
+}
+
+//registered output memory requires support from the streamer
+//implementation; streamers without it keep this default
+void rx_streamer::register_recv_buff(void *, const size_t)
+{
+    throw uhd::not_implemented_error(
+        "register_recv_buff() is not supported by this streamer");
+}
+
+//loaning out transport buffers requires support from the streamer
+//implementation; streamers without it keep this default
+bool rx_streamer::recv_loan(
+    buff_loan_t &,
+    rx_metadata_t &,
+    const double
+){
+    throw uhd::not_implemented_error(
+        "recv_loan() is not supported by this streamer");
+}
+
+//posted buffers require queue state inside the receive path;
+//streamers without that plumbing keep these defaults
+size_t rx_streamer::post_recv_buff(const buffs_type &, const size_t)
+{
+    throw uhd::not_implemented_error(
+        "post_recv_buff() is not supported by this streamer");
+}
+
+bool rx_streamer::recv_posted(recv_completion_t &, const double)
+{
+    throw uhd::not_implemented_error(
+        "recv_posted() is not supported by this streamer");
+}
+
+//runtime packet size changes require a device-side hook from the
+//streamer implementation; streamers without one keep this default
+void rx_streamer::set_samples_per_packet(const size_t)
+{
+    throw uhd::not_implemented_error(
+        "set_samples_per_packet() is not supported by this streamer");
+}
+
+//host-side corrections are fused into the conversion pass by the
+//streamer implementation; streamers without it keep this default
+void rx_streamer::set_iq_corrections(
+    const size_t,
+    const std::complex<float> &,
+    const std::complex<float> &
+){
+    throw uhd::not_implemented_error(
+        "set_iq_corrections() is not supported by this streamer");
+}
+
+//in-stream statistics are accumulated by the conversion pass;
+//streamers without that plumbing keep these defaults
+void rx_streamer::set_power_stats_enabled(const bool)
+{
+    throw uhd::not_implemented_error(
+        "set_power_stats_enabled() is not supported by this streamer");
+}
+
+power_stats_t rx_streamer::get_power_stats(const size_t)
+{
+    throw uhd::not_implemented_error(
+        "get_power_stats() is not supported by this streamer");
+}
+
+//performance counters require support from the streamer
+//implementation; streamers without them keep this default
+stream_stats_t rx_streamer::get_stream_stats(void) const
+{
+    throw uhd::not_implemented_error(
+        "get_stream_stats() is not supported by this streamer");
+}
+
+//converter introspection requires the streamer to resolve formats
+//through the converter framework; streamers without it keep this default
+convert::converter_info_type rx_streamer::get_converter_info(void) const
+{
+    throw uhd::not_implemented_error(
+        "get_converter_info() is not supported by this streamer");
+}
+
+//per-sample timekeeping is fed from inside the receive call; streamers
+//without that plumbing keep this default
+const sample_timekeeper &rx_streamer::get_timekeeper(void) const
+{
+    throw uhd::not_implemented_error(
+        "get_timekeeper() is not supported by this streamer");
+}
+
+//the sample history ring is fed from inside the receive call;
+//streamers without that plumbing keep these defaults
+void rx_streamer::enable_history(const double)
+{
+    throw uhd::not_implemented_error(
+        "enable_history() is not supported by this streamer");
+}
+
+size_t rx_streamer::freeze_history(void)
+{
+    throw uhd::not_implemented_error(
+        "freeze_history() is not supported by this streamer");
+}
+
+size_t rx_streamer::read_history(const buffs_type &, const size_t, const size_t)
+{
+    throw uhd::not_implemented_error(
+        "read_history() is not supported by this streamer");
+}
+
+void rx_streamer::resume_history(void)
+{
+    throw uhd::not_implemented_error(
+        "resume_history() is not supported by this streamer");
+}
+
+//transport reconnection requires rebuild hooks wired up at stream
+//creation; streamers without them keep this default
+void rx_streamer::reconnect(void)
+{
+    throw uhd::not_implemented_error(
+        "reconnect() is not supported by this streamer");
+}
+
+//a live converter swap needs the packet-handler machinery; streamers
+//built on other receive paths keep this default
+void rx_streamer::set_cpu_format(const std::string &)
+{
+    throw uhd::not_implemented_error(
+        "set_cpu_format() is not supported by this streamer");
+}
+
 tx_streamer::~tx_streamer(void)
 {
     //empty
 }
+
+//scattered sends need the conversion pass to walk the span list;
+//streamers without that plumbing keep this default
+size_t tx_streamer::send_spans(
+    const std::vector<span_list_t> &,
+    const tx_metadata_t &,
+    const double
+){
+    throw uhd::not_implemented_error(
+        "send_spans() is not supported by this streamer");
+}
+
+//drop-on-timeout requires support from the streamer implementation;
+//streamers without it keep this default
+void tx_streamer::set_drop_on_timeout(const bool)
+{
+    throw uhd::not_implemented_error(
+        "set_drop_on_timeout() is not supported by this streamer");
+}
+
+//generic fallback: send() already packs and pushes the whole burst
+//before returning, so pre-staging is send() plus the metadata contract
+size_t tx_streamer::stage_burst(
+    const buffs_type &buffs,
+    const size_t nsamps_per_buff,
+    const tx_metadata_t &metadata,
+    const double timeout
+){
+    if (not (metadata.has_time_spec
+            and metadata.start_of_burst
+            and metadata.end_of_burst)){
+        throw uhd::value_error("stage_burst() requires a timed, complete "
+            "burst: has_time_spec, start_of_burst and end_of_burst");
+    }
+    return this->send(buffs, nsamps_per_buff, metadata, timeout);
+}
+
+//observing the device buffer level requires flow control state from
+//the streamer implementation; streamers without it keep this default
+double tx_streamer::get_buffer_occupancy(void) const
+{
+    throw uhd::not_implemented_error(
+        "get_buffer_occupancy() is not supported by this streamer");
+}
+
+//watermark callbacks ride on the same occupancy state; streamers
+//without it keep this default
+void tx_streamer::set_occupancy_watermarks(
+    const double,
+    const double,
+    const std::function<void(const bool)> &
+){
+    throw uhd::not_implemented_error(
+        "set_occupancy_watermarks() is not supported by this streamer");
+}
+
+stream_stats_t tx_streamer::get_stream_stats(void) const
+{
+    throw uhd::not_implemented_error(
+        "get_stream_stats() is not supported by this streamer");
+}
+
+//converter introspection requires the streamer to resolve formats
+//through the converter framework; streamers without it keep this default
+convert::converter_info_type tx_streamer::get_converter_info(void) const
+{
+    throw uhd::not_implemented_error(
+        "get_converter_info() is not supported by this streamer");
+}
+
+//replicated sends require converter-level support from the streamer
+//implementation; streamers without it keep this default
+void tx_streamer::set_replicate_channels(const bool)
+{
+    throw uhd::not_implemented_error(
+        "set_replicate_channels() is not supported by this streamer");
+}
+
+//transport reconnection requires rebuild hooks wired up at stream
+//creation; streamers without them keep this default
+void tx_streamer::reconnect(void)
+{
+    throw uhd::not_implemented_error(
+        "reconnect() is not supported by this streamer");
+}
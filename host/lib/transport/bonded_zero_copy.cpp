@@ -0,0 +1,130 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/transport/bonded_zero_copy.hpp>
+#include <boost/make_shared.hpp>
+#include <algorithm>
+#include <chrono>
+
+using namespace uhd;
+using namespace uhd::transport;
+
+//how long to block on a single member link while waiting for data
+static const double BONDED_RECV_POLL_TIMEOUT = 100e-6;
+
+class bonded_zero_copy_impl : public bonded_zero_copy
+{
+public:
+    bonded_zero_copy_impl(const std::vector<zero_copy_if::sptr> &links):
+        _links(links),
+        _next_send_link(0),
+        _last_recv_link(0)
+    {
+        if (_links.empty()) {
+            throw uhd::value_error("bonded transport needs at least one link");
+        }
+    }
+
+    managed_recv_buffer::sptr get_recv_buff(double timeout)
+    {
+        //fast path: drain the link that last had data, then its peers
+        for (size_t i = 0; i < _links.size(); i++) {
+            const size_t link = (_last_recv_link + i) % _links.size();
+            managed_recv_buffer::sptr buff = _links[link]->get_recv_buff(0.0);
+            if (buff) {
+                _last_recv_link = link;
+                return buff;
+            }
+        }
+
+        //slow path: take turns blocking on each link until the deadline
+        const std::chrono::steady_clock::time_point deadline =
+            std::chrono::steady_clock::now()
+            + std::chrono::microseconds(long(timeout * 1e6));
+        do {
+            for (size_t i = 0; i < _links.size(); i++) {
+                const size_t link = (_last_recv_link + i) % _links.size();
+                managed_recv_buffer::sptr buff =
+                    _links[link]->get_recv_buff(BONDED_RECV_POLL_TIMEOUT);
+                if (buff) {
+                    _last_recv_link = link;
+                    return buff;
+                }
+            }
+        } while (std::chrono::steady_clock::now() < deadline);
+
+        return managed_recv_buffer::sptr();
+    }
+
+    size_t get_num_recv_frames(void) const
+    {
+        size_t num_frames = 0;
+        for (size_t i = 0; i < _links.size(); i++) {
+            num_frames += _links[i]->get_num_recv_frames();
+        }
+        return num_frames;
+    }
+
+    size_t get_recv_frame_size(void) const
+    {
+        size_t frame_size = _links[0]->get_recv_frame_size();
+        for (size_t i = 1; i < _links.size(); i++) {
+            frame_size = std::min(frame_size, _links[i]->get_recv_frame_size());
+        }
+        return frame_size;
+    }
+
+    managed_send_buffer::sptr get_send_buff(double timeout)
+    {
+        //stripe sends round-robin across the member links
+        const size_t start = _next_send_link;
+        _next_send_link = (_next_send_link + 1) % _links.size();
+        for (size_t i = 0; i < _links.size(); i++) {
+            managed_send_buffer::sptr buff =
+                _links[(start + i) % _links.size()]->get_send_buff(
+                    (i == 0) ? timeout : 0.0);
+            if (buff) return buff;
+        }
+        return managed_send_buffer::sptr();
+    }
+
+    size_t get_num_send_frames(void) const
+    {
+        size_t num_frames = 0;
+        for (size_t i = 0; i < _links.size(); i++) {
+            num_frames += _links[i]->get_num_send_frames();
+        }
+        return num_frames;
+    }
+
+    size_t get_send_frame_size(void) const
+    {
+        size_t frame_size = _links[0]->get_send_frame_size();
+        for (size_t i = 1; i < _links.size(); i++) {
+            frame_size = std::min(frame_size, _links[i]->get_send_frame_size());
+        }
+        return frame_size;
+    }
+
+    void flush_send_buffs(void)
+    {
+        for (size_t i = 0; i < _links.size(); i++) {
+            _links[i]->flush_send_buffs();
+        }
+    }
+
+private:
+    const std::vector<zero_copy_if::sptr> _links;
+    size_t _next_send_link;
+    size_t _last_recv_link;
+};
+
+bonded_zero_copy::sptr bonded_zero_copy::make(
+    const std::vector<zero_copy_if::sptr> &links
+) {
+    return boost::make_shared<bonded_zero_copy_impl>(links);
+}
@@ -7,9 +7,18 @@
 
 #include <uhd/transport/buffer_pool.hpp>
 #include <uhd/transport/zero_copy.hpp>
+#include <uhd/utils/log.hpp>
 #include <boost/shared_array.hpp>
 #include <vector>
 
+#ifdef HAVE_LIBNUMA
+#include <numa.h>
+#endif
+
+#ifdef UHD_PLATFORM_LINUX
+#include <sys/mman.h> //mmap w/ MAP_HUGETLB
+#endif
+
 using namespace uhd::transport;
 
 #ifdef UHD_TXRX_DEBUG_PRINTS
@@ -82,3 +91,90 @@ buffer_pool::sptr buffer_pool::make(
     return sptr(new buffer_pool_impl(ptrs, mem));
 }
 
+/***********************************************************************
+ * NUMA-bound buffer pool factory function
+ **********************************************************************/
+buffer_pool::sptr buffer_pool::make_numa(
+    const size_t num_buffs,
+    const size_t buff_size,
+    const int node,
+    const size_t alignment
+){
+#ifdef HAVE_LIBNUMA
+    if (numa_available() < 0 or node > numa_max_node()){
+        UHD_LOG_WARNING("BUFF_POOL", "NUMA node " << node
+            << " not available; allocating buffer pool without node binding");
+        return make(num_buffs, buff_size, alignment);
+    }
+
+    const size_t padded_buff_size = pad_to_boundary(buff_size, alignment);
+    const size_t num_bytes = padded_buff_size*num_buffs + alignment-1;
+    char *numa_mem = (char *)numa_alloc_onnode(num_bytes, node);
+    if (numa_mem == NULL){
+        UHD_LOG_WARNING("BUFF_POOL",
+            "Allocation on NUMA node " << node << " failed; "
+            "allocating buffer pool without node binding");
+        return make(num_buffs, buff_size, alignment);
+    }
+    //hand the memory to a shared_array with a numa_free deleter
+    boost::shared_array<char> mem(numa_mem,
+        [num_bytes](char *p){numa_free(p, num_bytes);});
+
+    //Fill a vector with boundary-aligned points in the memory
+    const size_t mem_start = pad_to_boundary(size_t(mem.get()), alignment);
+    std::vector<ptr_type> ptrs(num_buffs);
+    for (size_t i = 0; i < num_buffs; i++){
+        ptrs[i] = ptr_type(mem_start + padded_buff_size*i);
+    }
+
+    return sptr(new buffer_pool_impl(ptrs, mem));
+#else
+    UHD_LOG_WARNING("BUFF_POOL",
+        "This version of UHD was built without libnuma; "
+        "allocating buffer pool for node " << node << " without node binding");
+    return make(num_buffs, buff_size, alignment);
+#endif /*HAVE_LIBNUMA*/
+}
+
+/***********************************************************************
+ * Huge-page-backed buffer pool factory function
+ **********************************************************************/
+buffer_pool::sptr buffer_pool::make_huge(
+    const size_t num_buffs,
+    const size_t buff_size,
+    const size_t alignment
+){
+#ifdef UHD_PLATFORM_LINUX
+    static const size_t HUGE_PAGE_SIZE = 2*1024*1024;
+
+    const size_t padded_buff_size = pad_to_boundary(buff_size, alignment);
+    const size_t num_bytes = pad_to_boundary(
+        padded_buff_size*num_buffs + alignment-1, HUGE_PAGE_SIZE);
+
+    void *huge_mem = ::mmap(NULL, num_bytes, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (huge_mem == MAP_FAILED){
+        UHD_LOG_WARNING("BUFF_POOL",
+            "Could not allocate " << num_bytes << " bytes of huge pages "
+            "(check vm.nr_hugepages); allocating buffer pool on normal pages");
+        return make(num_buffs, buff_size, alignment);
+    }
+    //hand the mapping to a shared_array with a munmap deleter
+    boost::shared_array<char> mem((char *)huge_mem,
+        [num_bytes](char *p){::munmap(p, num_bytes);});
+
+    //Fill a vector with boundary-aligned points in the memory
+    const size_t mem_start = pad_to_boundary(size_t(mem.get()), alignment);
+    std::vector<ptr_type> ptrs(num_buffs);
+    for (size_t i = 0; i < num_buffs; i++){
+        ptrs[i] = ptr_type(mem_start + padded_buff_size*i);
+    }
+
+    return sptr(new buffer_pool_impl(ptrs, mem));
+#else
+    UHD_LOG_WARNING("BUFF_POOL",
+        "Huge page backing is not supported on this platform; "
+        "allocating buffer pool on normal pages");
+    return make(num_buffs, buff_size, alignment);
+#endif /*UHD_PLATFORM_LINUX*/
+}
@@ -93,7 +93,7 @@ void chdr::if_hdr_pack_le(
 /***************************************************************************/
 /* Unpacking                                                               */
 /***************************************************************************/
-UHD_INLINE void _hdr_unpack_chdr(
+UHD_INLINE unpack_error_t _hdr_unpack_chdr(
         const uint32_t chdr,
         if_packet_info_t &if_packet_info
 ) {
@@ -126,22 +126,86 @@ UHD_INLINE void _hdr_unpack_chdr(
     size_t pkt_size_word32 = (pkt_size_bytes / 4) + ((pkt_size_bytes % 4) ? 1 : 0);
     // Check lengths match:
     if (pkt_size_word32 < if_packet_info.num_header_words32) {
-        throw uhd::value_error("Bad CHDR or invalid packet length");
+        return UNPACK_BAD_LENGTH;
     }
     if (if_packet_info.num_packet_words32 < pkt_size_word32) {
-        throw uhd::value_error("Bad CHDR or packet fragment");
+        return UNPACK_FRAGMENT;
     }
     if_packet_info.num_payload_bytes = pkt_size_bytes - (4 * if_packet_info.num_header_words32);
     if_packet_info.num_payload_words32 = pkt_size_word32 - if_packet_info.num_header_words32;
+    return UNPACK_NO_ERROR;
 }
 
-void chdr::if_hdr_unpack_be(
+//! Convert a non-throwing unpack result into the boundary exception
+static UHD_INLINE void _throw_unpack_error(const unpack_error_t error)
+{
+    switch (error) {
+    case UNPACK_BAD_LENGTH:
+        throw uhd::value_error("Bad CHDR or invalid packet length");
+    case UNPACK_FRAGMENT:
+        throw uhd::value_error("Bad CHDR or packet fragment");
+    case UNPACK_BAD_HEADER:
+        throw uhd::value_error("Bad CHDR header");
+    default:
+        break;
+    }
+}
+
+/*! Branch-free unpack of the dominant case: a data packet with time.
+ *
+ * One masked compare on the header word selects the fast path, and all
+ * fields are then filled with shifts and masks only. Falls back to the
+ * general path (return false) for other packet types, packets without
+ * time, and for the error cases, so the error reporting stays in one
+ * place.
+ */
+UHD_INLINE bool _hdr_unpack_chdr_fast(
+        const uint32_t chdr,
+        if_packet_info_t &if_packet_info
+) {
+    // 2 Bits: Packet type (data = 0), 1 Bit: has time
+    if ((chdr & ((0x3 << 30) | HDR_FLAG_TSF)) != HDR_FLAG_TSF) return false;
+
+    const size_t pkt_size_bytes = chdr & 0xFFFF;
+    const size_t pkt_size_word32 = (pkt_size_bytes + 3) / 4;
+    if (pkt_size_word32 < 4) return false; //bad length, general path throws
+    if (if_packet_info.num_packet_words32 < pkt_size_word32) return false; //fragment
+
+    if_packet_info.link_type = if_packet_info_t::LINK_TYPE_CHDR;
+    if_packet_info.has_cid = false;
+    if_packet_info.has_sid = true;
+    if_packet_info.has_tsi = false;
+    if_packet_info.has_tlr = false;
+    if_packet_info.sob = false;
+    if_packet_info.has_tsf = true;
+    if_packet_info.packet_type = if_packet_info_t::PACKET_TYPE_DATA;
+    if_packet_info.eob = (chdr & HDR_FLAG_EOB) != 0;
+    if_packet_info.error = false;
+    if_packet_info.fc_ack = false;
+    if_packet_info.packet_count = (chdr >> 16) & 0xFFF;
+    if_packet_info.num_header_words32 = 4;
+    if_packet_info.num_payload_bytes = pkt_size_bytes - (4 * 4);
+    if_packet_info.num_payload_words32 = pkt_size_word32 - 4;
+    return true;
+}
+
+unpack_error_t chdr::if_hdr_unpack_be_nothrow(
         const uint32_t *packet_buff,
         if_packet_info_t &if_packet_info
 ) {
     // Read header and update if_packet_info
     uint32_t chdr = BE_MACRO(packet_buff[0]);
-    _hdr_unpack_chdr(chdr, if_packet_info);
+
+    if (_hdr_unpack_chdr_fast(chdr, if_packet_info)) {
+        if_packet_info.sid = BE_MACRO(packet_buff[1]);
+        if_packet_info.tsf = 0
+            | uint64_t(BE_MACRO(packet_buff[2])) << 32
+            | BE_MACRO(packet_buff[3]);
+        return UNPACK_NO_ERROR;
+    }
+
+    const unpack_error_t error = _hdr_unpack_chdr(chdr, if_packet_info);
+    if (error != UNPACK_NO_ERROR) return error;
 
     // Read SID
     if_packet_info.sid = BE_MACRO(packet_buff[1]);
@@ -152,15 +216,26 @@ void chdr::if_hdr_unpack_be(
             | uint64_t(BE_MACRO(packet_buff[2])) << 32
             | BE_MACRO(packet_buff[3]);
     }
+    return UNPACK_NO_ERROR;
 }
 
-void chdr::if_hdr_unpack_le(
+unpack_error_t chdr::if_hdr_unpack_le_nothrow(
         const uint32_t *packet_buff,
         if_packet_info_t &if_packet_info
 ) {
     // Read header and update if_packet_info
     uint32_t chdr = LE_MACRO(packet_buff[0]);
-    _hdr_unpack_chdr(chdr, if_packet_info);
+
+    if (_hdr_unpack_chdr_fast(chdr, if_packet_info)) {
+        if_packet_info.sid = LE_MACRO(packet_buff[1]);
+        if_packet_info.tsf = 0
+            | uint64_t(LE_MACRO(packet_buff[2])) << 32
+            | LE_MACRO(packet_buff[3]);
+        return UNPACK_NO_ERROR;
+    }
+
+    const unpack_error_t error = _hdr_unpack_chdr(chdr, if_packet_info);
+    if (error != UNPACK_NO_ERROR) return error;
 
     // Read SID
     if_packet_info.sid = LE_MACRO(packet_buff[1]);
@@ -171,5 +246,94 @@ void chdr::if_hdr_unpack_le(
             | uint64_t(LE_MACRO(packet_buff[2])) << 32
             | LE_MACRO(packet_buff[3]);
     }
+    return UNPACK_NO_ERROR;
+}
+
+/*! Decode all header fields without the length cross-checks.
+ *
+ * Same field extraction as _hdr_unpack_chdr, minus the bad-length and
+ * fragment tests. Non-data packet types (flow control, responses) still
+ * decode correctly since only validation is skipped, not decoding.
+ */
+UHD_INLINE void _hdr_unpack_chdr_trusted(
+        const uint32_t chdr,
+        if_packet_info_t &if_packet_info
+) {
+    // Set constant members
+    if_packet_info.link_type = if_packet_info_t::LINK_TYPE_CHDR;
+    if_packet_info.has_cid = false;
+    if_packet_info.has_sid = true;
+    if_packet_info.has_tsi = false;
+    if_packet_info.has_tlr = false;
+    if_packet_info.sob = false;
+
+    // Set configurable members
+    if_packet_info.has_tsf = (chdr & HDR_FLAG_TSF) > 0;
+    if_packet_info.packet_type = if_packet_info_t::packet_type_t((chdr >> 30) & 0x3);
+    if_packet_info.eob = (if_packet_info.packet_type == if_packet_info_t::PACKET_TYPE_DATA)
+                         && ((chdr & HDR_FLAG_EOB) > 0);
+    if_packet_info.error = (if_packet_info.packet_type == if_packet_info_t::PACKET_TYPE_RESP)
+                         && ((chdr & HDR_FLAG_ERROR) > 0);
+    if_packet_info.fc_ack = (if_packet_info.packet_type == if_packet_info_t::PACKET_TYPE_FC)
+                         && ((chdr & HDR_FLAG_FCACK) > 0);
+    if_packet_info.packet_count = (chdr >> 16) & 0xFFF;
+
+    // Set packet length variables (trusted: no cross-check against the
+    // buffer size or the header length)
+    if_packet_info.num_header_words32 = if_packet_info.has_tsf ? 4 : 2;
+    const size_t pkt_size_bytes = (chdr & 0xFFFF);
+    const size_t pkt_size_word32 = (pkt_size_bytes + 3) / 4;
+    if_packet_info.num_payload_bytes = pkt_size_bytes - (4 * if_packet_info.num_header_words32);
+    if_packet_info.num_payload_words32 = pkt_size_word32 - if_packet_info.num_header_words32;
+}
+
+unpack_error_t chdr::if_hdr_unpack_be_trusted(
+        const uint32_t *packet_buff,
+        if_packet_info_t &if_packet_info
+) {
+#ifdef UHD_CHDR_ALWAYS_VALIDATE
+    return if_hdr_unpack_be_nothrow(packet_buff, if_packet_info);
+#else
+    _hdr_unpack_chdr_trusted(BE_MACRO(packet_buff[0]), if_packet_info);
+    if_packet_info.sid = BE_MACRO(packet_buff[1]);
+    if (if_packet_info.has_tsf) {
+        if_packet_info.tsf = 0
+            | uint64_t(BE_MACRO(packet_buff[2])) << 32
+            | BE_MACRO(packet_buff[3]);
+    }
+    return UNPACK_NO_ERROR;
+#endif
+}
+
+unpack_error_t chdr::if_hdr_unpack_le_trusted(
+        const uint32_t *packet_buff,
+        if_packet_info_t &if_packet_info
+) {
+#ifdef UHD_CHDR_ALWAYS_VALIDATE
+    return if_hdr_unpack_le_nothrow(packet_buff, if_packet_info);
+#else
+    _hdr_unpack_chdr_trusted(LE_MACRO(packet_buff[0]), if_packet_info);
+    if_packet_info.sid = LE_MACRO(packet_buff[1]);
+    if (if_packet_info.has_tsf) {
+        if_packet_info.tsf = 0
+            | uint64_t(LE_MACRO(packet_buff[2])) << 32
+            | LE_MACRO(packet_buff[3]);
+    }
+    return UNPACK_NO_ERROR;
+#endif
+}
+
+void chdr::if_hdr_unpack_be(
+        const uint32_t *packet_buff,
+        if_packet_info_t &if_packet_info
+) {
+    _throw_unpack_error(if_hdr_unpack_be_nothrow(packet_buff, if_packet_info));
+}
+
+void chdr::if_hdr_unpack_le(
+        const uint32_t *packet_buff,
+        if_packet_info_t &if_packet_info
+) {
+    _throw_unpack_error(if_hdr_unpack_le_nothrow(packet_buff, if_packet_info));
 }
 
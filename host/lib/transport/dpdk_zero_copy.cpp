@@ -0,0 +1,355 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "udp_common.hpp" //MAX_ETHERNET_MTU
+#include <uhdlib/transport/dpdk_zero_copy.hpp>
+#include <uhd/transport/uhd-dpdk.h>
+#include <uhd/utils/log.hpp>
+#include <uhdlib/utils/atomic.hpp>
+#include <boost/format.hpp>
+#include <boost/make_shared.hpp>
+#include <arpa/inet.h>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+using namespace uhd;
+using namespace uhd::transport;
+
+namespace {
+    constexpr size_t DPDK_DEFAULT_NUM_MBUFS = 4095;
+    constexpr size_t DPDK_DEFAULT_MBUF_CACHE_SIZE = 315;
+    constexpr size_t DPDK_DEFAULT_MTU = MAX_ETHERNET_MTU;
+    constexpr uint64_t USEC_PER_SEC = 1000000;
+}
+
+/***********************************************************************
+ * DPDK context singleton
+ **********************************************************************/
+uhd_dpdk_ctx::uhd_dpdk_ctx(void) { /*NOP*/ }
+
+uhd_dpdk_ctx::~uhd_dpdk_ctx(void)
+{
+    if (this->is_init_done()) {
+        uhd_dpdk_destroy();
+    }
+}
+
+uhd_dpdk_ctx::sptr uhd_dpdk_ctx::get(void)
+{
+    static sptr ctx(new uhd_dpdk_ctx());
+    return ctx;
+}
+
+void uhd_dpdk_ctx::init(const device_addr_t &user_args)
+{
+    if (this->is_init_done()) {
+        return;
+    }
+
+    const std::string corelist = user_args.get("dpdk_corelist", "0,1");
+    const int num_mbufs = int(user_args.cast<size_t>(
+        "dpdk_num_mbufs", DPDK_DEFAULT_NUM_MBUFS));
+    const int mbuf_cache_size = int(user_args.cast<size_t>(
+        "dpdk_mbuf_cache_size", DPDK_DEFAULT_MBUF_CACHE_SIZE));
+    const int mtu = int(user_args.cast<size_t>("dpdk_mtu", DPDK_DEFAULT_MTU));
+
+    //build the EAL argument vector
+    std::vector<std::string> args = {"uhd", "-l", corelist};
+    std::vector<char *> argv;
+    for (std::string &arg : args) {
+        argv.push_back(&arg.front());
+    }
+    argv.push_back(NULL);
+
+    //drive all ports from the first I/O thread
+    const unsigned int num_ports = unsigned(user_args.cast<size_t>("dpdk_num_ports", 1));
+    std::vector<int> port_thread_mapping(num_ports, 1);
+
+    const int status = uhd_dpdk_init(
+        int(args.size()), &argv.front(), num_ports,
+        &port_thread_mapping.front(), num_mbufs, mbuf_cache_size, mtu);
+    if (status != 0) {
+        throw uhd::runtime_error(str(
+            boost::format("Failed to init DPDK context (%d)") % status));
+    }
+    UHD_LOG_TRACE("DPDK",
+        "DPDK context initialized with " << uhd_dpdk_port_count() << " port(s)");
+}
+
+bool uhd_dpdk_ctx::is_init_done(void) const
+{
+    return uhd_dpdk_port_count() >= 0;
+}
+
+size_t uhd_dpdk_ctx::get_port_count(void) const
+{
+    const int count = uhd_dpdk_port_count();
+    return (count < 0) ? 0 : size_t(count);
+}
+
+std::string uhd_dpdk_ctx::get_ipv4_addr(const unsigned int port_id) const
+{
+    uint32_t ipv4_addr = 0;
+    if (uhd_dpdk_get_ipv4_addr(port_id, &ipv4_addr, NULL) != 0) {
+        return "";
+    }
+    char buff[INET_ADDRSTRLEN];
+    if (::inet_ntop(AF_INET, &ipv4_addr, buff, sizeof(buff)) == NULL) {
+        return "";
+    }
+    return std::string(buff);
+}
+
+int uhd_dpdk_ctx::get_route(const std::string &addr) const
+{
+    uint32_t dst_addr;
+    if (::inet_pton(AF_INET, addr.c_str(), &dst_addr) != 1) {
+        return -1;
+    }
+    for (size_t port = 0; port < this->get_port_count(); port++) {
+        uint32_t port_addr = 0;
+        uint32_t netmask = 0;
+        if (uhd_dpdk_get_ipv4_addr(unsigned(port), &port_addr, &netmask) != 0) {
+            continue;
+        }
+        if ((port_addr & netmask) == (dst_addr & netmask)) {
+            return int(port);
+        }
+    }
+    return -1;
+}
+
+/***********************************************************************
+ * Reusable managed receive buffer:
+ *  - get_new dequeues a packet buffer from the DPDK socket
+ *  - release frees the packet buffer back to the mbuf pool
+ **********************************************************************/
+class dpdk_zero_copy_mrb : public managed_recv_buffer {
+public:
+    dpdk_zero_copy_mrb(struct uhd_dpdk_socket *sock):
+        _sock(sock), _buf(NULL) { /*NOP*/ }
+
+    void release(void)
+    {
+        if (_buf) {
+            uhd_dpdk_free_buf(_buf);
+            _buf = NULL;
+        }
+        _claimer.release();
+    }
+
+    UHD_INLINE sptr get_new(const double timeout, size_t &index)
+    {
+        if (not _claimer.claim_with_wait(timeout)) return sptr();
+
+        const int num_recvd = uhd_dpdk_recv(
+            _sock, &_buf, 1, unsigned(timeout*USEC_PER_SEC));
+        if (num_recvd > 0) {
+            index++; //advances the caller's buffer
+            return make(this,
+                uhd_dpdk_buf_to_data(_sock, _buf),
+                size_t(uhd_dpdk_get_len(_sock, _buf)));
+        }
+        if (num_recvd < 0) {
+            _claimer.release();
+            throw uhd::io_error(str(
+                boost::format("DPDK recv error (%d)") % num_recvd));
+        }
+
+        _claimer.release(); //undo claim
+        return sptr(); //null for timeout
+    }
+
+private:
+    struct uhd_dpdk_socket *_sock;
+    struct rte_mbuf *_buf;
+    simple_claimer _claimer;
+};
+
+/***********************************************************************
+ * Reusable managed send buffer:
+ *  - get_new requests a packet buffer from the mbuf pool
+ *  - commit enqueues the packet buffer for transmission
+ **********************************************************************/
+class dpdk_zero_copy_msb : public managed_send_buffer {
+public:
+    dpdk_zero_copy_msb(struct uhd_dpdk_socket *sock, const size_t frame_size):
+        _sock(sock), _buf(NULL), _frame_size(frame_size) { /*NOP*/ }
+
+    void release(void)
+    {
+        if (_buf) {
+            struct rte_mbuf *buf = _buf;
+            _buf = NULL;
+            buf->pkt_len = unsigned(size());
+            buf->data_len = uint16_t(size());
+            const int num_sent = uhd_dpdk_send(_sock, &buf, 1);
+            if (num_sent != 1) {
+                uhd_dpdk_free_buf(buf);
+                _claimer.release();
+                throw uhd::io_error("DPDK send failed");
+            }
+        }
+        _claimer.release();
+    }
+
+    UHD_INLINE sptr get_new(const double timeout, size_t &index)
+    {
+        if (not _claimer.claim_with_wait(timeout)) return sptr();
+
+        const int num_bufs = uhd_dpdk_request_tx_bufs(_sock, &_buf, 1);
+        if (num_bufs != 1) {
+            _buf = NULL;
+            _claimer.release(); //undo claim
+            return sptr(); //null for timeout
+        }
+        index++; //advances the caller's buffer
+        return make(this, uhd_dpdk_buf_to_data(_sock, _buf), _frame_size);
+    }
+
+private:
+    struct uhd_dpdk_socket *_sock;
+    struct rte_mbuf *_buf;
+    const size_t _frame_size;
+    simple_claimer _claimer;
+};
+
+/***********************************************************************
+ * Zero copy DPDK transport:
+ * One RX and one TX uhd-dpdk socket on the same local UDP port.
+ **********************************************************************/
+class dpdk_zero_copy_impl : public dpdk_zero_copy {
+public:
+    dpdk_zero_copy_impl(
+        const unsigned int dpdk_port_id,
+        const std::string &addr,
+        const std::string &remote_port,
+        const std::string &local_port,
+        const zero_copy_xport_params &xport_params
+    ):
+        _recv_frame_size(xport_params.recv_frame_size),
+        _num_recv_frames(xport_params.num_recv_frames),
+        _send_frame_size(xport_params.send_frame_size),
+        _num_send_frames(xport_params.num_send_frames),
+        _next_recv_buff_index(0), _next_send_buff_index(0)
+    {
+        UHD_LOGGER_TRACE("DPDK")
+            << boost::format("Creating DPDK transport to %s:%s on port %u")
+            % addr % remote_port % dpdk_port_id;
+
+        uint32_t dst_addr;
+        if (::inet_pton(AF_INET, addr.c_str(), &dst_addr) != 1) {
+            throw uhd::value_error("Invalid IPv4 address: " + addr);
+        }
+
+        struct uhd_dpdk_sockarg_udp sockarg;
+        std::memset(&sockarg, 0, sizeof(sockarg));
+        sockarg.is_tx = false;
+        sockarg.local_port = htons(uint16_t(std::stoul(local_port)));
+        _rx_sock = uhd_dpdk_sock_open(dpdk_port_id, UHD_DPDK_SOCK_UDP, &sockarg);
+        if (_rx_sock == NULL) {
+            throw uhd::runtime_error("Could not open DPDK RX socket");
+        }
+
+        //read back the local port in case it was auto-assigned
+        uhd_dpdk_udp_get_info(_rx_sock, &sockarg);
+
+        sockarg.is_tx = true;
+        sockarg.remote_port = htons(uint16_t(std::stoul(remote_port)));
+        sockarg.dst_addr = dst_addr;
+        _tx_sock = uhd_dpdk_sock_open(dpdk_port_id, UHD_DPDK_SOCK_UDP, &sockarg);
+        if (_tx_sock == NULL) {
+            uhd_dpdk_sock_close(_rx_sock);
+            throw uhd::runtime_error("Could not open DPDK TX socket");
+        }
+
+        //allocate re-usable managed buffer wrappers
+        for (size_t i = 0; i < get_num_recv_frames(); i++) {
+            _mrb_pool.push_back(boost::make_shared<dpdk_zero_copy_mrb>(_rx_sock));
+        }
+        for (size_t i = 0; i < get_num_send_frames(); i++) {
+            _msb_pool.push_back(boost::make_shared<dpdk_zero_copy_msb>(
+                _tx_sock, get_send_frame_size()));
+        }
+    }
+
+    ~dpdk_zero_copy_impl(void)
+    {
+        uhd_dpdk_sock_close(_rx_sock);
+        uhd_dpdk_sock_close(_tx_sock);
+    }
+
+    managed_recv_buffer::sptr get_recv_buff(double timeout)
+    {
+        if (_next_recv_buff_index == _num_recv_frames) _next_recv_buff_index = 0;
+        return _mrb_pool[_next_recv_buff_index]->get_new(timeout, _next_recv_buff_index);
+    }
+
+    size_t get_num_recv_frames(void) const {return _num_recv_frames;}
+    size_t get_recv_frame_size(void) const {return _recv_frame_size;}
+
+    managed_send_buffer::sptr get_send_buff(double timeout)
+    {
+        if (_next_send_buff_index == _num_send_frames) _next_send_buff_index = 0;
+        return _msb_pool[_next_send_buff_index]->get_new(timeout, _next_send_buff_index);
+    }
+
+    size_t get_num_send_frames(void) const {return _num_send_frames;}
+    size_t get_send_frame_size(void) const {return _send_frame_size;}
+
+    uint16_t get_local_port(void) const
+    {
+        struct uhd_dpdk_sockarg_udp sockarg;
+        if (uhd_dpdk_udp_get_info(_rx_sock, &sockarg) != 0) return 0;
+        return ntohs(sockarg.local_port);
+    }
+
+    uint32_t get_drop_count(void) const
+    {
+        uint32_t count = 0;
+        uhd_dpdk_get_drop_count(_rx_sock, &count);
+        return count;
+    }
+
+private:
+    const size_t _recv_frame_size, _num_recv_frames;
+    const size_t _send_frame_size, _num_send_frames;
+    std::vector<boost::shared_ptr<dpdk_zero_copy_mrb> > _mrb_pool;
+    std::vector<boost::shared_ptr<dpdk_zero_copy_msb> > _msb_pool;
+    size_t _next_recv_buff_index, _next_send_buff_index;
+
+    struct uhd_dpdk_socket *_rx_sock;
+    struct uhd_dpdk_socket *_tx_sock;
+};
+
+/***********************************************************************
+ * DPDK zero copy make function
+ **********************************************************************/
+dpdk_zero_copy::sptr dpdk_zero_copy::make(
+    const uhd_dpdk_ctx &ctx,
+    const unsigned int dpdk_port_id,
+    const std::string &addr,
+    const std::string &remote_port,
+    const std::string &local_port,
+    const zero_copy_xport_params &default_buff_args,
+    const device_addr_t &hints
+){
+    UHD_ASSERT_THROW(ctx.is_init_done());
+
+    zero_copy_xport_params xport_params = default_buff_args;
+    xport_params.recv_frame_size = size_t(hints.cast<double>(
+        "recv_frame_size", default_buff_args.recv_frame_size));
+    xport_params.num_recv_frames = size_t(hints.cast<double>(
+        "num_recv_frames", default_buff_args.num_recv_frames));
+    xport_params.send_frame_size = size_t(hints.cast<double>(
+        "send_frame_size", default_buff_args.send_frame_size));
+    xport_params.num_send_frames = size_t(hints.cast<double>(
+        "num_send_frames", default_buff_args.num_send_frames));
+
+    return dpdk_zero_copy::sptr(new dpdk_zero_copy_impl(
+        dpdk_port_id, addr, remote_port, local_port, xport_params));
+}
@@ -10,14 +10,19 @@
 #include <uhd/utils/static.hpp>
 #include <uhd/utils/log.hpp>
 #include <liberio/liberio.h>
+#include <boost/circular_buffer.hpp>
 #include <boost/make_shared.hpp>
 #include <sys/syslog.h>
+#include <algorithm>
 #include <mutex>
 
 namespace uhd { namespace transport {
 
 static const uint64_t USEC = 1000000;
 
+//! Max number of receive buffers to reap from the driver per poll cycle
+static const size_t DEFAULT_RX_REAP_BATCH = 16;
+
 static void liberio_log_cb(int severity, const char *msg, void *)
 {
     switch (severity) {
@@ -101,12 +106,10 @@ public:
             liberio_chan_buf_enqueue(_chan, _buf);
     }
 
-    sptr get_new(double timeout, size_t &index)
+    //! Wrap a buffer that was already dequeued from the driver
+    sptr get_new(liberio_buf *buf, size_t &index)
     {
-        _buf = liberio_chan_buf_dequeue(_chan, timeout * USEC);
-        if (!_buf)
-            return sptr();
-
+        _buf = buf;
         index++;
 
         return make(this, liberio_buf_get_mem(_buf, 0),
@@ -126,6 +129,10 @@ public:
                            const zero_copy_xport_params& xport_params)
                           : _tx_buf_size(xport_params.send_frame_size),
                             _rx_buf_size(xport_params.recv_frame_size),
+                            _rx_reap_batch(std::min(
+                                DEFAULT_RX_REAP_BATCH,
+                                xport_params.num_recv_frames)),
+                            _rx_reaped(xport_params.num_recv_frames),
                             _next_recv_buff_index(0),
                             _next_send_buff_index(0)
     {
@@ -199,6 +206,11 @@ public:
 
     ~liberio_zero_copy_impl(void)
     {
+        /* hand reaped but unconsumed buffers back to the driver */
+        while (!_rx_reaped.empty()) {
+            liberio_chan_buf_enqueue(_rx_chan, _rx_reaped.front());
+            _rx_reaped.pop_front();
+        }
         liberio_chan_put(_tx_chan);
         liberio_chan_put(_rx_chan);
     }
@@ -206,10 +218,30 @@ public:
     managed_recv_buffer::sptr get_recv_buff(double timeout = 0.1)
     {
         std::lock_guard<std::mutex> lock(_rx_mutex);
+        if (_rx_reaped.empty()) {
+            /* reap a batch: the first dequeue pays for the poll
+             * wakeup, then drain whatever else the driver has ready
+             * without waiting, so one poll cycle yields up to a
+             * batch of buffers instead of one
+             */
+            liberio_buf *buf = liberio_chan_buf_dequeue(
+                _rx_chan, timeout * USEC);
+            if (!buf)
+                return managed_recv_buffer::sptr();
+            _rx_reaped.push_back(buf);
+            while (_rx_reaped.size() < _rx_reap_batch) {
+                buf = liberio_chan_buf_dequeue(_rx_chan, 0);
+                if (!buf)
+                    break;
+                _rx_reaped.push_back(buf);
+            }
+        }
+        liberio_buf *buf = _rx_reaped.front();
+        _rx_reaped.pop_front();
         if (_next_recv_buff_index == _num_recv_bufs)
             _next_recv_buff_index = 0;
         return _mrb_pool[_next_recv_buff_index]->get_new(
-            timeout, _next_recv_buff_index);
+            buf, _next_recv_buff_index);
     }
 
     size_t get_num_recv_frames(void) const
@@ -248,6 +280,9 @@ private:
     liberio_chan *_rx_chan;
     const size_t _rx_buf_size;
     size_t _num_recv_bufs;
+    const size_t _rx_reap_batch;
+    //! buffers dequeued from the driver but not yet handed out
+    boost::circular_buffer<liberio_buf *> _rx_reaped;
 
     std::vector<boost::shared_ptr<liberio_zero_copy_mrb> > _mrb_pool;
     size_t _next_recv_buff_index;
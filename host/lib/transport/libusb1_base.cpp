@@ -10,6 +10,8 @@
 
 #include <uhd/utils/log.hpp>
 #include <uhd/utils/tasks.hpp>
+#include <uhd/utils/thread.hpp>
+#include <uhdlib/utils/thread_policy.hpp>
 #include <uhd/types/dict.hpp>
 #include <uhd/types/serial.hpp>
 #include <boost/weak_ptr.hpp>
@@ -17,6 +19,8 @@
 #include <boost/bind.hpp>
 #include <cstdlib>
 #include <iostream>
+#include <sstream>
+#include <vector>
 
 using namespace uhd;
 using namespace uhd::transport;
@@ -30,7 +34,9 @@ libusb::session::~session(void) {
 
 class libusb_session_impl : public libusb::session{
 public:
-    libusb_session_impl(void){
+    libusb_session_impl(const std::vector<size_t> &cpu_affinity = std::vector<size_t>()):
+        _cpu_affinity(cpu_affinity), _thread_tuned(false)
+    {
         UHD_ASSERT_THROW(libusb_init(&_context) == 0);
         libusb_set_debug(_context, debug_level);
         task_handler = task::make(boost::bind(&libusb_session_impl::libusb_event_handler_task, this, _context));
@@ -45,6 +51,8 @@ public:
 private:
     libusb_context *_context;
     task::sptr task_handler;
+    const std::vector<size_t> _cpu_affinity;
+    bool _thread_tuned;
 
     /*
      * Task to handle libusb events.  There should only be one thread per libusb_context handling events.
@@ -54,6 +62,12 @@ private:
      */
     UHD_INLINE void libusb_event_handler_task(libusb_context *context)
     {
+        //one-time setup on the event thread itself
+        if (not _thread_tuned){
+            _thread_tuned = true;
+            uhd::thread_policy::apply("usb_events");
+            if (not _cpu_affinity.empty()) uhd::set_thread_affinity(_cpu_affinity);
+        }
         timeval tv;
         tv.tv_sec = 0;
         tv.tv_usec = 100000;
@@ -98,6 +112,48 @@ libusb::session::sptr libusb::session::get_global_session(void){
     return new_global_session;
 }
 
+libusb::session::sptr libusb::session::get_event_session(void){
+    //parse the requested pool size once; default of one thread
+    //preserves the single global event loop
+    static const size_t pool_size = [](){
+        const char *num_string = getenv("UHD_USB_EVENT_THREADS");
+        if (num_string == NULL) return size_t(1);
+        const int num = atoi(num_string);
+        return (num > 1)? size_t(num) : size_t(1);
+    }();
+    if (pool_size <= 1) return get_global_session();
+
+    //parse the optional comma separated CPU list once
+    static const std::vector<size_t> cpu_list = [](){
+        std::vector<size_t> cpus;
+        const char *cpus_string = getenv("UHD_USB_EVENT_THREAD_AFFINITY");
+        if (cpus_string != NULL){
+            std::stringstream ss(cpus_string);
+            std::string cpu;
+            while (std::getline(ss, cpu, ',')){
+                if (not cpu.empty()) cpus.push_back(size_t(atoi(cpu.c_str())));
+            }
+        }
+        return cpus;
+    }();
+
+    //assign sessions round-robin so each new device handle gets the
+    //least recently used event thread of the pool
+    static boost::mutex mutex;
+    boost::mutex::scoped_lock lock(mutex);
+    static std::vector<boost::weak_ptr<session> > pool(pool_size);
+    static size_t next_index = 0;
+    const size_t index = next_index++ % pool.size();
+
+    if (not pool[index].expired()) return pool[index].lock();
+
+    std::vector<size_t> cpu_affinity;
+    if (not cpu_list.empty()) cpu_affinity.push_back(cpu_list[index % cpu_list.size()]);
+    sptr new_session(new libusb_session_impl(cpu_affinity));
+    pool[index] = new_session;
+    return new_session;
+}
+
 /***********************************************************************
  * libusb device
  **********************************************************************/
@@ -243,11 +299,42 @@ libusb::device_handle::~device_handle(void){
     /* NOP */
 }
 
+//! Find the equivalent of a device from another context by bus address.
+//! Returns a new reference that the caller must unref, or NULL.
+static libusb_device *find_device_in_context(libusb_context *ctx, libusb_device *dev)
+{
+    const uint8_t bus_number = libusb_get_bus_number(dev);
+    const uint8_t device_address = libusb_get_device_address(dev);
+    libusb_device **dev_list;
+    const ssize_t num_devs = libusb_get_device_list(ctx, &dev_list);
+    libusb_device *found = NULL;
+    for (ssize_t i = 0; i < num_devs; i++){
+        if (libusb_get_bus_number(dev_list[i]) == bus_number and
+            libusb_get_device_address(dev_list[i]) == device_address){
+            found = libusb_ref_device(dev_list[i]);
+            break;
+        }
+    }
+    libusb_free_device_list(dev_list, true/*unref*/);
+    return found;
+}
+
 class libusb_device_handle_impl : public libusb::device_handle{
 public:
     libusb_device_handle_impl(libusb::device::sptr dev){
         _dev = dev;
-        UHD_ASSERT_THROW(libusb_open(_dev->get(), &_handle) == 0);
+        _ctx_dev = NULL;
+        //open the device in the context of an event session so that
+        //completion processing spreads over the session pool; with the
+        //default pool of one this is the context the device came from
+        _session = libusb::session::get_event_session();
+        libusb_device *open_dev = dev->get();
+        if (_session != libusb::session::get_global_session()){
+            _ctx_dev = find_device_in_context(_session->get_context(), dev->get());
+            UHD_ASSERT_THROW(_ctx_dev != NULL);
+            open_dev = _ctx_dev;
+        }
+        UHD_ASSERT_THROW(libusb_open(open_dev, &_handle) == 0);
     }
 
     virtual ~libusb_device_handle_impl(void);
@@ -278,6 +365,8 @@ public:
 
 private:
     libusb::device::sptr _dev; //always keep a reference to device
+    libusb::session::sptr _session; //keeps the event thread alive
+    libusb_device *_ctx_dev; //device reference in the session context
     libusb_device_handle *_handle;
     std::vector<int> _claimed;
 };
@@ -288,6 +377,7 @@ libusb_device_handle_impl::~libusb_device_handle_impl(void){
         libusb_release_interface(this->get(), _claimed[i]);
     }
     libusb_close(_handle);
+    if (_ctx_dev != NULL) libusb_unref_device(_ctx_dev);
 }
 
 libusb::device_handle::sptr libusb::device_handle::get_cached_handle(device::sptr dev){
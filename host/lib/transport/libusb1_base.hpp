@@ -71,6 +71,19 @@ namespace libusb {
         //! get a shared pointer to the global session
         static sptr get_global_session(void);
 
+        /*!
+         * Get a session to handle events for a new device handle.
+         *
+         * By default this is the global session, and one thread handles
+         * event completions for every device. Set the environment
+         * variable UHD_USB_EVENT_THREADS to a number N > 1 to spread
+         * device handles round-robin over a pool of N sessions, each
+         * with its own libusb context and event thread. The environment
+         * variable UHD_USB_EVENT_THREAD_AFFINITY can hold a comma
+         * separated list of CPU numbers to pin the pool threads to.
+         */
+        static sptr get_event_session(void);
+
         //! get the underlying libusb context pointer
         virtual libusb_context *get_context(void) const = 0;
     };
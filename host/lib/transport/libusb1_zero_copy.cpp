@@ -18,6 +18,7 @@
 #include <boost/circular_buffer.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/condition_variable.hpp>
+#include <cstring>
 #include <list>
 
 #ifdef UHD_TXRX_DEBUG_PRINTS
@@ -92,7 +93,27 @@ static void LIBUSB_CALL libusb_async_cb(libusb_transfer *lut)
     lut_result_t *r = (lut_result_t *)lut->user_data;
     boost::lock_guard<boost::mutex> lock(r->mut);
     r->status = lut->status;
-    r->actual_length = lut->actual_length;
+    if (lut->type == LIBUSB_TRANSFER_TYPE_ISOCHRONOUS and (lut->endpoint & 0x80))
+    {
+        //isochronous recv: payload arrives in fixed per-packet slots,
+        //so compact the completed packets into a contiguous block and
+        //report the total; short or errored packets are simply skipped
+        //(iso has no retries - degradation is data loss, not stalling)
+        int total = 0;
+        for (int i = 0; i < lut->num_iso_packets; i++)
+        {
+            const libusb_iso_packet_descriptor &desc = lut->iso_packet_desc[i];
+            if (desc.status != LIBUSB_TRANSFER_COMPLETED or desc.actual_length == 0) continue;
+            unsigned char *src = libusb_get_iso_packet_buffer_simple(lut, (unsigned int)(i));
+            if (src != lut->buffer + total)
+            {
+                std::memmove(lut->buffer + total, src, desc.actual_length);
+            }
+            total += desc.actual_length;
+        }
+        r->actual_length = total;
+    }
+    else r->actual_length = lut->actual_length;
     r->completed = 1;
     r->usb_transfer_complete.notify_one();  // wake up thread waiting in wait_for_completion() member function below
 #ifdef UHD_TXRX_DEBUG_PRINTS
@@ -123,6 +144,19 @@ public:
     UHD_INLINE void submit(void)
     {
         _lut->length = int((_is_recv)? _frame_size : size()); //always set length
+        if (_lut->type == LIBUSB_TRANSFER_TYPE_ISOCHRONOUS)
+        {
+            //spread the transfer length across the iso packet slots;
+            //for send the last packets of a partial commit go out short
+            size_t remaining = size_t(_lut->length);
+            const size_t slot = _frame_size/size_t(_lut->num_iso_packets);
+            for (int i = 0; i < _lut->num_iso_packets; i++)
+            {
+                const size_t len = (remaining < slot)? remaining : slot;
+                _lut->iso_packet_desc[i].length = (unsigned int)(len);
+                remaining -= len;
+            }
+        }
 #ifdef UHD_TXRX_DEBUG_PRINTS
         result.start_time = boost::get_system_time().time_of_day().total_microseconds();
         result.buff_num = num();
@@ -187,28 +221,89 @@ libusb_zero_copy_mb::~libusb_zero_copy_mb(void) {
 /***********************************************************************
  * USB zero_copy device class
  **********************************************************************/
+
+//! walk the active config descriptor to check the endpoint's transfer type
+static bool endpoint_is_isochronous(
+    libusb::device_handle::sptr handle, const unsigned char endpoint
+){
+    libusb_config_descriptor *config = NULL;
+    if (libusb_get_active_config_descriptor(
+        libusb_get_device(handle->get()), &config) != LIBUSB_SUCCESS) return false;
+    bool is_iso = false;
+    for (int i = 0; i < config->bNumInterfaces; i++)
+    {
+        const libusb_interface &iface = config->interface[i];
+        for (int j = 0; j < iface.num_altsetting; j++)
+        {
+            const libusb_interface_descriptor &desc = iface.altsetting[j];
+            for (int k = 0; k < desc.bNumEndpoints; k++)
+            {
+                const libusb_endpoint_descriptor &ep = desc.endpoint[k];
+                if (ep.bEndpointAddress == endpoint and
+                    (ep.bmAttributes & 0x3) == LIBUSB_TRANSFER_TYPE_ISOCHRONOUS)
+                {
+                    is_iso = true;
+                }
+            }
+        }
+    }
+    libusb_free_config_descriptor(config);
+    return is_iso;
+}
+
 class libusb_zero_copy_single
 {
 public:
+    /*!
+     * \param extra_frames additional buffers beyond num_frames that are
+     * only submitted when the in-flight target grows under starvation.
+     * Must be zero for send endpoints: a parked send buffer cannot be
+     * told apart from one that carries payload waiting for submission.
+     */
     libusb_zero_copy_single(
         libusb::device_handle::sptr handle,
         const int interface, const unsigned char endpoint,
-        const size_t num_frames, const size_t frame_size
+        const size_t num_frames, const size_t frame_size,
+        const size_t extra_frames = 0,
+        const size_t num_iso_packets = 0
     ):
         _handle(handle),
         _num_frames(num_frames),
         _frame_size(frame_size),
-        _buffer_pool(buffer_pool::make(_num_frames, _frame_size)),
-        _enqueued(_num_frames), _released(_num_frames),
+        _total_frames(num_frames + extra_frames),
+        _num_iso_packets(num_iso_packets),
+        _buffer_pool(buffer_pool::make(_total_frames, _frame_size)),
+        _enqueued(_total_frames), _released(_total_frames),
+        _target_inflight(num_frames),
+        _non_starved_count(0),
         _status(STATUS_RUNNING)
     {
         const bool is_recv = (endpoint & 0x80) != 0;
+        UHD_ASSERT_THROW(is_recv or extra_frames == 0);
         const std::string name = str(boost::format("%s%d") % ((is_recv)? "rx" : "tx") % int(endpoint & 0x7f));
         _handle->claim_interface(interface);
 
+        //isochronous transfers are only valid on an iso endpoint; fall
+        //back to bulk when the device descriptor says otherwise so a
+        //misapplied device arg degrades instead of failing to stream
+        if (_num_iso_packets > 0 and not endpoint_is_isochronous(handle, (is_recv)? endpoint : (unsigned char)(endpoint & 0x7f)))
+        {
+            UHD_LOGGER_WARNING("USB") << boost::format(
+                "usb_iso_packets requested but endpoint %s is not isochronous, using bulk transfers"
+            ) % name;
+            _num_iso_packets = 0;
+        }
+        if (_num_iso_packets > 0 and (_frame_size % _num_iso_packets) != 0)
+        {
+            throw uhd::value_error(str(boost::format(
+                "usb_iso_packets (%u) must evenly divide the frame size (%u)"
+            ) % _num_iso_packets % _frame_size));
+        }
+
         //flush the buffers out of the recv endpoint
         //limit the flushing to at most one second
-        if (is_recv) for (size_t i = 0; i < 100; i++)
+        //(iso endpoints do not queue stale data and cannot be bulk-read)
+        if (is_recv and _num_iso_packets == 0) for (size_t i = 0; i < 100; i++)
         {
             unsigned char buff[512];
             int transfered = 0;
@@ -224,16 +319,35 @@ public:
         }
 
         //allocate libusb transfer structs and managed buffers
-        for (size_t i = 0; i < get_num_frames(); i++)
+        for (size_t i = 0; i < _total_frames; i++)
         {
-            libusb_transfer *lut = libusb_alloc_transfer(0);
+            libusb_transfer *lut = libusb_alloc_transfer(int(_num_iso_packets));
             UHD_ASSERT_THROW(lut != NULL);
 
             _mb_pool.push_back(boost::make_shared<libusb_zero_copy_mb>(
                 lut, this->get_frame_size(), boost::bind(&libusb_zero_copy_single::enqueue_buffer, this, _1), is_recv, name
             ));
 
-            libusb_fill_bulk_transfer(
+            if (_num_iso_packets > 0)
+            {
+                //multi-packet URBs: the controller reserves periodic
+                //bandwidth for the endpoint and services every packet
+                //slot per interval without bulk arbitration
+                libusb_fill_iso_transfer(
+                    lut,                                                    // transfer
+                    _handle->get(),                                         // dev_handle
+                    endpoint,                                               // endpoint
+                    static_cast<unsigned char *>(_buffer_pool->at(i)),      // buffer
+                    int(this->get_frame_size()),                            // length
+                    int(_num_iso_packets),                                  // num_iso_packets
+                    libusb_transfer_cb_fn(&libusb_async_cb),                // callback
+                    static_cast<void *>(&_mb_pool.back()->result),          // user_data
+                    0                                                       // timeout (ms)
+                );
+                libusb_set_iso_packet_lengths(
+                    lut, (unsigned int)(this->get_frame_size()/_num_iso_packets));
+            }
+            else libusb_fill_bulk_transfer(
                 lut,                                                    // transfer
                 _handle->get(),                                         // dev_handle
                 endpoint,                                               // endpoint
@@ -248,7 +362,9 @@ public:
         }
 
         //initial release for all buffers
-        for (size_t i = 0; i < get_num_frames(); i++)
+        //for recv, extra buffers park in the released queue until the
+        //in-flight target grows; for send there are no extra buffers
+        for (size_t i = 0; i < _total_frames; i++)
         {
             libusb_zero_copy_mb &mb = *(_mb_pool[i]);
             if (is_recv) mb.release();
@@ -295,8 +411,20 @@ public:
         boost::mutex::scoped_lock queue_lock(_queue_mutex);
         if (_enqueued.empty())
         {
+            //An empty queue means every transfer is either held by the
+            //caller or awaiting resubmission: zero URBs are in flight
+            //and a recv endpoint can drop packets. Deepen the pipeline
+            //into the extra buffers to ride out scheduler jitter.
+            if (_target_inflight < _total_frames) _target_inflight++;
+            _non_starved_count = 0;
             _buff_ready_cond.timed_wait(queue_lock, boost::posix_time::microseconds(long(timeout*1e6)));
         }
+        else if (_target_inflight > _num_frames and ++_non_starved_count > 4096)
+        {
+            //shrink slowly back to the nominal depth when keeping up
+            _target_inflight--;
+            _non_starved_count = 0;
+        }
         if (_enqueued.empty()) return buff;
         libusb_zero_copy_mb *front = _enqueued.front();
 
@@ -314,7 +442,9 @@ public:
 
 private:
     libusb::device_handle::sptr _handle;
-    const size_t _num_frames, _frame_size;
+    const size_t _num_frames, _frame_size, _total_frames;
+    //! iso packets per transfer, 0 = bulk endpoint
+    size_t _num_iso_packets;
 
     //! Storage for transfer related objects
     buffer_pool::sptr _buffer_pool;
@@ -324,9 +454,15 @@ private:
     boost::condition_variable _buff_ready_cond;
     boost::mutex _get_buff_mutex;
 
-    //! why 2 queues? there is room in the future to have > N buffers but only N in flight
+    //! why 2 queues? there can be > N buffers but only the in-flight
+    //! target number submitted; the rest wait in the released queue
     boost::circular_buffer<libusb_zero_copy_mb *> _enqueued, _released;
 
+    //! adaptive in-flight transfer depth: starts at the nominal frame
+    //! count and grows toward the total on observed URB starvation
+    size_t _target_inflight;
+    size_t _non_starved_count;
+
     enum {STATUS_RUNNING, STATUS_ERROR} _status;
 
     void enqueue_buffer(libusb_zero_copy_mb *mb)
@@ -341,7 +477,7 @@ private:
     {
         if (_status == STATUS_ERROR)
             return;
-        while (not _released.empty() and not _enqueued.full())
+        while (not _released.empty() and _enqueued.size() < _target_inflight)
         {
             try {
                 _released.front()->submit();
@@ -373,14 +509,27 @@ struct libusb_zero_copy_impl : usb_zero_copy
         const unsigned char send_endpoint,
         const device_addr_t &hints
     ){
+        const size_t num_recv_frames =
+            size_t(hints.cast<double>("num_recv_frames", DEFAULT_NUM_XFERS));
+        //extra recv buffers allow the in-flight transfer depth to grow
+        //past the nominal frame count under URB starvation
+        const size_t extra_recv_frames =
+            (hints.cast<double>("usb_adaptive_xfers", 1.0) != 0.0)? num_recv_frames : 0;
+        //usb_iso_packets selects isochronous transfers with that many
+        //packets per URB; only honored when the endpoint is actually
+        //isochronous (guaranteed bus bandwidth instead of arbitration)
+        const size_t num_iso_packets =
+            size_t(hints.cast<double>("usb_iso_packets", 0.0));
         _recv_impl.reset(new libusb_zero_copy_single(
             handle, recv_interface, (recv_endpoint & 0x7f) | 0x80,
-            size_t(hints.cast<double>("num_recv_frames", DEFAULT_NUM_XFERS)),
-            size_t(hints.cast<double>("recv_frame_size", DEFAULT_XFER_SIZE))));
+            num_recv_frames,
+            size_t(hints.cast<double>("recv_frame_size", DEFAULT_XFER_SIZE)),
+            extra_recv_frames, num_iso_packets));
         _send_impl.reset(new libusb_zero_copy_single(
             handle, send_interface, (send_endpoint & 0x7f) | 0x00,
             size_t(hints.cast<double>("num_send_frames", DEFAULT_NUM_XFERS)),
-            size_t(hints.cast<double>("send_frame_size", DEFAULT_XFER_SIZE))));
+            size_t(hints.cast<double>("send_frame_size", DEFAULT_XFER_SIZE)),
+            0, num_iso_packets));
     }
 
     virtual ~libusb_zero_copy_impl(void);
@@ -9,11 +9,16 @@
 #include <uhd/transport/bounded_buffer.hpp>
 #include <uhd/exception.hpp>
 #include <uhd/utils/safe_call.hpp>
+#include <uhd/utils/thread.hpp>
+#include <uhdlib/utils/thread_policy.hpp>
 #include <boost/enable_shared_from_this.hpp>
+#include <boost/foreach.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/thread.hpp>
 #include <boost/thread/locks.hpp>
 #include <map>
+#include <vector>
+#include <atomic>
 #include <chrono>
 #include <thread>
 
@@ -29,11 +34,19 @@ public:
     muxed_zero_copy_if_impl(
         zero_copy_if::sptr base_xport,
         stream_classifier_fn classify_fn,
-        size_t max_streams
+        size_t max_streams,
+        const bool low_latency
     ):
         _base_xport(base_xport), _classify(classify_fn),
-        _max_num_streams(max_streams), _num_dropped_frames(0)
+        _max_num_streams(max_streams), _num_dropped_frames(0),
+        _low_latency(low_latency), _have_priority_stream(false)
     {
+        //Size the demux hash table to a power of two at no more than
+        //half load so that probe sequences stay short and an empty
+        //slot always terminates an unsuccessful lookup.
+        size_t table_size = 2;
+        while (table_size < 2 * max_streams) table_size *= 2;
+        _stream_table = boost::make_shared<stream_table_t>(table_size);
         //Create the receive thread to poll the underlying transport
         //and classify packets into queues
         _recv_thread = boost::thread(
@@ -60,7 +73,7 @@ public:
         );
     }
 
-    virtual zero_copy_if::sptr make_stream(const uint32_t stream_num)
+    virtual zero_copy_if::sptr make_stream(const uint32_t stream_num, const bool priority)
     {
         boost::lock_guard<boost::mutex> lock(_mutex);
         if (_streams.size() >= _max_num_streams) {
@@ -71,8 +84,11 @@ public:
         stream_impl::sptr stream = boost::make_shared<stream_impl>(
             this->shared_from_this(), stream_num,
             _base_xport->get_num_send_frames() / _max_num_streams,
-            _base_xport->get_num_recv_frames() / _max_num_streams);
+            _base_xport->get_num_recv_frames() / _max_num_streams,
+            priority);
         _streams[stream_num] = stream;
+        if (priority) _have_priority_stream = true;
+        _publish_stream_table();
         return stream;
     }
 
@@ -85,6 +101,7 @@ public:
     {
         boost::lock_guard<boost::mutex> lock(_mutex);
         _streams.erase(stream_num);
+        _publish_stream_table();
     }
 
 private:
@@ -123,7 +140,8 @@ private:
             muxed_zero_copy_if_impl::sptr muxed_xport,
             const uint32_t stream_num,
             const size_t num_send_frames,
-            const size_t num_recv_frames
+            const size_t num_recv_frames,
+            const bool priority
             ) :
             _stream_num(stream_num), _muxed_xport(muxed_xport),
             _num_send_frames(num_send_frames),
@@ -132,7 +150,9 @@ private:
             _recv_frame_size(_muxed_xport->base_xport()->get_recv_frame_size()),
             _buff_queue(num_recv_frames),
             _buffers(num_recv_frames),
-            _buffer_index(0)
+            _buffer_index(0),
+            _priority(priority),
+            _approx_occupancy(0)
         {
             for (size_t i = 0; i < num_recv_frames; i++) {
                 _buffers[i] = boost::make_shared<stream_mrb>(_recv_frame_size);
@@ -162,6 +182,7 @@ private:
         managed_recv_buffer::sptr get_recv_buff(double timeout) {
             managed_recv_buffer::sptr buff;
             if (_buff_queue.pop_with_timed_wait(buff, timeout)) {
+                _approx_occupancy--;
                 return buff;
             } else {
                 return managed_recv_buffer::sptr();
@@ -171,6 +192,25 @@ private:
         void push_recv_buff(managed_recv_buffer::sptr buff) {
             _buff_queue.push_with_wait(_buffers.at(_buffer_index++)->get_new(buff->cast<char*>(), buff->size()));
             _buffer_index %= _buffers.size();
+            _approx_occupancy++;
+        }
+
+        /*!
+         * Push a buffer without ever blocking the demux thread.
+         * Only the consumer decrements the occupancy, so a stale
+         * reading can only err towards "full" - the push below then
+         * never waits, it drops instead.
+         * \return false when the queue was full and the frame dropped
+         */
+        bool push_recv_buff_haste(managed_recv_buffer::sptr buff) {
+            if (_approx_occupancy.load() >= _num_recv_frames) return false;
+            this->push_recv_buff(buff);
+            return true;
+        }
+
+        //! True when this stream carries latency-sensitive traffic
+        bool is_priority(void) const {
+            return _priority;
         }
 
         size_t get_num_send_frames(void) const {
@@ -196,12 +236,21 @@ private:
         bounded_buffer<managed_recv_buffer::sptr>   _buff_queue;
         std::vector< boost::shared_ptr<stream_mrb> >    _buffers;
         size_t                                      _buffer_index;
+        const bool                                  _priority;
+        std::atomic<size_t>                         _approx_occupancy;
     };
 
     inline zero_copy_if::sptr& base_xport() { return _base_xport; }
 
     void _update_queues()
     {
+        if (_low_latency) {
+            //Control responses ride this thread: take the configured
+            //role policy (pinning) and an elevated priority, and poll
+            //the base transport instead of sleeping when idle.
+            thread_policy::apply("ctrl_mux");
+            set_thread_priority_safe();
+        }
         //Run forever:
         // - Pull packets from the base transport
         // - Classify them
@@ -209,7 +258,7 @@ private:
         while (true) {
             {   //Uninterruptable block of code
                 boost::this_thread::disable_interruption interrupt_disabler;
-                if (not _process_next_buffer()) {
+                if (not _process_next_buffer() and not _low_latency) {
                     //Be a good citizen and yield if no packet is processed
                     static const size_t MIN_DUR = 1;
                     std::this_thread::sleep_for(std::chrono::nanoseconds(MIN_DUR));
@@ -242,14 +291,19 @@ private:
             stream_impl::sptr stream;
             try {
                 const uint32_t stream_num = _classify(buff->cast<void*>(), _base_xport->get_recv_frame_size());
-                {
-                    //Hold the stream mutex long enough to pull a bounded buffer
-                    //and lock it (increment its ref count).
-                    boost::lock_guard<boost::mutex> lock(_mutex);
-                    stream_map_t::iterator str_iter = _streams.find(stream_num);
-                    if (str_iter != _streams.end()) {
-                        stream = (*str_iter).second.lock();
+                //Classify against an immutable snapshot of the stream
+                //table. Writers publish a rebuilt table atomically, so
+                //the lookup takes no lock and usually a single probe.
+                const boost::shared_ptr<const stream_table_t> table =
+                    boost::atomic_load(&_stream_table);
+                const size_t mask = table->size() - 1;
+                size_t slot = _hash_stream_num(stream_num) & mask;
+                while ((*table)[slot].valid) {
+                    if ((*table)[slot].stream_num == stream_num) {
+                        stream = (*table)[slot].stream.lock();
+                        break;
                     }
+                    slot = (slot + 1) & mask;
                 }
             } catch (std::exception&) {
                 //If _classify throws we simply drop the frame
@@ -257,7 +311,18 @@ private:
             //Once a bounded buffer is acquired, we can rely on its
             //thread safety to serialize with the consumer.
             if (stream.get()) {
-                stream->push_recv_buff(buff);
+                //With a priority stream registered, bulk streams must
+                //not head-of-line block the demux thread: drop on a
+                //full queue so a control response behind the bulk
+                //frame is delivered right away.
+                if (_have_priority_stream and not stream->is_priority()) {
+                    if (not stream->push_recv_buff_haste(buff)) {
+                        boost::lock_guard<boost::mutex> lock(_mutex);
+                        _num_dropped_frames++;
+                    }
+                } else {
+                    stream->push_recv_buff(buff);
+                }
             } else {
                 boost::lock_guard<boost::mutex> lock(_mutex);
                 _num_dropped_frames++;
@@ -274,11 +339,55 @@ private:
 
     typedef std::map<uint32_t, stream_impl::wptr> stream_map_t;
 
+    //! One slot of the open-addressing demux hash table
+    struct stream_entry_t
+    {
+        stream_entry_t(void) : valid(false), stream_num(0) {}
+        bool                valid;
+        uint32_t            stream_num;
+        stream_impl::wptr   stream;
+    };
+    typedef std::vector<stream_entry_t> stream_table_t;
+
+    //! Knuth multiplicative hash; the table mask picks the low bits
+    static UHD_INLINE size_t _hash_stream_num(const uint32_t stream_num)
+    {
+        return size_t(stream_num * uint32_t(2654435761u));
+    }
+
+    /*!
+     * Rebuild the demux hash table from the stream map and publish it
+     * atomically for the receive thread (RCU-style: readers keep using
+     * the old snapshot until they load the new pointer).
+     * Requires the caller to hold _mutex.
+     */
+    void _publish_stream_table(void)
+    {
+        boost::shared_ptr<stream_table_t> table =
+            boost::make_shared<stream_table_t>(_stream_table->size());
+        const size_t mask = table->size() - 1;
+        BOOST_FOREACH(const stream_map_t::value_type &pair, _streams) {
+            size_t slot = _hash_stream_num(pair.first) & mask;
+            while ((*table)[slot].valid) {
+                slot = (slot + 1) & mask;
+            }
+            (*table)[slot].valid = true;
+            (*table)[slot].stream_num = pair.first;
+            (*table)[slot].stream = pair.second;
+        }
+        boost::atomic_store(
+            &_stream_table, boost::shared_ptr<const stream_table_t>(table));
+    }
+
     zero_copy_if::sptr      _base_xport;
     stream_classifier_fn    _classify;
     stream_map_t            _streams;
+    boost::shared_ptr<const stream_table_t> _stream_table;
     const size_t            _max_num_streams;
     size_t                  _num_dropped_frames;
+    const bool              _low_latency;
+    //! set once under _mutex, read lock-free by the demux thread
+    std::atomic<bool>       _have_priority_stream;
     boost::thread           _recv_thread;
     boost::mutex            _mutex;
 };
@@ -286,7 +395,8 @@ private:
 muxed_zero_copy_if::sptr muxed_zero_copy_if::make(
     zero_copy_if::sptr base_xport,
     muxed_zero_copy_if::stream_classifier_fn classify_fn,
-    size_t max_streams
+    size_t max_streams,
+    const bool low_latency
 ) {
-    return boost::make_shared<muxed_zero_copy_if_impl>(base_xport, classify_fn, max_streams);
+    return boost::make_shared<muxed_zero_copy_if_impl>(base_xport, classify_fn, max_streams, low_latency);
 }
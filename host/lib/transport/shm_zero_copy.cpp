@@ -0,0 +1,416 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/transport/shm_zero_copy.hpp>
+#include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
+#include <boost/format.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/thread/mutex.hpp>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <vector>
+
+#ifdef UHD_PLATFORM_LINUX
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+using namespace uhd;
+using namespace uhd::transport;
+
+static const size_t SHM_ZERO_COPY_DEFAULT_FRAME_SIZE = 8192;
+static const size_t SHM_ZERO_COPY_DEFAULT_NUM_FRAMES = 32;
+
+shm_zero_copy::~shm_zero_copy(void){
+    /* NOP */
+}
+
+#ifdef UHD_PLATFORM_LINUX
+
+/***********************************************************************
+ * Shared segment layout
+ *
+ * One control page followed by two rings (direction 0: creator to
+ * attacher, direction 1: the reverse). Each ring is a committed-length
+ * array and a frame region; the indices are free-running 32-bit
+ * counters, so (tail - head) is the ring occupancy across the wrap.
+ **********************************************************************/
+static const uint32_t SHM_ZC_MAGIC = 0x55485A43; //'UHZC'
+static const size_t SHM_ZC_CTRL_BYTES = 4096;
+
+struct shm_zc_ring_ctrl_t{
+    std::atomic<uint32_t> tail;         //frames produced (committed)
+    std::atomic<uint32_t> tail_waiters; //consumers blocked on the doorbell
+    char _pad0[56];
+    std::atomic<uint32_t> head;         //frames consumed and released
+    std::atomic<uint32_t> head_waiters; //producers blocked on a full ring
+    char _pad1[56];
+};
+
+struct shm_zc_ctrl_t{
+    std::atomic<uint32_t> magic; //set last by the creator
+    uint32_t num_frames[2];
+    uint32_t frame_size[2];
+    shm_zc_ring_ctrl_t ring[2];
+};
+
+static UHD_INLINE size_t round_up_64(const size_t bytes){
+    return (bytes + 63) & ~size_t(63);
+}
+
+static UHD_INLINE size_t ring_bytes(const size_t num_frames, const size_t frame_size){
+    return round_up_64(num_frames * sizeof(uint32_t)) + num_frames * frame_size;
+}
+
+/***********************************************************************
+ * Futex doorbell helpers (process-shared, hence no PRIVATE flag)
+ **********************************************************************/
+static UHD_INLINE void futex_wake_all(std::atomic<uint32_t> *word){
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(word),
+        FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+/*!
+ * Wait until the futex word moves past the seen value or the deadline
+ * expires. Returns true when the word changed.
+ */
+static bool futex_wait_for_change(
+    std::atomic<uint32_t> *word,
+    std::atomic<uint32_t> *waiters,
+    const uint32_t seen,
+    const std::chrono::steady_clock::time_point &deadline
+){
+    while (word->load(std::memory_order_acquire) == seen){
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) return false;
+        const auto remaining =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now);
+        struct timespec ts;
+        ts.tv_sec = remaining.count() / 1000000000ll;
+        ts.tv_nsec = remaining.count() % 1000000000ll;
+        waiters->fetch_add(1, std::memory_order_seq_cst);
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(word),
+            FUTEX_WAIT, seen, &ts, NULL, 0);
+        waiters->fetch_sub(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+static UHD_INLINE void ring_doorbell(
+    std::atomic<uint32_t> *word, std::atomic<uint32_t> *waiters
+){
+    if (waiters->load(std::memory_order_seq_cst) != 0) futex_wake_all(word);
+}
+
+class shm_zero_copy_impl;
+
+/***********************************************************************
+ * Managed buffers bound to fixed ring slots
+ **********************************************************************/
+class shm_zero_copy_mrb : public managed_recv_buffer{
+public:
+    shm_zero_copy_mrb(shm_zero_copy_impl *impl, void *mem, const size_t index):
+        _impl(impl), _mem(mem), _index(index) { /*NOP*/ }
+
+    void release(void); //defined below, advances the shared head
+
+    UHD_INLINE sptr get_new(const size_t len){
+        return make(this, _mem, len);
+    }
+
+private:
+    shm_zero_copy_impl *_impl;
+    void *_mem;
+    const size_t _index;
+};
+
+class shm_zero_copy_msb : public managed_send_buffer{
+public:
+    shm_zero_copy_msb(shm_zero_copy_impl *impl, void *mem, const size_t index, const size_t frame_size):
+        _impl(impl), _mem(mem), _index(index), _frame_size(frame_size) { /*NOP*/ }
+
+    void release(void); //defined below, commits the slot to the peer
+
+    UHD_INLINE sptr get_new(void){
+        return make(this, _mem, _frame_size);
+    }
+
+private:
+    shm_zero_copy_impl *_impl;
+    void *_mem;
+    const size_t _index;
+    const size_t _frame_size;
+};
+
+/***********************************************************************
+ * Zero copy transport over a shared-memory ring pair
+ *
+ * Like the wire transports, one thread receives and one thread sends
+ * per transport; buffers may be released/committed from any thread.
+ **********************************************************************/
+class shm_zero_copy_impl : public shm_zero_copy{
+public:
+    typedef boost::shared_ptr<shm_zero_copy_impl> sptr;
+
+    shm_zero_copy_impl(const std::string &name, const device_addr_t &hints):
+        _recv_seq(0), _send_seq(0)
+    {
+        _path = (name.empty() or name[0] != '/')? "/" + name : name;
+
+        //the first process to open the name creates and sizes the
+        //segment, the second one attaches and adopts its geometry
+        int fd = ::shm_open(_path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        _creator = (fd >= 0);
+        if (not _creator){
+            if (errno != EEXIST) throw uhd::io_error(str(boost::format(
+                "shm_open(%s) failed: %s") % _path % std::strerror(errno)));
+            fd = ::shm_open(_path.c_str(), O_RDWR, 0600);
+            if (fd < 0) throw uhd::io_error(str(boost::format(
+                "shm_open(%s) failed: %s") % _path % std::strerror(errno)));
+        }
+
+        try{
+            if (_creator) this->create_segment(fd, hints);
+            else this->attach_segment(fd);
+        }
+        catch(...){
+            ::close(fd);
+            if (_creator) ::shm_unlink(_path.c_str());
+            throw;
+        }
+        ::close(fd);
+
+        //the creator sends on ring 0, the attacher on ring 1
+        const size_t tx_dir = _creator? 0 : 1;
+        const size_t rx_dir = _creator? 1 : 0;
+        _tx_ring = &_ctrl->ring[tx_dir];
+        _rx_ring = &_ctrl->ring[rx_dir];
+        _num_send_frames = _ctrl->num_frames[tx_dir];
+        _send_frame_size = _ctrl->frame_size[tx_dir];
+        _num_recv_frames = _ctrl->num_frames[rx_dir];
+        _recv_frame_size = _ctrl->frame_size[rx_dir];
+
+        char *base = reinterpret_cast<char *>(_ctrl) + SHM_ZC_CTRL_BYTES;
+        char *dir_base[2];
+        dir_base[0] = base;
+        dir_base[1] = base + ring_bytes(_ctrl->num_frames[0], _ctrl->frame_size[0]);
+        _tx_lens = reinterpret_cast<uint32_t *>(dir_base[tx_dir]);
+        _rx_lens = reinterpret_cast<uint32_t *>(dir_base[rx_dir]);
+        char *tx_frames = dir_base[tx_dir] + round_up_64(_num_send_frames * sizeof(uint32_t));
+        char *rx_frames = dir_base[rx_dir] + round_up_64(_num_recv_frames * sizeof(uint32_t));
+
+        _recv_released.resize(_num_recv_frames, 0);
+        _send_committed.resize(_num_send_frames, 0);
+        for (size_t i = 0; i < _num_recv_frames; i++) _mrb_pool.push_back(
+            boost::shared_ptr<shm_zero_copy_mrb>(new shm_zero_copy_mrb(
+                this, rx_frames + i * _recv_frame_size, i)));
+        for (size_t i = 0; i < _num_send_frames; i++) _msb_pool.push_back(
+            boost::shared_ptr<shm_zero_copy_msb>(new shm_zero_copy_msb(
+                this, tx_frames + i * _send_frame_size, i, _send_frame_size)));
+
+        UHD_LOGGER_DEBUG("SHM") << boost::format(
+            "Opened shm transport %s as %s: %u recv frames x %u bytes, %u send frames x %u bytes"
+        ) % _path % (_creator? "creator" : "attacher")
+          % _num_recv_frames % _recv_frame_size % _num_send_frames % _send_frame_size;
+    }
+
+    ~shm_zero_copy_impl(void){
+        //wake any peer thread blocked on our rings before tearing down
+        futex_wake_all(&_tx_ring->tail);
+        futex_wake_all(&_rx_ring->head);
+        ::munmap(_ctrl, _total_bytes);
+        if (_creator) ::shm_unlink(_path.c_str());
+    }
+
+    /*******************************************************************
+     * Receive implementation
+     ******************************************************************/
+    managed_recv_buffer::sptr get_recv_buff(double timeout){
+        const uint32_t seq = _recv_seq;
+        if (_rx_ring->tail.load(std::memory_order_acquire) == seq){
+            const auto deadline = std::chrono::steady_clock::now()
+                + std::chrono::microseconds(long(timeout * 1e6));
+            if (not futex_wait_for_change(
+                &_rx_ring->tail, &_rx_ring->tail_waiters, seq, deadline)){
+                return managed_recv_buffer::sptr(); //timeout
+            }
+        }
+        _recv_seq++;
+        const size_t index = seq % _num_recv_frames;
+        return _mrb_pool[index]->get_new(_rx_lens[index]);
+    }
+
+    //! Called from mrb::release; releases may arrive out of order
+    void release_recv_slot(const size_t index){
+        boost::mutex::scoped_lock lock(_recv_release_mutex);
+        _recv_released[index] = 1;
+        uint32_t head = _rx_ring->head.load(std::memory_order_relaxed);
+        while (_recv_released[head % _num_recv_frames]){
+            _recv_released[head % _num_recv_frames] = 0;
+            head++;
+        }
+        _rx_ring->head.store(head, std::memory_order_release);
+        ring_doorbell(&_rx_ring->head, &_rx_ring->head_waiters);
+    }
+
+    size_t get_num_recv_frames(void) const {return _num_recv_frames;}
+    size_t get_recv_frame_size(void) const {return _recv_frame_size;}
+
+    /*******************************************************************
+     * Send implementation
+     ******************************************************************/
+    managed_send_buffer::sptr get_send_buff(double timeout){
+        const uint32_t seq = _send_seq;
+        uint32_t head = _tx_ring->head.load(std::memory_order_acquire);
+        if (seq - head >= _num_send_frames){ //ring full, wait for the peer
+            const auto deadline = std::chrono::steady_clock::now()
+                + std::chrono::microseconds(long(timeout * 1e6));
+            while (seq - head >= _num_send_frames){
+                if (not futex_wait_for_change(
+                    &_tx_ring->head, &_tx_ring->head_waiters, head, deadline)){
+                    return managed_send_buffer::sptr(); //timeout
+                }
+                head = _tx_ring->head.load(std::memory_order_acquire);
+            }
+        }
+        _send_seq++;
+        return _msb_pool[seq % _num_send_frames]->get_new();
+    }
+
+    //! Called from msb::release; commits may arrive out of order
+    void commit_send_slot(const size_t index, const size_t len){
+        boost::mutex::scoped_lock lock(_send_commit_mutex);
+        _tx_lens[index] = uint32_t(len);
+        _send_committed[index] = 1;
+        uint32_t tail = _tx_ring->tail.load(std::memory_order_relaxed);
+        while (_send_committed[tail % _num_send_frames]){
+            _send_committed[tail % _num_send_frames] = 0;
+            tail++;
+        }
+        _tx_ring->tail.store(tail, std::memory_order_release);
+        ring_doorbell(&_tx_ring->tail, &_tx_ring->tail_waiters);
+    }
+
+    size_t get_num_send_frames(void) const {return _num_send_frames;}
+    size_t get_send_frame_size(void) const {return _send_frame_size;}
+
+private:
+    void create_segment(const int fd, const device_addr_t &hints){
+        const size_t recv_frame_size = size_t(hints.cast<double>(
+            "recv_frame_size", SHM_ZERO_COPY_DEFAULT_FRAME_SIZE));
+        const size_t num_recv_frames = size_t(hints.cast<double>(
+            "num_recv_frames", SHM_ZERO_COPY_DEFAULT_NUM_FRAMES));
+        const size_t send_frame_size = size_t(hints.cast<double>(
+            "send_frame_size", SHM_ZERO_COPY_DEFAULT_FRAME_SIZE));
+        const size_t num_send_frames = size_t(hints.cast<double>(
+            "num_send_frames", SHM_ZERO_COPY_DEFAULT_NUM_FRAMES));
+
+        //direction 0 carries the creator's sent frames
+        _total_bytes = SHM_ZC_CTRL_BYTES
+            + ring_bytes(num_send_frames, send_frame_size)
+            + ring_bytes(num_recv_frames, recv_frame_size);
+        if (::ftruncate(fd, off_t(_total_bytes)) != 0) throw uhd::io_error(
+            str(boost::format("ftruncate(%s) failed: %s") % _path % std::strerror(errno)));
+        this->map_segment(fd);
+
+        std::memset(reinterpret_cast<void *>(_ctrl), 0, SHM_ZC_CTRL_BYTES);
+        _ctrl->num_frames[0] = uint32_t(num_send_frames);
+        _ctrl->frame_size[0] = uint32_t(send_frame_size);
+        _ctrl->num_frames[1] = uint32_t(num_recv_frames);
+        _ctrl->frame_size[1] = uint32_t(recv_frame_size);
+        _ctrl->magic.store(SHM_ZC_MAGIC, std::memory_order_release); //publish
+    }
+
+    void attach_segment(const int fd){
+        //map the control page to learn the geometry the creator chose
+        void *mem = ::mmap(NULL, SHM_ZC_CTRL_BYTES,
+            PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mem == MAP_FAILED) throw uhd::io_error(
+            str(boost::format("mmap(%s) failed: %s") % _path % std::strerror(errno)));
+        shm_zc_ctrl_t *ctrl = reinterpret_cast<shm_zc_ctrl_t *>(mem);
+
+        //wait (briefly) for the creator to finish initializing
+        const auto deadline =
+            std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while (ctrl->magic.load(std::memory_order_acquire) != SHM_ZC_MAGIC){
+            if (std::chrono::steady_clock::now() > deadline){
+                ::munmap(mem, SHM_ZC_CTRL_BYTES);
+                throw uhd::io_error(str(boost::format(
+                    "shm segment %s was never initialized by its creator") % _path));
+            }
+            ::usleep(1000);
+        }
+        _total_bytes = SHM_ZC_CTRL_BYTES
+            + ring_bytes(ctrl->num_frames[0], ctrl->frame_size[0])
+            + ring_bytes(ctrl->num_frames[1], ctrl->frame_size[1]);
+        ::munmap(mem, SHM_ZC_CTRL_BYTES);
+        this->map_segment(fd);
+    }
+
+    void map_segment(const int fd){
+        void *mem = ::mmap(NULL, _total_bytes,
+            PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mem == MAP_FAILED) throw uhd::io_error(
+            str(boost::format("mmap(%s) failed: %s") % _path % std::strerror(errno)));
+        _ctrl = reinterpret_cast<shm_zc_ctrl_t *>(mem);
+    }
+
+    std::string _path;
+    bool _creator;
+    size_t _total_bytes;
+    shm_zc_ctrl_t *_ctrl;
+    shm_zc_ring_ctrl_t *_tx_ring, *_rx_ring;
+    uint32_t *_tx_lens, *_rx_lens;
+
+    size_t _num_recv_frames, _recv_frame_size;
+    size_t _num_send_frames, _send_frame_size;
+    std::vector<boost::shared_ptr<shm_zero_copy_mrb> > _mrb_pool;
+    std::vector<boost::shared_ptr<shm_zero_copy_msb> > _msb_pool;
+
+    uint32_t _recv_seq, _send_seq;
+    std::vector<char> _recv_released;
+    std::vector<char> _send_committed;
+    boost::mutex _recv_release_mutex;
+    boost::mutex _send_commit_mutex;
+};
+
+void shm_zero_copy_mrb::release(void){
+    _impl->release_recv_slot(_index);
+}
+
+void shm_zero_copy_msb::release(void){
+    _impl->commit_send_slot(_index, size());
+}
+
+/***********************************************************************
+ * Factory
+ **********************************************************************/
+zero_copy_if::sptr shm_zero_copy::make(
+    const std::string &name,
+    const device_addr_t &hints
+){
+    return zero_copy_if::sptr(new shm_zero_copy_impl(name, hints));
+}
+
+#else /* UHD_PLATFORM_LINUX */
+
+zero_copy_if::sptr shm_zero_copy::make(
+    const std::string &,
+    const device_addr_t &
+){
+    throw uhd::not_implemented_error(
+        "shm_zero_copy is only available on Linux");
+}
+
+#endif /* UHD_PLATFORM_LINUX */
@@ -13,18 +13,39 @@
 #include <uhd/convert.hpp>
 #include <uhd/stream.hpp>
 #include <uhd/utils/tasks.hpp>
+#include <uhd/utils/thread.hpp>
 #include <uhd/utils/byteswap.hpp>
 #include <uhd/utils/log.hpp>
 #include <uhd/types/metadata.hpp>
+#include <uhd/types/sample_timekeeper.hpp>
 #include <uhd/transport/vrt_if_packet.hpp>
 #include <uhd/transport/zero_copy.hpp>
+#include <uhd/transport/buffer_pool.hpp>
 #include <uhdlib/rfnoc/rx_stream_terminator.hpp>
+#include <uhdlib/convert/convert_threaded.hpp>
+#include <uhdlib/convert/iq_corrections.hpp>
+#include <uhdlib/convert/power_stats.hpp>
+#include <uhdlib/utils/tracepoints.hpp>
+#include <uhdlib/utils/stage_profiler.hpp>
+#include <uhdlib/utils/alloc_guard.hpp>
 #include <boost/dynamic_bitset.hpp>
 #include <boost/function.hpp>
 #include <boost/format.hpp>
 #include <boost/make_shared.hpp>
+#include <boost/thread/mutex.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
 #include <iostream>
+#include <sstream>
+#include <utility>
 #include <vector>
+#include <atomic>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 // Included for debugging
 #ifdef UHD_TXRX_DEBUG_PRINTS
@@ -47,6 +68,139 @@ UHD_INLINE uint32_t get_context_code(
 typedef boost::function<void(void)> handle_overflow_type;
 static inline void handle_overflow_nop(void){}
 
+/***********************************************************************
+ * Incremental tick count to time spec converter
+ *
+ * Streaming delivers monotonically increasing timestamps with a fixed
+ * per-packet increment, so the time spec can be advanced by a cached
+ * delta instead of running the full from_ticks() conversion on every
+ * packet. The full conversion still runs on the first packet, on any
+ * discontinuity (including time going backwards after a device time
+ * change), and once per second to keep accumulated rounding bounded.
+ **********************************************************************/
+class incremental_time_converter{
+public:
+    incremental_time_converter(void):
+        _tick_rate(1.0), _valid(false),
+        _last_ticks(0), _sync_ticks(0), _delta_ticks(0)
+    {
+        /* NOP */
+    }
+
+    void set_tick_rate(const double rate){
+        _tick_rate = rate;
+        _valid = false;
+    }
+
+    time_spec_t convert(const uint64_t ticks){
+        if (_valid and ticks >= _last_ticks and double(ticks - _sync_ticks) < _tick_rate){
+            const uint64_t delta = ticks - _last_ticks;
+            if (delta != _delta_ticks){
+                _delta_ticks = delta;
+                _delta_time = time_spec_t::from_ticks(delta, _tick_rate);
+            }
+            _last_time += _delta_time;
+            _last_ticks = ticks;
+            return _last_time;
+        }
+
+        //full conversion on the first packet and on discontinuities
+        _last_time = time_spec_t::from_ticks(ticks, _tick_rate);
+        _last_ticks = ticks;
+        _sync_ticks = ticks;
+        _valid = true;
+        return _last_time;
+    }
+
+private:
+    double _tick_rate;
+    bool _valid;
+    uint64_t _last_ticks, _sync_ticks, _delta_ticks;
+    time_spec_t _delta_time, _last_time;
+};
+
+/***********************************************************************
+ * Packet capture ring ("black box recorder")
+ *
+ * Single-writer ring that snapshots one cache line of header metadata
+ * per received packet. The hot path does one entry write and one
+ * relaxed counter store; the dump path only runs after a stream error,
+ * so the ring never takes a lock and never stalls recv(). At the
+ * 64-byte entry size a 16k-entry ring costs 1 MB per channel.
+ **********************************************************************/
+class packet_capture_ring{
+public:
+    //! one cache line per packet
+    struct entry_type{
+        uint64_t host_time_ns;  //monotonic host time at header unpack
+        uint64_t tsf;           //device timestamp (valid when FLAG_HAS_TSF)
+        uint32_t sid;
+        uint32_t packet_count;
+        uint32_t num_packet_words32;
+        uint32_t flags;
+        uint32_t hdr_prefix[4]; //leading header words as received
+        uint32_t _pad[2];
+    };
+
+    static const uint32_t FLAG_HAS_TSF = (1 << 0);
+    static const uint32_t FLAG_HAS_SID = (1 << 1);
+    static const uint32_t FLAG_EOB     = (1 << 2);
+
+    packet_capture_ring(const size_t num_entries):
+        _mask(num_entries-1), _entries(num_entries), _count(0)
+    {
+        //the index mask requires a power-of-two depth
+        UHD_ASSERT_THROW(num_entries >= 2 and (num_entries & (num_entries-1)) == 0);
+    }
+
+    //! record one packet header, called from the recv hot path
+    UHD_INLINE void record(const uint32_t *vrt_hdr, const vrt::if_packet_info_t &ifpi){
+        const uint64_t seq = _count.load(std::memory_order_relaxed);
+        entry_type &entry = _entries[size_t(seq) & _mask];
+        entry.host_time_ns = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+        entry.tsf = ifpi.tsf;
+        entry.sid = ifpi.sid;
+        entry.packet_count = uint32_t(ifpi.packet_count);
+        entry.num_packet_words32 = uint32_t(ifpi.num_packet_words32);
+        entry.flags = (ifpi.has_tsf? FLAG_HAS_TSF : 0)
+                    | (ifpi.has_sid? FLAG_HAS_SID : 0)
+                    | (ifpi.eob? FLAG_EOB : 0);
+        const size_t prefix_words = std::min<size_t>(4, ifpi.num_packet_words32);
+        for (size_t i = 0; i < prefix_words; i++) entry.hdr_prefix[i] = vrt_hdr[i];
+        for (size_t i = prefix_words; i < 4; i++) entry.hdr_prefix[i] = 0;
+        _count.store(seq + 1, std::memory_order_release);
+    }
+
+    /*!
+     * Dump the most recent entries, oldest first.
+     * \param out where to write the text dump
+     * \param max_entries limit the dump to this many packets, 0 for all
+     */
+    void dump(std::ostream &out, const size_t max_entries = 0) const{
+        const uint64_t count = _count.load(std::memory_order_acquire);
+        const uint64_t depth = std::min<uint64_t>(count, _mask + 1);
+        const uint64_t num = (max_entries == 0)? depth : std::min<uint64_t>(depth, max_entries);
+        out << count << " packets seen, dumping last " << num << ":" << std::endl;
+        for (uint64_t seq = count - num; seq != count; seq++){
+            const entry_type &entry = _entries[size_t(seq) & _mask];
+            out << boost::format(
+                "  #%u host_ns=%u tsf=%u sid=0x%08x seq12=%u words32=%u flags=0x%x "
+                "hdr=[%08x %08x %08x %08x]"
+            )   % seq % entry.host_time_ns % entry.tsf % entry.sid
+                % entry.packet_count % entry.num_packet_words32 % entry.flags
+                % entry.hdr_prefix[0] % entry.hdr_prefix[1]
+                % entry.hdr_prefix[2] % entry.hdr_prefix[3]
+            << std::endl;
+        }
+    }
+
+private:
+    const size_t _mask;
+    std::vector<entry_type> _entries;
+    std::atomic<uint64_t> _count;
+};
+
 /***********************************************************************
  * Super receive packet handler
  *
@@ -61,6 +215,9 @@ public:
     typedef std::function<void(const uint32_t *)> handle_flowctrl_ack_type;
     typedef boost::function<void(const stream_cmd_t&)> issue_stream_cmd_type;
     typedef void(*vrt_unpacker_type)(const uint32_t *, vrt::if_packet_info_t &);
+    typedef vrt::unpack_error_t(*vrt_unpacker_nothrow_type)(const uint32_t *, vrt::if_packet_info_t &);
+    //! chan index, output buffers just written by the converter, nsamps
+    typedef boost::function<void(const size_t, const uhd::ref_vector<void *> &, const size_t)> post_convert_hook_type;
     //typedef boost::function<void(const uint32_t *, vrt::if_packet_info_t &)> vrt_unpacker_type;
 
     /*!
@@ -68,7 +225,35 @@ public:
      * \param size the number of transport channels
      */
     recv_packet_handler(const size_t size = 1):
+        _scheduled_cmds_in_flight(0),
+        _converter_swap_pending(false),
+        _vrt_unpacker_nothrow(NULL),
+        _trusted_unpacker(NULL),
+        _trusted_after_packets(0),
+        _validated_packets(0),
         _queue_error_for_next_call(false),
+        _warmed_up(false),
+        _history_duration(0.0),
+        _history_capacity(0),
+        _history_write_pos(0),
+        _history_filled(0),
+        _history_frozen(false),
+        _next_posted_index(0),
+        _num_timeouts(0),
+        _num_alignment_failures(0),
+        _skew_tolerance(0),
+        _max_skew_ticks(0),
+        _channels_in_lockstep(false),
+        _num_outputs(1),
+        _converter_prio(-1),
+        _num_conv_threads(1),
+        _scale_factor(1/32767.),
+        _iq_corrections_enabled(false),
+        _power_stats_enabled(false),
+        _deadline_enabled(false),
+        _deadline_dirty(false),
+        _deadline_spp(0),
+        _deadline_conv_nsps(0.0),
         _buffers_infos_index(0)
     {
         #ifdef  ERROR_INJECT_DROPPED_PACKETS
@@ -87,8 +272,11 @@ public:
     void resize(const size_t size){
         if (this->size() == size) return;
         _props.resize(size);
+        _lockstep_times.resize(size, 0);
+        _channels_in_lockstep = false;
         //re-initialize all buffers infos by re-creating the vector
         _buffers_infos = std::vector<buffers_info_type>(4, buffers_info_type(size));
+        this->select_recv_one_packet_fcn();
     }
 
     //! Get the channel width of this handler
@@ -102,6 +290,32 @@ public:
         _header_offset_words32 = header_offset_words32;
     }
 
+    /*!
+     * Setup a non-throwing vrt unpacker function and offset.
+     * Preferred over set_vrt_unpacker() when available: bad packets are
+     * rejected through a plain return code, so a storm of malformed
+     * packets costs no exception or string construction per packet.
+     */
+    void set_vrt_unpacker_nothrow(const vrt_unpacker_nothrow_type &vrt_unpacker, const size_t header_offset_words32 = 0){
+        _vrt_unpacker_nothrow = vrt_unpacker;
+        _header_offset_words32 = header_offset_words32;
+    }
+
+    /*!
+     * Arm trusted-link mode: once the given number of packets has passed
+     * the fully validating unpacker, swap in this reduced-check variant
+     * for the rest of the stream's life. Use only on links where the
+     * format has proven stable (e.g. a local CHDR stream); the trusted
+     * unpacker skips the per-packet length cross-checks.
+     * \param vrt_unpacker the trusted unpacker to promote to
+     * \param after_packets validated packets before the swap
+     */
+    void set_vrt_unpacker_trusted(const vrt_unpacker_nothrow_type &vrt_unpacker, const size_t after_packets = 100){
+        _trusted_unpacker = vrt_unpacker;
+        _trusted_after_packets = after_packets;
+        _validated_packets = 0;
+    }
+
     /*!
      * Set the threshold for alignment failure.
      * How many packets throw out before giving up?
@@ -111,14 +325,195 @@ public:
         _alignment_failure_threshold = threshold*this->size();
     }
 
+    /*!
+     * Configure coherent-group alignment.
+     *
+     * For channels spread across devices that share a clock and PPS,
+     * timestamps are nominally identical but can carry a small constant
+     * skew (group delay differences, FPGA pipeline depths). The strict
+     * equality check would then restart alignment - and throw away
+     * buffers - on every single packet. In coherent-group mode a
+     * timestamp within \p skew_tolerance_ticks of the alignment time
+     * counts as aligned; the residual skew is folded into the peak skew
+     * counter reported through get_stream_stats instead of triggering a
+     * realignment scan. Known per-device offsets should additionally be
+     * compensated with set_chan_alignment_offset so the tolerance only
+     * has to absorb jitter.
+     *
+     * \param enable true to enable tolerance-based alignment
+     * \param skew_tolerance_ticks largest timestamp difference, in
+     *        ticks, still treated as the same sample instant
+     */
+    void set_coherent_group(const bool enable, const uint64_t skew_tolerance_ticks = 0){
+        _skew_tolerance = enable? skew_tolerance_ticks : 0;
+    }
+
+    /*!
+     * Set the known timestamp offset of one channel in a coherent group.
+     * The offset (in ticks) is subtracted from this channel's packet
+     * timestamps before the alignment comparison, so a fixed
+     * inter-device skew predicted from the shared-clock topology aligns
+     * by arithmetic instead of by scanning. Reported metadata timestamps
+     * are not modified.
+     * \param xport_chan which transport channel
+     * \param ticks the expected timestamp offset of this channel
+     */
+    void set_chan_alignment_offset(const size_t xport_chan, const int64_t ticks){
+        _props.at(xport_chan).time_offset_ticks = ticks;
+    }
+
     //! Set the rate of ticks per second
     void set_tick_rate(const double rate){
         _tick_rate = rate;
+        _time_converter.set_tick_rate(rate);
+        _timekeeper.set_tick_rate(rate);
     }
 
     //! Set the rate of samples per second
     void set_samp_rate(const double rate){
         _samp_rate = rate;
+        _timekeeper.set_samp_rate(rate);
+        //the deadline reservation is derived from the rate
+        if (_deadline_enabled) _deadline_dirty = true;
+    }
+
+    //! Get the timekeeper tracking per-sample times of received buffers
+    const sample_timekeeper &get_timekeeper(void) const{
+        return _timekeeper;
+    }
+
+    /*******************************************************************
+     * Deadline scheduling:
+     * Put the thread that calls recv() under a deadline reservation
+     * (Linux SCHED_DEADLINE) with automatically derived parameters:
+     * the period is the packet interval (spp over the sample rate) and
+     * the runtime budget comes from the converter throughput measured
+     * at setup, with headroom for the rest of the per-packet work.
+     * Unlike a static FIFO/RR priority, a deadline thread is throttled
+     * once its per-period budget is spent, so the fast path gets hard
+     * CPU guarantees without being able to starve the host. The
+     * reservation is armed from within recv() - the kernel admits the
+     * calling thread, not an outside observer - and re-derived when
+     * the rate or the packet size changes.
+     ******************************************************************/
+
+    //! Enable (or disable) deadline scheduling of the recv caller
+    void set_deadline_scheduling(const bool enable, const size_t spp){
+        _deadline_spp = spp;
+        _deadline_enabled = enable;
+        _deadline_dirty = enable;
+    }
+
+    //! Track runtime packet size changes; no-op while disabled
+    void update_deadline_spp(const size_t spp){
+        _deadline_spp = spp;
+        if (_deadline_enabled) _deadline_dirty = true;
+    }
+
+    /*******************************************************************
+     * Sample history ring:
+     * Every recv() call appends its converted samples to a per-channel
+     * circular buffer, so a detector can freeze the ring and read back
+     * what arrived just before it fired. The feed happens while the
+     * caller buffers are still cache-hot from conversion.
+     ******************************************************************/
+
+    //! Enable (duration > 0) or release (duration == 0) the history ring
+    void enable_history(const double duration){
+        _history_pool.reset();
+        _history_capacity = 0;
+        _history_write_pos = 0;
+        _history_filled = 0;
+        _history_frozen = false;
+        _history_duration = std::max(duration, 0.0);
+        //the ring size depends on the sample rate and item size; when
+        //either is not yet known, allocation is retried on first feed
+        this->history_alloc();
+    }
+
+    //! Stop history updates; returns the number of samples held
+    size_t freeze_history(void){
+        if (_history_duration <= 0.0) throw uhd::runtime_error(
+            "freeze_history() called without enable_history()");
+        _history_frozen = true;
+        return _history_filled;
+    }
+
+    //! Copy samples out of a frozen history, oldest first
+    size_t read_history(
+        const uhd::rx_streamer::buffs_type &buffs,
+        const size_t nsamps_per_buff,
+        const size_t offset
+    ){
+        if (not _history_frozen) throw uhd::runtime_error(
+            "read_history() requires a frozen history");
+        if (offset >= _history_filled) return 0;
+        const size_t nsamps = std::min(nsamps_per_buff, _history_filled - offset);
+        //index of the oldest requested sample within the ring
+        const size_t start = (_history_write_pos + _history_capacity
+            - _history_filled + offset) % _history_capacity;
+        const size_t head = std::min(nsamps, _history_capacity - start);
+        for (size_t i = 0; i < _props.size(); i++){
+            const char *ring = reinterpret_cast<const char *>(_history_pool->at(i));
+            char *out = reinterpret_cast<char *>(buffs[i]);
+            std::memcpy(out, ring + start*_bytes_per_cpu_item, head*_bytes_per_cpu_item);
+            if (head < nsamps) std::memcpy(
+                out + head*_bytes_per_cpu_item, ring,
+                (nsamps - head)*_bytes_per_cpu_item);
+        }
+        return nsamps;
+    }
+
+    //! Resume history updates after a freeze; held samples age out
+    void resume_history(void){
+        _history_frozen = false;
+    }
+
+    /*******************************************************************
+     * Posted-buffer receive:
+     * The application pre-registers destination buffer sets and they
+     * are filled in posting order, the converter writing directly into
+     * the application's memory. Completions replace the per-call
+     * destination buffer, matching RDMA-style pre-posting ownership.
+     ******************************************************************/
+
+    //! Queue a destination buffer set; returns its posting index
+    size_t post_recv_buff(
+        const uhd::rx_streamer::buffs_type &buffs,
+        const size_t nsamps_per_buff
+    ){
+        if (buffs.size() != _props.size()) throw uhd::value_error(str(boost::format(
+            "post_recv_buff() got %u buffers for %u channels")
+            % buffs.size() % _props.size()));
+        if (nsamps_per_buff == 0) throw uhd::value_error(
+            "post_recv_buff() requires a non-zero buffer size");
+        posted_buffs_type posted;
+        posted.buffs.resize(buffs.size());
+        for (size_t i = 0; i < buffs.size(); i++) posted.buffs[i] = buffs[i];
+        posted.nsamps = nsamps_per_buff;
+        posted.index = _next_posted_index++;
+        _posted_buffs.push_back(posted);
+        return posted.index;
+    }
+
+    //! Fill the oldest posted buffer set and report its completion
+    bool recv_posted(
+        uhd::rx_streamer::recv_completion_t &completion,
+        const double timeout
+    ){
+        if (_posted_buffs.empty()) throw uhd::runtime_error(
+            "recv_posted() called with no buffers posted");
+        posted_buffs_type &posted = _posted_buffs.front();
+        completion.index = posted.index;
+        completion.nsamps = this->recv(
+            posted.buffs, posted.nsamps, completion.metadata, timeout, false);
+        //a timeout that produced nothing leaves the buffer posted
+        if (completion.nsamps == 0 and completion.metadata.error_code
+                == uhd::rx_metadata_t::ERROR_CODE_TIMEOUT){
+            return false;
+        }
+        _posted_buffs.pop_front();
+        return true;
     }
 
     /*!
@@ -127,12 +522,31 @@ public:
      * \param get_buff the getter function
      */
     void set_xport_chan_get_buff(const size_t xport_chan, const get_buff_type &get_buff, const bool flush = false){
+        _props.at(xport_chan).lookahead_buff.reset();
         if (flush){
             while (get_buff(0.0)) {};
         }
         _props.at(xport_chan).get_buff = get_buff;
     }
 
+    /*!
+     * Set the pollable receive descriptor of a transport channel.
+     * \param xport_chan which transport channel
+     * \param fd the descriptor, -1 when the transport has none
+     */
+    void set_xport_chan_recv_fd(const size_t xport_chan, const int fd){
+        _props.at(xport_chan).recv_fd = fd;
+    }
+
+    //! Get the pollable receive descriptors of all channels that have one
+    std::vector<int> get_recv_fds(void) const{
+        std::vector<int> fds;
+        for (size_t i = 0; i < _props.size(); i++){
+            if (_props[i].recv_fd != -1) fds.push_back(_props[i].recv_fd);
+        }
+        return fds;
+    }
+
     /*!
      * Flush all transports in the streamer:
      * The packet payload is discarded.
@@ -163,13 +577,118 @@ public:
         _props.at(xport_chan).handle_flowctrl_ack = handle_flowctrl_ack;
     }
 
+    /*!
+     * Set the sequence number reorder window for this channel.
+     * Packets that arrive up to this many sequence numbers early are
+     * parked and re-sequenced instead of being treated as a discontinuity,
+     * which makes aggregated links with slight inter-link reordering
+     * usable. A window of zero (the default) disables re-sequencing; on a
+     * single link an early packet always means a drop, and parking would
+     * only delay the error. Each parked packet pins a receive frame, so
+     * the window must stay well below the number of receive frames.
+     * \param xport_chan which transport channel
+     * \param window_size max number of early packets to park
+     */
+    void set_xport_chan_reorder_window(const size_t xport_chan, const size_t window_size){
+        _props.at(xport_chan).reorder_window_size = window_size;
+    }
+
+    /*!
+     * Enable the packet capture ring ("black box recorder") for this
+     * channel. Every received packet header is snapshotted into a
+     * lock-free ring at the cost of one cache-line write, and the most
+     * recent entries are logged when a sequence error is detected.
+     * \param xport_chan which transport channel
+     * \param num_entries ring depth in packets, rounded up to a power
+     *                    of two, zero (the default) disables capture
+     */
+    void set_xport_chan_capture_ring(const size_t xport_chan, const size_t num_entries){
+        if (num_entries == 0){
+            _props.at(xport_chan).capture_ring.reset();
+            return;
+        }
+        size_t depth = 2;
+        while (depth < num_entries) depth *= 2;
+        _props.at(xport_chan).capture_ring = boost::make_shared<packet_capture_ring>(depth);
+    }
+
+    /*!
+     * Dump the capture ring of one channel as text, oldest packet first.
+     * Safe to call from a monitoring thread while recv() is running.
+     * \param xport_chan which transport channel
+     * \param out where to write the text dump
+     * \param max_entries limit the dump to this many packets, 0 for all
+     */
+    void dump_packet_capture(const size_t xport_chan, std::ostream &out, const size_t max_entries = 0) const{
+        if (not _props.at(xport_chan).capture_ring){
+            out << "packet capture ring not enabled" << std::endl;
+            return;
+        }
+        _props.at(xport_chan).capture_ring->dump(out, max_entries);
+    }
+
     //! Set the conversion routine for all channels
-    void set_converter(const uhd::convert::id_type &id){
+    void set_converter(
+        const uhd::convert::id_type &id,
+        const size_t num_conv_threads = 1,
+        const uhd::convert::priority_type prio = -1
+    ){
         _num_outputs = id.num_outputs;
-        _converter = uhd::convert::get_converter(id)();
+        uhd::convert::function_type conv_fcn;
+        uhd::convert::priority_type selected_prio = -1;
+        if (prio != -1){
+            try{
+                conv_fcn = uhd::convert::get_converter(id, prio);
+                selected_prio = prio;
+            }
+            catch(const uhd::key_error &){
+                UHD_LOGGER_DEBUG("STREAMER")
+                    << "No converter with requested priority " << prio
+                    << " for " << id.to_string() << ", using the default";
+                conv_fcn = uhd::convert::get_converter(id);
+            }
+        }
+        else conv_fcn = uhd::convert::get_converter(id);
+        if (selected_prio == -1){
+            selected_prio = uhd::convert::get_converter_priority(id);
+        }
+        _converter = uhd::convert::make_threaded_converter(
+            conv_fcn(), id, num_conv_threads);
+        _converter_id = id;
+        _converter_prio = selected_prio;
+        UHD_LOGGER_DEBUG("STREAMER") << "Using converter: "
+            << uhd::convert::get_converter_info(id, selected_prio).to_pp_string();
+        _num_conv_threads = num_conv_threads;
+        _nt_converter.reset(); //rebuilt on demand for the new format pair
         this->set_scale_factor(1/32767.); //update after setting converter
         _bytes_per_otw_item = uhd::convert::get_bytes_per_item(id.input_format);
         _bytes_per_cpu_item = uhd::convert::get_bytes_per_item(id.output_format);
+        this->select_recv_one_packet_fcn();
+    }
+
+    //! Describe the conversion routine resolved by set_converter
+    uhd::convert::converter_info_type get_converter_info(void) const{
+        return uhd::convert::get_converter_info(_converter_id, _converter_prio);
+    }
+
+    /*!
+     * Request a CPU format change on a live stream.
+     *
+     * The new conversion routine is validated and resolved here on the
+     * caller's thread; the receive path swaps it in at the next packet
+     * boundary, so no recv call mixes formats within its output and a
+     * mode switch costs microseconds instead of a streamer teardown.
+     * Only the CPU-side format may change: the wire format and the
+     * channel topology are fixed by the device configuration.
+     */
+    void request_cpu_format(const std::string &cpu_format){
+        uhd::convert::id_type id = _converter_id;
+        id.output_format = cpu_format;
+        //resolve now so an unsupported format pair throws in the caller
+        uhd::convert::get_converter(id);
+        boost::mutex::scoped_lock lock(_pending_converter_mutex);
+        _pending_converter_id = id;
+        _converter_swap_pending.store(true, std::memory_order_release);
     }
 
     //! Set the transport channel's overflow handler
@@ -177,9 +696,119 @@ public:
         _props.at(xport_chan).handle_overflow = handle_overflow;
     }
 
+    /*!
+     * Set a hook that runs on each converted block while it is cache-hot.
+     *
+     * The hook is invoked once per channel per recv call, on the recv
+     * thread, right after the converter has written the block - so a
+     * first DSP stage (power detector, channel mask, ...) can be fused
+     * into the recv pass instead of re-reading the buffer from DRAM one
+     * pipeline stage later. The hook gets the channel index, the output
+     * buffer pointers the converter just filled, and the sample count.
+     *
+     * Note: when a destination lies in memory registered through
+     * register_output_memory, the streaming-store converter wrote around
+     * the cache and the block is not hot. Pass an empty function to
+     * remove the hook.
+     */
+    void set_post_convert_hook(const post_convert_hook_type &hook){
+        _post_convert_hook = hook;
+    }
+
+    /*!
+     * Apply host-side IQ corrections to one output channel.
+     *
+     * The correction (scale * sample + offset) runs fused into the
+     * conversion pass, per packet while the block is cache-hot. Only
+     * supported with the fc32 CPU format. A scale of 1 and offset of 0
+     * disables the stage for the channel; when no channel has a
+     * correction enabled the fast path is untouched.
+     */
+    void set_iq_corrections(
+        const size_t chan,
+        const std::complex<float> &scale,
+        const std::complex<float> &offset
+    ){
+        if (_converter_id.output_format != "fc32"){
+            throw uhd::runtime_error(
+                "host-side IQ corrections require the fc32 CPU format");
+        }
+        _iq_corrections.resize(std::max(_iq_corrections.size(), chan+1));
+        iq_correction_type &corr = _iq_corrections[chan];
+        corr.scale = scale;
+        corr.offset = offset;
+        corr.enabled = (scale != std::complex<float>(1.0f, 0.0f))
+            or (offset != std::complex<float>(0.0f, 0.0f));
+        _iq_corrections_enabled = false;
+        for (size_t i = 0; i < _iq_corrections.size(); i++){
+            if (_iq_corrections[i].enabled) _iq_corrections_enabled = true;
+        }
+    }
+
+    /*!
+     * Enable signal statistics accumulation in the conversion pass.
+     *
+     * Each converted block also feeds per-channel component sums and a
+     * sum of squared magnitudes, accumulated with SIMD while the block
+     * is cache-hot - nearly free next to the converter's own multiply.
+     * Only supported with the fc32 CPU format. Disabled by default;
+     * the fast path is then untouched.
+     */
+    void set_power_stats_enabled(const bool enable){
+        if (enable and _converter_id.output_format != "fc32"){
+            throw uhd::runtime_error(
+                "in-stream power statistics require the fc32 CPU format");
+        }
+        _power_stats.resize(this->size()*_num_outputs);
+        _power_stats_enabled = enable;
+    }
+
+    //! Read and reset one channel's accumulated signal statistics
+    uhd::power_stats_t get_power_stats(const size_t chan){
+        if (chan >= _power_stats.size()) return uhd::power_stats_t();
+        const uhd::power_stats_t stats = _power_stats[chan];
+        _power_stats[chan] = uhd::power_stats_t();
+        return stats;
+    }
+
     //! Set the scale factor used in float conversion
     void set_scale_factor(const double scale_factor){
+        _scale_factor = scale_factor;
         _converter->set_scalar(scale_factor);
+        if (_nt_converter) _nt_converter->set_scalar(scale_factor);
+    }
+
+    /*!
+     * Register a caller-owned output memory region.
+     * Conversions whose destination lies entirely inside a registered
+     * region use the streaming-store converter for the format pair
+     * when one is registered, bypassing the cache on the way into
+     * DMA-capable memory (e.g. CUDA pinned host buffers). Without such
+     * a converter the region is still recorded and conversion simply
+     * keeps using the default kernel.
+     */
+    void register_output_memory(void *mem, const size_t num_bytes){
+        if (size_t(mem) & 0xf) throw uhd::value_error(
+            "register_output_memory: memory must be 16-byte aligned for streaming stores");
+        if (not _nt_converter and _converter){
+            try{
+                _nt_converter = uhd::convert::make_threaded_converter(
+                    uhd::convert::get_converter(
+                        _converter_id, uhd::convert::PRIORITY_NONTEMPORAL)(),
+                    _converter_id, _num_conv_threads);
+                _nt_converter->set_scalar(_scale_factor);
+            }
+            catch(const uhd::key_error &){
+                UHD_LOGGER_DEBUG("STREAMER")
+                    << "No streaming-store converter for "
+                    << _converter_id.to_string()
+                    << ", registered memory will use the default";
+            }
+        }
+        output_region_type region;
+        region.base = size_t(mem);
+        region.length = num_bytes;
+        _output_regions.push_back(region);
     }
 
     //! Set the callback to issue stream commands
@@ -203,6 +832,28 @@ public:
         }
     }
 
+    //! Max scheduled commands kept in the device command FIFOs at once
+    static const size_t SCHEDULED_CMDS_IN_FLIGHT_MAX = 8;
+
+    /*!
+     * Queue a train of timed stream commands for dispatch.
+     * Up to SCHEDULED_CMDS_IN_FLIGHT_MAX commands go into the device
+     * command FIFO right away; every end-of-burst observed on the
+     * receive path tops the FIFO back up from the host-side queue, so
+     * an arbitrarily long burst train needs no pacing thread. The
+     * commands must be timed and should produce finite bursts, since
+     * burst completions are what drive the refill.
+     */
+    void schedule_stream_cmds(const std::vector<stream_cmd_t> &stream_cmds){
+        boost::mutex::scoped_lock lock(_scheduled_cmds_mutex);
+        for (size_t i = 0; i < stream_cmds.size(); i++){
+            if (stream_cmds[i].stream_now) throw uhd::value_error(
+                "schedule_stream_cmds: scheduled stream commands must be timed");
+            _scheduled_cmds.push_back(stream_cmds[i]);
+        }
+        this->top_up_scheduled_cmds();
+    }
+
     /*******************************************************************
      * Receive:
      * The entry point for the fast-path receive calls.
@@ -215,6 +866,40 @@ public:
         const double timeout,
         const bool one_packet
     ){
+        //apply a requested converter swap at this packet boundary;
+        //must run before recv_inner() arms its allocation guard since
+        //the converter rebuild allocates
+        if (_converter_swap_pending.load(std::memory_order_acquire)){
+            this->apply_converter_swap();
+        }
+        //(re)arm the deadline reservation from the thread that owns
+        //the fast path; runs before recv_inner() so the throughput
+        //benchmark stays clear of the allocation guard
+        if (_deadline_dirty and _samp_rate > 0.0){
+            this->apply_deadline_schedule();
+        }
+        const size_t num_recvd = this->recv_inner(
+            buffs, nsamps_per_buff, metadata, timeout, one_packet
+        );
+        //feed the per-sample timekeeper once per call: a handful of
+        //integer ops, conversion to seconds happens only on demand
+        _timekeeper.update(metadata, num_recvd);
+        if (_history_duration > 0.0) this->history_feed(buffs, num_recvd);
+        return num_recvd;
+    }
+
+    UHD_INLINE size_t recv_inner(
+        const uhd::rx_streamer::buffs_type &buffs,
+        const size_t nsamps_per_buff,
+        uhd::rx_metadata_t &metadata,
+        const double timeout,
+        const bool one_packet
+    ){
+        //the warm-up call may allocate (vector growth, converter state);
+        //every call after it must not (see alloc_guard.hpp)
+        scoped_alloc_guard alloc_guard(_warmed_up);
+        _warmed_up = true;
+
         //handle metadata queued from a previous receive
         if (_queue_error_for_next_call){
             _queue_error_for_next_call = false;
@@ -229,6 +914,7 @@ public:
         );
 
         if (one_packet or metadata.end_of_burst){
+            if (metadata.end_of_burst) this->note_burst_complete();
 #ifdef UHD_TXRX_DEBUG_PRINTS
             dbg_gather_data(nsamps_per_buff, accum_num_samps, metadata, timeout, one_packet);
 #endif
@@ -262,38 +948,376 @@ public:
                 break;
             }
         }
+        if (metadata.end_of_burst) this->note_burst_complete();
 #ifdef UHD_TXRX_DEBUG_PRINTS
         dbg_gather_data(nsamps_per_buff, accum_num_samps, metadata, timeout, one_packet);
 #endif
         return accum_num_samps;
     }
 
+    /*******************************************************************
+     * Batched receive:
+     * Fill a vector of caller buffers with one entry into the handler.
+     * The per-call overhead (virtual dispatch from the streamer and
+     * the queued error check) is paid once per batch instead of once
+     * per buffer; the converter state is already cached per handler.
+     ******************************************************************/
+    UHD_INLINE size_t recv_multi(
+        const std::vector<uhd::rx_streamer::buffs_type> &buffs,
+        const size_t nsamps_per_buff,
+        std::vector<size_t> &nsamps,
+        std::vector<uhd::rx_metadata_t> &metadata,
+        const double timeout,
+        const bool one_packet
+    ){
+        nsamps.resize(buffs.size());
+        metadata.resize(buffs.size());
+
+        size_t num_buffs = 0;
+        for (size_t i = 0; i < buffs.size(); i++){
+            nsamps[i] = this->recv(
+                buffs[i], nsamps_per_buff, metadata[i], timeout, one_packet
+            );
+            num_buffs++;
+
+            //stop on errors and burst boundaries; errors found mid-batch
+            //are reported in place rather than queued for the next call
+            if (metadata[i].error_code != rx_metadata_t::ERROR_CODE_NONE) break;
+            if (metadata[i].end_of_burst) break;
+        }
+        return num_buffs;
+    }
+
+    /*******************************************************************
+     * Loaned receive:
+     * Hand the packet payload to the caller without copy-conversion.
+     * The caller gets the samples in over-the-wire layout and keeps
+     * the transport buffer claimed until the loan is released.
+     ******************************************************************/
+    UHD_INLINE bool recv_loan(
+        uhd::rx_streamer::buff_loan_t &loan,
+        uhd::rx_metadata_t &metadata,
+        const double timeout
+    ){
+        //loans bypass the converter, so wire and host items must have
+        //the same size for the sample accounting to stay consistent
+        if (_bytes_per_otw_item != _bytes_per_cpu_item){
+            throw uhd::runtime_error(
+                "recv_loan() requires the wire item size to match the cpu item size");
+        }
+        if (this->size() != 1 or _num_outputs != 1){
+            throw uhd::runtime_error(
+                "recv_loan() is only supported on single channel streamers");
+        }
+
+        //handle metadata queued from a previous receive
+        if (_queue_error_for_next_call){
+            _queue_error_for_next_call = false;
+            metadata = _queue_metadata;
+            if (_queue_metadata.error_code != rx_metadata_t::ERROR_CODE_TIMEOUT) return false;
+        }
+
+        //get the next buffer if the current one has expired
+        if (get_curr_buffer_info().data_bytes_to_copy == 0)
+        {
+            //perform receive with alignment logic
+            get_aligned_buffs(timeout);
+        }
+
+        buffers_info_type &info = get_curr_buffer_info();
+        metadata = info.metadata;
+
+        //interpolate the time spec (useful after a partial recv call)
+        metadata.time_spec += time_spec_t::from_ticks(info.fragment_offset_in_samps, _samp_rate);
+
+        if (metadata.error_code != rx_metadata_t::ERROR_CODE_NONE) return false;
+
+        //the whole remaining payload leaves the handler in one loan,
+        //so there is never a fragment pending after this call
+        loan.nsamps = info.data_bytes_to_copy/_bytes_per_otw_item;
+        loan.data = info[0].copy_buff;
+        loan.buff = std::move(info[0].buff); //the loan holds the claim now
+        metadata.more_fragments = false;
+        metadata.fragment_offset = info.fragment_offset_in_samps;
+
+        info.data_bytes_to_copy = 0;
+        return true;
+    }
+
+    /*******************************************************************
+     * Performance counters:
+     * Sum the per-channel atomics into a snapshot for the caller.
+     * Safe to call from a monitoring thread while recv() is running.
+     ******************************************************************/
+    uhd::stream_stats_t get_stream_stats(void) const{
+        uhd::stream_stats_t stats;
+        for (size_t i = 0; i < _props.size(); i++){
+            stats.num_packets += _props[i].counters->num_packets.load(std::memory_order_relaxed);
+            stats.num_sequence_errors += _props[i].counters->num_sequence_errors.load(std::memory_order_relaxed);
+            stats.num_overruns += _props[i].counters->num_overruns.load(std::memory_order_relaxed);
+        }
+        stats.num_timeouts = _num_timeouts.load(std::memory_order_relaxed);
+        stats.num_alignment_failures = _num_alignment_failures.load(std::memory_order_relaxed);
+        stats.max_skew_ticks = _max_skew_ticks.load(std::memory_order_relaxed);
+        stats.update_link_quality();
+        UHD_STAGE_PROF_FILL(stats);
+        return stats;
+    }
+
 private:
+    /*******************************************************************
+     * Stream command scheduler
+     ******************************************************************/
+    //! Push queued commands into the device command FIFOs (lock held)
+    void top_up_scheduled_cmds(void){
+        while (_scheduled_cmds_in_flight < SCHEDULED_CMDS_IN_FLIGHT_MAX
+               and not _scheduled_cmds.empty()){
+            const stream_cmd_t &stream_cmd = _scheduled_cmds.front();
+            for (size_t i = 0; i < _props.size(); i++){
+                if (_props[i].issue_stream_cmd) _props[i].issue_stream_cmd(stream_cmd);
+            }
+            _scheduled_cmds.pop_front();
+            _scheduled_cmds_in_flight++;
+        }
+    }
+
+    //! A burst finished on the receive path; refill the command FIFOs
+    UHD_INLINE void note_burst_complete(void){
+        if (_scheduled_cmds_in_flight == 0) return; //scheduler inactive
+        boost::mutex::scoped_lock lock(_scheduled_cmds_mutex);
+        if (_scheduled_cmds_in_flight > 0) _scheduled_cmds_in_flight--;
+        this->top_up_scheduled_cmds();
+    }
+
+    std::deque<stream_cmd_t> _scheduled_cmds;
+    size_t _scheduled_cmds_in_flight;
+    boost::mutex _scheduled_cmds_mutex;
+
+    /*******************************************************************
+     * Live converter swap
+     ******************************************************************/
+    //! Apply a swap queued by request_cpu_format(); runs on the receive
+    //! thread between packets so no conversion mixes formats
+    void apply_converter_swap(void){
+        uhd::convert::id_type id;
+        {
+            boost::mutex::scoped_lock lock(_pending_converter_mutex);
+            _converter_swap_pending.store(false, std::memory_order_relaxed);
+            id = _pending_converter_id;
+        }
+        const double scale = _scale_factor; //survives the rebuild
+        const bool format_changed =
+            id.output_format != _converter_id.output_format;
+        this->set_converter(id, _num_conv_threads, _converter_prio);
+        this->set_scale_factor(scale);
+        //samples already in the history ring are in the old format:
+        //restart the ring empty rather than replay them
+        if (format_changed and _history_duration > 0.0){
+            this->enable_history(_history_duration);
+        }
+    }
+
+    //! converter swap queued by request_cpu_format()
+    boost::mutex _pending_converter_mutex;
+    uhd::convert::id_type _pending_converter_id;
+    std::atomic<bool> _converter_swap_pending;
+
     vrt_unpacker_type _vrt_unpacker;
+    vrt_unpacker_nothrow_type _vrt_unpacker_nothrow;
+    //! pending trusted unpacker, NULL once promoted (or never armed)
+    vrt_unpacker_nothrow_type _trusted_unpacker;
+    size_t _trusted_after_packets;
+    size_t _validated_packets;
     size_t _header_offset_words32;
     double _tick_rate, _samp_rate;
+    //! per-sample time tracking, fed once per recv() call
+    sample_timekeeper _timekeeper;
+    //! rolling per-channel sample history, fed once per recv() call
+    double _history_duration; //in seconds, 0 = off
+    buffer_pool::sptr _history_pool;
+    size_t _history_capacity; //in samples, 0 = not yet allocated
+    size_t _history_write_pos;
+    size_t _history_filled;
+    bool _history_frozen;
+
+    //! one pre-posted destination buffer set
+    struct posted_buffs_type{
+        std::vector<void *> buffs;
+        size_t nsamps;
+        size_t index;
+    };
+    std::deque<posted_buffs_type> _posted_buffs;
+    size_t _next_posted_index;
+
+    //! Size the ring from the current rate; deferred until both the
+    //  sample rate and the converter item size are known
+    void history_alloc(void){
+        if (_history_duration <= 0.0) return;
+        if (_samp_rate <= 0.0 or _bytes_per_cpu_item == 0 or _props.empty()) return;
+        _history_capacity = size_t(_history_duration*_samp_rate);
+        if (_history_capacity == 0){
+            _history_duration = 0.0;
+            return;
+        }
+        //huge pages keep the full-rate ring feed from thrashing the
+        //dTLB; make_huge falls back to a regular allocation on its own
+        _history_pool = buffer_pool::make_huge(
+            _props.size(), _history_capacity*_bytes_per_cpu_item);
+        _history_write_pos = 0;
+        _history_filled = 0;
+    }
+
+    //! Append one receive call's samples to the ring
+    UHD_INLINE void history_feed(
+        const uhd::rx_streamer::buffs_type &buffs, const size_t nsamps
+    ){
+        if (_history_capacity == 0){
+            this->history_alloc();
+            if (_history_capacity == 0) return;
+        }
+        if (_history_frozen or nsamps == 0) return;
+        if (nsamps >= _history_capacity){
+            //one call overfilled the ring: only the tail survives
+            const size_t src_off = (nsamps - _history_capacity)*_bytes_per_cpu_item;
+            for (size_t i = 0; i < _props.size(); i++){
+                std::memcpy(_history_pool->at(i),
+                    reinterpret_cast<const char *>(buffs[i]) + src_off,
+                    _history_capacity*_bytes_per_cpu_item);
+            }
+            _history_write_pos = 0;
+            _history_filled = _history_capacity;
+            return;
+        }
+        const size_t head = std::min(nsamps, _history_capacity - _history_write_pos);
+        for (size_t i = 0; i < _props.size(); i++){
+            char *ring = reinterpret_cast<char *>(_history_pool->at(i));
+            const char *in = reinterpret_cast<const char *>(buffs[i]);
+            std::memcpy(ring + _history_write_pos*_bytes_per_cpu_item,
+                in, head*_bytes_per_cpu_item);
+            if (head < nsamps) std::memcpy(
+                ring, in + head*_bytes_per_cpu_item,
+                (nsamps - head)*_bytes_per_cpu_item);
+        }
+        _history_write_pos = (_history_write_pos + nsamps) % _history_capacity;
+        _history_filled = std::min(_history_filled + nsamps, _history_capacity);
+    }
+    incremental_time_converter _time_converter;
     bool _queue_error_for_next_call;
+    bool _warmed_up; //first recv() happened, allocations now asserted away
     size_t _alignment_failure_threshold;
     rx_metadata_t _queue_metadata;
-    struct xport_chan_props_type{
+    //! per-channel event counters (shared_ptr because atomics cannot be copied on resize)
+    //
+    // Padded to a full cache line: the counter blocks are allocated
+    // back-to-back during resize(), and without the padding two channels
+    // served by different offload threads would bump atomics on the same
+    // line and ping-pong it between cores.
+    struct UHD_ALIGNED(64) stream_counters_type{
+        stream_counters_type(void):
+            num_packets(0), num_sequence_errors(0), num_overruns(0)
+        {}
+        std::atomic<uint64_t> num_packets;
+        std::atomic<uint64_t> num_sequence_errors;
+        std::atomic<uint64_t> num_overruns;
+    };
+    std::atomic<uint64_t> _num_timeouts;
+    std::atomic<uint64_t> _num_alignment_failures;
+    //! coherent-group mode: largest tolerated timestamp skew, 0 = strict
+    uint64_t _skew_tolerance;
+    //! peak inter-channel skew observed among aligned packets
+    std::atomic<uint64_t> _max_skew_ticks;
+    //! true while every channel aligned on its first packet last pass,
+    //! which arms the batched-scan fast path in get_aligned_buffs()
+    bool _channels_in_lockstep;
+    //! contiguous per-channel leading times for the one-pass batch scan
+    std::vector<uint64_t> _lockstep_times;
+#ifdef UHD_TXRX_STAGE_PROFILING
+    //! per-stage cycle histograms (compile-in micro-profiler)
+    stage_profiler _stage_profiler;
+#endif
+    //! a packet that arrived ahead of its sequence number, held for re-sequencing
+    struct reorder_entry_type{
+        size_t packet_count;
+        managed_recv_buffer::sptr buff;
+    };
+    //! Per-channel state, spaced one cache line apart inside _props.
+    //
+    // With one offload thread per channel the neighbouring elements are
+    // written by different cores, so the mutable hot state (sequence
+    // tracking, reorder bookkeeping) sits up front and the struct is
+    // aligned and padded to the cache line size -- a writer then only
+    // dirties lines its own channel touches. The callbacks below the
+    // fold are set once at stream creation and merely read afterwards.
+    struct UHD_ALIGNED(64) xport_chan_props_type{
         xport_chan_props_type(void):
             packet_count(0),
+            fc_update_window(0),
+            reorder_window_size(0),
+            capture_dumps_remaining(3),
+            time_offset_ticks(0),
             handle_overflow(&handle_overflow_nop),
-            fc_update_window(0)
+            counters(boost::make_shared<stream_counters_type>()),
+            recv_fd(-1)
         {}
+        //hot: mutated per packet by this channel's reader thread
+        size_t packet_count;
+        size_t fc_update_window;
+        size_t reorder_window_size;
+        //! small reorder window for slightly out-of-order links (e.g. dual 10GbE)
+        std::vector<reorder_entry_type> reorder_window;
+        //! log the ring for at most this many sequence errors per stream
+        size_t capture_dumps_remaining;
+        //! expected timestamp offset in a coherent group, in ticks
+        int64_t time_offset_ticks;
+        //! next queued packet, claimed early so its payload cache lines
+        //  can be prefetched while the current packet is converted
+        managed_recv_buffer::sptr lookahead_buff;
+        //cold: wired up once at stream creation, read-only on the fast path
         get_buff_type get_buff;
         issue_stream_cmd_type issue_stream_cmd;
-        size_t packet_count;
         handle_overflow_type handle_overflow;
         handle_flowctrl_type handle_flowctrl;
         handle_flowctrl_ack_type handle_flowctrl_ack;
-        size_t fc_update_window;
+        boost::shared_ptr<stream_counters_type> counters;
+        //! optional header snapshot ring for drop forensics
+        boost::shared_ptr<packet_capture_ring> capture_ring;
+        //! pollable descriptor of the transport, -1 when it has none
+        int recv_fd;
     };
     std::vector<xport_chan_props_type> _props;
     size_t _num_outputs;
     size_t _bytes_per_otw_item; //used in conversion
     size_t _bytes_per_cpu_item; //used in conversion
     uhd::convert::converter::sptr _converter; //used in conversion
+    uhd::convert::id_type _converter_id;
+    uhd::convert::priority_type _converter_prio;
+    size_t _num_conv_threads;
+    double _scale_factor;
+
+    //! caller-owned memory registered for streaming-store conversion
+    struct output_region_type{
+        size_t base;
+        size_t length;
+    };
+    std::vector<output_region_type> _output_regions;
+    uhd::convert::converter::sptr _nt_converter;
+
+    //! True when every output pointer lies inside a registered region
+    UHD_INLINE bool output_mem_registered(void *const *buffs, const size_t num) const{
+        for (size_t i = 0; i < num; i++){
+            const size_t addr = size_t(buffs[i]);
+            bool found = false;
+            for (size_t r = 0; r < _output_regions.size(); r++){
+                if (addr >= _output_regions[r].base and
+                    addr - _output_regions[r].base < _output_regions[r].length){
+                    found = true;
+                    break;
+                }
+            }
+            if (not found) return false;
+        }
+        return true;
+    }
 
     //! information stored for a received buffer
     struct per_buffer_info_type{
@@ -354,7 +1378,8 @@ private:
         PACKET_TIMESTAMP_ERROR,
         PACKET_INLINE_MESSAGE,
         PACKET_TIMEOUT_ERROR,
-        PACKET_SEQUENCE_ERROR
+        PACKET_SEQUENCE_ERROR,
+        PACKET_BAD_HEADER
     };
 
     #ifdef  ERROR_INJECT_DROPPED_PACKETS
@@ -377,9 +1402,34 @@ private:
         per_buffer_info_type &info = curr_buffer_info;
         while (1)
         {
-            //get a single packet from the transport layer
-            buff = _props[index].get_buff(timeout);
-            if (buff.get() == nullptr) return PACKET_TIMEOUT_ERROR;
+            //serve a re-sequenced packet from the reorder window first
+            bool from_reorder_window = false;
+            for (std::vector<reorder_entry_type>::iterator it = _props[index].reorder_window.begin();
+                 it != _props[index].reorder_window.end(); ++it){
+                if (it->packet_count == _props[index].packet_count){
+                    //move the handle: the single owner changes, no
+                    //refcount round trip
+                    buff = std::move(it->buff);
+                    _props[index].reorder_window.erase(it);
+                    from_reorder_window = true;
+                    break;
+                }
+            }
+
+            //otherwise get a single packet from the transport layer
+            //(serving the prefetched lookahead packet first, if any)
+            if (not from_reorder_window){
+                UHD_STAGE_PROF_TS(prof_wait_start);
+                if (_props[index].lookahead_buff){
+                    //move leaves the stash empty, without touching the
+                    //reference count
+                    buff = std::move(_props[index].lookahead_buff);
+                }
+                else buff = _props[index].get_buff(timeout);
+                if (buff.get() == nullptr) return PACKET_TIMEOUT_ERROR;
+                UHD_STAGE_PROF_ACC(STAGE_WAIT, prof_wait_start);
+                UHD_TRACEPOINT2(recv_buff_get, index, buff->size());
+            }
 
             #ifdef  ERROR_INJECT_DROPPED_PACKETS
             if (++recvd_packets > 1000)
@@ -391,6 +1441,8 @@ private:
             }
             #endif
 
+            UHD_STAGE_PROF_TS(prof_unpack_start);
+
             //bounds check before extract
             const size_t num_packet_words32 = buff->size()/sizeof(uint32_t);
             if (num_packet_words32 <= _header_offset_words32){
@@ -401,12 +1453,29 @@ private:
             memset(&info.ifpi, 0, sizeof (vrt::if_packet_info_t));
             info.ifpi.num_packet_words32 = num_packet_words32 - _header_offset_words32;
             info.vrt_hdr = buff->cast<const uint32_t *>() + _header_offset_words32;
-            _vrt_unpacker(info.vrt_hdr, info.ifpi);
+            if (_vrt_unpacker_nothrow != NULL){
+                //code-based rejection: a malformed packet costs no throw
+                if (_vrt_unpacker_nothrow(info.vrt_hdr, info.ifpi) != vrt::UNPACK_NO_ERROR){
+                    return PACKET_BAD_HEADER;
+                }
+                //trusted link mode: once enough packets survive the full
+                //validation, promote to the reduced-check unpacker
+                if (_trusted_unpacker != NULL and ++_validated_packets >= _trusted_after_packets){
+                    _vrt_unpacker_nothrow = _trusted_unpacker;
+                    _trusted_unpacker = NULL;
+                }
+            }
+            else _vrt_unpacker(info.vrt_hdr, info.ifpi);
+            if (_props[index].capture_ring){
+                //black box recorder: one cache-line write per packet
+                _props[index].capture_ring->record(info.vrt_hdr, info.ifpi);
+            }
             info.time = info.ifpi.tsf; //assumes has_tsf is true
             info.copy_buff = reinterpret_cast<const char *>(info.vrt_hdr + info.ifpi.num_header_words32);
 
-            //handle flow control
-            if (_props[index].handle_flowctrl)
+            //handle flow control (already done when the packet first arrived
+            //if it is being served from the reorder window)
+            if (_props[index].handle_flowctrl and not from_reorder_window)
             {
                 if ((info.ifpi.packet_count % _props[index].fc_update_window) == 0)
                 {
@@ -425,6 +1494,27 @@ private:
                 continue;
             }
 
+            //park data packets that arrived ahead of their sequence number
+            //and keep reading: on aggregated links (e.g. dual 10GbE) slight
+            //inter-link reordering is expected and not a discontinuity
+            #ifndef SRPH_DONT_CHECK_SEQUENCE
+            if (info.ifpi.packet_type == vrt::if_packet_info_t::PACKET_TYPE_DATA
+                and not from_reorder_window){
+                const size_t seq_mask = (info.ifpi.link_type == vrt::if_packet_info_t::LINK_TYPE_NONE)? 0xf : 0xfff;
+                const size_t delta = (info.ifpi.packet_count - _props[index].packet_count) & seq_mask;
+                if (delta != 0 and delta <= _props[index].reorder_window_size
+                    and _props[index].reorder_window.size() < _props[index].reorder_window_size){
+                    reorder_entry_type entry;
+                    entry.packet_count = info.ifpi.packet_count;
+                    entry.buff = std::move(buff); //ownership moves into the window
+                    _props[index].reorder_window.push_back(std::move(entry));
+                    info.copy_buff = nullptr;
+                    continue;
+                }
+            }
+            #endif
+
+            UHD_STAGE_PROF_ACC(STAGE_UNPACK, prof_unpack_start);
             break;
         }
 
@@ -445,6 +1535,17 @@ private:
         _props[index].packet_count = (info.ifpi.packet_count + 1) & seq_mask;
         if (expected_packet_count != info.ifpi.packet_count){
             //UHD_LOGGER_INFO("STREAMER") << "expected: " << expected_packet_count << " got: " << info.ifpi.packet_count;
+            //drop parked packets behind the new expected sequence number;
+            //packets still ahead of it remain serviceable
+            std::vector<reorder_entry_type> &window = _props[index].reorder_window;
+            for (size_t i = 0; i < window.size();){
+                const size_t ahead = (window[i].packet_count - _props[index].packet_count) & seq_mask;
+                if (ahead > _props[index].reorder_window_size){
+                    window.erase(window.begin() + i);
+                } else {
+                    i++;
+                }
+            }
             if (_props[index].handle_flowctrl) {
                 // Always update flow control in this case, because we don't
                 // know which packet was dropped and what state the upstream
@@ -461,6 +1562,21 @@ private:
         }
 
         //4) otherwise the packet is normal!
+        //Claim the next queued packet now (non-blocking) and start its
+        //payload cache lines towards the core: the lines arrive while
+        //this packet is being converted, so the first touches of the
+        //next frame no longer miss all the way to DRAM. The claimed
+        //buffer is served ahead of the transport on the next call.
+        if (not _props[index].lookahead_buff and _props[index].get_buff){
+            managed_recv_buffer::sptr next = _props[index].get_buff(0.0);
+            if (next){
+                const char *next_mem = next->cast<const char *>();
+                for (size_t off = 0; off < next->size(); off += 64){
+                    UHD_PREFETCH_READ(next_mem + off);
+                }
+                _props[index].lookahead_buff = std::move(next);
+            }
+        }
         return PACKET_IF_DATA;
     }
 
@@ -492,6 +1608,8 @@ private:
                 prev_buffer_info = curr_buffer_info;
                 curr_buffer_info.reset();
             }
+            _props[i].reorder_window.clear(); // release any parked frames
+            _props[i].lookahead_buff.reset();
         }
     }
 
@@ -502,12 +1620,27 @@ private:
     UHD_INLINE void alignment_check(
         const size_t index, buffers_info_type &info
     ){
+        //compensate the known offset of this channel within a coherent
+        //group before any comparison (the reported metadata timestamps
+        //keep using the unmodified packet time)
+        const uint64_t time = info[index].time - _props[index].time_offset_ticks;
+
+        //in coherent-group mode a residual skew within the tolerance is
+        //the same sample instant; record its peak instead of realigning
+        const uint64_t skew = (time > info.alignment_time)?
+            (time - info.alignment_time) : (info.alignment_time - time);
+        const bool time_matches = info.alignment_time_valid and skew <= _skew_tolerance;
+        if (time_matches and skew > _max_skew_ticks.load(std::memory_order_relaxed)){
+            _max_skew_ticks.store(skew, std::memory_order_relaxed); //only writer
+        }
+
         //if alignment time was not valid or if the sequence id is newer:
         //  use this index's time as the alignment time
         //  reset the indexes list and remove this index
-        if (not info.alignment_time_valid or info[index].time > info.alignment_time){
+        if (not info.alignment_time_valid or
+            (not time_matches and time > info.alignment_time)){
             info.alignment_time_valid = true;
-            info.alignment_time = info[index].time;
+            info.alignment_time = time;
             info.indexes_todo.set();
             info.indexes_todo.reset(index);
             // release the other buffers
@@ -526,7 +1659,7 @@ private:
 
         //if the sequence id matches:
         //  remove this index from the list and continue
-        else if (info[index].time == info.alignment_time){
+        else if (time_matches){
             info.indexes_todo.reset(index);
             // All channels should have sob set at the same time, so only
             // set start_of burst if all channels have sob set.
@@ -544,6 +1677,80 @@ private:
         //else if (info[index].time < info.alignment_time)...
     }
 
+    /*******************************************************************
+     * Lockstep fast path helpers:
+     * While every channel keeps aligning on its first packet, the
+     * per-packet pairwise checks in alignment_check() are deferred.
+     * Each channel's compensated leading time is recorded into the
+     * contiguous _lockstep_times array and one batch scan over that
+     * array verifies the whole set after the pass.
+     ******************************************************************/
+
+    //! Scan the per-channel leading times in one pass.
+    //! Returns true when every channel is within the skew tolerance of
+    //! channel zero; also maintains the peak skew statistic.
+    UHD_INLINE bool lockstep_times_aligned(void){
+        const uint64_t base = _lockstep_times[0];
+        size_t i = 0; //channel zero trivially matches itself
+        #if defined(__SSE2__)
+        //without a tolerance the check is pure equality: compare two
+        //channels per step against the splatted leading time
+        if (_skew_tolerance == 0){
+            const __m128i base2 = _mm_set1_epi64x(int64_t(base));
+            for (; i + 2 <= _lockstep_times.size(); i += 2){
+                const __m128i pair = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i *>(&_lockstep_times[i]));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi32(pair, base2)) != 0xFFFF)
+                    return false;
+            }
+        }
+        #endif
+        for (; i < _lockstep_times.size(); i++){
+            const uint64_t t = _lockstep_times[i];
+            const uint64_t skew = (t > base)? (t - base) : (base - t);
+            if (skew > _skew_tolerance) return false;
+            if (skew > _max_skew_ticks.load(std::memory_order_relaxed)){
+                _max_skew_ticks.store(skew, std::memory_order_relaxed);
+            }
+        }
+        return true;
+    }
+
+    //! Leave the lockstep fast path and rebuild the scalar alignment
+    //! state from the packets already fetched this pass.
+    //! The newest fetched packet is seeded as the alignment leader -
+    //! the scalar machine would have converged on it and discarded
+    //! anything older - then the remaining packets replay through
+    //! alignment_check(). Seeding first matters: replaying in index
+    //! order would let an early channel's leader takeover release the
+    //! buffers of channels not yet replayed.
+    void lockstep_fallback(buffers_info_type &info){
+        _channels_in_lockstep = false;
+        info.alignment_time_valid = false;
+        info.indexes_todo.set();
+        size_t leader = 0;
+        for (size_t i = 0; i < info.size(); i++){
+            if (info[i].copy_buff == nullptr) continue;
+            const uint64_t time = info[i].time - _props[i].time_offset_ticks;
+            if (not info.alignment_time_valid or time > info.alignment_time){
+                info.alignment_time = time;
+                info.alignment_time_valid = true;
+                leader = i;
+            }
+        }
+        if (not info.alignment_time_valid) return; //nothing fetched yet
+        //seed the leader state the way its takeover would have
+        info.indexes_todo.reset(leader);
+        info.data_bytes_to_copy = info[leader].ifpi.num_payload_bytes;
+        info.metadata.start_of_burst = info[leader].ifpi.sob;
+        info.metadata.end_of_burst = info[leader].ifpi.eob;
+        for (size_t i = 0; i < info.size(); i++){
+            if (i != leader and info[i].copy_buff != nullptr){
+                alignment_check(i, info);
+            }
+        }
+    }
+
     /*******************************************************************
      * Get aligned buffers:
      * Iterate through each index and try to accumulate aligned buffers.
@@ -567,6 +1774,7 @@ private:
         // - Handle the packet type yielded by the receive.
         // - Check the timestamps for alignment conditions.
         size_t iterations = 0;
+        while (true){
         while (curr_info.indexes_todo.any()){
 
             //get the index to process for this iteration
@@ -592,17 +1800,28 @@ private:
 
             switch(packet){
             case PACKET_IF_DATA:
-                alignment_check(index, curr_info);
+                _props[index].counters->num_packets.fetch_add(1, std::memory_order_relaxed);
+                if (_channels_in_lockstep){
+                    //defer the pairwise checks; record this channel's
+                    //compensated time for the batch scan after the pass
+                    _lockstep_times[index] =
+                        curr_info[index].time - _props[index].time_offset_ticks;
+                    curr_info.indexes_todo.reset(index);
+                }
+                else alignment_check(index, curr_info);
                 break;
 
             case PACKET_TIMESTAMP_ERROR:
+                if (_channels_in_lockstep) lockstep_fallback(curr_info);
                 //If the user changes the device time while streaming or without flushing,
                 //we can receive a packet that comes before the previous packet in time.
                 //This could cause the alignment logic to discard future received packets.
                 //Therefore, when this occurs, we reset the info to restart from scratch.
-                if (curr_info.alignment_time_valid and curr_info.alignment_time != curr_info[index].time){
+                if (curr_info.alignment_time_valid and curr_info.alignment_time !=
+                    curr_info[index].time - uint64_t(_props[index].time_offset_ticks)){
                     curr_info.alignment_time_valid = false;
                 }
+                _props[index].counters->num_packets.fetch_add(1, std::memory_order_relaxed);
                 alignment_check(index, curr_info);
                 break;
 
@@ -624,6 +1843,7 @@ private:
                     rx_metadata_t metadata = curr_info.metadata;
                     _props[index].handle_overflow();
                     curr_info.metadata = metadata;
+                    _props[index].counters->num_overruns.fetch_add(1, std::memory_order_relaxed);
                     UHD_LOG_FASTPATH("O");
                 }
                 return;
@@ -634,9 +1854,11 @@ private:
                     _props[index].handle_flowctrl(next_info[index].ifpi.packet_count);
                 }
                 curr_info.metadata.error_code = rx_metadata_t::ERROR_CODE_TIMEOUT;
+                _num_timeouts.fetch_add(1, std::memory_order_relaxed);
                 return;
 
             case PACKET_SEQUENCE_ERROR:
+                if (_channels_in_lockstep) lockstep_fallback(curr_info);
                 alignment_check(index, curr_info);
                 std::swap(curr_info, next_info); //save progress from curr -> next
                 curr_info.metadata.has_time_spec = prev_info.metadata.has_time_spec;
@@ -644,9 +1866,26 @@ private:
                     prev_info[index].ifpi.num_payload_words32*sizeof(uint32_t)/_bytes_per_otw_item, _samp_rate);
                 curr_info.metadata.out_of_sequence = true;
                 curr_info.metadata.error_code = rx_metadata_t::ERROR_CODE_OVERFLOW;
+                _props[index].counters->num_sequence_errors.fetch_add(1, std::memory_order_relaxed);
+                //log the recent packet history for the first few errors
+                if (_props[index].capture_ring and _props[index].capture_dumps_remaining > 0){
+                    _props[index].capture_dumps_remaining--;
+                    std::ostringstream dump;
+                    _props[index].capture_ring->dump(dump, 32);
+                    UHD_LOGGER_DEBUG("STREAMER")
+                        << "sequence error on channel " << index
+                        << ", packet capture ring: " << dump.str();
+                }
                 UHD_LOG_FASTPATH("D");
                 return;
 
+            case PACKET_BAD_HEADER:
+                //same handling as the exception path below, minus the throw
+                UHD_LOG_FASTPATH("?");
+                std::swap(curr_info, next_info); //save progress from curr -> next
+                curr_info.metadata.error_code = rx_metadata_t::ERROR_CODE_BAD_PACKET;
+                return;
+
             }
 
             //too many iterations: detect alignment failure
@@ -658,15 +1897,51 @@ private:
                 ) % iterations << std::endl;
                 std::swap(curr_info, next_info); //save progress from curr -> next
                 curr_info.metadata.error_code = rx_metadata_t::ERROR_CODE_ALIGNMENT;
+                _num_alignment_failures.fetch_add(1, std::memory_order_relaxed);
                 _props[index].handle_overflow();
                 return;
             }
 
         }
 
+        //batch verification for the lockstep fast path: one scan over
+        //the contiguous per-channel leading times replaces the per-packet
+        //pairwise checks deferred above
+        if (_channels_in_lockstep and this->size() > 1){
+            if (lockstep_times_aligned()){
+                curr_info.alignment_time = _lockstep_times[0];
+                curr_info.alignment_time_valid = true;
+                curr_info.data_bytes_to_copy = curr_info[0].ifpi.num_payload_bytes;
+                bool sob = true, eob = false;
+                for (size_t i = 0; i < this->size(); i++){
+                    sob = sob and curr_info[i].ifpi.sob;
+                    eob = eob or curr_info[i].ifpi.eob;
+                }
+                curr_info.metadata.start_of_burst = sob;
+                curr_info.metadata.end_of_burst = eob;
+            }
+            else {
+                //channels drifted apart: replay this pass through the
+                //scalar state machine and resume the alignment loop
+                lockstep_fallback(curr_info);
+                if (curr_info.indexes_todo.any()) continue;
+            }
+        }
+        //a scalar pass where every channel aligned on its first packet
+        //means the channels are in lockstep: arm the fast path
+        else if (this->size() > 1 and iterations == this->size()){
+            _channels_in_lockstep = true;
+        }
+        break;
+        } //while (true)
+
         //set the metadata from the buffer information at index zero
         curr_info.metadata.has_time_spec = curr_info[0].ifpi.has_tsf;
-        curr_info.metadata.time_spec = time_spec_t::from_ticks(curr_info[0].time, _tick_rate);
+        curr_info.metadata.time_spec = _time_converter.convert(curr_info[0].time);
+        //the host arrival time of the packet, when the transport captures
+        //it, rides along so callers can correlate it with the tsf above
+        curr_info.metadata.host_recv_timestamp_ns =
+            curr_info[0].buff? curr_info[0].buff->get_recv_timestamp_ns() : 0;
         curr_info.metadata.more_fragments = false;
         curr_info.metadata.fragment_offset = 0;
         curr_info.metadata.error_code = rx_metadata_t::ERROR_CODE_NONE;
@@ -678,6 +1953,13 @@ private:
      * Handles fragmentation, messages, errors, and copy-conversion.
      * When no fragments are available, call the get aligned buffers.
      * Then copy-convert available data into the user's IO buffers.
+     *
+     * Templated on the channel count and converter interleave width so
+     * that the dominant configurations (single channel, one output per
+     * channel) compile to straight-line code with the loops unrolled
+     * away; 0 means "use the runtime value". The instantiation that
+     * matches the streamer's configuration is picked once at setup by
+     * select_recv_one_packet_fcn().
      ******************************************************************/
     UHD_INLINE size_t recv_one_packet(
         const uhd::rx_streamer::buffs_type &buffs,
@@ -686,6 +1968,22 @@ private:
         const double timeout,
         const size_t buffer_offset_bytes = 0
     ){
+        return (this->*_recv_one_packet_fcn)(
+            buffs, nsamps_per_buff, metadata, timeout, buffer_offset_bytes);
+    }
+
+    template <size_t NCHANS, size_t NOUTPUTS>
+    size_t recv_one_packet_typed(
+        const uhd::rx_streamer::buffs_type &buffs,
+        const size_t nsamps_per_buff,
+        uhd::rx_metadata_t &metadata,
+        const double timeout,
+        const size_t buffer_offset_bytes
+    ){
+        //compile-time constants in the specialized instantiations
+        const size_t num_chans = NCHANS? NCHANS : this->size();
+        const size_t num_outputs = NOUTPUTS? NOUTPUTS : _num_outputs;
+
         //get the next buffer if the current one has expired
         if (get_curr_buffer_info().data_bytes_to_copy == 0)
         {
@@ -693,6 +1991,7 @@ private:
             get_aligned_buffs(timeout);
         }
 
+        UHD_STAGE_PROF_TS(prof_metadata_start);
         buffers_info_type &info = get_curr_buffer_info();
         metadata = info.metadata;
 
@@ -701,9 +2000,10 @@ private:
 
         //extract the number of samples available to copy
         const size_t nsamps_available = info.data_bytes_to_copy/_bytes_per_otw_item;
-        const size_t nsamps_to_copy = std::min(nsamps_per_buff*_num_outputs, nsamps_available);
+        const size_t nsamps_to_copy = std::min(nsamps_per_buff*num_outputs, nsamps_available);
         const size_t bytes_to_copy = nsamps_to_copy*_bytes_per_otw_item;
-        const size_t nsamps_to_copy_per_io_buff = nsamps_to_copy/_num_outputs;
+        const size_t nsamps_to_copy_per_io_buff = nsamps_to_copy/num_outputs;
+        UHD_STAGE_PROF_ACC(STAGE_METADATA, prof_metadata_start);
 
         //setup the data to share with converter threads
         _convert_nsamps = nsamps_to_copy_per_io_buff;
@@ -712,8 +2012,8 @@ private:
         _convert_bytes_to_copy = bytes_to_copy;
 
         //perform N channels of conversion
-        for (size_t i = 0; i < this->size(); i++) {
-            convert_to_out_buff(i);
+        for (size_t i = 0; i < num_chans; i++) {
+            convert_to_out_buff<NOUTPUTS>(i);
         }
 
         //update the copy buffer's availability
@@ -734,8 +2034,11 @@ private:
      * - Releases internal data buffers
      * - Updates read/write pointers
      */
+    template <size_t NOUTPUTS>
     inline void convert_to_out_buff(const size_t index)
     {
+        const size_t num_outputs = NOUTPUTS? NOUTPUTS : _num_outputs;
+
         //shortcut references to local data structures
         buffers_info_type &buff_info = get_curr_buffer_info();
         per_buffer_info_type &info = buff_info[index];
@@ -743,30 +2046,186 @@ private:
 
         //fill IO buffs with pointers into the output buffer
         void *io_buffs[4/*max interleave*/];
-        for (size_t i = 0; i < _num_outputs; i++){
-            char *b = reinterpret_cast<char *>(buffs[index*_num_outputs + i]);
+        for (size_t i = 0; i < num_outputs; i++){
+            char *b = reinterpret_cast<char *>(buffs[index*num_outputs + i]);
             io_buffs[i] = b + _convert_buffer_offset_bytes;
         }
-        const ref_vector<void *> out_buffs(io_buffs, _num_outputs);
+        const ref_vector<void *> out_buffs(io_buffs, num_outputs);
 
-        //perform the conversion operation
-        _converter->conv(info.copy_buff, out_buffs, _convert_nsamps);
+        //perform the conversion operation, writing around the cache
+        //when the destination is caller-registered memory
+        uhd::convert::converter *conv = _converter.get();
+        if (_nt_converter and this->output_mem_registered(io_buffs, num_outputs)){
+            conv = _nt_converter.get();
+        }
+        UHD_TRACEPOINT2(recv_convert_begin, index, _convert_nsamps);
+        UHD_STAGE_PROF_TS(prof_convert_start);
+        conv->conv(info.copy_buff, out_buffs, _convert_nsamps);
+        UHD_STAGE_PROF_ACC(STAGE_CONVERT, prof_convert_start);
+        UHD_TRACEPOINT2(recv_convert_end, index, _convert_nsamps);
+
+        //apply host-side IQ corrections while the block is cache-hot
+        if (_iq_corrections_enabled){
+            for (size_t i = 0; i < num_outputs; i++){
+                const size_t out_chan = index*num_outputs + i;
+                if (out_chan < _iq_corrections.size()
+                        and _iq_corrections[out_chan].enabled){
+                    uhd::convert::apply_iq_corrections_fc32(
+                        reinterpret_cast<std::complex<float> *>(io_buffs[i]),
+                        _convert_nsamps,
+                        _iq_corrections[out_chan].scale,
+                        _iq_corrections[out_chan].offset);
+                }
+            }
+        }
+
+        //accumulate signal statistics while the block is cache-hot
+        if (_power_stats_enabled){
+            for (size_t i = 0; i < num_outputs; i++){
+                const size_t out_chan = index*num_outputs + i;
+                if (out_chan >= _power_stats.size()) continue;
+                uhd::power_stats_t &stats = _power_stats[out_chan];
+                uhd::convert::accumulate_power_stats_fc32(
+                    reinterpret_cast<const std::complex<float> *>(io_buffs[i]),
+                    _convert_nsamps,
+                    stats.sum_i, stats.sum_q, stats.sum_power);
+                stats.num_samps += _convert_nsamps;
+            }
+        }
+
+        //run the fused DSP stage while the block is still in cache
+        if (_post_convert_hook){
+            _post_convert_hook(index, out_buffs, _convert_nsamps);
+        }
 
         //advance the pointer for the source buffer
         info.copy_buff += _convert_bytes_to_copy;
 
         //release the buffer if fully consumed
         if (buff_info.data_bytes_to_copy == _convert_bytes_to_copy){
+            UHD_STAGE_PROF_TS(prof_release_start);
             info.buff.reset(); //effectively a release
+            UHD_STAGE_PROF_ACC(STAGE_RELEASE, prof_release_start);
+        }
+    }
+
+    //! Optional kernel fused into the recv pass, empty when unset
+    post_convert_hook_type _post_convert_hook;
+
+    //! Per-output-channel host-side IQ correction parameters
+    struct iq_correction_type{
+        iq_correction_type(void):
+            enabled(false), scale(1.0f, 0.0f), offset(0.0f, 0.0f){}
+        bool enabled;
+        std::complex<float> scale;
+        std::complex<float> offset;
+    };
+    std::vector<iq_correction_type> _iq_corrections;
+    bool _iq_corrections_enabled; //any channel enabled, checked once
+
+    //! Per-output-channel signal statistic accumulators, written by the
+    //! conversion pass, read-and-reset via get_power_stats()
+    std::vector<uhd::power_stats_t> _power_stats;
+    bool _power_stats_enabled;
+
+    /*******************************************************************
+     * Deadline derivation (see set_deadline_scheduling)
+     ******************************************************************/
+
+    //! Samples per second one conversion call sustains, measured once
+    //! over scratch buffers of one packet's size
+    double measure_converter_throughput(void){
+        if (not _converter or _deadline_spp == 0) return 0.0;
+        const size_t spp = _deadline_spp;
+        std::vector<char> in_mem(spp*_bytes_per_otw_item*_num_outputs, 0);
+        std::vector<std::vector<char> > out_mem(_num_outputs,
+            std::vector<char>(spp*_bytes_per_cpu_item, 0));
+        void *out_ptrs[4/*max interleave*/];
+        for (size_t i = 0; i < _num_outputs; i++){
+            out_ptrs[i] = &out_mem[i].front();
+        }
+        const ref_vector<void *> out_buffs(out_ptrs, _num_outputs);
+        //the fastest of a few passes approximates the cache-hot state
+        //the fast path runs in
+        double best_secs = 0.0;
+        for (size_t run = 0; run < 4; run++){
+            const std::chrono::steady_clock::time_point start =
+                std::chrono::steady_clock::now();
+            _converter->conv(&in_mem.front(), out_buffs, spp);
+            const double secs = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+            if (run == 0 or secs < best_secs) best_secs = secs;
+        }
+        if (best_secs <= 0.0) return 0.0;
+        return double(spp)/best_secs;
+    }
+
+    //! Derive the reservation from rate, spp and converter throughput
+    //! and apply it to the calling thread
+    void apply_deadline_schedule(void){
+        _deadline_dirty = false;
+        if (not _deadline_enabled or _deadline_spp == 0) return;
+        //measure the converter once; a format change rebuilds the
+        //streamer, so the figure stays valid for its lifetime
+        if (_deadline_conv_nsps <= 0.0){
+            _deadline_conv_nsps = this->measure_converter_throughput();
+        }
+        const double period = double(_deadline_spp)/_samp_rate;
+        //one conversion per channel per period, tripled to cover the
+        //header parse, metadata and transport release work
+        double runtime = (_deadline_conv_nsps > 0.0)?
+            3.0*this->size()*double(_deadline_spp)/_deadline_conv_nsps : 0.0;
+        //the floor absorbs measurement jitter and burst catch-up; the
+        //ceiling leaves guaranteed time for the rest of the system,
+        //which is the point of deadline over static priority
+        runtime = std::max(runtime, 0.1*period);
+        runtime = std::min(runtime, 0.8*period);
+        if (not uhd::set_thread_deadline(runtime, period)){
+            //admission failed; do not retry on every rate change
+            _deadline_enabled = false;
+            return;
         }
+        UHD_LOGGER_DEBUG("STREAMER") << boost::format(
+            "Deadline reservation armed: %.0f us every %.0f us")
+            % (runtime*1e6) % (period*1e6);
     }
 
+    //! Deadline scheduling state; dirty re-derives on the next recv()
+    bool _deadline_enabled;
+    bool _deadline_dirty;
+    size_t _deadline_spp;
+    double _deadline_conv_nsps; //measured converter samples per second
+
     //! Shared variables for the worker threads
     size_t _convert_nsamps;
     const rx_streamer::buffs_type *_convert_buffs;
     size_t _convert_buffer_offset_bytes;
     size_t _convert_bytes_to_copy;
 
+    //! Pointer to the recv_one_packet instantiation matching the setup
+    typedef size_t (recv_packet_handler::*recv_one_packet_fcn_type)(
+        const uhd::rx_streamer::buffs_type &,
+        const size_t,
+        uhd::rx_metadata_t &,
+        const double,
+        const size_t
+    );
+    recv_one_packet_fcn_type _recv_one_packet_fcn;
+
+    //! Re-pick the specialized packet path; called when the channel
+    //! count or the converter's interleave width changes
+    void select_recv_one_packet_fcn(void){
+        if (this->size() == 1 and _num_outputs == 1){
+            _recv_one_packet_fcn = &recv_packet_handler::recv_one_packet_typed<1, 1>;
+        }
+        else if (_num_outputs == 1){
+            _recv_one_packet_fcn = &recv_packet_handler::recv_one_packet_typed<0, 1>;
+        }
+        else{
+            _recv_one_packet_fcn = &recv_packet_handler::recv_one_packet_typed<0, 0>;
+        }
+    }
+
     /*
      * This last section is only for debugging purposes.
      * It causes a lot of prints to stderr which can be piped to a file.
@@ -830,8 +2289,48 @@ private:
 
 class recv_packet_streamer : public recv_packet_handler, public rx_streamer{
 public:
+    typedef boost::function<void(size_t)> update_spp_fcn_t;
+
     recv_packet_streamer(const size_t max_num_samps){
         _max_num_samps = max_num_samps;
+        _max_spp_limit = max_num_samps;
+    }
+
+    //! Register a per-channel functor that re-programs the device's
+    //! packet size; this enables set_samples_per_packet()
+    void set_update_spp_fcn(const size_t chan, const update_spp_fcn_t &fcn){
+        _update_spp_fcns.resize(std::max(_update_spp_fcns.size(), chan+1));
+        _update_spp_fcns[chan] = fcn;
+    }
+
+    //! Set the frame-size-derived upper bound for runtime packet size
+    //! changes (defaults to the creation-time spp)
+    void set_spp_limit(const size_t max_spp){
+        _max_spp_limit = max_spp;
+    }
+
+    void set_samples_per_packet(const size_t spp){
+        if (_update_spp_fcns.empty()) throw uhd::not_implemented_error(
+            "set_samples_per_packet() is not supported by this streamer");
+        if (spp == 0 or spp > _max_spp_limit) throw uhd::value_error(str(
+            boost::format("set_samples_per_packet(): spp %u out of range [1, %u]")
+            % spp % _max_spp_limit));
+        for (size_t i = 0; i < _update_spp_fcns.size(); i++){
+            if (_update_spp_fcns[i]) _update_spp_fcns[i](spp);
+        }
+        //the handler takes each packet's size from its header, so only
+        //the advertised maximum needs to track the new packet size
+        _max_num_samps = spp;
+        recv_packet_handler::update_deadline_spp(spp);
+    }
+
+    //! Enable deadline scheduling derived from the current packet size
+    void set_deadline_scheduling(const bool enable){
+        recv_packet_handler::set_deadline_scheduling(enable, _max_num_samps);
+    }
+
+    void set_cpu_format(const std::string &cpu_format){
+        recv_packet_handler::request_cpu_format(cpu_format);
     }
 
     size_t get_num_channels(void) const{
@@ -852,13 +2351,119 @@ public:
         return recv_packet_handler::recv(buffs, nsamps_per_buff, metadata, timeout, one_packet);
     }
 
+    size_t recv_multi(
+        const std::vector<rx_streamer::buffs_type> &buffs,
+        const size_t nsamps_per_buff,
+        std::vector<size_t> &nsamps,
+        std::vector<uhd::rx_metadata_t> &metadata,
+        const double timeout,
+        const bool one_packet
+    ){
+        return recv_packet_handler::recv_multi(
+            buffs, nsamps_per_buff, nsamps, metadata, timeout, one_packet
+        );
+    }
+
+    bool recv_loan(
+        rx_streamer::buff_loan_t &loan,
+        uhd::rx_metadata_t &metadata,
+        const double timeout
+    ){
+        return recv_packet_handler::recv_loan(loan, metadata, timeout);
+    }
+
+    size_t post_recv_buff(
+        const rx_streamer::buffs_type &buffs,
+        const size_t nsamps_per_buff
+    ){
+        return recv_packet_handler::post_recv_buff(buffs, nsamps_per_buff);
+    }
+
+    bool recv_posted(
+        rx_streamer::recv_completion_t &completion,
+        const double timeout
+    ){
+        return recv_packet_handler::recv_posted(completion, timeout);
+    }
+
+    uhd::stream_stats_t get_stream_stats(void) const
+    {
+        return recv_packet_handler::get_stream_stats();
+    }
+
+    uhd::convert::converter_info_type get_converter_info(void) const
+    {
+        return recv_packet_handler::get_converter_info();
+    }
+
+    const uhd::sample_timekeeper &get_timekeeper(void) const
+    {
+        return recv_packet_handler::get_timekeeper();
+    }
+
+    void enable_history(const double duration)
+    {
+        return recv_packet_handler::enable_history(duration);
+    }
+
+    size_t freeze_history(void)
+    {
+        return recv_packet_handler::freeze_history();
+    }
+
+    size_t read_history(
+        const buffs_type &buffs,
+        const size_t nsamps_per_buff,
+        const size_t offset
+    ){
+        return recv_packet_handler::read_history(buffs, nsamps_per_buff, offset);
+    }
+
+    void resume_history(void)
+    {
+        return recv_packet_handler::resume_history();
+    }
+
+    std::vector<int> get_recv_fds(void) const
+    {
+        return recv_packet_handler::get_recv_fds();
+    }
+
     void issue_stream_cmd(const stream_cmd_t &stream_cmd)
     {
         return recv_packet_handler::issue_stream_cmd(stream_cmd);
     }
 
+    void schedule_stream_cmds(const std::vector<stream_cmd_t> &stream_cmds)
+    {
+        return recv_packet_handler::schedule_stream_cmds(stream_cmds);
+    }
+
+    void register_recv_buff(void *mem, const size_t num_bytes)
+    {
+        return recv_packet_handler::register_output_memory(mem, num_bytes);
+    }
+
+    void set_iq_corrections(
+        const size_t chan,
+        const std::complex<float> &scale,
+        const std::complex<float> &offset
+    ){
+        return recv_packet_handler::set_iq_corrections(chan, scale, offset);
+    }
+
+    void set_power_stats_enabled(const bool enable){
+        return recv_packet_handler::set_power_stats_enabled(enable);
+    }
+
+    uhd::power_stats_t get_power_stats(const size_t chan){
+        return recv_packet_handler::get_power_stats(chan);
+    }
+
 private:
     size_t _max_num_samps;
+    size_t _max_spp_limit;
+    std::vector<update_spp_fcn_t> _update_spp_fcns;
 };
 
 }}} //namespace
@@ -14,16 +14,26 @@
 #include <uhd/stream.hpp>
 #include <uhd/utils/tasks.hpp>
 #include <uhd/utils/byteswap.hpp>
+#include <uhd/utils/log.hpp>
 #include <uhd/utils/thread.hpp>
 #include <uhd/types/metadata.hpp>
 #include <uhd/transport/vrt_if_packet.hpp>
 #include <uhd/transport/zero_copy.hpp>
 #include <uhdlib/rfnoc/tx_stream_terminator.hpp>
+#include <uhdlib/convert/convert_threaded.hpp>
+#include <uhdlib/utils/tracepoints.hpp>
+#include <uhdlib/utils/stage_profiler.hpp>
+#include <uhdlib/utils/alloc_guard.hpp>
 #include <boost/function.hpp>
+#include <boost/make_shared.hpp>
+#include <cstring>
 #include <iostream>
 #include <vector>
 #include <chrono>
 #include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 #ifdef UHD_TXRX_DEBUG_PRINTS
 // Included for debugging
@@ -38,6 +48,187 @@ namespace uhd {
 namespace transport {
 namespace sph {
 
+//! Seconds of burst a pacer bucket may accumulate while its stream idles
+static const double PACER_BUCKET_DEPTH = 0.005;
+//! Bucket floor so the largest packet always fits (jumbo frame x channels)
+static const size_t PACER_MIN_BUCKET_BYTES = 65536;
+
+/***********************************************************************
+ * Token-bucket send pacer
+ *
+ * Streamers that feed the same physical link share one of these so
+ * their send() calls draw from a common link budget instead of racing
+ * each other into the transport and the device-side FIFO. Every stream
+ * refills a private bucket at its own rate-derived byte rate; a shared
+ * bucket refills at the paced fraction of the link rate. A packet goes
+ * on the wire when both buckets cover it and no stream in a more
+ * urgent priority tier is waiting on the link budget.
+ **********************************************************************/
+class send_pacer{
+public:
+    typedef boost::shared_ptr<send_pacer> sptr;
+
+    /*!
+     * \param link_rate usable link rate in bytes per second
+     *                  (zero disables the shared budget, leaving only
+     *                  the per-stream buckets)
+     * \param utilization fraction of the link rate the pacer may grant
+     */
+    send_pacer(const double link_rate, const double utilization = 0.95):
+        _link_rate(link_rate*utilization),
+        _link_tokens(bucket_cap(link_rate*utilization)),
+        _last_refill(std::chrono::steady_clock::now())
+    {
+        /* NOP */
+    }
+
+    /*!
+     * Register a stream and get back the handle consume() takes.
+     * \param priority the stream's tier, 0 is served first
+     */
+    size_t register_stream(const size_t priority){
+        std::unique_lock<std::mutex> lock(_mutex);
+        stream_type stream;
+        stream.byte_rate = 0.0;
+        stream.tokens = 0.0;
+        stream.pending_bytes = 0.0;
+        stream.priority = priority;
+        stream.waiting = false;
+        _streams.push_back(stream);
+        return _streams.size()-1;
+    }
+
+    //! Update a stream's pacing rate in bytes per second; zero (the
+    //! rate is not yet known) suspends that stream's private bucket
+    void set_stream_rate(const size_t stream, const double byte_rate){
+        std::unique_lock<std::mutex> lock(_mutex);
+        _streams.at(stream).byte_rate = byte_rate;
+        //start full so a rate change does not stall the next packet
+        _streams.at(stream).tokens = bucket_cap(byte_rate);
+        _cond.notify_all();
+    }
+
+    /*!
+     * Block until both buckets cover nbytes, then consume them.
+     * Returns false when the timeout expires first.
+     */
+    bool consume(const size_t stream, const size_t nbytes, const double timeout){
+        std::unique_lock<std::mutex> lock(_mutex);
+        stream_type &self = _streams.at(stream);
+        const std::chrono::steady_clock::time_point deadline =
+            std::chrono::steady_clock::now()
+            + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(timeout));
+        while (true){
+            this->refill();
+            if (this->can_send(self, nbytes)){
+                //tokens may go negative here when a packet is larger
+                //than the bucket; the debt pays itself off in refill()
+                //and keeps the long-term byte rate honest
+                if (self.byte_rate > 0.0) self.tokens -= double(nbytes);
+                if (_link_rate > 0.0) _link_tokens -= double(nbytes);
+                _cond.notify_all();
+                return true;
+            }
+            const double remaining = std::chrono::duration<double>(
+                deadline - std::chrono::steady_clock::now()).count();
+            if (remaining <= 0.0) return false;
+
+            //sleep until the slower bucket has refilled the deficit,
+            //re-checking periodically for priority tier handoffs
+            double wait = 100e-6;
+            if (self.byte_rate > 0.0){
+                wait = std::max(wait, token_deficit(self.tokens,
+                    nbytes, self.byte_rate)/self.byte_rate);
+            }
+            if (_link_rate > 0.0){
+                wait = std::max(wait, token_deficit(_link_tokens,
+                    nbytes, _link_rate)/_link_rate);
+            }
+            self.waiting = true;
+            self.pending_bytes = double(nbytes);
+            _cond.wait_for(lock, std::chrono::duration<double>(
+                std::min(wait, remaining)));
+            self.waiting = false;
+        }
+    }
+
+private:
+    struct stream_type{
+        double byte_rate;
+        double tokens;
+        double pending_bytes;
+        size_t priority;
+        bool waiting;
+    };
+
+    //! A bucket holds a burst window of tokens, never less than one
+    //! maximum-sized packet (or consume() could never succeed)
+    UHD_INLINE static double bucket_cap(const double byte_rate){
+        return std::max(byte_rate*PACER_BUCKET_DEPTH, double(PACER_MIN_BUCKET_BYTES));
+    }
+
+    //! How many tokens a bucket still owes for an nbytes packet
+    UHD_INLINE static double token_deficit(
+        const double tokens, const size_t nbytes, const double byte_rate
+    ){
+        const double need = std::min(double(nbytes), bucket_cap(byte_rate));
+        return (tokens < need)? need - tokens : 0.0;
+    }
+
+    //! Credit all buckets for the wall time since the last refill
+    UHD_INLINE void refill(void){
+        const std::chrono::steady_clock::time_point now =
+            std::chrono::steady_clock::now();
+        const double elapsed =
+            std::chrono::duration<double>(now - _last_refill).count();
+        _last_refill = now;
+        if (_link_rate > 0.0){
+            _link_tokens = std::min(
+                _link_tokens + elapsed*_link_rate, bucket_cap(_link_rate));
+        }
+        for (size_t i = 0; i < _streams.size(); i++){
+            stream_type &stream = _streams[i];
+            if (stream.byte_rate <= 0.0) continue;
+            stream.tokens = std::min(
+                stream.tokens + elapsed*stream.byte_rate,
+                bucket_cap(stream.byte_rate));
+        }
+    }
+
+    //! A stream may send when its buckets cover the packet and no more
+    //! urgent tier is queued up on the shared link budget
+    UHD_INLINE bool can_send(const stream_type &self, const size_t nbytes){
+        if (self.byte_rate > 0.0 and
+            self.tokens < std::min(double(nbytes), bucket_cap(self.byte_rate))){
+            return false;
+        }
+        if (_link_rate > 0.0){
+            if (_link_tokens < std::min(double(nbytes), bucket_cap(_link_rate))){
+                return false;
+            }
+            for (size_t i = 0; i < _streams.size(); i++){
+                const stream_type &other = _streams[i];
+                if (not other.waiting or other.priority >= self.priority) continue;
+                //only yield when the higher tier is short on the shared
+                //budget; its private rate limit is not our contention
+                if (other.byte_rate > 0.0 and
+                    other.tokens < std::min(other.pending_bytes,
+                        bucket_cap(other.byte_rate))) continue;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const double _link_rate;
+    double _link_tokens;
+    std::chrono::steady_clock::time_point _last_refill;
+    std::vector<stream_type> _streams;
+    std::mutex _mutex;
+    std::condition_variable _cond;
+};
+
 /***********************************************************************
  * Super send packet handler
  *
@@ -49,7 +240,13 @@ class send_packet_handler{
 public:
     typedef std::function<managed_send_buffer::sptr(double)> get_buff_type;
     typedef std::function<void(void)> post_send_cb_type;
+    //! chan index, destination in the transport buffer (OTW format),
+    //! sample capacity; returns the number of samples produced
+    typedef std::function<size_t(const size_t, void *, const size_t)> pull_fill_type;
     typedef std::function<bool(uhd::async_metadata_t &, const double)> async_receiver_type;
+    typedef std::function<double(void)> occupancy_fcn_type;
+    typedef std::function<uint64_t(void)> hw_occupancy_fcn_type;
+    typedef std::function<void(const bool)> watermark_cb_type;
     typedef void(*vrt_packer_type)(uint32_t *, vrt::if_packet_info_t &);
     //typedef std::function<void(uint32_t *, vrt::if_packet_info_t &)> vrt_packer_type;
 
@@ -58,7 +255,14 @@ public:
      * \param size the number of transport channels
      */
     send_packet_handler(const size_t size = 1):
-        _next_packet_seq(0), _cached_metadata(false)
+        _num_timeouts(0), _num_dropped_samps(0),
+        _async_event_counters(boost::make_shared<async_event_counters_type>()),
+        _converter_prio(-1),
+        _vrt_packer(NULL), _vrt_packer_no_tsf(NULL), _vrt_packer_tsf(NULL),
+        _next_packet_seq(0),
+        _warmed_up(false), _drop_on_timeout(false), _cached_metadata(false),
+        _low_watermark(0.0), _high_watermark(1.0), _above_high_watermark(false),
+        _replicate_channels(false), _pacer_stream(0)
     {
         this->set_enable_trailer(true);
         this->resize(size);
@@ -74,6 +278,9 @@ public:
         _props.resize(size);
         static const uint64_t zero = 0;
         _zero_buffs.resize(size, &zero);
+        _replicate_packet_words32.resize(size);
+        _span_index.resize(size);
+        _span_offset.resize(size);
     }
 
     //! Get the channel width of this handler
@@ -87,6 +294,22 @@ public:
         _header_offset_words32 = header_offset_words32;
     }
 
+    /*!
+     * Setup layout-specialized vrt packer variants.
+     *
+     * When set, the handler packs each header with the variant matching
+     * the packet's has_tsf flag instead of the generic packer, so a
+     * compile-time specialized routine (see chdr::if_hdr_pack_tmpl) can
+     * run branch-free for the layout actually on the wire. The flag
+     * only changes between bursts, so the selection branch predicts.
+     */
+    void set_vrt_packer_variants(
+        const vrt_packer_type &without_tsf, const vrt_packer_type &with_tsf
+    ){
+        _vrt_packer_no_tsf = without_tsf;
+        _vrt_packer_tsf = with_tsf;
+    }
+
     //! Set the stream ID for a specific channel (or no SID)
     void set_xport_chan_sid(const size_t xport_chan, const bool has_sid, const uint32_t sid = 0){
         _props.at(xport_chan).has_sid = has_sid;
@@ -108,6 +331,19 @@ public:
         _samp_rate = rate;
     }
 
+    /*!
+     * Attach this handler to a pacer shared with the other streamers
+     * on the same link. Every packet then draws its wire bytes from
+     * the pacer before taking transport buffers, so bursty callers
+     * queue in the pacer instead of flooding the device-side FIFO.
+     * \param pacer the shared pacer (an empty sptr detaches)
+     * \param stream this handler's stream handle from register_stream()
+     */
+    void set_pacer(const send_pacer::sptr &pacer, const size_t stream = 0){
+        _pacer = pacer;
+        _pacer_stream = stream;
+    }
+
     /*!
      * Set the function to get a managed buffer.
      * \param xport_chan which transport channel
@@ -126,15 +362,120 @@ public:
         _props.at(xport_chan).go_postal = cb;
     }
 
+    /*!
+     * Set the callback to flush batched sends on this channel.
+     * The callback runs once at the end of every send() call so
+     * that packets a transport held back for batching cannot
+     * outlive the call that committed them.
+     * \param xport_chan which transport channel
+     * \param cb the callback function
+     */
+    void set_xport_chan_flush_send_cb(const size_t xport_chan, const post_send_cb_type &cb){
+        _props.at(xport_chan).flush_send = cb;
+    }
+
+    /*!
+     * Set the functor that reports this channel's device buffer fill
+     * level as a fraction of the flow control window; this enables
+     * get_buffer_occupancy().
+     * \param xport_chan which transport channel
+     * \param fcn the occupancy getter function
+     */
+    void set_xport_chan_occupancy_fcn(const size_t xport_chan, const occupancy_fcn_type &fcn){
+        _props.at(xport_chan).get_occupancy = fcn;
+    }
+
+    //! Report the fullest channel's device buffer occupancy [0.0, 1.0]
+    double get_buffer_occupancy(void) const{
+        double occupancy = -1.0;
+        for (size_t i = 0; i < _props.size(); i++){
+            if (_props[i].get_occupancy){
+                occupancy = std::max(occupancy, _props[i].get_occupancy());
+            }
+        }
+        if (occupancy < 0.0) throw uhd::not_implemented_error(
+            "get_buffer_occupancy() is not supported by this streamer");
+        return occupancy;
+    }
+
+    /*!
+     * Set the functor that reads this channel's hardware buffer fill
+     * level in bytes (e.g. the DMA FIFO occupied count). The readback
+     * costs register transactions, so it runs only when stats are
+     * polled, never on the fast path.
+     * \param xport_chan which transport channel
+     * \param fcn the fill level getter function
+     * \param capacity_bytes the hardware buffer capacity in bytes
+     */
+    void set_xport_chan_hw_occupancy_fcn(
+        const size_t xport_chan,
+        const hw_occupancy_fcn_type &fcn,
+        const uint64_t capacity_bytes
+    ){
+        _props.at(xport_chan).get_hw_occupancy = fcn;
+        _props.at(xport_chan).hw_occupancy_capacity = capacity_bytes;
+    }
+
+    /*!
+     * Register a low/high watermark callback on the device buffer.
+     * The flow-control-derived occupancy is checked at the end of
+     * every send call; the callback fires with true on rising through
+     * the high watermark and with false on falling back through the
+     * low one. The callback runs on the send thread and must be
+     * lightweight and non-allocating.
+     */
+    void set_occupancy_watermarks(const double low, const double high, const watermark_cb_type &cb){
+        if (not (0.0 <= low and low <= high and high <= 1.0)){
+            throw uhd::value_error(str(boost::format(
+                "set_occupancy_watermarks(): bad watermarks [%f, %f]")
+                % low % high));
+        }
+        _low_watermark = low;
+        _high_watermark = high;
+        _watermark_cb = cb;
+    }
+
     //! Set the conversion routine for all channels
-    void set_converter(const uhd::convert::id_type &id){
+    void set_converter(
+        const uhd::convert::id_type &id,
+        const size_t num_conv_threads = 1,
+        const uhd::convert::priority_type prio = -1
+    ){
         _num_inputs = id.num_inputs;
-        _converter = uhd::convert::get_converter(id)();
+        uhd::convert::function_type conv_fcn;
+        uhd::convert::priority_type selected_prio = -1;
+        if (prio != -1){
+            try{
+                conv_fcn = uhd::convert::get_converter(id, prio);
+                selected_prio = prio;
+            }
+            catch(const uhd::key_error &){
+                UHD_LOGGER_DEBUG("STREAMER")
+                    << "No converter with requested priority " << prio
+                    << " for " << id.to_string() << ", using the default";
+                conv_fcn = uhd::convert::get_converter(id);
+            }
+        }
+        else conv_fcn = uhd::convert::get_converter(id);
+        if (selected_prio == -1){
+            selected_prio = uhd::convert::get_converter_priority(id);
+        }
+        _converter = uhd::convert::make_threaded_converter(
+            conv_fcn(), id, num_conv_threads);
+        _converter_id = id;
+        _converter_prio = selected_prio;
+        UHD_LOGGER_DEBUG("STREAMER") << "Using converter: "
+            << uhd::convert::get_converter_info(id, selected_prio).to_pp_string();
         this->set_scale_factor(32767.); //update after setting converter
         _bytes_per_otw_item = uhd::convert::get_bytes_per_item(id.output_format);
         _bytes_per_cpu_item = uhd::convert::get_bytes_per_item(id.input_format);
     }
 
+    //! Describe the conversion routine resolved by set_converter
+    uhd::convert::converter_info_type get_converter_info(void) const{
+        return uhd::convert::get_converter_info(_converter_id, _converter_prio);
+    }
+
     /*!
      * Set the maximum number of samples per host packet.
      * Ex: A USRP1 in dual channel mode would be half.
@@ -149,12 +490,55 @@ public:
         _converter->set_scalar(scale_factor);
     }
 
+    /*!
+     * Register the fill callback for pull-mode streaming.
+     *
+     * In pull mode the send machinery inverts the data flow: when
+     * transport credits are available, the callback is invoked with a
+     * pointer directly into the send buffer (past the packed header)
+     * and produces samples in the over-the-wire format. A signal
+     * generator thereby needs no pacing thread, no intermediate sample
+     * queue, and no extra copy - flow control paces the callback.
+     *
+     * The callback runs once per channel per packet and should fill the
+     * full capacity; when channels return different counts, the minimum
+     * is committed on every channel and the excess is discarded. A
+     * return of zero ends the current send_pull call.
+     */
+    void set_pull_fill_callback(const pull_fill_type &fill){
+        _pull_fill = fill;
+    }
+
     //! Set the callback to get async messages
     void set_async_receiver(const async_receiver_type &async_receiver)
     {
         _async_receiver = async_receiver;
     }
 
+    /*!
+     * Enable or disable drop-on-timeout send mode.
+     * When enabled, the timeout of a send() call is a hard deadline:
+     * a packet the transports cannot accept before the deadline is
+     * dropped and counted instead of blocking the caller, so the
+     * latency of a real-time feed stays bounded under congestion.
+     */
+    void set_drop_on_timeout(const bool enable){
+        _drop_on_timeout = enable;
+    }
+
+    /*!
+     * Enable or disable replicated-send mode.
+     * When enabled, only the first channel's input buffer is read: it
+     * is converted once and the converted payload is copied into every
+     * other channel's transport buffer. A payload memcpy is far
+     * cheaper than the converter pass, so sending one waveform on N
+     * channels no longer costs N conversions. Headers are still packed
+     * per channel (the SIDs differ).
+     */
+    void set_replicate_channels(const bool enable){
+        _replicate_channels = enable;
+    }
+
     //! Overload call to get async metadata
     bool recv_async_msg(
         uhd::async_metadata_t &async_metadata, double timeout = 0.1
@@ -164,6 +548,54 @@ public:
         return false;
     }
 
+    /*!
+     * Device-signalled event counters.
+     * The async message path aggregates device-reported underflows,
+     * downlink sequence errors and time errors here from its own task
+     * threads; get_stream_stats() folds them into the snapshot. Held
+     * through a shared_ptr so a counting task and the handler need not
+     * agree on teardown order.
+     */
+    struct async_event_counters_type{
+        async_event_counters_type(void):
+            num_underruns(0), num_seq_errors(0), num_time_errors(0)
+        {}
+        std::atomic<uint64_t> num_underruns;
+        std::atomic<uint64_t> num_seq_errors;
+        std::atomic<uint64_t> num_time_errors;
+    };
+
+    //! Get the counter block for the async message path to feed
+    boost::shared_ptr<async_event_counters_type> get_async_event_counters(void) const{
+        return _async_event_counters;
+    }
+
+    /*******************************************************************
+     * Performance counters:
+     * Sum the per-channel atomics into a snapshot for the caller.
+     * Safe to call from a monitoring thread while send() is running.
+     ******************************************************************/
+    uhd::stream_stats_t get_stream_stats(void) const{
+        uhd::stream_stats_t stats;
+        for (size_t i = 0; i < _props.size(); i++){
+            stats.num_packets += _props[i].counters->num_packets.load(std::memory_order_relaxed);
+            stats.num_fc_stalls += _props[i].counters->num_fc_stalls.load(std::memory_order_relaxed);
+            stats.fc_stall_time_ns += _props[i].counters->fc_stall_time_ns.load(std::memory_order_relaxed);
+            if (_props[i].get_hw_occupancy){
+                stats.device_buff_bytes += _props[i].get_hw_occupancy();
+                stats.device_buff_capacity += _props[i].hw_occupancy_capacity;
+            }
+        }
+        stats.num_timeouts = _num_timeouts.load(std::memory_order_relaxed);
+        stats.num_dropped_samps = _num_dropped_samps.load(std::memory_order_relaxed);
+        stats.num_device_underruns = _async_event_counters->num_underruns.load(std::memory_order_relaxed);
+        stats.num_device_seq_errors = _async_event_counters->num_seq_errors.load(std::memory_order_relaxed);
+        stats.num_device_time_errors = _async_event_counters->num_time_errors.load(std::memory_order_relaxed);
+        stats.update_link_quality();
+        UHD_STAGE_PROF_FILL(stats);
+        return stats;
+    }
+
     /*******************************************************************
      * Send:
      * The entry point for the fast-path send calls.
@@ -174,6 +606,189 @@ public:
         const size_t nsamps_per_buff,
         const uhd::tx_metadata_t &metadata,
         const double timeout
+    ){
+        //the warm-up call may allocate (vector growth, converter state);
+        //every call after it must not (see alloc_guard.hpp)
+        scoped_alloc_guard alloc_guard(_warmed_up);
+        _warmed_up = true;
+
+        //in drop mode the timeout bounds the whole call, fragments and all
+        if (_drop_on_timeout){
+            _send_exit_time = std::chrono::steady_clock::now()
+                + std::chrono::microseconds(long(timeout*1e6));
+        }
+
+        const size_t num_samps_sent = this->send_dispatch(
+            buffs, nsamps_per_buff, metadata, timeout
+        );
+
+        //flush any packets the transports held back for batching
+        for (size_t i = 0; i < _props.size(); i++){
+            if (_props[i].flush_send) _props[i].flush_send();
+        }
+
+        this->check_occupancy_watermarks();
+
+        return num_samps_sent;
+    }
+
+    /*******************************************************************
+     * Pull-mode send:
+     * Samples are produced by the registered fill callback directly in
+     * the transport buffers as flow control credits become available.
+     ******************************************************************/
+    size_t send_pull(
+        const size_t nsamps_per_buff,
+        const uhd::tx_metadata_t &metadata,
+        const double timeout
+    ){
+        if (not _pull_fill) throw uhd::runtime_error(
+            "send_pull called without a fill callback registered");
+
+        scoped_alloc_guard alloc_guard(_warmed_up);
+        _warmed_up = true;
+
+        if (_drop_on_timeout){
+            _send_exit_time = std::chrono::steady_clock::now()
+                + std::chrono::microseconds(long(timeout*1e6));
+        }
+
+        //translate the metadata to vrt if packet info
+        vrt::if_packet_info_t if_packet_info;
+        if_packet_info.packet_type = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+        if_packet_info.has_cid = false;
+        if_packet_info.has_tlr = _has_tlr;
+        if_packet_info.has_tsi = false;
+        if_packet_info.has_tsf = metadata.has_time_spec;
+        if_packet_info.tsf     = metadata.time_spec.to_ticks(_tick_rate);
+        if_packet_info.sob     = metadata.start_of_burst;
+        if_packet_info.eob     = false; //set on the final fragment
+        if_packet_info.fc_ack  = false;
+
+        size_t total_num_samps_sent = 0;
+        while (total_num_samps_sent < nsamps_per_buff){
+            const size_t nsamps_this_packet = std::min(
+                nsamps_per_buff - total_num_samps_sent, _max_samples_per_packet);
+            if (total_num_samps_sent + nsamps_this_packet == nsamps_per_buff){
+                if_packet_info.eob = metadata.end_of_burst;
+            }
+            const size_t num_samps_sent = send_one_packet_pull(
+                nsamps_this_packet, if_packet_info, timeout);
+            total_num_samps_sent += num_samps_sent;
+
+            //stop on timeout or on a callback that ran dry
+            if (num_samps_sent < nsamps_this_packet) break;
+
+            //setup metadata for the next fragment
+            const time_spec_t time_spec = metadata.time_spec
+                + time_spec_t::from_ticks(total_num_samps_sent, _samp_rate);
+            if_packet_info.tsf = time_spec.to_ticks(_tick_rate);
+            if_packet_info.sob = false;
+        }
+
+        //flush any packets the transports held back for batching
+        for (size_t i = 0; i < _props.size(); i++){
+            if (_props[i].flush_send) _props[i].flush_send();
+        }
+
+        this->check_occupancy_watermarks();
+
+        return total_num_samps_sent;
+    }
+
+    /*******************************************************************
+     * Scatter-gather send:
+     * Each channel's samples may be scattered across several memory
+     * spans; the conversion pass walks the span lists directly while
+     * packing frames, so no contiguous staging copy is needed.
+     ******************************************************************/
+    size_t send_spans(
+        const std::vector<uhd::tx_streamer::span_list_t> &buffs,
+        const uhd::tx_metadata_t &metadata,
+        const double timeout
+    ){
+        if (_num_inputs != 1) throw uhd::runtime_error(
+            "send_spans() does not support formats with interleaved input buffers");
+        if (buffs.size() != this->size()) throw uhd::value_error(str(boost::format(
+            "send_spans() got %u span lists for %u channels")
+            % buffs.size() % this->size()));
+
+        //total samples per channel; every channel must agree so the
+        //packets stay aligned across the transports
+        size_t nsamps_per_buff = 0;
+        for (size_t i = 0; i < buffs[0].size(); i++){
+            nsamps_per_buff += buffs[0][i].nsamps;
+        }
+        for (size_t chan = 1; chan < buffs.size(); chan++){
+            size_t nsamps = 0;
+            for (size_t i = 0; i < buffs[chan].size(); i++){
+                nsamps += buffs[chan][i].nsamps;
+            }
+            if (nsamps != nsamps_per_buff) throw uhd::value_error(
+                "send_spans() requires the same sample total on every channel");
+        }
+
+        //metadata-only calls take the regular path (sob caching, eob packets)
+        if (nsamps_per_buff == 0){
+            return this->send(_zero_buffs, 0, metadata, timeout);
+        }
+
+        scoped_alloc_guard alloc_guard(_warmed_up);
+        _warmed_up = true;
+
+        if (_drop_on_timeout){
+            _send_exit_time = std::chrono::steady_clock::now()
+                + std::chrono::microseconds(long(timeout*1e6));
+        }
+
+        //reset the per-channel span cursors for this call
+        for (size_t chan = 0; chan < this->size(); chan++){
+            _span_index[chan] = 0;
+            _span_offset[chan] = 0;
+        }
+
+        const size_t num_samps_sent = this->send_spans_dispatch(
+            buffs, nsamps_per_buff, metadata, timeout
+        );
+
+        //flush any packets the transports held back for batching
+        for (size_t i = 0; i < _props.size(); i++){
+            if (_props[i].flush_send) _props[i].flush_send();
+        }
+
+        this->check_occupancy_watermarks();
+
+        return num_samps_sent;
+    }
+
+private:
+
+    //! Fire the watermark callback on occupancy threshold crossings;
+    //! runs once per send call, costs one pass over the fc state
+    UHD_INLINE void check_occupancy_watermarks(void){
+        if (not _watermark_cb) return;
+        double occupancy = -1.0;
+        for (size_t i = 0; i < _props.size(); i++){
+            if (_props[i].get_occupancy){
+                occupancy = std::max(occupancy, _props[i].get_occupancy());
+            }
+        }
+        if (occupancy < 0.0) return;
+        if (not _above_high_watermark and occupancy >= _high_watermark){
+            _above_high_watermark = true;
+            _watermark_cb(true);
+        }
+        else if (_above_high_watermark and occupancy <= _low_watermark){
+            _above_high_watermark = false;
+            _watermark_cb(false);
+        }
+    }
+
+    UHD_INLINE size_t send_dispatch(
+        const uhd::tx_streamer::buffs_type &buffs,
+        const size_t nsamps_per_buff,
+        const uhd::tx_metadata_t &metadata,
+        const double timeout
     ){
         //translate the metadata to vrt if packet info
         vrt::if_packet_info_t if_packet_info;
@@ -272,31 +887,178 @@ public:
 		return nsamps_sent;
     }
 
+    UHD_INLINE size_t send_spans_dispatch(
+        const std::vector<uhd::tx_streamer::span_list_t> &buffs,
+        const size_t nsamps_per_buff,
+        const uhd::tx_metadata_t &metadata,
+        const double timeout
+    ){
+        //translate the metadata to vrt if packet info
+        vrt::if_packet_info_t if_packet_info;
+        if_packet_info.packet_type = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+        if_packet_info.has_cid = false;
+        if_packet_info.has_tlr = _has_tlr;
+        if_packet_info.has_tsi = false;
+        if_packet_info.has_tsf = metadata.has_time_spec;
+        if_packet_info.tsf     = metadata.time_spec.to_ticks(_tick_rate);
+        if_packet_info.sob     = metadata.start_of_burst;
+        if_packet_info.eob     = metadata.end_of_burst;
+        if_packet_info.fc_ack  = false; //This is a data packet
+
+        //apply metadata cached by an empty start-of-burst send
+        if (_cached_metadata)
+        {
+            if (!metadata.has_time_spec)
+            {
+                if_packet_info.has_tsf = _metadata_cache.has_time_spec;
+                if_packet_info.tsf     = _metadata_cache.time_spec.to_ticks(_tick_rate);
+            }
+            if_packet_info.sob     = _metadata_cache.start_of_burst;
+            if_packet_info.eob     = _metadata_cache.end_of_burst;
+            _cached_metadata = false;
+        }
+
+        if (nsamps_per_buff <= _max_samples_per_packet){
+            return send_one_packet_spans(buffs, nsamps_per_buff, if_packet_info, timeout);
+        }
+
+        size_t total_num_samps_sent = 0;
+
+        //false until final fragment
+        if_packet_info.eob = false;
+
+        const size_t num_fragments = (nsamps_per_buff-1)/_max_samples_per_packet;
+        const size_t final_length = ((nsamps_per_buff-1)%_max_samples_per_packet)+1;
+
+        //loop through the following fragment indexes
+        for (size_t i = 0; i < num_fragments; i++){
+
+            //send a fragment with the helper function
+            const size_t num_samps_sent = send_one_packet_spans(
+                buffs, _max_samples_per_packet, if_packet_info, timeout);
+            total_num_samps_sent += num_samps_sent;
+            if (num_samps_sent == 0) return total_num_samps_sent;
+
+            //setup metadata for the next fragment
+            const time_spec_t time_spec = metadata.time_spec + time_spec_t::from_ticks(total_num_samps_sent, _samp_rate);
+            if_packet_info.tsf = time_spec.to_ticks(_tick_rate);
+            if_packet_info.sob = false;
+        }
+
+        //send the final fragment with the helper function
+        if_packet_info.eob = metadata.end_of_burst;
+        return total_num_samps_sent
+            + send_one_packet_spans(buffs, final_length, if_packet_info, timeout);
+    }
+
 private:
 
     vrt_packer_type _vrt_packer;
+    //! layout-specialized packers, NULL unless armed via set_vrt_packer_variants
+    vrt_packer_type _vrt_packer_no_tsf;
+    vrt_packer_type _vrt_packer_tsf;
     size_t _header_offset_words32;
+
+    //! Pack one header with the best packer for this packet's layout
+    UHD_INLINE void pack_header(uint32_t *mem, vrt::if_packet_info_t &ifpi){
+        if (_vrt_packer_tsf != NULL){
+            (ifpi.has_tsf? _vrt_packer_tsf : _vrt_packer_no_tsf)(mem, ifpi);
+        }
+        else _vrt_packer(mem, ifpi);
+    }
     double _tick_rate, _samp_rate;
-    struct xport_chan_props_type{
-        xport_chan_props_type(void):has_sid(false),sid(0){}
+    //! per-channel event counters (shared_ptr because atomics cannot be copied on resize)
+    //
+    // Padded to a full cache line so the counter blocks of adjacent
+    // channels (allocated back-to-back in resize()) cannot false-share
+    // when each channel is driven from its own thread.
+    struct UHD_ALIGNED(64) stream_counters_type{
+        stream_counters_type(void):
+            num_packets(0), num_fc_stalls(0), fc_stall_time_ns(0)
+        {}
+        std::atomic<uint64_t> num_packets;
+        std::atomic<uint64_t> num_fc_stalls;
+        std::atomic<uint64_t> fc_stall_time_ns;
+    };
+    std::atomic<uint64_t> _num_timeouts;
+    std::atomic<uint64_t> _num_dropped_samps;
+    //! device-signalled events, fed by the async message path
+    boost::shared_ptr<async_event_counters_type> _async_event_counters;
+#ifdef UHD_TXRX_STAGE_PROFILING
+    //! per-stage cycle histograms (compile-in micro-profiler)
+    stage_profiler _stage_profiler;
+#endif
+    //! Per-channel state, spaced one cache line apart inside _props.
+    //
+    // The buff pointer is swapped on every packet; with one worker
+    // thread per channel the neighbouring elements are written by
+    // different cores, so the struct is aligned and padded to the cache
+    // line size with the per-packet state first. Everything else is
+    // wired up once at stream creation and only read on the fast path.
+    struct UHD_ALIGNED(64) xport_chan_props_type{
+        xport_chan_props_type(void):
+            has_sid(false),
+            sid(0),
+            counters(boost::make_shared<stream_counters_type>())
+        {}
+        //hot: re-assigned on every packet sent down this channel
+        managed_send_buffer::sptr buff;
+        //cold: wired up once at stream creation, read-only on the fast path
         get_buff_type get_buff;
         post_send_cb_type go_postal;
+        post_send_cb_type flush_send;
+        occupancy_fcn_type get_occupancy;
+        hw_occupancy_fcn_type get_hw_occupancy;
+        uint64_t hw_occupancy_capacity = 0;
         bool has_sid;
         uint32_t sid;
-        managed_send_buffer::sptr buff;
+        boost::shared_ptr<stream_counters_type> counters;
     };
     std::vector<xport_chan_props_type> _props;
     size_t _num_inputs;
     size_t _bytes_per_otw_item; //used in conversion
     size_t _bytes_per_cpu_item; //used in conversion
     uhd::convert::converter::sptr _converter; //used in conversion
+    uhd::convert::id_type _converter_id;
+    uhd::convert::priority_type _converter_prio;
     size_t _max_samples_per_packet;
     std::vector<const void *> _zero_buffs;
     size_t _next_packet_seq;
+    bool _warmed_up; //first send() happened, allocations now asserted away
+    bool _drop_on_timeout; //drop rather than block past the send deadline
+    std::chrono::steady_clock::time_point _send_exit_time;
     bool _has_tlr;
     async_receiver_type _async_receiver;
     bool _cached_metadata;
     uhd::tx_metadata_t _metadata_cache;
+    double _low_watermark;
+    double _high_watermark;
+    watermark_cb_type _watermark_cb;
+    bool _above_high_watermark;
+    bool _replicate_channels; //convert once, fan payload out to all channels
+    std::vector<size_t> _replicate_packet_words32; //scratch, sized in resize()
+    //per-channel span cursors for send_spans, sized in resize()
+    std::vector<size_t> _span_index;
+    std::vector<size_t> _span_offset;
+    //! shared link pacer, empty unless attached via set_pacer()
+    send_pacer::sptr _pacer;
+    size_t _pacer_stream;
+
+    /*******************************************************************
+     * Draw this packet's wire bytes from the shared pacer (when one is
+     * attached). Returns false when the pacer deadline passes first.
+     ******************************************************************/
+    UHD_INLINE bool pace_one_packet(
+        const vrt::if_packet_info_t &if_packet_info, const double timeout
+    ){
+        if (not _pacer) return true;
+        if (_pacer->consume(_pacer_stream,
+            if_packet_info.num_payload_bytes*this->size(), timeout)){
+            return true;
+        }
+        _num_timeouts.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
 
 #ifdef UHD_TXRX_DEBUG_PRINTS
     struct dbg_send_stat_t {
@@ -343,6 +1105,47 @@ private:
 
 #endif
 
+    /*******************************************************************
+     * Acquire a send buffer on every channel.
+     * Returns true when all channels hold a buffer. On failure, buffers
+     * already acquired for other channels stay cached for the next call
+     * and \p dropped tells a drop-mode caller apart from a timeout.
+     ******************************************************************/
+    UHD_INLINE bool acquire_send_buffs(const double timeout, bool &dropped){
+        dropped = false;
+        BOOST_FOREACH(xport_chan_props_type &props, _props){
+            if (not props.buff){
+                //poll first so that waiting on flow control credit
+                //(no free send buffer) can be counted as a stall
+                props.buff = props.get_buff(0.0);
+                if (not props.buff){
+                    props.counters->num_fc_stalls.fetch_add(1, std::memory_order_relaxed);
+                    //time the blocking wait: the stall path is already
+                    //stalled, so two clock reads cost nothing relative
+                    const std::chrono::steady_clock::time_point stall_start =
+                        std::chrono::steady_clock::now();
+                    if (_drop_on_timeout){
+                        //block only until this call's deadline
+                        const double remaining = std::chrono::duration<double>(
+                            _send_exit_time - stall_start).count();
+                        if (remaining > 0.0) props.buff = props.get_buff(remaining);
+                    }
+                    else props.buff = props.get_buff(timeout);
+                    props.counters->fc_stall_time_ns.fetch_add(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - stall_start).count(),
+                        std::memory_order_relaxed);
+                }
+            }
+            if (not props.buff){
+                _num_timeouts.fetch_add(1, std::memory_order_relaxed);
+                dropped = _drop_on_timeout;
+                return false;
+            }
+        }
+        return true;
+    }
+
     /*******************************************************************
      * Send a single packet:
      ******************************************************************/
@@ -359,11 +1162,26 @@ private:
         if_packet_info.num_payload_words32 = (if_packet_info.num_payload_bytes + 3/*round up*/)/sizeof(uint32_t);
         if_packet_info.packet_count = _next_packet_seq;
 
+        //pace against the shared link budget first
+        if (not pace_one_packet(if_packet_info, timeout)){
+            return 0; //timeout
+        }
+
         //get a buffer for each channel or timeout
-        BOOST_FOREACH(xport_chan_props_type &props, _props){
-            if (not props.buff) props.buff = props.get_buff(timeout);
-            if (not props.buff) return 0; //timeout
+        bool dropped = false;
+        UHD_STAGE_PROF_TS(prof_wait_start);
+        if (not acquire_send_buffs(timeout, dropped)){
+            if (dropped){
+                //deadline passed: drop this packet instead of blocking.
+                //the caller sees the samples as sent so its pacing is
+                //undisturbed.
+                _num_dropped_samps.fetch_add(
+                    nsamps_per_buff*this->size(), std::memory_order_relaxed);
+                return nsamps_per_buff;
+            }
+            return 0; //timeout
         }
+        UHD_STAGE_PROF_ACC(STAGE_WAIT, prof_wait_start);
 
         //setup the data to share with converter threads
         _convert_nsamps = nsamps_per_buff;
@@ -371,8 +1189,12 @@ private:
         _convert_buffer_offset_bytes = buffer_offset_bytes;
         _convert_if_packet_info = &if_packet_info;
 
-        //perform N channels of conversion
-        for (size_t i = 0; i < this->size(); i++) {
+        //perform N channels of conversion, or one conversion plus
+        //payload replication when all channels carry the same samples
+        if (_replicate_channels and this->size() > 1){
+            send_replicated();
+        }
+        else for (size_t i = 0; i < this->size(); i++) {
             convert_to_in_buff(i);
         }
 
@@ -403,19 +1225,29 @@ private:
         const ref_vector<const void *> in_buffs(io_buffs, _num_inputs);
 
         //pack metadata into a vrt header
+        UHD_STAGE_PROF_TS(prof_metadata_start);
         uint32_t *otw_mem = buff->cast<uint32_t *>() + _header_offset_words32;
         if_packet_info.has_sid = _props[index].has_sid;
         if_packet_info.sid = _props[index].sid;
-        _vrt_packer(otw_mem, if_packet_info);
+        pack_header(otw_mem, if_packet_info);
         otw_mem += if_packet_info.num_header_words32;
+        UHD_STAGE_PROF_ACC(STAGE_METADATA, prof_metadata_start);
 
         //perform the conversion operation
+        UHD_TRACEPOINT2(send_convert_begin, index, _convert_nsamps);
+        UHD_STAGE_PROF_TS(prof_convert_start);
         _converter->conv(in_buffs, otw_mem, _convert_nsamps);
+        UHD_STAGE_PROF_ACC(STAGE_CONVERT, prof_convert_start);
+        UHD_TRACEPOINT2(send_convert_end, index, _convert_nsamps);
 
         //commit the samples to the zero-copy interface
         const size_t num_vita_words32 = _header_offset_words32+if_packet_info.num_packet_words32;
+        UHD_TRACEPOINT2(send_commit, index, num_vita_words32*sizeof(uint32_t));
+        UHD_STAGE_PROF_TS(prof_release_start);
         buff->commit(num_vita_words32*sizeof(uint32_t));
         buff.reset(); //effectively a release
+        UHD_STAGE_PROF_ACC(STAGE_RELEASE, prof_release_start);
+        _props[index].counters->num_packets.fetch_add(1, std::memory_order_relaxed);
 
         if (_props[index].go_postal)
         {
@@ -423,12 +1255,261 @@ private:
         }
     }
 
+    /*! Replicated-send path: convert the first channel's input once,
+     *  then fan the converted payload out to the remaining channels.
+     *
+     * Only the first channel's input buffer is read. Each channel
+     * still gets its own header (per-channel SID, and header sizes may
+     * differ), but channels 1..N-1 receive the payload by memcpy from
+     * the first channel's converted packet instead of running the
+     * converter again.
+     */
+    UHD_INLINE void send_replicated(void)
+    {
+        vrt::if_packet_info_t if_packet_info = *_convert_if_packet_info;
+        const tx_streamer::buffs_type &buffs = *_convert_buffs;
+
+        //fill IO buffs with pointers into the first channel's buffer
+        const void *io_buffs[4/*max interleave*/];
+        for (size_t i = 0; i < _num_inputs; i++){
+            const char *b = reinterpret_cast<const char *>(buffs[i]);
+            io_buffs[i] = b + _convert_buffer_offset_bytes;
+        }
+        const ref_vector<const void *> in_buffs(io_buffs, _num_inputs);
+
+        //pack the first channel's header and convert once
+        UHD_STAGE_PROF_TS(prof_metadata_start);
+        uint32_t *otw_mem = _props[0].buff->cast<uint32_t *>() + _header_offset_words32;
+        if_packet_info.has_sid = _props[0].has_sid;
+        if_packet_info.sid = _props[0].sid;
+        pack_header(otw_mem, if_packet_info);
+        uint32_t *payload = otw_mem + if_packet_info.num_header_words32;
+        UHD_STAGE_PROF_ACC(STAGE_METADATA, prof_metadata_start);
+
+        UHD_TRACEPOINT2(send_convert_begin, 0, _convert_nsamps);
+        UHD_STAGE_PROF_TS(prof_convert_start);
+        _converter->conv(in_buffs, payload, _convert_nsamps);
+        UHD_STAGE_PROF_ACC(STAGE_CONVERT, prof_convert_start);
+        UHD_TRACEPOINT2(send_convert_end, 0, _convert_nsamps);
+
+        //fan the payload out to the remaining channels before any
+        //commit, so the source payload cannot be recycled under us
+        _replicate_packet_words32[0] = if_packet_info.num_packet_words32;
+        for (size_t i = 1; i < this->size(); i++){
+            vrt::if_packet_info_t hdr = *_convert_if_packet_info;
+            hdr.has_sid = _props[i].has_sid;
+            hdr.sid = _props[i].sid;
+            uint32_t *chan_mem = _props[i].buff->cast<uint32_t *>() + _header_offset_words32;
+            pack_header(chan_mem, hdr);
+            std::memcpy(
+                chan_mem + hdr.num_header_words32, payload,
+                hdr.num_payload_words32*sizeof(uint32_t));
+            _replicate_packet_words32[i] = hdr.num_packet_words32;
+        }
+
+        //commit every channel
+        for (size_t i = 0; i < this->size(); i++){
+            commit_chan_buff(i, _replicate_packet_words32[i]);
+        }
+    }
+
+    //! Commit one channel's packet to its transport and release it
+    UHD_INLINE void commit_chan_buff(const size_t index, const size_t num_packet_words32)
+    {
+        managed_send_buffer::sptr &buff = _props[index].buff;
+        const size_t num_vita_words32 = _header_offset_words32 + num_packet_words32;
+        UHD_TRACEPOINT2(send_commit, index, num_vita_words32*sizeof(uint32_t));
+        UHD_STAGE_PROF_TS(prof_release_start);
+        buff->commit(num_vita_words32*sizeof(uint32_t));
+        buff.reset(); //effectively a release
+        UHD_STAGE_PROF_ACC(STAGE_RELEASE, prof_release_start);
+        _props[index].counters->num_packets.fetch_add(1, std::memory_order_relaxed);
+
+        if (_props[index].go_postal)
+        {
+            _props[index].go_postal();
+        }
+    }
+
+    //! Move a channel's span cursor forward by nsamps without reading
+    UHD_INLINE void advance_span_cursor(
+        const uhd::tx_streamer::span_list_t &spans,
+        const size_t chan,
+        size_t nsamps
+    ){
+        while (nsamps != 0){
+            const uhd::tx_streamer::span_t &span = spans[_span_index[chan]];
+            if (_span_offset[chan] == span.nsamps){
+                _span_index[chan]++;
+                _span_offset[chan] = 0;
+                continue;
+            }
+            const size_t n = std::min(nsamps, span.nsamps - _span_offset[chan]);
+            _span_offset[chan] += n;
+            nsamps -= n;
+        }
+    }
+
+    /*******************************************************************
+     * Send a single packet gathered from the span lists:
+     * The converter runs once per contiguous span piece, writing to an
+     * advancing offset in the transport buffer, so scattered input
+     * costs extra converter calls but never a staging copy.
+     ******************************************************************/
+    UHD_INLINE size_t send_one_packet_spans(
+        const std::vector<uhd::tx_streamer::span_list_t> &buffs,
+        const size_t nsamps_per_buff,
+        vrt::if_packet_info_t &if_packet_info,
+        const double timeout
+    ){
+        //load the rest of the if_packet_info in here
+        if_packet_info.num_payload_bytes = nsamps_per_buff*_num_inputs*_bytes_per_otw_item;
+        if_packet_info.num_payload_words32 = (if_packet_info.num_payload_bytes + 3/*round up*/)/sizeof(uint32_t);
+        if_packet_info.packet_count = _next_packet_seq;
+
+        //pace against the shared link budget first
+        if (not pace_one_packet(if_packet_info, timeout)){
+            return 0; //timeout
+        }
+
+        //get a buffer for each channel or timeout
+        bool dropped = false;
+        UHD_STAGE_PROF_TS(prof_wait_start);
+        if (not acquire_send_buffs(timeout, dropped)){
+            if (dropped){
+                //deadline passed: drop this packet, but still advance
+                //the span cursors so later fragments stay aligned
+                for (size_t chan = 0; chan < this->size(); chan++){
+                    this->advance_span_cursor(buffs[chan], chan, nsamps_per_buff);
+                }
+                _num_dropped_samps.fetch_add(
+                    nsamps_per_buff*this->size(), std::memory_order_relaxed);
+                return nsamps_per_buff;
+            }
+            return 0; //timeout
+        }
+        UHD_STAGE_PROF_ACC(STAGE_WAIT, prof_wait_start);
+
+        for (size_t chan = 0; chan < this->size(); chan++){
+            //pack metadata into a vrt header
+            UHD_STAGE_PROF_TS(prof_metadata_start);
+            vrt::if_packet_info_t hdr = if_packet_info;
+            hdr.has_sid = _props[chan].has_sid;
+            hdr.sid = _props[chan].sid;
+            uint32_t *otw_mem = _props[chan].buff->cast<uint32_t *>() + _header_offset_words32;
+            pack_header(otw_mem, hdr);
+            char *otw_bytes = reinterpret_cast<char *>(otw_mem + hdr.num_header_words32);
+            UHD_STAGE_PROF_ACC(STAGE_METADATA, prof_metadata_start);
+
+            //gather this packet's samples straight from the span list
+            UHD_TRACEPOINT2(send_convert_begin, chan, nsamps_per_buff);
+            UHD_STAGE_PROF_TS(prof_convert_start);
+            size_t nsamps_left = nsamps_per_buff;
+            while (nsamps_left != 0){
+                const uhd::tx_streamer::span_t &span = buffs[chan][_span_index[chan]];
+                if (_span_offset[chan] == span.nsamps){
+                    //exhausted (or empty) span: move to the next one
+                    _span_index[chan]++;
+                    _span_offset[chan] = 0;
+                    continue;
+                }
+                const size_t nsamps = std::min(
+                    nsamps_left, span.nsamps - _span_offset[chan]);
+                const void *in_mem = reinterpret_cast<const char *>(span.data)
+                    + _span_offset[chan]*_bytes_per_cpu_item;
+                _converter->conv(in_mem, otw_bytes, nsamps);
+                otw_bytes += nsamps*_bytes_per_otw_item;
+                _span_offset[chan] += nsamps;
+                nsamps_left -= nsamps;
+            }
+            UHD_STAGE_PROF_ACC(STAGE_CONVERT, prof_convert_start);
+            UHD_TRACEPOINT2(send_convert_end, chan, nsamps_per_buff);
+
+            //commit the samples to the zero-copy interface
+            commit_chan_buff(chan, hdr.num_packet_words32);
+        }
+
+        _next_packet_seq++; //increment sequence after commits
+        return nsamps_per_buff;
+    }
+
+    /*******************************************************************
+     * Send a single packet in pull mode:
+     * The fill callback produces samples directly in the transport
+     * buffers, so there is no converter pass and no staging copy.
+     ******************************************************************/
+    UHD_INLINE size_t send_one_packet_pull(
+        const size_t nsamps_per_buff,
+        vrt::if_packet_info_t &if_packet_info,
+        const double timeout
+    ){
+        //load the rest of the if_packet_info in here
+        if_packet_info.num_payload_bytes = nsamps_per_buff*_num_inputs*_bytes_per_otw_item;
+        if_packet_info.num_payload_words32 = (if_packet_info.num_payload_bytes + 3/*round up*/)/sizeof(uint32_t);
+        if_packet_info.packet_count = _next_packet_seq;
+
+        //pace against the shared link budget first
+        if (not pace_one_packet(if_packet_info, timeout)){
+            return 0; //timeout
+        }
+
+        //get a buffer for each channel or timeout
+        bool dropped = false;
+        UHD_STAGE_PROF_TS(prof_wait_start);
+        if (not acquire_send_buffs(timeout, dropped)){
+            //in pull mode a missed deadline produces nothing to drop;
+            //the callback simply was not asked for samples
+            return 0;
+        }
+        UHD_STAGE_PROF_ACC(STAGE_WAIT, prof_wait_start);
+
+        //pack a header per channel and fill the payload in place
+        size_t nsamps_filled = nsamps_per_buff;
+        for (size_t i = 0; i < this->size(); i++){
+            vrt::if_packet_info_t hdr = if_packet_info;
+            hdr.has_sid = _props[i].has_sid;
+            hdr.sid = _props[i].sid;
+            uint32_t *otw_mem = _props[i].buff->cast<uint32_t *>() + _header_offset_words32;
+            pack_header(otw_mem, hdr); //also yields num_header_words32
+            const size_t nsamps = _pull_fill(
+                i, otw_mem + hdr.num_header_words32, nsamps_per_buff);
+            nsamps_filled = std::min(nsamps_filled, nsamps);
+        }
+
+        //a dry callback: keep the uncommitted buffers cached and bail
+        if (nsamps_filled == 0) return 0;
+
+        //commit every channel at the shortest fill; headers packed for
+        //the full capacity are repacked when the count shrank (the
+        //header size itself does not depend on the payload length)
+        for (size_t i = 0; i < this->size(); i++){
+            vrt::if_packet_info_t hdr = if_packet_info;
+            hdr.has_sid = _props[i].has_sid;
+            hdr.sid = _props[i].sid;
+            hdr.num_payload_bytes = nsamps_filled*_num_inputs*_bytes_per_otw_item;
+            hdr.num_payload_words32 = (hdr.num_payload_bytes + 3/*round up*/)/sizeof(uint32_t);
+            uint32_t *otw_mem = _props[i].buff->cast<uint32_t *>() + _header_offset_words32;
+            pack_header(otw_mem, hdr);
+            const size_t num_vita_words32 = _header_offset_words32+hdr.num_packet_words32;
+            _props[i].buff->commit(num_vita_words32*sizeof(uint32_t));
+            _props[i].buff.reset(); //effectively a release
+            _props[i].counters->num_packets.fetch_add(1, std::memory_order_relaxed);
+            if (_props[i].go_postal) _props[i].go_postal();
+        }
+
+        _next_packet_seq++; //increment sequence after commits
+        return nsamps_filled;
+    }
+
     //! Shared variables for the worker threads
     size_t _convert_nsamps;
     const tx_streamer::buffs_type *_convert_buffs;
     size_t _convert_buffer_offset_bytes;
     vrt::if_packet_info_t *_convert_if_packet_info;
 
+    //! Fill callback for pull-mode streaming, empty when unset
+    pull_fill_type _pull_fill;
+
 };
 
 class send_packet_streamer : public send_packet_handler, public tx_streamer{
@@ -455,12 +1536,53 @@ public:
         return send_packet_handler::send(buffs, nsamps_per_buff, metadata, timeout);
     }
 
+    size_t send_spans(
+        const std::vector<tx_streamer::span_list_t> &buffs,
+        const uhd::tx_metadata_t &metadata,
+        const double timeout
+    ){
+        return send_packet_handler::send_spans(buffs, metadata, timeout);
+    }
+
     bool recv_async_msg(
         uhd::async_metadata_t &async_metadata, double timeout = 0.1
     ){
         return send_packet_handler::recv_async_msg(async_metadata, timeout);
     }
 
+    uhd::stream_stats_t get_stream_stats(void) const
+    {
+        return send_packet_handler::get_stream_stats();
+    }
+
+    uhd::convert::converter_info_type get_converter_info(void) const
+    {
+        return send_packet_handler::get_converter_info();
+    }
+
+    void set_drop_on_timeout(const bool enable)
+    {
+        return send_packet_handler::set_drop_on_timeout(enable);
+    }
+
+    double get_buffer_occupancy(void) const
+    {
+        return send_packet_handler::get_buffer_occupancy();
+    }
+
+    void set_occupancy_watermarks(
+        const double low,
+        const double high,
+        const std::function<void(const bool)> &callback
+    ){
+        return send_packet_handler::set_occupancy_watermarks(low, high, callback);
+    }
+
+    void set_replicate_channels(const bool enable)
+    {
+        return send_packet_handler::set_replicate_channels(enable);
+    }
+
 private:
     size_t _max_num_samps;
 };
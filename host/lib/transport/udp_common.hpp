@@ -10,6 +10,11 @@
 
 #include <uhd/config.hpp>
 #include <boost/asio.hpp>
+#include <chrono>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace uhd{ namespace transport{
 
@@ -65,6 +70,49 @@ namespace uhd{ namespace transport{
 #endif
     }
 
+    /*!
+     * Pause briefly inside a busy-wait loop.
+     * Uses the pause/yield instruction where available to save power
+     * and to free pipeline resources for the sibling hyper-thread.
+     */
+    UHD_INLINE void spin_wait_pause(void){
+#if defined(__SSE2__)
+        _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        __asm__ __volatile__("yield");
+#endif
+    }
+
+    /*!
+     * Hybrid spin-then-block wait for receive readiness.
+     * Busy-polls the socket for up to the spin budget -- worthwhile
+     * when the next packet is expected within a few microseconds, as
+     * it is at high sample rates -- then falls back to the blocking
+     * wait for the rest of the timeout. A zero budget is the plain
+     * blocking wait.
+     * \param sock_fd the open socket file descriptor
+     * \param timeout the timeout duration in seconds
+     * \param spin_us the busy-poll budget in microseconds
+     * \return true when the socket is ready for receive
+     */
+    UHD_INLINE bool wait_for_recv_ready(int sock_fd, double timeout, const size_t spin_us){
+#ifndef UHD_PLATFORM_WIN32
+        if (spin_us != 0){
+            const std::chrono::steady_clock::time_point deadline =
+                std::chrono::steady_clock::now() + std::chrono::microseconds(long(spin_us));
+            do{
+                pollfd pfd_read;
+                pfd_read.fd = sock_fd;
+                pfd_read.events = POLLIN;
+                if (::poll(&pfd_read, 1, 0) > 0) return true;
+                //a few pauses between probes keep the probe rate sane
+                for (size_t i = 0; i < 32; i++) spin_wait_pause();
+            } while (std::chrono::steady_clock::now() < deadline);
+        }
+#endif
+        return wait_for_recv_ready(sock_fd, timeout);
+    }
+
 }} //namespace uhd::transport
 
 #endif /* INCLUDED_LIBUHD_TRANSPORT_VRT_PACKET_HANDLER_HPP */
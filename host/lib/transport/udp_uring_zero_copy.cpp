@@ -0,0 +1,316 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "udp_uring_zero_copy.hpp"
+#include "udp_common.hpp"
+#include <uhd/transport/buffer_pool.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhdlib/utils/atomic.hpp>
+#include <boost/format.hpp>
+#include <boost/make_shared.hpp>
+#include <liburing.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cstring>
+#include <vector>
+
+using namespace uhd;
+using namespace uhd::transport;
+
+class udp_uring_zero_copy_impl;
+
+/***********************************************************************
+ * Managed receive buffer:
+ *  - the kernel fills the registered buffer via a pre-posted read;
+ *  - release() re-arms the read for this frame.
+ **********************************************************************/
+class udp_uring_mrb : public managed_recv_buffer{
+public:
+    udp_uring_mrb(void *mem, const size_t index, udp_uring_zero_copy_impl *xport):
+        _mem(mem), _index(index), _xport(xport) { /*NOP*/ }
+
+    void release(void); //defined below, needs the impl
+
+    UHD_INLINE sptr get_completed(const size_t len){
+        return make(this, _mem, len);
+    }
+
+    void *get_mem(void) const {return _mem;}
+    size_t get_index(void) const {return _index;}
+
+private:
+    void *_mem;
+    const size_t _index;
+    udp_uring_zero_copy_impl *_xport;
+};
+
+/***********************************************************************
+ * Managed send buffer:
+ *  - commit() posts a fixed-buffer write; the completion is reaped
+ *    lazily when the frame is next requested.
+ **********************************************************************/
+class udp_uring_msb : public managed_send_buffer{
+public:
+    udp_uring_msb(void *mem, const size_t index, udp_uring_zero_copy_impl *xport):
+        _mem(mem), _index(index), _xport(xport), _in_flight(false) { /*NOP*/ }
+
+    void release(void); //defined below, needs the impl
+
+    UHD_INLINE sptr get_new(const size_t frame_size){
+        return make(this, _mem, frame_size);
+    }
+
+    void *get_mem(void) const {return _mem;}
+    size_t get_index(void) const {return _index;}
+    bool in_flight(void) const {return _in_flight;}
+    void set_in_flight(const bool in_flight) {_in_flight = in_flight;}
+
+private:
+    void *_mem;
+    const size_t _index;
+    udp_uring_zero_copy_impl *_xport;
+    bool _in_flight;
+};
+
+/***********************************************************************
+ * Zero copy UDP implementation with io_uring:
+ *   One ring per direction so the recv and send paths never contend.
+ *   All frames are registered with the kernel once at construction;
+ *   read requests stay pre-posted so get_recv_buff() only harvests
+ *   completions and send commits only append submission entries.
+ **********************************************************************/
+class udp_uring_zero_copy_impl : public udp_uring_zero_copy{
+public:
+    typedef boost::shared_ptr<udp_uring_zero_copy_impl> sptr;
+
+    udp_uring_zero_copy_impl(
+        const std::string &addr,
+        const std::string &port,
+        const zero_copy_xport_params &xport_params
+    ):
+        _recv_frame_size(xport_params.recv_frame_size),
+        _num_recv_frames(xport_params.num_recv_frames),
+        _send_frame_size(xport_params.send_frame_size),
+        _num_send_frames(xport_params.num_send_frames),
+        _recv_buffer_pool(buffer_pool::make(xport_params.num_recv_frames, xport_params.recv_frame_size)),
+        _send_buffer_pool(buffer_pool::make(xport_params.num_send_frames, xport_params.send_frame_size)),
+        _next_send_buff_index(0)
+    {
+        UHD_LOGGER_TRACE("UDP")
+            << boost::format("Creating io_uring UDP transport to %s:%s") % addr % port;
+
+        //resolve the address and connect a plain datagram socket
+        addrinfo hint;
+        std::memset(&hint, 0, sizeof(hint));
+        hint.ai_family = AF_INET;
+        hint.ai_socktype = SOCK_DGRAM;
+        addrinfo *result = NULL;
+        if (::getaddrinfo(addr.c_str(), port.c_str(), &hint, &result) != 0){
+            throw uhd::io_error(str(boost::format("getaddrinfo failed for %s:%s") % addr % port));
+        }
+        _sock_fd = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (_sock_fd < 0){
+            ::freeaddrinfo(result);
+            throw uhd::io_error("socket creation failed");
+        }
+        if (::connect(_sock_fd, result->ai_addr, result->ai_addrlen) != 0){
+            ::freeaddrinfo(result);
+            ::close(_sock_fd);
+            throw uhd::io_error(str(boost::format("connect failed for %s:%s") % addr % port));
+        }
+        ::freeaddrinfo(result);
+
+        //one ring per direction; sized to hold every frame in flight
+        if (::io_uring_queue_init(unsigned(_num_recv_frames), &_recv_ring, 0) < 0 or
+            ::io_uring_queue_init(unsigned(_num_send_frames), &_send_ring, 0) < 0){
+            ::close(_sock_fd);
+            throw uhd::runtime_error("io_uring_queue_init failed (kernel too old?)");
+        }
+
+        //register the frame memory so the kernel can fill/drain it directly
+        std::vector<iovec> recv_iovs(_num_recv_frames), send_iovs(_num_send_frames);
+        for (size_t i = 0; i < _num_recv_frames; i++){
+            recv_iovs[i].iov_base = _recv_buffer_pool->at(i);
+            recv_iovs[i].iov_len = _recv_frame_size;
+            _mrb_pool.push_back(boost::make_shared<udp_uring_mrb>(
+                _recv_buffer_pool->at(i), i, this
+            ));
+        }
+        for (size_t i = 0; i < _num_send_frames; i++){
+            send_iovs[i].iov_base = _send_buffer_pool->at(i);
+            send_iovs[i].iov_len = _send_frame_size;
+            _msb_pool.push_back(boost::make_shared<udp_uring_msb>(
+                _send_buffer_pool->at(i), i, this
+            ));
+        }
+        if (::io_uring_register_buffers(&_recv_ring, &recv_iovs.front(), unsigned(_num_recv_frames)) < 0 or
+            ::io_uring_register_buffers(&_send_ring, &send_iovs.front(), unsigned(_num_send_frames)) < 0){
+            throw uhd::runtime_error("io_uring_register_buffers failed");
+        }
+
+        //pre-post a read for every receive frame
+        for (size_t i = 0; i < _num_recv_frames; i++){
+            this->post_recv(i);
+        }
+        ::io_uring_submit(&_recv_ring);
+    }
+
+    ~udp_uring_zero_copy_impl(void){
+        ::io_uring_queue_exit(&_recv_ring);
+        ::io_uring_queue_exit(&_send_ring);
+        ::close(_sock_fd);
+    }
+
+    /*******************************************************************
+     * Receive implementation:
+     * Harvest the next completion; buffers come back in completion
+     * order, and release() re-posts the read for the frame.
+     ******************************************************************/
+    managed_recv_buffer::sptr get_recv_buff(double timeout){
+        io_uring_cqe *cqe = NULL;
+        if (::io_uring_peek_cqe(&_recv_ring, &cqe) != 0){
+            __kernel_timespec ts;
+            ts.tv_sec = long(timeout);
+            ts.tv_nsec = long((timeout - double(ts.tv_sec))*1e9);
+            if (::io_uring_wait_cqe_timeout(&_recv_ring, &cqe, &ts) != 0){
+                return managed_recv_buffer::sptr(); //null for timeout
+            }
+        }
+        const size_t index = size_t((uintptr_t)::io_uring_cqe_get_data(cqe));
+        const int res = cqe->res;
+        ::io_uring_cqe_seen(&_recv_ring, cqe);
+        if (res < 0){
+            //re-arm the frame and report the error
+            this->post_recv(index);
+            ::io_uring_submit(&_recv_ring);
+            throw uhd::io_error(str(boost::format("io_uring recv error: %s") % strerror(-res)));
+        }
+        return _mrb_pool[index]->get_completed(size_t(res));
+    }
+
+    //called from udp_uring_mrb::release
+    void rearm_recv(const size_t index){
+        this->post_recv(index);
+        ::io_uring_submit(&_recv_ring);
+    }
+
+    size_t get_num_recv_frames(void) const {return _num_recv_frames;}
+    size_t get_recv_frame_size(void) const {return _recv_frame_size;}
+
+    /*******************************************************************
+     * Send implementation:
+     * Hand out the next frame once its previous write has completed;
+     * commit appends the write without waiting for the completion.
+     ******************************************************************/
+    managed_send_buffer::sptr get_send_buff(double timeout){
+        if (_next_send_buff_index == _num_send_frames) _next_send_buff_index = 0;
+        boost::shared_ptr<udp_uring_msb> msb = _msb_pool[_next_send_buff_index];
+
+        //reap send completions until this frame is free again
+        const time_spec_t exit_time = uhd::get_system_time() + time_spec_t(timeout);
+        while (msb->in_flight()){
+            this->reap_send_completions();
+            if (msb->in_flight() and uhd::get_system_time() > exit_time){
+                return managed_send_buffer::sptr(); //null for timeout
+            }
+        }
+        _next_send_buff_index++;
+        return msb->get_new(_send_frame_size);
+    }
+
+    //called from udp_uring_msb::release
+    void post_send(udp_uring_msb *msb, const size_t num_bytes){
+        io_uring_sqe *sqe = ::io_uring_get_sqe(&_send_ring);
+        while (sqe == NULL){
+            //submission queue full: reap and retry
+            this->reap_send_completions();
+            sqe = ::io_uring_get_sqe(&_send_ring);
+        }
+        ::io_uring_prep_write_fixed(
+            sqe, _sock_fd, msb->get_mem(), unsigned(num_bytes), 0, int(msb->get_index()));
+        ::io_uring_sqe_set_data(sqe, (void *)(uintptr_t)msb->get_index());
+        msb->set_in_flight(true);
+        ::io_uring_submit(&_send_ring);
+    }
+
+    size_t get_num_send_frames(void) const {return _num_send_frames;}
+    size_t get_send_frame_size(void) const {return _send_frame_size;}
+
+    uint16_t get_local_port(void) const{
+        sockaddr_in sa;
+        socklen_t len = sizeof(sa);
+        if (::getsockname(_sock_fd, (sockaddr *)&sa, &len) != 0) return 0;
+        return ntohs(sa.sin_port);
+    }
+
+    std::string get_local_addr(void) const{
+        sockaddr_in sa;
+        socklen_t len = sizeof(sa);
+        if (::getsockname(_sock_fd, (sockaddr *)&sa, &len) != 0) return "";
+        char buff[INET_ADDRSTRLEN];
+        if (::inet_ntop(AF_INET, &sa.sin_addr, buff, sizeof(buff)) == NULL) return "";
+        return std::string(buff);
+    }
+
+private:
+    void post_recv(const size_t index){
+        io_uring_sqe *sqe = ::io_uring_get_sqe(&_recv_ring);
+        UHD_ASSERT_THROW(sqe != NULL); //ring is sized for all frames
+        ::io_uring_prep_read_fixed(
+            sqe, _sock_fd, _mrb_pool[index]->get_mem(),
+            unsigned(_recv_frame_size), 0, int(index));
+        ::io_uring_sqe_set_data(sqe, (void *)(uintptr_t)index);
+    }
+
+    void reap_send_completions(void){
+        io_uring_cqe *cqe = NULL;
+        while (::io_uring_peek_cqe(&_send_ring, &cqe) == 0){
+            const size_t index = size_t((uintptr_t)::io_uring_cqe_get_data(cqe));
+            const int res = cqe->res;
+            ::io_uring_cqe_seen(&_send_ring, cqe);
+            _msb_pool[index]->set_in_flight(false);
+            if (res < 0){
+                throw uhd::io_error(str(boost::format("io_uring send error: %s") % strerror(-res)));
+            }
+        }
+    }
+
+    //memory management -> buffers and fifos
+    const size_t _recv_frame_size, _num_recv_frames;
+    const size_t _send_frame_size, _num_send_frames;
+    buffer_pool::sptr _recv_buffer_pool, _send_buffer_pool;
+    std::vector<boost::shared_ptr<udp_uring_mrb> > _mrb_pool;
+    std::vector<boost::shared_ptr<udp_uring_msb> > _msb_pool;
+    size_t _next_send_buff_index;
+
+    //io_uring guts -> socket and rings
+    int _sock_fd;
+    io_uring _recv_ring;
+    io_uring _send_ring;
+};
+
+void udp_uring_mrb::release(void){
+    _xport->rearm_recv(_index);
+}
+
+void udp_uring_msb::release(void){
+    _xport->post_send(this, size());
+}
+
+/***********************************************************************
+ * io_uring UDP zero copy make function
+ **********************************************************************/
+udp_zero_copy::sptr udp_uring_zero_copy::make(
+    const std::string &addr,
+    const std::string &port,
+    const zero_copy_xport_params &xport_params
+){
+    return udp_zero_copy::sptr(
+        new udp_uring_zero_copy_impl(addr, port, xport_params)
+    );
+}
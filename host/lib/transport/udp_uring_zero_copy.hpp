@@ -0,0 +1,39 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UDP_URING_ZERO_COPY_HPP
+#define INCLUDED_UDP_URING_ZERO_COPY_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/transport/udp_zero_copy.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <string>
+
+namespace uhd { namespace transport {
+
+/*!
+ * A zero copy UDP transport on top of io_uring with registered buffers.
+ * Receive and send completions are harvested from the completion queues
+ * without a per-packet syscall; the kernel fills/drains the frame pools
+ * directly. Requires a 5.1+ kernel and liburing at build time.
+ */
+class udp_uring_zero_copy : public virtual udp_zero_copy {
+public:
+    /*!
+     * Make a new io_uring UDP transport (same contract as
+     * udp_zero_copy::make). Throws uhd::runtime_error when the kernel
+     * does not support io_uring.
+     */
+    static udp_zero_copy::sptr make(
+        const std::string &addr,
+        const std::string &port,
+        const zero_copy_xport_params &xport_params
+    );
+};
+
+}} //namespace uhd::transport
+
+#endif /* INCLUDED_UDP_URING_ZERO_COPY_HPP */
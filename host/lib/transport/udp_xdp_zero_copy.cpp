@@ -0,0 +1,340 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "udp_xdp_zero_copy.hpp"
+#include "udp_common.hpp"
+#include <uhd/transport/buffer_pool.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhdlib/utils/atomic.hpp>
+#include <boost/format.hpp>
+#include <boost/make_shared.hpp>
+#include <bpf/xsk.h>
+#include <arpa/inet.h>
+#include <linux/if_ether.h>
+#include <linux/ip.h>
+#include <linux/udp.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cstring>
+#include <vector>
+
+using namespace uhd;
+using namespace uhd::transport;
+
+namespace {
+    //AF_XDP chunks may not exceed the page size without huge page UMEMs
+    constexpr size_t XDP_FRAME_SIZE = 4096;
+    //room the kernel leaves in front of the frame data
+    constexpr size_t XDP_PKT_HEADERS =
+        sizeof(ethhdr) + sizeof(iphdr) + sizeof(udphdr);
+}
+
+class udp_xdp_zero_copy_impl;
+
+/***********************************************************************
+ * Managed receive buffer:
+ *  - wraps one UMEM frame handed out by the RX ring;
+ *  - release() recycles the frame address onto the fill ring.
+ **********************************************************************/
+class udp_xdp_mrb : public managed_recv_buffer{
+public:
+    udp_xdp_mrb(udp_xdp_zero_copy_impl *xport):
+        _xport(xport), _umem_addr(0) { /*NOP*/ }
+
+    void release(void); //defined below, needs the impl
+
+    UHD_INLINE sptr get_filled(void *payload, const size_t len, const uint64_t umem_addr){
+        _umem_addr = umem_addr;
+        return make(this, payload, len);
+    }
+
+    UHD_INLINE bool claim(void){
+        return _claimer.claim_with_wait(0.0);
+    }
+
+    uint64_t get_umem_addr(void) const {return _umem_addr;}
+
+private:
+    udp_xdp_zero_copy_impl *_xport;
+    uint64_t _umem_addr;
+    simple_claimer _claimer;
+};
+
+/***********************************************************************
+ * Managed send buffer:
+ *  - copy-and-send on a standard connected socket (see header notes)
+ **********************************************************************/
+class udp_xdp_msb : public managed_send_buffer{
+public:
+    udp_xdp_msb(void *mem, int sock_fd, const size_t frame_size):
+        _mem(mem), _sock_fd(sock_fd), _frame_size(frame_size) { /*NOP*/ }
+
+    void release(void){
+        const ssize_t ret = ::send(_sock_fd, (const char *)_mem, size(), 0);
+        if (ret < 0){
+            throw uhd::io_error(str(boost::format("send error on socket: %s") % strerror(errno)));
+        }
+        _claimer.release();
+    }
+
+    UHD_INLINE sptr get_new(const double timeout, size_t &index){
+        if (not _claimer.claim_with_wait(timeout)) return sptr();
+        index++; //advances the caller's buffer
+        return make(this, _mem, _frame_size);
+    }
+
+private:
+    void *_mem;
+    int _sock_fd;
+    size_t _frame_size;
+    simple_claimer _claimer;
+};
+
+/***********************************************************************
+ * Zero copy UDP implementation with AF_XDP:
+ * The UMEM is one contiguous buffer_pool whose chunks cycle between
+ * the fill ring, the RX ring, and the caller.
+ **********************************************************************/
+class udp_xdp_zero_copy_impl : public udp_xdp_zero_copy{
+public:
+    typedef boost::shared_ptr<udp_xdp_zero_copy_impl> sptr;
+
+    udp_xdp_zero_copy_impl(
+        const std::string &addr,
+        const std::string &port,
+        const std::string &iface,
+        const size_t queue_id,
+        const zero_copy_xport_params &xport_params
+    ):
+        _recv_frame_size(std::min<size_t>(
+            xport_params.recv_frame_size, XDP_FRAME_SIZE - XDP_PKT_HEADERS)),
+        _num_recv_frames(xport_params.num_recv_frames),
+        _send_frame_size(xport_params.send_frame_size),
+        _num_send_frames(xport_params.num_send_frames),
+        _umem_pool(buffer_pool::make(
+            xport_params.num_recv_frames, XDP_FRAME_SIZE, XDP_FRAME_SIZE)),
+        _send_buffer_pool(buffer_pool::make(
+            xport_params.num_send_frames, xport_params.send_frame_size)),
+        _next_recv_mrb_index(0), _next_send_buff_index(0)
+    {
+        UHD_LOGGER_TRACE("UDP")
+            << boost::format("Creating AF_XDP UDP transport to %s:%s (%s queue %d)")
+            % addr % port % iface % queue_id;
+
+        if (_recv_frame_size < xport_params.recv_frame_size){
+            UHD_LOG_WARNING("UDP", "AF_XDP limits recv_frame_size to "
+                << _recv_frame_size << " bytes (page sized UMEM chunks)");
+        }
+
+        //connect a standard socket for the send path and so the local
+        //UDP port is reserved with the kernel
+        addrinfo hint;
+        std::memset(&hint, 0, sizeof(hint));
+        hint.ai_family = AF_INET;
+        hint.ai_socktype = SOCK_DGRAM;
+        addrinfo *result = NULL;
+        if (::getaddrinfo(addr.c_str(), port.c_str(), &hint, &result) != 0){
+            throw uhd::io_error(str(boost::format("getaddrinfo failed for %s:%s") % addr % port));
+        }
+        _sock_fd = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (_sock_fd < 0 or ::connect(_sock_fd, result->ai_addr, result->ai_addrlen) != 0){
+            ::freeaddrinfo(result);
+            throw uhd::io_error(str(boost::format("connect failed for %s:%s") % addr % port));
+        }
+        ::freeaddrinfo(result);
+        _local_port = this->get_local_port();
+
+        //create the UMEM over the receive buffer pool
+        xsk_umem_config umem_cfg;
+        std::memset(&umem_cfg, 0, sizeof(umem_cfg));
+        umem_cfg.fill_size = unsigned(_num_recv_frames);
+        umem_cfg.comp_size = XSK_RING_CONS__DEFAULT_NUM_DESCS;
+        umem_cfg.frame_size = XDP_FRAME_SIZE;
+        umem_cfg.frame_headroom = 0;
+        if (xsk_umem__create(&_umem, _umem_pool->at(0),
+                _num_recv_frames*XDP_FRAME_SIZE, &_fill_ring, &_comp_ring,
+                &umem_cfg) != 0){
+            ::close(_sock_fd);
+            throw uhd::runtime_error("xsk_umem__create failed (kernel too old?)");
+        }
+
+        //create the XDP socket bound to the interface queue
+        xsk_socket_config xsk_cfg;
+        std::memset(&xsk_cfg, 0, sizeof(xsk_cfg));
+        xsk_cfg.rx_size = unsigned(_num_recv_frames);
+        xsk_cfg.tx_size = 0;
+        if (xsk_socket__create(&_xsk, iface.c_str(), unsigned(queue_id),
+                _umem, &_rx_ring, NULL, &xsk_cfg) != 0){
+            xsk_umem__delete(_umem);
+            ::close(_sock_fd);
+            throw uhd::runtime_error(str(boost::format(
+                "xsk_socket__create failed on %s queue %d") % iface % queue_id));
+        }
+        _xsk_fd = xsk_socket__fd(_xsk);
+
+        //hand every UMEM frame to the kernel via the fill ring
+        uint32_t idx = 0;
+        UHD_ASSERT_THROW(xsk_ring_prod__reserve(
+            &_fill_ring, unsigned(_num_recv_frames), &idx) == _num_recv_frames);
+        for (size_t i = 0; i < _num_recv_frames; i++){
+            *xsk_ring_prod__fill_addr(&_fill_ring, idx++) = i*XDP_FRAME_SIZE;
+        }
+        xsk_ring_prod__submit(&_fill_ring, unsigned(_num_recv_frames));
+
+        //allocate the managed buffer wrappers
+        for (size_t i = 0; i < _num_recv_frames; i++){
+            _mrb_pool.push_back(boost::make_shared<udp_xdp_mrb>(this));
+        }
+        for (size_t i = 0; i < _num_send_frames; i++){
+            _msb_pool.push_back(boost::make_shared<udp_xdp_msb>(
+                _send_buffer_pool->at(i), _sock_fd, _send_frame_size));
+        }
+    }
+
+    ~udp_xdp_zero_copy_impl(void){
+        xsk_socket__delete(_xsk);
+        xsk_umem__delete(_umem);
+        ::close(_sock_fd);
+    }
+
+    /*******************************************************************
+     * Receive implementation:
+     * Pop descriptors off the RX ring, recycle frames that do not
+     * belong to our UDP flow, and hand out matching payloads.
+     ******************************************************************/
+    managed_recv_buffer::sptr get_recv_buff(double timeout){
+        const time_spec_t exit_time = uhd::get_system_time() + time_spec_t(timeout);
+        while (true){
+            uint32_t idx = 0;
+            if (xsk_ring_cons__peek(&_rx_ring, 1, &idx) == 0){
+                //nothing pending: block on the socket with the remaining time
+                const double remaining = (exit_time - uhd::get_system_time()).get_real_secs();
+                if (remaining <= 0.0) return managed_recv_buffer::sptr();
+                pollfd pfd;
+                pfd.fd = _xsk_fd;
+                pfd.events = POLLIN;
+                if (::poll(&pfd, 1, int(remaining*1000)) <= 0){
+                    return managed_recv_buffer::sptr(); //null for timeout
+                }
+                continue;
+            }
+
+            const xdp_desc *desc = xsk_ring_cons__rx_desc(&_rx_ring, idx);
+            const uint64_t umem_addr = desc->addr;
+            const size_t len = desc->len;
+            xsk_ring_cons__release(&_rx_ring, 1);
+
+            char *frame = (char *)xsk_umem__get_data(_umem_pool->at(0), umem_addr);
+            if (not this->is_our_flow(frame, len)){
+                this->recycle_frame(umem_addr); //not CHDR traffic
+                continue;
+            }
+
+            //find an unclaimed wrapper (there is always at least one,
+            //since the pool is sized to the number of UMEM frames)
+            while (not _mrb_pool[_next_recv_mrb_index]->claim()){
+                _next_recv_mrb_index = (_next_recv_mrb_index + 1)%_num_recv_frames;
+            }
+            boost::shared_ptr<udp_xdp_mrb> mrb = _mrb_pool[_next_recv_mrb_index];
+            _next_recv_mrb_index = (_next_recv_mrb_index + 1)%_num_recv_frames;
+            return mrb->get_filled(
+                frame + XDP_PKT_HEADERS, len - XDP_PKT_HEADERS, umem_addr);
+        }
+    }
+
+    //called from udp_xdp_mrb::release
+    void recycle_frame(const uint64_t umem_addr){
+        uint32_t idx = 0;
+        while (xsk_ring_prod__reserve(&_fill_ring, 1, &idx) == 0){
+            //fill ring full should not happen (it is sized for all frames)
+            boost::this_thread::yield();
+        }
+        *xsk_ring_prod__fill_addr(&_fill_ring, idx) = umem_addr;
+        xsk_ring_prod__submit(&_fill_ring, 1);
+    }
+
+    size_t get_num_recv_frames(void) const {return _num_recv_frames;}
+    size_t get_recv_frame_size(void) const {return _recv_frame_size;}
+
+    /*******************************************************************
+     * Send implementation (standard socket, see header notes)
+     ******************************************************************/
+    managed_send_buffer::sptr get_send_buff(double timeout){
+        if (_next_send_buff_index == _num_send_frames) _next_send_buff_index = 0;
+        return _msb_pool[_next_send_buff_index]->get_new(timeout, _next_send_buff_index);
+    }
+
+    size_t get_num_send_frames(void) const {return _num_send_frames;}
+    size_t get_send_frame_size(void) const {return _send_frame_size;}
+
+    uint16_t get_local_port(void) const{
+        sockaddr_in sa;
+        socklen_t len = sizeof(sa);
+        if (::getsockname(_sock_fd, (sockaddr *)&sa, &len) != 0) return 0;
+        return ntohs(sa.sin_port);
+    }
+
+    std::string get_local_addr(void) const{
+        sockaddr_in sa;
+        socklen_t len = sizeof(sa);
+        if (::getsockname(_sock_fd, (sockaddr *)&sa, &len) != 0) return "";
+        char buff[INET_ADDRSTRLEN];
+        if (::inet_ntop(AF_INET, &sa.sin_addr, buff, sizeof(buff)) == NULL) return "";
+        return std::string(buff);
+    }
+
+private:
+    //check that the frame is IPv4/UDP addressed at our local port
+    UHD_INLINE bool is_our_flow(const char *frame, const size_t len) const{
+        if (len < XDP_PKT_HEADERS) return false;
+        const ethhdr *eth = (const ethhdr *)frame;
+        if (eth->h_proto != htons(ETH_P_IP)) return false;
+        const iphdr *ip = (const iphdr *)(frame + sizeof(ethhdr));
+        if (ip->protocol != IPPROTO_UDP) return false;
+        const udphdr *udp = (const udphdr *)(frame + sizeof(ethhdr) + sizeof(iphdr));
+        return ntohs(udp->dest) == _local_port;
+    }
+
+    //memory management -> buffers and fifos
+    const size_t _recv_frame_size, _num_recv_frames;
+    const size_t _send_frame_size, _num_send_frames;
+    buffer_pool::sptr _umem_pool, _send_buffer_pool;
+    std::vector<boost::shared_ptr<udp_xdp_mrb> > _mrb_pool;
+    std::vector<boost::shared_ptr<udp_xdp_msb> > _msb_pool;
+    size_t _next_recv_mrb_index, _next_send_buff_index;
+    uint16_t _local_port;
+
+    //AF_XDP guts -> UMEM, rings, sockets
+    int _sock_fd;
+    int _xsk_fd;
+    xsk_umem *_umem;
+    xsk_socket *_xsk;
+    xsk_ring_prod _fill_ring;
+    xsk_ring_cons _comp_ring;
+    xsk_ring_cons _rx_ring;
+};
+
+void udp_xdp_mrb::release(void){
+    _xport->recycle_frame(_umem_addr);
+    _claimer.release();
+}
+
+/***********************************************************************
+ * AF_XDP UDP zero copy make function
+ **********************************************************************/
+udp_zero_copy::sptr udp_xdp_zero_copy::make(
+    const std::string &addr,
+    const std::string &port,
+    const std::string &iface,
+    const size_t queue_id,
+    const zero_copy_xport_params &xport_params
+){
+    return udp_zero_copy::sptr(
+        new udp_xdp_zero_copy_impl(addr, port, iface, queue_id, xport_params)
+    );
+}
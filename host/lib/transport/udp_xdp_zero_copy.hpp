@@ -0,0 +1,49 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UDP_XDP_ZERO_COPY_HPP
+#define INCLUDED_UDP_XDP_ZERO_COPY_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/transport/udp_zero_copy.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <string>
+
+namespace uhd { namespace transport {
+
+/*!
+ * A UDP transport whose receive path runs over an AF_XDP socket:
+ * the kernel XDP redirect places frames directly into a UMEM carved
+ * out of the transport's buffer_pool, so RX completes without a
+ * per-packet syscall or sk_buff allocation. The send path keeps a
+ * standard connected socket (neighbour/route handling stays with the
+ * kernel), which is acceptable because the RX direction carries the
+ * full sample rate.
+ *
+ * Frames not addressed to the transport's UDP flow are recycled back
+ * to the fill ring, so the NIC queue should be steered (e.g. via
+ * ethtool flow rules) at the CHDR traffic for best results.
+ */
+class udp_xdp_zero_copy : public virtual udp_zero_copy {
+public:
+    /*!
+     * Make a new AF_XDP UDP transport (same contract as
+     * udp_zero_copy::make). The interface and queue are taken from
+     * the xdp_iface and xdp_queue transport args.
+     * Throws uhd::runtime_error when the socket cannot be created.
+     */
+    static udp_zero_copy::sptr make(
+        const std::string &addr,
+        const std::string &port,
+        const std::string &iface,
+        const size_t queue_id,
+        const zero_copy_xport_params &xport_params
+    );
+};
+
+}} //namespace uhd::transport
+
+#endif /* INCLUDED_UDP_XDP_ZERO_COPY_HPP */
@@ -6,6 +6,12 @@
 //
 
 #include "udp_common.hpp"
+#ifdef HAVE_LIBURING
+#include "udp_uring_zero_copy.hpp"
+#endif
+#ifdef HAVE_XDP
+#include "udp_xdp_zero_copy.hpp"
+#endif
 #include <uhd/transport/udp_zero_copy.hpp>
 #include <uhd/transport/udp_simple.hpp> //mtu
 #include <uhd/transport/buffer_pool.hpp>
@@ -16,12 +22,24 @@
 #include <boost/make_shared.hpp>
 #include <vector>
 #include <chrono>
+#include <cstring>
 #include <thread>
 
+#ifdef UHD_PLATFORM_LINUX
+#include <sys/socket.h> //recvmmsg
+#include <netinet/in.h> //IP_TOS
+#include <linux/net_tstamp.h> //SOF_TIMESTAMPING flags
+#include <linux/errqueue.h> //scm_timestamping
+#endif
+
 using namespace uhd;
 using namespace uhd::transport;
 namespace asio = boost::asio;
 constexpr size_t UDP_ZERO_COPY_DEFAULT_NUM_FRAMES = 1;
+constexpr size_t UDP_ZERO_COPY_DEFAULT_RECV_BATCH_SIZE = 1; // syscall per packet
+constexpr size_t UDP_ZERO_COPY_MAX_RECV_BATCH_SIZE = 64;
+constexpr size_t UDP_ZERO_COPY_DEFAULT_SEND_BATCH_SIZE = 1; // syscall per packet
+constexpr size_t UDP_ZERO_COPY_MAX_SEND_BATCH_SIZE = 64;
 constexpr size_t UDP_ZERO_COPY_DEFAULT_FRAME_SIZE = 1472; // Based on common 1500 byte MTU for 1GbE.
 constexpr size_t UDP_ZERO_COPY_DEFAULT_BUFF_SIZE = 2500000; // 20ms of data for 1GbE link (in bytes)
 /***********************************************************************
@@ -51,14 +69,45 @@ static void check_registry_for_fast_send_threshold(const size_t mtu){
 }
 #endif /*HAVE_ATLBASE_H*/
 
+#ifdef UHD_PLATFORM_LINUX
+//! pull the receive timestamp out of a message's control data,
+//! preferring the raw hardware stamp over the software one
+static uint64_t extract_rx_timestamp_ns(msghdr &msg){
+    for (cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL; cmsg = CMSG_NXTHDR(&msg, cmsg)){
+        if (cmsg->cmsg_level == SOL_SOCKET and cmsg->cmsg_type == SO_TIMESTAMPING){
+            scm_timestamping ts;
+            std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+            const timespec &t =
+                (ts.ts[2].tv_sec != 0 or ts.ts[2].tv_nsec != 0)? ts.ts[2] : ts.ts[0];
+            return uint64_t(t.tv_sec) * 1000000000ull + uint64_t(t.tv_nsec);
+        }
+    }
+    return 0;
+}
+#endif /*UHD_PLATFORM_LINUX*/
+
+//! allocate a frame pool, NUMA-bound when a node was requested
+static buffer_pool::sptr make_frame_pool(
+    const size_t num_frames, const size_t frame_size, const int numa_node
+){
+    if (numa_node >= 0){
+        return buffer_pool::make_numa(num_frames, frame_size, numa_node);
+    }
+    return buffer_pool::make(num_frames, frame_size);
+}
+
 /***********************************************************************
  * Reusable managed receiver buffer:
  *  - get_new performs the recv operation
  **********************************************************************/
 class udp_zero_copy_asio_mrb : public managed_recv_buffer{
 public:
-    udp_zero_copy_asio_mrb(void *mem, int sock_fd, const size_t frame_size):
-        _mem(mem), _sock_fd(sock_fd), _frame_size(frame_size), _len(0) { /*NOP*/ }
+    udp_zero_copy_asio_mrb(
+        void *mem, int sock_fd, const size_t frame_size, const bool rx_timestamps,
+        const size_t spin_wait_us
+    ):
+        _mem(mem), _sock_fd(sock_fd), _frame_size(frame_size), _len(0),
+        _rx_timestamps(rx_timestamps), _spin_wait_us(spin_wait_us) { /*NOP*/ }
 
     void release(void){
         _claimer.release();
@@ -68,15 +117,15 @@ public:
         if (not _claimer.claim_with_wait(timeout)) return sptr();
 
         #ifdef MSG_DONTWAIT //try a non-blocking recv() if supported
-        _len = ::recv(_sock_fd, (char *)_mem, _frame_size, MSG_DONTWAIT);
+        _len = this->recv_once(MSG_DONTWAIT);
         if (_len > 0){
             index++; //advances the caller's buffer
             return make(this, _mem, size_t(_len));
         }
         #endif
 
-        if (wait_for_recv_ready(_sock_fd, timeout)){
-            _len = ::recv(_sock_fd, (char *)_mem, _frame_size, 0);
+        if (wait_for_recv_ready(_sock_fd, timeout, _spin_wait_us)){
+            _len = this->recv_once(0);
             if (_len == 0)
                 throw uhd::io_error("socket closed");
             if (_len < 0)
@@ -89,11 +138,54 @@ public:
         return sptr(); //null for timeout
     }
 
+    //claim this buffer without performing the recv (batched receive path)
+    UHD_INLINE bool claim(const double timeout){
+        return _claimer.claim_with_wait(timeout);
+    }
+
+    //undo a claim made for a batched receive that yielded no datagram
+    UHD_INLINE void unclaim(void){
+        _claimer.release();
+    }
+
+    //hand out an already-claimed buffer filled by a batched receive
+    UHD_INLINE sptr get_filled(const size_t len, size_t &index){
+        _len = ssize_t(len);
+        index++; //advances the caller's buffer
+        return make(this, _mem, len);
+    }
+
+    void *get_mem(void) const {return _mem;}
+
 private:
+    //! one recv syscall, capturing the receive timestamp when enabled
+    UHD_INLINE ssize_t recv_once(const int flags){
+        #ifdef UHD_PLATFORM_LINUX
+        if (_rx_timestamps){
+            iovec iov;
+            iov.iov_base = _mem;
+            iov.iov_len = _frame_size;
+            char control[CMSG_SPACE(sizeof(scm_timestamping))];
+            msghdr msg;
+            std::memset(&msg, 0, sizeof(msg));
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            msg.msg_control = control;
+            msg.msg_controllen = sizeof(control);
+            const ssize_t len = ::recvmsg(_sock_fd, &msg, flags);
+            if (len > 0) this->set_recv_timestamp_ns(extract_rx_timestamp_ns(msg));
+            return len;
+        }
+        #endif /*UHD_PLATFORM_LINUX*/
+        return ::recv(_sock_fd, (char *)_mem, _frame_size, flags);
+    }
+
     void *_mem;
     int _sock_fd;
     size_t _frame_size;
     ssize_t _len;
+    const bool _rx_timestamps;
+    const size_t _spin_wait_us;
     simple_claimer _claimer;
 };
 
@@ -101,32 +193,18 @@ private:
  * Reusable managed send buffer:
  *  - commit performs the send operation
  **********************************************************************/
+class udp_zero_copy_asio_impl; //owns the batched send state
+
 class udp_zero_copy_asio_msb : public managed_send_buffer{
 public:
-    udp_zero_copy_asio_msb(void *mem, int sock_fd, const size_t frame_size):
-        _mem(mem), _sock_fd(sock_fd), _frame_size(frame_size) { /*NOP*/ }
+    udp_zero_copy_asio_msb(
+        void *mem, int sock_fd, const size_t frame_size,
+        udp_zero_copy_asio_impl *batch_owner
+    ):
+        _mem(mem), _sock_fd(sock_fd), _frame_size(frame_size),
+        _batch_owner(batch_owner) { /*NOP*/ }
 
-    void release(void){
-        //Retry logic because send may fail with ENOBUFS.
-        //This is known to occur at least on some OSX systems.
-        //But it should be safe to always check for the error.
-        while (true)
-        {
-            const ssize_t ret = ::send(_sock_fd, (const char *)_mem, size(), 0);
-            if (ret == ssize_t(size())) break;
-            if (ret == -1 and errno == ENOBUFS)
-            {
-                std::this_thread::sleep_for(std::chrono::microseconds(1));
-                continue; //try to send again
-            }
-            if (ret == -1)
-            {
-                throw uhd::io_error(str(boost::format("send error on socket: %s") % strerror(errno)));
-            }
-            UHD_ASSERT_THROW(ret == ssize_t(size()));
-        }
-        _claimer.release();
-    }
+    void release(void); //defined below the transport implementation
 
     UHD_INLINE sptr get_new(const double timeout, size_t &index){
         if (not _claimer.claim_with_wait(timeout)) return sptr();
@@ -134,10 +212,18 @@ public:
         return make(this, _mem, _frame_size);
     }
 
+    //undo a claim once a batched send of this frame went out
+    UHD_INLINE void unclaim(void){
+        _claimer.release();
+    }
+
+    void *get_mem(void) const {return _mem;}
+
 private:
     void *_mem;
     int _sock_fd;
     size_t _frame_size;
+    udp_zero_copy_asio_impl *_batch_owner;
     simple_claimer _claimer;
 };
 
@@ -161,9 +247,15 @@ public:
         _num_recv_frames(xport_params.num_recv_frames),
         _send_frame_size(xport_params.send_frame_size),
         _num_send_frames(xport_params.num_send_frames),
-        _recv_buffer_pool(buffer_pool::make(xport_params.num_recv_frames, xport_params.recv_frame_size)),
-        _send_buffer_pool(buffer_pool::make(xport_params.num_send_frames, xport_params.send_frame_size)),
-        _next_recv_buff_index(0), _next_send_buff_index(0)
+        _recv_buffer_pool(make_frame_pool(xport_params.num_recv_frames, xport_params.recv_frame_size, xport_params.numa_node)),
+        _send_buffer_pool(make_frame_pool(xport_params.num_send_frames, xport_params.send_frame_size, xport_params.numa_node)),
+        _next_recv_buff_index(0), _next_send_buff_index(0),
+        _recv_batch_size(std::min(xport_params.recv_batch_size, xport_params.num_recv_frames)),
+        _batch_count(0), _batch_offset(0),
+        _send_batch_size(std::min(xport_params.send_batch_size, xport_params.num_send_frames)),
+        _num_pending_sends(0),
+        _rx_timestamps(false),
+        _spin_wait_us((xport_params.spin_wait_us > 0)? size_t(xport_params.spin_wait_us) : 0)
     {
         UHD_LOGGER_TRACE("UDP")
             << boost::format("Creating UDP transport to %s:%s") % addr % port;
@@ -183,6 +275,64 @@ public:
         _socket->connect(receiver_endpoint);
         _sock_fd = _socket->native_handle();
 
+        //enable receive timestamping when requested; NIC hardware stamps
+        //require the interface to have them enabled (e.g. hwstamp_ctl),
+        //so also ask for kernel software stamps as a fallback
+        #ifdef UHD_PLATFORM_LINUX
+        if (xport_params.rx_timestamps){
+            const int flags =
+                SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE |
+                SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+            if (::setsockopt(_sock_fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) == 0){
+                _rx_timestamps = true;
+            } else {
+                UHD_LOGGER_WARNING("UDP") << boost::format(
+                    "Could not enable receive timestamping: %s") % strerror(errno);
+            }
+        }
+        #else
+        if (xport_params.rx_timestamps){
+            UHD_LOGGER_WARNING("UDP") << "Receive timestamping is not supported on this platform";
+        }
+        #endif /*UHD_PLATFORM_LINUX*/
+
+        //apply the socket QoS/tuning policy from the transport params
+        if (xport_params.dscp >= 0){
+            #ifdef IP_TOS
+            const int tos = xport_params.dscp << 2; //DSCP is the upper 6 bits
+            if (::setsockopt(_sock_fd, IPPROTO_IP, IP_TOS, (const char *)&tos, sizeof(tos)) != 0){
+                UHD_LOGGER_WARNING("UDP") << boost::format(
+                    "Could not set DSCP %d on socket: %s")
+                    % xport_params.dscp % strerror(errno);
+            }
+            #else
+            UHD_LOGGER_WARNING("UDP") << "DSCP marking is not supported on this platform";
+            #endif
+        }
+        if (xport_params.busy_poll_us > 0){
+            #ifdef SO_BUSY_POLL
+            const int busy_poll = xport_params.busy_poll_us;
+            if (::setsockopt(_sock_fd, SOL_SOCKET, SO_BUSY_POLL, (const char *)&busy_poll, sizeof(busy_poll)) != 0){
+                UHD_LOGGER_WARNING("UDP") << boost::format(
+                    "Could not enable socket busy polling: %s") % strerror(errno);
+            }
+            #else
+            UHD_LOGGER_WARNING("UDP") << "SO_BUSY_POLL is not supported on this platform";
+            #endif
+        }
+        if (xport_params.so_priority >= 0){
+            #ifdef SO_PRIORITY
+            const int so_priority = xport_params.so_priority;
+            if (::setsockopt(_sock_fd, SOL_SOCKET, SO_PRIORITY, (const char *)&so_priority, sizeof(so_priority)) != 0){
+                UHD_LOGGER_WARNING("UDP") << boost::format(
+                    "Could not set socket priority %d: %s")
+                    % so_priority % strerror(errno);
+            }
+            #else
+            UHD_LOGGER_WARNING("UDP") << "SO_PRIORITY is not supported on this platform";
+            #endif
+        }
+
         UHD_LOGGER_TRACE("UDP")
             << boost::format("Local UDP socket endpoint: %s:%s")
             % get_local_addr() % get_local_port();
@@ -190,14 +340,44 @@ public:
         //allocate re-usable managed receive buffers
         for (size_t i = 0; i < get_num_recv_frames(); i++){
             _mrb_pool.push_back(boost::make_shared<udp_zero_copy_asio_mrb>(
-                _recv_buffer_pool->at(i), _sock_fd, get_recv_frame_size()
+                _recv_buffer_pool->at(i), _sock_fd, get_recv_frame_size(),
+                _rx_timestamps, _spin_wait_us
             ));
         }
 
+        #ifdef UHD_PLATFORM_LINUX
+        //pre-allocate the scatter lists for the batched receive path
+        if (_recv_batch_size > 1){
+            UHD_LOGGER_TRACE("UDP")
+                << boost::format("Batched receive enabled: up to %d datagrams per syscall")
+                % _recv_batch_size;
+            _msgvec.resize(_recv_batch_size);
+            _iovec.resize(_recv_batch_size);
+            std::memset(&_msgvec.front(), 0, _msgvec.size()*sizeof(mmsghdr));
+            if (_rx_timestamps){
+                _cmsg_mem.resize(_recv_batch_size * CMSG_SPACE(sizeof(scm_timestamping)));
+            }
+        }
+        #endif /*UHD_PLATFORM_LINUX*/
+
+        #ifdef UHD_PLATFORM_LINUX
+        //pre-allocate the gather lists for the batched send path
+        if (_send_batch_size > 1){
+            UHD_LOGGER_TRACE("UDP")
+                << boost::format("Batched send enabled: up to %d datagrams per syscall")
+                % _send_batch_size;
+            _send_msgvec.resize(_send_batch_size);
+            _send_iovec.resize(_send_batch_size);
+            _pending_msbs.resize(_send_batch_size, NULL);
+            std::memset(&_send_msgvec.front(), 0, _send_msgvec.size()*sizeof(mmsghdr));
+        }
+        #endif /*UHD_PLATFORM_LINUX*/
+
         //allocate re-usable managed send buffers
         for (size_t i = 0; i < get_num_send_frames(); i++){
             _msb_pool.push_back(boost::make_shared<udp_zero_copy_asio_msb>(
-                _send_buffer_pool->at(i), _sock_fd, get_send_frame_size()
+                _send_buffer_pool->at(i), _sock_fd, get_send_frame_size(),
+                (this->send_batching_enabled())? this : NULL
             ));
         }
     }
@@ -225,11 +405,90 @@ public:
      * Receive implementation:
      * Block on the managed buffer's get call and advance the index.
      ******************************************************************/
+    int get_recv_fd(void) const{
+        return _sock_fd;
+    }
+
     managed_recv_buffer::sptr get_recv_buff(double timeout){
         if (_next_recv_buff_index == _num_recv_frames) _next_recv_buff_index = 0;
+        #ifdef UHD_PLATFORM_LINUX
+        if (_recv_batch_size > 1) return get_recv_buff_batched(timeout);
+        #endif
         return _mrb_pool[_next_recv_buff_index]->get_new(timeout, _next_recv_buff_index);
     }
 
+    #ifdef UHD_PLATFORM_LINUX
+    /*******************************************************************
+     * Batched receive implementation:
+     * Pull up to recv_batch_size datagrams from the kernel with a
+     * single recvmmsg() and hand them out one at a time. This avoids
+     * re-entering the kernel per CHDR packet when draining a burst.
+     ******************************************************************/
+    managed_recv_buffer::sptr get_recv_buff_batched(const double timeout){
+        //hand out a buffer filled by a previous recvmmsg first
+        if (_batch_offset < _batch_count){
+            const size_t len = size_t(_msgvec[_batch_offset].msg_len);
+            if (_rx_timestamps){
+                _mrb_pool[_next_recv_buff_index]->set_recv_timestamp_ns(
+                    extract_rx_timestamp_ns(_msgvec[_batch_offset].msg_hdr));
+            }
+            _batch_offset++;
+            return _mrb_pool[_next_recv_buff_index]->get_filled(len, _next_recv_buff_index);
+        }
+
+        //claim a contiguous run of frames for the kernel to fill;
+        //the run may not wrap around the end of the buffer pool
+        const size_t max_batch = std::min(_recv_batch_size, _num_recv_frames - _next_recv_buff_index);
+        size_t num_claimed = 0;
+        for (size_t i = 0; i < max_batch; i++){
+            //only wait on the first frame; trailing frames are best-effort
+            if (not _mrb_pool[_next_recv_buff_index + i]->claim((i == 0)? timeout : 0.0)) break;
+            num_claimed++;
+        }
+        if (num_claimed == 0) return managed_recv_buffer::sptr(); //null for timeout
+
+        for (size_t i = 0; i < num_claimed; i++){
+            _iovec[i].iov_base = _mrb_pool[_next_recv_buff_index + i]->get_mem();
+            _iovec[i].iov_len = _recv_frame_size;
+            _msgvec[i].msg_hdr.msg_iov = &_iovec[i];
+            _msgvec[i].msg_hdr.msg_iovlen = 1;
+            if (_rx_timestamps){
+                //the kernel shrinks msg_controllen, so reset it every call
+                _msgvec[i].msg_hdr.msg_control =
+                    &_cmsg_mem[i * CMSG_SPACE(sizeof(scm_timestamping))];
+                _msgvec[i].msg_hdr.msg_controllen = CMSG_SPACE(sizeof(scm_timestamping));
+            }
+        }
+
+        int num_recvd = ::recvmmsg(_sock_fd, &_msgvec.front(), num_claimed, MSG_DONTWAIT, NULL);
+        if (num_recvd <= 0 and wait_for_recv_ready(_sock_fd, timeout, _spin_wait_us)){
+            num_recvd = ::recvmmsg(_sock_fd, &_msgvec.front(), num_claimed, MSG_DONTWAIT, NULL);
+        }
+        if (num_recvd < 0 and errno != EAGAIN and errno != EWOULDBLOCK){
+            for (size_t i = 0; i < num_claimed; i++){
+                _mrb_pool[_next_recv_buff_index + i]->unclaim();
+            }
+            throw uhd::io_error(str(boost::format("recvmmsg error on socket: %s") % strerror(errno)));
+        }
+
+        //undo the claims on frames the kernel did not fill
+        const size_t num_filled = (num_recvd > 0)? size_t(num_recvd) : 0;
+        for (size_t i = num_filled; i < num_claimed; i++){
+            _mrb_pool[_next_recv_buff_index + i]->unclaim();
+        }
+        if (num_filled == 0) return managed_recv_buffer::sptr(); //null for timeout
+
+        _batch_count = num_filled;
+        _batch_offset = 1;
+        if (_rx_timestamps){
+            _mrb_pool[_next_recv_buff_index]->set_recv_timestamp_ns(
+                extract_rx_timestamp_ns(_msgvec[0].msg_hdr));
+        }
+        return _mrb_pool[_next_recv_buff_index]->get_filled(
+            size_t(_msgvec[0].msg_len), _next_recv_buff_index);
+    }
+    #endif /*UHD_PLATFORM_LINUX*/
+
     size_t get_num_recv_frames(void) const {return _num_recv_frames;}
     size_t get_recv_frame_size(void) const {return _recv_frame_size;}
 
@@ -239,12 +498,71 @@ public:
      ******************************************************************/
     managed_send_buffer::sptr get_send_buff(double timeout){
         if (_next_send_buff_index == _num_send_frames) _next_send_buff_index = 0;
+        #ifdef UHD_PLATFORM_LINUX
+        //frames parked in a pending batch hold their claims, so a
+        //full pool must be flushed before this claim can succeed
+        if (_num_pending_sends > 0){
+            managed_send_buffer::sptr buff =
+                _msb_pool[_next_send_buff_index]->get_new(0.0, _next_send_buff_index);
+            if (buff) return buff;
+            this->flush_send_buffs();
+        }
+        #endif /*UHD_PLATFORM_LINUX*/
         return _msb_pool[_next_send_buff_index]->get_new(timeout, _next_send_buff_index);
     }
 
     size_t get_num_send_frames(void) const {return _num_send_frames;}
     size_t get_send_frame_size(void) const {return _send_frame_size;}
 
+    //! batching only helps where sendmmsg() is available
+    UHD_INLINE bool send_batching_enabled(void) const {
+        #ifdef UHD_PLATFORM_LINUX
+        return _send_batch_size > 1;
+        #else
+        return false;
+        #endif
+    }
+
+    #ifdef UHD_PLATFORM_LINUX
+    /*******************************************************************
+     * Batched send implementation:
+     * Committed frames are parked here and pushed to the kernel with
+     * a single sendmmsg() once the batch is full or a flush forces
+     * them out. Frames keep their claims until the batch went out.
+     ******************************************************************/
+    void enqueue_send(udp_zero_copy_asio_msb *msb, const size_t len){
+        _send_iovec[_num_pending_sends].iov_base = msb->get_mem();
+        _send_iovec[_num_pending_sends].iov_len = len;
+        _send_msgvec[_num_pending_sends].msg_hdr.msg_iov = &_send_iovec[_num_pending_sends];
+        _send_msgvec[_num_pending_sends].msg_hdr.msg_iovlen = 1;
+        _pending_msbs[_num_pending_sends] = msb;
+        _num_pending_sends++;
+        if (_num_pending_sends == _send_batch_size) this->flush_send_buffs();
+    }
+
+    void flush_send_buffs(void){
+        size_t num_sent = 0;
+        while (num_sent < _num_pending_sends){
+            const int ret = ::sendmmsg(
+                _sock_fd, &_send_msgvec[num_sent], _num_pending_sends - num_sent, 0);
+            if (ret < 0){
+                //Retry logic because send may fail with ENOBUFS,
+                //matching the behavior of the unbatched commit.
+                if (errno == ENOBUFS){
+                    std::this_thread::sleep_for(std::chrono::microseconds(1));
+                    continue;
+                }
+                throw uhd::io_error(str(boost::format("sendmmsg error on socket: %s") % strerror(errno)));
+            }
+            num_sent += size_t(ret);
+        }
+        for (size_t i = 0; i < _num_pending_sends; i++){
+            _pending_msbs[i]->unclaim();
+        }
+        _num_pending_sends = 0;
+    }
+    #endif /*UHD_PLATFORM_LINUX*/
+
     uint16_t get_local_port(void) const
     {
         return _socket->local_endpoint().port();
@@ -264,12 +582,67 @@ private:
     std::vector<boost::shared_ptr<udp_zero_copy_asio_mrb> > _mrb_pool;
     size_t _next_recv_buff_index, _next_send_buff_index;
 
+    //batched receive state (filled run of frames from one recvmmsg call)
+    const size_t _recv_batch_size;
+    size_t _batch_count, _batch_offset;
+    #ifdef UHD_PLATFORM_LINUX
+    std::vector<mmsghdr> _msgvec;
+    std::vector<iovec> _iovec;
+    std::vector<char> _cmsg_mem; //control space for batched timestamp capture
+    #endif
+
+    //batched send state (committed frames awaiting one sendmmsg call)
+    const size_t _send_batch_size;
+    size_t _num_pending_sends;
+    #ifdef UHD_PLATFORM_LINUX
+    std::vector<mmsghdr> _send_msgvec;
+    std::vector<iovec> _send_iovec;
+    std::vector<udp_zero_copy_asio_msb *> _pending_msbs;
+    #endif
+
+    //receive timestamp capture (may be downgraded to off in the ctor)
+    bool _rx_timestamps;
+
+    //busy-poll budget before blocking in the kernel
+    size_t _spin_wait_us;
+
     //asio guts -> socket and service
     asio::io_service        _io_service;
     socket_sptr             _socket;
     int                     _sock_fd;
 };
 
+void udp_zero_copy_asio_msb::release(void){
+    #ifdef UHD_PLATFORM_LINUX
+    //batched path: park the committed frame with the transport;
+    //the claim is released once the batch goes onto the wire
+    if (_batch_owner != NULL){
+        _batch_owner->enqueue_send(this, size());
+        return;
+    }
+    #endif /*UHD_PLATFORM_LINUX*/
+
+    //Retry logic because send may fail with ENOBUFS.
+    //This is known to occur at least on some OSX systems.
+    //But it should be safe to always check for the error.
+    while (true)
+    {
+        const ssize_t ret = ::send(_sock_fd, (const char *)_mem, size(), 0);
+        if (ret == ssize_t(size())) break;
+        if (ret == -1 and errno == ENOBUFS)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(1));
+            continue; //try to send again
+        }
+        if (ret == -1)
+        {
+            throw uhd::io_error(str(boost::format("send error on socket: %s") % strerror(errno)));
+        }
+        UHD_ASSERT_THROW(ret == ssize_t(size()));
+    }
+    _claimer.release();
+}
+
 /***********************************************************************
  * UDP zero copy make function
  **********************************************************************/
@@ -322,6 +695,19 @@ udp_zero_copy::sptr udp_zero_copy::make(
     xport_params.num_send_frames = size_t(hints.cast<double>("num_send_frames", default_buff_args.num_send_frames));
     xport_params.recv_buff_size = size_t(hints.cast<double>("recv_buff_size", default_buff_args.recv_buff_size));
     xport_params.send_buff_size = size_t(hints.cast<double>("send_buff_size", default_buff_args.send_buff_size));
+    xport_params.recv_batch_size = size_t(hints.cast<double>("recv_batch_size", default_buff_args.recv_batch_size));
+    xport_params.send_batch_size = size_t(hints.cast<double>("send_batch_size", default_buff_args.send_batch_size));
+    xport_params.numa_node = int(hints.cast<double>("numa_node", default_buff_args.numa_node));
+    xport_params.dscp = int(hints.cast<double>("dscp", default_buff_args.dscp));
+    xport_params.busy_poll_us = int(hints.cast<double>("busy_poll", default_buff_args.busy_poll_us));
+    xport_params.so_priority = int(hints.cast<double>("so_priority", default_buff_args.so_priority));
+    xport_params.spin_wait_us = int(hints.cast<double>("spin_wait", default_buff_args.spin_wait_us));
+    xport_params.rx_timestamps =
+        hints.has_key("rx_timestamps") or default_buff_args.rx_timestamps;
+
+    if (xport_params.dscp > 63) {
+        throw uhd::value_error("dscp must be a codepoint in the range 0-63");
+    }
 
     if (xport_params.num_recv_frames == 0) {
         UHD_LOG_TRACE("UDP", "Default value for num_recv_frames: "
@@ -347,6 +733,24 @@ udp_zero_copy::sptr udp_zero_copy::make(
         );
         xport_params.send_frame_size = UDP_ZERO_COPY_DEFAULT_FRAME_SIZE;
     }
+    if (xport_params.recv_batch_size == 0) {
+        xport_params.recv_batch_size = UDP_ZERO_COPY_DEFAULT_RECV_BATCH_SIZE;
+    }
+    if (xport_params.recv_batch_size > UDP_ZERO_COPY_MAX_RECV_BATCH_SIZE) {
+        UHD_LOG_WARNING("UDP", "Clipping recv_batch_size to "
+            << UDP_ZERO_COPY_MAX_RECV_BATCH_SIZE
+        );
+        xport_params.recv_batch_size = UDP_ZERO_COPY_MAX_RECV_BATCH_SIZE;
+    }
+    if (xport_params.send_batch_size == 0) {
+        xport_params.send_batch_size = UDP_ZERO_COPY_DEFAULT_SEND_BATCH_SIZE;
+    }
+    if (xport_params.send_batch_size > UDP_ZERO_COPY_MAX_SEND_BATCH_SIZE) {
+        UHD_LOG_WARNING("UDP", "Clipping send_batch_size to "
+            << UDP_ZERO_COPY_MAX_SEND_BATCH_SIZE
+        );
+        xport_params.send_batch_size = UDP_ZERO_COPY_MAX_SEND_BATCH_SIZE;
+    }
 
     if (xport_params.recv_buff_size == 0) {
         UHD_LOG_TRACE("UDP", "Using default value for recv_buff_size");
@@ -378,6 +782,31 @@ udp_zero_copy::sptr udp_zero_copy::make(
         }
     #endif
 
+    #ifdef HAVE_LIBURING
+    //select the io_uring backend via the use_io_uring transport arg
+    if (hints.has_key("use_io_uring")){
+        buff_params_out.recv_buff_size = xport_params.recv_buff_size;
+        buff_params_out.send_buff_size = xport_params.send_buff_size;
+        return udp_uring_zero_copy::make(addr, port, xport_params);
+    }
+    #endif /*HAVE_LIBURING*/
+
+    #ifdef HAVE_XDP
+    //select the AF_XDP backend via the use_xdp transport arg
+    if (hints.has_key("use_xdp")){
+        if (not hints.has_key("xdp_iface")){
+            throw uhd::value_error("use_xdp requires the xdp_iface transport arg");
+        }
+        buff_params_out.recv_buff_size = xport_params.recv_buff_size;
+        buff_params_out.send_buff_size = xport_params.send_buff_size;
+        return udp_xdp_zero_copy::make(
+            addr, port,
+            hints["xdp_iface"],
+            hints.cast<size_t>("xdp_queue", 0),
+            xport_params);
+    }
+    #endif /*HAVE_XDP*/
+
     udp_zero_copy_asio_impl::sptr udp_trans(
         new udp_zero_copy_asio_impl(addr, port, xport_params)
     );
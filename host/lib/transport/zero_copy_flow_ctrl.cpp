@@ -10,6 +10,7 @@
 #include <uhd/transport/buffer_pool.hpp>
 #include <uhd/utils/log.hpp>
 #include <uhd/utils/safe_call.hpp>
+#include <uhdlib/utils/tracepoints.hpp>
 #include <boost/format.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/thread/mutex.hpp>
@@ -43,7 +44,9 @@ public:
         if (_mb)
         {
             _mb->commit(size());
+            UHD_TRACEPOINT1(fc_send_wait_begin, size());
             while (_flow_ctrl and not _flow_ctrl(_mb)) {}
+            UHD_TRACEPOINT1(fc_send_wait_end, size());
             _mb.reset();
         }
     }
@@ -87,7 +90,9 @@ public:
     UHD_INLINE sptr get(sptr &mb)
     {
         _mb = mb;
+        UHD_TRACEPOINT1(fc_recv_wait_begin, _mb->size());
         while (_flow_ctrl and not _flow_ctrl(_mb)) {}
+        UHD_TRACEPOINT1(fc_recv_wait_end, _mb->size());
         return make(this, _mb->cast<void *>(), _mb->size());
     }
 
@@ -186,6 +191,11 @@ public:
         return _transport->get_send_frame_size();
     }
 
+    void flush_send_buffs()
+    {
+        _transport->flush_send_buffs();
+    }
+
 private:
     // The underlying transport
     zero_copy_if::sptr _transport;
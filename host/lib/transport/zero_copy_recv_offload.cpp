@@ -6,12 +6,13 @@
 //
 
 #include <uhd/transport/zero_copy_recv_offload.hpp>
-#include <uhd/transport/bounded_buffer.hpp>
+#include <uhd/transport/spsc_bounded_buffer.hpp>
 #include <uhd/transport/buffer_pool.hpp>
 
 #include <uhd/utils/log.hpp>
 #include <uhd/utils/safe_call.hpp>
 #include <uhd/utils/thread.hpp>
+#include <uhdlib/utils/thread_policy.hpp>
 #include <boost/format.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/thread/mutex.hpp>
@@ -21,7 +22,9 @@
 using namespace uhd;
 using namespace uhd::transport;
 
-typedef bounded_buffer<managed_recv_buffer::sptr> bounded_buffer_t;
+//the offload thread is the only producer and the caller's streamer
+//thread the only consumer, so the lock-free SPSC ring applies here
+typedef spsc_bounded_buffer<managed_recv_buffer::sptr> bounded_buffer_t;
 
 /***********************************************************************
  * Zero copy offload transport:
@@ -33,8 +36,10 @@ public:
     typedef boost::shared_ptr<zero_copy_recv_offload_impl> sptr;
 
     zero_copy_recv_offload_impl(zero_copy_if::sptr transport,
-                          const double timeout) :
+                          const double timeout,
+                          const std::vector<size_t> &cpu_affinity) :
         _transport(transport), _timeout(timeout),
+        _cpu_affinity(cpu_affinity),
         _inbox(transport->get_num_recv_frames()),
         _recv_done(false)
     {
@@ -76,6 +81,9 @@ public:
     // pulling pointers to managed receiver buffers quickly
     void enqueue_recv()
     {
+        //transport-specific affinity hints win over the role policy
+        uhd::thread_policy::apply("recv_offload");
+        uhd::set_thread_affinity(_cpu_affinity);
         while (not is_recv_done()) {
             managed_recv_buffer::sptr buff = _transport->get_recv_buff(_timeout);
             if (not buff) continue;
@@ -123,11 +131,17 @@ public:
         return _transport->get_send_frame_size();
     }
 
+    void flush_send_buffs()
+    {
+        _transport->flush_send_buffs();
+    }
+
 private:
     // The linked transport
     zero_copy_if::sptr _transport;
 
     const double _timeout;
+    const std::vector<size_t> _cpu_affinity;
 
     // Shared buffers
     bounded_buffer_t _inbox;
@@ -140,10 +154,11 @@ private:
 
 zero_copy_recv_offload::sptr zero_copy_recv_offload::make(
         zero_copy_if::sptr transport,
-        const double timeout)
+        const double timeout,
+        const std::vector<size_t> &cpu_affinity)
 {
     zero_copy_recv_offload_impl::sptr zero_copy_recv_offload(
-        new zero_copy_recv_offload_impl(transport, timeout)
+        new zero_copy_recv_offload_impl(transport, timeout, cpu_affinity)
     );
 
     return zero_copy_recv_offload;
@@ -0,0 +1,119 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/types/sample_timekeeper.hpp>
+#include <cmath>
+
+using namespace uhd;
+
+//! portable 64x64 -> 128 bit unsigned multiply via 32-bit halves
+static UHD_INLINE void mul_u64(
+    const uint64_t a, const uint64_t b, uint64_t &hi, uint64_t &lo
+){
+    const uint64_t a_lo = a & 0xFFFFFFFFull, a_hi = a >> 32;
+    const uint64_t b_lo = b & 0xFFFFFFFFull, b_hi = b >> 32;
+    const uint64_t p0 = a_lo*b_lo;
+    const uint64_t p1 = a_lo*b_hi;
+    const uint64_t p2 = a_hi*b_lo;
+    const uint64_t p3 = a_hi*b_hi;
+    const uint64_t mid = (p0 >> 32) + (p1 & 0xFFFFFFFFull) + (p2 & 0xFFFFFFFFull);
+    lo = (p0 & 0xFFFFFFFFull) | (mid << 32);
+    hi = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+}
+
+sample_timekeeper::sample_timekeeper(void):
+    _tick_rate(1.0),
+    _samp_rate(1.0),
+    _step_whole(1),
+    _step_frac(0),
+    _base_whole(0),
+    _base_frac(0),
+    _pending_samps(0),
+    _anchored(false)
+{
+    /* NOP */
+}
+
+void sample_timekeeper::set_tick_rate(const double tick_rate)
+{
+    _tick_rate = tick_rate;
+    this->recalc_step();
+}
+
+void sample_timekeeper::set_samp_rate(const double samp_rate)
+{
+    _samp_rate = samp_rate;
+    this->recalc_step();
+}
+
+void sample_timekeeper::recalc_step(void)
+{
+    //the only floating point division; the long double intermediate
+    //keeps the fractional part good to well below a tick per buffer
+    const long double step = (long double)(_tick_rate)/(long double)(_samp_rate);
+    const long double whole = std::floor(step);
+    _step_whole = uint64_t(whole);
+    _step_frac = uint64_t((step - whole)*18446744073709551616.0L); //2^64
+}
+
+void sample_timekeeper::update(const rx_metadata_t &metadata, const size_t nsamps)
+{
+    if (metadata.has_time_spec)
+    {
+        //re-anchor on the buffer's own time: one double-based
+        //translation, after which the math is all integer
+        const long double ticks = 0.0L
+            + (long double)(metadata.time_spec.get_full_secs())*(long double)(_tick_rate)
+            + (long double)(metadata.time_spec.get_frac_secs())*(long double)(_tick_rate);
+        const long double whole = std::floor(ticks);
+        _base_whole = uint64_t(whole);
+        _base_frac = uint64_t((ticks - whole)*18446744073709551616.0L); //2^64
+        _anchored = true;
+    }
+    else if (_anchored)
+    {
+        //free-run: advance by the previous buffer's sample count
+        this->advance(_base_whole, _base_frac, uint64_t(_pending_samps));
+    }
+    _pending_samps = nsamps;
+}
+
+bool sample_timekeeper::is_anchored(void) const
+{
+    return _anchored;
+}
+
+void sample_timekeeper::advance(
+    uint64_t &whole, uint64_t &frac, const uint64_t nsamps
+) const
+{
+    uint64_t hi = 0, lo = 0;
+    mul_u64(_step_frac, nsamps, hi, lo);
+    const uint64_t new_frac = frac + lo;
+    if (new_frac < frac) hi++; //carry out of the fractional word
+    whole += _step_whole*nsamps + hi;
+    frac = new_frac;
+}
+
+uint64_t sample_timekeeper::get_ticks(const size_t sample_offset) const
+{
+    uint64_t whole = _base_whole, frac = _base_frac;
+    this->advance(whole, frac, uint64_t(sample_offset));
+    return whole + (frac >> 63); //round to nearest tick
+}
+
+uint64_t sample_timekeeper::get_tick_frac(const size_t sample_offset) const
+{
+    uint64_t whole = _base_whole, frac = _base_frac;
+    this->advance(whole, frac, uint64_t(sample_offset));
+    return frac;
+}
+
+time_spec_t sample_timekeeper::get_time_spec(const size_t sample_offset) const
+{
+    return time_spec_t::from_ticks(
+        (long long)(this->get_ticks(sample_offset)), _tick_rate);
+}
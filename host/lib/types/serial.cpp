@@ -7,11 +7,60 @@
 
 #include <uhd/types/serial.hpp>
 #include <uhdlib/utils/narrow.hpp>
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
 using namespace uhd;
 
+/***********************************************************************
+ * EEPROM page writes
+ *
+ * I2C EEPROMs buffer one page internally, so a page can go out in a
+ * single transaction followed by one internal write cycle - writing a
+ * full image byte-by-byte pays that write cycle per byte instead.
+ * A page write must never cross a page boundary: the address counter
+ * wraps within the page and would corrupt its beginning.
+ *
+ * 8 bytes is the page size of the 24LC02-class parts used for
+ * daughterboard EEPROMs and a safe lower bound for everything larger;
+ * the 16-bit addressable parts (24LC32 and up) all buffer at least 32.
+ **********************************************************************/
+static const size_t EEPROM_PAGE_SIZE = 8;
+static const size_t EEPROM16_PAGE_SIZE = 32;
+static const size_t EEPROM_WRITE_CYCLE_MS = 10; //worst case write
+
+/*!
+ * Wait out the EEPROM's internal write cycle after a page write.
+ *
+ * The device does not acknowledge until the cycle completes, so poll it
+ * with read-backs of the page just written: the poll returns as soon as
+ * the device is ready again (typically well under the worst case figure)
+ * and verifies the page as a side effect. If the device never reads back
+ * the written data within the worst case window, fall through quietly -
+ * same guarantees as the fixed wait this replaces.
+ */
+static void wait_for_write_cycle(
+    i2c_iface *iface,
+    const uint16_t addr,
+    const uint16_t offset,
+    const byte_vector_t::const_iterator begin,
+    const byte_vector_t::const_iterator end
+){
+    const auto deadline = std::chrono::steady_clock::now()
+        + std::chrono::milliseconds(EEPROM_WRITE_CYCLE_MS);
+    do {
+        try {
+            const byte_vector_t readback =
+                iface->read_eeprom(addr, offset, end - begin);
+            if (std::equal(begin, end, readback.begin())) return;
+        } catch(...) {
+            //device not acknowledging yet - write cycle still running
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    } while (std::chrono::steady_clock::now() < deadline);
+}
+
 i2c_iface::~i2c_iface(void)
 {
     //empty
@@ -40,14 +89,20 @@ void i2c_iface::write_eeprom(
     uint16_t offset,
     const byte_vector_t &bytes
 ){
-    for (size_t i = 0; i < bytes.size(); i++){
-        //write a byte at a time, its easy that way
-        byte_vector_t cmd = {
-            narrow_cast<uint8_t>(offset+i),
-            narrow_cast<uint8_t>(bytes[i])
-        };
+    size_t i = 0;
+    while (i < bytes.size()){
+        const uint16_t offset_i = offset + i;
+        //write up to a page per transaction, but never across a page boundary
+        const size_t num = std::min(
+            EEPROM_PAGE_SIZE - (offset_i % EEPROM_PAGE_SIZE), bytes.size() - i);
+        byte_vector_t cmd;
+        cmd.reserve(num + 1);
+        cmd.push_back(narrow_cast<uint8_t>(offset_i));
+        cmd.insert(cmd.end(), bytes.begin()+i, bytes.begin()+i+num);
         this->write_i2c(addr, cmd);
-        std::this_thread::sleep_for(std::chrono::milliseconds(10)); //worst case write
+        wait_for_write_cycle(
+            this, addr, offset_i, bytes.begin()+i, bytes.begin()+i+num);
+        i += num;
     }
 }
 
@@ -105,17 +160,22 @@ struct eeprom16_impl : i2c_iface
         uint16_t offset,
         const byte_vector_t &bytes
     ){
-        for (size_t i = 0; i < bytes.size(); i++)
+        size_t i = 0;
+        while (i < bytes.size())
         {
-            //write a byte at a time, its easy that way
-            uint16_t offset_i = offset+i;
-            byte_vector_t cmd{
-                narrow_cast<uint8_t>(offset_i >> 8),
-                narrow_cast<uint8_t>(offset_i & 0xff),
-                bytes[i]
-            };
+            const uint16_t offset_i = offset + i;
+            //write up to a page per transaction, but never across a page boundary
+            const size_t num = std::min(
+                EEPROM16_PAGE_SIZE - (offset_i % EEPROM16_PAGE_SIZE), bytes.size() - i);
+            byte_vector_t cmd;
+            cmd.reserve(num + 2);
+            cmd.push_back(narrow_cast<uint8_t>(offset_i >> 8));
+            cmd.push_back(narrow_cast<uint8_t>(offset_i & 0xff));
+            cmd.insert(cmd.end(), bytes.begin()+i, bytes.begin()+i+num);
             this->write_i2c(addr, cmd);
-            std::this_thread::sleep_for(std::chrono::milliseconds(10)); //worst case write
+            wait_for_write_cycle(
+                this, addr, offset_i, bytes.begin()+i, bytes.begin()+i+num);
+            i += num;
         }
     }
 };
@@ -7,6 +7,11 @@
 
 #include <uhd/types/wb_iface.hpp>
 #include <uhd/exception.hpp>
+#include <uhd/utils/safe_call.hpp>
+#include <boost/make_shared.hpp>
+#include <chrono>
+#include <map>
+#include <mutex>
 
 using namespace uhd;
 
@@ -44,3 +49,217 @@ uint16_t wb_iface::peek16(const wb_iface::wb_addr_type)
 {
     throw uhd::not_implemented_error("peek16 not implemented");
 }
+
+void wb_iface::poke32_range(const wb_iface::wb_addr_type addr, const std::vector<uint32_t> &data)
+{
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        this->poke32(addr + 4*i, data[i]);
+    }
+}
+
+std::vector<uint32_t> wb_iface::peek32_range(const wb_iface::wb_addr_type addr, const size_t num_regs)
+{
+    std::vector<uint32_t> data(num_regs);
+    for (size_t i = 0; i < num_regs; i++)
+    {
+        data[i] = this->peek32(addr + 4*i);
+    }
+    return data;
+}
+
+/***********************************************************************
+ * Cached readback interface
+ **********************************************************************/
+class cached_wb_iface_impl : public cached_wb_iface
+{
+public:
+    typedef std::chrono::steady_clock clock_type;
+
+    cached_wb_iface_impl(wb_iface::sptr iface):
+        _iface(iface)
+    {
+        //NOP
+    }
+
+    void set_cache_ttl(const wb_addr_type addr, const double ttl)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        entry_type &entry = _cache[addr];
+        entry.ttl = std::chrono::microseconds(long(ttl*1e6));
+        entry.valid = false;
+    }
+
+    void invalidate(const wb_addr_type addr)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::map<wb_addr_type, entry_type>::iterator it = _cache.find(addr);
+        if (it != _cache.end()) it->second.valid = false;
+    }
+
+    void invalidate_all(void)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        this->invalidate_all_locked();
+    }
+
+    uint32_t peek32(const wb_addr_type addr)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            std::map<wb_addr_type, entry_type>::iterator it = _cache.find(addr);
+            if (it != _cache.end() and it->second.valid
+                and clock_type::now() < it->second.expiry) {
+                return it->second.value;
+            }
+        }
+        const uint32_t value = _iface->peek32(addr);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            std::map<wb_addr_type, entry_type>::iterator it = _cache.find(addr);
+            if (it != _cache.end()) {
+                it->second.value = value;
+                it->second.expiry = clock_type::now() + it->second.ttl;
+                it->second.valid = true;
+            }
+        }
+        return value;
+    }
+
+    //writes pass through and drop the cache: they may change any
+    //status the device reports
+    void poke32(const wb_addr_type addr, const uint32_t data)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            this->invalidate_all_locked();
+        }
+        _iface->poke32(addr, data);
+    }
+
+    void poke64(const wb_addr_type addr, const uint64_t data)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            this->invalidate_all_locked();
+        }
+        _iface->poke64(addr, data);
+    }
+
+    uint64_t peek64(const wb_addr_type addr)
+    {
+        return _iface->peek64(addr);
+    }
+
+    void poke16(const wb_addr_type addr, const uint16_t data)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            this->invalidate_all_locked();
+        }
+        _iface->poke16(addr, data);
+    }
+
+    uint16_t peek16(const wb_addr_type addr)
+    {
+        return _iface->peek16(addr);
+    }
+
+private:
+    struct entry_type
+    {
+        entry_type(void): value(0), valid(false) {}
+        uint32_t value;
+        bool valid;
+        std::chrono::microseconds ttl;
+        clock_type::time_point expiry;
+    };
+
+    void invalidate_all_locked(void)
+    {
+        for (std::map<wb_addr_type, entry_type>::iterator it = _cache.begin();
+             it != _cache.end(); ++it) {
+            it->second.valid = false;
+        }
+    }
+
+    wb_iface::sptr _iface;
+    std::map<wb_addr_type, entry_type> _cache;
+    std::mutex _mutex;
+};
+
+cached_wb_iface::sptr cached_wb_iface::make(wb_iface::sptr iface)
+{
+    return boost::make_shared<cached_wb_iface_impl>(iface);
+}
+
+wb_write_batch::wb_write_batch(wb_iface::sptr iface):
+    _iface(iface)
+{
+    //NOP
+}
+
+wb_write_batch::~wb_write_batch(void)
+{
+    UHD_SAFE_CALL
+    (
+        this->commit();
+    )
+}
+
+void wb_write_batch::poke32(const wb_iface::wb_addr_type addr, const uint32_t data)
+{
+    _writes.push_back(std::make_pair(addr, data));
+}
+
+void wb_write_batch::commit(void)
+{
+    for (size_t i = 0; i < _writes.size(); i++)
+    {
+        _iface->poke32(_writes[i].first, _writes[i].second);
+    }
+    _writes.clear();
+}
+
+/***********************************************************************
+ * Register state snapshot
+ **********************************************************************/
+wb_snapshot::wb_snapshot(void)
+{
+    //NOP
+}
+
+void wb_snapshot::declare_range(const wb_iface::wb_addr_type addr, const size_t num_regs)
+{
+    range_type range;
+    range.addr = addr;
+    range.num_regs = num_regs;
+    _ranges.push_back(range);
+    //a new range invalidates any previous capture
+    _values.clear();
+}
+
+void wb_snapshot::capture(wb_iface::sptr iface)
+{
+    std::vector<std::vector<uint32_t> > values;
+    for (size_t i = 0; i < _ranges.size(); i++)
+    {
+        values.push_back(iface->peek32_range(_ranges[i].addr, _ranges[i].num_regs));
+    }
+    _values.swap(values);
+}
+
+void wb_snapshot::restore(wb_iface::sptr iface) const
+{
+    if (not this->valid()) throw uhd::runtime_error(
+        "wb_snapshot::restore() called without a capture");
+    for (size_t i = 0; i < _ranges.size(); i++)
+    {
+        iface->poke32_range(_ranges[i].addr, _values[i]);
+    }
+}
+
+bool wb_snapshot::valid(void) const
+{
+    return not _ranges.empty() and _values.size() == _ranges.size();
+}
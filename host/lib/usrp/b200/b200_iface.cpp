@@ -71,6 +71,10 @@ const static int VREQ_MAX_SIZE_USB3 = 512;
 const static int VREQ_DEFAULT_SIZE  = VREQ_MAX_SIZE_USB2;
 const static int VREQ_MAX_SIZE      = VREQ_MAX_SIZE_USB3;
 
+//! Coalescing buffer size for firmware loading. The FX3 boot ROM accepts
+// vendor writes of up to 4 KiB; stay at half of that to be safe.
+const static size_t FX3_FW_LOAD_MAX_XFER = 2048;
+
 typedef uint32_t hash_type;
 
 
@@ -208,13 +212,60 @@ public:
         }
 
         ihex_reader file_reader(filestring);
+
+        /* The hex file stores the firmware in small (typically 16-byte)
+         * records, and pushing each one as its own control transfer makes
+         * the USB protocol overhead dominate the load time. Coalesce
+         * contiguous records into larger vendor writes and only flush on an
+         * address discontinuity, a full buffer, or the final jump record. */
+        unsigned char fw_buff[FX3_FW_LOAD_MAX_XFER];
+        uint16_t buff_len = 0;
+        uint16_t buff_lower = 0, buff_upper = 0;
+        auto flush_fw_buff = [&](void) -> int {
+            if (buff_len == 0) return 0;
+            const int ret = fx3_control_write(
+                FX3_FIRMWARE_LOAD, buff_lower, buff_upper, fw_buff, buff_len, 0);
+            if (ret < 0) return ret;
+            if (ret != int(buff_len)) return -1;
+            buff_len = 0;
+            return 0;
+        };
+        auto record_handler = [&](
+            uint16_t lower_address_bits, uint16_t upper_address_bits,
+            unsigned char *buff, uint16_t len
+        ) -> int {
+            if (buff == NULL and len == 0) {
+                //the jump record: flush pending data before starting the CPU
+                const int ret = flush_fw_buff();
+                if (ret < 0) return ret;
+                return fx3_control_write(
+                    FX3_FIRMWARE_LOAD,
+                    lower_address_bits, upper_address_bits, NULL, 0, 0);
+            }
+            const uint32_t this_addr =
+                (uint32_t(upper_address_bits) << 16) | lower_address_bits;
+            const uint32_t next_addr =
+                ((uint32_t(buff_upper) << 16) | buff_lower) + buff_len;
+            if (buff_len > 0 and
+                (this_addr != next_addr or buff_len + len > sizeof(fw_buff))
+            ){
+                const int ret = flush_fw_buff();
+                if (ret < 0) return ret;
+            }
+            if (buff_len == 0) {
+                buff_lower = lower_address_bits;
+                buff_upper = upper_address_bits;
+            }
+            std::memcpy(fw_buff + buff_len, buff, len);
+            buff_len += len;
+            return int(len);
+        };
+
         try {
-            file_reader.read(
-                boost::bind(
-                    &b200_iface_impl::fx3_control_write, this,
-                    FX3_FIRMWARE_LOAD, _1, _2, _3, _4, 0
-                )
-            );
+            file_reader.read(record_handler);
+            if (flush_fw_buff() < 0) {
+                throw uhd::io_error("load_firmware: flush of final records failed");
+            }
         } catch (const uhd::io_error &e) {
             throw uhd::io_error(str(boost::format("Could not load firmware: \n%s") % e.what()));
         }
@@ -400,18 +451,22 @@ public:
             throw uhd::io_error((boost::format("load_fpga: short read on firmware loopback request (expecting: %d, returned: %d)") % ntoread % nread).str());
         transfer_size = std::min(transfer_size, nread); // Select the smaller value
 
-        size_t file_size = 0;
+        /* Read the whole bitstream up front; one sequential read is faster
+         * than interleaving small file reads with the USB writes. */
+        std::vector<unsigned char> bitstream;
         {
             std::ifstream file(filename, std::ios::in | std::ios::binary | std::ios::ate);
-            file_size = size_t(file.tellg());
-        }
-
-        std::ifstream file;
-        file.open(filename, std::ios::in | std::ios::binary);
-
-        if (!file.good()) {
-            throw uhd::io_error("load_fpga: cannot open FPGA input file.");
+            if (!file.good()) {
+                throw uhd::io_error("load_fpga: cannot open FPGA input file.");
+            }
+            bitstream.resize(size_t(file.tellg()));
+            file.seekg(0, std::ios::beg);
+            file.read((char *) bitstream.data(), bitstream.size());
+            if (!file.good()) {
+                throw uhd::io_error("load_fpga: cannot read FPGA input file.");
+            }
         }
+        const size_t file_size = bitstream.size();
 
         // Zero the hash, in case we abort programming another image and revert to the previously programmed image
         usrp_set_fpga_hash(0);
@@ -424,15 +479,18 @@ public:
         else if (ret != bytes_to_xfer)
             throw uhd::io_error((boost::format("Short write on start FPGA config (expecting: %d, returned: %d)") % bytes_to_xfer % ret).str());
 
+        /* Poll at a fine granularity: the state transitions only take a few
+         * ms, and a coarse poll interval adds a constant chunk to every
+         * load. The total timeouts are unchanged. */
         wait_count = 0;
         do {
             fx3_state = get_fx3_status();
 
-            if((wait_count >= 500) || (fx3_state == FX3_STATE_ERROR) || (fx3_state == FX3_STATE_UNDEFINED)) {
+            if((wait_count >= 5000) || (fx3_state == FX3_STATE_ERROR) || (fx3_state == FX3_STATE_UNDEFINED)) {
                 return fx3_state;
             }
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
 
             wait_count++;
         } while(fx3_state != FX3_STATE_FPGA_READY);
@@ -453,26 +511,22 @@ public:
         do {
             fx3_state = get_fx3_status();
 
-            if((wait_count >= 1000) || (fx3_state == FX3_STATE_ERROR) || (fx3_state == FX3_STATE_UNDEFINED)) {
+            if((wait_count >= 10000) || (fx3_state == FX3_STATE_ERROR) || (fx3_state == FX3_STATE_UNDEFINED)) {
                 return fx3_state;
             }
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
 
             wait_count++;
         } while(fx3_state != FX3_STATE_CONFIGURING_FPGA);
 
         size_t bytes_sent = 0;
-        while (!file.eof()) {
-            file.read((char *) out_buff, transfer_size);
-            const std::streamsize n = file.gcount();
-            if(n == 0)
-                continue;
-
-            uint16_t transfer_count = uint16_t(n);
+        while (bytes_sent < file_size) {
+            const uint16_t transfer_count = uint16_t(
+                std::min<size_t>(transfer_size, file_size - bytes_sent));
 
             /* Send the data to the device. */
-            int nwritten = fx3_control_write(B200_VREQ_FPGA_DATA, 0, 0, out_buff, transfer_count, 5000);
+            int nwritten = fx3_control_write(B200_VREQ_FPGA_DATA, 0, 0, &bitstream[bytes_sent], transfer_count, 5000);
             if (nwritten < 0)
                 throw uhd::io_error((boost::format("load_fpga: cannot write bitstream to FX3 (%d: %s)") % nwritten % libusb_error_name(nwritten)).str());
             else if (nwritten != transfer_count)
@@ -494,19 +548,21 @@ public:
                     UHD_LOGGER_DEBUG("B200") << std::setw(3) << percent_after << "%";
                 }
             }
+            else
+            {
+                bytes_sent += transfer_count;
+            }
         }
 
-        file.close();
-
         wait_count = 0;
         do {
             fx3_state = get_fx3_status();
 
-            if((wait_count >= 500) || (fx3_state == FX3_STATE_ERROR) || (fx3_state == FX3_STATE_UNDEFINED)) {
+            if((wait_count >= 5000) || (fx3_state == FX3_STATE_ERROR) || (fx3_state == FX3_STATE_UNDEFINED)) {
                 return fx3_state;
             }
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
 
             wait_count++;
         } while(fx3_state != FX3_STATE_RUNNING);
@@ -85,6 +85,10 @@ public:
     ad9361_ctrl_impl(ad9361_params::sptr client_settings, ad9361_io::sptr io_iface):
         _device(client_settings, io_iface)
     {
+        //Every user of this interface configures a clock rate right
+        //after construction, which re-runs all of the calibration
+        //algorithms at the actual rate. Skip the redundant pass here.
+        _device.skip_initialization_calibration();
         _device.initialize();
     }
     double set_gain(const std::string &which, const double value)
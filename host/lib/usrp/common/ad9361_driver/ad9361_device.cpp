@@ -1714,21 +1714,28 @@ void ad9361_device_t::initialize()
 
     _setup_adc();
 
-    _calibrate_baseband_dc_offset();
-    _calibrate_rf_dc_offset();
-    _calibrate_rx_quadrature();
-
-    /*
-     * Rx BB DC and IQ tracking are both disabled by calibration at this
-     * point. Only issue commands if tracking needs to be turned on.
-     */
-    if (_use_dc_offset_tracking)
-        _configure_bb_dc_tracking();
-    if (_use_iq_balance_tracking)
-        _configure_rx_iq_tracking();
+    /* The calibration pass is skippable when the client configures a
+     * clock rate right after initialization: set_clock_rate() re-runs
+     * every algorithm below at the actual rate. Leaving the last cal
+     * frequencies untouched (at zero) guarantees that a tune before
+     * any rate change still triggers a calibration. */
+    if (not _skip_init_cal) {
+        _calibrate_baseband_dc_offset();
+        _calibrate_rf_dc_offset();
+        _calibrate_rx_quadrature();
+
+        /*
+         * Rx BB DC and IQ tracking are both disabled by calibration at this
+         * point. Only issue commands if tracking needs to be turned on.
+         */
+        if (_use_dc_offset_tracking)
+            _configure_bb_dc_tracking();
+        if (_use_iq_balance_tracking)
+            _configure_rx_iq_tracking();
 
-    _last_rx_cal_freq = _rx_freq;
-    _last_tx_cal_freq = _tx_freq;
+        _last_rx_cal_freq = _rx_freq;
+        _last_tx_cal_freq = _tx_freq;
+    }
 
     // cals done, set PPORT config
     switch (_client_params->get_digital_interface_mode()) {
@@ -31,6 +31,7 @@ public:
 
     ad9361_device_t(ad9361_params::sptr client, ad9361_io::sptr io_iface) :
         _client_params(client), _io_iface(io_iface),
+        _last_rx_cal_freq(0.0), _last_tx_cal_freq(0.0),
         _bbpll_freq(0.0), _adcclock_freq(0.0), _req_clock_rate(0.0),
         _req_coreclk(0.0), _rx_bbf_tunediv(0), _curr_gain_table(0),
         _rx1_gain(0.0), _rx2_gain(0.0), _tx1_gain(0.0), _tx2_gain(0.0),
@@ -38,6 +39,7 @@ public:
         _rx1_agc_mode(GAIN_MODE_MANUAL), _rx2_agc_mode(GAIN_MODE_MANUAL),
         _rx1_agc_enable(false), _rx2_agc_enable(false),
         _use_dc_offset_tracking(false), _use_iq_balance_tracking(false),
+        _skip_init_cal(false),
         _rx_filters{
             {"LPF_TIA", std::make_tuple(
                     [this](const chain_t){
@@ -158,6 +160,15 @@ public:
     /* Initialize the AD9361 codec. */
     void initialize();
 
+    /* Skip the calibration pass at the end of initialize().
+     *
+     * The first set_clock_rate() call after initialization re-runs every
+     * calibration algorithm at the actual rate anyway, so a client that
+     * always configures a clock rate right after construction can skip
+     * the initialization-time pass and roughly halve the startup time.
+     * Must be called before initialize(). */
+    void skip_initialization_calibration(void) { _skip_init_cal = true; }
+
     /* Set SPI interface */
     void set_io_iface(ad9361_io::sptr io_iface);
 
@@ -347,6 +358,7 @@ private:    //Members
     std::recursive_mutex  _mutex;
     bool _use_dc_offset_tracking;
     bool _use_iq_balance_tracking;
+    bool _skip_init_cal;
 
     // Filter API
     using filter_tuple = std::tuple<
@@ -6,16 +6,22 @@
 //
 
 #include <uhdlib/usrp/common/apply_corrections.hpp>
+#include <uhdlib/cal/binary_cal_table.hpp>
 #include <uhd/usrp/dboard_eeprom.hpp>
 #include <uhd/utils/paths.hpp>
 #include <uhd/utils/log.hpp>
 #include <uhd/utils/csv.hpp>
 #include <uhd/types/dict.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/thread/mutex.hpp>
 #include <cstdio>
+#include <cmath>
 #include <complex>
 #include <fstream>
+#include <list>
+#include <unordered_map>
+#include <utility>
 
 namespace fs = boost::filesystem;
 
@@ -42,6 +48,55 @@ static bool fe_cal_comp(fe_cal_t a, fe_cal_t b){
 }
 
 static uhd::dict<std::string, std::vector<fe_cal_t> > fe_cal_cache;
+static uhd::dict<std::string, uhd::cal::binary_cal_table::sptr> fe_bin_cal_cache;
+
+/***********************************************************************
+ * LRU cache of interpolated corrections
+ *
+ * Hopping schedules revisit a fixed set of frequencies, so repeat
+ * tunes resolve with a hash lookup instead of searching and
+ * interpolating the table again on every hop. Guarded by the
+ * corrections_mutex held by all callers.
+ **********************************************************************/
+static const size_t FE_CAL_LRU_CAPACITY = 1024;
+
+//key is (table key, freq bucket at is_same_freq granularity)
+typedef std::pair<std::string, long long> fe_cal_lru_key_t;
+typedef std::pair<fe_cal_lru_key_t, std::complex<double> > fe_cal_lru_entry_t;
+static std::list<fe_cal_lru_entry_t> fe_cal_lru_list;
+static std::unordered_map<
+    fe_cal_lru_key_t,
+    std::list<fe_cal_lru_entry_t>::iterator,
+    boost::hash<fe_cal_lru_key_t>
+> fe_cal_lru_map;
+
+static fe_cal_lru_key_t fe_cal_lru_key(const std::string &key, const double lo_freq)
+{
+    return fe_cal_lru_key_t(key, (long long)(std::floor(lo_freq * 10.0 + 0.5)));
+}
+
+static bool fe_cal_lru_get(
+    const std::string &key, const double lo_freq, std::complex<double> &corr
+){
+    const auto it = fe_cal_lru_map.find(fe_cal_lru_key(key, lo_freq));
+    if (it == fe_cal_lru_map.end()) return false;
+    //move the hit to the front of the recency list
+    fe_cal_lru_list.splice(fe_cal_lru_list.begin(), fe_cal_lru_list, it->second);
+    corr = it->second->second;
+    return true;
+}
+
+static void fe_cal_lru_put(
+    const std::string &key, const double lo_freq, const std::complex<double> &corr
+){
+    fe_cal_lru_list.push_front(
+        fe_cal_lru_entry_t(fe_cal_lru_key(key, lo_freq), corr));
+    fe_cal_lru_map[fe_cal_lru_list.front().first] = fe_cal_lru_list.begin();
+    if (fe_cal_lru_list.size() > FE_CAL_LRU_CAPACITY){
+        fe_cal_lru_map.erase(fe_cal_lru_list.back().first);
+        fe_cal_lru_list.pop_back();
+    }
+}
 
 static bool is_same_freq(const double f1, const double f2)
 {
@@ -82,6 +137,35 @@ static std::complex<double> get_fe_correction(
     );
 }
 
+static std::complex<double> get_fe_correction(
+    const uhd::cal::binary_cal_table::sptr &table, const double lo_freq
+){
+    //rows are (lo_freq, iq_corr_real, iq_corr_imag) sorted by lo_freq
+    const size_t num_rows = table->get_num_rows();
+    if (num_rows == 0 or table->get_num_cols() < 3)
+        throw uhd::runtime_error("malformed binary calibration table");
+
+    const size_t hi_index = table->lower_bound(lo_freq);
+    if (hi_index == num_rows){ //all rows below: clamp to the last one
+        const double *row = table->at(num_rows - 1);
+        return std::complex<double>(row[1], row[2]);
+    }
+    const double *hi_row = table->at(hi_index);
+    if (hi_index == 0 or is_same_freq(hi_row[0], lo_freq)){
+        return std::complex<double>(hi_row[1], hi_row[2]);
+    }
+    const double *lo_row = table->at(hi_index - 1);
+    if (is_same_freq(lo_row[0], lo_freq)){
+        return std::complex<double>(lo_row[1], lo_row[2]);
+    }
+
+    //interpolation time
+    return std::complex<double>(
+        linear_interp(lo_freq, lo_row[0], lo_row[1], hi_row[0], hi_row[1]),
+        linear_interp(lo_freq, lo_row[0], lo_row[2], hi_row[0], hi_row[2])
+    );
+}
+
 static void apply_fe_corrections(
     uhd::property_tree::sptr sub_tree,
     const uhd::fs_path &db_path,
@@ -92,6 +176,26 @@ static void apply_fe_corrections(
     //extract eeprom serial
     const uhd::usrp::dboard_eeprom_t db_eeprom = sub_tree->access<uhd::usrp::dboard_eeprom_t>(db_path).get();
 
+    //prefer the flat binary table when one has been generated: it is
+    //mmap'd and searched in place, so large per-frequency tables are
+    //neither parsed nor copied into memory at load
+    const fs::path bin_data_path = fs::path(uhd::get_app_path()) / ".uhd" / "cal"
+        / (file_prefix + db_eeprom.serial + uhd::cal::binary_cal_table::FILE_EXT);
+    if (fe_bin_cal_cache.has_key(bin_data_path.string()) or fs::exists(bin_data_path)){
+        if (not fe_bin_cal_cache.has_key(bin_data_path.string())){
+            fe_bin_cal_cache[bin_data_path.string()] =
+                uhd::cal::binary_cal_table::make(bin_data_path.string());
+            UHD_LOGGER_INFO("CAL") << "Calibration data mapped: " << bin_data_path.string();
+        }
+        std::complex<double> corr;
+        if (not fe_cal_lru_get(bin_data_path.string(), lo_freq, corr)){
+            corr = get_fe_correction(fe_bin_cal_cache[bin_data_path.string()], lo_freq);
+            fe_cal_lru_put(bin_data_path.string(), lo_freq, corr);
+        }
+        sub_tree->access<std::complex<double> >(fe_path).set(corr);
+        return;
+    }
+
     //make the calibration file path
     const fs::path cal_data_path = fs::path(uhd::get_app_path()) / ".uhd" / "cal" / (file_prefix + db_eeprom.serial + ".csv");
     if (not fs::exists(cal_data_path)) return;
@@ -126,8 +230,12 @@ static void apply_fe_corrections(
 
     }
 
-    sub_tree->access<std::complex<double> >(fe_path)
-        .set(get_fe_correction(cal_data_path.string(), lo_freq));
+    std::complex<double> corr;
+    if (not fe_cal_lru_get(cal_data_path.string(), lo_freq, corr)){
+        corr = get_fe_correction(cal_data_path.string(), lo_freq);
+        fe_cal_lru_put(cal_data_path.string(), lo_freq, corr);
+    }
+    sub_tree->access<std::complex<double> >(fe_path).set(corr);
 }
 
 /***********************************************************************
@@ -115,6 +115,45 @@ public:
         }
     }
 
+    virtual void set_atr_config(const atr_config_t &config)
+    {
+        //Update every shadow register first, then flush the changed
+        //registers back-to-back: the writes go out as one uninterrupted
+        //burst on the control interface with nothing interleaved.
+        if (config.atr_mode_mask != 0) {
+            //atr_disable is the inverse convention: 1 = static GPIO
+            _atr_disable_reg.set_with_mask(~config.atr_mode_value, config.atr_mode_mask);
+        }
+        if (config.ddr_mask  != 0) _ddr_reg.set_with_mask(config.ddr_value, config.ddr_mask);
+        if (config.idle_mask != 0) _atr_idle_reg.set_with_mask(config.idle_value, config.idle_mask);
+        if (config.rx_mask   != 0) _atr_rx_reg.set_with_mask(config.rx_value, config.rx_mask);
+        if (config.tx_mask   != 0) _atr_tx_reg.set_with_mask(config.tx_value, config.tx_mask);
+        if (config.fdx_mask  != 0) _atr_fdx_reg.set_with_mask(config.fdx_value, config.fdx_mask);
+
+        //mode and direction first, then the state table; the idle
+        //register output also depends on the atr_disable setting
+        if (config.atr_mode_mask != 0) _atr_disable_reg.flush();
+        if (config.ddr_mask      != 0) _ddr_reg.flush();
+        if (config.idle_mask != 0 or config.atr_mode_mask != 0) _atr_idle_reg.flush();
+        if (config.rx_mask   != 0) _atr_rx_reg.flush();
+        if (config.tx_mask   != 0) _atr_tx_reg.flush();
+        if (config.fdx_mask  != 0) _atr_fdx_reg.flush();
+    }
+
+    virtual void set_atr_config(const atr_config_t &config, const time_spec_t &time)
+    {
+        timed_wb_iface::sptr timed =
+            boost::dynamic_pointer_cast<timed_wb_iface>(_iface);
+        if (not timed) {
+            throw uhd::not_implemented_error(
+                "timed GPIO ATR programming is not supported on this control interface");
+        }
+        const time_spec_t prev_time = timed->get_time();
+        timed->set_time(time);
+        set_atr_config(config);
+        timed->set_time(prev_time);
+    }
+
     inline virtual void set_gpio_attr(const gpio_attr_t attr, const uint32_t value)
     {
         //An attribute based API to configure all settings for the GPIO bus in one function
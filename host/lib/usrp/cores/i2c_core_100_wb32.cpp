@@ -8,6 +8,7 @@
 #include <uhd/exception.hpp>
 #include <uhd/utils/log.hpp>
 #include <uhdlib/usrp/cores/i2c_core_100_wb32.hpp>
+#include <boost/thread/recursive_mutex.hpp>
 #include <chrono>
 #include <thread>
 
@@ -70,6 +71,9 @@ public:
         uint16_t addr,
         const byte_vector_t &bytes
     ){
+        //a transaction spans multiple pokes and callers
+        //may run from parallel radio setup threads
+        boost::recursive_mutex::scoped_lock lock(_mutex);
         _iface->poke32(REG_I2C_DATA, (addr << 1) | 0); //addr and read bit (0)
         _iface->poke32(REG_I2C_CMD_STATUS, I2C_CMD_WR | I2C_CMD_START | (bytes.size() == 0 ? I2C_CMD_STOP : 0));
 
@@ -93,6 +97,7 @@ public:
         uint16_t addr,
         size_t num_bytes
     ){
+        boost::recursive_mutex::scoped_lock lock(_mutex);
         byte_vector_t bytes;
         if (num_bytes == 0) return bytes;
 
@@ -118,6 +123,8 @@ public:
     //the default implementation calls read i2c once per byte
     byte_vector_t read_eeprom(uint16_t addr, uint16_t offset, size_t num_bytes)
     {
+        //recursive: the lock must span both halves of the transaction
+        boost::recursive_mutex::scoped_lock lock(_mutex);
         this->write_i2c(addr, byte_vector_t(1, uint8_t(offset)));
         return this->read_i2c(addr, num_bytes);
     }
@@ -139,6 +146,7 @@ private:
 
     wb_iface::sptr _iface;
     const size_t _base;
+    boost::recursive_mutex _mutex;
 };
 
 i2c_core_100_wb32::sptr i2c_core_100_wb32::make(wb_iface::sptr iface, const size_t base)
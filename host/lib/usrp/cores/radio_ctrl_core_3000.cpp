@@ -17,7 +17,11 @@
 #include <boost/thread/thread.hpp>
 #include <boost/format.hpp>
 #include <boost/bind.hpp>
-#include <queue>
+#include <algorithm>
+#include <boost/circular_buffer.hpp>
+#include <chrono>
+#include <cmath>
+#include <thread>
 
 using namespace uhd;
 using namespace uhd::usrp;
@@ -27,6 +31,20 @@ static const double ACK_TIMEOUT = 2.0; //supposed to be worst case practical tim
 static const double MASSIVE_TIMEOUT = 10.0; //for when we wait on a timed command
 static const size_t SR_READBACK = 32;
 
+//! Minimum number of outstanding write acks before a poke blocks.
+// Some control transports expose very few receive frames (the ethernet
+// control path gets only two), which would otherwise throttle a burst of
+// register writes to one round trip per write. Since acks are reaped
+// opportunistically after every send, the pipeline depth can safely
+// exceed the transport's receive ring. Must stay below the shallowest
+// command FIFO across the gen-3 FPGAs.
+static const size_t DEFAULT_PIPELINE_DEPTH = 16;
+
+//! Assumed safe lead time for timed commands before calibration.
+// Generous enough for a congested gigabit link; measure_command_latency()
+// replaces it with what the transport actually delivers.
+static const double DEFAULT_COMMAND_MARGIN = 0.010;
+
 radio_ctrl_core_3000::~radio_ctrl_core_3000(void){
     /* NOP */
 }
@@ -43,8 +61,12 @@ public:
                     vrt::if_packet_info_t::PACKET_TYPE_CONTEXT), _bige(
                     big_endian), _ctrl_xport(ctrl_xport), _resp_xport(
                     resp_xport), _sid(sid), _name(name), _seq_out(0), _timeout(
-                    ACK_TIMEOUT), _resp_queue(128/*max response msgs*/), _resp_queue_size(
-                    _resp_xport ? _resp_xport->get_num_recv_frames() : 3)
+                    ACK_TIMEOUT), _command_margin(DEFAULT_COMMAND_MARGIN), _resp_queue(
+                    128/*max response msgs*/), _resp_queue_size(
+                    _resp_xport ?
+                        std::max(_resp_xport->get_num_recv_frames(), DEFAULT_PIPELINE_DEPTH) :
+                        DEFAULT_PIPELINE_DEPTH), _outstanding_seqs(
+                    _resp_queue_size + 1)
     {
         if (resp_xport)
         {
@@ -90,6 +112,47 @@ public:
         return this->wait_for_ack(true);
     }
 
+    //taking the lock once keeps the whole burst contiguous on the
+    //transport, so the writes pipeline up to _resp_queue_size deep
+    //instead of interleaving with other callers' round trips
+    void poke32_range(const wb_addr_type addr, const std::vector<uint32_t> &data)
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        for (size_t i = 0; i < data.size(); i++)
+        {
+            this->send_pkt((addr + 4*i)/4, data[i]);
+            this->wait_for_ack(false);
+        }
+    }
+
+    std::vector<uint32_t> peek32_range(const wb_addr_type addr, const size_t num_regs)
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        std::vector<uint32_t> data(num_regs);
+
+        //drain outstanding write acks first so every response received
+        //below belongs to one of our readback requests
+        while (not _outstanding_seqs.empty()) this->recv_one_ack();
+
+        size_t next_req = 0, next_resp = 0;
+        while (next_resp < num_regs)
+        {
+            //keep the request pipeline as deep as the response queue allows
+            while (next_req < num_regs
+                and _outstanding_seqs.size() < _resp_queue_size)
+            {
+                this->send_pkt(SR_READBACK, (addr + 4*next_req)/8);
+                next_req++;
+            }
+            const uint64_t res = this->recv_one_ack();
+            const uint32_t lo = uint32_t(res & 0xffffffff);
+            const uint32_t hi = uint32_t(res >> 32);
+            data[next_resp] = (((addr + 4*next_resp)/4) & 0x1)? hi : lo;
+            next_resp++;
+        }
+        return data;
+    }
+
     /*******************************************************************
      * Update methods for time
      ******************************************************************/
@@ -113,6 +176,80 @@ public:
         _tick_rate = rate;
     }
 
+    /*******************************************************************
+     * Command latency calibration
+     ******************************************************************/
+    latency_stats_t measure_command_latency(const size_t num_samples)
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        if (num_samples == 0)
+        {
+            throw uhd::value_error("measure_command_latency() requires at least one sample");
+        }
+        if (_use_time)
+        {
+            throw uhd::runtime_error(str(boost::format(
+                "Radio ctrl (%s) measure_command_latency() cannot run with a "
+                "command time set: acks for timed commands return at execution "
+                "time, not at delivery time") % _name));
+        }
+
+        //drain outstanding write acks so every round trip below pairs
+        //one request with its own response
+        while (not _outstanding_seqs.empty()) this->recv_one_ack();
+
+        //one throwaway round trip warms up the transport path
+        this->send_pkt(SR_READBACK, 0);
+        this->recv_one_ack();
+
+        std::vector<double> samples(num_samples);
+        for (size_t i = 0; i < num_samples; i++)
+        {
+            //stagger the issue times so the batch does not beat against
+            //periodic traffic sharing the link
+            std::this_thread::sleep_for(std::chrono::microseconds(50 + 70*long(i % 7)));
+
+            const std::chrono::steady_clock::time_point start =
+                std::chrono::steady_clock::now();
+            this->send_pkt(SR_READBACK, 0);
+            this->recv_one_ack();
+            samples[i] = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+        }
+
+        latency_stats_t stats;
+        stats.min_latency = samples.front();
+        stats.max_latency = samples.front();
+        double sum = 0.0;
+        for (size_t i = 0; i < num_samples; i++)
+        {
+            stats.min_latency = std::min(stats.min_latency, samples[i]);
+            stats.max_latency = std::max(stats.max_latency, samples[i]);
+            sum += samples[i];
+        }
+        stats.mean_latency = sum/num_samples;
+        double sq_sum = 0.0;
+        for (size_t i = 0; i < num_samples; i++)
+        {
+            const double dev = samples[i] - stats.mean_latency;
+            sq_sum += dev*dev;
+        }
+        stats.jitter = std::sqrt(sq_sum/num_samples);
+
+        //cover the slowest observed delivery plus headroom for jitter
+        //the batch did not happen to sample
+        stats.safe_margin = std::max(stats.max_latency,
+            stats.mean_latency + 4.0*stats.jitter);
+        _command_margin = stats.safe_margin;
+        return stats;
+    }
+
+    double get_command_margin(void)
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        return _command_margin;
+    }
+
 private:
     // This is the buffer type for messages in radio control core.
     struct resp_buff_type
@@ -157,119 +294,177 @@ private:
         pkt[packet_info.num_header_words32+1] = (_bige)? uhd::htonx(data) : uhd::htowx(data);
         //UHD_LOGGER_INFO("radio_ctrl") << boost::format("0x%08x, 0x%08x\n") % addr % data;
         //send the buffer over the interface
-        _outstanding_seqs.push(_seq_out);
+        UHD_ASSERT_THROW(not _outstanding_seqs.full());
+        _outstanding_seqs.push_back(_seq_out);
         buff->commit(sizeof(uint32_t)*(packet_info.num_packet_words32));
 
         _seq_out++;//inc seq for next call
     }
 
+    //! Block until one response arrives and ack the oldest outstanding seq
+    UHD_INLINE uint64_t recv_one_ack(void)
+    {
+        //get seq to ack from outstanding packets list
+        UHD_ASSERT_THROW(not _outstanding_seqs.empty());
+        const size_t seq_to_ack = _outstanding_seqs.front();
+        _outstanding_seqs.pop_front();
+
+        //parse the packet
+        vrt::if_packet_info_t packet_info;
+        resp_buff_type resp_buff;
+        memset(&resp_buff, 0x00, sizeof(resp_buff));
+        uint32_t const *pkt = NULL;
+        managed_recv_buffer::sptr buff;
+
+        //get buffer from response endpoint - or die in timeout
+        if (_resp_xport)
+        {
+            buff = _resp_xport->get_recv_buff(_timeout);
+            try
+            {
+                UHD_ASSERT_THROW(bool(buff));
+                UHD_ASSERT_THROW(buff->size() > 0);
+            }
+            catch(const std::exception &ex)
+            {
+                throw uhd::io_error(str(boost::format("Radio ctrl (%s) no response packet - %s") % _name % ex.what()));
+            }
+            pkt = buff->cast<const uint32_t *>();
+            packet_info.num_packet_words32 = buff->size()/sizeof(uint32_t);
+        }
+
+        //get buffer from response endpoint - or die in timeout
+        else
+        {
+            /*
+             * Couldn't get message with haste.
+             * Now check both possible queues for messages.
+             * Messages should come in on _resp_queue,
+             * but could end up in dump_queue.
+             * If we don't get a message --> Die in timeout.
+             */
+            double accum_timeout = 0.0;
+            const double short_timeout = 0.005; // == 5ms
+            while(not ((_resp_queue.pop_with_haste(resp_buff))
+                    || (check_dump_queue(resp_buff))
+                    || (_resp_queue.pop_with_timed_wait(resp_buff, short_timeout))
+                    )){
+                /*
+                 * If a message couldn't be received within a given timeout
+                 * --> throw AssertionError!
+                 */
+                accum_timeout += short_timeout;
+                UHD_ASSERT_THROW(accum_timeout < _timeout);
+            }
+
+            pkt = resp_buff.data;
+            packet_info.num_packet_words32 = sizeof(resp_buff)/sizeof(uint32_t);
+        }
+
+        return this->handle_ack(pkt, packet_info, seq_to_ack, buff);
+    }
+
     UHD_INLINE uint64_t wait_for_ack(const bool readback)
     {
         while (readback or (_outstanding_seqs.size() >= _resp_queue_size))
         {
-            //get seq to ack from outstanding packets list
-            UHD_ASSERT_THROW(not _outstanding_seqs.empty());
-            const size_t seq_to_ack = _outstanding_seqs.front();
-            _outstanding_seqs.pop();
+            const uint64_t res = this->recv_one_ack();
+
+            //return the readback value
+            if (readback and _outstanding_seqs.empty())
+            {
+                return res;
+            }
+        }
+
+        //a write below the pipeline limit does not block, but reap any
+        //responses that already arrived so the transport's receive
+        //frames free up in the middle of a long burst of writes
+        this->reap_available_acks();
 
-            //parse the packet
+        return 0;
+    }
+
+    UHD_INLINE void reap_available_acks(void)
+    {
+        while (not _outstanding_seqs.empty())
+        {
             vrt::if_packet_info_t packet_info;
             resp_buff_type resp_buff;
-            memset(&resp_buff, 0x00, sizeof(resp_buff));
             uint32_t const *pkt = NULL;
             managed_recv_buffer::sptr buff;
 
-            //get buffer from response endpoint - or die in timeout
+            //grab a response with haste - or give up for now
             if (_resp_xport)
             {
-                buff = _resp_xport->get_recv_buff(_timeout);
-                try
+                buff = _resp_xport->get_recv_buff(0.0);
+                if (not buff) return;
+                if (buff->size() == 0)
                 {
-                    UHD_ASSERT_THROW(bool(buff));
-                    UHD_ASSERT_THROW(buff->size() > 0);
-                }
-                catch(const std::exception &ex)
-                {
-                    throw uhd::io_error(str(boost::format("Radio ctrl (%s) no response packet - %s") % _name % ex.what()));
+                    throw uhd::io_error(str(boost::format("Radio ctrl (%s) empty response packet") % _name));
                 }
                 pkt = buff->cast<const uint32_t *>();
                 packet_info.num_packet_words32 = buff->size()/sizeof(uint32_t);
             }
-
-            //get buffer from response endpoint - or die in timeout
             else
             {
-                /*
-                 * Couldn't get message with haste.
-                 * Now check both possible queues for messages.
-                 * Messages should come in on _resp_queue,
-                 * but could end up in dump_queue.
-                 * If we don't get a message --> Die in timeout.
-                 */
-                double accum_timeout = 0.0;
-                const double short_timeout = 0.005; // == 5ms
-                while(not ((_resp_queue.pop_with_haste(resp_buff))
-                        || (check_dump_queue(resp_buff))
-                        || (_resp_queue.pop_with_timed_wait(resp_buff, short_timeout))
-                        )){
-                    /*
-                     * If a message couldn't be received within a given timeout
-                     * --> throw AssertionError!
-                     */
-                    accum_timeout += short_timeout;
-                    UHD_ASSERT_THROW(accum_timeout < _timeout);
-                }
-
+                if (not _resp_queue.pop_with_haste(resp_buff)) return;
                 pkt = resp_buff.data;
                 packet_info.num_packet_words32 = sizeof(resp_buff)/sizeof(uint32_t);
             }
 
-            //parse the buffer
-            try
-            {
-                packet_info.link_type = _link_type;
-                if (_bige) vrt::if_hdr_unpack_be(pkt, packet_info);
-                else vrt::if_hdr_unpack_le(pkt, packet_info);
-            }
-            catch(const std::exception &ex)
-            {
-                UHD_LOGGER_ERROR("radio_ctrl") << "Radio ctrl bad VITA packet: " << ex.what() ;
-                if (buff){
-                    UHD_VAR(buff->size());
-                }
-                else{
-                    UHD_LOGGER_INFO("radio_ctrl") << "buff is NULL" ;
-                }
-                UHD_LOGGER_INFO("radio_ctrl") << std::hex << pkt[0] << std::dec ;
-                UHD_LOGGER_INFO("radio_ctrl") << std::hex << pkt[1] << std::dec ;
-                UHD_LOGGER_INFO("radio_ctrl") << std::hex << pkt[2] << std::dec ;
-                UHD_LOGGER_INFO("radio_ctrl") << std::hex << pkt[3] << std::dec ;
-            }
+            const size_t seq_to_ack = _outstanding_seqs.front();
+            _outstanding_seqs.pop_front();
+            this->handle_ack(pkt, packet_info, seq_to_ack, buff);
+        }
+    }
 
-            //check the buffer
-            try
-            {
-                UHD_ASSERT_THROW(packet_info.has_sid);
-                UHD_ASSERT_THROW(packet_info.sid == uint32_t((_sid >> 16) | (_sid << 16)));
-                UHD_ASSERT_THROW(packet_info.packet_count == (seq_to_ack & 0xfff));
-                UHD_ASSERT_THROW(packet_info.num_payload_words32 == 2);
-                UHD_ASSERT_THROW(packet_info.packet_type == _packet_type);
+    UHD_INLINE uint64_t handle_ack(
+            const uint32_t *pkt,
+            vrt::if_packet_info_t &packet_info,
+            const size_t seq_to_ack,
+            managed_recv_buffer::sptr buff)
+    {
+        //parse the buffer
+        try
+        {
+            packet_info.link_type = _link_type;
+            if (_bige) vrt::if_hdr_unpack_be(pkt, packet_info);
+            else vrt::if_hdr_unpack_le(pkt, packet_info);
+        }
+        catch(const std::exception &ex)
+        {
+            UHD_LOGGER_ERROR("radio_ctrl") << "Radio ctrl bad VITA packet: " << ex.what() ;
+            if (buff){
+                UHD_VAR(buff->size());
             }
-            catch(const std::exception &ex)
-            {
-                throw uhd::io_error(str(boost::format("Radio ctrl (%s) packet parse error - %s") % _name % ex.what()));
+            else{
+                UHD_LOGGER_INFO("radio_ctrl") << "buff is NULL" ;
             }
+            UHD_LOGGER_INFO("radio_ctrl") << std::hex << pkt[0] << std::dec ;
+            UHD_LOGGER_INFO("radio_ctrl") << std::hex << pkt[1] << std::dec ;
+            UHD_LOGGER_INFO("radio_ctrl") << std::hex << pkt[2] << std::dec ;
+            UHD_LOGGER_INFO("radio_ctrl") << std::hex << pkt[3] << std::dec ;
+        }
 
-            //return the readback value
-            if (readback and _outstanding_seqs.empty())
-            {
-                const uint64_t hi = (_bige)? uhd::ntohx(pkt[packet_info.num_header_words32+0]) : uhd::wtohx(pkt[packet_info.num_header_words32+0]);
-                const uint64_t lo = (_bige)? uhd::ntohx(pkt[packet_info.num_header_words32+1]) : uhd::wtohx(pkt[packet_info.num_header_words32+1]);
-                return ((hi << 32) | lo);
-            }
+        //check the buffer
+        try
+        {
+            UHD_ASSERT_THROW(packet_info.has_sid);
+            UHD_ASSERT_THROW(packet_info.sid == uint32_t((_sid >> 16) | (_sid << 16)));
+            UHD_ASSERT_THROW(packet_info.packet_count == (seq_to_ack & 0xfff));
+            UHD_ASSERT_THROW(packet_info.num_payload_words32 == 2);
+            UHD_ASSERT_THROW(packet_info.packet_type == _packet_type);
+        }
+        catch(const std::exception &ex)
+        {
+            throw uhd::io_error(str(boost::format("Radio ctrl (%s) packet parse error - %s") % _name % ex.what()));
         }
 
-        return 0;
+        //extract the readback value
+        const uint64_t hi = (_bige)? uhd::ntohx(pkt[packet_info.num_header_words32+0]) : uhd::wtohx(pkt[packet_info.num_header_words32+0]);
+        const uint64_t lo = (_bige)? uhd::ntohx(pkt[packet_info.num_header_words32+1]) : uhd::wtohx(pkt[packet_info.num_header_words32+1]);
+        return ((hi << 32) | lo);
     }
 
     /*
@@ -322,9 +517,13 @@ private:
     bool _use_time;
     double _tick_rate;
     double _timeout;
-    std::queue<size_t> _outstanding_seqs;
+    double _command_margin;
     bounded_buffer<resp_buff_type> _resp_queue;
     const size_t _resp_queue_size;
+    // Preallocated to the pipeline depth, so tracking a transaction
+    // never touches the allocator (std::queue's deque backing churns
+    // heap blocks under sustained command storms)
+    boost::circular_buffer<size_t> _outstanding_seqs;
 };
 
 radio_ctrl_core_3000::sptr radio_ctrl_core_3000::make(const bool big_endian,
@@ -156,8 +156,11 @@ public:
             decim /= 2;
         }
 
+        //group the decimation and scale factor writes into one batch
+        wb_write_batch batch(_iface);
+
         if (_is_b200) {
-            _iface->poke32(REG_DSP_RX_DECIM, (hb0 << 9) /*small HB */ | (hb1 << 8) /*large HB*/ | (decim & 0xff));
+            batch.poke32(REG_DSP_RX_DECIM, (hb0 << 9) /*small HB */ | (hb1 << 8) /*large HB*/ | (decim & 0xff));
 
             if (decim > 1 and hb0 == 0 and hb1 == 0) {
                 UHD_LOGGER_WARNING("CORES") << boost::format(
@@ -177,7 +180,7 @@ public:
             } else {
                 hb_enable=0;
             }
-            _iface->poke32(REG_DSP_RX_DECIM,  (hb_enable << 8) | (decim & 0xff));
+            batch.poke32(REG_DSP_RX_DECIM,  (hb_enable << 8) | (decim & 0xff));
 
             if (decim > 1 and hb0 == 0 and hb1 == 0 and hb2 == 0) {
                 UHD_LOGGER_WARNING("CORES") << boost::format(
@@ -204,7 +207,8 @@ public:
         // _scaling_adjustment = std::pow(2, ceil_log2(rate_pow))/(1.648*rate_pow*1.415);
         _scaling_adjustment = std::pow(2, ceil_log2(rate_pow))/(1.648*rate_pow);
 
-        this->update_scalar();
+        this->update_scalar(batch);
+        batch.commit();
 
         return _tick_rate/decim_rate;
     }
@@ -213,12 +217,18 @@ public:
     // gain compensation blocks already hardcoded in place in DDC (that provide simple 1/2^n gain compensation).
     // Further more factor in OTW format which adds further gain factor to weight output samples correctly.
     void update_scalar(void){
+        wb_write_batch batch(_iface);
+        this->update_scalar(batch);
+        batch.commit();
+    }
+
+    void update_scalar(wb_write_batch &batch){
         const double target_scalar = (1 << (_is_b200 ? 16 : 15))*_scaling_adjustment/_dsp_extra_scaling;
         const int32_t actual_scalar = boost::math::iround(target_scalar);
         // Calculate the error introduced by using integer representation for the scalar, can be corrected in host later.
         _fxpt_scalar_correction = target_scalar/actual_scalar;
         // Write DDC with scaling correction for CIC and CORDIC that maximizes dynamic range in 32/16/12/8bits.
-        _iface->poke32(REG_DSP_RX_SCALE_IQ, actual_scalar);
+        batch.poke32(REG_DSP_RX_SCALE_IQ, actual_scalar);
     }
 
     double get_scaling_adjustment(void){
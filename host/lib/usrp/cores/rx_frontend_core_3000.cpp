@@ -94,7 +94,8 @@ public:
         if (fe_conn.is_i_inverted()) mapping_reg_val |= FLAG_DSP_RX_MAPPING_INVERT_I;
         if (fe_conn.is_q_inverted()) mapping_reg_val |= FLAG_DSP_RX_MAPPING_INVERT_Q;
 
-        _iface->poke32(REG_RX_FE_MAPPING, mapping_reg_val);
+        wb_write_batch batch(_iface);
+        batch.poke32(REG_RX_FE_MAPPING, mapping_reg_val);
 
         UHD_ASSERT_THROW(_adc_rate!=0.0)
         if (fe_conn.get_sampling_mode() == fe_connection_t::HETERODYNE) {
@@ -116,9 +117,10 @@ public:
                     std::abs(_adc_rate / cordic_freq)
             );
 
-            _iface->poke32(REG_RX_FE_HET_CORDIC_PHASE, (cordic_freq > 0) ? 0 : 1);
+            batch.poke32(REG_RX_FE_HET_CORDIC_PHASE, (cordic_freq > 0) ? 0 : 1);
         }
 
+        batch.commit();
 
         _fe_conn = fe_conn;
     }
@@ -138,13 +140,17 @@ public:
     }
 
     void _set_dc_offset(const uint32_t flags) {
-        _iface->poke32(REG_RX_FE_OFFSET_I, flags | (_i_dc_off & ~FLAG_MASK));
-        _iface->poke32(REG_RX_FE_OFFSET_Q, flags | (_q_dc_off & ~FLAG_MASK));
+        wb_write_batch batch(_iface);
+        batch.poke32(REG_RX_FE_OFFSET_I, flags | (_i_dc_off & ~FLAG_MASK));
+        batch.poke32(REG_RX_FE_OFFSET_Q, flags | (_q_dc_off & ~FLAG_MASK));
+        batch.commit();
     }
 
     void set_iq_balance(const std::complex<double> &cor) {
-        _iface->poke32(REG_RX_FE_MAG_CORRECTION, fs_to_bits(cor.real(), 18));
-        _iface->poke32(REG_RX_FE_PHASE_CORRECTION, fs_to_bits(cor.imag(), 18));
+        wb_write_batch batch(_iface);
+        batch.poke32(REG_RX_FE_MAG_CORRECTION, fs_to_bits(cor.real(), 18));
+        batch.poke32(REG_RX_FE_PHASE_CORRECTION, fs_to_bits(cor.imag(), 18));
+        batch.commit();
     }
 
     void populate_subtree(uhd::property_tree::sptr subtree) {
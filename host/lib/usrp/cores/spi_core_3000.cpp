@@ -39,6 +39,56 @@ public:
     ){
         boost::lock_guard<boost::mutex> lock(_mutex);
 
+        this->post_transaction(which_slave, config, data, num_bits);
+
+        //conditional readback
+        if (readback)
+        {
+            return _iface->peek32(_readback);
+        }
+
+        return 0;
+    }
+
+    uint32_t transact_spi_batch(const std::vector<spi_batch_entry_t> &entries)
+    {
+        boost::lock_guard<boost::mutex> lock(_mutex);
+
+        //post all transactions back-to-back with no readback in between
+        for (const spi_batch_entry_t &entry : entries) {
+            this->post_transaction(
+                entry.which_slave, entry.config, entry.data, entry.num_bits);
+        }
+
+        //one completion wait for the whole run
+        return _iface->peek32(_readback);
+    }
+
+    void set_shutdown(const bool shutdown)
+    {
+        _shutdown_cache = shutdown;
+        _iface->poke32(SPI_SHUTDOWN, _shutdown_cache);
+    }
+
+    bool get_shutdown()
+    {
+        return(_shutdown_cache);
+    }
+
+    void set_divider(const double div)
+    {
+        _div = size_t((div/2) - 0.5);
+    }
+
+private:
+
+    //! Post the writes for one transaction (caller must hold _mutex)
+    void post_transaction(
+        int which_slave,
+        const spi_config_t &config,
+        uint32_t data,
+        size_t num_bits
+    ){
         //load SPI divider
         size_t spi_divider = _div;
         if (config.use_custom_divider) {
@@ -72,34 +122,8 @@ public:
 
         //send data word
         _iface->poke32(SPI_DATA, data_out);
-
-        //conditional readback
-        if (readback)
-        {
-            return _iface->peek32(_readback);
-        }
-
-        return 0;
-    }
-
-    void set_shutdown(const bool shutdown)
-    {
-        _shutdown_cache = shutdown;
-        _iface->poke32(SPI_SHUTDOWN, _shutdown_cache);
-    }
-
-    bool get_shutdown()
-    {
-        return(_shutdown_cache);
-    }
-
-    void set_divider(const double div)
-    {
-        _div = size_t((div/2) - 0.5);
     }
 
-private:
-
     wb_iface::sptr _iface;
     const size_t _base;
     const size_t _readback;
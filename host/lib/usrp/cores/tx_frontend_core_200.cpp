@@ -60,15 +60,19 @@ public:
         const int32_t i_dc_off = boost::math::iround(off.real()*scaler);
         const int32_t q_dc_off = boost::math::iround(off.imag()*scaler);
 
-        _iface->poke32(REG_TX_FE_DC_OFFSET_I, i_dc_off);
-        _iface->poke32(REG_TX_FE_DC_OFFSET_Q, q_dc_off);
+        wb_write_batch batch(_iface);
+        batch.poke32(REG_TX_FE_DC_OFFSET_I, i_dc_off);
+        batch.poke32(REG_TX_FE_DC_OFFSET_Q, q_dc_off);
+        batch.commit();
 
         return std::complex<double>(i_dc_off/scaler, q_dc_off/scaler);
     }
 
     void set_iq_balance(const std::complex<double> &cor){
-        _iface->poke32(REG_TX_FE_MAG_CORRECTION, fs_to_bits(cor.real(), 18));
-        _iface->poke32(REG_TX_FE_PHASE_CORRECTION, fs_to_bits(cor.imag(), 18));
+        wb_write_batch batch(_iface);
+        batch.poke32(REG_TX_FE_MAG_CORRECTION, fs_to_bits(cor.real(), 18));
+        batch.poke32(REG_TX_FE_PHASE_CORRECTION, fs_to_bits(cor.imag(), 18));
+        batch.commit();
     }
 
     void populate_subtree(uhd::property_tree::sptr subtree)
@@ -47,6 +47,10 @@ public:
         rx_dboard_base(args), _expert(expert), _ctrl(ctrl),
         _ch_name(dboard_ctor_args_t::cast(args).sd_name)
     {
+        //Batch the initial property writes below into a single expert
+        //resolve instead of one resolve per auto-resolving node
+        deferred_resolve_t resolve_batch(_expert);
+
         //---------------------------------------------------------
         // Add user-visible, channel specific properties to front-end tree
         //---------------------------------------------------------
@@ -11,7 +11,11 @@
 #include <uhdlib/rfnoc/graph_impl.hpp>
 #include <uhdlib/rfnoc/ctrl_iface.hpp>
 #include <boost/make_shared.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
 #include <algorithm>
+#include <exception>
+#include <vector>
 
 using namespace uhd::usrp;
 
@@ -105,8 +109,12 @@ void device3_impl::enumerate_rfnoc_blocks(
     // 2) Destroy existing block controllers
     // TODO: Clear out all the old block control classes
     // 3) Create new block controllers
+    // First, make a transport for port number zero on every block, because
+    // we always need that. This stays serial: make_transport() mutates
+    // device state and is not safe to call concurrently.
+    std::vector<uhd::rfnoc::ctrl_iface::sptr> ctrls(n_blocks);
+    std::vector<uhd::sid_t> ctrl_send_sids(n_blocks);
     for (size_t i = 0; i < n_blocks; i++) {
-        // First, make a transport for port number zero, because we always need that:
         ctrl_sid.set_dst_xbarport(base_port + i);
         ctrl_sid.set_dst_blockport(0);
         both_xports_t xport = this->make_transport(
@@ -118,34 +126,68 @@ void device3_impl::enumerate_rfnoc_blocks(
             str(boost::format("Setting up NoC-Shell Control for port #0 (SID: %s)...")
                 % xport.send_sid.to_pp_string_hex())
         );
-        uhd::rfnoc::ctrl_iface::sptr ctrl = uhd::rfnoc::ctrl_iface::make(
+        ctrls[i] = uhd::rfnoc::ctrl_iface::make(
             xport,
             str(boost::format("CE_%02d_Port_%02X")
                 % i
                 % ctrl_sid.get_dst_endpoint())
         );
-        uint64_t noc_id = ctrl->send_cmd_pkt(
-                uhd::rfnoc::SR_READBACK,
-                uhd::rfnoc::SR_READBACK_REG_ID,
-                true
-        );
-        UHD_LOG_DEBUG("DEVICE3", str(
-            boost::format("Port 0x%02X: Found NoC-Block with ID %016X.")
-                % int(ctrl_sid.get_dst_endpoint())
-                % noc_id
-        ));
+        ctrl_send_sids[i] = xport.send_sid;
+    }
+    // Now probe the NoC IDs and parse the block definitions concurrently.
+    // Every block has its own control interface, so the readback round
+    // trips overlap with each other and with the blockdef XML parsing.
+    std::vector<uint64_t> noc_ids(n_blocks, 0);
+    std::vector<uhd::rfnoc::blockdef::sptr> block_defs(n_blocks);
+    boost::thread_group probe_threads;
+    std::exception_ptr probe_error;
+    boost::mutex probe_error_mutex;
+    for (size_t i = 0; i < n_blocks; i++) {
+        probe_threads.create_thread([&, i](){
+            try {
+                noc_ids[i] = ctrls[i]->send_cmd_pkt(
+                        uhd::rfnoc::SR_READBACK,
+                        uhd::rfnoc::SR_READBACK_REG_ID,
+                        true
+                );
+                UHD_LOG_DEBUG("DEVICE3", str(
+                    boost::format("Port 0x%02X: Found NoC-Block with ID %016X.")
+                        % int(ctrl_send_sids[i].get_dst_endpoint())
+                        % noc_ids[i]
+                ));
+                block_defs[i] = uhd::rfnoc::blockdef::make_from_noc_id(noc_ids[i]);
+                if (not block_defs[i]) {
+                    UHD_LOG_WARNING("DEVICE3",
+                        "No block definition found, using default block configuration "
+                        "for block with NOC ID: " + str(boost::format("0x%08X") % noc_ids[i])
+                    );
+                    block_defs[i] = uhd::rfnoc::blockdef::make_from_noc_id(
+                        uhd::rfnoc::DEFAULT_NOC_ID);
+                }
+                UHD_ASSERT_THROW(bool(block_defs[i]));
+            }
+            catch (...) {
+                boost::mutex::scoped_lock l(probe_error_mutex);
+                if (not probe_error) {
+                    probe_error = std::current_exception();
+                }
+            }
+        });
+    }
+    probe_threads.join_all();
+    if (probe_error) {
+        std::rethrow_exception(probe_error);
+    }
+    // Finally, create the remaining control transports and the block
+    // controllers, again serially (the controllers populate the property
+    // tree and must end up in _rfnoc_block_ctrl in port order).
+    for (size_t i = 0; i < n_blocks; i++) {
+        ctrl_sid.set_dst_xbarport(base_port + i);
+        ctrl_sid.set_dst_blockport(0);
+        const uint64_t noc_id = noc_ids[i];
+        uhd::rfnoc::blockdef::sptr block_def = block_defs[i];
         uhd::rfnoc::make_args_t make_args;
-        uhd::rfnoc::blockdef::sptr block_def = uhd::rfnoc::blockdef::make_from_noc_id(noc_id);
-        if (not block_def) {
-            UHD_LOG_WARNING("DEVICE3",
-                "No block definition found, using default block configuration "
-                "for block with NOC ID: " + str(boost::format("0x%08X") % noc_id)
-            );
-            block_def = uhd::rfnoc::blockdef::make_from_noc_id(
-                uhd::rfnoc::DEFAULT_NOC_ID);
-        }
-        UHD_ASSERT_THROW(block_def);
-        make_args.ctrl_ifaces[0] = ctrl;
+        make_args.ctrl_ifaces[0] = ctrls[i];
         for (const size_t port_number : block_def->get_all_port_numbers()) {
             if (port_number == 0) { // We've already set this up
                 continue;
@@ -173,7 +215,7 @@ void device3_impl::enumerate_rfnoc_blocks(
             str(boost::format("0x%08X") % noc_id)
         );
 
-        make_args.base_address = xport.send_sid.get_dst();
+        make_args.base_address = ctrl_send_sids[i].get_dst();
         make_args.device_index = device_index;
         make_args.tree = subtree;
         {   //Critical section for block_ctrl vector access
@@ -26,6 +26,7 @@
 #include <uhdlib/rfnoc/tx_stream_terminator.hpp>
 #include <uhdlib/rfnoc/rx_stream_terminator.hpp>
 #include <uhdlib/rfnoc/xports.hpp>
+#include <map>
 
 namespace uhd { namespace usrp {
 
@@ -42,6 +43,9 @@ static const size_t DEVICE3_LINE_SIZE                  = 8;
 static const size_t DEVICE3_TX_MAX_HDR_LEN             = uhd::transport::vrt::chdr::max_if_hdr_words64 * sizeof(uint64_t);    // Bytes
 static const size_t DEVICE3_RX_MAX_HDR_LEN             = uhd::transport::vrt::chdr::max_if_hdr_words64 * sizeof(uint64_t);    // Bytes
 
+//! Callback that parks a transport in the device cache for reuse
+typedef boost::function<void(const std::string &, const both_xports_t &)> recycle_xport_fn_t;
+
 // This class manages the lifetime of the TX async message handler task, transports, and terminator
 class device3_send_packet_streamer : public uhd::transport::sph::send_packet_streamer
 {
@@ -62,6 +66,13 @@ public:
     {
         // Make sure the async task is destroyed before the transports
         _tx_async_msg_tasks.clear();
+
+        // Hand the transports back to the device cache for reuse
+        if (_recycle_fn) {
+            for (const auto &key_xport : _recycle_xports) {
+                _recycle_fn(key_xport.first, key_xport.second);
+            }
+        }
     }
 
     uhd::rfnoc::tx_stream_terminator::sptr get_terminator()
@@ -74,11 +85,69 @@ public:
         _tx_async_msg_tasks.push_back(task);
     }
 
+    void set_recycle_fn(const recycle_xport_fn_t &recycle_fn)
+    {
+        _recycle_fn = recycle_fn;
+    }
+
+    void add_recycle_xport(const std::string &key, const both_xports_t &xport)
+    {
+        _recycle_xports.push_back(std::make_pair(key, xport));
+    }
+
+    //! Register a callback to run whenever the sample rate is updated
+    //  (used to keep rate-derived state like flow control credit
+    //  extrapolation in sync with rate changes)
+    void add_samp_rate_hook(const boost::function<void(double)> &hook)
+    {
+        _samp_rate_hooks.push_back(hook);
+    }
+
+    // Shadows the (non-virtual) handler method on purpose: the rate
+    // update path calls through this class, and the hooks must see
+    // every rate change.
+    void set_samp_rate(const double rate)
+    {
+        uhd::transport::sph::send_packet_streamer::set_samp_rate(rate);
+        for (const auto &hook : _samp_rate_hooks) {
+            hook(rate);
+        }
+    }
+
+    //! Register a per-channel transport rebuild hook (see tx_streamer::reconnect)
+    void add_reconnect_fn(const boost::function<void(void)> &fn)
+    {
+        _reconnect_fns.push_back(fn);
+    }
+
+    void reconnect(void)
+    {
+        for (const auto &fn : _reconnect_fns) {
+            fn();
+        }
+    }
+
+    //! Drop parked transports under this key (they are dead after a reconnect)
+    void remove_recycle_xport(const std::string &key)
+    {
+        for (size_t i = 0; i < _recycle_xports.size();) {
+            if (_recycle_xports[i].first == key) {
+                _recycle_xports.erase(_recycle_xports.begin() + i);
+            } else {
+                i++;
+            }
+        }
+    }
+
 private:
     uhd::rfnoc::tx_stream_terminator::sptr _terminator;
     both_xports_t _data_xport;
     both_xports_t _async_msg_xport;
     std::vector<task::sptr> _tx_async_msg_tasks;
+    recycle_xport_fn_t _recycle_fn;
+    std::vector<std::pair<std::string, both_xports_t> > _recycle_xports;
+    std::vector<boost::function<void(double)> > _samp_rate_hooks;
+    std::vector<boost::function<void(void)> > _reconnect_fns;
 };
 
 // This class manages the lifetime of the RX transports and terminator and provides access to both
@@ -94,7 +163,15 @@ public:
             _terminator(terminator),
             _xport(xport) {}
 
-    ~device3_recv_packet_streamer() {}
+    ~device3_recv_packet_streamer()
+    {
+        // Hand the transports back to the device cache for reuse
+        if (_recycle_fn) {
+            for (const auto &key_xport : _recycle_xports) {
+                _recycle_fn(key_xport.first, key_xport.second);
+            }
+        }
+    }
 
     both_xports_t get_xport()
     {
@@ -106,9 +183,47 @@ public:
         return _terminator;
     }
 
+    void set_recycle_fn(const recycle_xport_fn_t &recycle_fn)
+    {
+        _recycle_fn = recycle_fn;
+    }
+
+    void add_recycle_xport(const std::string &key, const both_xports_t &xport)
+    {
+        _recycle_xports.push_back(std::make_pair(key, xport));
+    }
+
+    //! Register a per-channel transport rebuild hook (see rx_streamer::reconnect)
+    void add_reconnect_fn(const boost::function<void(void)> &fn)
+    {
+        _reconnect_fns.push_back(fn);
+    }
+
+    void reconnect(void)
+    {
+        for (const auto &fn : _reconnect_fns) {
+            fn();
+        }
+    }
+
+    //! Drop parked transports under this key (they are dead after a reconnect)
+    void remove_recycle_xport(const std::string &key)
+    {
+        for (size_t i = 0; i < _recycle_xports.size();) {
+            if (_recycle_xports[i].first == key) {
+                _recycle_xports.erase(_recycle_xports.begin() + i);
+            } else {
+                i++;
+            }
+        }
+    }
+
 private:
     uhd::rfnoc::rx_stream_terminator::sptr _terminator;
     both_xports_t _xport;
+    recycle_xport_fn_t _recycle_fn;
+    std::vector<std::pair<std::string, both_xports_t> > _recycle_xports;
+    std::vector<boost::function<void(void)> > _reconnect_fns;
 };
 
 class device3_impl : public uhd::device3, public boost::enable_shared_from_this<device3_impl>
@@ -199,6 +314,23 @@ protected:
     virtual uhd::device_addr_t get_tx_hints(size_t) { return uhd::device_addr_t(); }
     virtual uhd::device_addr_t get_rx_hints(size_t) { return uhd::device_addr_t(); }
 
+    /*! Take a transport with a matching configuration out of the cache.
+     *
+     * Streamers park their transports (including buffer pools and socket
+     * state) in the cache when they are destroyed, so re-creating a
+     * streamer with the same args reuses them instead of reallocating.
+     * \param key the configuration key the transport was cached under
+     * \return the cached transport, or an empty one when there is no match
+     */
+    uhd::both_xports_t get_cached_transport(const std::string &key);
+
+    /*! Park a transport in the cache for reuse by an identical streamer.
+     *
+     * The cache is bounded; when it is full the transport is dropped and
+     * simply freed as before.
+     */
+    void cache_transport(const std::string &key, const uhd::both_xports_t &xport);
+
     //! Is called after a streamer is generated
     virtual void post_streamer_hooks(uhd::direction_t) {}
 
@@ -247,8 +379,18 @@ private:
     //! Buffer for async metadata
     boost::shared_ptr<async_md_type> _async_md;
 
+    //! Shared TX pacer: streamers created with pacing=1 draw their
+    //! wire bytes from this common token-bucket link budget
+    uhd::transport::sph::send_pacer::sptr _tx_pacer;
+
     //! This mutex locks the get_xx_stream() functions.
     boost::mutex _transport_setup_mutex;
+
+    //! Transports parked by destroyed streamers, keyed by configuration
+    std::multimap<std::string, uhd::both_xports_t> _xport_cache;
+
+    //! This mutex locks the transport cache (streamers die on any thread)
+    boost::mutex _xport_cache_mutex;
 };
 
 }} /* namespace uhd::usrp */
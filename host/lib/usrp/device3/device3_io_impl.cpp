@@ -13,13 +13,19 @@
 #include <uhd/rfnoc/sink_block_ctrl_base.hpp>
 #include <uhd/utils/byteswap.hpp>
 #include <uhd/utils/log.hpp>
+#include <uhd/utils/thread.hpp>
+#include <boost/algorithm/string.hpp>
 #include <uhd/rfnoc/rate_node_ctrl.hpp>
 #include <uhd/rfnoc/radio_ctrl.hpp>
+#include <uhd/rfnoc/dma_fifo_block_ctrl.hpp>
 #include <uhd/transport/zero_copy_flow_ctrl.hpp>
 #include <uhdlib/rfnoc/rx_stream_terminator.hpp>
 #include <uhdlib/rfnoc/tx_stream_terminator.hpp>
+#include <uhdlib/transport/lockfree_bounded_queue.hpp>
 #include <uhdlib/usrp/common/async_packet_handler.hpp>
+#include <uhdlib/utils/system_time.hpp>
 #include <boost/atomic.hpp>
+#include <chrono>
 
 #define UHD_TX_STREAMER_LOG() UHD_LOGGER_TRACE("STREAMER")
 #define UHD_RX_STREAMER_LOG() UHD_LOGGER_TRACE("STREAMER")
@@ -41,6 +47,76 @@ static uhd::stream_args_t sanitize_stream_args(const uhd::stream_args_t &args_)
     return args;
 }
 
+/*!
+ * Apply a named stream profile to the transport hints.
+ *
+ * The profile stream arg ties together knobs that otherwise live in
+ * different places (device args, prefs, environment) and are easy to
+ * misconfigure as a set:
+ *
+ * - "latency" busy-polls in the kernel and in the transport wait
+ *   (busy_poll/spin_wait), disables syscall batching so no packet
+ *   waits for its peers, and boosts the calling thread to realtime
+ *   priority (the thread that builds the streamer is assumed to be
+ *   the streaming thread).
+ * - "throughput" sizes the syscall batches up and leaves the wait
+ *   strategy blocking.
+ *
+ * Individual knobs given explicitly -- in the stream args or in the
+ * device args -- always win over the profile defaults. The optional
+ * cpu_affinity stream arg (comma-separated CPU list) pins the calling
+ * thread regardless of profile.
+ */
+static void apply_stream_profile(
+    const uhd::device_addr_t &stream_args,
+    uhd::device_addr_t &hints
+){
+    //pass explicitly given transport knobs through to the hints
+    static const char *knobs[] = {
+        "spin_wait", "busy_poll", "recv_batch_size", "send_batch_size"
+    };
+    for (const char *knob : knobs){
+        if (stream_args.has_key(knob)) hints[knob] = stream_args[knob];
+    }
+
+    if (stream_args.has_key("cpu_affinity")){
+        std::vector<std::string> cpu_strs;
+        boost::split(cpu_strs, stream_args["cpu_affinity"], boost::is_any_of(","), boost::token_compress_on);
+        std::vector<size_t> cpus;
+        for (const std::string &cpu_str : cpu_strs){
+            if (not cpu_str.empty()) cpus.push_back(boost::lexical_cast<size_t>(cpu_str));
+        }
+        uhd::set_thread_affinity(cpus);
+    }
+
+    const std::string profile = stream_args.get("profile", hints.get("profile", ""));
+    if (profile.empty()) return;
+
+    std::vector<std::pair<std::string, std::string>> defaults;
+    if (profile == "latency"){
+        defaults = {
+            {"spin_wait", "50"},
+            {"busy_poll", "50"},
+            {"recv_batch_size", "1"},
+            {"send_batch_size", "1"},
+        };
+        uhd::set_thread_priority_safe(uhd::default_thread_priority, true);
+    }
+    else if (profile == "throughput"){
+        defaults = {
+            {"recv_batch_size", "16"},
+            {"send_batch_size", "16"},
+        };
+    }
+    else {
+        throw uhd::value_error("unknown stream profile: " + profile);
+    }
+
+    for (const auto &kv : defaults){
+        if (not hints.has_key(kv.first)) hints[kv.first] = kv.second;
+    }
+}
+
 static void check_stream_sig_compatible(const rfnoc::stream_sig_t &stream_sig, stream_args_t &args, const std::string &tx_rx)
 {
     if (args.otw_format.empty()) {
@@ -137,17 +213,37 @@ void generate_channel_list(
  * RX Flow Control Functions
  **********************************************************************/
 //! Stores the state of RX flow control
-struct rx_fc_cache_t
+//
+// One cache per channel, hammered from that channel's recv path; aligned
+// to the cache line size so neighbouring allocations cannot false-share.
+struct UHD_ALIGNED(64) rx_fc_cache_t
 {
     rx_fc_cache_t():
         interval(0),
         last_byte_count(0),
         total_bytes_consumed(0),
         total_packets_consumed(0),
-        seq_num(0) {}
+        seq_num(0),
+        window(0),
+        min_interval(0),
+        adaptive(false),
+        rate_ewma(0.0),
+        rtt_ewma(0.0) {}
 
     //! Flow control interval in bytes
     size_t interval;
+    //! Full flow control window in bytes (upper bound for the interval)
+    size_t window;
+    //! Smallest interval the tuner may fall back to
+    size_t min_interval;
+    //! Retune the interval from measured ACK round-trips
+    bool adaptive;
+    //! Estimated consumption rate in bytes per second
+    double rate_ewma;
+    //! Estimated flow control ACK round-trip in seconds
+    double rtt_ewma;
+    //! Time the last flow control packet went out
+    time_spec_t last_fc_send_time;
     //! Byte count at last flow control packet
     uint32_t last_byte_count;
     //! This will wrap around, but that's OK, because math.
@@ -291,12 +387,60 @@ static bool rx_flow_ctrl(
     //send the buffer over the interface
     fc_buff->commit(sizeof(uint32_t)*(packet_info.num_packet_words32));
 
+    // Measure the consumption rate between flow control packets for
+    // the interval tuner (see tune_rx_fc_interval)
+    if (fc_cache->adaptive)
+    {
+        const time_spec_t now = uhd::get_system_time();
+        if (fc_cache->last_fc_send_time != time_spec_t(0.0))
+        {
+            const double elapsed = (now - fc_cache->last_fc_send_time).get_real_secs();
+            if (elapsed > 0.0)
+            {
+                const double rate =
+                    (fc_cache->total_bytes_consumed - fc_cache->last_byte_count)/elapsed;
+                fc_cache->rate_ewma = (fc_cache->rate_ewma == 0.0) ? rate :
+                    0.875*fc_cache->rate_ewma + 0.125*rate;
+            }
+        }
+        fc_cache->last_fc_send_time = now;
+    }
+
     //update byte count
     fc_cache->last_byte_count = fc_cache->total_bytes_consumed;
 
     return true;
 }
 
+/*! Adapt the RX flow control update interval to the measured ACK round-trip.
+ *
+ * The source stalls when the un-acked bytes reach the window, so an
+ * update has to arrive before the remainder of the window is consumed.
+ * During one round-trip, rate*rtt bytes are in flight; the interval is
+ * therefore sized to half the window minus the in-flight bytes. Short
+ * round-trips (direct attach) stretch the interval to cut update packet
+ * overhead, long round-trips (e.g. 10GbE through a switch) shrink it
+ * back down towards the configured minimum.
+ */
+static void tune_rx_fc_interval(
+    boost::shared_ptr<rx_fc_cache_t> fc_cache
+) {
+    if (not fc_cache->adaptive) return;
+    if (fc_cache->last_fc_send_time == time_spec_t(0.0)) return;
+
+    const double rtt = (uhd::get_system_time() - fc_cache->last_fc_send_time).get_real_secs();
+    if (rtt <= 0.0) return;
+    fc_cache->rtt_ewma = (fc_cache->rtt_ewma == 0.0) ? rtt :
+        0.875*fc_cache->rtt_ewma + 0.125*rtt;
+
+    const double bytes_per_rtt = fc_cache->rate_ewma * fc_cache->rtt_ewma;
+    const double target = fc_cache->window/2.0 - bytes_per_rtt;
+    fc_cache->interval = size_t(std::max(
+        double(fc_cache->min_interval),
+        std::min(target, fc_cache->window/2.0)
+    ));
+}
+
 /*! Handle RX flow control ACK packets.
  *
  */
@@ -318,6 +462,9 @@ static void handle_rx_flowctrl_ack(
     fc_cache->total_bytes_consumed = byte_count;
     fc_cache->total_packets_consumed = pkt_count; // guess we need a pkt offset too?
 
+    // Measure the ACK round-trip and retune the update interval
+    tune_rx_fc_interval(fc_cache);
+
     // This will send a flow control packet if there is a significant discrepancy
     rx_flow_ctrl(fc_cache, nullptr);
 }
@@ -328,7 +475,10 @@ static void handle_rx_flowctrl_ack(
 #define DEVICE3_ASYNC_EVENT_CODE_FLOW_CTRL 0
 
 //! Stores the state of TX flow control
-struct tx_fc_cache_t
+//
+// One cache per channel, updated on every packet sent and on every ACK
+// received; aligned to the cache line size like its RX counterpart.
+struct UHD_ALIGNED(64) tx_fc_cache_t
 {
     tx_fc_cache_t(uint32_t capacity):
         last_byte_ack(0),
@@ -337,7 +487,9 @@ struct tx_fc_cache_t
         pkt_count(0),
         window_size(capacity),
         fc_ack_seqnum(0),
-        fc_received(false) {}
+        fc_received(false),
+        credit_rate(0.0),
+        ack_time_valid(false) {}
 
     uint32_t last_byte_ack;
     uint32_t last_seq_ack;
@@ -346,12 +498,88 @@ struct tx_fc_cache_t
     uint32_t window_size;
     uint32_t fc_ack_seqnum;
     bool fc_received;
+    //! Downstream consumption rate in bytes per second (0.0 disables
+    //  credit extrapolation). The radio drains at exactly the sample
+    //  rate, so credits can be replenished on schedule between updates.
+    double credit_rate;
+    //! True once last_ack_time holds the arrival time of a real update
+    bool ack_time_valid;
+    //! When the credit state in last_byte_ack was actually measured
+    std::chrono::steady_clock::time_point last_ack_time;
     std::function<uint32_t(uint32_t)> to_host;
     std::function<uint32_t(uint32_t)> from_host;
     std::function<void(const uint32_t *packet_buff, vrt::if_packet_info_t &)> unpack;
     std::function<void(uint32_t *packet_buff, vrt::if_packet_info_t &)> pack;
 };
 
+/*! Apply the credit state carried by one flow control message.
+ */
+static void tx_flow_ctrl_apply(
+    boost::shared_ptr<tx_fc_cache_t> fc_cache,
+    managed_recv_buffer::sptr fc_buff
+) {
+    vrt::if_packet_info_t if_packet_info;
+    if_packet_info.num_packet_words32 = fc_buff->size()/sizeof(uint32_t);
+    const uint32_t *packet_buff = fc_buff->cast<const uint32_t *>();
+    try {
+        fc_cache->unpack(packet_buff, if_packet_info);
+    }
+    catch(const std::exception &ex)
+    {
+        UHD_LOGGER_ERROR("TX FLOW CTRL") << "Error unpacking flow control packet: " << ex.what() << std::endl;
+        return;
+    }
+
+    if (if_packet_info.packet_type != vrt::if_packet_info_t::PACKET_TYPE_FC)
+    {
+        UHD_LOGGER_ERROR("TX FLOW CTRL") << "Unexpected packet received by flow control handler: " << if_packet_info.packet_type << std::endl;
+        return;
+    }
+
+    const uint32_t *payload = &packet_buff[if_packet_info.num_header_words32];
+    const uint32_t pkt_count = fc_cache->to_host(payload[0]);
+    const uint32_t byte_count = fc_cache->to_host(payload[1]);
+
+    // update the amount of space
+    fc_cache->last_byte_ack = byte_count;
+    fc_cache->last_seq_ack = pkt_count;
+
+    // A real count resets the extrapolation base: any credits guessed
+    // since the previous update are reconciled against the truth here.
+    fc_cache->last_ack_time = std::chrono::steady_clock::now();
+    fc_cache->ack_time_valid = true;
+
+    fc_cache->fc_received = true;
+}
+
+/*! Estimate how many bytes the downstream consumer drained since the
+ *  last real flow control update.
+ *
+ * With a known consumption rate the credit window can advance on
+ * schedule instead of stalling for a full round trip every update
+ * window. The estimate is capped at the bytes actually in flight: the
+ * consumer cannot have drained data that was never sent, so even a
+ * wildly late update can never let the window overrun the downstream
+ * buffer by more than the (exact) amount we put into it.
+ */
+static uint32_t tx_flow_ctrl_extrapolate(
+    boost::shared_ptr<tx_fc_cache_t> fc_cache
+) {
+    if (fc_cache->credit_rate <= 0.0 or not fc_cache->ack_time_valid)
+    {
+        return 0;
+    }
+    const double elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - fc_cache->last_ack_time).count();
+    const double drained = elapsed * fc_cache->credit_rate;
+    const uint32_t in_flight = fc_cache->byte_count - fc_cache->last_byte_ack;
+    if (drained >= double(in_flight))
+    {
+        return in_flight;
+    }
+    return uint32_t(drained);
+}
+
 static bool tx_flow_ctrl(
     boost::shared_ptr<tx_fc_cache_t> fc_cache,
     zero_copy_if::sptr xport,
@@ -359,8 +587,22 @@ static bool tx_flow_ctrl(
 ) {
     while (true)
     {
-        // If there is space
-        if (fc_cache->window_size - (fc_cache->byte_count - fc_cache->last_byte_ack) >= buff->size())
+        // Drain every flow control message already queued on the return
+        // path in one sweep. Under load many updates pile up between
+        // sends; each one only supersedes the last, so applying them
+        // all here leaves the latest credit state and keeps the
+        // messages from hogging transport frames until the window
+        // blocks.
+        while (managed_recv_buffer::sptr fc_buff = xport->get_recv_buff(0.0))
+        {
+            tx_flow_ctrl_apply(fc_cache, fc_buff);
+        }
+
+        // If there is space (counting credits extrapolated from the
+        // consumption rate since the last real update, if enabled)
+        const uint32_t outstanding = fc_cache->byte_count - fc_cache->last_byte_ack
+            - tx_flow_ctrl_extrapolate(fc_cache);
+        if (fc_cache->window_size - outstanding >= buff->size())
         {
             // All is good - packet will be sent
             fc_cache->byte_count += buff->size();
@@ -373,37 +615,20 @@ static bool tx_flow_ctrl(
             return true;
         }
 
-        // Look for a flow control message to update the space available in the buffer.
-        managed_recv_buffer::sptr buff = xport->get_recv_buff(0.1);
-        if (buff)
+        // Window full: block for the next flow control message. With
+        // extrapolation enabled, only wait about as long as it takes
+        // the consumer to drain one more packet - whichever comes
+        // first, a real update or the accrued credits, unblocks us.
+        double timeout = 0.1;
+        if (fc_cache->credit_rate > 0.0 and fc_cache->ack_time_valid)
         {
-            vrt::if_packet_info_t if_packet_info;
-            if_packet_info.num_packet_words32 = buff->size()/sizeof(uint32_t);
-            const uint32_t *packet_buff = buff->cast<const uint32_t *>();
-            try {
-                fc_cache->unpack(packet_buff, if_packet_info);
-            }
-            catch(const std::exception &ex)
-            {
-                UHD_LOGGER_ERROR("TX FLOW CTRL") << "Error unpacking flow control packet: " << ex.what() << std::endl;
-                continue;
-            }
-
-            if (if_packet_info.packet_type != vrt::if_packet_info_t::PACKET_TYPE_FC)
-            {
-                UHD_LOGGER_ERROR("TX FLOW CTRL") << "Unexpected packet received by flow control handler: " << if_packet_info.packet_type << std::endl;
-                continue;
-            }
-
-            const uint32_t *payload = &packet_buff[if_packet_info.num_header_words32];
-            const uint32_t pkt_count = fc_cache->to_host(payload[0]);
-            const uint32_t byte_count = fc_cache->to_host(payload[1]);
-
-            // update the amount of space
-            fc_cache->last_byte_ack = byte_count;
-            fc_cache->last_seq_ack = pkt_count;
-
-            fc_cache->fc_received = true;
+            timeout = std::min(timeout, std::max(
+                double(buff->size()) / fc_cache->credit_rate, 100e-6));
+        }
+        managed_recv_buffer::sptr fc_buff = xport->get_recv_buff(timeout);
+        if (fc_buff)
+        {
+            tx_flow_ctrl_apply(fc_cache, fc_buff);
         }
     }
     return false;
@@ -474,12 +699,21 @@ static void tx_flow_ctrl_ack(
 /***********************************************************************
  * TX Async Message Functions
  **********************************************************************/
+//! Per-streamer queue for TX async metadata.
+// The producers are the async message tasks (one per channel), so the
+// push must be lock-free: a burst of underflow messages then cannot
+// stall behind a contended lock, and the TX thread's recv_async_msg
+// poll is a single atomic load when the queue is empty.
+typedef lockfree_bounded_queue<async_metadata_t> async_md_ring_type;
+
 struct async_tx_info_t
 {
     size_t stream_channel;
     size_t device_channel;
-    boost::shared_ptr<device3_impl::async_md_type> async_queue;
+    boost::shared_ptr<async_md_ring_type> async_queue;
     boost::shared_ptr<device3_impl::async_md_type> old_async_queue;
+    //! streamer's device-event counter block for the stats API
+    boost::shared_ptr<sph::send_packet_handler::async_event_counters_type> event_counters;
 };
 
 /*! Handle incoming messages.
@@ -532,6 +766,27 @@ static void handle_tx_async_msgs(
             async_info->stream_channel
     );
 
+    //aggregate device-side events for the stats API before queueing:
+    //these counters let a monitor tell device-reported faults apart
+    //from host-side drops without draining the async queue
+    if (async_info->event_counters){
+        switch (metadata.event_code){
+        case async_metadata_t::EVENT_CODE_UNDERFLOW:
+        case async_metadata_t::EVENT_CODE_UNDERFLOW_IN_PACKET:
+            async_info->event_counters->num_underruns.fetch_add(1, std::memory_order_relaxed);
+            break;
+        case async_metadata_t::EVENT_CODE_SEQ_ERROR:
+        case async_metadata_t::EVENT_CODE_SEQ_ERROR_IN_BURST:
+            async_info->event_counters->num_seq_errors.fetch_add(1, std::memory_order_relaxed);
+            break;
+        case async_metadata_t::EVENT_CODE_TIME_ERROR:
+            async_info->event_counters->num_time_errors.fetch_add(1, std::memory_order_relaxed);
+            break;
+        default:
+            break;
+        }
+    }
+
 	// Filter out any flow control messages and cache the rest
     if (metadata.event_code == DEVICE3_ASYNC_EVENT_CODE_FLOW_CTRL)
     {
@@ -583,6 +838,34 @@ void device3_impl::update_rx_streamers(double /* rate */)
     }
 }
 
+/***********************************************************************
+ * Transport cache for fast streamer re-creation
+ **********************************************************************/
+//! Bound on parked transports; beyond it they are freed as before
+static const size_t XPORT_CACHE_MAX_SIZE = 16;
+
+uhd::both_xports_t device3_impl::get_cached_transport(const std::string &key)
+{
+    boost::mutex::scoped_lock lock(_xport_cache_mutex);
+    std::multimap<std::string, uhd::both_xports_t>::iterator it = _xport_cache.find(key);
+    if (it == _xport_cache.end()) {
+        return uhd::both_xports_t();
+    }
+    uhd::both_xports_t xport = it->second;
+    _xport_cache.erase(it);
+    UHD_LOGGER_DEBUG("STREAMER") << "Reusing cached transport for " << key;
+    return xport;
+}
+
+void device3_impl::cache_transport(const std::string &key, const uhd::both_xports_t &xport)
+{
+    boost::mutex::scoped_lock lock(_xport_cache_mutex);
+    if (_xport_cache.size() >= XPORT_CACHE_MAX_SIZE) {
+        return; //cache full, let the transport be freed
+    }
+    _xport_cache.insert(std::make_pair(key, xport));
+}
+
 rx_streamer::sptr device3_impl::get_rx_stream(const stream_args_t &args_)
 {
     boost::mutex::scoped_lock lock(_transport_setup_mutex);
@@ -631,11 +914,20 @@ rx_streamer::sptr device3_impl::get_rx_stream(const stream_args_t &args_)
 
         // Setup the DSP transport hints
         device_addr_t rx_hints = get_rx_hints(mb_index);
+        apply_stream_profile(args.args, rx_hints);
 
-        //allocate sid and create transport
+        //allocate sid and create transport, reusing a parked one when
+        //an identical streamer was destroyed earlier (cheap retarget)
         uhd::sid_t stream_address = blk_ctrl->get_address(block_port);
         UHD_RX_STREAMER_LOG() << "creating rx stream " << rx_hints.to_string() ;
-        both_xports_t xport = make_transport(stream_address, RX_DATA, rx_hints);
+        const bool recycle = args.args.cast<size_t>("recycle", 1) != 0;
+        const std::string xport_cache_key = str(boost::format("%08x/RX_DATA/%s")
+            % stream_address.get() % rx_hints.to_string());
+        both_xports_t xport = recycle?
+            get_cached_transport(xport_cache_key) : both_xports_t();
+        if (not xport.recv) {
+            xport = make_transport(stream_address, RX_DATA, rx_hints);
+        }
         UHD_RX_STREAMER_LOG() << std::hex << "data_sid = " << xport.send_sid << std::dec << " actual recv_buff_size = " << xport.recv_buff_size;
 
         // Configure the block
@@ -656,7 +948,13 @@ rx_streamer::sptr device3_impl::get_rx_stream(const stream_args_t &args_)
         boost::shared_ptr<rx_fc_cache_t> fc_cache(new rx_fc_cache_t());
         fc_cache->sid = xport.send_sid;
         fc_cache->xport = xport.send;
-        fc_cache->interval = fc_handle_window;
+        fc_cache->interval = rx_hints.cast<size_t>("fc_update_interval", fc_handle_window);
+        fc_cache->window = fc_window;
+        fc_cache->min_interval = fc_cache->interval;
+        // The update interval adapts to the measured ACK round-trip
+        // unless the user pinned it with fc_update_interval
+        fc_cache->adaptive = (rx_hints.cast<size_t>("fc_adaptive", 1) != 0)
+            and not rx_hints.has_key("fc_update_interval");
         if (xport.endianness == ENDIANNESS_BIG)
         {
             fc_cache->to_host = uhd::ntohx<uint32_t>;
@@ -671,6 +969,11 @@ rx_streamer::sptr device3_impl::get_rx_stream(const stream_args_t &args_)
             fc_cache->pack = vrt::chdr::if_hdr_pack_le;
             fc_cache->unpack = vrt::chdr::if_hdr_unpack_le;
         }
+        //park the transport as it is before the flow control wrapper:
+        //a recycled transport gets a fresh wrapper (and fc_cache) on
+        //reuse, so counters from the previous session cannot leak past
+        //SR_CLEAR_TX_FC and wrappers do not nest per recycle generation
+        const both_xports_t recycle_xport = xport;
         xport.recv = zero_copy_flow_ctrl::make
         (
             xport.recv,
@@ -720,25 +1023,63 @@ rx_streamer::sptr device3_impl::get_rx_stream(const stream_args_t &args_)
                     recv_terminator,
                     xport);
             my_streamer->resize(chan_list.size());
+            //runtime spp changes may go up to the frame-derived maximum,
+            //not just the (possibly smaller) creation-time spp
+            my_streamer->set_spp_limit(bpp/bpi);
+        }
+
+        //park this channel's transport in the cache when the streamer dies
+        if (recycle) {
+            my_streamer->add_recycle_xport(xport_cache_key, recycle_xport);
         }
 
         //init some streamer stuff
         std::string conv_endianness;
         if (xport.endianness == ENDIANNESS_BIG) {
-            my_streamer->set_vrt_unpacker(&vrt::chdr::if_hdr_unpack_be);
+            my_streamer->set_vrt_unpacker_nothrow(&vrt::chdr::if_hdr_unpack_be_nothrow);
             conv_endianness = "be";
         } else {
-            my_streamer->set_vrt_unpacker(&vrt::chdr::if_hdr_unpack_le);
+            my_streamer->set_vrt_unpacker_nothrow(&vrt::chdr::if_hdr_unpack_le_nothrow);
             conv_endianness = "le";
         }
 
+        //trusted_link=1 drops the per-packet length cross-checks once
+        //the stream has proven itself under full validation
+        if (args.args.cast<size_t>("trusted_link", 0) != 0) {
+            my_streamer->set_vrt_unpacker_trusted(
+                (xport.endianness == ENDIANNESS_BIG)?
+                &vrt::chdr::if_hdr_unpack_be_trusted :
+                &vrt::chdr::if_hdr_unpack_le_trusted
+            );
+        }
+
+        //history_secs=N keeps a rolling copy of the last N seconds of
+        //received samples for retroactive reads after a trigger
+        const double history_secs = args.args.cast<double>("history_secs", 0.0);
+        if (history_secs > 0.0) {
+            my_streamer->enable_history(history_secs);
+        }
+
         //set the converter
         uhd::convert::id_type id;
         id.input_format = args.otw_format + "_item32_" + conv_endianness;
         id.num_inputs = 1;
         id.output_format = args.cpu_format;
         id.num_outputs = 1;
-        my_streamer->set_converter(id);
+        //with converter_prio=N the routine registered under priority N
+        //is forced for A/B testing (overrides the convenience args);
+        //with streaming_stores=1 the converter writes around the cache,
+        //for channel-major blocks much larger than the LLC;
+        //with dither=1 it fuses half an LSB of dither into the
+        //dequantization (takes precedence over streaming_stores)
+        my_streamer->set_converter(id,
+            args.args.cast<size_t>("num_conv_threads", 1),
+            args.args.has_key("converter_prio")?
+                uhd::convert::priority_type(args.args.cast<int>("converter_prio", -1)) :
+            (args.args.cast<size_t>("dither", 0) != 0)?
+                uhd::convert::PRIORITY_DITHERED :
+            (args.args.cast<size_t>("streaming_stores", 0) != 0)?
+                uhd::convert::PRIORITY_NONTEMPORAL : -1);
 
         // Give the streamer a functor to handle flow control ACK messages
         my_streamer->set_xport_handle_flowctrl_ack(
@@ -760,6 +1101,24 @@ rx_streamer::sptr device3_impl::get_rx_stream(const stream_args_t &args_)
             true /*flush*/
         );
 
+        //Expose the transport descriptor for caller-driven polling
+        my_streamer->set_xport_chan_recv_fd(
+            stream_i,
+            xport.recv->get_recv_fd()
+        );
+
+        //Optionally tolerate slight packet reordering on aggregated links
+        my_streamer->set_xport_chan_reorder_window(
+            stream_i,
+            args.args.cast<size_t>("reorder_window", 0)
+        );
+
+        //Optionally record recent packet headers for drop forensics
+        my_streamer->set_xport_chan_capture_ring(
+            stream_i,
+            args.args.cast<size_t>("capture_ring", 0)
+        );
+
         //Give the streamer a functor to handle overruns
         //bind requires a weak_ptr to break the a streamer->streamer circular dependency
         //Using "this" is OK because we know that this device3_impl will outlive the streamer
@@ -780,6 +1139,107 @@ rx_streamer::sptr device3_impl::get_rx_stream(const stream_args_t &args_)
                 blk_ctrl->issue_stream_cmd(stream_cmd, block_port);
             }
         );
+
+        //Give the streamer a functor to re-program the radio's packet
+        //size, so latency/throughput modes can be switched at runtime
+        //without tearing the streamer down
+        if (not upstream_radio_nodes.empty()) {
+            my_streamer->set_update_spp_fcn(
+                stream_i,
+                [upstream_radio_nodes](const size_t spp) {
+                    for (const auto &node : upstream_radio_nodes) {
+                        node->set_arg<int>("spp", int(spp));
+                    }
+                }
+            );
+        }
+
+        //Give the streamer a functor to rebuild this channel's transport
+        //after a link failure (see rx_streamer::reconnect). Capturing
+        //"this" is OK because this device3_impl outlives the streamer.
+        my_streamer->add_reconnect_fn(
+            [this, stream_address, rx_hints, blk_ctrl, block_port,
+             fc_cache, upstream_radio_nodes, weak_ptr, stream_i,
+             xport_cache_key, recycle]() {
+                auto streamer =
+                    boost::dynamic_pointer_cast<device3_recv_packet_streamer>(
+                        weak_ptr.lock());
+                if (not streamer) return;
+
+                //fresh sockets: the dead transport keeps its claimed
+                //buffers until the handler lets go of them below
+                both_xports_t new_xport =
+                    make_transport(stream_address, RX_DATA, rx_hints);
+
+                //re-derive the flow control window for the new socket
+                const size_t pkt_size = new_xport.recv->get_recv_frame_size();
+                const size_t fc_window = get_rx_flow_control_window(
+                    pkt_size, new_xport.recv_buff_size, rx_hints) - pkt_size;
+                blk_ctrl->configure_flow_control_out(
+                    true,
+                    fc_window,
+                    rx_hints.cast<size_t>("recv_pkt_limit", 0),
+                    block_port
+                );
+
+                //restart the flow control conversation from zero on the
+                //new return path
+                fc_cache->sid = new_xport.send_sid;
+                fc_cache->xport = new_xport.send;
+                fc_cache->window = fc_window;
+                fc_cache->last_byte_count = 0;
+                fc_cache->total_bytes_consumed = 0;
+                fc_cache->total_packets_consumed = 0;
+                fc_cache->seq_num = 0;
+                fc_cache->last_fc_send_time = time_spec_t(0.0);
+                new_xport.recv = zero_copy_flow_ctrl::make(
+                    new_xport.recv,
+                    NULL,
+                    [fc_cache](managed_buffer::sptr buff) {
+                        return rx_flow_ctrl(fc_cache, buff);
+                    }
+                );
+
+                //re-point the data and response routes at the new socket
+                //(the FC clear also resets the source's sequence counter)
+                blk_ctrl->sr_write(uhd::rfnoc::SR_CLEAR_TX_FC, 0x1, block_port);
+                blk_ctrl->sr_write(uhd::rfnoc::SR_CLEAR_TX_FC, 0x0, block_port);
+                blk_ctrl->set_destination(new_xport.send_sid.get_src(), block_port);
+                blk_ctrl->sr_write(uhd::rfnoc::SR_RESP_OUT_DST_SID,
+                    new_xport.send_sid.get_src(), block_port);
+                for (const auto &node : upstream_radio_nodes) {
+                    node->sr_write(uhd::rfnoc::SR_RESP_OUT_DST_SID,
+                        new_xport.send_sid.get_src(), block_port);
+                }
+
+                //swap the dead transport out from under the handler
+                streamer->set_xport_chan_get_buff(
+                    stream_i,
+                    [new_xport](double timeout) {
+                        return new_xport.recv->get_recv_buff(timeout);
+                    },
+                    true /*flush*/
+                );
+                streamer->set_xport_chan_recv_fd(
+                    stream_i, new_xport.recv->get_recv_fd());
+
+                //the parked transport is dead now - never recycle it
+                streamer->remove_recycle_xport(xport_cache_key);
+                if (recycle) {
+                    streamer->add_recycle_xport(xport_cache_key, new_xport);
+                }
+                UHD_RX_STREAMER_LOG() << std::hex << "reconnected, new data_sid = "
+                    << new_xport.send_sid << std::dec;
+            }
+        );
+    }
+
+    //deadline_sched=1 puts the application's recv thread under a
+    //deadline CPU reservation derived from the rate, the packet size
+    //and the measured converter throughput (Linux only; anywhere else
+    //the first recv() warns once and continues unscheduled)
+    if (args.args.cast<size_t>("deadline_sched", 0) != 0) {
+        my_streamer->set_deadline_scheduling(true);
     }
 
     // Notify all blocks in this chain that they are connected to an active streamer
@@ -788,6 +1248,14 @@ rx_streamer::sptr device3_impl::get_rx_stream(const stream_args_t &args_)
     // Store a weak pointer to prevent a streamer->device3_impl->streamer circular dependency.
     // Note that we store the streamer only once, and use its terminator's
     // ID to do so.
+    //return transports to the device cache when the streamer is destroyed;
+    //capturing "this" is OK because this device3_impl outlives the streamer
+    my_streamer->set_recycle_fn(
+        [this](const std::string &key, const both_xports_t &xport) {
+            this->cache_transport(key, xport);
+        }
+    );
+
     _rx_streamers[recv_terminator->unique_id()] = boost::weak_ptr<uhd::rx_streamer>(my_streamer);
 
     // Sets tick rate, samp rate and scaling on this streamer.
@@ -840,7 +1308,7 @@ tx_streamer::sptr device3_impl::get_tx_stream(const uhd::stream_args_t &args_)
     // Note: All 'args.args' are merged into chan_args now.
 
     //shared async queue for all channels in streamer
-    boost::shared_ptr<async_md_type> async_md(new async_md_type(1000/*messages deep*/));
+    boost::shared_ptr<async_md_ring_type> async_md(new async_md_ring_type(1000/*messages deep*/));
 
     // II. Iterate over all channels
     boost::shared_ptr<device3_send_packet_streamer> my_streamer;
@@ -879,12 +1347,26 @@ tx_streamer::sptr device3_impl::get_tx_stream(const uhd::stream_args_t &args_)
 
         // Setup the dsp transport hints
         device_addr_t tx_hints = get_tx_hints(mb_index);
+        apply_stream_profile(args.args, tx_hints);
         const size_t fifo_size = blk_ctrl->get_fifo_size(block_port);
         // Allocate sid and create transport
         uhd::sid_t stream_address = blk_ctrl->get_address(block_port);
         UHD_TX_STREAMER_LOG() << "creating tx stream " << tx_hints.to_string() ;
-        both_xports_t xport = make_transport(stream_address, TX_DATA, tx_hints);
-        both_xports_t async_xport = make_transport(stream_address, ASYNC_MSG, device_addr_t(""));
+        const bool recycle = args.args.cast<size_t>("recycle", 1) != 0;
+        const std::string xport_cache_key = str(boost::format("%08x/TX_DATA/%s")
+            % stream_address.get() % tx_hints.to_string());
+        const std::string async_cache_key = str(boost::format("%08x/ASYNC_MSG/")
+            % stream_address.get());
+        both_xports_t xport = recycle?
+            get_cached_transport(xport_cache_key) : both_xports_t();
+        if (not xport.send) {
+            xport = make_transport(stream_address, TX_DATA, tx_hints);
+        }
+        both_xports_t async_xport = recycle?
+            get_cached_transport(async_cache_key) : both_xports_t();
+        if (not async_xport.recv) {
+            async_xport = make_transport(stream_address, ASYNC_MSG, device_addr_t(""));
+        }
         UHD_TX_STREAMER_LOG() << std::hex << "data_sid = " << xport.send_sid << std::dec ;
 
         // Configure flow control
@@ -913,6 +1395,11 @@ tx_streamer::sptr device3_impl::get_tx_stream(const uhd::stream_args_t &args_)
             fc_cache->pack = vrt::chdr::if_hdr_pack_le;
             fc_cache->unpack = vrt::chdr::if_hdr_unpack_le;
         }
+        //park the transport as it is before the flow control wrapper:
+        //a recycled transport gets a fresh wrapper (and fc_cache) on
+        //reuse, so the stale tx_flow_ctrl callback cannot compete with
+        //the new one for the same return path
+        const both_xports_t recycle_xport = xport;
         xport.send = zero_copy_flow_ctrl::make(
             xport.send,
             [fc_cache, xport](managed_buffer::sptr buff) {
@@ -977,13 +1464,25 @@ tx_streamer::sptr device3_impl::get_tx_stream(const uhd::stream_args_t &args_)
             my_streamer->resize(chan_list.size());
         }
 
+        //park this channel's transports in the cache when the streamer dies
+        if (recycle) {
+            my_streamer->add_recycle_xport(xport_cache_key, recycle_xport);
+            my_streamer->add_recycle_xport(async_cache_key, async_xport);
+        }
+
         //init some streamer stuff
         std::string conv_endianness;
         if (xport.endianness == ENDIANNESS_BIG) {
             my_streamer->set_vrt_packer(&vrt::chdr::if_hdr_pack_be);
+            my_streamer->set_vrt_packer_variants(
+                &vrt::chdr::if_hdr_pack_tmpl<true, false>,
+                &vrt::chdr::if_hdr_pack_tmpl<true, true>);
             conv_endianness = "be";
         } else {
             my_streamer->set_vrt_packer(&vrt::chdr::if_hdr_pack_le);
+            my_streamer->set_vrt_packer_variants(
+                &vrt::chdr::if_hdr_pack_tmpl<false, false>,
+                &vrt::chdr::if_hdr_pack_tmpl<false, true>);
             conv_endianness = "le";
         }
 
@@ -993,13 +1492,36 @@ tx_streamer::sptr device3_impl::get_tx_stream(const uhd::stream_args_t &args_)
         id.num_inputs = 1;
         id.output_format = args.otw_format + "_item32_" + conv_endianness;
         id.num_outputs = 1;
-        my_streamer->set_converter(id);
+        //with converter_prio=N the routine registered under priority N
+        //is forced for A/B testing
+        my_streamer->set_converter(id,
+            args.args.cast<size_t>("num_conv_threads", 1),
+            args.args.has_key("converter_prio")?
+                uhd::convert::priority_type(args.args.cast<int>("converter_prio", -1)) : -1);
+
+        // Opt-in: replenish flow control credits at the known radio
+        // consumption rate instead of waiting for every downstream
+        // update, which removes RTT-shaped stalls from the steady-state
+        // send path on links with round-trip spikes. The hook keeps the
+        // byte rate in step with rate changes; an undefined sample rate
+        // (the 1.0 placeholder) keeps extrapolation off.
+        if (args.args.cast<size_t>("fc_extrapolate", 0) != 0)
+        {
+            const size_t otw_bpi = convert::get_bytes_per_item(args.otw_format);
+            my_streamer->add_samp_rate_hook(
+                [fc_cache, otw_bpi](const double rate) {
+                    fc_cache->credit_rate =
+                        (rate > 1.0)? (rate * otw_bpi) : 0.0;
+                }
+            );
+        }
 
         boost::shared_ptr<async_tx_info_t> async_tx_info(new async_tx_info_t());
         async_tx_info->stream_channel = args.channels[stream_i];
         async_tx_info->device_channel = mb_index;
         async_tx_info->async_queue = async_md;
         async_tx_info->old_async_queue = _async_md;
+        async_tx_info->event_counters = my_streamer->get_async_event_counters();
 
         task::sptr async_task = task::make(
             [async_tx_info, async_xport, xport, send_terminator]() {
@@ -1021,6 +1543,38 @@ tx_streamer::sptr device3_impl::get_tx_stream(const uhd::stream_args_t &args_)
                 return xport.send->get_send_buff(timeout);
             }
         );
+        //Give the streamer a functor to flush batched sends
+        my_streamer->set_xport_chan_flush_send_cb(
+            stream_i,
+            [xport]() {
+                xport.send->flush_send_buffs();
+            }
+        );
+        //Give the streamer a functor to report how full the device-side
+        //buffer (e.g. the off-chip DMA FIFO) is, derived from the flow
+        //control state; lets applications verify pre-staged bursts
+        my_streamer->set_xport_chan_occupancy_fcn(
+            stream_i,
+            [fc_cache]() {
+                //unsigned arithmetic handles the counter wrap-around
+                const uint32_t in_flight =
+                    fc_cache->byte_count - fc_cache->last_byte_ack;
+                return double(in_flight) / double(fc_cache->window_size);
+            }
+        );
+        //When the sink block is the DMA FIFO, also surface the actual
+        //hardware fill level through the streamer stats
+        auto dma_fifo_ctrl =
+            boost::dynamic_pointer_cast<rfnoc::dma_fifo_block_ctrl>(blk_ctrl);
+        if (dma_fifo_ctrl) {
+            my_streamer->set_xport_chan_hw_occupancy_fcn(
+                stream_i,
+                [dma_fifo_ctrl, block_port]() {
+                    return uint64_t(dma_fifo_ctrl->get_bytes_occupied(block_port));
+                },
+                fifo_size
+            );
+        }
         //Give the streamer a functor handled received async messages
         my_streamer->set_async_receiver(
             [async_md](uhd::async_metadata_t& md, const double timeout) {
@@ -1039,7 +1593,88 @@ tx_streamer::sptr device3_impl::get_tx_stream(const uhd::stream_args_t &args_)
                     xport.send,
                     xport.send_sid
                 );
-            } 
+            }
+        );
+
+        //Give the streamer a functor to rebuild this channel's data
+        //transport after a link failure (see tx_streamer::reconnect).
+        //The async message transport is left alone: its device-side
+        //route is keyed on the control path and its socket is
+        //connectionless, so it resumes by itself once the link is back.
+        //Capturing "this" is OK because this device3_impl outlives the
+        //streamer.
+        boost::weak_ptr<uhd::tx_streamer> weak_streamer(my_streamer);
+        my_streamer->add_reconnect_fn(
+            [this, stream_address, tx_hints, blk_ctrl, block_port,
+             fc_cache, fifo_size, weak_streamer, stream_i,
+             xport_cache_key, recycle]() {
+                auto streamer =
+                    boost::dynamic_pointer_cast<device3_send_packet_streamer>(
+                        weak_streamer.lock());
+                if (not streamer) return;
+
+                both_xports_t new_xport =
+                    make_transport(stream_address, TX_DATA, tx_hints);
+
+                //restart the flow control conversation from zero; the
+                //FC clear empties the downstream accounting to match
+                blk_ctrl->sr_write(uhd::rfnoc::SR_CLEAR_RX_FC, 0x1, block_port);
+                blk_ctrl->sr_write(uhd::rfnoc::SR_CLEAR_RX_FC, 0x0, block_port);
+                const size_t fc_window = std::min(
+                    tx_hints.cast<size_t>("send_buff_size", fifo_size), fifo_size);
+                const size_t fc_handle_window = std::max<size_t>(
+                    1, fc_window / stream_options.tx_fc_response_freq);
+                blk_ctrl->configure_flow_control_in(
+                    fc_handle_window, block_port);
+                fc_cache->last_byte_ack = 0;
+                fc_cache->last_seq_ack = 0;
+                fc_cache->byte_count = 0;
+                fc_cache->pkt_count = 0;
+                fc_cache->window_size = fc_window;
+                fc_cache->fc_received = false;
+                fc_cache->ack_time_valid = false;
+                new_xport.send = zero_copy_flow_ctrl::make(
+                    new_xport.send,
+                    [fc_cache, new_xport](managed_buffer::sptr buff) {
+                        return tx_flow_ctrl(fc_cache, new_xport.recv, buff);
+                    },
+                    NULL
+                );
+
+                //swap the dead transport out from under the handler
+                streamer->set_xport_chan_get_buff(
+                    stream_i,
+                    [new_xport](const double timeout) {
+                        return new_xport.send->get_send_buff(timeout);
+                    }
+                );
+                streamer->set_xport_chan_flush_send_cb(
+                    stream_i,
+                    [new_xport]() {
+                        new_xport.send->flush_send_buffs();
+                    }
+                );
+                streamer->set_xport_chan_sid(
+                    stream_i, true, new_xport.send_sid);
+                streamer->set_xport_chan_post_send_cb(
+                    stream_i,
+                    [fc_cache, new_xport]() {
+                        tx_flow_ctrl_ack(
+                            fc_cache,
+                            new_xport.send,
+                            new_xport.send_sid
+                        );
+                    }
+                );
+
+                //the parked transport is dead now - never recycle it
+                streamer->remove_recycle_xport(xport_cache_key);
+                if (recycle) {
+                    streamer->add_recycle_xport(xport_cache_key, new_xport);
+                }
+                UHD_TX_STREAMER_LOG() << std::hex << "reconnected, new data_sid = "
+                    << new_xport.send_sid << std::dec;
+            }
         );
     }
 
@@ -1049,8 +1684,50 @@ tx_streamer::sptr device3_impl::get_tx_stream(const uhd::stream_args_t &args_)
     // Store a weak pointer to prevent a streamer->device3_impl->streamer circular dependency.
     // Note that we store the streamer only once, and use its terminator's
     // ID to do so.
+    //return transports to the device cache when the streamer is destroyed;
+    //capturing "this" is OK because this device3_impl outlives the streamer
+    my_streamer->set_recycle_fn(
+        [this](const std::string &key, const both_xports_t &xport) {
+            this->cache_transport(key, xport);
+        }
+    );
+
     _tx_streamers[send_terminator->unique_id()] = boost::weak_ptr<uhd::tx_streamer>(my_streamer);
 
+    // Opt-in: pace this streamer against the device's shared TX link
+    // budget so concurrent streamers cannot starve each other into
+    // underflows (see sph::send_pacer). Streams created with a lower
+    // pacing_priority are served first when the link saturates. The
+    // rate hook keeps the pacer's byte rate in step with rate changes;
+    // an undefined sample rate (the 1.0 placeholder) leaves that
+    // stream's private bucket off.
+    if (args.args.cast<size_t>("pacing", 0) != 0)
+    {
+        if (not _tx_pacer)
+        {
+            // The shared budget is the motherboard's advertised link
+            // maximum; without one only the per-stream buckets pace
+            double link_rate = 0.0;
+            const uhd::fs_path rate_path("/mboards/0/link_max_rate");
+            if (_tree->exists(rate_path)) {
+                link_rate = _tree->access<double>(rate_path).get();
+            }
+            _tx_pacer = boost::make_shared<sph::send_pacer>(link_rate);
+        }
+        const size_t pacer_stream = _tx_pacer->register_stream(
+            args.args.cast<size_t>("pacing_priority", 1));
+        my_streamer->set_pacer(_tx_pacer, pacer_stream);
+        const size_t otw_bpi = convert::get_bytes_per_item(args.otw_format);
+        const size_t nchans = chan_list.size();
+        const sph::send_pacer::sptr pacer = _tx_pacer;
+        my_streamer->add_samp_rate_hook(
+            [pacer, pacer_stream, otw_bpi, nchans](const double rate) {
+                pacer->set_stream_rate(pacer_stream,
+                    (rate > 1.0)? (rate * otw_bpi * nchans) : 0.0);
+            }
+        );
+    }
+
     // Sets tick rate, samp rate and scaling on this streamer
     // A registered terminator is required to do this.
     update_tx_streamers();
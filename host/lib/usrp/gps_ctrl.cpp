@@ -8,9 +8,12 @@
 #include <uhd/usrp/gps_ctrl.hpp>
 
 #include <uhd/utils/log.hpp>
+#include <uhd/utils/tasks.hpp>
 #include <uhd/exception.hpp>
 #include <uhd/types/sensors.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/thread/thread.hpp>
 #include <boost/tokenizer.hpp>
 #include <boost/format.hpp>
@@ -35,6 +38,7 @@ namespace {
     constexpr int GPS_LOCK_FRESHNESS        = 2500;
     constexpr int GPS_TIMEOUT_DELAY_MS      = 200;
     constexpr int GPSDO_COMMAND_DELAY_MS    = 200;
+    constexpr int GPS_REFRESH_INTERVAL_MS   = 10;
 }
 
 /*!
@@ -45,55 +49,50 @@ gps_ctrl::~gps_ctrl(void){
     /* NOP */
 }
 
+void gps_ctrl::subscribe_fix_callback(const fix_callback_type &){
+    // Implementations that do their own background polling override this;
+    // anything else has no event source to hook the callback into.
+    throw uhd::not_implemented_error(
+        "subscribe_fix_callback() is not supported by this GPS control");
+}
+
 class gps_ctrl_impl : public gps_ctrl{
 private:
-    std::map<std::string, boost::tuple<std::string, boost::system_time, bool> > sentences;
-    boost::mutex cache_mutex;
-    boost::system_time _last_cache_update;
+    //Sensor cache snapshot: sentence text and the time it was received.
+    //The background refresher owns the serial port and publishes a new
+    //snapshot by atomic shared_ptr exchange, so sensor queries read the
+    //last sample without taking a lock or touching the uart.
+    typedef std::map<std::string, boost::tuple<std::string, boost::system_time> > snapshot_type;
+    typedef boost::shared_ptr<const snapshot_type> snapshot_sptr;
+    snapshot_sptr _sentences;
+
+    boost::mutex _callback_mutex;
+    std::vector<fix_callback_type> _fix_callbacks;
 
     std::string get_sentence(const std::string which, const int max_age_ms, const int timeout, const bool wait_for_next = false)
     {
-        std::string sentence;
         boost::system_time now = boost::get_system_time();
-        boost::system_time exit_time = now + milliseconds(timeout);
-        boost::posix_time::time_duration age;
+        const boost::system_time exit_time = now + milliseconds(timeout);
+
+        //when waiting for the next sentence, anything published before
+        //this point in time counts as already seen
+        const boost::system_time seen_before = wait_for_next ?
+            now : boost::system_time(boost::posix_time::min_date_time);
 
-        if (wait_for_next)
-        {
-            boost::lock_guard<boost::mutex> lock(cache_mutex);
-            update_cache();
-            //mark sentence as touched
-            if (sentences.find(which) != sentences.end())
-                sentences[which].get<2>() = true;
-        }
         while (1)
         {
-            try
+            snapshot_sptr snapshot = boost::atomic_load(&_sentences);
+            snapshot_type::const_iterator it = snapshot->find(which);
+            if (it != snapshot->end())
             {
-                boost::lock_guard<boost::mutex> lock(cache_mutex);
-
-                // update cache if older than a millisecond
-                if (now - _last_cache_update > milliseconds(1))
-                {
-                    update_cache();
-                }
-
-                if (sentences.find(which) == sentences.end())
-                {
-                    age = milliseconds(max_age_ms);
-                } else {
-                    age = boost::get_system_time() - sentences[which].get<1>();
-                }
-                if (age < milliseconds(max_age_ms) and (not (wait_for_next and sentences[which].get<2>())))
+                const boost::system_time &time = it->second.get<1>();
+                if (now - time < milliseconds(max_age_ms) and time > seen_before)
                 {
-                    sentence = sentences[which].get<0>();
-                    sentences[which].get<2>() = true;
+                    return it->second.get<0>();
                 }
-            } catch(std::exception &e) {
-                UHD_LOGGER_DEBUG("GPS") << "get_sentence: " << e.what();
             }
 
-            if (not sentence.empty() or now > exit_time)
+            if (now > exit_time)
             {
                 break;
             }
@@ -102,12 +101,7 @@ private:
             now = boost::get_system_time();
         }
 
-        if (sentence.empty())
-        {
-            throw uhd::value_error("gps ctrl: No " + which + " message found");
-        }
-
-        return sentence;
+        throw uhd::value_error("gps ctrl: No " + which + " message found");
     }
 
     static bool is_nmea_checksum_ok(std::string nmea)
@@ -178,20 +172,54 @@ private:
 
     boost::system_time time = boost::get_system_time();
 
-    // Update sentences with newly read data
+    // Publish a new snapshot with the newly read data: readers keep the
+    // old snapshot alive until they drop it, so never modify one in place
+    boost::shared_ptr<snapshot_type> snapshot =
+        boost::make_shared<snapshot_type>(*boost::atomic_load(&_sentences));
+    bool fresh_fix = false;
     for(std::string key:  keys)
     {
         if (not msgs[key].empty())
         {
-            sentences[key] = boost::make_tuple(msgs[key], time, false);
+            (*snapshot)[key] = boost::make_tuple(msgs[key], time);
+            fresh_fix = fresh_fix or key != "SERVO";
         }
     }
+    boost::atomic_store(&_sentences, snapshot_sptr(snapshot));
 
-    _last_cache_update = time;
+    if (fresh_fix)
+    {
+        notify_fix_callbacks();
+    }
+  }
+
+  void notify_fix_callbacks(void) {
+    std::vector<fix_callback_type> callbacks;
+    {
+        boost::lock_guard<boost::mutex> lock(_callback_mutex);
+        callbacks = _fix_callbacks;
+    }
+    for(const fix_callback_type &callback:  callbacks)
+    {
+        try {
+            callback();
+        } catch(std::exception &e) {
+            UHD_LOGGER_ERROR("GPS") << "fix callback: " << e.what();
+        }
+    }
+  }
+
+  //background refresher: drain the uart and publish a new snapshot, then
+  //nap - the boost sleep is an interruption point, so destroying the task
+  //still shuts the thread down promptly
+  void refresh_task(void) {
+    update_cache();
+    boost::this_thread::sleep(milliseconds(GPS_REFRESH_INTERVAL_MS));
   }
 
 public:
   gps_ctrl_impl(uart_iface::sptr uart) :
+      _sentences(boost::make_shared<snapshot_type>()),
       _uart(uart),
       _gps_type(GPS_TYPE_NONE)
   {
@@ -255,8 +283,16 @@ public:
 
     }
 
-    // initialize cache
+    // initialize the cache, then hand the serial port off to the
+    // background refresher - from here on sensor queries are served from
+    // the published snapshots and never block on the uart
     update_cache();
+
+    if (gps_detected())
+    {
+        _refresh_task = task::make(
+            boost::bind(&gps_ctrl_impl::refresh_task, this), "gps_refresh");
+    }
   }
 
   ~gps_ctrl_impl(void){
@@ -300,6 +336,11 @@ public:
     }
   }
 
+  void subscribe_fix_callback(const fix_callback_type &callback) {
+      boost::lock_guard<boost::mutex> lock(_callback_mutex);
+      _fix_callbacks.push_back(callback);
+  }
+
 private:
   void init_gpsdo(void) {
       //issue some setup stuff so it spits out the appropriate data
@@ -419,6 +460,10 @@ private:
     GPS_TYPE_NONE
   } _gps_type;
 
+  //declared last so it is destroyed first: the polling thread must be
+  //gone before the uart and the callback list go away
+  task::sptr _refresh_task;
+
 };
 
 /***********************************************************************
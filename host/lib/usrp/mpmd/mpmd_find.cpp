@@ -141,6 +141,11 @@ device_addrs_t mpmd_find_with_addrs(const device_addrs_t& hints)
     UHD_LOG_TRACE("MPMD FIND", "Finding with addrs.");
     device_addrs_t found_devices;
     found_devices.reserve(hints.size());
+    // Probe all hints concurrently so they share one discovery deadline
+    std::vector<std::future<device_addrs_t>> task_list;
+    device_addrs_t probed_hints;
+    task_list.reserve(hints.size());
+    probed_hints.reserve(hints.size());
     for (const auto& hint : hints) {
         if (not (hint.has_key(xport::FIRST_ADDR_KEY) or
                  hint.has_key(xport::MGMT_ADDR_KEY))) {
@@ -150,7 +155,16 @@ device_addrs_t mpmd_find_with_addrs(const device_addrs_t& hints)
         }
         const std::string mgmt_addr =
             hint.get(xport::MGMT_ADDR_KEY, hint.get(xport::FIRST_ADDR_KEY, ""));
-        device_addrs_t reply_addrs = mpmd_find_with_addr(mgmt_addr, hint);
+        task_list.emplace_back(std::async(std::launch::async,
+            [mgmt_addr, hint](){
+                return mpmd_find_with_addr(mgmt_addr, hint);
+            }
+        ));
+        probed_hints.push_back(hint);
+    }
+    for (size_t task_idx = 0; task_idx < task_list.size(); task_idx++) {
+        const auto& hint = probed_hints[task_idx];
+        device_addrs_t reply_addrs = task_list[task_idx].get();
         if (reply_addrs.size() > 1) {
             UHD_LOG_ERROR("MPMD",
                 "Could not resolve device hint \"" << hint.to_string()
@@ -19,6 +19,8 @@
 #include <fstream>
 #include <iterator>
 #include <streambuf>
+#include <thread>
+#include <vector>
 
 using namespace uhd;
 
@@ -77,21 +79,15 @@ uhd::usrp::component_file_t generate_component(
 }
 
 /*
- * Function to be registered with uhd_image_loader
+ * Update a single device. Runs on its own thread when multiple devices are
+ * updated in one go.
  */
-static bool mpmd_image_loader(const image_loader::image_loader_args_t &image_loader_args){
-    // See if any MPM devices with the given args are found
-    device_addr_t find_hint = image_loader_args.args;
-    find_hint.set("find_all", "1"); // We need to find all devices
-    device_addrs_t devs = mpmd_find(find_hint);
-
-    if (devs.size() != 1) {
-        // TODO: Do we want to handle multiple devices here?
-        //       Or force uhd_image_loader to only feed us a single device?
-        return false;
-    }
-    // Grab the first device_addr and add the option to skip initialization
-    device_addr_t dev_addr(devs[0]);
+static void mpmd_update_device(
+    const device_addr_t &dev_addr_in,
+    const image_loader::image_loader_args_t &image_loader_args
+){
+    // Add the option to skip initialization
+    device_addr_t dev_addr(dev_addr_in);
     dev_addr["skip_init"] = "1";
     // Make the device
     uhd::device::sptr usrp = uhd::device::make(dev_addr, uhd::device::USRP);
@@ -178,6 +174,55 @@ static bool mpmd_image_loader(const image_loader::image_loader_args_t &image_loa
     UHD_LOG_INFO("MPMD IMAGE LOADER", "Starting update. This may take a while.");
     tree->access<uhd::usrp::component_files_t>("/mboards/0/components/fpga").set(all_component_files);
     UHD_LOG_INFO("MPMD IMAGE LOADER", "Update component function succeeded.");
+}
+
+/*
+ * Function to be registered with uhd_image_loader
+ */
+static bool mpmd_image_loader(const image_loader::image_loader_args_t &image_loader_args){
+    // See if any MPM devices with the given args are found
+    device_addr_t find_hint = image_loader_args.args;
+    find_hint.set("find_all", "1"); // We need to find all devices
+    device_addrs_t devs = mpmd_find(find_hint);
+
+    if (devs.empty()) {
+        return false;
+    }
+    if (devs.size() == 1) {
+        mpmd_update_device(devs[0], image_loader_args);
+        return true;
+    }
+
+    // Multiple devices matched the given args: update them concurrently.
+    // Each device gets its own session and RPC connection, so the updates
+    // proceed independently of each other.
+    std::vector<std::string> errors(devs.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < devs.size(); i++) {
+        threads.push_back(std::thread([i, &devs, &image_loader_args, &errors](){
+            try {
+                mpmd_update_device(devs[i], image_loader_args);
+            } catch (const std::exception &ex) {
+                errors[i] = ex.what();
+            }
+        }));
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    std::string error_msg;
+    for (size_t i = 0; i < devs.size(); i++) {
+        if (not errors[i].empty()) {
+            error_msg += str(boost::format("%s: %s\n")
+                             % devs[i].get("serial", devs[i].get("addr", ""))
+                             % errors[i]);
+        }
+    }
+    if (not error_msg.empty()) {
+        throw uhd::runtime_error(
+            "Update failed on the following devices:\n" + error_msg);
+    }
 
     return true;
 }
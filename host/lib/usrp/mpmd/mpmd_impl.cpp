@@ -15,7 +15,11 @@
 #include <uhd/usrp/mboard_eeprom.hpp>
 #include <uhdlib/rfnoc/rpc_block_ctrl.hpp>
 #include <uhdlib/rfnoc/radio_ctrl_impl.hpp>
+#include <uhdlib/utils/compat_cache.hpp>
+#include <uhdlib/utils/init_profiler.hpp>
+#include <uhd/version.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/format.hpp>
 #include <boost/asio.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/thread.hpp>
@@ -39,6 +43,8 @@ namespace {
     const double MPMD_CHDR_MAX_RTT = 0.02;
     //! MPM Compatibility number
     const std::vector<size_t> MPM_COMPAT_NUM = {1, 2};
+    //! How long a passed compat verification stays cached (seconds)
+    const double MPMD_COMPAT_CACHE_TTL = 24 * 3600;
 
     /*************************************************************************
      * Helper functions
@@ -182,13 +188,34 @@ mpmd_impl::mpmd_impl(const device_addr_t& device_args)
         << (serialize_init ? "serially " : "in parallel ")
         << "with args: " << device_args.to_string();
 
+    // If we don't force async, most compilers, at least now, will default to
+    // deferred.
+    const auto launch_policy = serialize_init ?
+        std::launch::deferred :
+        std::launch::async;
+
+    //time the init phases for cold-start regression hunting
+    uhd::init_profiler profiler("MPMD");
+
     // First, claim all the devices (so we own them and no one else can claim
     // them).
-    // This can be parallelized as long as uptrs are stored in the right spot;
-    // they need to be correctly indexed.
-    for (size_t mb_i = 0; mb_i < num_mboards; ++mb_i) {
-        UHD_LOG_DEBUG("MPMD", "Claiming mboard " << mb_i);
-        _mb.push_back(claim_and_make(mb_args[mb_i]));
+    // Each board has its own RPC connection, so the claims can run
+    // concurrently; the futures keep the uptrs correctly indexed.
+    profiler.enter_phase("claim");
+    {
+        std::vector<std::future<mpmd_mboard_impl::uptr>> claim_tasks;
+        claim_tasks.reserve(num_mboards);
+        for (size_t mb_i = 0; mb_i < num_mboards; ++mb_i) {
+            claim_tasks.emplace_back(std::async(launch_policy,
+                [this, mb_i, &mb_args](){
+                    UHD_LOG_DEBUG("MPMD", "Claiming mboard " << mb_i);
+                    return claim_and_make(mb_args[mb_i]);
+                }
+            ));
+        }
+        for (auto &claim_task : claim_tasks) {
+            _mb.push_back(claim_task.get());
+        }
     }
 
     // Next figure out the number of base xport addresses. This way, we
@@ -200,11 +227,22 @@ mpmd_impl::mpmd_impl(const device_addr_t& device_args)
     }
 
     if (not skip_init) {
-        // Run the actual device initialization. This can run in parallel.
+        // Run the actual device initialization. Each board only talks to its
+        // own RPC server here, so the initializations run concurrently.
+        profiler.enter_phase("device init");
+        std::vector<std::future<void>> init_tasks;
+        init_tasks.reserve(num_mboards);
         for (size_t mb_i = 0; mb_i < num_mboards; ++mb_i) {
             // Note: This is the only place we do compat number checks. They're
             // effectively disabled for skip_init=1
-            setup_mb(_mb[mb_i].get(), mb_i, base_xport_addr[mb_i]);
+            init_tasks.emplace_back(std::async(launch_policy,
+                [this, mb_i, &base_xport_addr](){
+                    setup_mb(_mb[mb_i].get(), mb_i, base_xport_addr[mb_i]);
+                }
+            ));
+        }
+        for (auto &init_task : init_tasks) {
+            init_task.get();
         }
     } else {
         UHD_LOG_DEBUG("MPMD", "Claimed device, but skipped init.");
@@ -216,6 +254,7 @@ mpmd_impl::mpmd_impl(const device_addr_t& device_args)
     // This might be parallelized, need to verify the prop tree can handle the
     // concurrent accesses. Would shave of milliseconds per device -- probably
     // not worth it.
+    profiler.enter_phase("tree population");
     for (size_t mb_i = 0; mb_i < mb_args.size(); ++mb_i) {
         init_property_tree(_tree, fs_path("/mboards") / mb_i, _mb[mb_i].get());
     }
@@ -223,6 +262,7 @@ mpmd_impl::mpmd_impl(const device_addr_t& device_args)
     if (not skip_init) {
         // This can be parallelized, because the blocks of individual mboards
         // live on different subtrees.
+        profiler.enter_phase("rfnoc enumeration");
         for (size_t mb_i = 0; mb_i < mb_args.size(); ++mb_i) {
             setup_rfnoc_blocks(_mb[mb_i].get(), mb_i, mb_args[mb_i]);
         }
@@ -239,10 +279,13 @@ mpmd_impl::mpmd_impl(const device_addr_t& device_args)
         // Blocks will finalize their own setup in this function. They have
         // (and might need) full access to the prop tree, the timekeepers, etc.
         // This is already internally parallelized.
+        profiler.enter_phase("rpc block init");
         setup_rpc_blocks(filtered_block_args, serialize_init);
     } else {
         UHD_LOG_INFO("MPMD", "Claimed device without full initialization.");
     }
+
+    profiler.finish();
 }
 
 mpmd_impl::~mpmd_impl()
@@ -276,11 +319,38 @@ void mpmd_impl::setup_mb(
     const size_t mb_index,
     const size_t base_xport_addr
 ) {
-    assert_compat_number_throw(
-        "MPM",
-        MPM_COMPAT_NUM,
-        mb->rpc->request<std::vector<size_t>>("get_mpm_compat_num")
-    );
+    // The compat verification costs one RPC round trip per session, and
+    // against an unchanged device its result cannot change. The cached
+    // fingerprint covers everything the check depends on - the MPM and
+    // FPGA versions from the device info already fetched at claim time,
+    // the UHD version, and the compat number UHD expects - so a fresh
+    // entry skips the round trip and any change re-verifies. Disable
+    // with compat_cache=0; compat_cache_ttl overrides the window.
+    const std::string serial = mb->device_info.get("serial", "");
+    const std::string fingerprint = str(
+        boost::format("mpm_compat:%s/%s/%s/%d.%d")
+        % mb->device_info.get("mpm_version", "")
+        % mb->device_info.get("fpga_version", "")
+        % uhd::get_version_string()
+        % MPM_COMPAT_NUM[0] % MPM_COMPAT_NUM[1]);
+    const bool use_compat_cache = not serial.empty()
+        and _device_args.cast<size_t>("compat_cache", 1) != 0;
+    if (use_compat_cache and uhd::compat_cache::is_fresh(
+            serial, fingerprint,
+            _device_args.cast<double>("compat_cache_ttl", MPMD_COMPAT_CACHE_TTL))) {
+        UHD_LOG_DEBUG("MPMD",
+            "Skipping MPM compat number check: this configuration "
+            "was verified recently.");
+    } else {
+        assert_compat_number_throw(
+            "MPM",
+            MPM_COMPAT_NUM,
+            mb->rpc->request<std::vector<size_t>>("get_mpm_compat_num")
+        );
+        if (use_compat_cache) {
+            uhd::compat_cache::store(serial, fingerprint);
+        }
+    }
 
     UHD_LOG_DEBUG("MPMD", "Initializing mboard " << mb_index);
     mb->init();
@@ -14,6 +14,7 @@
 #include <uhd/types/dict.hpp>
 #include <uhd/utils/tasks.hpp>
 #include <uhd/transport/muxed_zero_copy_if.hpp>
+#include <uhd/transport/udp_simple.hpp>
 #include <uhd/property_tree.hpp>
 #include <uhdlib/utils/rpc.hpp>
 #include <boost/optional.hpp>
@@ -87,6 +88,23 @@ class mpmd_mboard_impl
      */
     uhd::rpc_client::sptr rpc;
 
+  private:
+    /*! Reference to the RPC client that handles claiming
+     *
+     * Claiming runs on its own connection so that a blocked main RPC
+     * channel cannot starve the claim renewal.
+     */
+    uhd::rpc_client::sptr _claim_rpc;
+
+    /*! The in-flight claim request posted at construction.
+     *
+     * Posting the claim before the other setup queries overlaps its round
+     * trip with theirs; claim_device_and_make_task() collects the token.
+     */
+    boost::optional<uhd::rpc_client::async_response<std::string>>
+        _claim_response;
+
+  public:
     //! Number of RFNoC crossbars on this device
     const size_t num_xbars;
 
@@ -130,19 +148,23 @@ class mpmd_mboard_impl
     void set_timeout_init();
 
   private:
-    /*! Reference to the RPC client that handles claiming
-     */
-    uhd::rpc_client::sptr _claim_rpc;
     /*************************************************************************
      * Private methods
      ************************************************************************/
     /*! Renew the claim onto the device.
      *
      * This is meant to be called repeatedly, e.g., using a UHD task. See also
-     * _claimer_task.
+     * _claimer_task. Tries the UDP keep-alive first and falls back to the
+     * RPC reclaim when the keep-alive goes unanswered.
      */
     bool claim();
 
+    /*! Renew the claim via the UDP keep-alive service.
+     *
+     * Returns true when the discovery service acknowledged the keep-alive.
+     */
+    bool send_claim_keepalive();
+
      /*! Set RPC client timeout value
       *
       * \param timeout_ms time limit (in ms) that a rpc client waits for a single call
@@ -170,6 +192,12 @@ class mpmd_mboard_impl
      */
     uhd::task::sptr _claimer_task;
 
+    //! Datagram socket to the discovery service for claim keep-alives
+    uhd::transport::udp_simple::sptr _keepalive_udp;
+
+    //! Copy of the claim token for building keep-alive datagrams
+    std::string _claim_token;
+
     uhd::mpmd::xport::mpmd_xport_mgr::uptr _xport_mgr;
 };
 
@@ -26,6 +26,10 @@ namespace {
     constexpr size_t MPMD_SHORT_RPC_TIMEOUT     = 2000;
     //! Timeout for pings (seconds).
     constexpr double MPMD_PING_TIMEOUT          = 0.1;
+    //! Timeout for the claim keep-alive acknowledgement (seconds).
+    constexpr double MPMD_CLAIM_KEEPALIVE_TIMEOUT = 0.1;
+    //! Prefix of the UDP claim keep-alive request ("MPM-KEEP;<token>")
+    const std::string MPMD_CLAIM_KEEPALIVE_CMD = "MPM-KEEP";
     //! Default session ID (MPM will recognize a session by this name)
     const std::string MPMD_DEFAULT_SESSION_ID = "UHD";
     //! Key to initialize a ping/measurement latency test
@@ -314,8 +318,13 @@ mpmd_mboard_impl::mpmd_mboard_impl(
         const std::string& rpc_server_addr
 ) : mb_args(mb_args_)
     , rpc(make_mpm_rpc_client(rpc_server_addr, mb_args_))
-    , num_xbars(rpc->request<size_t>("get_num_xbars"))
     , _claim_rpc(make_mpm_rpc_client(rpc_server_addr, mb_args_))
+    // Post the claim right away so its round trip overlaps the
+    // get_num_xbars query below; the token is collected in
+    // claim_device_and_make_task()
+    , _claim_response(_claim_rpc->async_request<std::string>("claim",
+          mb_args_.get("session_id", MPMD_DEFAULT_SESSION_ID)))
+    , num_xbars(rpc->request<size_t>("get_num_xbars"))
     // xbar_local_addrs is not yet valid after this!
     , xbar_local_addrs(num_xbars, 0xFF)
     , _xport_mgr(xport::mpmd_xport_mgr::make(mb_args))
@@ -327,21 +336,38 @@ mpmd_mboard_impl::mpmd_mboard_impl(
         << " number of crossbars: " << num_xbars
     ;
 
+    // The keep-alive goes to the discovery datagram service next to the
+    // RPC server; without it the claim renewal simply stays on RPC
+    try {
+        _keepalive_udp = uhd::transport::udp_simple::make_broadcast(
+            rpc_server_addr,
+            mb_args_.get(mpmd_impl::MPM_DISCOVERY_PORT_KEY,
+                std::to_string(mpmd_impl::MPM_DISCOVERY_PORT)));
+    } catch (...) {
+        UHD_LOG_DEBUG("MPMD",
+            "Could not create claim keep-alive socket, "
+            "claim renewal will use RPC only.");
+    }
+
     _claimer_task = claim_device_and_make_task();
     if (mb_args_.has_key(MPMD_MEAS_LATENCY_KEY)) {
         measure_rpc_latency(rpc, MPMD_MEAS_LATENCY_DURATION);
     }
 
+    /// Post the device and dboard info queries as one pipelined burst
+    auto device_info_response = rpc->async_request<dev_info>("get_device_info");
+    auto dboards_info_response =
+        rpc->async_request<std::vector<dev_info>>("get_dboard_info");
+
     /// Get device info
-    const auto device_info_dict = rpc->request<dev_info>("get_device_info");
+    const auto device_info_dict = device_info_response.get();
     for (const auto &info_pair : device_info_dict) {
         device_info[info_pair.first] = info_pair.second;
     }
     UHD_LOGGER_TRACE("MPMD")
         << "MPM reports device info: " << device_info.to_string();
     /// Get dboard info
-    const auto dboards_info =
-        rpc->request<std::vector<dev_info>>("get_dboard_info");
+    const auto dboards_info = dboards_info_response.get();
     UHD_ASSERT_THROW(this->dboard_info.size() == 0);
     for (const auto &dboard_info_dict : dboards_info) {
         uhd::device_addr_t this_db_info;
@@ -495,6 +521,12 @@ void mpmd_mboard_impl::set_timeout_init()
  ****************************************************************************/
 bool mpmd_mboard_impl::claim()
 {
+    // Prefer the UDP keep-alive: it renews the claim in the discovery
+    // service without a round trip through the RPC server, so a busy or
+    // blocked RPC thread cannot delay the renewal
+    if (_keepalive_udp and send_claim_keepalive()) {
+        return true;
+    }
     try {
         return _claim_rpc->request_with_token<bool>("reclaim");
     } catch (...) {
@@ -503,6 +535,28 @@ bool mpmd_mboard_impl::claim()
     }
 }
 
+bool mpmd_mboard_impl::send_claim_keepalive()
+{
+    // The acknowledgement is an echo of the request; no (or a wrong)
+    // reply means the keep-alive was not accepted or got lost, and the
+    // caller falls back to the RPC reclaim
+    try {
+        const std::string send_buf =
+            MPMD_CLAIM_KEEPALIVE_CMD + ";" + _claim_token;
+        std::vector<uint8_t> recv_buf(send_buf.size(), ' ');
+        _keepalive_udp->send(
+            boost::asio::buffer(send_buf.c_str(), send_buf.size()));
+        const size_t len = _keepalive_udp->recv(
+            boost::asio::buffer(recv_buf), MPMD_CLAIM_KEEPALIVE_TIMEOUT);
+        return len == send_buf.size() and std::memcmp(
+            (void *) &recv_buf[0],
+            (void *) send_buf.c_str(),
+            send_buf.size()) == 0;
+    } catch (...) {
+        return false;
+    }
+}
+
 void mpmd_mboard_impl::set_rpcc_timeout(const uint64_t timeout_ms){
     rpc->set_timeout(timeout_ms);
     //FIXME: remove this when we know why rpc client didn't reset timer
@@ -512,16 +566,17 @@ void mpmd_mboard_impl::set_rpcc_timeout(const uint64_t timeout_ms){
 
 uhd::task::sptr mpmd_mboard_impl::claim_device_and_make_task(
 ) {
-    auto rpc_token = _claim_rpc->request<std::string>("claim",
-        mb_args.get("session_id", MPMD_DEFAULT_SESSION_ID)
-    );
+    // The claim request was posted in the constructor; collect it here
+    auto rpc_token = _claim_response->get();
+    _claim_response = boost::none;
     if (rpc_token.empty()) {
         throw uhd::value_error("mpmd device claiming failed!");
     }
     UHD_LOG_TRACE("MPMD", "Received claim token " << rpc_token);
-    // Save token for both RPC clients
+    // Save token for both RPC clients and the UDP keep-alive
     _claim_rpc->set_token(rpc_token);
     rpc->set_token(rpc_token);
+    _claim_token = rpc_token;
     return uhd::task::make([this] {
         auto now = std::chrono::steady_clock::now();
         if (not this->claim()) {
@@ -12,6 +12,9 @@
 #include <uhd/types/sensors.hpp>
 #include <uhd/types/eeprom.hpp>
 #include <uhd/usrp/mboard_eeprom.hpp>
+#include <map>
+#include <memory>
+#include <mutex>
 
 using namespace uhd;
 using namespace uhd::mpmd;
@@ -20,6 +23,12 @@ namespace {
     //! Timeout value for the update_component RPC call (ms)
     constexpr size_t MPMD_UPDATE_COMPONENT_TIMEOUT = 20000;
 
+    //! Sensor values prefetched by the snapshot backend, keyed by name
+    struct sensor_snapshot_cache_t {
+        std::mutex mutex;
+        std::map<std::string, sensor_value_t::sensor_map_t> values;
+    };
+
     /*! Update a component using all required files. For example, when updating the FPGA image
      * (.bit or .bin), users can provide a new overlay image (DTS) to apply in addition.
      *
@@ -91,6 +100,17 @@ void mpmd_impl::init_property_tree(
         fs_path mb_path,
         mpmd_mboard_impl *mb
 ) {
+    // Post the init-time queries as one pipelined burst; the responses are
+    // collected below where their values are needed.
+    auto sensor_list_response =
+        mb->rpc->async_request_with_token<std::vector<std::string>>(
+            "get_mb_sensors"
+        );
+    auto updateable_components_response =
+        mb->rpc->async_request<std::vector<std::string>>(
+            "list_updateable_components"
+        );
+
     /*** Device info ****************************************************/
     if (not tree->exists("/name")) {
         tree->create<std::string>("/name")
@@ -152,20 +172,32 @@ void mpmd_impl::init_property_tree(
     ;
 
     /*** Sensors ********************************************************/
-    auto sensor_list =
-        mb->rpc->request_with_token<std::vector<std::string>>(
-            "get_mb_sensors"
-        );
+    auto sensor_list = sensor_list_response.get();
     UHD_LOG_DEBUG("MPMD",
         "Found " << sensor_list.size() << " motherboard sensors."
     );
+    // Cache primed by the snapshot backend below: a snapshot() of this
+    // subtree fetches all sensor values in one RPC call, and the
+    // per-sensor publishers consume the cached values instead of going
+    // to the device one sensor at a time. Each cached value is consumed
+    // at most once, so direct reads outside a snapshot stay live.
+    auto sensor_cache = std::make_shared<sensor_snapshot_cache_t>();
     for (const auto& sensor_name : sensor_list) {
         UHD_LOG_TRACE("MPMD",
             "Adding motherboard sensor `" << sensor_name << "'"
         );
         tree->create<sensor_value_t>(
                 mb_path / "sensors" / sensor_name)
-            .set_publisher([mb, sensor_name](){
+            .set_publisher([mb, sensor_name, sensor_cache](){
+                {
+                    std::lock_guard<std::mutex> lock(sensor_cache->mutex);
+                    auto it = sensor_cache->values.find(sensor_name);
+                    if (it != sensor_cache->values.end()) {
+                        const sensor_value_t value(it->second);
+                        sensor_cache->values.erase(it);
+                        return value;
+                    }
+                }
                 return sensor_value_t(
                     mb->rpc->request_with_token<sensor_value_t::sensor_map_t>(
                         "get_mb_sensor", sensor_name
@@ -180,6 +212,28 @@ void mpmd_impl::init_property_tree(
             })
         ;
     }
+    // One-shot readout of all motherboard sensors. multi_usrp's batch
+    // getters prefer this node, so a polling pass over many sensors
+    // costs a single RPC call instead of one per sensor.
+    tree->create<std::map<std::string, sensor_value_t::sensor_map_t>>(
+            mb_path / "sensors_batch")
+        .set_publisher([mb](){
+            return mb->rpc->request_with_token<
+                std::map<std::string, sensor_value_t::sensor_map_t>>(
+                    "get_mb_sensors_batch"
+                );
+        })
+    ;
+    // Bulk backend for property_tree::snapshot(): prime the sensor cache
+    // with a single RPC call covering every motherboard sensor.
+    tree->register_snapshot_backend(mb_path, [mb, sensor_cache](){
+        auto values = mb->rpc->request_with_token<
+            std::map<std::string, sensor_value_t::sensor_map_t>>(
+                "get_mb_sensors_batch"
+            );
+        std::lock_guard<std::mutex> lock(sensor_cache->mutex);
+        sensor_cache->values.swap(values);
+    });
 
     /*** EEPROM *********************************************************/
     tree->create<uhd::usrp::mboard_eeprom_t>(mb_path / "eeprom")
@@ -206,10 +260,8 @@ void mpmd_impl::init_property_tree(
     ;
 
     /*** Updateable Components ******************************************/
-    std::vector<std::string> updateable_components =
-            mb->rpc->request<std::vector<std::string>>(
-                    "list_updateable_components"
-            );
+    const std::vector<std::string> updateable_components =
+            updateable_components_response.get();
     // TODO: Check the 'id' against the registered property
     UHD_LOG_DEBUG("MPMD",
                 "Found " << updateable_components.size() << " updateable motherboard components."
@@ -55,8 +55,11 @@ mpmd_xport_ctrl_liberio::make_transport(
 
     default_buff_args.send_frame_size = get_mtu(uhd::TX_DIRECTION);
     default_buff_args.recv_frame_size = get_mtu(uhd::RX_DIRECTION);
-    default_buff_args.num_recv_frames = LIBERIO_NUM_RECV_FRAMES;
-    default_buff_args.num_send_frames = LIBERIO_NUM_SEND_FRAMES;
+    //the DMA ring depth is overridable through device args
+    default_buff_args.num_recv_frames =
+        _mb_args.cast<size_t>("num_recv_frames", LIBERIO_NUM_RECV_FRAMES);
+    default_buff_args.num_send_frames =
+        _mb_args.cast<size_t>("num_send_frames", LIBERIO_NUM_SEND_FRAMES);
 
     if (xport_type == usrp::device3_impl::CTRL) {
         default_buff_args.send_frame_size = LIBERIO_CTRL_FRAME_MAX_SIZE;
@@ -95,20 +98,24 @@ mpmd_xport_ctrl_liberio::make_transport(
         if (not _ctrl_dma_xport) {
             default_buff_args.send_frame_size = LIBERIO_CTRL_FRAME_MAX_SIZE;
             default_buff_args.recv_frame_size = LIBERIO_CTRL_FRAME_MAX_SIZE;
+            //Control responses bound register access latency: run the
+            //demuxer in low-latency mode
             _ctrl_dma_xport = make_muxed_liberio_xport(tx_dev, rx_dev,
-                    default_buff_args, int(divisor));
+                    default_buff_args, int(divisor), true /*low_latency*/);
         }
 
         UHD_LOGGER_TRACE("MPMD")
             << "Making (muxed) stream with num " << xports.recv_sid.get_dst();
-        xports.recv = _ctrl_dma_xport->make_stream(xports.recv_sid.get_dst());
+        xports.recv = _ctrl_dma_xport->make_stream(
+                xports.recv_sid.get_dst(), true /*priority*/);
     } else if (xport_type == usrp::device3_impl::ASYNC_MSG) {
         UHD_ASSERT_THROW(xport_info["muxed"] == "True");
         if (not _async_msg_dma_xport) {
             default_buff_args.send_frame_size = LIBERIO_ASYNC_FRAME_MAX_SIZE;
             default_buff_args.recv_frame_size = LIBERIO_ASYNC_FRAME_MAX_SIZE;
             _async_msg_dma_xport = make_muxed_liberio_xport(
-                    tx_dev, rx_dev, default_buff_args, int(divisor));
+                    tx_dev, rx_dev, default_buff_args, int(divisor),
+                    false /*low_latency*/);
         }
 
         UHD_LOGGER_TRACE("MPMD")
@@ -153,12 +160,13 @@ mpmd_xport_ctrl_liberio::make_muxed_liberio_xport(
         const std::string &tx_dev,
         const std::string &rx_dev,
         const uhd::transport::zero_copy_xport_params &buff_args,
-        const size_t max_muxed_ports
+        const size_t max_muxed_ports,
+        const bool low_latency
 ) {
     auto base_xport = transport::liberio_zero_copy::make(
             tx_dev, rx_dev, buff_args);
 
     return uhd::transport::muxed_zero_copy_if::make(
-            base_xport, extract_sid_from_pkt, max_muxed_ports);
+            base_xport, extract_sid_from_pkt, max_muxed_ports, low_latency);
 }
 
@@ -45,7 +45,8 @@ private:
             const std::string &tx_dev,
             const std::string &rx_dev,
             const uhd::transport::zero_copy_xport_params &buff_args,
-            const size_t max_muxed_ports
+            const size_t max_muxed_ports,
+            const bool low_latency
     );
 
     const uhd::device_addr_t _mb_args;
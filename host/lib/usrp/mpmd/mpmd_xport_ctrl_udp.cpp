@@ -8,6 +8,10 @@
 #include "mpmd_xport_mgr.hpp"
 #include "mpmd_xport_ctrl_udp.hpp"
 #include <uhd/transport/udp_zero_copy.hpp>
+#include <uhd/transport/bonded_zero_copy.hpp>
+#ifdef HAVE_DPDK
+#include <uhdlib/transport/dpdk_zero_copy.hpp>
+#endif
 #include <uhd/transport/udp_simple.hpp>
 #include <uhd/transport/udp_constants.hpp>
 
@@ -172,6 +176,15 @@ mpmd_xport_ctrl_udp::mpmd_xport_ctrl_udp(
         mpmd_impl::MPM_DISCOVERY_PORT_KEY,
         std::to_string(mpmd_impl::MPM_DISCOVERY_PORT)
     );
+
+    // A previous session may have recorded the probed path MTU in the
+    // discovery cache; reuse it instead of probing the path again
+    if (_mb_args.has_key("path_mtu")) {
+        _mtu = std::min(_mtu, _mb_args.cast<size_t>("path_mtu", _mtu));
+        UHD_LOG_DEBUG("MPMD", "Using cached path MTU: " << _mtu);
+        return;
+    }
+
     auto discover_mtu_for_ip = [mpm_discovery_port](const std::string &ip_addr){
         return discover_mtu(
             ip_addr,
@@ -185,6 +198,14 @@ mpmd_xport_ctrl_udp::mpmd_xport_ctrl_udp(
     for (const auto &ip_addr : _available_addrs) {
         _mtu = std::min(_mtu, discover_mtu_for_ip(ip_addr));
     }
+
+    // Record the probe result so that cache-enabled sessions can skip
+    // the probing next time
+    if (_mb_args.has_key("cache") and _mb_args.has_key("serial")) {
+        device_addr_t cache_entry(_mb_args);
+        cache_entry["path_mtu"] = std::to_string(_mtu);
+        device::update_discovery_cache(cache_entry);
+    }
 }
 
 uhd::both_xports_t
@@ -222,16 +243,91 @@ mpmd_xport_ctrl_udp::make_transport(
     }else{
         default_buff_args.send_frame_size = get_mtu(uhd::TX_DIRECTION);
     }
+    // Receive-side scaling: a single UDP flow hashes to one NIC RX queue
+    // and thus one IRQ core. With rss_ports=N on an RX data stream we open
+    // N sockets to the same device endpoint and advertise all local ports
+    // back to MPM, so a device that supports it can spread the stream
+    // across them; the recv packet handler's reorder window restores the
+    // packet order. A device that only honors src_port simply keeps all
+    // traffic on the first socket.
+    size_t rss_ports = 1;
+    if (xport_type == usrp::device3_impl::RX_DATA
+            and xport_args.has_key("rss_ports")) {
+        rss_ports = std::max<size_t>(
+            xport_args.cast<size_t>("rss_ports", 1), 1);
+    }
     transport::udp_zero_copy::buff_params buff_params;
-    auto recv = transport::udp_zero_copy::make(
-        xport_info["ipv4"],
-        xport_info["port"],
-        default_buff_args,
-        buff_params,
-        xport_args
-    );
-    const uint16_t port = recv->get_local_port();
-    const std::string src_ip_addr = recv->get_local_addr();
+    transport::zero_copy_if::sptr recv;
+    std::vector<transport::zero_copy_if::sptr> rss_sockets;
+    uint16_t port = 0;
+    std::string src_ip_addr;
+#ifdef HAVE_DPDK
+    if (_mb_args.has_key("use_dpdk")) {
+        auto dpdk_ctx = transport::uhd_dpdk_ctx::get();
+        if (not dpdk_ctx->is_init_done()) {
+            dpdk_ctx->init(_mb_args);
+        }
+        const int dpdk_port_id = dpdk_ctx->get_route(xport_info["ipv4"]);
+        if (dpdk_port_id < 0) {
+            throw uhd::runtime_error(
+                "Could not find a DPDK port to reach address "
+                + xport_info["ipv4"]);
+        }
+        auto dpdk_recv = transport::dpdk_zero_copy::make(
+            *dpdk_ctx,
+            unsigned(dpdk_port_id),
+            xport_info["ipv4"],
+            xport_info["port"],
+            "0",
+            default_buff_args,
+            xport_args
+        );
+        //with DPDK the frame pools take the place of the socket buffers
+        buff_params.recv_buff_size =
+            dpdk_recv->get_num_recv_frames() * dpdk_recv->get_recv_frame_size();
+        buff_params.send_buff_size =
+            dpdk_recv->get_num_send_frames() * dpdk_recv->get_send_frame_size();
+        port = dpdk_recv->get_local_port();
+        src_ip_addr = dpdk_ctx->get_ipv4_addr(unsigned(dpdk_port_id));
+        recv = dpdk_recv;
+        if (rss_ports > 1) {
+            UHD_LOG_DEBUG("MPMD",
+                "rss_ports is ignored with DPDK transports");
+        }
+    } else
+#endif /*HAVE_DPDK*/
+    {
+        auto udp_recv = transport::udp_zero_copy::make(
+            xport_info["ipv4"],
+            xport_info["port"],
+            default_buff_args,
+            buff_params,
+            xport_args
+        );
+        port = udp_recv->get_local_port();
+        src_ip_addr = udp_recv->get_local_addr();
+        recv = udp_recv;
+        if (rss_ports > 1) {
+            rss_sockets.push_back(recv);
+            std::string src_ports = std::to_string(port);
+            for (size_t i = 1; i < rss_ports; i++) {
+                auto extra_recv = transport::udp_zero_copy::make(
+                    xport_info["ipv4"],
+                    xport_info["port"],
+                    default_buff_args,
+                    buff_params,
+                    xport_args
+                );
+                rss_sockets.push_back(extra_recv);
+                src_ports += "," + std::to_string(
+                    extra_recv->get_local_port());
+            }
+            xport_info["rss_src_ports"] = src_ports;
+            UHD_LOG_DEBUG("MPMD",
+                "Opened " << rss_sockets.size() << " RX sockets for "
+                "receive-side scaling on ports " << src_ports);
+        }
+    }
     xport_info["src_port"] = std::to_string(port);
     xport_info["src_ipv4"] = src_ip_addr;
 
@@ -242,8 +338,10 @@ mpmd_xport_ctrl_udp::make_transport(
     xports.recv_sid = xports.send_sid.reversed();
     xports.recv_buff_size = buff_params.recv_buff_size;
     xports.send_buff_size = buff_params.send_buff_size;
-    xports.recv = recv; // Note: This is a type cast!
-    xports.send = recv; // This too
+    xports.recv = rss_sockets.empty()
+        ? recv // Note: This is a type cast!
+        : transport::bonded_zero_copy::make(rss_sockets);
+    xports.send = recv; // Upstream traffic stays on the primary socket
     return xports;
 }
 
@@ -27,6 +27,11 @@
 #include <cmath>
 #include <bitset>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
 #include <thread>
 
 using namespace uhd;
@@ -394,6 +399,18 @@ public:
         }
     }
 
+    ~multi_usrp_impl(void){
+        //stop the async command worker; queued commands run to completion
+        if (_async_cmd_thread.joinable()){
+            {
+                std::lock_guard<std::mutex> lock(_async_cmd_mutex);
+                _async_cmd_exit = true;
+            }
+            _async_cmd_cond.notify_one();
+            _async_cmd_thread.join();
+        }
+    }
+
     device::sptr get_device(void){
         return _dev;
     }
@@ -616,25 +633,72 @@ public:
     void set_time_unknown_pps(const time_spec_t &time_spec){
         UHD_LOGGER_INFO("MULTI_USRP")
             << "    1) catch time transition at pps edge";
-        auto end_time = std::chrono::steady_clock::now()
-                            + std::chrono::milliseconds(1100);
-        time_spec_t time_start_last_pps = get_time_last_pps();
-        while (time_start_last_pps == get_time_last_pps())
-        {
-            if (std::chrono::steady_clock::now() > end_time) {
-                throw uhd::runtime_error(
-                    "Board 0 may not be getting a PPS signal!\n"
-                    "No PPS detected within the time interval.\n"
-                    "See the application notes for your device.\n"
-                );
+        //Predict the PPS phase from board 0's readbacks: the time-now
+        //and last-PPS registers tick in the same timebase, so their
+        //difference is the time since the last edge, even when the
+        //absolute time has never been set.
+        auto edge_time = std::chrono::steady_clock::now();
+        const double since_edge =
+            (get_time_now(0) - get_time_last_pps(0)).get_real_secs();
+        if (since_edge >= 0.0 and since_edge <= 0.8){
+            edge_time -= std::chrono::milliseconds(long(since_edge*1e3));
+        }
+        else{
+            //The phase cannot be trusted (the time counter was just
+            //rewritten) or the next edge is too close to program every
+            //device before it arrives: catch an edge the slow way.
+            //This also proves a PPS signal is actually present before
+            //we rely on predicting its edges.
+            auto end_time = std::chrono::steady_clock::now()
+                                + std::chrono::milliseconds(1100);
+            time_spec_t time_start_last_pps = get_time_last_pps();
+            while (time_start_last_pps == get_time_last_pps())
+            {
+                if (std::chrono::steady_clock::now() > end_time) {
+                    throw uhd::runtime_error(
+                        "Board 0 may not be getting a PPS signal!\n"
+                        "No PPS detected within the time interval.\n"
+                        "See the application notes for your device.\n"
+                    );
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            edge_time = std::chrono::steady_clock::now();
         }
 
         UHD_LOGGER_INFO("MULTI_USRP")
             << "    2) set times next pps (synchronously)";
-        set_time_next_pps(time_spec, ALL_MBOARDS);
-        std::this_thread::sleep_for(std::chrono::seconds(1));
+        //Program every mboard concurrently: each one has its own control
+        //channel, and all writes must land before the predicted edge.
+        if (get_num_mboards() == 1){
+            set_time_next_pps(time_spec, 0);
+        }
+        else{
+            std::vector<std::string> errors(get_num_mboards());
+            std::vector<std::thread> workers;
+            for (size_t m = 0; m < get_num_mboards(); m++){
+                workers.push_back(std::thread([this, m, time_spec, &errors](){
+                    try{
+                        this->set_time_next_pps(time_spec, m);
+                    }
+                    catch(const std::exception &ex){
+                        errors[m] = ex.what();
+                    }
+                }));
+            }
+            for (auto &worker : workers) worker.join();
+            for (size_t m = 0; m < errors.size(); m++){
+                if (not errors[m].empty()) throw uhd::runtime_error(str(
+                    boost::format("Failed to set time on board %d: %s")
+                    % m % errors[m]
+                ));
+            }
+        }
+
+        //sleep until just past the predicted edge instead of a blanket
+        //full second; the margin covers prediction and control latency
+        std::this_thread::sleep_until(
+            edge_time + std::chrono::milliseconds(1100));
 
         //verify that the time registers are read to be within a few RTT
         for (size_t m = 1; m < get_num_mboards(); m++){
@@ -697,6 +761,67 @@ public:
         }
     }
 
+    time_spec_t issue_stream_cmd_synced(const stream_cmd_t &stream_cmd, const double lead_time){
+        //resolve the common start time: keep a caller-provided future
+        //time spec, otherwise schedule lead_time ahead of board zero
+        const time_spec_t time_0 = this->get_time_now(0);
+        stream_cmd_t timed_cmd = stream_cmd;
+        if (timed_cmd.stream_now or timed_cmd.time_spec <= time_0){
+            timed_cmd.time_spec = time_0 + time_spec_t(lead_time);
+        }
+        timed_cmd.stream_now = false;
+
+        //sort the channels by motherboard
+        std::vector<std::vector<size_t> > mb_chans(get_num_mboards());
+        for (size_t c = 0; c < get_rx_num_channels(); c++){
+            mb_chans[rx_chan_to_mcp(c).mboard].push_back(c);
+        }
+
+        //issue the commands to every mboard concurrently: each one has
+        //its own control channel, so the delivery times overlap
+        if (get_num_mboards() == 1){
+            issue_stream_cmd(timed_cmd, ALL_CHANS);
+        }
+        else{
+            std::vector<std::string> errors(get_num_mboards());
+            std::vector<std::thread> workers;
+            for (size_t m = 0; m < get_num_mboards(); m++){
+                workers.push_back(std::thread([this, m, timed_cmd, &mb_chans, &errors](){
+                    try{
+                        for (const size_t c : mb_chans[m]){
+                            this->issue_stream_cmd(timed_cmd, c);
+                        }
+                    }
+                    catch(const std::exception &ex){
+                        errors[m] = ex.what();
+                    }
+                }));
+            }
+            for (auto &worker : workers) worker.join();
+            for (size_t m = 0; m < errors.size(); m++){
+                if (not errors[m].empty()) throw uhd::runtime_error(str(
+                    boost::format("Failed to issue stream command on board %d: %s")
+                    % m % errors[m]
+                ));
+            }
+        }
+
+        //verify that every command landed before the start time; a late
+        //command activates on arrival and misaligns that board's stream
+        for (size_t m = 0; m < get_num_mboards(); m++){
+            const time_spec_t time_m = this->get_time_now(m);
+            if (time_m >= timed_cmd.time_spec) throw uhd::runtime_error(str(
+                boost::format(
+                    "Stream command for board %d may have arrived late: "
+                    "board time is %f seconds, start time is %f seconds. "
+                    "Increase the lead time and restart the streams.")
+                % m % time_m.get_real_secs()
+                % timed_cmd.time_spec.get_real_secs()
+            ));
+        }
+        return timed_cmd.time_spec;
+    }
+
     void set_clock_config(const clock_config_t &clock_config, size_t mboard){
         //set the reference source...
         std::string clock_source;
@@ -965,6 +1090,34 @@ public:
         return {};
     }
 
+    std::map<std::string, sensor_value_t> get_mboard_sensors_batch(
+        const std::vector<std::string> &names, size_t mboard
+    ){
+        std::map<std::string, sensor_value_t> sensors;
+        // MPM-based devices expose a batch node which reads out all
+        // motherboard sensors with a single RPC call
+        if (_tree->exists(mb_root(mboard) / "sensors_batch")) {
+            typedef std::map<std::string, sensor_value_t::sensor_map_t>
+                sensor_maps_t;
+            const sensor_maps_t sensor_maps = _tree->access<sensor_maps_t>(
+                mb_root(mboard) / "sensors_batch").get();
+            for (const std::string &name : names) {
+                if (sensor_maps.count(name) == 0) {
+                    throw uhd::lookup_error(
+                        "Invalid motherboard sensor name: " + name);
+                }
+                sensors.insert(std::make_pair(
+                    name, sensor_value_t(sensor_maps.at(name))));
+            }
+            return sensors;
+        }
+        for (const std::string &name : names) {
+            sensors.insert(std::make_pair(
+                name, get_mboard_sensor(name, mboard)));
+        }
+        return sensors;
+    }
+
     void set_user_register(const uint8_t addr, const uint32_t data, size_t mboard){
         if (mboard != ALL_MBOARDS){
             typedef std::pair<uint8_t, uint32_t> user_reg_t;
@@ -1103,6 +1256,12 @@ public:
         return result;
     }
 
+    std::future<tune_result_t> set_rx_freq_async(const tune_request_t &tune_request, size_t chan){
+        return post_async_cmd<tune_result_t>([this, tune_request, chan](){
+            return this->set_rx_freq(tune_request, chan);
+        });
+    }
+
     double get_rx_freq(size_t chan){
         return derive_freq_from_xx_subdev_and_dsp(RX_SIGN, _tree->subtree(rx_dsp_root(chan)), _tree->subtree(rx_rf_fe_root(chan)));
     }
@@ -1119,6 +1278,34 @@ public:
         return _tree->access<meta_range_t>(rx_rf_fe_root(chan) / "freq" / "range").get();
     }
 
+    void make_rx_tune_profile(const std::vector<double> &freqs, size_t chan){
+        tune_profile_t profile;
+        //tune each entry once so clipping, LO offsets and hardware
+        //coercion are resolved now instead of on every hop
+        for (const double freq : freqs){
+            profile.results.push_back(set_rx_freq(tune_request_t(freq), chan));
+        }
+        //cache the property references so a hop skips the path lookups too
+        profile.rf_freq_prop = &_tree->access<double>(rx_rf_fe_root(chan) / "freq" / "value");
+        profile.dsp_freq_prop = &_tree->access<double>(rx_dsp_root(chan) / "freq" / "value");
+        _rx_tune_profiles[chan] = profile;
+    }
+
+    tune_result_t apply_rx_tune_profile(size_t index, size_t chan){
+        if (_rx_tune_profiles.count(chan) == 0){
+            throw uhd::runtime_error("no RX tune profile computed for this channel");
+        }
+        return apply_tune_profile(_rx_tune_profiles[chan], index);
+    }
+
+    tune_result_t apply_rx_tune_profile(size_t index, const time_spec_t &time, size_t chan){
+        const size_t mboard = rx_chan_to_mcp(chan).mboard;
+        set_command_time(time, mboard);
+        const tune_result_t result = apply_rx_tune_profile(index, chan);
+        clear_command_time(mboard);
+        return result;
+    }
+
     /**************************************************************************
      * LO controls
      *************************************************************************/
@@ -1532,6 +1719,12 @@ public:
         }
     }
 
+    std::future<void> set_rx_gain_async(double gain, const std::string &name, size_t chan){
+        return post_async_cmd<void>([this, gain, name, chan](){
+            this->set_rx_gain(gain, name, chan);
+        });
+    }
+
     void set_rx_gain_profile(const std::string& profile, const size_t chan){
         if (chan != ALL_CHANS) {
             if (_tree->exists(rx_rf_fe_root(chan) / "gains/all/profile/value")) {
@@ -1680,6 +1873,16 @@ public:
         return sensor_names;
     }
 
+    std::map<std::string, sensor_value_t> get_rx_sensors_batch(
+        const std::vector<std::string> &names, size_t chan
+    ){
+        std::map<std::string, sensor_value_t> sensors;
+        for (const std::string &name : names) {
+            sensors.insert(std::make_pair(name, get_rx_sensor(name, chan)));
+        }
+        return sensors;
+    }
+
     void set_rx_dc_offset(const bool enb, size_t chan){
         if (chan != ALL_CHANS){
             if (_tree->exists(rx_fe_root(chan) / "dc_offset" / "enable")) {
@@ -1923,6 +2126,12 @@ public:
         return result;
     }
 
+    std::future<tune_result_t> set_tx_freq_async(const tune_request_t &tune_request, size_t chan){
+        return post_async_cmd<tune_result_t>([this, tune_request, chan](){
+            return this->set_tx_freq(tune_request, chan);
+        });
+    }
+
     double get_tx_freq(size_t chan){
         return derive_freq_from_xx_subdev_and_dsp(TX_SIGN, _tree->subtree(tx_dsp_root(chan)), _tree->subtree(tx_rf_fe_root(chan)));
     }
@@ -1939,6 +2148,31 @@ public:
         return _tree->access<meta_range_t>(tx_rf_fe_root(chan) / "freq" / "range").get();
     }
 
+    void make_tx_tune_profile(const std::vector<double> &freqs, size_t chan){
+        tune_profile_t profile;
+        for (const double freq : freqs){
+            profile.results.push_back(set_tx_freq(tune_request_t(freq), chan));
+        }
+        profile.rf_freq_prop = &_tree->access<double>(tx_rf_fe_root(chan) / "freq" / "value");
+        profile.dsp_freq_prop = &_tree->access<double>(tx_dsp_root(chan) / "freq" / "value");
+        _tx_tune_profiles[chan] = profile;
+    }
+
+    tune_result_t apply_tx_tune_profile(size_t index, size_t chan){
+        if (_tx_tune_profiles.count(chan) == 0){
+            throw uhd::runtime_error("no TX tune profile computed for this channel");
+        }
+        return apply_tune_profile(_tx_tune_profiles[chan], index);
+    }
+
+    tune_result_t apply_tx_tune_profile(size_t index, const time_spec_t &time, size_t chan){
+        const size_t mboard = tx_chan_to_mcp(chan).mboard;
+        set_command_time(time, mboard);
+        const tune_result_t result = apply_tx_tune_profile(index, chan);
+        clear_command_time(mboard);
+        return result;
+    }
+
     void set_tx_gain(double gain, const std::string &name, size_t chan){
         try {
             return tx_gain_group(chan)->set_value(gain, name);
@@ -1947,6 +2181,12 @@ public:
         }
     }
 
+    std::future<void> set_tx_gain_async(double gain, const std::string &name, size_t chan){
+        return post_async_cmd<void>([this, gain, name, chan](){
+            this->set_tx_gain(gain, name, chan);
+        });
+    }
+
     void set_tx_gain_profile(const std::string& profile, const size_t chan){
         if (chan != ALL_CHANS) {
             if (_tree->exists(tx_rf_fe_root(chan) / "gains/all/profile/value")) {
@@ -2077,6 +2317,16 @@ public:
         return sensor_names;
     }
 
+    std::map<std::string, sensor_value_t> get_tx_sensors_batch(
+        const std::vector<std::string> &names, size_t chan
+    ){
+        std::map<std::string, sensor_value_t> sensors;
+        for (const std::string &name : names) {
+            sensors.insert(std::make_pair(name, get_tx_sensor(name, chan)));
+        }
+        return sensors;
+    }
+
     void set_tx_dc_offset(const std::complex<double> &offset, size_t chan){
         if (chan != ALL_CHANS){
             if (_tree->exists(tx_fe_root(chan) / "dc_offset" / "value")) {
@@ -2498,6 +2748,74 @@ private:
     bool _is_device3;
     uhd::rfnoc::legacy_compat::sptr _legacy_compat;
 
+    /**************************************************************************
+     * Async command worker
+     *************************************************************************/
+    //the *_async calls are queued here and run on a dedicated control
+    //thread, so reconfiguration never blocks a thread that services
+    //streamers; the worker is spawned lazily on the first async call
+    std::mutex _async_cmd_mutex;
+    std::condition_variable _async_cmd_cond;
+    std::deque<std::function<void(void)>> _async_cmd_queue;
+    std::thread _async_cmd_thread;
+    bool _async_cmd_exit = false;
+
+    template <typename result_type>
+    std::future<result_type> post_async_cmd(std::function<result_type(void)> fcn){
+        //a shared ptr makes the move-only packaged task queueable
+        auto task = std::make_shared<std::packaged_task<result_type(void)>>(
+            std::move(fcn));
+        std::future<result_type> result = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(_async_cmd_mutex);
+            if (not _async_cmd_thread.joinable()){
+                _async_cmd_thread = std::thread(
+                    &multi_usrp_impl::async_cmd_worker, this);
+            }
+            _async_cmd_queue.push_back([task](){(*task)();});
+        }
+        _async_cmd_cond.notify_one();
+        return result;
+    }
+
+    void async_cmd_worker(void){
+        std::unique_lock<std::mutex> lock(_async_cmd_mutex);
+        while (true){
+            _async_cmd_cond.wait(lock, [this](){
+                return _async_cmd_exit or not _async_cmd_queue.empty();
+            });
+            if (_async_cmd_queue.empty()) return; //only exit once drained
+            std::function<void(void)> cmd = std::move(_async_cmd_queue.front());
+            _async_cmd_queue.pop_front();
+            lock.unlock();
+            cmd(); //exceptions propagate through the packaged task's future
+            lock.lock();
+        }
+    }
+
+    //! Precomputed tune state per channel for fast frequency hopping
+    struct tune_profile_t{
+        std::vector<tune_result_t> results;
+        property<double> *rf_freq_prop;
+        property<double> *dsp_freq_prop;
+        tune_profile_t(void): rf_freq_prop(NULL), dsp_freq_prop(NULL){}
+    };
+    std::map<size_t, tune_profile_t> _rx_tune_profiles;
+    std::map<size_t, tune_profile_t> _tx_tune_profiles;
+
+    static tune_result_t apply_tune_profile(tune_profile_t &profile, const size_t index){
+        if (index >= profile.results.size()){
+            throw uhd::index_error("tune profile index out of range");
+        }
+        //replay the targets recorded at profile computation time; the
+        //hardware coerces them exactly as it did then, so the recorded
+        //tune result still describes the outcome
+        const tune_result_t &result = profile.results[index];
+        profile.rf_freq_prop->set(result.target_rf_freq);
+        profile.dsp_freq_prop->set(result.target_dsp_freq);
+        return result;
+    }
+
     struct mboard_chan_pair{
         size_t mboard, chan;
         mboard_chan_pair(void): mboard(0), chan(0){}
@@ -0,0 +1,433 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "../../transport/super_recv_packet_handler.hpp"
+#include "../../transport/super_send_packet_handler.hpp"
+#include "null_impl.hpp"
+#include <uhd/convert.hpp>
+#include <uhd/exception.hpp>
+#include <uhd/transport/vrt_if_packet.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/static.hpp>
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+using namespace uhd;
+using namespace uhd::transport;
+
+namespace {
+    constexpr size_t DEFAULT_FRAME_SIZE = 8000;
+    constexpr size_t NUM_FRAMES = 32;
+    constexpr size_t DEFAULT_LOOPBACK_DEPTH = 64;
+    //nominal rate for timestamp bookkeeping when unthrottled
+    constexpr double NOMINAL_SAMP_RATE = 100e6;
+}
+
+/***********************************************************************
+ * Managed buffers over plain memory
+ **********************************************************************/
+//! A recycling receive frame: release() returns it to the pool
+class null_mrb : public managed_recv_buffer{
+public:
+    null_mrb(const size_t frame_size):
+        _mem(frame_size/sizeof(uint32_t) + 1), _claimed(false){}
+
+    void release(void){
+        _claimed.store(false, std::memory_order_release);
+    }
+
+    bool try_claim(void){
+        bool expected = false;
+        return _claimed.compare_exchange_strong(
+            expected, true, std::memory_order_acquire);
+    }
+
+    sptr get_new(const size_t len){
+        return make(this, &_mem.front(), len);
+    }
+
+    uint32_t *mem(void){
+        return &_mem.front();
+    }
+
+private:
+    std::vector<uint32_t> _mem;
+    std::atomic<bool> _claimed;
+};
+
+//! A send frame: release() sinks the committed packet (or loops it back)
+class null_msb : public managed_send_buffer{
+public:
+    null_msb(const size_t frame_size):
+        _mem(frame_size/sizeof(uint32_t) + 1), _claimed(false){}
+
+    void set_loopback_queue(void *queue){
+        _queue = queue;
+    }
+
+    void release(void);
+
+    bool try_claim(void){
+        bool expected = false;
+        return _claimed.compare_exchange_strong(
+            expected, true, std::memory_order_acquire);
+    }
+
+    sptr get_new(const size_t len){
+        return make(this, &_mem.front(), len);
+    }
+
+private:
+    std::vector<uint32_t> _mem;
+    std::atomic<bool> _claimed;
+    void *_queue = nullptr;
+};
+
+/***********************************************************************
+ * Per-channel state
+ **********************************************************************/
+struct null_impl::rx_chan_state_type{
+    rx_chan_state_type(const size_t frame_size):
+        spp(0), payload_words32(0),
+        streaming(false), packet_count(0), samples_generated(0)
+    {
+        for (size_t i = 0; i < NUM_FRAMES; i++){
+            frames.push_back(boost::make_shared<null_mrb>(frame_size));
+        }
+    }
+    std::vector<boost::shared_ptr<null_mrb> > frames;
+    size_t spp;
+    size_t payload_words32;
+    std::atomic<bool> streaming;
+    size_t packet_count;
+    uint64_t samples_generated;
+    std::chrono::steady_clock::time_point start_time;
+};
+
+struct null_impl::tx_chan_state_type{
+    tx_chan_state_type(const size_t frame_size)
+    {
+        for (size_t i = 0; i < NUM_FRAMES; i++){
+            frames.push_back(boost::make_shared<null_msb>(frame_size));
+        }
+    }
+    std::vector<boost::shared_ptr<null_msb> > frames;
+};
+
+void null_msb::release(void){
+    //commit() already stored the packet length; sink or loop it back
+    if (_queue != nullptr){
+        null_impl::loopback_queue_type *queue =
+            static_cast<null_impl::loopback_queue_type *>(_queue);
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        if (queue->packets.size() >= queue->capacity){
+            //a full queue models a saturated link: drop and count
+            queue->num_dropped++;
+        }
+        else{
+            const size_t num_words32 = (_length + 3)/sizeof(uint32_t);
+            queue->packets.push_back(std::vector<uint32_t>(
+                _mem.begin(), _mem.begin() + num_words32));
+            queue->cond.notify_one();
+        }
+    }
+    _claimed.store(false, std::memory_order_release);
+}
+
+/***********************************************************************
+ * Device implementation
+ **********************************************************************/
+null_impl::null_impl(const device_addr_t &device_addr){
+    UHD_LOG_INFO("NULL", "Opening the null/loopback device...");
+    _type = device::USRP;
+    _num_chans = device_addr.cast<size_t>("num_chans", 1);
+    _frame_size = device_addr.cast<size_t>("frame_size", DEFAULT_FRAME_SIZE);
+    _rate = device_addr.cast<double>("rate", 0.0);
+    _samp_rate = (_rate > 0.0)? _rate : NOMINAL_SAMP_RATE;
+    _loopback = device_addr.has_key("loopback");
+    if (_num_chans == 0 or _frame_size < 64){
+        throw uhd::value_error("null device: bad num_chans or frame_size");
+    }
+
+    for (size_t i = 0; i < _num_chans; i++){
+        _rx_chans.push_back(boost::make_shared<rx_chan_state_type>(_frame_size));
+        _tx_chans.push_back(boost::make_shared<tx_chan_state_type>(_frame_size));
+        _loopback_queues.push_back(boost::make_shared<loopback_queue_type>(
+            device_addr.cast<size_t>("queue_depth", DEFAULT_LOOPBACK_DEPTH)));
+    }
+
+    _tree = property_tree::make();
+    _tree->create<std::string>("/name").set("Null Loopback Device");
+    _tree->create<std::string>("/mboards/0/name").set("null");
+}
+
+null_impl::~null_impl(void){
+    for (size_t i = 0; i < _num_chans; i++){
+        _rx_chans[i]->streaming = false;
+    }
+}
+
+bool null_impl::recv_async_msg(async_metadata_t &, double timeout){
+    //the null device never produces async events (nothing can underflow)
+    std::this_thread::sleep_for(std::chrono::duration<double>(timeout));
+    return false;
+}
+
+/***********************************************************************
+ * Packet generation/sinking
+ **********************************************************************/
+managed_recv_buffer::sptr null_impl::get_recv_buff(
+    const size_t chan, const double timeout
+){
+    rx_chan_state_type &state = *_rx_chans[chan];
+    const auto deadline = std::chrono::steady_clock::now()
+        + std::chrono::duration<double>(timeout);
+
+    //loopback mode: serve whatever tx committed on this channel
+    if (_loopback){
+        loopback_queue_type &queue = *_loopback_queues[chan];
+        std::unique_lock<std::mutex> lock(queue.mutex);
+        if (not queue.cond.wait_until(lock, deadline,
+                [&queue]{return not queue.packets.empty();})){
+            return managed_recv_buffer::sptr();
+        }
+        const std::vector<uint32_t> packet = std::move(queue.packets.front());
+        queue.packets.pop_front();
+        lock.unlock();
+        for (size_t i = 0; i < state.frames.size(); i++){
+            null_mrb *mrb = state.frames[i].get();
+            if (not mrb->try_claim()) continue;
+            std::memcpy(mrb->mem(), &packet.front(),
+                packet.size()*sizeof(uint32_t));
+            return mrb->get_new(packet.size()*sizeof(uint32_t));
+        }
+        return managed_recv_buffer::sptr(); //handler holds every frame
+    }
+
+    //generator mode: wait for a stream command to start us
+    while (not state.streaming.load(std::memory_order_acquire)){
+        if (std::chrono::steady_clock::now() > deadline){
+            return managed_recv_buffer::sptr();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    //throttle to the configured line rate
+    if (_rate > 0.0){
+        const std::chrono::duration<double> target(
+            double(state.samples_generated)/_rate);
+        std::this_thread::sleep_until(state.start_time
+            + std::chrono::duration_cast<
+                std::chrono::steady_clock::duration>(target));
+    }
+
+    //claim a free frame from the pool
+    null_mrb *mrb = nullptr;
+    while (mrb == nullptr){
+        for (size_t i = 0; i < state.frames.size(); i++){
+            if (state.frames[i]->try_claim()){
+                mrb = state.frames[i].get();
+                break;
+            }
+        }
+        if (mrb != nullptr) break;
+        if (std::chrono::steady_clock::now() > deadline){
+            return managed_recv_buffer::sptr();
+        }
+        std::this_thread::yield();
+    }
+
+    //pack a header; the payload bytes are left untouched, the converter
+    //cost downstream is identical either way
+    vrt::if_packet_info_t ifpi;
+    ifpi.packet_type = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+    ifpi.num_payload_words32 = state.payload_words32;
+    ifpi.num_payload_bytes = state.payload_words32*sizeof(uint32_t);
+    ifpi.packet_count = state.packet_count++;
+    ifpi.has_tsf = true;
+    ifpi.tsf = state.samples_generated;
+    vrt::if_hdr_pack_be(mrb->mem(), ifpi);
+    state.samples_generated += state.spp;
+
+    return mrb->get_new(ifpi.num_packet_words32*sizeof(uint32_t));
+}
+
+managed_send_buffer::sptr null_impl::get_send_buff(
+    const size_t chan, const double timeout
+){
+    tx_chan_state_type &state = *_tx_chans[chan];
+    const auto deadline = std::chrono::steady_clock::now()
+        + std::chrono::duration<double>(timeout);
+    while (true){
+        for (size_t i = 0; i < state.frames.size(); i++){
+            if (state.frames[i]->try_claim()){
+                return state.frames[i]->get_new(_frame_size);
+            }
+        }
+        if (std::chrono::steady_clock::now() > deadline){
+            return managed_send_buffer::sptr();
+        }
+        std::this_thread::yield();
+    }
+}
+
+void null_impl::issue_stream_cmd(const size_t chan, const stream_cmd_t &cmd){
+    rx_chan_state_type &state = *_rx_chans[chan];
+    switch (cmd.stream_mode){
+    case stream_cmd_t::STREAM_MODE_STOP_CONTINUOUS:
+        state.streaming.store(false, std::memory_order_release);
+        return;
+    default:
+        UHD_LOG_WARNING("NULL",
+            "finite stream modes not supported, starting continuous stream");
+        //fallthru
+    case stream_cmd_t::STREAM_MODE_START_CONTINUOUS:
+        state.packet_count = 0;
+        state.samples_generated = 0;
+        state.start_time = std::chrono::steady_clock::now();
+        state.streaming.store(true, std::memory_order_release);
+        return;
+    }
+}
+
+/***********************************************************************
+ * Streamers: the real packet handlers over the in-memory transport
+ **********************************************************************/
+rx_streamer::sptr null_impl::get_rx_stream(const stream_args_t &args_){
+    stream_args_t args = args_;
+
+    //setup defaults for unspecified values
+    args.otw_format = args.otw_format.empty()? "sc16" : args.otw_format;
+    args.channels = args.channels.empty()? std::vector<size_t>(1, 0) : args.channels;
+
+    //calculate packet size
+    static const size_t hdr_size = 0
+        + vrt::max_if_hdr_words32*sizeof(uint32_t)
+        - sizeof(vrt::if_packet_info_t().cid) //no class id ever used
+        - sizeof(vrt::if_packet_info_t().tsi) //no int time ever used
+    ;
+    const size_t bpp = _frame_size - hdr_size;
+    const size_t bpi = convert::get_bytes_per_item(args.otw_format);
+    const size_t spp = args.args.cast<size_t>("spp", bpp/bpi);
+
+    //make the new streamer given the samples per packet
+    boost::shared_ptr<sph::recv_packet_streamer> my_streamer =
+        boost::make_shared<sph::recv_packet_streamer>(spp);
+
+    //init some streamer stuff
+    my_streamer->resize(args.channels.size());
+    my_streamer->set_vrt_unpacker(&vrt::if_hdr_unpack_be);
+
+    //set the converter
+    uhd::convert::id_type id;
+    id.input_format = args.otw_format + "_item32_be";
+    id.num_inputs = 1;
+    id.output_format = args.cpu_format;
+    id.num_outputs = 1;
+    my_streamer->set_converter(id);
+
+    //bind callbacks for the handler
+    for (size_t chan_i = 0; chan_i < args.channels.size(); chan_i++){
+        const size_t chan = args.channels[chan_i];
+        if (chan >= _num_chans){
+            throw uhd::value_error("null device: channel out of range");
+        }
+        _rx_chans[chan]->spp = spp;
+        _rx_chans[chan]->payload_words32 = (spp*bpi)/sizeof(uint32_t);
+        my_streamer->set_xport_chan_get_buff(chan_i, boost::bind(
+            &null_impl::get_recv_buff, this, chan, _1), true /*flush*/);
+        my_streamer->set_issue_stream_cmd(chan_i, boost::bind(
+            &null_impl::issue_stream_cmd, this, chan, _1));
+    }
+
+    my_streamer->set_tick_rate(_samp_rate);
+    my_streamer->set_samp_rate(_samp_rate);
+
+    return my_streamer;
+}
+
+tx_streamer::sptr null_impl::get_tx_stream(const stream_args_t &args_){
+    stream_args_t args = args_;
+
+    //setup defaults for unspecified values
+    args.otw_format = args.otw_format.empty()? "sc16" : args.otw_format;
+    args.channels = args.channels.empty()? std::vector<size_t>(1, 0) : args.channels;
+
+    //calculate packet size
+    static const size_t hdr_size = 0
+        + vrt::max_if_hdr_words32*sizeof(uint32_t)
+        - sizeof(vrt::if_packet_info_t().cid) //no class id ever used
+        - sizeof(vrt::if_packet_info_t().tsi) //no int time ever used
+    ;
+    const size_t bpp = _frame_size - hdr_size;
+    const size_t spp = bpp/convert::get_bytes_per_item(args.otw_format);
+
+    //make the new streamer given the samples per packet
+    boost::shared_ptr<sph::send_packet_streamer> my_streamer =
+        boost::make_shared<sph::send_packet_streamer>(spp);
+
+    //init some streamer stuff
+    my_streamer->resize(args.channels.size());
+    my_streamer->set_vrt_packer(&vrt::if_hdr_pack_be);
+
+    //set the converter
+    uhd::convert::id_type id;
+    id.input_format = args.cpu_format;
+    id.num_inputs = 1;
+    id.output_format = args.otw_format + "_item32_be";
+    id.num_outputs = 1;
+    my_streamer->set_converter(id);
+
+    //bind callbacks for the handler
+    for (size_t chan_i = 0; chan_i < args.channels.size(); chan_i++){
+        const size_t chan = args.channels[chan_i];
+        if (chan >= _num_chans){
+            throw uhd::value_error("null device: channel out of range");
+        }
+        if (_loopback){
+            for (size_t i = 0; i < _tx_chans[chan]->frames.size(); i++){
+                _tx_chans[chan]->frames[i]->set_loopback_queue(
+                    _loopback_queues[chan].get());
+            }
+        }
+        my_streamer->set_xport_chan_get_buff(chan_i, boost::bind(
+            &null_impl::get_send_buff, this, chan, _1));
+    }
+
+    my_streamer->set_tick_rate(_samp_rate);
+    my_streamer->set_samp_rate(_samp_rate);
+
+    return my_streamer;
+}
+
+/***********************************************************************
+ * Discovery and factory
+ **********************************************************************/
+static device_addrs_t null_find(const device_addr_t &hint){
+    device_addrs_t null_addrs;
+
+    //never participates in broadcast discovery:
+    //only an explicit type=null hint finds the software device
+    if (hint.get("type", "") != "null") return null_addrs;
+
+    device_addr_t new_addr;
+    new_addr["type"] = "null";
+    new_addr["name"] = hint.get("name", "");
+    null_addrs.push_back(new_addr);
+    return null_addrs;
+}
+
+static device::sptr null_make(const device_addr_t &device_addr){
+    return device::sptr(new null_impl(device_addr));
+}
+
+UHD_STATIC_BLOCK(register_null_device){
+    device::register_device(&null_find, &null_make, device::USRP);
+}
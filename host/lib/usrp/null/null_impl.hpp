@@ -0,0 +1,82 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_NULL_IMPL_HPP
+#define INCLUDED_NULL_IMPL_HPP
+
+#include <uhd/device.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <uhd/types/stream_cmd.hpp>
+#include <uhd/transport/zero_copy.hpp>
+#include <boost/shared_ptr.hpp>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdint.h>
+#include <vector>
+
+/*!
+ * Null/loopback software device.
+ *
+ * A pure software USRP that generates and sinks VRT packets in memory,
+ * discovered only with an explicit type=null hint. The data runs
+ * through the real packet handlers and converters, so the entire host
+ * fastpath (header parsing, alignment, sequence tracking, conversion)
+ * can be benchmarked and regression-tested on machines with no radio
+ * and no NIC.
+ *
+ * Device args:
+ * - num_chans: number of rx/tx channels to expose (default 1)
+ * - frame_size: frame size in bytes for both directions (default 8000)
+ * - rate: line rate in samples/sec, 0 = unthrottled (default 0)
+ * - loopback: when present, packets committed on tx channel N are
+ *   served to rx channel N instead of being generated; without it,
+ *   rx generates packets and tx discards them
+ */
+class null_impl : public uhd::device{
+public:
+    null_impl(const uhd::device_addr_t &device_addr);
+    ~null_impl(void);
+
+    uhd::rx_streamer::sptr get_rx_stream(const uhd::stream_args_t &args);
+    uhd::tx_streamer::sptr get_tx_stream(const uhd::stream_args_t &args);
+    bool recv_async_msg(uhd::async_metadata_t &async_metadata, double timeout);
+
+    //! Bounded packet queue connecting a tx commit to rx generation
+    //! (public so the send buffer's release hook can push into it)
+    struct loopback_queue_type{
+        loopback_queue_type(const size_t capacity_):
+            capacity(capacity_), num_dropped(0){}
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::deque<std::vector<uint32_t> > packets;
+        const size_t capacity;
+        uint64_t num_dropped;
+    };
+
+private:
+    struct rx_chan_state_type; //defined in null_impl.cpp
+    struct tx_chan_state_type; //defined in null_impl.cpp
+
+    uhd::transport::managed_recv_buffer::sptr get_recv_buff(
+        const size_t chan, const double timeout);
+    uhd::transport::managed_send_buffer::sptr get_send_buff(
+        const size_t chan, const double timeout);
+    void issue_stream_cmd(const size_t chan, const uhd::stream_cmd_t &cmd);
+
+    size_t _num_chans;
+    size_t _frame_size;
+    double _rate; //throttle, 0 = unthrottled
+    double _samp_rate; //rate used for timestamp bookkeeping
+    bool _loopback;
+
+    std::vector<boost::shared_ptr<rx_chan_state_type> > _rx_chans;
+    std::vector<boost::shared_ptr<tx_chan_state_type> > _tx_chans;
+    std::vector<boost::shared_ptr<loopback_queue_type> > _loopback_queues;
+};
+
+#endif /* INCLUDED_NULL_IMPL_HPP */
@@ -12,6 +12,7 @@
 #include <stdint.h>
 #include <boost/format.hpp>
 #include <boost/math/special_functions/round.hpp>
+#include <boost/thread/mutex.hpp>
 #include <stdexcept>
 #include <cmath>
 #include <cstdlib>
@@ -108,6 +109,9 @@ public:
     }
 
     void set_dboard_rate(const x300_clock_which_t which, double rate) {
+        //dboard clock methods may be called from parallel radio setup
+        //threads; the register shadow and SPI sequence must not interleave
+        boost::mutex::scoped_lock lock(_dboard_mutex);
         uint16_t div = uint16_t(_vco_freq / rate);
         uint16_t *reg = NULL;
         uint8_t addr = 0xFF;
@@ -152,6 +156,7 @@ public:
 
     double get_dboard_rate(const x300_clock_which_t which)
     {
+        boost::mutex::scoped_lock lock(_dboard_mutex);
         double rate = 0.0;
         switch (which)
         {
@@ -179,6 +184,7 @@ public:
 
     void enable_dboard_clock(const x300_clock_which_t which, const bool enable)
     {
+        boost::mutex::scoped_lock lock(_dboard_mutex);
         switch (which)
         {
         case X300_CLOCK_WHICH_DB0_RX:
@@ -796,6 +802,7 @@ private:
     lmk04816_regs_t         _lmk04816_regs;
     double                  _vco_freq;
     x300_clk_delays         _delays;
+    boost::mutex            _dboard_mutex;
 };
 
 x300_clock_ctrl::sptr x300_clock_ctrl::make(uhd::spi_iface::sptr spiface,
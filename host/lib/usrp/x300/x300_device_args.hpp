@@ -32,7 +32,9 @@ public:
         _niusrprio_rpc_port("niusrprio_rpc_port", NIUSRPRIO_DEFAULT_RPC_PORT),
         _has_fw_file("fw", false),
         _fw_file("fw", ""),
-        _blank_eeprom("blank_eeprom", false)
+        _blank_eeprom("blank_eeprom", false),
+        _use_dpdk("use_dpdk", false),
+        _bond_links("bond_links", false)
     {
         // nop
     }
@@ -92,6 +94,14 @@ public:
     bool get_blank_eeprom() const {
         return _blank_eeprom.get();
     }
+    // true to stream via the DPDK kernel-bypass transport
+    bool get_use_dpdk() const {
+        return _use_dpdk.get();
+    }
+    // true to stripe data streams across both Ethernet links
+    bool get_bond_links() const {
+        return _bond_links.get();
+    }
 
     inline virtual std::string to_string() const {
         return  _master_clock_rate.to_string() + ", " +
@@ -149,6 +159,16 @@ private:
             PARSE_DEFAULT(_fw_file);
         }
         PARSE_DEFAULT(_blank_eeprom)
+        PARSE_DEFAULT(_use_dpdk)
+#ifndef HAVE_DPDK
+        if (_use_dpdk.get()) {
+            UHD_LOG_WARNING("X300",
+                "Cannot use DPDK, this version of UHD was not built with DPDK "
+                "support. Will use regular UDP transport.");
+            _use_dpdk.set(false);
+        }
+#endif
+        PARSE_DEFAULT(_bond_links)
 
         //Sanity check params
         _enforce_discrete(_master_clock_rate, TICK_RATE_OPTIONS);
@@ -175,6 +195,8 @@ private:
     constrained_device_args_t::bool_arg            _has_fw_file;
     constrained_device_args_t::str_arg<true>       _fw_file;
     constrained_device_args_t::bool_arg            _blank_eeprom;
+    constrained_device_args_t::bool_arg            _use_dpdk;
+    constrained_device_args_t::bool_arg            _bond_links;
 };
 
 }}} //namespace
@@ -6,6 +6,8 @@
 //
 
 #include <fstream>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include <boost/algorithm/string.hpp>
@@ -75,6 +77,7 @@ typedef struct {
  */
 typedef struct {
     bool                             found;
+    bool                             progress;  // Print progress to stdout (single-device sessions only)
     bool                             ethernet;
     bool                             configure; // Reload FPGA after burning to flash (Ethernet only)
     bool                             verify;    // Device will verify the download along the way (Ethernet only)
@@ -159,34 +162,11 @@ static void x300_validate_image(x300_session_t &session){
 
 static void x300_setup_session(x300_session_t &session,
                                const device_addr_t &args,
+                               const device_addr_t &dev_addr,
                                const std::string &filepath,
                                const std::string &outpath){
-    device_addrs_t devs = x300_find(args);
-    if(devs.size() == 0){
-        session.found = false;
-        return;
-    }
-    else if(devs.size() > 1){
-        std::string err_msg = "Could not resolve given args to a single X-Series device.\n"
-                              "Applicable devices:\n";
-
-        for(const uhd::device_addr_t &dev:  devs){
-            std::string identifier = dev.has_key("addr") ? "addr"
-                                                         : "resource";
-
-            err_msg += str(boost::format(" * %s (%s=%s)\n")
-                           % dev.get("product", "X3XX")
-                           % identifier
-                           % dev.get(identifier));
-        }
-
-        err_msg += "\nSpecify one of these devices with the given args to load an image onto it.";
-
-        throw uhd::runtime_error(err_msg);
-    }
-
     session.found = true;
-    session.dev_addr = devs[0];
+    session.dev_addr = dev_addr;
     session.ethernet = session.dev_addr.has_key("addr");
     if(session.ethernet){
         session.ip_addr = session.dev_addr["addr"];
@@ -275,19 +255,19 @@ static void x300_ethernet_load(x300_session_t &session){
     uint32_t flags = X300_FPGA_PROG_FLAGS_ACK | X300_FPGA_PROG_FLAGS_INIT;
     size_t len = x300_send_and_recv(session.write_xport, flags, &pkt_out, session.data_in);
     if(x300_recv_ok(pkt_in, len)){
-        std::cout << "-- Initializing FPGA loading..." << std::flush;
+        if(session.progress) std::cout << "-- Initializing FPGA loading..." << std::flush;
     }
     else if(len == 0){
-        std::cout << "failed." << std::endl;
+        if(session.progress) std::cout << "failed." << std::endl;
         throw uhd::runtime_error("Timed out waiting for reply from device.");
     }
     else{
-        std::cout << "failed." << std::endl;
+        if(session.progress) std::cout << "failed." << std::endl;
         throw uhd::runtime_error("Device reported an error during initialization.");
     }
 
-    std::cout << "successful." << std::endl;
-    if(session.verify){
+    if(session.progress) std::cout << "successful." << std::endl;
+    if(session.verify and session.progress){
         std::cout << "-- NOTE: Device is verifying the image it is receiving, increasing the loading time." << std::endl;
     }
 
@@ -299,12 +279,14 @@ static void x300_ethernet_load(x300_session_t &session){
     for(size_t i = 0; i < session.size; i += X300_FLASH_SECTOR_SIZE){
 
         // Print progress percentage at beginning of each sector
-        std::cout << boost::format("\r-- Loading %s FPGA image: %d%% (%d/%d sectors)")
-                     % session.fpga_type
-                     % (int(double(i) / double(session.size) * 100.0))
-                     % (i / X300_FLASH_SECTOR_SIZE)
-                     % sectors
-                 << std::flush;
+        if(session.progress){
+            std::cout << boost::format("\r-- Loading %s FPGA image: %d%% (%d/%d sectors)")
+                         % session.fpga_type
+                         % (int(double(i) / double(session.size) * 100.0))
+                         % (i / X300_FLASH_SECTOR_SIZE)
+                         % sectors
+                     << std::flush;
+        }
 
         // Each packet
         for(size_t j = i; (j < session.size and j < (i+X300_FLASH_SECTOR_SIZE)); j += X300_PACKET_SIZE_BYTES){
@@ -350,45 +332,49 @@ static void x300_ethernet_load(x300_session_t &session){
         image.close();
     }
 
-    std::cout << boost::format("\r-- Loading %s FPGA image: 100%% (%d/%d sectors)")
-                 % session.fpga_type
-                 % sectors
-                 % sectors
-             << std::endl;
+    if(session.progress){
+        std::cout << boost::format("\r-- Loading %s FPGA image: 100%% (%d/%d sectors)")
+                     % session.fpga_type
+                     % sectors
+                     % sectors
+                 << std::endl;
+    }
 
     // Cleanup
     if(!session.lvbitx) image.close();
     flags = (X300_FPGA_PROG_FLAGS_CLEANUP | X300_FPGA_PROG_FLAGS_ACK);
     pkt_out.sector = pkt_out.index = pkt_out.size = 0;
     memset(pkt_out.data8, 0, X300_PACKET_SIZE_BYTES);
-    std::cout << "-- Finalizing image load..." << std::flush;
+    if(session.progress) std::cout << "-- Finalizing image load..." << std::flush;
     len = x300_send_and_recv(session.write_xport, flags, &pkt_out, session.data_in);
     if(len == 0){
-        std::cout << "failed." << std::endl;
+        if(session.progress) std::cout << "failed." << std::endl;
         throw uhd::runtime_error("Timed out waiting for reply from device.");
     }
     else if((ntohl(pkt_in->flags) & X300_FPGA_PROG_FLAGS_ERROR)){
-        std::cout << "failed." << std::endl;
+        if(session.progress) std::cout << "failed." << std::endl;
         throw uhd::runtime_error("Device reported an error during cleanup.");
     }
-    else std::cout << "successful." << std::endl;
+    else if(session.progress) std::cout << "successful." << std::endl;
 
     // Save new FPGA image (if option set)
     if(session.configure){
         flags = (X300_FPGA_PROG_CONFIGURE | X300_FPGA_PROG_FLAGS_ACK);
         x300_send_and_recv(session.write_xport, flags, &pkt_out, session.data_in);
-        std::cout << "-- Saving image onto device..." << std::flush;
+        if(session.progress) std::cout << "-- Saving image onto device..." << std::flush;
         if(len == 0){
-            std::cout << "failed." << std::endl;
+            if(session.progress) std::cout << "failed." << std::endl;
             throw uhd::runtime_error("Timed out waiting for reply from device.");
         }
         else if((ntohl(pkt_in->flags) & X300_FPGA_PROG_FLAGS_ERROR)){
-            std::cout << "failed." << std::endl;
+            if(session.progress) std::cout << "failed." << std::endl;
             throw uhd::runtime_error("Device reported an error while saving the image.");
         }
-        else std::cout << "successful." << std::endl;
+        else if(session.progress) std::cout << "successful." << std::endl;
+    }
+    if(session.progress){
+        std::cout << str(boost::format("Power-cycle the USRP %s to use the new image.") % session.dev_addr.get("product", "")) << std::endl;
     }
-    std::cout << str(boost::format("Power-cycle the USRP %s to use the new image.") % session.dev_addr.get("product", "")) << std::endl;
 }
 
 static void x300_ethernet_read(x300_session_t &session){
@@ -403,18 +389,18 @@ static void x300_ethernet_read(x300_session_t &session){
     uint32_t flags = X300_FPGA_READ_FLAGS_ACK | X300_FPGA_READ_FLAGS_INIT;
     size_t len = x300_send_and_recv(session.read_xport, flags, &pkt_out, session.data_in);
     if(x300_recv_ok(pkt_in, len)){
-        std::cout << "-- Initializing FPGA reading..." << std::flush;
+        if(session.progress) std::cout << "-- Initializing FPGA reading..." << std::flush;
     }
     else if(len == 0){
-        std::cout << "failed." << std::endl;
+        if(session.progress) std::cout << "failed." << std::endl;
         throw uhd::runtime_error("Timed out waiting for reply from device.");
     }
     else{
-        std::cout << "failed." << std::endl;
+        if(session.progress) std::cout << "failed." << std::endl;
         throw uhd::runtime_error("Device reported an error during initialization.");
     }
 
-    std::cout << "successful." << std::endl;
+    if(session.progress) std::cout << "successful." << std::endl;
 
     // Read the first packet
     // Acknowledge receipt of the FPGA image data
@@ -453,7 +439,7 @@ static void x300_ethernet_read(x300_session_t &session){
     {
         if (pkt_in->data8[i] != X300_FPGA_BIT_HEADER[i])
         {
-            std::cout << "-- No *.bit header detected, FPGA image is a raw stream (*.bin)!" << std::endl;
+            if(session.progress) std::cout << "-- No *.bit header detected, FPGA image is a raw stream (*.bin)!" << std::endl;
             image_size = X300_FPGA_BIN_SIZE_BYTES;
             sectors = (image_size / X300_FLASH_SECTOR_SIZE);
             extension = std::string(".bin");
@@ -463,8 +449,10 @@ static void x300_ethernet_read(x300_session_t &session){
 
     session.outpath += extension;
     std::ofstream image(session.outpath.c_str(), std::ios::binary);
-    std::cout << boost::format("-- Output FPGA file: %s\n")
-                 % session.outpath;
+    if(session.progress){
+        std::cout << boost::format("-- Output FPGA file: %s\n")
+                     % session.outpath;
+    }
 
     // Write the first packet
     image.write((char*)pkt_in->data8, X300_PACKET_SIZE_BYTES);
@@ -474,12 +462,14 @@ static void x300_ethernet_read(x300_session_t &session){
     for(size_t i = 0; i < image_size; i += X300_FLASH_SECTOR_SIZE){
 
         // Once we determine the image size, print the progress percentage
-        std::cout << boost::format("\r-- Reading %s FPGA image: %d%% (%d/%d sectors)")
-                     % session.fpga_type
-                     % (int(double(i) / double(image_size) * 100.0))
-                     % (i / X300_FLASH_SECTOR_SIZE)
-                     % sectors
-                  << std::flush;
+        if(session.progress){
+            std::cout << boost::format("\r-- Reading %s FPGA image: %d%% (%d/%d sectors)")
+                         % session.fpga_type
+                         % (int(double(i) / double(image_size) * 100.0))
+                         % (i / X300_FLASH_SECTOR_SIZE)
+                         % sectors
+                      << std::flush;
+        }
 
         // Each packet
         while (pkt_count < image_size and pkt_count < (i + X300_FLASH_SECTOR_SIZE))
@@ -525,46 +515,66 @@ static void x300_ethernet_read(x300_session_t &session){
         pkt_count = i + X300_FLASH_SECTOR_SIZE;
     }
 
-    std::cout << boost::format("\r-- Reading %s FPGA image: 100%% (%d/%d sectors)")
-                 % session.fpga_type
-                 % sectors
-                 % sectors
-              << std::endl;
+    if(session.progress){
+        std::cout << boost::format("\r-- Reading %s FPGA image: 100%% (%d/%d sectors)")
+                     % session.fpga_type
+                     % sectors
+                     % sectors
+                  << std::endl;
+    }
 
     // Cleanup
     image.close();
     flags = (X300_FPGA_READ_FLAGS_CLEANUP | X300_FPGA_READ_FLAGS_ACK);
     pkt_out.sector = pkt_out.index = pkt_out.size = 0;
     memset(pkt_out.data8, 0, X300_PACKET_SIZE_BYTES);
-    std::cout << "-- Finalizing image read for verification..." << std::flush;
+    if(session.progress) std::cout << "-- Finalizing image read for verification..." << std::flush;
     len = x300_send_and_recv(session.read_xport, flags, &pkt_out, session.data_in);
     if(len == 0){
-        std::cout << "failed." << std::endl;
+        if(session.progress) std::cout << "failed." << std::endl;
         throw uhd::runtime_error("Timed out waiting for reply from device.");
     }
     else if((ntohl(pkt_in->flags) & X300_FPGA_READ_FLAGS_ERROR)){
-        std::cout << "failed." << std::endl;
+        if(session.progress) std::cout << "failed." << std::endl;
         throw uhd::runtime_error("Device reported an error during cleanup.");
     }
-    else std::cout << "successful image read." << std::endl;
+    else if(session.progress) std::cout << "successful image read." << std::endl;
 }
 
 static void x300_pcie_load(x300_session_t &session){
 
-    std::cout << boost::format("\r-- Loading %s FPGA image (this will take 5-10 minutes)...")
-                 % session.fpga_type
-             << std::flush;
+    if(session.progress){
+        std::cout << boost::format("\r-- Loading %s FPGA image (this will take 5-10 minutes)...")
+                     % session.fpga_type
+                 << std::flush;
+    }
 
     nirio_status status = NiRio_Status_Success;
     niusrprio::niusrprio_session fpga_session(session.resource, session.rpc_port);
     nirio_status_chain(fpga_session.download_bitstream_to_flash(session.filepath), status);
 
     if(nirio_status_fatal(status)){
-        std::cout << "failed." << std::endl;
+        if(session.progress) std::cout << "failed." << std::endl;
         niusrprio::nirio_status_to_exception(status, "NI-RIO reported the following error:");
     }
-    else std::cout << "successful." << std::endl;
-    std::cout << str(boost::format("Power-cycle the USRP %s to use the new image.") % session.dev_addr.get("product", "")) << std::endl;
+    else if(session.progress) std::cout << "successful." << std::endl;
+    if(session.progress){
+        std::cout << str(boost::format("Power-cycle the USRP %s to use the new image.") % session.dev_addr.get("product", "")) << std::endl;
+    }
+}
+
+static void x300_run_session(x300_session_t &session,
+                             const image_loader::image_loader_args_t &image_loader_args){
+    // Download the FPGA image to a file
+    if(image_loader_args.download) {
+        if(session.progress) std::cout << "Attempting to download the FPGA image ..." << std::endl;
+        x300_ethernet_read(session);
+    }
+
+    if (not image_loader_args.load_fpga) return;
+
+    if (session.ethernet) x300_ethernet_load(session);
+    else                  x300_pcie_load(session);
 }
 
 static bool x300_image_loader(const image_loader::image_loader_args_t &image_loader_args){
@@ -573,30 +583,72 @@ static bool x300_image_loader(const image_loader::image_loader_args_t &image_loa
 
     if (devs.size() == 0) return false;
 
-    x300_session_t session;
-    x300_setup_session(session,
-                       image_loader_args.args,
-                       image_loader_args.fpga_path,
-                       image_loader_args.out_path);
-
-    if(!session.found) return false;
-
-    std::cout << boost::format("Unit: USRP %s (%s, %s)\nFPGA Image: %s\n")
-                 % session.dev_addr["product"]
-                 % session.dev_addr["serial"]
-                 % session.dev_addr[session.ethernet ? "addr" : "resource"]
-                 % session.filepath;
+    // One session per device found; the per-device messages are printed
+    // up front so the concurrent flash below has a quiet console.
+    std::vector<x300_session_t> sessions(devs.size());
+    for(size_t i = 0; i < devs.size(); i++){
+        x300_setup_session(sessions[i],
+                           image_loader_args.args,
+                           devs[i],
+                           image_loader_args.fpga_path,
+                           image_loader_args.out_path);
+
+        // Sector-by-sector progress only makes sense for a single device
+        sessions[i].progress = (devs.size() == 1);
+
+        // Keep downloaded images from clobbering each other
+        if(image_loader_args.download and devs.size() > 1){
+            sessions[i].outpath += "_" + sessions[i].dev_addr.get("serial", "");
+        }
 
-    // Download the FPGA image to a file
-    if(image_loader_args.download) {
-        std::cout << "Attempting to download the FPGA image ..." << std::endl;
-        x300_ethernet_read(session);
+        std::cout << boost::format("Unit: USRP %s (%s, %s)\nFPGA Image: %s\n")
+                     % sessions[i].dev_addr["product"]
+                     % sessions[i].dev_addr["serial"]
+                     % sessions[i].dev_addr[sessions[i].ethernet ? "addr" : "resource"]
+                     % sessions[i].filepath;
+    }
+
+    if(sessions.size() == 1){
+        x300_run_session(sessions[0], image_loader_args);
+        return true;
+    }
+
+    // Concurrent flashing of multiple devices: each session has its own
+    // transport, so the devices proceed independently of each other.
+    std::mutex cout_mutex;
+    std::vector<std::string> errors(sessions.size());
+    std::vector<std::thread> threads;
+    for(size_t i = 0; i < sessions.size(); i++){
+        threads.push_back(std::thread([i, &sessions, &image_loader_args, &cout_mutex, &errors](){
+            const std::string serial = sessions[i].dev_addr.get("serial", "");
+            try {
+                x300_run_session(sessions[i], image_loader_args);
+                std::lock_guard<std::mutex> lock(cout_mutex);
+                std::cout << boost::format("-- %s: Image load successful. Power-cycle the device to use the new image.")
+                             % serial
+                          << std::endl;
+            } catch (const std::exception &ex) {
+                errors[i] = ex.what();
+                std::lock_guard<std::mutex> lock(cout_mutex);
+                std::cout << boost::format("-- %s: Image load failed.") % serial << std::endl;
+            }
+        }));
+    }
+    for(size_t i = 0; i < threads.size(); i++){
+        threads[i].join();
     }
 
-    if (not image_loader_args.load_fpga) return true;
-
-    if (session.ethernet) x300_ethernet_load(session);
-    else                  x300_pcie_load(session);
+    std::string error_msg;
+    for(size_t i = 0; i < sessions.size(); i++){
+        if(not errors[i].empty()){
+            error_msg += str(boost::format("%s: %s\n")
+                             % sessions[i].dev_addr.get("serial", "")
+                             % errors[i]);
+        }
+    }
+    if(not error_msg.empty()){
+        throw uhd::runtime_error("Image load failed on the following devices:\n" + error_msg);
+    }
 
     return true;
 }
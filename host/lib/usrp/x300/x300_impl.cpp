@@ -10,6 +10,7 @@
 #include "x310_lvbitx.hpp"
 #include "x300_mb_eeprom_iface.hpp"
 #include <uhdlib/usrp/common/apply_corrections.hpp>
+#include <uhdlib/utils/init_profiler.hpp>
 #include <uhd/utils/static.hpp>
 #include <uhd/utils/log.hpp>
 #include <uhd/utils/paths.hpp>
@@ -19,6 +20,10 @@
 #include <uhd/transport/udp_zero_copy.hpp>
 #include <uhd/transport/udp_constants.hpp>
 #include <uhd/transport/zero_copy_recv_offload.hpp>
+#include <uhd/transport/bonded_zero_copy.hpp>
+#ifdef HAVE_DPDK
+#include <uhdlib/transport/dpdk_zero_copy.hpp>
+#endif
 #include <uhd/transport/nirio_zero_copy.hpp>
 #include <uhd/transport/nirio/niusrprio_session.h>
 #include <uhd/utils/platform.hpp>
@@ -31,8 +36,12 @@
 #include <boost/make_shared.hpp>
 #include <boost/functional/hash.hpp>
 #include <boost/assign/list_of.hpp>
+#include <boost/thread/mutex.hpp>
+#include <exception>
 #include <fstream>
+#include <functional>
 #include <chrono>
+#include <future>
 #include <thread>
 
 using namespace uhd;
@@ -320,7 +329,10 @@ device_addrs_t x300_find(const device_addr_t &hint_)
 
     if (!hint.has_key("resource"))
     {
-        //otherwise, no address was specified, send a broadcast on each interface
+        //otherwise, no address was specified, send a broadcast on each
+        //interface; the probes run concurrently so many interfaces share
+        //one discovery deadline instead of summing their timeouts
+        std::vector<std::future<device_addrs_t>> find_tasks;
         for(const if_addrs_t &if_addrs:  get_if_addrs())
         {
             //avoid the loopback device
@@ -330,19 +342,27 @@ device_addrs_t x300_find(const device_addr_t &hint_)
             device_addr_t new_hint = hint;
             new_hint["addr"] = if_addrs.bcast;
 
-            //call discover with the new hint and append results
-            device_addrs_t new_addrs = x300_find(new_hint);
+            //call discover with the new hint in a separate thread
+            find_tasks.emplace_back(std::async(std::launch::async,
+                [new_hint](){
+                    return x300_find(new_hint);
+                }
+            ));
+        }
+        bool found_serial = false;
+        for (auto &find_task : find_tasks)
+        {
+            const device_addrs_t new_addrs = find_task.get();
             //if we are looking for a serial, only add the one device with a matching serial
             if (hint.has_key("serial")) {
-                bool found_serial = false; //signal to break out of the interface loop
-                for (device_addrs_t::iterator new_addr_it=new_addrs.begin(); new_addr_it != new_addrs.end(); new_addr_it++) {
+                if (found_serial) continue; //just join the remaining tasks
+                for (device_addrs_t::const_iterator new_addr_it=new_addrs.begin(); new_addr_it != new_addrs.end(); new_addr_it++) {
                     if ((*new_addr_it)["serial"] == hint["serial"]) {
                         addrs.insert(addrs.begin(), *new_addr_it);
                         found_serial = true;
                         break;
                     }
                 }
-                if (found_serial) break;
             } else {
                 // Otherwise, add all devices we find
                 addrs.insert(addrs.begin(), new_addrs.begin(), new_addrs.end());
@@ -541,12 +561,143 @@ void x300_impl::mboard_members_t::discover_eth(
         throw uhd::assertion_error("X300 Initialization Error: No ethernet interfaces specified.");
 }
 
+/***********************************************************************
+ * Init stage dependency graph
+ *
+ * The back half of setup_mb is a handful of stages with an explicit
+ * dependency structure: clocking must come before anything that runs on
+ * the radio clock, but the property tree and sensor population have no
+ * business waiting for the LMK to lock. Stages run as async tasks that
+ * block on their dependencies' futures, so independent stages overlap
+ * and the overall time approaches the critical path instead of the sum.
+ *
+ * After the run, the graph logs a per-stage trace and the critical path
+ * at DEBUG level so a slow bring-up can be pinned to the stage chain
+ * that actually gated it.
+ **********************************************************************/
+namespace {
+    class init_task_graph{
+    public:
+        typedef std::function<void(void)> stage_fcn_type;
+
+        //! Add a stage; dependencies must refer to already-added stages
+        size_t add_stage(
+            const std::string &name,
+            const std::vector<size_t> &deps,
+            const stage_fcn_type &fcn
+        ){
+            stage_type stage;
+            stage.name = name;
+            stage.deps = deps;
+            stage.fcn = fcn;
+            _stages.push_back(stage);
+            return _stages.size() - 1;
+        }
+
+        //! Run all stages; rethrows the first stage error after the join
+        void run(const std::string &label){
+            const time_point t0 = std::chrono::steady_clock::now();
+            std::vector<std::shared_future<void>> futures;
+            for (size_t i = 0; i < _stages.size(); i++){
+                stage_type &stage = _stages.at(i);
+                std::vector<std::shared_future<void>> dep_futures;
+                for (const size_t dep : stage.deps){
+                    dep_futures.push_back(futures.at(dep));
+                }
+                futures.push_back(std::async(std::launch::async,
+                    [&stage, dep_futures, t0](){
+                        //a failed dependency rethrows here, so the stage
+                        //body never runs on top of a broken prerequisite
+                        for (const auto &dep : dep_futures) dep.get();
+                        stage.start_ms = ms_since(t0);
+                        stage.fcn();
+                        stage.stop_ms = ms_since(t0);
+                        stage.ran = true;
+                    }
+                ).share());
+            }
+            //every stage must be joined before we leave - they reference
+            //caller stack state - so collect the first error and rethrow
+            //only after the last future is done
+            std::exception_ptr error;
+            for (auto &future : futures){
+                try{
+                    future.get();
+                }
+                catch(...){
+                    if (not error) error = std::current_exception();
+                }
+            }
+            log_trace(label);
+            if (error) std::rethrow_exception(error);
+        }
+
+    private:
+        typedef std::chrono::steady_clock::time_point time_point;
+
+        struct stage_type{
+            std::string name;
+            std::vector<size_t> deps;
+            stage_fcn_type fcn;
+            double start_ms = 0.0;
+            double stop_ms = 0.0;
+            bool ran = false;
+        };
+
+        static double ms_since(const time_point &t0){
+            return std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - t0).count();
+        }
+
+        void log_trace(const std::string &label){
+            for (const stage_type &stage : _stages){
+                if (not stage.ran){
+                    UHD_LOGGER_DEBUG("X300") << label
+                        << " init stage " << stage.name << ": did not run";
+                    continue;
+                }
+                UHD_LOGGER_DEBUG("X300") << label
+                    << boost::format(" init stage %s: start %.1f ms, took %.1f ms")
+                       % stage.name % stage.start_ms
+                       % (stage.stop_ms - stage.start_ms);
+            }
+            //walk back from the last stage to finish along the
+            //latest-finishing dependency at each hop
+            size_t tail = 0;
+            double total_ms = 0.0;
+            for (size_t i = 0; i < _stages.size(); i++){
+                if (not _stages[i].ran) return; //incomplete run, no path
+                if (_stages[i].stop_ms > _stages[tail].stop_ms) tail = i;
+                total_ms = std::max(total_ms, _stages[i].stop_ms);
+            }
+            std::string path = _stages[tail].name;
+            while (not _stages[tail].deps.empty()){
+                size_t next = _stages[tail].deps.front();
+                for (const size_t dep : _stages[tail].deps){
+                    if (_stages[dep].stop_ms > _stages[next].stop_ms) next = dep;
+                }
+                tail = next;
+                path = _stages[tail].name + " -> " + path;
+            }
+            UHD_LOGGER_DEBUG("X300") << label
+                << boost::format(" init critical path (%.1f ms): ") % total_ms
+                << path;
+        }
+
+        std::vector<stage_type> _stages;
+    };
+}
+
 void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t &dev_addr)
 {
     const fs_path mb_path = fs_path("/mboards") / mb_i;
     mboard_members_t &mb = _mb[mb_i];
     mb.initialization_done = false;
 
+    //time the init phases for cold-start regression hunting
+    uhd::init_profiler profiler("X300 mb" + std::to_string(mb_i));
+    profiler.enter_phase("transport setup");
+
     const std::string thread_id(
         boost::lexical_cast<std::string>(boost::this_thread::get_id())
     );
@@ -627,6 +778,7 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t &dev_addr)
     }
 
     //create basic communication
+    profiler.enter_phase("basic communication");
     UHD_LOGGER_DEBUG("X300") << "Setting up basic communication...";
     if (mb.xport_path == "nirio") {
         boost::mutex::scoped_lock lock(pcie_zpu_iface_registry_mutex);
@@ -642,6 +794,7 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t &dev_addr)
     }
 
     // Claim device
+    profiler.enter_phase("claim");
     if (not try_to_claim(mb.zpu_ctrl)) {
         throw uhd::runtime_error("Failed to claim device");
     }
@@ -649,6 +802,7 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t &dev_addr)
 
     //extract the FW path for the X300
     //and live load fw over ethernet link
+    profiler.enter_phase("firmware load");
     if (mb.args.has_fw_file()) {
         const std::string x300_fw_image =
             find_image_path(mb.args.get_fw_file());
@@ -657,6 +811,7 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t &dev_addr)
 
     //check compat numbers
     //check fpga compat before fw compat because the fw is a subset of the fpga image
+    profiler.enter_phase("compat checks");
     this->check_fpga_compat(mb_path, mb);
     this->check_fw_compat(mb_path, mb);
 
@@ -696,6 +851,7 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t &dev_addr)
     ////////////////////////////////////////////////////////////////////
     // setup the mboard eeprom
     ////////////////////////////////////////////////////////////////////
+    profiler.enter_phase("eeprom and frame sizes");
     UHD_LOGGER_DEBUG("X300") << "Loading values from EEPROM...";
     x300_mb_eeprom_iface::sptr eeprom16 =
         x300_mb_eeprom_iface::make(mb.zpu_ctrl, mb.zpu_i2c);
@@ -704,54 +860,19 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t &dev_addr)
         eeprom16->write_eeprom(0x50, 0, byte_vector_t(256, 0xff));
     }
 
-    const mboard_eeprom_t mb_eeprom = get_mb_eeprom(eeprom16);
-    _tree->create<mboard_eeprom_t>(mb_path / "eeprom")
-        // Initialize the property with a current copy of the EEPROM contents
-        .set(mb_eeprom)
-        // Whenever this property is written, update the chip
-        .add_coerced_subscriber(
-            [this, eeprom16](const mboard_eeprom_t &mb_eeprom){
-                this->set_mb_eeprom(eeprom16, mb_eeprom);
-            }
-        )
-    ;
-
-    if (mb.args.get_recover_mb_eeprom()) {
-        UHD_LOGGER_WARNING("X300") << "UHD is operating in EEPROM Recovery Mode which disables hardware version "
-                            "checks.\nOperating in this mode may cause hardware damage and unstable "
-                            "radio performance!";
-        return;
-    }
+    // The EEPROM readout happens over slow I2C and contributes a constant
+    // multi-hundred-ms chunk to every open. Kick it off on a worker thread
+    // and overlap it with the path MTU probing below; the future is joined
+    // right before the EEPROM contents are first needed.
+    std::future<mboard_eeprom_t> mb_eeprom_fut =
+        std::async(std::launch::async, [eeprom16](){
+            return x300_impl::get_mb_eeprom(eeprom16);
+        });
 
     ////////////////////////////////////////////////////////////////////
-    // parse the product number
-    ////////////////////////////////////////////////////////////////////
-    std::string product_name = "X300?";
-    switch (get_mb_type_from_eeprom(mb_eeprom)) {
-        case USRP_X300_MB:
-            product_name = "X300";
-            break;
-        case USRP_X310_MB:
-            product_name = "X310";
-            break;
-        default:
-            if (not mb.args.get_recover_mb_eeprom())
-                throw uhd::runtime_error("Unrecognized product type.\n"
-                                         "Either the software does not support this device in which case please update your driver software to the latest version and retry OR\n"
-                                         "The product code in the EEPROM is corrupt and may require reprogramming.");
-    }
-    _tree->create<std::string>(mb_path / "name").set(product_name);
-    _tree->create<std::string>(mb_path / "codename").set("Yetti");
-
-    ////////////////////////////////////////////////////////////////////
-    // discover ethernet interfaces, frame sizes, and link rates
+    // determine max frame sizes (overlapped with the EEPROM readout)
     ////////////////////////////////////////////////////////////////////
     if (mb.xport_path == "eth" ) {
-        double link_max_rate = 0.0;
-
-        // Discover ethernet interfaces
-        mb.discover_eth(mb_eeprom, eth_addrs);
-
         /* This is an ETH connection. Figure out what the maximum supported frame
          * size is for the transport in the up and down directions. The frame size
          * depends on the host PC's NIC's MTU settings. To determine the frame size,
@@ -779,8 +900,23 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t &dev_addr)
             const std::string mtu_tool("ifconfig");
         #endif
 
+        // A previous session may have recorded the probed path MTU in the
+        // discovery cache; reuse it (clamped to the requested ceiling)
+        // instead of probing the path again
+        if (dev_addr.has_key("path_mtu_recv") and dev_addr.has_key("path_mtu_send")) {
+            _max_frame_sizes.recv_frame_size = std::min(
+                dev_addr.cast<size_t>("path_mtu_recv", x300::DATA_FRAME_MAX_SIZE),
+                req_max_frame_size.recv_frame_size);
+            _max_frame_sizes.send_frame_size = std::min(
+                dev_addr.cast<size_t>("path_mtu_send", x300::DATA_FRAME_MAX_SIZE),
+                req_max_frame_size.send_frame_size);
+            UHD_LOGGER_DEBUG("X300")
+                << "Using cached path MTU: recv frame size "
+                << _max_frame_sizes.recv_frame_size
+                << ", send frame size " << _max_frame_sizes.send_frame_size;
+        }
         // Detect the frame size on the path to the USRP
-        try {
+        else try {
             frame_size_t pri_frame_sizes = determine_max_frame_size(
                 eth_addrs.at(0), req_max_frame_size
             );
@@ -803,6 +939,17 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t &dev_addr)
                     sec_frame_sizes.send_frame_size
                 );
             }
+
+            // Record the probe result so that cache-enabled sessions can
+            // skip the probing next time
+            if (dev_addr.has_key("cache") and dev_addr.has_key("serial")) {
+                device_addr_t cache_entry(dev_addr);
+                cache_entry["path_mtu_recv"] =
+                    std::to_string(_max_frame_sizes.recv_frame_size);
+                cache_entry["path_mtu_send"] =
+                    std::to_string(_max_frame_sizes.send_frame_size);
+                device::update_discovery_cache(cache_entry);
+            }
         } catch(std::exception &e) {
             UHD_LOGGER_ERROR("X300") << e.what() ;
         }
@@ -813,9 +960,9 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t &dev_addr)
                 << boost::format("You requested a receive frame size of (%lu) but your NIC's max frame size is (%lu).")
                 % req_max_frame_size.recv_frame_size
                 % _max_frame_sizes.recv_frame_size
-                
+
                 << boost::format("Please verify your NIC's MTU setting using '%s' or set the recv_frame_size argument appropriately.")
-                % mtu_tool 
+                % mtu_tool
                 << "UHD will use the auto-detected max frame size for this connection."
                 ;
         }
@@ -826,12 +973,62 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t &dev_addr)
                 << boost::format("You requested a send frame size of (%lu) but your NIC's max frame size is (%lu).")
                 % req_max_frame_size.send_frame_size
                 % _max_frame_sizes.send_frame_size
-                
+
                 << boost::format("Please verify your NIC's MTU setting using '%s' or set the send_frame_size argument appropriately.")
-                % mtu_tool 
+                % mtu_tool
                 << "UHD will use the auto-detected max frame size for this connection."
                 ;
         }
+    }
+
+    const mboard_eeprom_t mb_eeprom = mb_eeprom_fut.get();
+    _tree->create<mboard_eeprom_t>(mb_path / "eeprom")
+        // Initialize the property with a current copy of the EEPROM contents
+        .set(mb_eeprom)
+        // Whenever this property is written, update the chip
+        .add_coerced_subscriber(
+            [this, eeprom16](const mboard_eeprom_t &mb_eeprom){
+                this->set_mb_eeprom(eeprom16, mb_eeprom);
+            }
+        )
+    ;
+
+    if (mb.args.get_recover_mb_eeprom()) {
+        UHD_LOGGER_WARNING("X300") << "UHD is operating in EEPROM Recovery Mode which disables hardware version "
+                            "checks.\nOperating in this mode may cause hardware damage and unstable "
+                            "radio performance!";
+        return;
+    }
+
+    ////////////////////////////////////////////////////////////////////
+    // parse the product number
+    ////////////////////////////////////////////////////////////////////
+    std::string product_name = "X300?";
+    switch (get_mb_type_from_eeprom(mb_eeprom)) {
+        case USRP_X300_MB:
+            product_name = "X300";
+            break;
+        case USRP_X310_MB:
+            product_name = "X310";
+            break;
+        default:
+            if (not mb.args.get_recover_mb_eeprom())
+                throw uhd::runtime_error("Unrecognized product type.\n"
+                                         "Either the software does not support this device in which case please update your driver software to the latest version and retry OR\n"
+                                         "The product code in the EEPROM is corrupt and may require reprogramming.");
+    }
+    _tree->create<std::string>(mb_path / "name").set(product_name);
+    _tree->create<std::string>(mb_path / "codename").set("Yetti");
+
+    ////////////////////////////////////////////////////////////////////
+    // discover ethernet interfaces, frame sizes, and link rates
+    ////////////////////////////////////////////////////////////////////
+    profiler.enter_phase("ethernet discovery");
+    if (mb.xport_path == "eth" ) {
+        double link_max_rate = 0.0;
+
+        // Discover ethernet interfaces
+        mb.discover_eth(mb_eeprom, eth_addrs);
 
         // Check frame sizes
         for (auto conn : mb.eth_conns)
@@ -910,67 +1107,91 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t &dev_addr)
     }
 
     ////////////////////////////////////////////////////////////////////
-    // create clock control objects
+    // the remaining init is an explicit dependency graph: clocking must
+    // gate the radios, but the property tree and sensor stages have no
+    // reason to wait for the LMK to lock
     ////////////////////////////////////////////////////////////////////
-    UHD_LOGGER_DEBUG("X300") << "Setting up RF frontend clocking...";
+    profiler.enter_phase("init dependency graph");
+    init_task_graph init_graph;
+    std::vector<rfnoc::block_id_t> radio_ids;
 
     //Initialize clock control registers. NOTE: This does not configure the LMK yet.
-    mb.clock = x300_clock_ctrl::make(mb.zpu_spi,
-        1 /*slaveno*/,
-        mb.hw_rev,
-        mb.args.get_master_clock_rate(),
-        mb.args.get_dboard_clock_rate(),
-        mb.args.get_system_ref_rate()
-    );
-    mb.fw_regmap->ref_freq_reg.write(
-        fw_regmap_t::ref_freq_reg_t::REF_FREQ,
-        uint32_t(mb.args.get_system_ref_rate())
-    );
+    const size_t stage_clock_ctrl = init_graph.add_stage(
+        "clock_ctrl", {}, [this, &mb](){
+        UHD_LOGGER_DEBUG("X300") << "Setting up RF frontend clocking...";
+        mb.clock = x300_clock_ctrl::make(mb.zpu_spi,
+            1 /*slaveno*/,
+            mb.hw_rev,
+            mb.args.get_master_clock_rate(),
+            mb.args.get_dboard_clock_rate(),
+            mb.args.get_system_ref_rate()
+        );
+        mb.fw_regmap->ref_freq_reg.write(
+            fw_regmap_t::ref_freq_reg_t::REF_FREQ,
+            uint32_t(mb.args.get_system_ref_rate())
+        );
+    });
 
     //Initialize clock source to use internal reference and generate
     //a valid radio clock. This may change after configuration is done.
     //This will configure the LMK and wait for lock
-    update_clock_source(mb, mb.args.get_clock_source());
-
-    ////////////////////////////////////////////////////////////////////
-    // create clock properties
-    ////////////////////////////////////////////////////////////////////
-    _tree->create<double>(mb_path / "master_clock_rate")
-        .set_publisher(boost::bind(&x300_clock_ctrl::get_master_clock_rate, mb.clock))
-    ;
-
-    UHD_LOGGER_INFO("X300")
-        << "Radio 1x clock: " << (mb.clock->get_master_clock_rate()/1e6)
-        << " MHz";
+    const size_t stage_clock_config = init_graph.add_stage(
+        "clock_config", {stage_clock_ctrl}, [this, &mb](){
+        update_clock_source(mb, mb.args.get_clock_source());
+        UHD_LOGGER_INFO("X300")
+            << "Radio 1x clock: " << (mb.clock->get_master_clock_rate()/1e6)
+            << " MHz";
+    });
 
     ////////////////////////////////////////////////////////////////////
-    // Create the GPSDO control
+    // Create the GPSDO control and misc mboard sensors
     ////////////////////////////////////////////////////////////////////
+    init_graph.add_stage("gpsdo_sensors", {}, [this, &mb, mb_path](){
     static const uint32_t dont_look_for_gpsdo = 0x1234abcdul;
 
     //otherwise if not disabled, look for the internal GPSDO
     if (mb.zpu_ctrl->peek32(SR_ADDR(X300_FW_SHMEM_BASE, X300_FW_SHMEM_GPSDO_STATUS)) != dont_look_for_gpsdo)
     {
-        UHD_LOG_DEBUG("X300", "Detecting internal GPSDO....");
-        try {
-            // gps_ctrl will print its own log statements if a GPSDO was found
-            mb.gps = gps_ctrl::make(x300_make_uart_iface(mb.zpu_ctrl));
-        }
-        catch(std::exception &e) {
-            UHD_LOGGER_ERROR("X300")
-                << "An error occurred making GPSDO control: " << e.what();
-        }
-        if (mb.gps and mb.gps->gps_detected()) {
-            for(const std::string& name : mb.gps->get_sensors()) {
-                _tree->create<sensor_value_t>(mb_path / "sensors" / name)
-                    .set_publisher(boost::bind(&gps_ctrl::get_sensor, mb.gps, name));
+        //defer the actual detection until the sensors are first queried;
+        //probing the GPSDO UART is slow and a streaming-only application
+        //never needs it
+        _tree->register_lazy_subtree(mb_path / "sensors", [this, &mb, mb_path](){
+            UHD_LOG_DEBUG("X300", "Detecting internal GPSDO....");
+            try {
+                // gps_ctrl will print its own log statements if a GPSDO was found
+                mb.gps = gps_ctrl::make(x300_make_uart_iface(mb.zpu_ctrl));
             }
-        }
-        else {
-            mb.zpu_ctrl->poke32(SR_ADDR(X300_FW_SHMEM_BASE, X300_FW_SHMEM_GPSDO_STATUS), dont_look_for_gpsdo);
-        }
+            catch(std::exception &e) {
+                UHD_LOGGER_ERROR("X300")
+                    << "An error occurred making GPSDO control: " << e.what();
+            }
+            if (mb.gps and mb.gps->gps_detected()) {
+                for(const std::string& name : mb.gps->get_sensors()) {
+                    _tree->create<sensor_value_t>(mb_path / "sensors" / name)
+                        .set_publisher(boost::bind(&gps_ctrl::get_sensor, mb.gps, name));
+                }
+            }
+            else {
+                mb.zpu_ctrl->poke32(SR_ADDR(X300_FW_SHMEM_BASE, X300_FW_SHMEM_GPSDO_STATUS), dont_look_for_gpsdo);
+            }
+        });
     }
 
+    _tree->create<sensor_value_t>(mb_path / "sensors" / "ref_locked")
+        .set_publisher(boost::bind(&x300_impl::get_ref_locked, this, mb));
+    });
+
+    ////////////////////////////////////////////////////////////////////
+    // create clock and time properties
+    // (the clock object carries its configured rates from construction,
+    // so this stage needs the clock_ctrl object, not a locked LMK)
+    ////////////////////////////////////////////////////////////////////
+    init_graph.add_stage(
+        "clock_time_props", {stage_clock_ctrl}, [this, &mb, mb_path](){
+    _tree->create<double>(mb_path / "master_clock_rate")
+        .set_publisher(boost::bind(&x300_clock_ctrl::get_master_clock_rate, mb.clock))
+    ;
+
     ////////////////////////////////////////////////////////////////////
     // setup time sources and properties
     ////////////////////////////////////////////////////////////////////
@@ -1045,14 +1266,14 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t &dev_addr)
         })
         .set(master_clock_rate)
     ;
-
-    ////////////////////////////////////////////////////////////////////
-    // and do the misc mboard sensors
-    ////////////////////////////////////////////////////////////////////
-    _tree->create<sensor_value_t>(mb_path / "sensors" / "ref_locked")
-        .set_publisher(boost::bind(&x300_impl::get_ref_locked, this, mb));
+    });
 
     //////////////// RFNOC /////////////////
+    //the radio blocks run on the radio clock, so enumeration must wait
+    //for a valid clock configuration
+    const size_t stage_rfnoc = init_graph.add_stage(
+        "rfnoc_enum", {stage_clock_config},
+        [this, &mb, &radio_ids, &dev_addr, mb_i](){
     const size_t n_rfnoc_blocks = mb.zpu_ctrl->peek32(SR_ADDR(SET0_BASE, ZPU_RB_NUM_CE));
     enumerate_rfnoc_blocks(
         mb_i,
@@ -1061,12 +1282,13 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t &dev_addr)
         uhd::sid_t(x300::SRC_ADDR0, 0, x300::DST_ADDR + mb_i, 0),
         dev_addr
     );
+    const std::string radio_blockid_hint = str(boost::format("%d/Radio") % mb_i);
+    radio_ids = find_blocks<rfnoc::x300_radio_ctrl_impl>(radio_blockid_hint);
+    });
     //////////////// RFNOC /////////////////
 
     // If we have a radio, we must configure its codec control:
-    const std::string radio_blockid_hint = str(boost::format("%d/Radio") % mb_i);
-    std::vector<rfnoc::block_id_t> radio_ids =
-                find_blocks<rfnoc::x300_radio_ctrl_impl>(radio_blockid_hint);
+    init_graph.add_stage("radio_init", {stage_rfnoc}, [this, &mb, &radio_ids](){
     if (not radio_ids.empty()) {
         if (radio_ids.size() > 2) {
             UHD_LOGGER_WARNING("X300")
@@ -1077,12 +1299,38 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t &dev_addr)
         for(const rfnoc::block_id_t &id:  radio_ids) {
             rfnoc::x300_radio_ctrl_impl::sptr radio(get_block_ctrl<rfnoc::x300_radio_ctrl_impl>(id));
             mb.radios.push_back(radio);
-            radio->setup_radio(
-                    mb.zpu_i2c,
-                    mb.clock,
-                    mb.args.get_ignore_cal_file(),
-                    mb.args.get_self_cal_adc_delay()
-            );
+        }
+
+        //The radio blocks are independent hardware, so set them up in
+        //parallel to cut the codec/frontend bring-up time in half. The
+        //shared I2C and clock control cores serialize internally.
+        //thread_group cannot propagate exceptions, so capture the first
+        //one and rethrow it after the join.
+        {
+            boost::thread_group setup_threads;
+            std::exception_ptr setup_error;
+            boost::mutex setup_error_mutex;
+            for (const rfnoc::x300_radio_ctrl_impl::sptr &radio : mb.radios) {
+                setup_threads.create_thread([&, radio](){
+                    try {
+                        radio->setup_radio(
+                                mb.zpu_i2c,
+                                mb.clock,
+                                mb.args.get_ignore_cal_file(),
+                                mb.args.get_self_cal_adc_delay()
+                        );
+                    } catch (...) {
+                        boost::mutex::scoped_lock l(setup_error_mutex);
+                        if (not setup_error) {
+                            setup_error = std::current_exception();
+                        }
+                    }
+                });
+            }
+            setup_threads.join_all();
+            if (setup_error) {
+                std::rethrow_exception(setup_error);
+            }
         }
 
         ////////////////////////////////////////////////////////////////////
@@ -1100,8 +1348,27 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t &dev_addr)
                 mb.args.get_ext_adc_self_test_duration()
             );
         } else {
+            //each radio owns its ADC and SPI path, so the self tests can
+            //run concurrently
+            boost::thread_group test_threads;
+            std::exception_ptr test_error;
+            boost::mutex test_error_mutex;
             for (size_t i = 0; i < mb.radios.size(); i++) {
-                mb.radios.at(i)->self_test_adc();
+                rfnoc::x300_radio_ctrl_impl::sptr radio = mb.radios.at(i);
+                test_threads.create_thread([&, radio](){
+                    try {
+                        radio->self_test_adc();
+                    } catch (...) {
+                        boost::mutex::scoped_lock l(test_error_mutex);
+                        if (not test_error) {
+                            test_error = std::current_exception();
+                        }
+                    }
+                });
+            }
+            test_threads.join_all();
+            if (test_error) {
+                std::rethrow_exception(test_error);
             }
         }
 
@@ -1116,7 +1383,13 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t &dev_addr)
         UHD_LOGGER_INFO("X300")
             << "No Radio Block found. Assuming radio-less operation.";
     } /* end of radio block(s) initialization */
+    });
 
+    //run the graph: independent stages overlap, and the trace logged
+    //afterwards shows which stage chain actually gated the bring-up
+    init_graph.run("mb" + std::to_string(mb_i));
+
+    profiler.finish();
     mb.initialization_done = true;
 }
 
@@ -1181,7 +1454,8 @@ static uhd::transport::muxed_zero_copy_if::sptr make_muxed_pcie_msg_xport
 (
     uhd::niusrprio::niusrprio_session::sptr rio_fpga_interface,
     uint32_t dma_channel_num,
-    size_t max_muxed_ports
+    size_t max_muxed_ports,
+    const bool low_latency
 ) {
     zero_copy_xport_params buff_args;
     buff_args.send_frame_size = x300::PCIE_MSG_FRAME_SIZE;
@@ -1192,7 +1466,8 @@ static uhd::transport::muxed_zero_copy_if::sptr make_muxed_pcie_msg_xport
     zero_copy_if::sptr base_xport = nirio_zero_copy::make(
         rio_fpga_interface, dma_channel_num,
         buff_args, uhd::device_addr_t());
-    return muxed_zero_copy_if::make(base_xport, extract_sid_from_pkt, max_muxed_ports);
+    return muxed_zero_copy_if::make(
+        base_xport, extract_sid_from_pkt, max_muxed_ports, low_latency);
 }
 
 uhd::both_xports_t x300_impl::make_transport(
@@ -1217,13 +1492,17 @@ uhd::both_xports_t x300_impl::make_transport(
             if (not mb.ctrl_dma_xport) {
                 //One underlying DMA channel will handle
                 //all control traffic
+                //Control responses bound register access latency: run
+                //the demuxer in low-latency mode
                 mb.ctrl_dma_xport = make_muxed_pcie_msg_xport(
                     mb.rio_fpga_interface,
                     dma_channel_num,
-                    x300::PCIE_MAX_MUXED_CTRL_XPORTS);
+                    x300::PCIE_MAX_MUXED_CTRL_XPORTS,
+                    true /*low_latency*/);
             }
             //Create a virtual control transport
-            xports.recv = mb.ctrl_dma_xport->make_stream(xports.recv_sid.get_dst());
+            xports.recv = mb.ctrl_dma_xport->make_stream(
+                xports.recv_sid.get_dst(), true /*priority*/);
         } else if (xport_type == ASYNC_MSG) {
             //Transport for async message stream
             if (not mb.async_msg_dma_xport) {
@@ -1232,7 +1511,8 @@ uhd::both_xports_t x300_impl::make_transport(
                 mb.async_msg_dma_xport = make_muxed_pcie_msg_xport(
                     mb.rio_fpga_interface,
                     dma_channel_num,
-                    x300::PCIE_MAX_MUXED_ASYNC_XPORTS);
+                    x300::PCIE_MAX_MUXED_ASYNC_XPORTS,
+                    false /*low_latency*/);
             }
             //Create a virtual async message transport
             xports.recv = mb.async_msg_dma_xport->make_stream(xports.recv_sid.get_dst());
@@ -1288,6 +1568,20 @@ uhd::both_xports_t x300_impl::make_transport(
             conn.type==X300_IFACE_ETH0 ? x300::XB_DST_E0 : x300::XB_DST_E1;
         if (xport_type != TX_DATA) next_src_addr = (next_src_addr + 1) % mb.eth_conns.size();
 
+        // With link bonding, a data stream gets a socket on every Ethernet
+        // link and its packets are striped across them. Outbound (TX)
+        // striping is effective immediately since the crossbar forwards by
+        // destination regardless of ingress port. Inbound data still arrives
+        // on the link programmed into the crossbar CAM below, until the
+        // FPGA's dispatcher learns to alternate egress links per stream.
+        const bool bond_links = mb.args.get_bond_links()
+            and mb.eth_conns.size() > 1
+            and (xport_type == TX_DATA or xport_type == RX_DATA)
+#ifdef HAVE_DPDK
+            and not mb.args.get_use_dpdk()
+#endif
+        ;
+
         xports.send_sid = this->allocate_sid(mb, address, xbar_src_addr, xbar_src_dst);
         xports.recv_sid = xports.send_sid.reversed();
 
@@ -1332,21 +1626,80 @@ uhd::both_xports_t x300_impl::make_transport(
 
         //make a new transport - fpga has no idea how to talk to us on this yet
         udp_zero_copy::buff_params buff_params;
-        xports.recv = udp_zero_copy::make(
-                conn.addr,
-                BOOST_STRINGIZE(X300_VITA_UDP_PORT),
-                default_buff_args,
-                buff_params,
-                xport_args);
+        buff_params.recv_buff_size = 0;
+        buff_params.send_buff_size = 0;
+        std::vector<zero_copy_if::sptr> eth_sockets;
+#ifdef HAVE_DPDK
+        if (mb.args.get_use_dpdk()) {
+            auto dpdk_ctx = uhd::transport::uhd_dpdk_ctx::get();
+            if (not dpdk_ctx->is_init_done()) {
+                dpdk_ctx->init(args);
+            }
+            const int dpdk_port_id = dpdk_ctx->get_route(conn.addr);
+            if (dpdk_port_id < 0) {
+                throw uhd::runtime_error(
+                    "Could not find a DPDK port to reach address " + conn.addr);
+            }
+            xports.recv = dpdk_zero_copy::make(
+                    *dpdk_ctx,
+                    unsigned(dpdk_port_id),
+                    conn.addr,
+                    BOOST_STRINGIZE(X300_VITA_UDP_PORT),
+                    "0",
+                    default_buff_args,
+                    xport_args);
+            //with DPDK the frame pools take the place of the socket buffers
+            buff_params.recv_buff_size =
+                default_buff_args.num_recv_frames * default_buff_args.recv_frame_size;
+            buff_params.send_buff_size =
+                default_buff_args.num_send_frames * default_buff_args.send_frame_size;
+            eth_sockets.push_back(xports.recv);
+        } else
+#endif /*HAVE_DPDK*/
+        {
+            const size_t num_sockets = bond_links ? mb.eth_conns.size() : 1;
+            for (size_t i = 0; i < num_sockets; i++) {
+                const std::string &socket_addr =
+                    bond_links ? mb.eth_conns[i].addr : conn.addr;
+                udp_zero_copy::buff_params socket_buff_params;
+                eth_sockets.push_back(udp_zero_copy::make(
+                        socket_addr,
+                        BOOST_STRINGIZE(X300_VITA_UDP_PORT),
+                        default_buff_args,
+                        socket_buff_params,
+                        xport_args));
+                buff_params.recv_buff_size += socket_buff_params.recv_buff_size;
+                buff_params.send_buff_size += socket_buff_params.send_buff_size;
+            }
+        }
 
         // Create a threaded transport for the receive chain only
         // Note that this shouldn't affect PCIe
         if (xport_type == RX_DATA) {
-            xports.recv = zero_copy_recv_offload::make(
-                    xports.recv,
-                    x300::RECV_OFFLOAD_BUFFER_TIMEOUT
-            );
+            // Each data transport gets its own receive thread; the
+            // offload_thread_cpu arg pins them (comma-separated CPUs)
+            std::vector<size_t> offload_cpus;
+            if (xport_args.has_key("offload_thread_cpu")) {
+                std::vector<std::string> cpu_strs;
+                boost::split(cpu_strs,
+                    xport_args["offload_thread_cpu"],
+                    boost::is_any_of(","));
+                for (const std::string &cpu_str : cpu_strs) {
+                    offload_cpus.push_back(std::stoul(cpu_str));
+                }
+            }
+            for (size_t i = 0; i < eth_sockets.size(); i++) {
+                eth_sockets[i] = zero_copy_recv_offload::make(
+                        eth_sockets[i],
+                        x300::RECV_OFFLOAD_BUFFER_TIMEOUT,
+                        offload_cpus
+                );
+            }
         }
+
+        xports.recv = (eth_sockets.size() == 1)
+            ? eth_sockets.front()
+            : bonded_zero_copy::make(eth_sockets);
         xports.send = xports.recv;
 
         //For the UDP transport the buffer size is the size of the socket buffer
@@ -1363,12 +1716,16 @@ uhd::both_xports_t x300_impl::make_transport(
         UHD_LOGGER_DEBUG("X300") << "programming packet for new xport on "
             << conn.addr <<  " sid " << xports.send_sid ;
         //YES, get a __send__ buffer from the __recv__ socket
-        //-- this is the only way to program the framer for recv:
-        managed_send_buffer::sptr buff = xports.recv->get_send_buff();
-        buff->cast<uint32_t *>()[0] = 0; //eth dispatch looks for != 0
-        buff->cast<uint32_t *>()[1] = uhd::htonx(xports.send_sid.get());
-        buff->commit(8);
-        buff.reset();
+        //-- this is the only way to program the framer for recv.
+        //With bonded links, every member socket sends the packet so
+        //each framer learns the route to the host:
+        for (size_t i = 0; i < eth_sockets.size(); i++) {
+            managed_send_buffer::sptr buff = eth_sockets[i]->get_send_buff();
+            buff->cast<uint32_t *>()[0] = 0; //eth dispatch looks for != 0
+            buff->cast<uint32_t *>()[1] = uhd::htonx(xports.send_sid.get());
+            buff->commit(8);
+            buff.reset();
+        }
 
         //reprogram the ethernet dispatcher's udp port (should be safe to always set)
         UHD_LOGGER_TRACE("X300")
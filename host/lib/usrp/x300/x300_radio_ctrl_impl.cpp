@@ -20,6 +20,7 @@
 #include <boost/make_shared.hpp>
 #include <boost/date_time/posix_time/posix_time_io.hpp>
 #include <chrono>
+#include <future>
 #include <thread>
 
 using namespace uhd;
@@ -619,7 +620,6 @@ void x300_radio_ctrl_impl::setup_radio(
         bool ignore_cal_file,
         bool verbose)
 {
-    _self_cal_adc_capture_delay(verbose);
     _ignore_cal_file = ignore_cal_file;
 
     ////////////////////////////////////////////////////////////////////
@@ -642,10 +642,24 @@ void x300_radio_ctrl_impl::setup_radio(
 
     const size_t DB_OFFSET = (_radio_slot == "A") ? 0x0 : 0x2;
     const fs_path db_path = ("dboards" / _radio_slot);
+
+    // The dboard EEPROMs are read over slow I2C. Overlap the readout with
+    // the ADC capture delay self-cal below and join where the EEPROM
+    // contents are first needed. The I2C core serializes bus access, so
+    // the worker thread can share the bus with the other radio's setup.
+    std::future<void> db_eeprom_fut =
+        std::async(std::launch::async, [this, zpu_i2c, DB_OFFSET](){
+            for (const size_t eeprom_addr : EEPROM_ADDRS) {
+                const size_t addr = eeprom_addr + DB_OFFSET;
+                _db_eeproms[addr].load(*zpu_i2c, BASE_ADDR | addr);
+            }
+        });
+
+    _self_cal_adc_capture_delay(verbose);
+
+    db_eeprom_fut.get();
     for (size_t i = 0; i < EEPROM_ADDRS.size(); i++) {
         const size_t addr = EEPROM_ADDRS[i] + DB_OFFSET;
-        //Load EEPROM
-        _db_eeproms[addr].load(*zpu_i2c, BASE_ADDR | addr);
         //Add to tree
         _tree->create<dboard_eeprom_t>(db_path / EEPROM_PATHS[i])
             .set(_db_eeproms[addr])
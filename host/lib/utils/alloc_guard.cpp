@@ -0,0 +1,76 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifdef UHD_ALLOC_ASSERT
+
+#include <uhdlib/utils/alloc_guard.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    //depth of armed guards on this thread;
+    //an allocation while the depth is non-zero aborts
+    thread_local int alloc_guard_depth = 0;
+}
+
+void uhd::alloc_guard_arm(void)
+{
+    alloc_guard_depth++;
+}
+
+void uhd::alloc_guard_disarm(void)
+{
+    alloc_guard_depth--;
+}
+
+static void *checked_alloc(std::size_t size)
+{
+    if (alloc_guard_depth > 0){
+        // Cannot throw or log from here, both would allocate. Print
+        // with stdio and abort so the backtrace points at the
+        // offending allocation site.
+        std::fputs(
+            "UHD_ALLOC_ASSERT: heap allocation on a guarded fastpath thread\n",
+            stderr);
+        std::abort();
+    }
+    void *ptr = std::malloc(size);
+    if (ptr == nullptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void *operator new(std::size_t size)
+{
+    return checked_alloc(size);
+}
+
+void *operator new[](std::size_t size)
+{
+    return checked_alloc(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+#endif /* UHD_ALLOC_ASSERT */
@@ -0,0 +1,118 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/paths.hpp>
+#include <uhdlib/utils/compat_cache.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/thread/mutex.hpp>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+namespace fs = boost::filesystem;
+
+/*
+ * One line per device serial:
+ *   <serial>\t<epoch seconds of the verification>\t<fingerprint>
+ * The file is tiny (one entry per device ever verified from this host)
+ * and rewritten whole on every store.
+ */
+
+namespace {
+
+    struct cache_entry_t
+    {
+        std::string serial;
+        int64_t timestamp;
+        std::string fingerprint;
+    };
+
+    fs::path get_compat_cache_path(void)
+    {
+        return fs::path(uhd::get_app_path()) / ".uhd" / "cache" / "compat_checks";
+    }
+
+    boost::mutex &get_compat_cache_mutex(void)
+    {
+        static boost::mutex mutex;
+        return mutex;
+    }
+
+    std::vector<cache_entry_t> load_compat_cache(void)
+    {
+        std::vector<cache_entry_t> entries;
+        std::ifstream cache_file(get_compat_cache_path().string().c_str());
+        std::string line;
+        while (std::getline(cache_file, line)) {
+            std::istringstream fields(line);
+            cache_entry_t entry;
+            if (not std::getline(fields, entry.serial, '\t')) continue;
+            std::string timestamp;
+            if (not std::getline(fields, timestamp, '\t')) continue;
+            if (not std::getline(fields, entry.fingerprint)) continue;
+            try {
+                entry.timestamp = std::stoll(timestamp);
+            } catch (const std::exception &) {
+                continue; //skip unparseable entries, the cache is only a hint
+            }
+            entries.push_back(entry);
+        }
+        return entries;
+    }
+
+} //namespace
+
+bool uhd::compat_cache::is_fresh(
+    const std::string &serial,
+    const std::string &fingerprint,
+    const double max_age_secs
+){
+    if (serial.empty()) return false;
+    boost::mutex::scoped_lock lock(get_compat_cache_mutex());
+    const int64_t now = int64_t(std::time(NULL));
+    for (const cache_entry_t &entry : load_compat_cache()) {
+        if (entry.serial != serial) continue;
+        if (entry.fingerprint != fingerprint) return false;
+        const int64_t age = now - entry.timestamp;
+        //a timestamp from the future means the clock moved; re-verify
+        return age >= 0 and double(age) <= max_age_secs;
+    }
+    return false;
+}
+
+void uhd::compat_cache::store(
+    const std::string &serial,
+    const std::string &fingerprint
+){
+    if (serial.empty()) return;
+    boost::mutex::scoped_lock lock(get_compat_cache_mutex());
+    try {
+        std::vector<cache_entry_t> entries = load_compat_cache();
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (entries[i].serial == serial) {
+                entries.erase(entries.begin() + i);
+                break;
+            }
+        }
+        cache_entry_t entry;
+        entry.serial = serial;
+        entry.timestamp = int64_t(std::time(NULL));
+        entry.fingerprint = fingerprint;
+        entries.push_back(entry);
+
+        fs::create_directories(get_compat_cache_path().parent_path());
+        std::ofstream cache_file(get_compat_cache_path().string().c_str());
+        for (const cache_entry_t &e : entries) {
+            cache_file << e.serial << '\t' << e.timestamp << '\t'
+                       << e.fingerprint << std::endl;
+        }
+    } catch (const std::exception &e) {
+        UHD_LOGGER_WARNING("UHD")
+            << "Could not update compat check cache: " << e.what();
+    }
+}
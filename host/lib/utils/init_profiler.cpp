@@ -0,0 +1,75 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/utils/init_profiler.hpp>
+#include <uhd/utils/log.hpp>
+#include <boost/format.hpp>
+
+using namespace uhd;
+
+init_profiler::init_profiler(const std::string &context):
+    _context(context),
+    _phase_open(false),
+    _reported(false)
+{
+    //NOP
+}
+
+init_profiler::~init_profiler(void)
+{
+    if (not _reported) {
+        try {
+            this->finish();
+        } catch (...) {
+            //never throw from a destructor
+        }
+    }
+}
+
+void init_profiler::enter_phase(const std::string &name)
+{
+    this->leave_phase();
+    phase_type phase;
+    phase.name = name;
+    _phases.push_back(phase);
+    _phase_start = clock_type::now();
+    _phase_open = true;
+}
+
+void init_profiler::leave_phase(void)
+{
+    if (not _phase_open) return;
+    _phases.back().elapsed = std::chrono::duration<double>(
+        clock_type::now() - _phase_start).count();
+    _phase_open = false;
+}
+
+double init_profiler::get_total(void) const
+{
+    double total = 0.0;
+    for (const phase_type &phase : _phases) {
+        total += phase.elapsed;
+    }
+    return total;
+}
+
+void init_profiler::finish(void)
+{
+    this->leave_phase();
+    _reported = true;
+    if (_phases.empty()) return;
+
+    const double total = this->get_total();
+    UHD_LOGGER_DEBUG("PROFILER")
+        << boost::format("%s initialization took %.1f ms:")
+           % _context % (total*1e3);
+    for (const phase_type &phase : _phases) {
+        UHD_LOGGER_DEBUG("PROFILER")
+            << boost::format("%s   %-28s %8.1f ms (%5.1f%%)")
+               % _context % phase.name % (phase.elapsed*1e3)
+               % ((total > 0.0)? (100.0*phase.elapsed/total) : 0.0);
+    }
+}
@@ -16,6 +16,8 @@
 #include <fstream>
 #include <cctype>
 #include <atomic>
+#include <chrono>
+#include <cstring>
 #include <mutex>
 #include <memory>
 #include <thread>
@@ -158,6 +160,94 @@ private:
     std::ofstream _file_stream;
 };
 
+/***********************************************************************
+ * Fastpath message ring
+ **********************************************************************/
+#ifndef UHD_LOG_FASTPATH_DISABLE
+/*! Bounded lock-free multi-producer/single-consumer ring for fastpath
+ * log messages.
+ *
+ * Producers claim a slot with an atomic sequence handshake, copy the
+ * message into preallocated storage and publish the slot; they never
+ * lock, block, or allocate, so a burst of overflow indications cannot
+ * jitter the streaming threads. When the ring is full the message is
+ * dropped and counted; the consumer reports the drop count once the
+ * burst has passed. The single consumer polls the slot at the read
+ * cursor, so it needs no wakeup from the producers.
+ */
+class fastpath_log_ring {
+public:
+    fastpath_log_ring(void):
+        _write(0), _read(0), _dropped(0)
+    {
+        for (size_t i = 0; i < CAPACITY; i++) {
+            _entries[i].seq.store(i, std::memory_order_relaxed);
+            _entries[i].len = 0;
+        }
+    }
+
+    //! Producer interface: push a message, drop (and count) when full
+    void push(const std::string &msg)
+    {
+        uint64_t pos = _write.load(std::memory_order_relaxed);
+        for (;;) {
+            entry_type &entry = _entries[pos & (CAPACITY - 1)];
+            const int64_t dif =
+                int64_t(entry.seq.load(std::memory_order_acquire)) - int64_t(pos);
+            if (dif == 0) {
+                if (_write.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed)) {
+                    entry.len = std::min(msg.size(), size_t(MAX_MSG_LEN));
+                    std::memcpy(entry.msg, msg.data(), entry.len);
+                    entry.seq.store(pos + 1, std::memory_order_release);
+                    return;
+                }
+            } else if (dif < 0) {
+                //ring is full: never wait, just count the loss
+                _dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            } else {
+                pos = _write.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    //! Consumer interface: true when a message was popped
+    bool pop(std::string &msg)
+    {
+        entry_type &entry = _entries[_read & (CAPACITY - 1)];
+        const int64_t dif =
+            int64_t(entry.seq.load(std::memory_order_acquire)) - int64_t(_read + 1);
+        if (dif < 0) return false;
+        msg.assign(entry.msg, entry.len);
+        entry.seq.store(_read + CAPACITY, std::memory_order_release);
+        _read++;
+        return true;
+    }
+
+    //! Consumer interface: messages dropped since the last call
+    uint64_t reap_dropped(void)
+    {
+        return _dropped.exchange(0, std::memory_order_relaxed);
+    }
+
+private:
+    static const size_t CAPACITY = 512; //must be a power of two
+    static const size_t MAX_MSG_LEN = 32;
+
+    struct entry_type {
+        std::atomic<uint64_t> seq;
+        char msg[MAX_MSG_LEN];
+        size_t len;
+    };
+
+    entry_type _entries[CAPACITY];
+    std::atomic<uint64_t> _write;
+    uint64_t _read; //only touched by the consumer thread
+    std::atomic<uint64_t> _dropped;
+};
+#endif /* UHD_LOG_FASTPATH_DISABLE */
+
 /***********************************************************************
  * Global resources for the logger
  **********************************************************************/
@@ -172,9 +262,6 @@ public:
     log_resource(void):
         global_level(uhd::log::off),
         _exit(false),
-#ifndef UHD_LOG_FASTPATH_DISABLE
-        _fastpath_queue(10),
-#endif
         _log_queue(10)
     {
         //allow override from macro definition
@@ -257,9 +344,7 @@ public:
         );
         final_message.message = "";
         push(final_message);
-#ifndef UHD_LOG_FASTPATH_DISABLE
-        push_fastpath("");
-#endif
+        //the fastpath task polls its ring, so _exit alone wakes it up
         _pop_task->join();
         {
             std::lock_guard<std::mutex> l(_logmap_mutex);
@@ -281,9 +366,9 @@ public:
 #ifndef UHD_LOG_FASTPATH_DISABLE
     void push_fastpath(const std::string &message)
     {
-        // Never wait. If the buffer is full, we just don't see the message.
-        // Too bad.
-        _fastpath_queue.push_with_haste(message);
+        // Never waits or allocates. If the ring is full, the message is
+        // dropped and the consumer reports the count after the burst.
+        _fastpath_queue.push(message);
     }
 #endif
 
@@ -326,14 +411,20 @@ public:
 #ifndef UHD_LOG_FASTPATH_DISABLE
         std::string msg;
         while (!_exit) {
-            _fastpath_queue.pop_with_wait(msg);
-            std::cerr << msg << std::flush;
+            if (_fastpath_queue.pop(msg)) {
+                std::cerr << msg << std::flush;
+                continue;
+            }
+            //the burst has passed: report any losses, then idle
+            _report_dropped_fastpath();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
         }
 
-        // Exit procedure: Clear the queue
-        while (_fastpath_queue.pop_with_haste(msg)) {
+        // Exit procedure: Clear the ring
+        while (_fastpath_queue.pop(msg)) {
             std::cerr << msg << std::flush;
         }
+        _report_dropped_fastpath();
 #endif
     }
 
@@ -342,11 +433,11 @@ public:
 #ifndef UHD_LOG_FASTPATH_DISABLE
         std::string msg;
         while (!_exit) {
-            _fastpath_queue.pop_with_wait(msg);
+            // Discard everything
+            while (_fastpath_queue.pop(msg));
+            _fastpath_queue.reap_dropped();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
         }
-
-        // Exit procedure: Clear the queue
-        while (_fastpath_queue.pop_with_haste(msg));
 #endif
     }
 
@@ -471,7 +562,16 @@ private:
         std::pair<uhd::log::severity_level, uhd::log::log_fn_t>;
     std::map<std::string, level_logfn_pair> _loggers;
 #ifndef UHD_LOG_FASTPATH_DISABLE
-    uhd::transport::bounded_buffer<std::string> _fastpath_queue;
+    void _report_dropped_fastpath()
+    {
+        const uint64_t dropped = _fastpath_queue.reap_dropped();
+        if (dropped) {
+            std::cerr << "[dropped " << dropped << " fastpath messages]"
+                      << std::flush;
+        }
+    }
+
+    fastpath_log_ring _fastpath_queue;
 #endif
     uhd::transport::bounded_buffer<uhd::log::logging_info> _log_queue;
 };
@@ -538,6 +638,11 @@ uhd::log::set_log_level(uhd::log::severity_level level){
     log_rs().global_level = level;
 }
 
+uhd::log::severity_level
+uhd::log::get_log_level(){
+    return log_rs().global_level;
+}
+
 void
 uhd::log::set_logger_level(const std::string &key, uhd::log::severity_level level){
     log_rs().set_log_level(key, level);
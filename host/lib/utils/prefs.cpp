@@ -11,12 +11,38 @@
 #include <uhdlib/utils/paths.hpp>
 #include <boost/filesystem.hpp>
 #include <cstdlib>
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <vector>
 
 using namespace uhd;
 
 namespace {
     constexpr char UHD_CONF_FILE_VAR[] = "UHD_CONFIG_FILE";
 
+    //! One config source: where it lives and when it was last parsed
+    struct conf_source_type {
+        std::string path;
+        std::string config_type;
+        std::time_t mtime; //0 when the file did not exist at parse time
+    };
+
+    //! Counts config re-parses; lets derived caches detect staleness
+    size_t _conf_generation = 0;
+
+    std::time_t _conf_file_mtime(const std::string& path)
+    {
+        try {
+            if (not path.empty() and boost::filesystem::exists(path)) {
+                return boost::filesystem::last_write_time(path);
+            }
+        } catch (...) {
+            // nop
+        }
+        return 0;
+    }
+
     inline void _update_conf_file(
             const std::string& path,
             const std::string& config_type,
@@ -52,27 +78,51 @@ namespace {
 
 config_parser& uhd::prefs::get_uhd_config()
 {
+    // The parsed config is cached process-wide; on every call one stat
+    // per source file decides whether the cache is still valid, so the
+    // repeated lookups during device setup never re-tokenize the files.
+    static std::mutex mutex;
     static config_parser _conf_files{};
+    static std::vector<conf_source_type> _sources;
     static bool init_done = false;
+
+    std::lock_guard<std::mutex> lock(mutex);
     if (not init_done) {
         UHD_LOG_TRACE("CONF", "Initializing config file object...");
         const std::string sys_conf_file = path_expandvars(UHD_SYS_CONF_FILE);
-        _update_conf_file(sys_conf_file, "system", _conf_files);
+        _sources.push_back(conf_source_type{sys_conf_file, "system", 0});
         const std::string user_conf_file =
             (boost::filesystem::path(get_app_path())
                 / std::string(UHD_USER_CONF_FILE)).string();
-        _update_conf_file(user_conf_file, "user", _conf_files);
-        std::string env_conf_file;
+        _sources.push_back(conf_source_type{user_conf_file, "user", 0});
         try { // getenv into std::string can fail
             if (std::getenv(UHD_CONF_FILE_VAR) != NULL) {
-                env_conf_file = std::string(std::getenv(UHD_CONF_FILE_VAR));
+                _sources.push_back(conf_source_type{
+                    std::string(std::getenv(UHD_CONF_FILE_VAR)), "ENV", 0});
             }
-            _update_conf_file(env_conf_file, "ENV", _conf_files);
         } catch (const std::exception &) {
             // nop
         }
+    }
+
+    bool stale = not init_done;
+    for (const auto& source : _sources) {
+        if (_conf_file_mtime(source.path) != source.mtime) {
+            stale = true;
+            break;
+        }
+    }
+
+    if (stale) {
+        _conf_files = config_parser{};
+        for (auto& source : _sources) {
+            _update_conf_file(source.path, source.config_type, _conf_files);
+            source.mtime = _conf_file_mtime(source.path);
+        }
+        _conf_generation++;
         UHD_LOG_TRACE("PREFS", "Done initializing.");
     }
+    init_done = true;
 
     return _conf_files;
 }
@@ -88,8 +138,34 @@ device_addr_t uhd::prefs::get_usrp_args(
         "serial"
     };
 
+    // The config-derived portion depends only on the identifying keys
+    // and the parsed config, so resolved device-match sections are
+    // memoized per identity until the config files change on disk.
+    static std::mutex mutex;
+    static std::map<std::string, device_addr_t> _match_cache;
+    static size_t _cache_generation = 0;
+
+    std::string identity;
     for (const auto& key : keys_to_update_from) {
-        update_from_key(key, user_args.get(key, ""), usrp_args);
+        identity += key + "=" + user_args.get(key, "") + ",";
+    }
+
+    {
+        get_uhd_config(); //refresh the config (and generation) first
+        std::lock_guard<std::mutex> lock(mutex);
+        if (_cache_generation != _conf_generation) {
+            _match_cache.clear();
+            _cache_generation = _conf_generation;
+        }
+        const auto cached = _match_cache.find(identity);
+        if (cached != _match_cache.end()) {
+            usrp_args = cached->second;
+        } else {
+            for (const auto& key : keys_to_update_from) {
+                update_from_key(key, user_args.get(key, ""), usrp_args);
+            }
+            _match_cache[identity] = usrp_args;
+        }
     }
 
     // Finally, copy over the original user args:
@@ -99,4 +175,3 @@ device_addr_t uhd::prefs::get_usrp_args(
 
     return usrp_args;
 }
-
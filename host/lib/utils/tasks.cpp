@@ -10,10 +10,15 @@
 #include <uhd/utils/thread.hpp>
 #include <uhd/utils/log.hpp>
 #include <uhd/exception.hpp>
+#include <uhdlib/utils/thread_policy.hpp>
 #include <boost/thread/thread.hpp>
 #include <boost/thread/barrier.hpp>
+#include <boost/make_shared.hpp>
+#include <algorithm>
+#include <deque>
 #include <exception>
 #include <iostream>
+#include <map>
 #include <vector>
 #include <thread>
 #include <atomic>
@@ -29,7 +34,7 @@ public:
         _task = std::thread([this, task_fcn](){ this->task_loop(task_fcn); });
         if (not name.empty()) {
 #ifdef HAVE_PTHREAD_SETNAME
-            pthread_setname_np(_task->native_handle(), name.substr(0,16).c_str());
+            pthread_setname_np(_task.native_handle(), name.substr(0,16).c_str());
 #endif /* HAVE_PTHREAD_SETNAME */
         }
     }
@@ -43,6 +48,7 @@ public:
 
 private:
     void task_loop(const task_fcn_type &task_fcn){
+        thread_policy::apply("task");
         try{
             while (!_exit){
                 task_fcn();
@@ -72,6 +78,248 @@ task::sptr task::make(const task_fcn_type &task_fcn, const std::string &name){
     return task::sptr(new task_impl(task_fcn, name));
 }
 
+/***********************************************************************
+ * Shared task executor:
+ * Pooled tasks run interleaved on a small group of worker threads with
+ * per-worker work-stealing queues, instead of one dedicated thread per
+ * task. Tasks with the same CPU affinity mask share one worker group,
+ * so housekeeping never has to land on isolated streaming cores.
+ **********************************************************************/
+class task_executor_group{
+public:
+    //a task entry is always in exactly one of these states:
+    //waiting in some worker's queue, running an iteration, or done
+    enum task_state_t {STATE_QUEUED, STATE_RUNNING, STATE_DONE};
+
+    struct entry_type{
+        entry_type(const task::task_fcn_type &fcn, const std::string &name):
+            fcn(fcn), name(name), exit(false), state(STATE_QUEUED){}
+        const task::task_fcn_type fcn;
+        const std::string name;
+        bool exit;
+        task_state_t state;
+        boost::mutex mut;
+        boost::condition_variable done_cond;
+    };
+    typedef boost::shared_ptr<entry_type> entry_sptr;
+
+    task_executor_group(const std::vector<size_t> &cpu_affinity):
+        _cpu_affinity(cpu_affinity), _shutdown(false), _num_tasks(0)
+    {
+        /* NOP */
+    }
+
+    ~task_executor_group(void){
+        _shutdown = true;
+        _work_cond.notify_all();
+        for (size_t i = 0; i < _workers.size(); i++){
+            if (_workers[i]->thread.joinable()) _workers[i]->thread.join();
+        }
+    }
+
+    entry_sptr add_task(const task::task_fcn_type &fcn, const std::string &name){
+        entry_sptr entry = boost::make_shared<entry_type>(fcn, name);
+        boost::mutex::scoped_lock lock(_mut);
+        _num_tasks++;
+        this->spawn_workers();
+        //seed the least loaded worker's queue
+        size_t best = 0;
+        for (size_t i = 1; i < _workers.size(); i++){
+            if (_workers[i]->queue.size() < _workers[best]->queue.size()) best = i;
+        }
+        _workers[best]->queue.push_back(entry);
+        _work_cond.notify_one();
+        return entry;
+    }
+
+    //! block until the task is out of the queues and not running
+    void remove_task(entry_sptr entry){
+        {
+            boost::mutex::scoped_lock lock(entry->mut);
+            entry->exit = true;
+            while (entry->state != STATE_DONE){
+                entry->done_cond.wait(lock);
+            }
+        }
+        boost::mutex::scoped_lock lock(_mut);
+        _num_tasks--;
+    }
+
+private:
+    struct worker_type{
+        std::deque<entry_sptr> queue;
+        std::thread thread;
+    };
+    typedef boost::shared_ptr<worker_type> worker_sptr;
+
+    //! grow the worker set toward the target, called with _mut held
+    void spawn_workers(void){
+        //pooled tasks are mostly-idle housekeeping: one worker per
+        //four tasks, capped well below the core count
+        const size_t hw_cap = std::max<size_t>(1, std::thread::hardware_concurrency()/2);
+        const size_t target = std::max<size_t>(1,
+            std::min(std::min<size_t>(4, hw_cap), (_num_tasks + 3)/4));
+        while (_workers.size() < target){
+            worker_sptr worker = boost::make_shared<worker_type>();
+            _workers.push_back(worker);
+            const size_t index = _workers.size() - 1;
+            worker->thread = std::thread([this, index](){ this->worker_loop(index); });
+#ifdef HAVE_PTHREAD_SETNAME
+            pthread_setname_np(worker->thread.native_handle(), "uhd_task_pool");
+#endif /* HAVE_PTHREAD_SETNAME */
+        }
+    }
+
+    //! pop from the own queue, or steal from the back of a sibling's
+    entry_sptr pop_or_steal(const size_t index){
+        boost::mutex::scoped_lock lock(_mut);
+        if (not _workers[index]->queue.empty()){
+            entry_sptr entry = _workers[index]->queue.front();
+            _workers[index]->queue.pop_front();
+            return entry;
+        }
+        for (size_t i = 0; i < _workers.size(); i++){
+            if (i == index) continue;
+            if (not _workers[i]->queue.empty()){
+                entry_sptr entry = _workers[i]->queue.back();
+                _workers[i]->queue.pop_back();
+                return entry;
+            }
+        }
+        return entry_sptr();
+    }
+
+    void requeue(const size_t index, entry_sptr entry){
+        boost::mutex::scoped_lock lock(_mut);
+        _workers[index]->queue.push_back(entry);
+        _work_cond.notify_one();
+    }
+
+    void worker_loop(const size_t index){
+        //the explicit group affinity wins over the configured policy
+        thread_policy::apply("task_pool");
+        if (not _cpu_affinity.empty()){
+            uhd::set_thread_affinity(_cpu_affinity);
+        }
+        while (not _shutdown){
+            entry_sptr entry = this->pop_or_steal(index);
+            if (not entry){
+                //idle: all tasks are running elsewhere or none exist;
+                //the timeout guards against a lost notify on teardown
+                boost::mutex::scoped_lock lock(_mut);
+                _work_cond.timed_wait(lock, boost::posix_time::milliseconds(100));
+                continue;
+            }
+
+            {
+                boost::mutex::scoped_lock lock(entry->mut);
+                if (entry->exit){
+                    entry->state = STATE_DONE;
+                    entry->done_cond.notify_all();
+                    continue;
+                }
+                entry->state = STATE_RUNNING;
+            }
+
+            //run one iteration of the task outside all locks
+            bool alive = true;
+            try{
+                entry->fcn();
+            }
+            catch(const std::exception &e){
+                this->do_error_msg(entry->name, e.what());
+                alive = false;
+            }
+            catch(...){
+                //never rethrow here: it would take down every task
+                //sharing this worker, not just the offender
+                this->do_error_msg(entry->name, "unknown exception");
+                alive = false;
+            }
+
+            {
+                boost::mutex::scoped_lock lock(entry->mut);
+                if (entry->exit or not alive){
+                    entry->state = STATE_DONE;
+                    entry->done_cond.notify_all();
+                    continue;
+                }
+                entry->state = STATE_QUEUED;
+            }
+            this->requeue(index, entry);
+        }
+    }
+
+    void do_error_msg(const std::string &name, const std::string &msg){
+        UHD_LOGGER_ERROR("UHD")
+            << "An unexpected exception was caught in pooled task '" << name << "'."
+            << "The task will now exit, things may not work."
+            << msg
+        ;
+    }
+
+    const std::vector<size_t> _cpu_affinity;
+    std::atomic<bool> _shutdown;
+    boost::mutex _mut;
+    boost::condition_variable _work_cond;
+    std::vector<worker_sptr> _workers;
+    size_t _num_tasks;
+};
+
+//! process-wide executor: one worker group per distinct affinity mask
+class task_executor{
+public:
+    static task_executor &instance(void){
+        static task_executor executor;
+        return executor;
+    }
+
+    boost::shared_ptr<task_executor_group> get_group(const std::vector<size_t> &cpu_affinity){
+        std::vector<size_t> key(cpu_affinity);
+        std::sort(key.begin(), key.end());
+        boost::mutex::scoped_lock lock(_mut);
+        if (_groups.count(key) == 0){
+            _groups[key] = boost::make_shared<task_executor_group>(cpu_affinity);
+        }
+        return _groups[key];
+    }
+
+private:
+    boost::mutex _mut;
+    std::map<std::vector<size_t>, boost::shared_ptr<task_executor_group> > _groups;
+};
+
+class pooled_task_impl : public task{
+public:
+    pooled_task_impl(
+        const task::task_fcn_type &task_fcn,
+        const std::string &name,
+        const std::vector<size_t> &cpu_affinity
+    ):
+        _group(task_executor::instance().get_group(cpu_affinity))
+    {
+        _entry = _group->add_task(task_fcn, name);
+    }
+
+    ~pooled_task_impl(void){
+        _group->remove_task(_entry);
+    }
+
+private:
+    //the group sptr keeps the workers alive for as long as any task
+    //references them, independent of static destruction order
+    boost::shared_ptr<task_executor_group> _group;
+    task_executor_group::entry_sptr _entry;
+};
+
+task::sptr task::make_pooled(
+    const task_fcn_type &task_fcn,
+    const std::string &name,
+    const std::vector<size_t> &cpu_affinity
+){
+    return task::sptr(new pooled_task_impl(task_fcn, name, cpu_affinity));
+}
+
 msg_task::~msg_task(void){
     /* NOP */
 }
@@ -99,6 +99,96 @@ static void check_priority_range(float priority){
 
 #endif /* HAVE_THREAD_PRIO_DUMMY */
 
+/***********************************************************************
+ * Deadline scheduling (Linux SCHED_DEADLINE)
+ **********************************************************************/
+#ifdef HAVE_SCHED_SETATTR
+    #include <linux/sched.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #include <cerrno>
+    #include <cstring>
+
+    //glibc provides no wrapper for sched_setattr; declare the attribute
+    //struct and make the syscall directly
+    namespace {
+        struct sched_attr_t {
+            uint32_t size;
+            uint32_t sched_policy;
+            uint64_t sched_flags;
+            int32_t  sched_nice;
+            uint32_t sched_priority;
+            uint64_t sched_runtime;
+            uint64_t sched_deadline;
+            uint64_t sched_period;
+        };
+    }
+
+    bool uhd::set_thread_deadline(const double runtime, const double period){
+        if (runtime <= 0.0 or period <= 0.0 or runtime > period){
+            UHD_LOGGER_WARNING("UHD") << boost::format(
+                "Invalid deadline reservation: runtime %f s, period %f s."
+            ) % runtime % period;
+            return false;
+        }
+
+        sched_attr_t attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.sched_policy = SCHED_DEADLINE;
+        attr.sched_runtime = uint64_t(runtime*1e9);
+        attr.sched_deadline = uint64_t(period*1e9);
+        attr.sched_period = uint64_t(period*1e9);
+
+        if (syscall(SYS_sched_setattr, 0 /*this thread*/, &attr, 0) != 0){
+            UHD_LOGGER_WARNING("UHD") << boost::format(
+                "Unable to enable deadline scheduling (%s). "
+                "Performance may be negatively affected.\n"
+                "Deadline scheduling requires CAP_SYS_NICE and a thread "
+                "affinity spanning the scheduling domain."
+            ) % std::strerror(errno);
+            return false;
+        }
+        return true;
+    }
+#else
+    bool uhd::set_thread_deadline(const double, const double){
+        UHD_LOGGER_WARNING("UHD")
+            << "Deadline scheduling is not supported on this platform.";
+        return false;
+    }
+#endif /* HAVE_SCHED_SETATTR */
+
+/***********************************************************************
+ * Set thread affinity
+ **********************************************************************/
+#ifdef HAVE_PTHREAD_SETAFFINITY
+    #include <pthread.h>
+
+    void uhd::set_thread_affinity(const std::vector<size_t> &cpu_affinity){
+        if (cpu_affinity.empty()) return;
+
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        for (const size_t cpu : cpu_affinity){
+            CPU_SET(cpu, &cpu_set);
+        }
+        const int ret = pthread_setaffinity_np(
+            pthread_self(), sizeof(cpu_set_t), &cpu_set);
+        if (ret != 0){
+            UHD_LOG_WARNING("UHD",
+                "Failed to set desired thread affinity. "
+                "Performance may be negatively affected.");
+        }
+    }
+#else
+    void uhd::set_thread_affinity(const std::vector<size_t> &cpu_affinity){
+        if (cpu_affinity.empty()) return;
+        UHD_LOG_WARNING("UHD",
+            "Setting the thread affinity is not supported on this platform.");
+    }
+#endif /* HAVE_PTHREAD_SETAFFINITY */
+
 void uhd::set_thread_name(
     boost::thread *thrd,
     const std::string &name
@@ -0,0 +1,148 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/thread.hpp>
+#include <uhdlib/utils/thread_policy.hpp>
+#include <uhdlib/utils/prefs.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <map>
+#include <mutex>
+
+using namespace uhd;
+using namespace uhd::thread_policy;
+
+namespace {
+    std::mutex _policy_mutex;
+    std::map<std::string, policy_t> _policies;
+    bool _conf_loaded = false;
+
+    //! Parse a CPU list; both commas and dots separate entries, since
+    //  device arg values cannot carry commas
+    std::vector<size_t> parse_affinity(const std::string &value)
+    {
+        std::vector<size_t> cpu_affinity;
+        std::vector<std::string> tokens;
+        boost::split(tokens, value, boost::is_any_of(",."));
+        for (const std::string &token : tokens) {
+            if (token.empty()) continue;
+            cpu_affinity.push_back(
+                boost::lexical_cast<size_t>(boost::trim_copy(token)));
+        }
+        return cpu_affinity;
+    }
+
+    //! Fold one key/value pair of the form <role>_<field> into the map
+    void update_policy(const std::string &key, const std::string &value)
+    {
+        std::string role, field;
+        if (boost::ends_with(key, "_priority")) {
+            role = key.substr(0, key.size() - 9);
+            field = "priority";
+        } else if (boost::ends_with(key, "_realtime")) {
+            role = key.substr(0, key.size() - 9);
+            field = "realtime";
+        } else if (boost::ends_with(key, "_deadline_runtime")) {
+            role = key.substr(0, key.size() - 17);
+            field = "deadline_runtime";
+        } else if (boost::ends_with(key, "_deadline_period")) {
+            role = key.substr(0, key.size() - 16);
+            field = "deadline_period";
+        } else if (boost::ends_with(key, "_affinity")) {
+            role = key.substr(0, key.size() - 9);
+            field = "affinity";
+        } else {
+            UHD_LOG_WARNING("UHD",
+                "Ignoring unrecognized thread policy key: " << key);
+            return;
+        }
+        if (role.empty()) return;
+
+        policy_t &policy = _policies[role];
+        try {
+            if (field == "priority") {
+                policy.priority = boost::lexical_cast<float>(value);
+                policy.has_priority = true;
+            } else if (field == "realtime") {
+                policy.realtime = (boost::lexical_cast<size_t>(value) != 0);
+            } else if (field == "deadline_runtime") {
+                policy.deadline_runtime = boost::lexical_cast<double>(value);
+            } else if (field == "deadline_period") {
+                policy.deadline_period = boost::lexical_cast<double>(value);
+            } else {
+                policy.cpu_affinity = parse_affinity(value);
+            }
+        } catch (const std::exception &) {
+            UHD_LOG_WARNING("UHD",
+                "Invalid thread policy value for " << key << ": " << value);
+        }
+    }
+
+    //! Pull the [threads] section of uhd.conf exactly once; explicit
+    //  registrations and device args are applied afterwards and win
+    void load_conf_policies(void)
+    {
+        if (_conf_loaded) return;
+        _conf_loaded = true;
+        config_parser &conf = prefs::get_uhd_config();
+        for (const std::string &key : conf.options("threads")) {
+            update_policy(key, conf.get<std::string>("threads", key, ""));
+        }
+    }
+} /* namespace */
+
+policy_t::policy_t(void):
+    has_priority(false),
+    priority(uhd::default_thread_priority),
+    realtime(true),
+    deadline_runtime(0.0),
+    deadline_period(0.0)
+{
+    /* NOP */
+}
+
+void uhd::thread_policy::register_policy(
+    const std::string &role,
+    const policy_t &policy
+) {
+    std::lock_guard<std::mutex> lock(_policy_mutex);
+    load_conf_policies();
+    _policies[role] = policy;
+}
+
+void uhd::thread_policy::register_policies_from_args(
+    const uhd::device_addr_t &args
+) {
+    std::lock_guard<std::mutex> lock(_policy_mutex);
+    load_conf_policies();
+    for (const std::string &key : args.keys()) {
+        if (not boost::starts_with(key, "thread_")) continue;
+        update_policy(key.substr(7), args[key]);
+    }
+}
+
+void uhd::thread_policy::apply(const std::string &role)
+{
+    policy_t policy;
+    {
+        std::lock_guard<std::mutex> lock(_policy_mutex);
+        load_conf_policies();
+        if (_policies.count(role) == 0) return;
+        policy = _policies[role];
+    }
+    //the affinity goes first: deadline admission checks it, and a
+    //deadline thread can no longer narrow its own CPU mask
+    set_thread_affinity(policy.cpu_affinity);
+    bool deadline_set = false;
+    if (policy.deadline_runtime > 0.0 and policy.deadline_period > 0.0) {
+        deadline_set = set_thread_deadline(
+            policy.deadline_runtime, policy.deadline_period);
+    }
+    if (not deadline_set and policy.has_priority) {
+        set_thread_priority_safe(policy.priority, policy.realtime);
+    }
+}
@@ -66,6 +66,25 @@ static void pack_and_unpack(
     if (if_packet_info_in.has_tsf and if_packet_info_out.has_tsf){
         BOOST_CHECK_EQUAL(if_packet_info_in.tsf, if_packet_info_out.tsf);
     }
+
+    //the trusted unpacker must decode well-formed packets identically
+    //to the fully validating one
+    if_packet_info_t if_packet_info_trusted;
+    if_packet_info_trusted.num_packet_words32 = if_packet_info_in.num_packet_words32;
+    BOOST_CHECK_EQUAL(
+        chdr::if_hdr_unpack_be_trusted(packet_buff, if_packet_info_trusted),
+        UNPACK_NO_ERROR
+    );
+    BOOST_CHECK_EQUAL(if_packet_info_out.packet_type, if_packet_info_trusted.packet_type);
+    BOOST_CHECK_EQUAL(if_packet_info_out.packet_count, if_packet_info_trusted.packet_count);
+    BOOST_CHECK_EQUAL(if_packet_info_out.num_header_words32, if_packet_info_trusted.num_header_words32);
+    BOOST_CHECK_EQUAL(if_packet_info_out.num_payload_words32, if_packet_info_trusted.num_payload_words32);
+    BOOST_CHECK_EQUAL(if_packet_info_out.num_payload_bytes, if_packet_info_trusted.num_payload_bytes);
+    BOOST_CHECK_EQUAL(if_packet_info_out.sid, if_packet_info_trusted.sid);
+    BOOST_CHECK_EQUAL(if_packet_info_out.has_tsf, if_packet_info_trusted.has_tsf);
+    if (if_packet_info_out.has_tsf){
+        BOOST_CHECK_EQUAL(if_packet_info_out.tsf, if_packet_info_trusted.tsf);
+    }
 }
 
 BOOST_AUTO_TEST_CASE(test_with_chdr){
@@ -0,0 +1,139 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/convert.hpp>
+#include <uhd/exception.hpp>
+#include <boost/program_options.hpp>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace po = boost::program_options;
+
+/*
+ * Times every registered converter across a range of buffer sizes and
+ * prints the throughput in GB/s, counting the bytes moved on both the
+ * input and output side of the conversion. Comparing runs across UHD
+ * versions (or against a stashed reference run) shows when a SIMD
+ * conversion path went missing, e.g. because a build flag changed.
+ */
+
+//! Time one converter at one buffer size, returns GB/s
+static double benchmark_converter(
+    uhd::convert::converter::sptr conv,
+    const size_t nsamps,
+    const size_t in_size,
+    const size_t out_size,
+    const size_t num_inputs,
+    const size_t num_outputs,
+    const double duration
+){
+    std::vector<std::vector<char> > in_buffs(num_inputs, std::vector<char>(nsamps*in_size));
+    std::vector<std::vector<char> > out_buffs(num_outputs, std::vector<char>(nsamps*out_size));
+    std::vector<const void *> in_ptrs(num_inputs);
+    std::vector<void *> out_ptrs(num_outputs);
+    for (size_t i = 0; i < num_inputs; i++){
+        for (size_t j = 0; j < in_buffs[i].size(); j++) in_buffs[i][j] = char(rand());
+        in_ptrs[i] = &in_buffs[i].front();
+    }
+    for (size_t i = 0; i < num_outputs; i++) out_ptrs[i] = &out_buffs[i].front();
+
+    const uhd::convert::converter::input_type in(in_ptrs);
+    const uhd::convert::converter::output_type out(out_ptrs);
+
+    //warm up the caches and branch predictors
+    conv->conv(in, out, nsamps);
+
+    const size_t bytes_per_call = nsamps*(in_size*num_inputs + out_size*num_outputs);
+    size_t num_calls = 0;
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point stop;
+    do {
+        conv->conv(in, out, nsamps);
+        num_calls++;
+        stop = std::chrono::steady_clock::now();
+    } while (std::chrono::duration<double>(stop - start).count() < duration);
+
+    const double elapsed = std::chrono::duration<double>(stop - start).count();
+    return (double(num_calls)*bytes_per_call)/elapsed/1e9;
+}
+
+int main(int argc, char *argv[]){
+    std::string filter;
+    size_t min_size, max_size;
+    double duration;
+
+    po::options_description desc("Allowed options");
+    desc.add_options()
+        ("help", "help message")
+        ("filter", po::value<std::string>(&filter)->default_value(""), "only benchmark conversions whose id contains this substring")
+        ("min-size", po::value<size_t>(&min_size)->default_value(1024), "smallest buffer size in bytes")
+        ("max-size", po::value<size_t>(&max_size)->default_value(16*1024*1024), "largest buffer size in bytes")
+        ("duration", po::value<double>(&duration)->default_value(0.25), "time to spend on each measurement in seconds")
+    ;
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")){
+        std::cout << "UHD Converter Benchmark " << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    //the benchmark buffer sizes, stepping by 4x from min to max
+    std::vector<size_t> sizes;
+    for (size_t size = min_size; size <= max_size; size *= 4) sizes.push_back(size);
+
+    std::cout << "GB/s counts bytes moved on both sides of the conversion" << std::endl;
+    std::cout << boost::format("%-44s %4s") % "conversion id" % "prio";
+    for (size_t s = 0; s < sizes.size(); s++){
+        std::cout << boost::format(" %9s") % (std::to_string(sizes[s]/1024) + "KB");
+    }
+    std::cout << std::endl;
+
+    std::vector<uhd::convert::id_type> ids = uhd::convert::get_ids();
+    std::sort(ids.begin(), ids.end(),
+        [](const uhd::convert::id_type &lhs, const uhd::convert::id_type &rhs){
+            return lhs.to_string() < rhs.to_string();
+        });
+
+    for (size_t i = 0; i < ids.size(); i++){
+        const uhd::convert::id_type &id = ids[i];
+        if (not filter.empty() and id.to_string().find(filter) == std::string::npos) continue;
+
+        size_t in_size, out_size;
+        try {
+            in_size = uhd::convert::get_bytes_per_item(id.input_format);
+            out_size = uhd::convert::get_bytes_per_item(id.output_format);
+        }
+        catch(const uhd::key_error &){
+            std::cout << boost::format("%-44s      skipped, unknown item size") % id.to_string() << std::endl;
+            continue;
+        }
+
+        for (uhd::convert::priority_type prio :  uhd::convert::get_priorities(id)){
+            uhd::convert::converter::sptr conv = uhd::convert::get_converter(id, prio)();
+            conv->set_scalar(1.0/32767);
+
+            std::cout << boost::format("%-44s %4d") % id.to_string() % prio << std::flush;
+            for (size_t s = 0; s < sizes.size(); s++){
+                //size the sample count off the larger side of the conversion
+                const size_t item_size = std::max(in_size, out_size);
+                const size_t nsamps = std::max<size_t>(sizes[s]/item_size, 1);
+                const double gbps = benchmark_converter(
+                    conv, nsamps, in_size, out_size, id.num_inputs, id.num_outputs, duration);
+                std::cout << boost::format(" %9.3f") % gbps << std::flush;
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -6,8 +6,10 @@
 //
 
 #include <uhd/convert.hpp>
+#include <uhd/exception.hpp>
 #include <boost/test/unit_test.hpp>
 #include <stdint.h>
+#include <algorithm>
 #include <complex>
 #include <vector>
 #include <cstdlib>
@@ -251,6 +253,80 @@ BOOST_AUTO_TEST_CASE(test_convert_types_be_sc16_and_sc12){
     }
 }
 
+/***********************************************************************
+ * Test float to/from sc4 conversion loopback
+ **********************************************************************/
+static void test_convert_types_fc32_with_sc4(size_t nsamps, convert::id_type &id){
+    //fill the input samples
+    std::vector<fc32_t> input(nsamps), output(nsamps);
+    for(fc32_t &in:  input) in = fc32_t(
+        (std::rand()/(RAND_MAX/2.0)) - 1,
+        (std::rand()/(RAND_MAX/2.0)) - 1
+    );
+
+    //run the loopback and test (4-bit wire: half an LSB is 1/16)
+    convert::id_type in_id = id;
+    convert::id_type out_id = id;
+    std::swap(out_id.input_format, out_id.output_format);
+    std::swap(out_id.num_inputs, out_id.num_outputs);
+    loopback(nsamps, in_id, out_id, input, output);
+    for (size_t i = 0; i < nsamps; i++){
+        MY_CHECK_CLOSE(input[i].real(), output[i].real(), float(0.13));
+        MY_CHECK_CLOSE(input[i].imag(), output[i].imag(), float(0.13));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_convert_types_le_sc4_with_fc32){
+    convert::id_type id;
+    id.input_format = "fc32";
+    id.num_inputs = 1;
+    id.output_format = "sc4_item32_le";
+    id.num_outputs = 1;
+
+    //try various lengths to test edge cases
+    for (size_t nsamps = 1; nsamps < 16; nsamps++){
+        test_convert_types_fc32_with_sc4(nsamps, id);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_convert_types_be_sc4_with_fc32){
+    convert::id_type id;
+    id.input_format = "fc32";
+    id.num_inputs = 1;
+    id.output_format = "sc4_item32_be";
+    id.num_outputs = 1;
+
+    //try various lengths to test edge cases
+    for (size_t nsamps = 1; nsamps < 16; nsamps++){
+        test_convert_types_fc32_with_sc4(nsamps, id);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_convert_types_le_sc16_and_sc4){
+    convert::id_type id;
+    id.input_format = "sc16";
+    id.num_inputs = 1;
+    id.num_outputs = 1;
+
+    //try various lengths to test edge cases
+    id.output_format = "sc4_item32_le";
+    for (size_t nsamps = 1; nsamps < 16; nsamps++){
+        test_convert_types_sc16(nsamps, id, 1, 0xf000);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_convert_types_be_sc16_and_sc4){
+    convert::id_type id;
+    id.input_format = "sc16";
+    id.num_inputs = 1;
+    id.num_outputs = 1;
+
+    id.output_format = "sc4_item32_be";
+    for (size_t nsamps = 1; nsamps < 16; nsamps++){
+        test_convert_types_sc16(nsamps, id, 1, 0xf000);
+    }
+}
+
 /***********************************************************************
  * Test float to/from fc32 conversion loopback
  **********************************************************************/
@@ -371,6 +447,72 @@ BOOST_AUTO_TEST_CASE(test_convert_types_sc16_to_fc32){
     }
 }
 
+/***********************************************************************
+ * Test dithered short to float conversion
+ **********************************************************************/
+BOOST_AUTO_TEST_CASE(test_convert_types_sc16_to_fc32_dithered){
+    convert::id_type in_id;
+    in_id.input_format = "sc16";
+    in_id.num_inputs = 1;
+    in_id.output_format = "sc16_item32_le";
+    in_id.num_outputs = 1;
+
+    convert::id_type out_id;
+    out_id.input_format = "sc16_item32_le";
+    out_id.num_inputs = 1;
+    out_id.output_format = "fc32";
+    out_id.num_outputs = 1;
+
+    //dithered kernels are only registered on SIMD-capable builds
+    const std::vector<convert::priority_type> prios = convert::get_priorities(out_id);
+    if (std::find(prios.begin(), prios.end(), convert::PRIORITY_DITHERED) == prios.end()){
+        return;
+    }
+
+    const size_t nsamps = 61; //not a multiple of the SIMD width
+    std::vector<sc16_t> input(nsamps);
+    for(sc16_t &in:  input) in = sc16_t(
+        std::rand()-(RAND_MAX/2),
+        std::rand()-(RAND_MAX/2)
+    );
+    std::vector<uint32_t> interm(nsamps);
+    std::vector<fc32_t> output0_buff(nsamps), output1_buff(nsamps);
+
+    std::vector<const void *> input0(1, &input[0]), input1(1, &interm[0]);
+    std::vector<void *> output0(1, &interm[0]);
+    std::vector<void *> output1(1, &output0_buff[0]), output2(1, &output1_buff[0]);
+
+    //convert short to intermediate
+    convert::converter::sptr c0 = convert::get_converter(in_id)();
+    c0->set_scalar(32767.);
+    c0->conv(input0, output0, nsamps);
+
+    //convert intermediate to float with dither
+    convert::converter::sptr c1 = convert::get_converter(out_id, convert::PRIORITY_DITHERED)();
+    c1->set_scalar(1/32767.);
+    c1->conv(input1, output1, nsamps);
+
+    //the dither moves each sample by at most half an LSB
+    const float lsb = 1.0f/32767;
+    size_t num_moved = 0;
+    for (size_t i = 0; i < nsamps; i++){
+        const float expected_r = input[i].real()*lsb;
+        const float expected_i = input[i].imag()*lsb;
+        BOOST_CHECK(std::abs(output0_buff[i].real() - expected_r) <= lsb*0.51);
+        BOOST_CHECK(std::abs(output0_buff[i].imag() - expected_i) <= lsb*0.51);
+        if (output0_buff[i].real() != expected_r) num_moved++;
+    }
+    BOOST_CHECK(num_moved != 0);
+
+    //the generator state advances, so a second pass dithers differently
+    c1->conv(input1, output2, nsamps);
+    size_t num_different = 0;
+    for (size_t i = 0; i < nsamps; i++){
+        if (output0_buff[i] != output1_buff[i]) num_different++;
+    }
+    BOOST_CHECK(num_different != 0);
+}
+
 /***********************************************************************
  * Test sc8 conversions
  **********************************************************************/
@@ -630,3 +772,36 @@ BOOST_AUTO_TEST_CASE(test_convert_types_f32_and_f32){
         test_convert_types_f32(nsamps, id);
     }
 }
+
+/***********************************************************************
+ * Test converter registry introspection
+ **********************************************************************/
+BOOST_AUTO_TEST_CASE(test_convert_registry_introspection){
+    const std::vector<convert::id_type> ids = convert::get_ids();
+    BOOST_REQUIRE(not ids.empty());
+
+    for (const convert::id_type &id : ids){
+        const std::vector<convert::priority_type> prios =
+            convert::get_priorities(id);
+        BOOST_REQUIRE(not prios.empty());
+
+        //the default resolution picks the best registered priority
+        const convert::priority_type best_prio =
+            *std::max_element(prios.begin(), prios.end());
+        BOOST_CHECK_EQUAL(convert::get_converter_priority(id), best_prio);
+
+        //forcing a registered priority returns exactly that priority
+        for (const convert::priority_type prio : prios){
+            BOOST_CHECK_EQUAL(convert::get_converter_priority(id, prio), prio);
+            const convert::converter_info_type info =
+                convert::get_converter_info(id, prio);
+            BOOST_CHECK_EQUAL(info.priority, prio);
+            BOOST_CHECK(not info.impl_class.empty());
+            BOOST_CHECK(not info.to_pp_string().empty());
+        }
+    }
+
+    //forcing an unregistered priority is an error
+    BOOST_CHECK_THROW(
+        convert::get_converter_priority(ids.front(), 1000), uhd::key_error);
+}
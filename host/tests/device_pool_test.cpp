@@ -0,0 +1,148 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/device_pool.hpp>
+#include <uhd/device.hpp>
+#include <uhd/exception.hpp>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace uhd;
+
+/***********************************************************************
+ * Mock device registered into the real discovery and factory system.
+ *
+ * The mock only answers hints with type=mock_pool so it stays invisible
+ * to everything else in this process. Global counters let the tests
+ * observe what the pool does behind the scenes.
+ **********************************************************************/
+namespace {
+    std::atomic<size_t> num_makes(0);
+    std::atomic<size_t> num_rx_streams(0);
+    std::atomic<size_t> num_resets(0);
+
+    struct mock_rx_streamer : rx_streamer{
+        size_t get_num_channels(void) const{return 1;}
+        size_t get_max_num_samps(void) const{return 363;}
+        size_t recv(
+            const buffs_type &, const size_t, rx_metadata_t &,
+            const double, const bool
+        ){return 0;}
+        void issue_stream_cmd(const stream_cmd_t &){}
+    };
+
+    struct mock_tx_streamer : tx_streamer{
+        size_t get_num_channels(void) const{return 1;}
+        size_t get_max_num_samps(void) const{return 363;}
+        size_t send(
+            const buffs_type &, const size_t, const tx_metadata_t &,
+            const double
+        ){return 0;}
+        bool recv_async_msg(async_metadata_t &, double){return false;}
+    };
+
+    struct mock_device : device{
+        rx_streamer::sptr get_rx_stream(const stream_args_t &){
+            num_rx_streams++;
+            return rx_streamer::sptr(new mock_rx_streamer());
+        }
+        tx_streamer::sptr get_tx_stream(const stream_args_t &){
+            return tx_streamer::sptr(new mock_tx_streamer());
+        }
+        bool recv_async_msg(async_metadata_t &, double){return false;}
+    };
+
+    device_addrs_t mock_find(const device_addr_t &hint){
+        device_addrs_t addrs;
+        if (hint.get("type", "") == "mock_pool"){
+            device_addr_t addr;
+            addr["type"] = "mock_pool";
+            addr["serial"] = "F00D";
+            addrs.push_back(addr);
+        }
+        return addrs;
+    }
+
+    device::sptr mock_make(const device_addr_t &){
+        num_makes++;
+        return device::sptr(new mock_device());
+    }
+
+    void ensure_registered(void){
+        static bool registered = false;
+        if (not registered){
+            device::register_device(&mock_find, &mock_make, device::USRP);
+            registered = true;
+        }
+        num_makes = 0;
+        num_rx_streams = 0;
+        num_resets = 0;
+    }
+
+    //spin until the pool reports a ready device (preparation is async)
+    void wait_until_ready(device_pool::sptr pool){
+        const auto exit_time = std::chrono::steady_clock::now()
+            + std::chrono::seconds(5);
+        while (pool->num_ready() == 0
+                and std::chrono::steady_clock::now() < exit_time){
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        BOOST_REQUIRE(pool->num_ready() > 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_device_pool_acquire){
+    ensure_registered();
+
+    device_addr_t hint;
+    hint["type"] = "mock_pool";
+    device_pool::sptr pool = device_pool::make(
+        hint, 1, stream_args_t("fc32"));
+    BOOST_CHECK_EQUAL(pool->size(), 1);
+    wait_until_ready(pool);
+
+    //the device and its streamer were prepared in the background
+    BOOST_CHECK_EQUAL(num_makes, 1);
+    BOOST_CHECK_EQUAL(num_rx_streams, 1);
+
+    //a warm acquire hands out the prepared device without further setup
+    device_pool::session::sptr session = pool->acquire(1.0);
+    BOOST_REQUIRE(bool(session->get_device()));
+    BOOST_REQUIRE(bool(session->get_rx_stream()));
+    BOOST_CHECK_EQUAL(num_makes, 1);
+    BOOST_CHECK_EQUAL(pool->num_ready(), 0);
+
+    //no tx template was given, so there is no tx streamer to hand out
+    BOOST_CHECK_THROW(session->get_tx_stream(), uhd::runtime_error);
+
+    //the only device is out: a second acquire must time out
+    BOOST_CHECK_THROW(pool->acquire(0.1), uhd::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_device_pool_release_reinit){
+    ensure_registered();
+
+    device_addr_t hint;
+    hint["type"] = "mock_pool";
+    device_pool::sptr pool = device_pool::make(
+        hint, 1, stream_args_t("fc32"), stream_args_t(),
+        [](device::sptr){num_resets++;});
+    wait_until_ready(pool);
+
+    pool->acquire(1.0); //acquire and release right away
+    wait_until_ready(pool);
+
+    //the device went back through the worker: reset callback ran and a
+    //fresh streamer was created, but the device itself was kept
+    BOOST_CHECK_EQUAL(num_makes, 1);
+    BOOST_CHECK_EQUAL(num_resets, 1);
+    BOOST_CHECK_EQUAL(num_rx_streams, 2);
+
+    device_pool::session::sptr session = pool->acquire(1.0);
+    BOOST_REQUIRE(bool(session->get_rx_stream()));
+}
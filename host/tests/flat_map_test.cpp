@@ -0,0 +1,52 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <boost/test/unit_test.hpp>
+#include <uhdlib/utils/flat_map.hpp>
+#include <string>
+
+BOOST_AUTO_TEST_CASE(test_flat_map_init){
+    uhd::flat_map<int, int> m;
+    BOOST_CHECK_EQUAL(m.size(), size_t(0));
+    m[-1] = 3;
+    m[0] = 4;
+    m[1] = 5;
+    BOOST_CHECK_EQUAL(m.size(), size_t(3));
+    BOOST_CHECK(m.has_key(0));
+    BOOST_CHECK(not m.has_key(2));
+    BOOST_CHECK_EQUAL(m[-1], 3);
+    BOOST_CHECK_EQUAL(m.get(0), 4);
+    BOOST_CHECK_EQUAL(m.keys().size(), size_t(3));
+}
+
+BOOST_AUTO_TEST_CASE(test_flat_map_get_throws){
+    uhd::flat_map<std::string, int> m;
+    m["key"] = 42;
+    BOOST_CHECK_EQUAL(m.get("key"), 42);
+    BOOST_CHECK_THROW(m.get("nope"), uhd::key_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_flat_map_update){
+    uhd::flat_map<std::string, int> m;
+    m["key"] = 1;
+    m["key"] = 2;
+    BOOST_CHECK_EQUAL(m.size(), size_t(1));
+    BOOST_CHECK_EQUAL(m.get("key"), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_flat_map_grow){
+    //insert well past the initial table size to force rehashing
+    uhd::flat_map<int, int> m;
+    for (int i = 0; i < 1000; i++){
+        m[i] = i + 1;
+    }
+    BOOST_CHECK_EQUAL(m.size(), size_t(1000));
+    for (int i = 0; i < 1000; i++){
+        BOOST_CHECK(m.has_key(i));
+        BOOST_CHECK_EQUAL(m.get(i), i + 1);
+    }
+    BOOST_CHECK_EQUAL(m.keys().size(), size_t(1000));
+}
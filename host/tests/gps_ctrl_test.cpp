@@ -0,0 +1,124 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/usrp/gps_ctrl.hpp>
+#include <uhd/types/sensors.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/format.hpp>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace uhd;
+
+/***********************************************************************
+ * Mock a GPSDO behind the uart_iface.
+ *
+ * The mock never answers *IDN?, so gps_ctrl settles on the generic
+ * NMEA device type. A fixed set of sentences is replayed over and over,
+ * paced so that the background refresher sees at most one line per
+ * read and its drain loop terminates.
+ **********************************************************************/
+namespace {
+    //append the NMEA checksum to a sentence body
+    std::string nmea(const std::string &body){
+        unsigned crc = 0;
+        for (const char c : body) crc ^= c;
+        return str(boost::format("$%s*%02X") % body % crc);
+    }
+
+    //these end in an empty field because the sentence regex in gps_ctrl
+    //requires a comma right before the checksum
+    const std::string GPRMC = nmea(
+        "GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,150823,003.1,W,");
+    const std::string GPGGA = nmea(
+        "GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,");
+}
+
+struct mock_uart : uart_iface{
+    mock_uart(const std::vector<std::string> &repeat):
+        _repeat(repeat),
+        _repeat_index(0),
+        _next_emit(std::chrono::steady_clock::now())
+    {
+        //NOP
+    }
+
+    void write_uart(const std::string &){
+        //commands get no reply: the device looks like a generic NMEA GPS
+    }
+
+    std::string read_uart(double timeout){
+        const auto exit_time = std::chrono::steady_clock::now()
+            + std::chrono::milliseconds(long(timeout*1000));
+        while (1){
+            {
+                boost::lock_guard<boost::mutex> lock(_mutex);
+                if (std::chrono::steady_clock::now() >= _next_emit){
+                    _next_emit = std::chrono::steady_clock::now()
+                        + std::chrono::milliseconds(100);
+                    return _repeat[_repeat_index++ % _repeat.size()] + "\r\n";
+                }
+            }
+            if (std::chrono::steady_clock::now() >= exit_time) return "";
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    boost::mutex _mutex;
+    const std::vector<std::string> _repeat;
+    size_t _repeat_index;
+    std::chrono::steady_clock::time_point _next_emit;
+};
+
+BOOST_AUTO_TEST_CASE(test_gps_ctrl_cached_sensors){
+    boost::shared_ptr<mock_uart> uart(new mock_uart({GPRMC, GPGGA}));
+    gps_ctrl::sptr gps = gps_ctrl::make(uart);
+    BOOST_REQUIRE(gps->gps_detected());
+
+    //give the background refresher time to publish both sentences
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+    //cached sensors come back from the last published snapshot, well
+    //under the second it takes the device to produce a new sentence
+    const auto start = std::chrono::steady_clock::now();
+    BOOST_CHECK_EQUAL(gps->get_sensor("gps_gpgga").value, GPGGA);
+    BOOST_CHECK_EQUAL(gps->get_sensor("gps_gprmc").value, GPRMC);
+    BOOST_CHECK(gps->get_sensor("gps_locked").to_bool());
+    BOOST_CHECK(std::chrono::steady_clock::now() - start
+        < std::chrono::milliseconds(100));
+
+    //gps_time waits for the next GPRMC, then decodes it
+    using namespace boost::posix_time;
+    const ptime expected(boost::gregorian::date(2023, 8, 15),
+        time_duration(12, 35, 19));
+    BOOST_CHECK_EQUAL(gps->get_sensor("gps_time").to_int(),
+        int((expected - from_time_t(0)).total_seconds()));
+}
+
+BOOST_AUTO_TEST_CASE(test_gps_ctrl_fix_callback){
+    boost::shared_ptr<mock_uart> uart(new mock_uart({GPRMC, GPGGA}));
+    gps_ctrl::sptr gps = gps_ctrl::make(uart);
+    BOOST_REQUIRE(gps->gps_detected());
+
+    std::atomic<size_t> num_fixes(0);
+    gps->subscribe_fix_callback([&num_fixes](void){
+        num_fixes++;
+    });
+
+    //every replayed sentence republishes the snapshot and fires the
+    //callback from the polling thread
+    const auto exit_time = std::chrono::steady_clock::now()
+        + std::chrono::seconds(2);
+    while (num_fixes == 0 and std::chrono::steady_clock::now() < exit_time){
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    BOOST_CHECK(num_fixes > 0);
+}
@@ -0,0 +1,124 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <boost/test/unit_test.hpp>
+#include <uhdlib/utils/polyphase_resampler.hpp>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+typedef std::complex<float> fc32_t;
+
+static const double PI = 3.14159265358979323846;
+
+BOOST_AUTO_TEST_CASE(test_resampler_params){
+    BOOST_CHECK_THROW(uhd::polyphase_resampler(0.0), uhd::value_error);
+    BOOST_CHECK_THROW(uhd::polyphase_resampler(-1.5), uhd::value_error);
+    BOOST_CHECK_THROW(uhd::polyphase_resampler(0.5, 1), uhd::value_error);
+    uhd::polyphase_resampler resamp(0.75);
+    BOOST_CHECK_CLOSE(resamp.rate(), 0.75, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(test_resampler_output_count){
+    //feed the stream in chunks and check the aggregate output count
+    //lands within one sample per chunk of num_input * rate
+    const double rate = 0.96; //3.84 Msps out of 4 Msps
+    uhd::polyphase_resampler resamp(rate);
+    std::vector<fc32_t> in(1000, fc32_t(1.0f, 0.0f));
+    std::vector<fc32_t> out(resamp.max_output_size(in.size()));
+    size_t total_out = 0;
+    const size_t num_chunks = 20;
+    for (size_t i = 0; i < num_chunks; i++){
+        total_out += resamp.process(&in.front(), in.size(), &out.front());
+    }
+    const double expected = num_chunks * in.size() * rate;
+    BOOST_CHECK(std::abs(double(total_out) - expected) < double(num_chunks));
+}
+
+BOOST_AUTO_TEST_CASE(test_resampler_dc_gain){
+    //a constant input must come out at the same level for any rate
+    const double rates[] = {0.75, 0.96, 1.0, 4.0/3};
+    for (const double rate : rates){
+        uhd::polyphase_resampler resamp(rate);
+        std::vector<fc32_t> in(500, fc32_t(0.5f, -0.25f));
+        std::vector<fc32_t> out(resamp.max_output_size(in.size()));
+        const size_t num_out = resamp.process(&in.front(), in.size(), &out.front());
+        BOOST_REQUIRE(num_out > 100);
+        //skip the filter transient at the head
+        for (size_t i = 50; i < num_out; i++){
+            BOOST_CHECK(std::abs(out[i].real() - 0.5f) < 0.01f);
+            BOOST_CHECK(std::abs(out[i].imag() + 0.25f) < 0.01f);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_resampler_tone){
+    //resample a complex tone and check it lands on the scaled frequency
+    const double rate = 0.75;
+    const double freq = 0.05; //cycles per input sample, well inside passband
+    uhd::polyphase_resampler resamp(rate);
+    std::vector<fc32_t> in(2000);
+    for (size_t n = 0; n < in.size(); n++){
+        in[n] = fc32_t(float(std::cos(2*PI*freq*n)), float(std::sin(2*PI*freq*n)));
+    }
+    std::vector<fc32_t> out(resamp.max_output_size(in.size()));
+    const size_t num_out = resamp.process(&in.front(), in.size(), &out.front());
+    BOOST_REQUIRE(num_out > 200);
+    //measure the phase advance per output sample over the steady state
+    double freq_sum = 0.0;
+    size_t count = 0;
+    for (size_t i = 100; i + 1 < num_out; i++, count++){
+        const std::complex<double> a(out[i].real(), out[i].imag());
+        const std::complex<double> b(out[i+1].real(), out[i+1].imag());
+        freq_sum += std::arg(b * std::conj(a)) / (2*PI);
+    }
+    const double freq_meas = freq_sum / count;
+    BOOST_CHECK(std::abs(freq_meas - freq/rate) < 1e-3);
+    //amplitude should survive the passband
+    for (size_t i = 100; i < num_out; i++){
+        BOOST_CHECK(std::abs(std::abs(out[i]) - 1.0f) < 0.02f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_resampler_chunked_matches_whole){
+    //chunked processing must produce the same stream as one call
+    const double rate = 4.0/3;
+    std::vector<fc32_t> in(900);
+    for (size_t n = 0; n < in.size(); n++){
+        in[n] = fc32_t(float(std::sin(0.1*n)), float(std::cos(0.07*n)));
+    }
+    uhd::polyphase_resampler whole(rate);
+    std::vector<fc32_t> out_whole(whole.max_output_size(in.size()));
+    const size_t num_whole = whole.process(&in.front(), in.size(), &out_whole.front());
+
+    uhd::polyphase_resampler chunked(rate);
+    std::vector<fc32_t> out_chunked;
+    std::vector<fc32_t> tmp(chunked.max_output_size(in.size()));
+    const size_t chunk = 77;
+    for (size_t off = 0; off < in.size(); off += chunk){
+        const size_t len = std::min(chunk, in.size() - off);
+        const size_t n = chunked.process(&in[off], len, &tmp.front());
+        out_chunked.insert(out_chunked.end(), tmp.begin(), tmp.begin() + n);
+    }
+    BOOST_REQUIRE_EQUAL(num_whole, out_chunked.size());
+    for (size_t i = 0; i < num_whole; i++){
+        BOOST_CHECK(std::abs(out_whole[i] - out_chunked[i]) < 1e-5f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_resampler_reset){
+    uhd::polyphase_resampler resamp(0.9);
+    std::vector<fc32_t> in(300, fc32_t(1.0f, 0.0f));
+    std::vector<fc32_t> out_a(resamp.max_output_size(in.size()));
+    std::vector<fc32_t> out_b(resamp.max_output_size(in.size()));
+    const size_t num_a = resamp.process(&in.front(), in.size(), &out_a.front());
+    resamp.reset();
+    const size_t num_b = resamp.process(&in.front(), in.size(), &out_b.front());
+    BOOST_REQUIRE_EQUAL(num_a, num_b);
+    for (size_t i = 0; i < num_a; i++){
+        BOOST_CHECK(std::abs(out_a[i] - out_b[i]) < 1e-6f);
+    }
+}
@@ -114,6 +114,27 @@ BOOST_AUTO_TEST_CASE(test_prop_manual_coercion){
     BOOST_CHECK_EQUAL(csetter._x, 34);
 }
 
+BOOST_AUTO_TEST_CASE(test_prop_get_cref){
+    uhd::property_tree::sptr tree = uhd::property_tree::make();
+    uhd::property<int> &prop = tree->create<int>("/");
+
+    BOOST_CHECK_THROW(prop.get_cref(), std::exception);
+
+    prop.set(42);
+    BOOST_CHECK_EQUAL(prop.get_cref(), 42);
+
+    //the reference aliases the stored value across reads
+    const int *addr = &prop.get_cref();
+    prop.set(34);
+    BOOST_CHECK_EQUAL(prop.get_cref(), 34);
+    BOOST_CHECK_EQUAL(addr, &prop.get_cref());
+
+    //a publisher yields a temporary, no reference can be returned
+    getter_type getter;
+    prop.set_publisher(boost::bind(&getter_type::doit, &getter));
+    BOOST_CHECK_THROW(prop.get_cref(), std::exception);
+}
+
 BOOST_AUTO_TEST_CASE(test_prop_with_publisher){
     uhd::property_tree::sptr tree = uhd::property_tree::make();
     uhd::property<int> &prop = tree->create<int>("/");
@@ -216,6 +237,116 @@ BOOST_AUTO_TEST_CASE(test_prop_subtree){
 }
 
 
+BOOST_AUTO_TEST_CASE(test_prop_lazy_subtree){
+    uhd::property_tree::sptr tree = uhd::property_tree::make();
+    size_t populator_calls = 0;
+    tree->register_lazy_subtree("/lazy", [tree, &populator_calls](){
+        populator_calls++;
+        tree->create<int>("/lazy/prop0").set(42);
+    });
+
+    //creating a sibling under the same branch must not trigger the populator
+    tree->create<int>("/lazy/prop1").set(34);
+    BOOST_CHECK_EQUAL(populator_calls, 0);
+
+    //the first query of the branch materializes it exactly once
+    const std::vector<std::string> dirs = tree->list("/lazy");
+    BOOST_CHECK_EQUAL(populator_calls, 1);
+    BOOST_CHECK_EQUAL(dirs.size(), 2);
+    BOOST_CHECK(tree->exists("/lazy/prop0"));
+    BOOST_CHECK_EQUAL(tree->access<int>("/lazy/prop0").get(), 42);
+    BOOST_CHECK_EQUAL(tree->access<int>("/lazy/prop1").get(), 34);
+    BOOST_CHECK_EQUAL(populator_calls, 1);
+
+    //a populator registered below an existing branch triggers on access
+    tree->register_lazy_subtree("/lazy/deeper", [tree, &populator_calls](){
+        populator_calls++;
+        tree->create<int>("/lazy/deeper/prop2").set(1);
+    });
+    BOOST_CHECK_EQUAL(tree->access<int>("/lazy/deeper/prop2").get(), 1);
+    BOOST_CHECK_EQUAL(populator_calls, 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_prop_snapshot){
+    uhd::property_tree::sptr tree = uhd::property_tree::make();
+    tree->create<int>("/mb/prop0").set(0);
+    tree->create<int>("/mb/sub/prop1").set(1);
+    tree->create<int>("/mb/sub/prop2").set(2);
+    tree->create<int>("/other/prop3").set(3);
+
+    //a snapshot collects every property path below the given path
+    std::vector<uhd::fs_path> paths = tree->snapshot("/mb");
+    BOOST_CHECK_EQUAL(paths.size(), 3);
+    for (const uhd::fs_path &path : paths){
+        BOOST_CHECK(tree->exists(path));
+        BOOST_CHECK(not tree->access<int>(path).empty());
+    }
+
+    //lazily registered branches materialize before the walk
+    tree->register_lazy_subtree("/mb/lazy", [tree](){
+        tree->create<int>("/mb/lazy/prop4").set(4);
+    });
+    BOOST_CHECK_EQUAL(tree->snapshot("/mb").size(), 4);
+
+    //registered bulk backends run once per covering snapshot
+    size_t backend_calls = 0;
+    tree->register_snapshot_backend("/mb", [&backend_calls](){
+        backend_calls++;
+    });
+    tree->snapshot("/mb");
+    BOOST_CHECK_EQUAL(backend_calls, 1);
+    tree->snapshot("/mb/sub");
+    BOOST_CHECK_EQUAL(backend_calls, 2);
+    tree->snapshot("/other");
+    BOOST_CHECK_EQUAL(backend_calls, 2);
+
+    //snapshots work relative to a subtree view
+    uhd::property_tree::sptr subtree = tree->subtree("/mb");
+    const std::vector<uhd::fs_path> sub_paths = subtree->snapshot("sub");
+    BOOST_CHECK_EQUAL(sub_paths.size(), 2);
+    for (const uhd::fs_path &path : sub_paths){
+        BOOST_CHECK(subtree->exists(path));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_prop_intern){
+    uhd::property_tree::sptr tree = uhd::property_tree::make();
+    tree->create<double>("/mb/tick_rate").set(100e6);
+    tree->create<int>("/mb/other").set(7);
+
+    //a handle resolves once and reads/writes track the property
+    const uhd::property_tree::path_handle_t handle = tree->intern("/mb/tick_rate");
+    BOOST_CHECK_EQUAL(tree->access<double>(handle).get(), 100e6);
+    tree->access<double>(handle).set(200e6);
+    BOOST_CHECK_EQUAL(tree->access<double>("/mb/tick_rate").get(), 200e6);
+    tree->access<double>("/mb/tick_rate").set(120e6);
+    BOOST_CHECK_EQUAL(tree->access<double>(handle).get(), 120e6);
+
+    //interning the same path again yields the same handle
+    BOOST_CHECK_EQUAL(tree->intern("/mb/tick_rate"), handle);
+    BOOST_CHECK(tree->intern("/mb/other") != handle);
+
+    //handles are shared with subtree views of the same guts
+    uhd::property_tree::sptr subtree = tree->subtree("/mb");
+    BOOST_CHECK_EQUAL(subtree->intern("tick_rate"), handle);
+    BOOST_CHECK_EQUAL(subtree->access<double>(handle).get(), 120e6);
+
+    //interning resolves lazy branches, like access does
+    tree->register_lazy_subtree("/mb/lazy", [tree](){
+        tree->create<int>("/mb/lazy/prop").set(5);
+    });
+    const uhd::property_tree::path_handle_t lazy_handle = tree->intern("/mb/lazy/prop");
+    BOOST_CHECK_EQUAL(tree->access<int>(lazy_handle).get(), 5);
+
+    //a handle pins the property across removal of its path
+    tree->remove("/mb/other");
+    BOOST_CHECK(not tree->exists("/mb/other"));
+
+    //missing paths and bogus handles throw lookup errors
+    BOOST_CHECK_THROW(tree->intern("/mb/nope"), uhd::lookup_error);
+    BOOST_CHECK_THROW(tree->access<int>(uhd::property_tree::path_handle_t(999)), uhd::lookup_error);
+}
+
 BOOST_AUTO_TEST_CASE(test_prop_operators)
 {
     uhd::fs_path path1 = "/root/";
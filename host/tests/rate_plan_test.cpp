@@ -0,0 +1,84 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/rfnoc/rate_plan.hpp>
+#include <uhd/exception.hpp>
+#include <boost/test/unit_test.hpp>
+#include <iostream>
+
+using namespace uhd::rfnoc;
+
+// an X300-style DDC stage: 3 halfbands, CIC up to 255
+static dsp_stage_caps x300_stage(void)
+{
+    return dsp_stage_caps(3, 255);
+}
+
+BOOST_AUTO_TEST_CASE(test_rate_plan_single_stage)
+{
+    std::vector<dsp_stage_caps> stages(1, x300_stage());
+
+    // a power of two fills the halfbands before the CIC
+    rate_plan plan = plan_rate_chain(stages, 16);
+    BOOST_REQUIRE_EQUAL(plan.stages.size(), 1);
+    BOOST_CHECK_EQUAL(plan.get_total_decim(), 16);
+    BOOST_CHECK_EQUAL(plan.stages[0].num_halfbands, 3);
+    BOOST_CHECK_EQUAL(plan.stages[0].cic_decim, 2);
+
+    // decimation of one is a passthrough
+    plan = plan_rate_chain(stages, 1);
+    BOOST_CHECK_EQUAL(plan.stages[0].decim, 1);
+    BOOST_CHECK_EQUAL(plan.cost, 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(test_rate_plan_two_stages)
+{
+    std::vector<dsp_stage_caps> single(1, x300_stage());
+    std::vector<dsp_stage_caps> stages(2, x300_stage());
+
+    // 4080 = 16 * 255 exceeds the range of one stage (3 halfbands and
+    // a CIC of 255 top out at 2040), but a cascade can realize it
+    BOOST_CHECK_THROW(plan_rate_chain(single, 4080), uhd::value_error);
+    rate_plan plan = plan_rate_chain(stages, 4080);
+    std::cout << plan.to_pp_string() << std::endl;
+    BOOST_CHECK_EQUAL(plan.get_total_decim(), 4080);
+    BOOST_CHECK(plan.stages[0].decim > 1);
+    BOOST_CHECK(plan.stages[1].decim > 1);
+
+    // a rate change that fits one stage costs no extra in a cascade:
+    // the planner leaves the other stage as a passthrough
+    plan = plan_rate_chain(stages, 64);
+    BOOST_CHECK_EQUAL(plan.get_total_decim(), 64);
+    BOOST_CHECK_EQUAL(plan.cost, plan_rate_chain(single, 64).cost);
+}
+
+BOOST_AUTO_TEST_CASE(test_rate_plan_avoids_odd_cic)
+{
+    std::vector<dsp_stage_caps> stages(2, x300_stage());
+
+    // 6 = 2*3: the plan should put the odd factor behind a halfband
+    // in one stage rather than run a bare odd CIC in each
+    const rate_plan plan = plan_rate_chain(stages, 6);
+    BOOST_CHECK_EQUAL(plan.get_total_decim(), 6);
+    for (const rate_plan::stage_type &stage : plan.stages) {
+        if (stage.cic_decim > 1) {
+            BOOST_CHECK(stage.decim % 2 == 0);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_rate_plan_infeasible)
+{
+    // a prime larger than the CIC range cannot be realized
+    std::vector<dsp_stage_caps> stages(1, dsp_stage_caps(3, 4));
+    BOOST_CHECK_THROW(plan_rate_chain(stages, 7), uhd::value_error);
+    BOOST_CHECK_THROW(plan_rate_chain(stages, 0), uhd::value_error);
+
+    // no stages can only realize a decimation of one
+    std::vector<dsp_stage_caps> no_stages;
+    BOOST_CHECK_EQUAL(plan_rate_chain(no_stages, 1).get_total_decim(), 1);
+    BOOST_CHECK_THROW(plan_rate_chain(no_stages, 2), uhd::value_error);
+}
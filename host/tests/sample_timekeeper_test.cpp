@@ -0,0 +1,84 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/types/sample_timekeeper.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace uhd;
+
+BOOST_AUTO_TEST_CASE(test_timekeeper_integer_ratio){
+    //200 MHz timebase, 25 Msps: exactly 8 ticks per sample
+    sample_timekeeper tk;
+    tk.set_tick_rate(200e6);
+    tk.set_samp_rate(25e6);
+    BOOST_CHECK(not tk.is_anchored());
+
+    rx_metadata_t md;
+    md.has_time_spec = true;
+    md.time_spec = time_spec_t::from_ticks(1000000, 200e6);
+    tk.update(md, 1000);
+    BOOST_CHECK(tk.is_anchored());
+
+    BOOST_CHECK_EQUAL(tk.get_ticks(0), uint64_t(1000000));
+    BOOST_CHECK_EQUAL(tk.get_ticks(1), uint64_t(1000008));
+    BOOST_CHECK_EQUAL(tk.get_ticks(999), uint64_t(1000000 + 999*8));
+}
+
+BOOST_AUTO_TEST_CASE(test_timekeeper_free_running){
+    sample_timekeeper tk;
+    tk.set_tick_rate(200e6);
+    tk.set_samp_rate(25e6);
+
+    rx_metadata_t md;
+    md.has_time_spec = true;
+    md.time_spec = time_spec_t::from_ticks(0, 200e6);
+    tk.update(md, 1000);
+
+    //subsequent buffers without a time free-run from the anchor
+    md.has_time_spec = false;
+    tk.update(md, 1000);
+    BOOST_CHECK_EQUAL(tk.get_ticks(0), uint64_t(1000*8));
+    tk.update(md, 500);
+    BOOST_CHECK_EQUAL(tk.get_ticks(0), uint64_t(2000*8));
+    BOOST_CHECK_EQUAL(tk.get_ticks(499), uint64_t(2499*8));
+}
+
+BOOST_AUTO_TEST_CASE(test_timekeeper_fractional_ratio){
+    //61.44 MHz timebase at 10 Msps: 6.144 ticks per sample, so the
+    //fractional accumulation must stay exact over many buffers
+    sample_timekeeper tk;
+    tk.set_tick_rate(61.44e6);
+    tk.set_samp_rate(10e6);
+
+    rx_metadata_t md;
+    md.has_time_spec = true;
+    md.time_spec = time_spec_t::from_ticks(0, 61.44e6);
+    tk.update(md, 10000);
+    md.has_time_spec = false;
+    for (size_t i = 0; i < 1000; i++) tk.update(md, 10000);
+
+    //10M samples in: exactly 61.44M ticks (one second)
+    BOOST_CHECK_EQUAL(tk.get_ticks(0), uint64_t(61440000));
+    BOOST_CHECK_CLOSE(tk.get_time_spec(0).get_real_secs(), 1.0, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(test_timekeeper_monotonic){
+    sample_timekeeper tk;
+    tk.set_tick_rate(30.72e6);
+    tk.set_samp_rate(30.72e6/7); //awkward non-integer ratio
+
+    rx_metadata_t md;
+    md.has_time_spec = true;
+    md.time_spec = time_spec_t(0.5);
+    tk.update(md, 100);
+
+    uint64_t last = tk.get_ticks(0);
+    for (size_t i = 1; i < 100; i++){
+        const uint64_t ticks = tk.get_ticks(i);
+        BOOST_CHECK(ticks > last);
+        last = ticks;
+    }
+}
@@ -0,0 +1,105 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/types/serial.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <vector>
+
+using namespace uhd;
+
+/***********************************************************************
+ * Mock an I2C EEPROM behind the i2c_iface eeprom routines.
+ *
+ * The mock emulates the device-side constraints the page write code
+ * must respect: the first command byte sets the address pointer, a
+ * multi-byte write fills the page buffer and must not wrap the page,
+ * and reads auto-increment the address pointer.
+ **********************************************************************/
+static const size_t MOCK_EEPROM_SIZE = 256;
+static const size_t MOCK_PAGE_SIZE = 8; //matches the smallest supported part
+
+struct mock_eeprom_iface : i2c_iface{
+    mock_eeprom_iface(void):
+        mem(MOCK_EEPROM_SIZE, 0xff),
+        addr_ptr(0),
+        num_page_writes(0)
+    {
+        //NOP
+    }
+
+    void write_i2c(uint16_t, const byte_vector_t &buf){
+        BOOST_REQUIRE(not buf.empty());
+        addr_ptr = buf[0];
+        if (buf.size() == 1) return; //address-only write starts a read cycle
+        num_page_writes++;
+
+        //a page write must stay within one page of the device
+        const size_t num = buf.size() - 1;
+        BOOST_REQUIRE_LE(num, MOCK_PAGE_SIZE);
+        BOOST_REQUIRE_LE(
+            (addr_ptr % MOCK_PAGE_SIZE) + num, MOCK_PAGE_SIZE);
+
+        for (size_t i = 0; i < num; i++){
+            mem.at(addr_ptr + i) = buf[i + 1];
+        }
+        addr_ptr += num;
+    }
+
+    byte_vector_t read_i2c(uint16_t, size_t num_bytes){
+        byte_vector_t bytes;
+        for (size_t i = 0; i < num_bytes; i++){
+            bytes.push_back(mem.at(addr_ptr++));
+        }
+        return bytes;
+    }
+
+    byte_vector_t mem;
+    size_t addr_ptr;
+    size_t num_page_writes;
+};
+
+BOOST_AUTO_TEST_CASE(test_eeprom_page_write_loopback){
+    mock_eeprom_iface iface;
+
+    //fill a buffer with a recognizable pattern
+    byte_vector_t bytes(32);
+    for (size_t i = 0; i < bytes.size(); i++) bytes[i] = uint8_t(0xa0 + i);
+
+    iface.write_eeprom(0x50, 0, bytes);
+    BOOST_CHECK(std::equal(bytes.begin(), bytes.end(), iface.mem.begin()));
+
+    const byte_vector_t readback = iface.read_eeprom(0x50, 0, bytes.size());
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        bytes.begin(), bytes.end(), readback.begin(), readback.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_eeprom_page_write_unaligned){
+    mock_eeprom_iface iface;
+
+    //an unaligned write spanning three pages: the mock asserts that no
+    //transaction crosses a page boundary
+    byte_vector_t bytes(18);
+    for (size_t i = 0; i < bytes.size(); i++) bytes[i] = uint8_t(i + 1);
+
+    iface.write_eeprom(0x50, 5, bytes);
+    BOOST_CHECK(std::equal(bytes.begin(), bytes.end(), iface.mem.begin() + 5));
+
+    //bytes around the written range stay untouched
+    BOOST_CHECK_EQUAL(iface.mem.at(4), 0xff);
+    BOOST_CHECK_EQUAL(iface.mem.at(5 + bytes.size()), 0xff);
+}
+
+BOOST_AUTO_TEST_CASE(test_eeprom_page_write_batches){
+    mock_eeprom_iface iface;
+
+    //an aligned 32-byte image goes out in 4 page writes (and thus 4
+    //internal write cycles) instead of the 32 of the byte-at-a-time
+    //scheme it replaces
+    byte_vector_t bytes(32, 0x5a);
+    iface.write_eeprom(0x50, 0, bytes);
+    BOOST_CHECK_EQUAL(iface.num_page_writes, 4);
+}
@@ -31,3 +31,50 @@ BOOST_AUTO_TEST_CASE(test_soft_reg_field) {
     BOOST_CHECK_EQUAL(soft_reg_field::shift(test_reg4), 0);
     BOOST_CHECK_EQUAL(soft_reg_field::mask<size_t>(test_reg4), ~size_t(0) & 0x1FFFFFFFF);
 }
+
+BOOST_AUTO_TEST_CASE(test_soft_reg_flush_group) {
+    //wb_iface stub that records all pokes
+    class counting_iface : public wb_iface {
+    public:
+        void poke32(const wb_addr_type addr, const uint32_t data) {
+            pokes.push_back(std::make_pair(addr, data));
+        }
+        std::vector<std::pair<wb_addr_type, uint32_t> > pokes;
+    };
+
+    UHD_DEFINE_SOFT_REG_FIELD(FIELD_A, /* width */ 4, /* shift */ 0);
+    UHD_DEFINE_SOFT_REG_FIELD(FIELD_B, /* width */ 4, /* shift */ 4);
+
+    counting_iface iface;
+    soft_reg32_wo_t reg0(0), reg1(4), reg2(8);
+    //sync=true flushes, so all soft-copies start out clean
+    reg0.initialize(iface, true);
+    reg1.initialize(iface, true);
+    reg2.initialize(iface, true);
+    iface.pokes.clear();
+
+    soft_reg_flush_group_t group;
+    group.add(reg0);
+    group.add(reg1);
+    group.add(reg2);
+    BOOST_CHECK(not group.is_dirty());
+
+    //multiple field updates to the same register coalesce into one
+    //poke, and the untouched register is skipped entirely
+    reg0.set(FIELD_A, 0x3);
+    reg0.set(FIELD_B, 0x5);
+    reg1.set(FIELD_A, 0x7);
+    BOOST_CHECK(group.is_dirty());
+    group.commit();
+
+    BOOST_REQUIRE_EQUAL(iface.pokes.size(), 2);
+    BOOST_CHECK_EQUAL(iface.pokes[0].first, 0);
+    BOOST_CHECK_EQUAL(iface.pokes[0].second, 0x53);
+    BOOST_CHECK_EQUAL(iface.pokes[1].first, 4);
+    BOOST_CHECK_EQUAL(iface.pokes[1].second, 0x7);
+
+    //now everything is clean: another commit emits nothing
+    BOOST_CHECK(not group.is_dirty());
+    group.commit();
+    BOOST_CHECK_EQUAL(iface.pokes.size(), 2);
+}
@@ -10,6 +10,7 @@
 #include <boost/shared_array.hpp>
 #include <boost/bind.hpp>
 #include <complex>
+#include <cstring>
 #include <vector>
 #include <list>
 
@@ -805,3 +806,192 @@ BOOST_AUTO_TEST_CASE(test_sph_recv_multi_channel_fragment){
 
     BOOST_REQUIRE_THROW(handler.recv(buffs, NUM_SAMPS_PER_BUFF, metadata, 1.0, true), uhd::io_error);
 }
+
+////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_sph_recv_one_channel_history){
+////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format = "sc16_item32_be";
+    id.num_inputs = 1;
+    id.output_format = "fc32";
+    id.num_outputs = 1;
+
+    dummy_recv_xport_class dummy_recv_xport("big");
+    uhd::transport::vrt::if_packet_info_t ifpi;
+    ifpi.packet_type = uhd::transport::vrt::if_packet_info_t::PACKET_TYPE_DATA;
+    ifpi.num_payload_words32 = 0;
+    ifpi.packet_count = 0;
+    ifpi.sob = true;
+    ifpi.eob = false;
+    ifpi.has_sid = false;
+    ifpi.has_cid = false;
+    ifpi.has_tsi = true;
+    ifpi.has_tsf = true;
+    ifpi.tsi = 0;
+    ifpi.tsf = 0;
+    ifpi.has_tlr = false;
+
+    static const double TICK_RATE = 100e6;
+    static const double SAMP_RATE = 10e6;
+    static const size_t NUM_PKTS_TO_TEST = 30;
+    static const size_t HISTORY_SAMPS = 100;
+
+    //generate a bunch of packets
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++){
+        ifpi.num_payload_words32 = 10 + i%10;
+        dummy_recv_xport.push_back_packet(ifpi);
+        ifpi.packet_count++;
+        ifpi.tsf += ifpi.num_payload_words32*size_t(TICK_RATE/SAMP_RATE);
+    }
+
+    //create the super receive packet handler with a history ring
+    uhd::transport::sph::recv_packet_handler handler(1);
+    handler.set_vrt_unpacker(&uhd::transport::vrt::if_hdr_unpack_be);
+    handler.set_tick_rate(TICK_RATE);
+    handler.set_samp_rate(SAMP_RATE);
+    handler.set_xport_chan_get_buff(0, boost::bind(&dummy_recv_xport_class::get_recv_buff, &dummy_recv_xport, _1));
+    handler.set_converter(id);
+    handler.enable_history(HISTORY_SAMPS/SAMP_RATE);
+
+    //the ring must be frozen before it can be read
+    std::vector<std::complex<float> > history(HISTORY_SAMPS);
+    BOOST_CHECK_THROW(handler.read_history(&history.front(), 1, 0), uhd::runtime_error);
+
+    //receive everything, keeping a reference copy of all samples
+    std::vector<std::complex<float> > buff(20);
+    std::vector<std::complex<float> > reference;
+    uhd::rx_metadata_t metadata;
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++){
+        const size_t num_samps_ret = handler.recv(
+            &buff.front(), buff.size(), metadata, 1.0, true
+        );
+        BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+        reference.insert(reference.end(), buff.begin(), buff.begin() + num_samps_ret);
+    }
+
+    //freeze and read back: the ring must hold the newest samples
+    const size_t held = handler.freeze_history();
+    BOOST_CHECK_EQUAL(held, HISTORY_SAMPS);
+    const size_t num_read = handler.read_history(&history.front(), HISTORY_SAMPS, 0);
+    BOOST_CHECK_EQUAL(num_read, HISTORY_SAMPS);
+    //compare raw bytes: the payload is arbitrary and may not be a
+    //valid float, so value comparison would trip over NaN
+    BOOST_CHECK(std::memcmp(&history.front(),
+        &reference[reference.size() - HISTORY_SAMPS],
+        HISTORY_SAMPS*sizeof(std::complex<float>)) == 0);
+
+    //an offset read returns only the newer span
+    const size_t num_offset_read = handler.read_history(&history.front(), HISTORY_SAMPS, 90);
+    BOOST_CHECK_EQUAL(num_offset_read, 10UL);
+    BOOST_CHECK(std::memcmp(&history.front(),
+        &reference[reference.size() - 10],
+        10*sizeof(std::complex<float>)) == 0);
+
+    //resuming re-arms the feed and makes reads invalid again
+    handler.resume_history();
+    BOOST_CHECK_THROW(handler.read_history(&history.front(), 1, 0), uhd::runtime_error);
+}
+
+////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_sph_recv_one_channel_posted){
+////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format = "sc16_item32_be";
+    id.num_inputs = 1;
+    id.output_format = "fc32";
+    id.num_outputs = 1;
+
+    dummy_recv_xport_class dummy_recv_xport("big");
+    dummy_recv_xport_class reference_xport("big");
+    uhd::transport::vrt::if_packet_info_t ifpi;
+    ifpi.packet_type = uhd::transport::vrt::if_packet_info_t::PACKET_TYPE_DATA;
+    ifpi.num_payload_words32 = 0;
+    ifpi.packet_count = 0;
+    ifpi.sob = true;
+    ifpi.eob = false;
+    ifpi.has_sid = false;
+    ifpi.has_cid = false;
+    ifpi.has_tsi = true;
+    ifpi.has_tsf = true;
+    ifpi.tsi = 0;
+    ifpi.tsf = 0;
+    ifpi.has_tlr = false;
+
+    static const double TICK_RATE = 100e6;
+    static const double SAMP_RATE = 10e6;
+    static const size_t NUM_PKTS_TO_TEST = 30;
+
+    //generate a bunch of packets, identically on both transports
+    size_t total_num_samps = 0;
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++){
+        ifpi.num_payload_words32 = 10 + i%10;
+        dummy_recv_xport.push_back_packet(ifpi);
+        reference_xport.push_back_packet(ifpi);
+        ifpi.packet_count++;
+        ifpi.tsf += ifpi.num_payload_words32*size_t(TICK_RATE/SAMP_RATE);
+        total_num_samps += 10 + i%10;
+    }
+
+    //create the super receive packet handler
+    uhd::transport::sph::recv_packet_handler handler(1);
+    handler.set_vrt_unpacker(&uhd::transport::vrt::if_hdr_unpack_be);
+    handler.set_tick_rate(TICK_RATE);
+    handler.set_samp_rate(SAMP_RATE);
+    handler.set_xport_chan_get_buff(0, boost::bind(&dummy_recv_xport_class::get_recv_buff, &dummy_recv_xport, _1));
+    handler.set_converter(id);
+
+    //a second handler receives the same samples conventionally
+    uhd::transport::sph::recv_packet_handler ref_handler(1);
+    ref_handler.set_vrt_unpacker(&uhd::transport::vrt::if_hdr_unpack_be);
+    ref_handler.set_tick_rate(TICK_RATE);
+    ref_handler.set_samp_rate(SAMP_RATE);
+    ref_handler.set_xport_chan_get_buff(0, boost::bind(&dummy_recv_xport_class::get_recv_buff, &reference_xport, _1));
+    ref_handler.set_converter(id);
+
+    std::vector<std::complex<float> > reference(total_num_samps);
+    uhd::rx_metadata_t metadata;
+    const size_t num_ref_samps = ref_handler.recv(
+        &reference.front(), reference.size(), metadata, 1.0, false
+    );
+    BOOST_CHECK_EQUAL(num_ref_samps, total_num_samps);
+
+    //receiving with nothing posted is an error
+    uhd::rx_streamer::recv_completion_t completion;
+    BOOST_CHECK_THROW(handler.recv_posted(completion, 1.0), uhd::runtime_error);
+
+    //a zero-sized post is rejected
+    std::vector<std::complex<float> > buff0(200), buff1(200), buff2(100);
+    BOOST_CHECK_THROW(handler.post_recv_buff(&buff0.front(), 0), uhd::value_error);
+
+    //post three destination buffers up front
+    BOOST_CHECK_EQUAL(handler.post_recv_buff(&buff0.front(), buff0.size()), 0UL);
+    BOOST_CHECK_EQUAL(handler.post_recv_buff(&buff1.front(), buff1.size()), 1UL);
+    BOOST_CHECK_EQUAL(handler.post_recv_buff(&buff2.front(), buff2.size()), 2UL);
+
+    //the first two posted buffers fill completely, in posting order
+    BOOST_CHECK(handler.recv_posted(completion, 1.0));
+    BOOST_CHECK_EQUAL(completion.index, 0UL);
+    BOOST_CHECK_EQUAL(completion.nsamps, buff0.size());
+    BOOST_CHECK_EQUAL(completion.metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+    BOOST_CHECK(std::memcmp(&buff0.front(), &reference[0],
+        buff0.size()*sizeof(std::complex<float>)) == 0);
+
+    BOOST_CHECK(handler.recv_posted(completion, 1.0));
+    BOOST_CHECK_EQUAL(completion.index, 1UL);
+    BOOST_CHECK_EQUAL(completion.nsamps, buff1.size());
+    BOOST_CHECK(std::memcmp(&buff1.front(), &reference[buff0.size()],
+        buff1.size()*sizeof(std::complex<float>)) == 0);
+
+    //the transport runs dry part-way into the third buffer: the short
+    //fill still completes it
+    const size_t remaining = total_num_samps - buff0.size() - buff1.size();
+    BOOST_CHECK(handler.recv_posted(completion, 0.1));
+    BOOST_CHECK_EQUAL(completion.index, 2UL);
+    BOOST_CHECK_EQUAL(completion.nsamps, remaining);
+    BOOST_CHECK(std::memcmp(&buff2.front(),
+        &reference[buff0.size() + buff1.size()],
+        remaining*sizeof(std::complex<float>)) == 0);
+
+    //the queue is now empty again
+    BOOST_CHECK_THROW(handler.recv_posted(completion, 0.1), uhd::runtime_error);
+}
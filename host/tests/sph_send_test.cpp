@@ -57,6 +57,26 @@ public:
         _lens.pop_front();
     }
 
+    //! Like pop_front_packet, but also yields the payload words
+    void pop_front_packet_payload(
+        uhd::transport::vrt::if_packet_info_t &ifpi,
+        std::vector<uint32_t> &payload
+    ){
+        ifpi.num_packet_words32 = _lens.front()/sizeof(uint32_t);
+        const uint32_t *pkt = reinterpret_cast<uint32_t *>(_mems.front().get());
+        if (_end == "big"){
+            uhd::transport::vrt::if_hdr_unpack_be(pkt, ifpi);
+        }
+        if (_end == "little"){
+            uhd::transport::vrt::if_hdr_unpack_le(pkt, ifpi);
+        }
+        payload.assign(
+            pkt + ifpi.num_header_words32,
+            pkt + ifpi.num_header_words32 + ifpi.num_payload_words32);
+        _mems.pop_front();
+        _lens.pop_front();
+    }
+
     uhd::transport::managed_send_buffer::sptr get_send_buff(double){
         _msbs.push_back(boost::shared_ptr<dummy_msb>(new dummy_msb()));
         _mems.push_back(boost::shared_array<char>(new char[1000]));
@@ -180,3 +200,93 @@ BOOST_AUTO_TEST_CASE(test_sph_send_one_channel_full_buffer_mode){
         num_accum_samps += ifpi.num_payload_words32;
     }
 }
+
+////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_sph_send_one_channel_spans){
+////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format = "fc32";
+    id.num_inputs = 1;
+    id.output_format = "sc16_item32_be";
+    id.num_outputs = 1;
+
+    dummy_send_xport_class dummy_send_xport("big");
+    dummy_send_xport_class reference_xport("big");
+
+    static const double TICK_RATE = 100e6;
+    static const double SAMP_RATE = 10e6;
+    static const size_t NUM_PKTS_TO_TEST = 30;
+
+    //create the super send packet handler
+    uhd::transport::sph::send_packet_handler handler(1);
+    handler.set_vrt_packer(&uhd::transport::vrt::if_hdr_pack_be);
+    handler.set_tick_rate(TICK_RATE);
+    handler.set_samp_rate(SAMP_RATE);
+    handler.set_xport_chan_get_buff(0, boost::bind(&dummy_send_xport_class::get_send_buff, &dummy_send_xport, _1));
+    handler.set_converter(id);
+    handler.set_max_samples_per_packet(20);
+
+    //a second handler sends the same samples contiguously for reference
+    uhd::transport::sph::send_packet_handler ref_handler(1);
+    ref_handler.set_vrt_packer(&uhd::transport::vrt::if_hdr_pack_be);
+    ref_handler.set_tick_rate(TICK_RATE);
+    ref_handler.set_samp_rate(SAMP_RATE);
+    ref_handler.set_xport_chan_get_buff(0, boost::bind(&dummy_send_xport_class::get_send_buff, &reference_xport, _1));
+    ref_handler.set_converter(id);
+    ref_handler.set_max_samples_per_packet(20);
+
+    //allocate metadata and buffer
+    std::vector<std::complex<float> > buff(20*NUM_PKTS_TO_TEST);
+    for (size_t i = 0; i < buff.size(); i++){
+        buff[i] = std::complex<float>(float(i)/buff.size(), -float(i)/buff.size());
+    }
+    uhd::tx_metadata_t metadata;
+    metadata.start_of_burst = true;
+    metadata.end_of_burst = true;
+    metadata.has_time_spec = true;
+    metadata.time_spec = uhd::time_spec_t(0.0);
+
+    //scatter the buffer into irregular spans that straddle packet
+    //boundaries, including an empty span
+    std::vector<uhd::tx_streamer::span_list_t> spans(1);
+    size_t offset = 0;
+    size_t span_len = 1;
+    while (offset < buff.size()){
+        const size_t nsamps = std::min(span_len, buff.size() - offset);
+        spans[0].push_back(uhd::tx_streamer::span_t(&buff[offset], nsamps));
+        if (span_len == 7) spans[0].push_back(uhd::tx_streamer::span_t(NULL, 0));
+        offset += nsamps;
+        span_len = (span_len % 13) + 1;
+    }
+
+    //send scattered and contiguous
+    const size_t num_sent = handler.send_spans(spans, metadata, 1.0);
+    BOOST_CHECK_EQUAL(num_sent, buff.size());
+    const size_t num_sent_ref = ref_handler.send(
+        &buff.front(), buff.size(), metadata, 1.0
+    );
+    BOOST_CHECK_EQUAL(num_sent_ref, buff.size());
+
+    //check the sent packets against the reference
+    size_t num_accum_samps = 0;
+    uhd::transport::vrt::if_packet_info_t ifpi, ref_ifpi;
+    std::vector<uint32_t> payload, ref_payload;
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++){
+        std::cout << "data check " << i << std::endl;
+        dummy_send_xport.pop_front_packet_payload(ifpi, payload);
+        reference_xport.pop_front_packet_payload(ref_ifpi, ref_payload);
+        BOOST_CHECK_EQUAL(ifpi.num_payload_words32, 20UL);
+        BOOST_CHECK(ifpi.has_tsf);
+        BOOST_CHECK_EQUAL(ifpi.tsf, num_accum_samps*TICK_RATE/SAMP_RATE);
+        BOOST_CHECK_EQUAL(ifpi.sob, i == 0);
+        BOOST_CHECK_EQUAL(ifpi.eob, i == NUM_PKTS_TO_TEST-1);
+        BOOST_CHECK(payload == ref_payload);
+        num_accum_samps += ifpi.num_payload_words32;
+    }
+
+    //a span list count that does not match the channel count is rejected
+    std::vector<uhd::tx_streamer::span_list_t> bad_spans(2);
+    bad_spans[0].push_back(uhd::tx_streamer::span_t(&buff[0], 10));
+    bad_spans[1].push_back(uhd::tx_streamer::span_t(&buff[0], 5));
+    BOOST_CHECK_THROW(handler.send_spans(bad_spans, metadata, 1.0), uhd::value_error);
+}
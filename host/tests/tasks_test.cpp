@@ -7,6 +7,7 @@
 
 #include <boost/test/unit_test.hpp>
 #include <uhd/utils/tasks.hpp>
+#include <atomic>
 #include <thread>
 #include <chrono>
 #include <vector>
@@ -26,3 +27,28 @@ BOOST_AUTO_TEST_CASE(tasks_test) {
         test_vec.push_back(uhd::task::make([i](){ test_tasks_sleep(i); }));
     }
 }
+
+BOOST_AUTO_TEST_CASE(pooled_tasks_test) {
+
+    static const size_t N_TASKS = 100;
+    std::vector<std::shared_ptr<std::atomic<size_t>>> counters;
+    std::vector<uhd::task::sptr> test_vec;
+
+    //many pooled tasks share a handful of workers; every task must
+    //still get iterations and the destructors must not hang
+    for (size_t i = 0; i < N_TASKS; i++) {
+        counters.push_back(std::make_shared<std::atomic<size_t>>(0));
+        auto counter = counters.back();
+        test_vec.push_back(uhd::task::make_pooled([counter](){
+            (*counter)++;
+            test_tasks_sleep(1);
+        }, "test_pool"));
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    test_vec.clear();
+
+    for (size_t i = 0; i < N_TASKS; i++) {
+        BOOST_CHECK(counters[i]->load() > 0);
+    }
+}
@@ -0,0 +1,44 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/utils/thread_policy.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_CASE(test_thread_policy_unknown_role)
+{
+    //roles without a policy must be a silent no-op: every internal
+    //thread calls apply() unconditionally
+    BOOST_CHECK_NO_THROW(uhd::thread_policy::apply("no_such_role"));
+}
+
+BOOST_AUTO_TEST_CASE(test_thread_policy_register_and_apply)
+{
+    uhd::thread_policy::policy_t policy;
+    BOOST_CHECK(not policy.has_priority);
+    BOOST_CHECK(policy.cpu_affinity.empty());
+
+    policy.cpu_affinity.push_back(0);
+    uhd::thread_policy::register_policy("test_role", policy);
+    BOOST_CHECK_NO_THROW(uhd::thread_policy::apply("test_role"));
+}
+
+BOOST_AUTO_TEST_CASE(test_thread_policy_from_args)
+{
+    uhd::device_addr_t args;
+    args["thread_recv_offload_affinity"] = "0.0";
+    args["thread_recv_offload_realtime"] = "0";
+    args["thread_usb_events_priority"] = "0.25";
+    //unrelated and malformed keys must not throw, only warn
+    args["thread_bogus"] = "1";
+    args["thread_usb_events_affinity"] = "not_a_cpu";
+    args["addr"] = "192.168.10.2";
+
+    BOOST_CHECK_NO_THROW(
+        uhd::thread_policy::register_policies_from_args(args));
+    BOOST_CHECK_NO_THROW(uhd::thread_policy::apply("recv_offload"));
+    BOOST_CHECK_NO_THROW(uhd::thread_policy::apply("usb_events"));
+}
@@ -0,0 +1,173 @@
+//
+// Copyright 2018 Ettus Research, a National Instruments Company
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/types/wb_iface.hpp>
+#include <uhd/exception.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+#include <map>
+
+using namespace uhd;
+
+namespace {
+    //! A fake register interface that counts device accesses
+    class counting_wb_iface : public wb_iface
+    {
+    public:
+        void poke32(const wb_addr_type addr, const uint32_t data)
+        {
+            regs[addr] = data;
+            poke_count++;
+        }
+
+        uint32_t peek32(const wb_addr_type addr)
+        {
+            peek_count++;
+            return regs[addr];
+        }
+
+        std::map<wb_addr_type, uint32_t> regs;
+        size_t poke_count = 0;
+        size_t peek_count = 0;
+    };
+}
+
+BOOST_AUTO_TEST_CASE(test_cached_wb_iface)
+{
+    auto backing = boost::make_shared<counting_wb_iface>();
+    cached_wb_iface::sptr iface = cached_wb_iface::make(backing);
+
+    backing->regs[0] = 111;
+    backing->regs[4] = 222;
+
+    //undeclared addresses always go to the device
+    BOOST_CHECK_EQUAL(iface->peek32(0), 111);
+    BOOST_CHECK_EQUAL(iface->peek32(0), 111);
+    BOOST_CHECK_EQUAL(backing->peek_count, 2);
+
+    //declared addresses are served from the cache within the TTL
+    iface->set_cache_ttl(0, 1000.0);
+    BOOST_CHECK_EQUAL(iface->peek32(0), 111);
+    BOOST_CHECK_EQUAL(backing->peek_count, 3);
+    backing->regs[0] = 333; //not visible until invalidated
+    BOOST_CHECK_EQUAL(iface->peek32(0), 111);
+    BOOST_CHECK_EQUAL(iface->peek32(0), 111);
+    BOOST_CHECK_EQUAL(backing->peek_count, 3);
+
+    //a sibling register is unaffected
+    BOOST_CHECK_EQUAL(iface->peek32(4), 222);
+    BOOST_CHECK_EQUAL(backing->peek_count, 4);
+
+    //explicit invalidation forces a device read
+    iface->invalidate(0);
+    BOOST_CHECK_EQUAL(iface->peek32(0), 333);
+    BOOST_CHECK_EQUAL(backing->peek_count, 5);
+
+    //an expired TTL forces a device read
+    iface->set_cache_ttl(4, 0.0);
+    BOOST_CHECK_EQUAL(iface->peek32(4), 222);
+    BOOST_CHECK_EQUAL(iface->peek32(4), 222);
+    BOOST_CHECK_EQUAL(backing->peek_count, 7);
+
+    //writes pass through and drop the whole cache
+    backing->regs[0] = 444;
+    iface->poke32(8, 1);
+    BOOST_CHECK_EQUAL(backing->poke_count, 1);
+    BOOST_CHECK_EQUAL(iface->peek32(0), 444);
+    BOOST_CHECK_EQUAL(backing->peek_count, 8);
+
+    //invalidate_all drops every entry
+    backing->regs[0] = 555;
+    iface->invalidate_all();
+    BOOST_CHECK_EQUAL(iface->peek32(0), 555);
+    BOOST_CHECK_EQUAL(backing->peek_count, 9);
+}
+
+BOOST_AUTO_TEST_CASE(test_wb_write_batch)
+{
+    auto backing = boost::make_shared<counting_wb_iface>();
+    {
+        wb_write_batch batch(backing);
+        batch.poke32(0, 10);
+        batch.poke32(4, 20);
+        BOOST_CHECK_EQUAL(backing->poke_count, 0);
+        batch.commit();
+        BOOST_CHECK_EQUAL(backing->poke_count, 2);
+        BOOST_CHECK_EQUAL(backing->regs[0], 10);
+        BOOST_CHECK_EQUAL(backing->regs[4], 20);
+
+        //the destructor commits pending writes
+        batch.poke32(8, 30);
+    }
+    BOOST_CHECK_EQUAL(backing->poke_count, 3);
+    BOOST_CHECK_EQUAL(backing->regs[8], 30);
+}
+
+BOOST_AUTO_TEST_CASE(test_wb_iface_range_defaults)
+{
+    auto backing = boost::make_shared<counting_wb_iface>();
+
+    //the default poke32_range loops over poke32 with a 4-byte stride
+    backing->poke32_range(16, {1, 2, 3});
+    BOOST_CHECK_EQUAL(backing->poke_count, 3);
+    BOOST_CHECK_EQUAL(backing->regs[16], 1);
+    BOOST_CHECK_EQUAL(backing->regs[20], 2);
+    BOOST_CHECK_EQUAL(backing->regs[24], 3);
+
+    //the default peek32_range loops over peek32
+    const std::vector<uint32_t> data = backing->peek32_range(16, 3);
+    BOOST_CHECK_EQUAL(backing->peek_count, 3);
+    BOOST_REQUIRE_EQUAL(data.size(), 3);
+    BOOST_CHECK_EQUAL(data[0], 1);
+    BOOST_CHECK_EQUAL(data[1], 2);
+    BOOST_CHECK_EQUAL(data[2], 3);
+
+    //empty ranges touch nothing
+    backing->poke32_range(0, {});
+    BOOST_CHECK(backing->peek32_range(0, 0).empty());
+    BOOST_CHECK_EQUAL(backing->poke_count, 3);
+    BOOST_CHECK_EQUAL(backing->peek_count, 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_wb_snapshot)
+{
+    auto primary = boost::make_shared<counting_wb_iface>();
+    auto standby = boost::make_shared<counting_wb_iface>();
+
+    primary->regs[0] = 10;
+    primary->regs[4] = 20;
+    primary->regs[128] = 30;
+
+    wb_snapshot snap;
+    snap.declare_range(0, 2);
+    snap.declare_range(128, 1);
+
+    //restore before capture is an error
+    BOOST_CHECK(not snap.valid());
+    BOOST_CHECK_THROW(snap.restore(standby), uhd::runtime_error);
+
+    snap.capture(primary);
+    BOOST_CHECK(snap.valid());
+    BOOST_CHECK_EQUAL(primary->peek_count, 3);
+
+    //restoring onto a second device clones the captured state
+    snap.restore(standby);
+    BOOST_CHECK_EQUAL(standby->poke_count, 3);
+    BOOST_CHECK_EQUAL(standby->regs[0], 10);
+    BOOST_CHECK_EQUAL(standby->regs[4], 20);
+    BOOST_CHECK_EQUAL(standby->regs[128], 30);
+
+    //the snapshot holds values, not references: later device changes
+    //do not leak into a restore
+    primary->regs[0] = 99;
+    snap.restore(standby);
+    BOOST_CHECK_EQUAL(standby->regs[0], 10);
+
+    //declaring another range invalidates the capture
+    snap.declare_range(256, 1);
+    BOOST_CHECK(not snap.valid());
+    BOOST_CHECK_THROW(snap.restore(standby), uhd::runtime_error);
+}
@@ -222,10 +222,90 @@ static std::string get_device_pp_string(property_tree::sptr tree){
 }
 
 void print_tree(const uhd::fs_path &path, uhd::property_tree::sptr tree){
-    std::cout << path << std::endl;
-    for(const std::string &name:  tree->list(path)){
-        print_tree(path / name, tree);
+    //one-pass subtree collection instead of a list() call per node
+    for(const uhd::fs_path &prop_path:  tree->snapshot(path)){
+        std::cout << prop_path << std::endl;
+    }
+}
+
+static std::string json_escape(const std::string &in){
+    std::stringstream ss;
+    for(const char c:  in){
+        switch (c){
+        case '"': ss << "\\\""; break;
+        case '\\': ss << "\\\\"; break;
+        case '\n': ss << "\\n"; break;
+        case '\r': ss << "\\r"; break;
+        case '\t': ss << "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) ss << boost::format("\\u%04x") % int(c);
+            else ss << c;
+        }
+    }
+    return ss.str();
+}
+
+/*! Render one property as a JSON value.
+ * Tries the property types the probe knows how to print; a type
+ * mismatch throws and the next candidate is tried. Properties of
+ * other types (register interfaces, eeprom structs, ...) are skipped.
+ */
+static bool get_json_value(property_tree::sptr tree, const fs_path &path, std::string &out){
+    try{
+        out = "\"" + json_escape(tree->access<std::string>(path).get()) + "\"";
+        return true;
+    } catch(...){}
+    try{
+        out = (tree->access<bool>(path).get())? "true" : "false";
+        return true;
+    } catch(...){}
+    try{
+        out = str(boost::format("%d") % tree->access<int>(path).get());
+        return true;
+    } catch(...){}
+    try{
+        out = str(boost::format("%g") % tree->access<double>(path).get());
+        return true;
+    } catch(...){}
+    try{
+        const sensor_value_t sensor = tree->access<sensor_value_t>(path).get();
+        out = str(boost::format("{\"name\": \"%s\", \"value\": \"%s\", \"unit\": \"%s\"}")
+            % json_escape(sensor.name) % json_escape(sensor.value) % json_escape(sensor.unit));
+        return true;
+    } catch(...){}
+    try{
+        const meta_range_t range = tree->access<meta_range_t>(path).get();
+        out = str(boost::format("{\"start\": %g, \"stop\": %g, \"step\": %g}")
+            % range.start() % range.stop() % range.step());
+        return true;
+    } catch(...){}
+    try{
+        const std::vector<std::string> strs =
+            tree->access<std::vector<std::string> >(path).get();
+        std::stringstream ss; ss << "[";
+        for (size_t i = 0; i < strs.size(); i++){
+            ss << ((i)? ", " : "") << "\"" << json_escape(strs[i]) << "\"";
+        }
+        ss << "]";
+        out = ss.str();
+        return true;
+    } catch(...){}
+    return false;
+}
+
+void print_tree_json(const uhd::fs_path &path, uhd::property_tree::sptr tree){
+    //one snapshot pass collects the paths and lets bulk backends
+    //prefetch their values; the typed reads below hit the cache
+    std::cout << "{" << std::endl;
+    bool first = true;
+    for(const uhd::fs_path &prop_path:  tree->snapshot(path)){
+        std::string value;
+        if (not get_json_value(tree, prop_path, value)) continue;
+        if (not first) std::cout << "," << std::endl;
+        first = false;
+        std::cout << "  \"" << json_escape(prop_path) << "\": " << value;
     }
+    std::cout << std::endl << "}" << std::endl;
 }
 
 int UHD_SAFE_MAIN(int argc, char *argv[]){
@@ -235,6 +315,7 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
         ("version", "print the version string and exit")
         ("args", po::value<std::string>()->default_value(""), "device address args")
         ("tree", "specify to print a complete property tree")
+        ("json", "print the property tree with values as JSON for machine consumption")
         ("string", po::value<std::string>(), "query a string value from the property tree")
         ("double", po::value<std::string>(), "query a double precision floating point value from the property tree")
         ("int", po::value<std::string>(), "query a integer value from the property tree")
@@ -297,7 +378,8 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
         return EXIT_SUCCESS;
     }
 
-    if (vm.count("tree") != 0) print_tree("/", tree);
+    if (vm.count("json") != 0) print_tree_json("/", tree);
+    else if (vm.count("tree") != 0) print_tree("/", tree);
     else if (not vm.count("init-only")) std::cout << make_border(get_device_pp_string(tree)) << std::endl;
 
     return EXIT_SUCCESS;
@@ -10,6 +10,7 @@ Code to run the discovery port
 from __future__ import print_function
 from multiprocessing import Process
 import socket
+import time
 from builtins import bytes
 from usrp_mpm.mpmtypes import MPM_DISCOVERY_PORT
 from usrp_mpm.mpmlog import get_main_logger
@@ -18,6 +19,8 @@ from usrp_mpm.mpmutils import to_binary_str
 RESPONSE_PREAMBLE = b"USRP-MPM"
 RESPONSE_SEP = b";"
 RESPONSE_CLAIMED_KEY = b"claimed"
+# Prefix of the UDP claim keep-alive request ("MPM-KEEP;<token>")
+KEEPALIVE_PREAMBLE = b"MPM-KEEP"
 # "Max MTU" is not a redundant name. We don't know the total path MTU, but we
 # can say for sure that it won't exceed a certain value, and that's the max MTU
 MAX_MTU = 8000
@@ -94,6 +97,22 @@ def _discovery_process(state, discovery_addr):
                     send_sock.sendto(send_data, sender)
                 except OSError as ex:
                     log.warning("ECHO send error: %s", str(ex))
+            elif data.strip(b"\0").startswith(KEEPALIVE_PREAMBLE):
+                # Claim keep-alive: renews the claim without a round trip
+                # through the RPC server. The request is echoed back as the
+                # acknowledgement; an invalid token gets no response and the
+                # requester falls back to the RPC reclaim.
+                token = data.strip(b"\0")[len(KEEPALIVE_PREAMBLE)+1:]
+                if state.claim_status.value \
+                        and state.claim_token.value == token:
+                    state.claim_keepalive.value = time.monotonic()
+                    try:
+                        send_sock.sendto(data, sender)
+                    except OSError as ex:
+                        log.warning("Keep-alive send error: %s", str(ex))
+                else:
+                    log.debug("Ignoring keep-alive with invalid token "
+                              "from %s", sender[0])
     except Exception as err:
         log.error("Unexpected error: `%s' Type: `%s'", str(err), type(err))
         sock.close()
@@ -27,6 +27,9 @@ class SharedState(object):
         self.system_ready = Value(ctypes.c_bool, False, lock=self.lock)
         # String with max length of 256:
         self.claim_token = Array(ctypes.c_char, 256, lock=self.lock)
+        # time.monotonic() stamp of the last valid UDP claim keep-alive,
+        # written by the discovery process and read by the RPC server
+        self.claim_keepalive = Value(ctypes.c_double, 0.0, lock=self.lock)
         self.dev_type = Array(ctypes.c_char, 16, lock=self.lock)
         self.dev_serial = Array(ctypes.c_char, 8, lock=self.lock)
         self.dev_product = Array(ctypes.c_char, 16, lock=self.lock)
@@ -735,6 +735,23 @@ class PeriphManagerBase(object):
             self, self.mboard_sensor_callback_map.get(sensor_name)
         )()
 
+    def get_mb_sensors_batch(self, sensor_names=None):
+        """
+        Return a dictionary mapping sensor names to sensor value
+        dictionaries (see get_mb_sensor() for the value format). If
+        sensor_names is not given, all available sensors are read out.
+
+        This rolls the readout of an arbitrary number of sensors into a
+        single RPC call; pollers that read many sensors at once should
+        prefer it over calling get_mb_sensor() in a loop.
+        """
+        if sensor_names is None:
+            sensor_names = self.get_mb_sensors()
+        return {
+            sensor_name: self.get_mb_sensor(sensor_name)
+            for sensor_name in sensor_names
+        }
+
     ##########################################################################
     # EEPROMS
     ##########################################################################
@@ -10,6 +10,7 @@ Implemented RPC Servers
 from __future__ import print_function
 import traceback
 import copy
+import time
 from random import choice
 from string import ascii_letters, digits
 from multiprocessing import Process
@@ -361,6 +362,13 @@ class MPMServer(RPCServer):
         if self._disable_timeouts:
             self.log.debug("Timeouts are disabled: Snoozing")
             self._reset_timer()
+        elif self._state.claim_keepalive.value + self._timeout_interval \
+                > time.monotonic():
+            # The discovery process saw a valid UDP keep-alive recently
+            # enough, so the claim holder is alive even if it never made
+            # it through to this server
+            self.log.debug("Claim renewed by UDP keep-alive: Snoozing")
+            self._reset_timer()
         else:
             self.log.warning("A timeout event occured!")
             self._unclaim()